@@ -0,0 +1,306 @@
+/***************************************************************************//**
+ * @file evlog.c
+ * @brief Batch analysis of comparator edge timestamps: debounce, hysteresis
+ * tracking and rate statistics.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "evlog.h"
+
+#if !defined(EVLOG_HOST)
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_ldma.h"
+#include "em_prs.h"
+#include "em_timer.h"
+
+// Ping-pong descriptors; each half of the ring raises one LDMA interrupt
+static LDMA_Descriptor_t captureDesc[2];
+
+/**************************************************************************//**
+ * @brief
+ *   Start timestamping both edges of a PRS channel into a ring buffer.
+ *
+ * @details
+ *   TIMER0 CC0 captures the counter on every edge of the asynchronous PRS
+ *   channel and each capture requests one LDMA word transfer from the input
+ *   capture FIFO. The ring is covered by two linked descriptors, so the CPU
+ *   is only interrupted when half of the ring has been filled. LDMA_Init()
+ *   must have been called and the producer connected to prsChannel.
+ *
+ * @param[in] ringSize
+ *   Number of words in the ring; must be even.
+ *
+ * @return
+ *   Timestamp clock in Hz.
+ *****************************************************************************/
+uint32_t EVLOG_CaptureStart(volatile uint32_t *ring,
+                            uint32_t ringSize,
+                            unsigned int prsChannel,
+                            unsigned int ldmaChannel)
+{
+  LDMA_TransferCfg_t cfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_TIMER0_CC0);
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+  TIMER_InitCC_TypeDef ccInit = TIMER_INITCC_DEFAULT;
+  uint32_t half = ringSize / 2;
+
+  captureDesc[0] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_P2M_WORD(&TIMER0->CC[0].ICF, ring, half, 1);
+  captureDesc[1] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_P2M_WORD(&TIMER0->CC[0].ICF, ring + half, half,
+                                     -1);
+
+  // Transfer on every capture
+  captureDesc[0].xfer.ignoreSrec = 0;
+  captureDesc[1].xfer.ignoreSrec = 0;
+
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+
+  // Free-running 32-bit counter; divide by 16 for a ~1 us tick
+  timerInit.enable = false;
+  timerInit.prescale = timerPrescale16;
+  TIMER_Init(TIMER0, &timerInit);
+
+  // Capture both edges of the PRS channel
+  ccInit.eventCtrl = timerEventEveryEdge;
+  ccInit.edge = timerEdgeBoth;
+  ccInit.mode = timerCCModeCapture;
+  ccInit.prsInput = true;
+  ccInit.prsInputType = timerPrsInputAsyncLevel;
+  ccInit.prsSel = prsChannel;
+  TIMER_InitCC(TIMER0, 0, &ccInit);
+  PRS_ConnectConsumer(prsChannel, prsTypeAsync, prsConsumerTIMER0_CC0);
+
+  LDMA_StartTransfer(ldmaChannel, &cfg, &captureDesc[0]);
+  TIMER_Enable(TIMER0, true);
+
+  return CMU_ClockFreqGet(cmuClock_TIMER0) / 16;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Ring index the next timestamp capture goes to.
+ *****************************************************************************/
+uint32_t EVLOG_CaptureWriteIndex(const volatile uint32_t *ring,
+                                 unsigned int ldmaChannel)
+{
+  return (LDMA->CH[ldmaChannel].DST - (uint32_t)ring) / sizeof(uint32_t);
+}
+#endif // !EVLOG_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Reset the analysis.
+ *
+ * @param[in] level
+ *   Current comparator output.
+ *
+ * @param[in] now
+ *   Current timestamp.
+ *****************************************************************************/
+void EVLOG_Init(EVLOG_Handle_TypeDef *handle,
+                const EVLOG_Init_TypeDef *init,
+                uint8_t level,
+                uint32_t now)
+{
+  memset(handle, 0, sizeof(*handle));
+  handle->config = *init;
+  handle->debounceTicks =
+    (uint32_t)((uint64_t)init->tickHz * init->debounceUs / 1000000u);
+  handle->rawLevel = level ? 1 : 0;
+  handle->stableLevel = handle->rawLevel;
+  handle->lastEdge = now;
+  handle->lastBatch = now;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Accept rawLevel as the debounced level if it changed.
+ *****************************************************************************/
+static void commit(EVLOG_Handle_TypeDef *h,
+                   EVLOG_Event_TypeDef *events,
+                   uint32_t maxEvents,
+                   EVLOG_Stats_TypeDef *stats)
+{
+  h->pending = false;
+  if (h->rawLevel == h->stableLevel) {
+    return;
+  }
+  h->stableLevel = h->rawLevel;
+  if (stats->events < maxEvents) {
+    events[stats->events].timestamp = h->lastEdge;
+    events[stats->events].level = h->rawLevel;
+  }
+  stats->events++;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Update the recommended hysteresis from the chatter seen in a batch.
+ *****************************************************************************/
+static void trackHysteresis(EVLOG_Handle_TypeDef *h, EVLOG_Stats_TypeDef *stats)
+{
+  const EVLOG_Init_TypeDef *c = &h->config;
+  uint8_t previous = h->hystLevel;
+
+  if (stats->rejected >= c->chatterLimit) {
+    if (h->hystLevel < c->hystMax) {
+      h->hystLevel++;
+    }
+    h->quietCount = 0;
+  } else if (stats->rejected == 0) {
+    if (++h->quietCount >= c->quietBatches && h->hystLevel > 0) {
+      h->hystLevel--;
+      h->quietCount = 0;
+    }
+  } else {
+    h->quietCount = 0;
+  }
+
+  stats->hystLevel = h->hystLevel;
+  stats->hystChanged = h->hystLevel != previous;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Process every timestamp written to the ring since the last call.
+ *
+ * @details
+ *   Consecutive timestamps alternate between rising and falling edges,
+ *   starting from the level given to EVLOG_Init(). A level is accepted once
+ *   it has been held for the debounce time; the event carries the time of
+ *   the edge that started it, i.e. the last bounce. Edges that end a shorter
+ *   level are counted as chatter. A level still pending at the end of the
+ *   batch is accepted when now shows it has been held long enough, otherwise
+ *   it is carried over to the next batch.
+ *
+ * @note
+ *   Call at least once per ring length and often enough that timestamps do
+ *   not wrap between batches.
+ *
+ * @param[in] now
+ *   Current timestamp, read after writeIndex.
+ *
+ * @param[out] events
+ *   Accepted transitions; stats->events may exceed maxEvents, in which case
+ *   the later events are only counted.
+ *
+ * @return
+ *   Number of events written to events.
+ *****************************************************************************/
+uint32_t EVLOG_Process(EVLOG_Handle_TypeDef *handle,
+                       const volatile uint32_t *ring,
+                       uint32_t ringSize,
+                       uint32_t writeIndex,
+                       uint32_t now,
+                       EVLOG_Event_TypeDef *events,
+                       uint32_t maxEvents,
+                       EVLOG_Stats_TypeDef *stats)
+{
+  uint32_t debounce = handle->debounceTicks;
+
+  memset(stats, 0, sizeof(*stats));
+  stats->minPulse = UINT32_MAX;
+
+  writeIndex %= ringSize;
+  while (handle->readIndex != writeIndex) {
+    uint32_t t = ring[handle->readIndex];
+    uint32_t interval = t - handle->lastEdge;
+
+    handle->readIndex = (handle->readIndex + 1) % ringSize;
+
+    if (interval < stats->minPulse) {
+      stats->minPulse = interval;
+    }
+    if (handle->pending) {
+      if (interval >= debounce) {
+        commit(handle, events, maxEvents, stats);
+      } else {
+        stats->rejected++;
+      }
+    }
+
+    handle->rawLevel ^= 1;
+    handle->lastEdge = t;
+    handle->pending = true;
+    stats->rawEdges++;
+  }
+
+  if (handle->pending && now - handle->lastEdge >= debounce) {
+    commit(handle, events, maxEvents, stats);
+  }
+
+  stats->spanTicks = now - handle->lastBatch;
+  handle->lastBatch = now;
+  if (stats->spanTicks > 0) {
+    float perTick = (float)handle->config.tickHz / (float)stats->spanTicks;
+
+    stats->rawRate = stats->rawEdges * perTick;
+    stats->eventRate = stats->events * perTick;
+  }
+  trackHysteresis(handle, stats);
+
+  handle->totalEdges += stats->rawEdges;
+  handle->totalEvents += stats->events;
+  handle->totalRejected += stats->rejected;
+
+  return stats->events < maxEvents ? stats->events : maxEvents;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Correct the edge polarity from the actual comparator output.
+ *
+ * @details
+ *   Polarity is inferred by alternation, so a lost or spurious capture
+ *   inverts every following level. Call after EVLOG_Process() with the
+ *   output read while no capture was in flight; on a mismatch the level is
+ *   corrected and debounced from the end of the batch.
+ *
+ * @return
+ *   true if the level had to be corrected.
+ *****************************************************************************/
+bool EVLOG_Resync(EVLOG_Handle_TypeDef *handle, uint8_t level)
+{
+  level = level ? 1 : 0;
+  if (handle->rawLevel == level) {
+    return false;
+  }
+  handle->rawLevel = level;
+  handle->lastEdge = handle->lastBatch;
+  handle->pending = true;
+  handle->syncErrors++;
+  return true;
+}
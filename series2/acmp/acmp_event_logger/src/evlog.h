@@ -0,0 +1,131 @@
+/***************************************************************************//**
+ * @file evlog.h
+ * @brief Batch analysis of comparator edge timestamps: debounce, hysteresis
+ * tracking and rate statistics.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EVLOG_H
+#define EVLOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Accepted (debounced) comparator transition
+typedef struct {
+  uint32_t timestamp;   ///< Timer ticks of the edge that started the level
+  uint8_t  level;       ///< Comparator output after the transition
+} EVLOG_Event_TypeDef;
+
+/// Results of one batch
+typedef struct {
+  uint32_t rawEdges;    ///< Captured edges in the batch
+  uint32_t events;      ///< Accepted transitions in the batch
+  uint32_t rejected;    ///< Edges that ended a level shorter than debounce
+  uint32_t minPulse;    ///< Shortest time between raw edges, in ticks
+  uint32_t spanTicks;   ///< Time covered by the batch
+  float    rawRate;     ///< Raw edges per second
+  float    eventRate;   ///< Accepted transitions per second
+  uint8_t  hystLevel;   ///< Recommended comparator hysteresis level
+  bool     hystChanged; ///< hystLevel differs from the previous batch
+} EVLOG_Stats_TypeDef;
+
+/// Analysis configuration
+typedef struct {
+  uint32_t tickHz;        ///< Timestamp clock
+  uint32_t debounceUs;    ///< Time a level must be held to be accepted
+  uint16_t chatterLimit;  ///< Rejected edges per batch that raise hysteresis
+  uint16_t quietBatches;  ///< Batches without chatter that lower hysteresis
+  uint8_t  hystMax;       ///< Highest hysteresis level
+} EVLOG_Init_TypeDef;
+
+/// Default configuration: 1 MHz timestamps, 2 ms debounce
+#define EVLOG_INIT_DEFAULT                                            \
+  {                                                                   \
+    1000000,  /* 1 MHz timestamps */                                  \
+    2000,     /* Accept levels held for 2 ms */                       \
+    4,        /* Raise hysteresis at 4 chatter edges per batch */     \
+    16,       /* Lower hysteresis after 16 quiet batches */           \
+    3,        /* Hysteresis levels 0..3 */                            \
+  }
+
+/// Analysis state; all fields are read-only for the application
+typedef struct {
+  EVLOG_Init_TypeDef config;
+  uint32_t debounceTicks;
+  uint32_t readIndex;       ///< Next ring entry to process
+  uint32_t lastEdge;        ///< Timestamp of the last raw edge
+  uint32_t lastBatch;       ///< Time the last batch ended
+  uint8_t  rawLevel;        ///< Comparator output after the last raw edge
+  uint8_t  stableLevel;     ///< Debounced comparator output
+  bool     pending;         ///< rawLevel not yet held for debounceTicks
+  uint8_t  hystLevel;
+  uint16_t quietCount;
+
+  uint32_t totalEdges;
+  uint32_t totalEvents;
+  uint32_t totalRejected;
+  uint32_t syncErrors;      ///< Level corrections made by EVLOG_Resync()
+} EVLOG_Handle_TypeDef;
+
+void EVLOG_Init(EVLOG_Handle_TypeDef *handle,
+                const EVLOG_Init_TypeDef *init,
+                uint8_t level,
+                uint32_t now);
+uint32_t EVLOG_Process(EVLOG_Handle_TypeDef *handle,
+                       const volatile uint32_t *ring,
+                       uint32_t ringSize,
+                       uint32_t writeIndex,
+                       uint32_t now,
+                       EVLOG_Event_TypeDef *events,
+                       uint32_t maxEvents,
+                       EVLOG_Stats_TypeDef *stats);
+bool EVLOG_Resync(EVLOG_Handle_TypeDef *handle, uint8_t level);
+
+#if !defined(EVLOG_HOST)
+uint32_t EVLOG_CaptureStart(volatile uint32_t *ring,
+                            uint32_t ringSize,
+                            unsigned int prsChannel,
+                            unsigned int ldmaChannel);
+uint32_t EVLOG_CaptureWriteIndex(const volatile uint32_t *ring,
+                                 unsigned int ldmaChannel);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVLOG_H
@@ -0,0 +1,291 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief This project logs ACMP output transitions without an interrupt per
+ * edge: the comparator output is timestamped by TIMER0 through the PRS, the
+ * LDMA collects the timestamps in a ring buffer and the CPU debounces and
+ * analyzes them once per batch.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_acmp.h"
+#include "em_burtc.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_prs.h"
+#include "em_timer.h"
+
+#include "bsp.h"
+
+#include "mx25flash_spi.h"
+#include "evlog.h"
+
+#define LED0_PORT             BSP_GPIO_LED0_PORT
+#define LED0_PIN              BSP_GPIO_LED0_PIN
+#define ACMP_INPUT_PORT_PIN   acmpInputPB1
+
+// PRS channel carrying the ACMP output to TIMER0 CC0
+#define ACMP_PRS_CH           0
+
+// LDMA channel copying captures into the timestamp ring
+#define CAPTURE_LDMA_CH       0
+
+// One wake-up per half ring of edges
+#define CAPTURE_RING          64
+
+// Flush partial batches once per second (1 kHz ULFRCO clocks)
+#define FLUSH_PERIOD          1000
+
+// Accepted transitions kept for inspection
+#define EVENT_LOG_SIZE        32
+
+// Comparator hysteresis for each level recommended by EVLOG
+static const ACMP_HysteresisLevel_TypeDef hysteresis[] = {
+  acmpHysteresisDisabled,
+  acmpHysteresis10Sym,
+  acmpHysteresis20Sym,
+  acmpHysteresis30Sym
+};
+
+// Written by the LDMA only
+static volatile uint32_t captureRing[CAPTURE_RING];
+
+// Watch these in the debugger
+EVLOG_Handle_TypeDef evlog;
+EVLOG_Stats_TypeDef lastStats;
+EVLOG_Event_TypeDef eventLog[EVENT_LOG_SIZE];
+uint32_t eventLogCount = 0;
+
+/**************************************************************************//**
+ * @brief escapeHatch()
+ *
+ * When developing or debugging code that enters EM2 or lower, it's a
+ * good idea to have an "escape hatch" type mechanism, e.g. a way to
+ * pause the device so that a debugger can connect in order to erase
+ * flash, among other things.
+ *
+ * Before proceeding with this example, make sure PB0 is not pressed.
+ * If the PB0 pin is low, turn on LED0 and execute the breakpoint (BKPT)
+ * instruction to stop the processor in EM0 and allow a debug
+ * connection to be made.
+ *****************************************************************************/
+void escapeHatch(void)
+{
+  // Configure PB0 pin as an input pulled high
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
+
+  // Check for PB0 low; if so halt the CPU
+  if (GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == 0) {
+    GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 1);
+    __BKPT(0);
+  }
+  // Pin not asserted; disable the PB0 digital input
+  else {
+    GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeDisabled, 0);
+  }
+}
+
+/**************************************************************************//**
+ * @brief ACMP initialization
+ *
+ * @param[in] hystLevel
+ *   Index into the hysteresis table.
+ *
+ * @param[in] level
+ *   Output to drive while the ACMP is being reconfigured, so that changing
+ *   the hysteresis does not produce edges.
+ *****************************************************************************/
+void initACMP(uint8_t hystLevel, uint8_t level)
+{
+  CMU_ClockEnable(cmuClock_ACMP0, true);
+
+  ACMP_Init_TypeDef init = ACMP_INIT_DEFAULT;
+  init.hysteresisLevel = hysteresis[hystLevel];
+  init.inactiveValue = level;
+  ACMP_Init(ACMP0, &init);
+
+  // Allocate BODD0 to ACMP0 to be able to use the input
+  GPIO->BBUSALLOC = GPIO_BBUSALLOC_BODD0_ACMP0;
+
+  // Compare the input pin against the undivided 1.25 V reference
+  ACMP_ChannelSet(ACMP0, acmpInputVREFDIV1V25, ACMP_INPUT_PORT_PIN);
+
+  // Wait for warm-up
+  while (!(ACMP0->IF & ACMP_IF_ACMPRDY));
+  ACMP_IntClear(ACMP0, ACMP_IF_ACMPRDY);
+}
+
+/**************************************************************************//**
+ * @brief PRS initialization; routes the ACMP output to ACMP_PRS_CH
+ *****************************************************************************/
+void initPRS(void)
+{
+  CMU_ClockEnable(cmuClock_PRS, true);
+  PRS_ConnectSignal(ACMP_PRS_CH, prsTypeAsync, prsSignalACMP0_OUT);
+}
+
+/**************************************************************************//**
+ * @brief BURTC initialization; wakes the CPU every FLUSH_PERIOD to process
+ *        edges that have not filled half of the ring
+ *****************************************************************************/
+void initBURTC(void)
+{
+  CMU_ClockSelectSet(cmuClock_EM4GRPACLK, cmuSelect_ULFRCO);
+  CMU_ClockEnable(cmuClock_BURTC, true);
+
+  BURTC_Init_TypeDef burtcInit = BURTC_INIT_DEFAULT;
+  burtcInit.compare0Top = true; // reset counter when counter reaches compare value
+  BURTC_Init(&burtcInit);
+
+  BURTC_CounterReset();
+  BURTC_CompareSet(0, FLUSH_PERIOD);
+
+  BURTC_IntEnable(BURTC_IEN_COMP);  // compare match
+  NVIC_EnableIRQ(BURTC_IRQn);
+  BURTC_Enable(true);
+}
+
+/**************************************************************************//**
+ * @brief  LDMA Handler; only wakes the CPU once per half ring of edges
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  LDMA_IntClear(LDMA_IntGet());
+}
+
+/**************************************************************************//**
+ * @brief  BURTC Handler; only wakes the CPU
+ *****************************************************************************/
+void BURTC_IRQHandler(void)
+{
+  BURTC_IntClear(BURTC_IF_COMP);
+}
+
+/**************************************************************************//**
+ * @brief  Current ACMP output
+ *****************************************************************************/
+static uint8_t acmpLevel(void)
+{
+  return (ACMP0->STATUS & ACMP_STATUS_ACMPOUT) ? 1 : 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Process the timestamps captured since the last wake-up.
+ *****************************************************************************/
+void processBatch(void)
+{
+  EVLOG_Event_TypeDef events[CAPTURE_RING];
+  uint32_t now, first, last, n, i;
+  uint8_t level;
+
+  // Every edge before now is in the ring once first has been read
+  now = TIMER_CounterGet(TIMER0);
+  first = EVLOG_CaptureWriteIndex(captureRing, CAPTURE_LDMA_CH);
+  level = acmpLevel();
+  last = EVLOG_CaptureWriteIndex(captureRing, CAPTURE_LDMA_CH);
+
+  n = EVLOG_Process(&evlog, captureRing, CAPTURE_RING, first, now,
+                    events, CAPTURE_RING, &lastStats);
+
+  // The level only belongs to the processed edges if none arrived meanwhile
+  if (first == last) {
+    EVLOG_Resync(&evlog, level);
+  }
+
+  for (i = 0; i < n; i++) {
+    eventLog[eventLogCount % EVENT_LOG_SIZE] = events[i];
+    eventLogCount++;
+  }
+
+  if (lastStats.hystChanged) {
+    initACMP(lastStats.hystLevel, evlog.stableLevel);
+  }
+
+  // LED0 is on while the debounced input is below the reference
+  if (evlog.stableLevel) {
+    GPIO_PinOutClear(LED0_PORT, LED0_PIN);
+  } else {
+    GPIO_PinOutSet(LED0_PORT, LED0_PIN);
+  }
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  EVLOG_Init_TypeDef evlogInit = EVLOG_INIT_DEFAULT;
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  FlashStatus status;
+
+  // Workarounds for any errata
+  CHIP_Init();
+
+  // Turn on GPIO clock before checking escape hatch
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  // Halt if PB0 held before starting to allow debug access
+  escapeHatch();
+
+  GPIO_PinModeSet(LED0_PORT, LED0_PIN, gpioModePushPull, 0);
+
+  // Power-down MX25 SPI flash
+  MX25_init();
+  MX25_RSTEN();
+  MX25_RST(&status);
+  MX25_DP();
+  MX25_deinit();
+
+  initACMP(0, 0);
+  initPRS();
+
+  LDMA_Init(&ldmaInit);
+  evlogInit.tickHz = EVLOG_CaptureStart(captureRing, CAPTURE_RING,
+                                        ACMP_PRS_CH, CAPTURE_LDMA_CH);
+  EVLOG_Init(&evlog, &evlogInit, acmpLevel(), TIMER_CounterGet(TIMER0));
+
+  initBURTC();
+
+  /*
+   * The LDMA does not run in EM2, so sleep in EM1. Edges are captured and
+   * stored without the CPU; it wakes when half of the ring is full or on
+   * the BURTC flush, whichever comes first.
+   */
+  while (1) {
+    EMU_EnterEM1();
+    processBatch();
+  }
+}
@@ -0,0 +1,313 @@
+/***************************************************************************//**
+ * @file evlog_sim.c
+ * @brief Host test and benchmark for the comparator event log analysis.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DEVLOG_HOST -I../src -o evlog_sim evlog_sim.c ../src/evlog.c
+ *   ./evlog_sim
+ *
+ * Synthetic traces of comparator edges are fed through a model of the LDMA
+ * capture ring: a batch is processed whenever half of the ring has been
+ * written, as after the LDMA interrupt, and once per second, as after the
+ * BURTC flush wake-up. The trace has three phases:
+ *
+ *   bounce   transitions with up to 6 short bounces each
+ *   chatter  transitions buried in 20 to 60 edges of near-threshold noise
+ *   clean    single-edge transitions
+ *
+ * The accepted events must match the transitions of the trace exactly, the
+ * recommended hysteresis must rise during the chatter phase and fall back to 0
+ * in the clean phase, and a dropped capture must be corrected by
+ * EVLOG_Resync() from the output level sampled after each batch. The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "evlog.h"
+
+#define RING_SIZE     64
+#define MAX_EDGES     100000
+#define MAX_EVENTS    4096
+#define TICK_HZ       1000000
+#define FLUSH_TICKS   TICK_HZ           // BURTC flush once per second
+#define START_TIME    0xFFF00000ull     // wraps the 32-bit timestamps
+
+typedef struct {
+  uint64_t edges[MAX_EDGES];
+  uint32_t edgeCount;
+  EVLOG_Event_TypeDef truth[MAX_EVENTS];
+  uint32_t truthCount;
+  uint64_t time;
+  uint8_t  level;
+  uint32_t phaseEnd[3];                 // edge count at the end of each phase
+} Trace_TypeDef;
+
+typedef struct {
+  EVLOG_Event_TypeDef events[MAX_EVENTS];
+  uint32_t eventCount;
+  uint32_t batches;
+  uint32_t rejected;
+  uint8_t  phaseHyst[3];                // hysteresis at the end of each phase
+  uint32_t syncErrors;
+} Result_TypeDef;
+
+static Trace_TypeDef trace;
+static Result_TypeDef result;
+static uint32_t seed = 12345;
+
+static uint32_t between(uint32_t lo, uint32_t hi)
+{
+  seed = seed * 1103515245u + 12345u;
+  return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Append one transition: an even number of bounce edges, then the edge
+ *   that settles the new level, then the time the level is held.
+ ******************************************************************************/
+static void transition(uint32_t bounces, uint32_t gapLo, uint32_t gapHi,
+                       uint32_t holdLo, uint32_t holdHi)
+{
+  uint32_t i;
+
+  bounces &= ~1u;
+  for (i = 0; i < bounces; i++) {
+    trace.edges[trace.edgeCount++] = trace.time;
+    trace.time += between(gapLo, gapHi);
+  }
+  trace.edges[trace.edgeCount++] = trace.time;
+  trace.level ^= 1;
+  trace.truth[trace.truthCount].timestamp = (uint32_t)trace.time;
+  trace.truth[trace.truthCount].level = trace.level;
+  trace.truthCount++;
+  trace.time += between(holdLo, holdHi);
+}
+
+static void buildTrace(void)
+{
+  uint32_t i;
+
+  memset(&trace, 0, sizeof(trace));
+  trace.time = START_TIME + 10000;
+  trace.level = 1;
+
+  for (i = 0; i < 40; i++) {
+    transition(between(0, 6), 20, 400, 30000, 150000);
+  }
+  trace.phaseEnd[0] = trace.edgeCount;
+  for (i = 0; i < 40; i++) {
+    transition(between(20, 60), 5, 300, 5000, 40000);
+  }
+  trace.phaseEnd[1] = trace.edgeCount;
+  for (i = 0; i < 300; i++) {
+    transition(0, 0, 0, 100000, 300000);
+  }
+  trace.phaseEnd[2] = trace.edgeCount;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Output level at a time, counting every edge of the trace.
+ ******************************************************************************/
+static uint8_t levelAt(uint64_t t)
+{
+  uint32_t i;
+  uint8_t level = 1;
+
+  for (i = 0; i < trace.edgeCount && trace.edges[i] <= t; i++) {
+    level ^= 1;
+  }
+  return level;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Process one batch, as the main loop does after each wake-up.
+ ******************************************************************************/
+static void processBatch(EVLOG_Handle_TypeDef *h, const uint32_t *ring,
+                         uint32_t written, uint64_t now)
+{
+  EVLOG_Stats_TypeDef stats;
+
+  result.eventCount += EVLOG_Process(h, ring, RING_SIZE, written,
+                                     (uint32_t)now,
+                                     &result.events[result.eventCount],
+                                     MAX_EVENTS - result.eventCount, &stats);
+  result.batches++;
+  result.rejected += stats.rejected;
+  EVLOG_Resync(h, levelAt(now));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Feed the trace through the capture ring model, optionally dropping one
+ *   capture, and resynchronize after each batch.
+ ******************************************************************************/
+static void run(int dropEdge)
+{
+  static uint32_t ring[RING_SIZE];
+  EVLOG_Init_TypeDef init = EVLOG_INIT_DEFAULT;
+  EVLOG_Handle_TypeDef h;
+  uint64_t nextFlush = START_TIME + FLUSH_TICKS;
+  uint64_t end = trace.time + 2 * FLUSH_TICKS;
+  uint32_t written = 0, i, phase = 0;
+
+  memset(&result, 0, sizeof(result));
+  init.tickHz = TICK_HZ;
+  EVLOG_Init(&h, &init, 1, (uint32_t)START_TIME);
+
+  for (i = 0; i <= trace.edgeCount; i++) {
+    uint64_t t = i < trace.edgeCount ? trace.edges[i] : end;
+
+    // BURTC flush wake-ups before this edge
+    while (nextFlush <= t) {
+      processBatch(&h, ring, written, nextFlush);
+      nextFlush += FLUSH_TICKS;
+    }
+    while (phase < 3 && i == trace.phaseEnd[phase]) {
+      result.phaseHyst[phase++] = h.hystLevel;
+    }
+    if (i == trace.edgeCount) {
+      break;
+    }
+    if ((int)i == dropEdge) {
+      continue;
+    }
+
+    ring[written % RING_SIZE] = (uint32_t)t;
+    written++;
+
+    // LDMA half-ring interrupt, handled before the next capture
+    if (written % (RING_SIZE / 2) == 0) {
+      uint64_t now = t + 10;
+
+      if (i + 1 < trace.edgeCount && trace.edges[i + 1] <= now) {
+        now = trace.edges[i + 1] - 1;
+      }
+      processBatch(&h, ring, written, now);
+    }
+  }
+  result.syncErrors = h.syncErrors;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Count the trace transitions missing from or wrong in the result.
+ ******************************************************************************/
+static uint32_t mismatches(void)
+{
+  uint32_t i, bad = 0;
+
+  for (i = 0; i < trace.truthCount; i++) {
+    if (i >= result.eventCount
+        || result.events[i].timestamp != trace.truth[i].timestamp
+        || result.events[i].level != trace.truth[i].level) {
+      bad++;
+    }
+  }
+  return bad + (result.eventCount > trace.truthCount
+                ? result.eventCount - trace.truthCount : 0);
+}
+
+static void benchmark(void)
+{
+  static uint32_t ring[RING_SIZE];
+  static EVLOG_Event_TypeDef events[RING_SIZE];
+  EVLOG_Init_TypeDef init = EVLOG_INIT_DEFAULT;
+  EVLOG_Handle_TypeDef h;
+  EVLOG_Stats_TypeDef stats;
+  uint32_t batches = 200000, i, k, t = 0;
+  clock_t start;
+  double seconds;
+
+  EVLOG_Init(&h, &init, 1, 0);
+  start = clock();
+  for (i = 0; i < batches; i++) {
+    // Half a ring per batch, alternating chatter and clean edges
+    for (k = 0; k < RING_SIZE / 2; k++) {
+      t += (k & 3) ? 150 : 5000;
+      ring[(i * (RING_SIZE / 2) + k) % RING_SIZE] = t;
+    }
+    EVLOG_Process(&h, ring, RING_SIZE, (i + 1) * (RING_SIZE / 2), t + 10,
+                  events, RING_SIZE, &stats);
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("benchmark: %lu edges in %.3f s, %.1f M edges/s\n",
+         (unsigned long)h.totalEdges, seconds, h.totalEdges / seconds / 1e6);
+}
+
+int main(void)
+{
+  int failures = 0;
+  uint32_t bad;
+
+  buildTrace();
+  printf("trace: %lu edges, %lu transitions\n",
+         (unsigned long)trace.edgeCount, (unsigned long)trace.truthCount);
+
+  run(-1);
+  bad = mismatches();
+  printf("batched: %lu events, %lu chatter edges, %lu wake-ups instead of "
+         "%lu, %lu mismatches\n",
+         (unsigned long)result.eventCount, (unsigned long)result.rejected,
+         (unsigned long)result.batches, (unsigned long)trace.edgeCount,
+         (unsigned long)bad);
+  printf("hysteresis at end of bounce/chatter/clean phase: %u %u %u\n",
+         result.phaseHyst[0], result.phaseHyst[1], result.phaseHyst[2]);
+  if (bad != 0 || result.syncErrors != 0) {
+    printf("  events do not match the trace\n");
+    failures++;
+  }
+  if (result.phaseHyst[1] == 0 || result.phaseHyst[2] != 0) {
+    printf("  hysteresis not tracking the chatter\n");
+    failures++;
+  }
+
+  // Lose one clean capture; the polarity must be corrected after one batch
+  run((int)trace.phaseEnd[1] + 10);
+  bad = mismatches();
+  printf("dropped capture: %lu sync error(s), %lu mismatches\n",
+         (unsigned long)result.syncErrors, (unsigned long)bad);
+  if (result.syncErrors != 1 || bad > 2) {
+    printf("  dropped capture not recovered\n");
+    failures++;
+  }
+
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
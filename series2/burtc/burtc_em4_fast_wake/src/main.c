@@ -0,0 +1,244 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Periodic EM4 wake-ups that restore their state from BURAM and skip
+ * the initialization a cold start needs, with each boot phase timed.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_burtc.h"
+#include "em_gpio.h"
+#include "bsp.h"
+#include "retargetserial.h"
+#include "stdio.h"
+#include "mx25flash_spi.h"
+
+#include "wake.h"
+
+// Number of 1 KHz ULFRCO clocks between EM4 wake-ups
+#define BURTC_WAKE_PERIOD   1000
+
+// Every this many wake-ups, also print a report
+#define REPORT_EVERY        10
+
+// Change whenever AppState_TypeDef changes, so old state is not restored
+#define STATE_LAYOUT        1
+
+// Boot phases, each timed from the start of main() in core clock cycles
+typedef enum {
+  PHASE_CHIP,               // CHIP_Init()
+  PHASE_RESTORE,            // Reset cause and BURAM state
+  PHASE_CLOCKS,
+  PHASE_PERIPHERALS,
+  PHASE_READY,              // First useful work done
+  PHASE_COUNT
+} Phase_TypeDef;
+
+static const char *const phaseNames[PHASE_COUNT] = {
+  "CHIP_Init()", "restore", "clocks", "peripherals", "first work"
+};
+
+static const char *const reasonNames[] = {
+  "power-on", "reset pin", "watchdog", "lockup", "software reset",
+  "EM4 wake-up", "EM4 wake-up, state lost"
+};
+
+// Everything the application keeps through EM4
+typedef struct {
+  uint32_t wakeups;                 // EM4 wake-ups since the cold start
+  uint32_t led;                     // LED0 level held through EM4
+  uint32_t wakeMs;                  // Wake-up event to main(), last wake-up
+  uint32_t cold[PHASE_COUNT];       // Phase times of the cold start
+  uint32_t fast[PHASE_COUNT];       // Phase times of the last wake-up
+} AppState_TypeDef;
+
+AppState_TypeDef state;
+WAKE_Timing_TypeDef timing;
+WAKE_Reason_TypeDef reason;
+
+/**************************************************************************//**
+ * @brief  Configure BURTC to wake from EM4 every BURTC_WAKE_PERIOD
+ *****************************************************************************/
+void initBURTC(void)
+{
+  BURTC_Init_TypeDef burtcInit = BURTC_INIT_DEFAULT;
+  burtcInit.compare0Top = true; // reset counter when counter reaches compare value
+  burtcInit.em4comp = true;     // BURTC compare interrupt wakes from EM4 (causes reset)
+  BURTC_Init(&burtcInit);
+
+  BURTC_CounterReset();
+  BURTC_CompareSet(0, BURTC_WAKE_PERIOD);
+  BURTC_IntEnable(BURTC_IEN_COMP);
+  BURTC_Enable(true);
+}
+
+/**************************************************************************//**
+ * @brief  Print the reset cause and the boot phase times
+ *****************************************************************************/
+void report(void)
+{
+  uint32_t mhz = CMU_ClockFreqGet(cmuClock_CORE) / 1000000;
+  int i;
+
+  printf("-- Reset cause: %s\n", reasonNames[reason]);
+  printf("-- EM4 wake-ups since the cold start: %lu\n", state.wakeups);
+  printf("-- Phase end, us from main():  cold start  last wake-up\n");
+  for (i = 0; i < PHASE_COUNT; i++) {
+    printf("   %-12s %21lu %13lu\n", phaseNames[i],
+           state.cold[i] / mhz, state.fast[i] / mhz);
+  }
+  if (state.wakeups > 0) {
+    printf("-- Wake-up event to main(): %lu ms (BURTC)\n", state.wakeMs);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Fast path after an EM4 wake-up with the state restored.
+ *
+ * @details
+ *   BURTC, its clock selection and the EM4 domain kept running through EM4,
+ *   and the serial flash is still powered down, so only the bus clocks and
+ *   the LED pin, whose level was held by pin retention, are set up again.
+ *   Returns only when a report is due.
+ *****************************************************************************/
+void fastWake(void)
+{
+  EMU_EM4Init_TypeDef em4Init = EMU_EM4INIT_DEFAULT;
+  uint32_t ticks;
+
+  CMU_ClockEnable(cmuClock_BURTC, true);
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  ticks = BURTC_CounterGet();
+  BURTC_IntClear(BURTC_IF_COMP);
+  WAKE_Stamp(&timing, PHASE_CLOCKS);
+
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN,
+                  gpioModePushPull, state.led);
+  EMU_UnlatchPinRetention();
+  em4Init.pinRetentionMode = emuPinRetentionLatch;
+  EMU_EM4Init(&em4Init);
+  WAKE_Stamp(&timing, PHASE_PERIPHERALS);
+
+  // The work each wake-up is for
+  state.led = !state.led;
+  GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  WAKE_Stamp(&timing, PHASE_READY);
+
+  state.wakeups++;
+  state.wakeMs = ticks;
+  memcpy(state.fast, timing.at, sizeof(state.fast));
+  if (state.wakeups % REPORT_EVERY != 0) {
+    WAKE_EnterEM4(STATE_LAYOUT, &state, sizeof(state));
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Cold start: everything is set up from reset.
+ *****************************************************************************/
+void coldStart(void)
+{
+  EMU_EM4Init_TypeDef em4Init = EMU_EM4INIT_DEFAULT;
+  FlashStatus status;
+
+  CMU_ClockSelectSet(cmuClock_EM4GRPACLK, cmuSelect_ULFRCO);
+  CMU_ClockEnable(cmuClock_BURTC, true);
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  WAKE_Stamp(&timing, PHASE_CLOCKS);
+
+  EMU_UnlatchPinRetention();
+
+  // Init and power-down MX25 SPI flash
+  MX25_init();
+  MX25_RSTEN();
+  MX25_RST(&status);
+  MX25_DP();
+  MX25_deinit();
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInput, 1);
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 1);
+  initBURTC();
+  em4Init.pinRetentionMode = emuPinRetentionLatch;
+  EMU_EM4Init(&em4Init);
+  WAKE_Stamp(&timing, PHASE_PERIPHERALS);
+
+  // Same work as a wake-up: the LED is on
+  state.led = 1;
+  WAKE_Stamp(&timing, PHASE_READY);
+  memcpy(state.cold, timing.at, sizeof(state.cold));
+}
+
+/**************************************************************************//**
+ * @brief	Main function
+ *****************************************************************************/
+int main(void)
+{
+  WAKE_CycleCounterStart();
+  WAKE_TimingStart(&timing, WAKE_Cycles);
+
+  CHIP_Init();
+  WAKE_Stamp(&timing, PHASE_CHIP);
+
+  reason = WAKE_Boot(STATE_LAYOUT, &state, sizeof(state));
+  WAKE_Stamp(&timing, PHASE_RESTORE);
+
+  if (reason == wakeEm4) {
+    // Back here only every REPORT_EVERY wake-ups
+    fastWake();
+    RETARGET_SerialInit();
+    RETARGET_SerialCrLf(1);
+    report();
+  } else {
+    coldStart();
+    report();
+
+    // Wait for user to press PB0, reset BURTC counter
+    printf("Press PB0 to enter EM4 \n");
+    while(GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == 1);
+    BURTC_CounterReset();
+  }
+
+  printf("Entering EM4, waking every %d ms \n\n", BURTC_WAKE_PERIOD);
+  RETARGET_SerialFlush(); // delay for printf to finish
+  WAKE_EnterEM4(STATE_LAYOUT, &state, sizeof(state));
+
+  // This line should never be reached
+  while(1);
+}
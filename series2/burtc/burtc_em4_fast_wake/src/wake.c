@@ -0,0 +1,296 @@
+/***************************************************************************//**
+ * @file wake.c
+ * @brief EM4 wake-up path: application state kept in BURAM with a CRC, the
+ * reset cause classified, and boot phases timed.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "wake.h"
+
+#if !defined(WAKE_HOST)
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_rmu.h"
+
+static volatile uint32_t *retention(void)
+{
+  return &BURAM->RET[0].REG;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the core cycle counter (DWT_CYCCNT) from zero.
+ *****************************************************************************/
+void WAKE_CycleCounterStart(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t WAKE_Cycles(void)
+{
+  return DWT->CYCCNT;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Read and clear the reset cause and, after an EM4 wake-up, restore the
+ *   state saved by WAKE_EnterEM4().
+ *
+ * @details
+ *   After any other reset the saved state is discarded, so it cannot be
+ *   restored by a later wake-up.
+ *****************************************************************************/
+WAKE_Reason_TypeDef WAKE_Boot(uint8_t layout, void *state, uint32_t size)
+{
+  uint32_t rstcause = RMU_ResetCauseGet();
+  uint32_t cause = 0;
+  bool restored = false;
+
+  RMU_ResetCauseClear();
+#if defined(_CMU_CLKEN0_BURAM_MASK)
+  CMU_ClockEnable(cmuClock_BURAM, true);
+#endif
+
+  // Only the causes told apart; brown-outs and others count as power-on
+  cause |= (rstcause & EMU_RSTCAUSE_POR) ? WAKE_CAUSE_POR : 0;
+  cause |= (rstcause & EMU_RSTCAUSE_PIN) ? WAKE_CAUSE_PIN : 0;
+  cause |= (rstcause & EMU_RSTCAUSE_EM4) ? WAKE_CAUSE_EM4 : 0;
+  cause |= (rstcause & EMU_RSTCAUSE_WDOG0) ? WAKE_CAUSE_WDOG0 : 0;
+#if defined(EMU_RSTCAUSE_WDOG1)
+  cause |= (rstcause & EMU_RSTCAUSE_WDOG1) ? WAKE_CAUSE_WDOG1 : 0;
+#endif
+  cause |= (rstcause & EMU_RSTCAUSE_LOCKUP) ? WAKE_CAUSE_LOCKUP : 0;
+  cause |= (rstcause & EMU_RSTCAUSE_SYSREQ) ? WAKE_CAUSE_SYSREQ : 0;
+  if (cause == 0) {
+    cause = WAKE_CAUSE_POR;
+  }
+
+  if (cause == WAKE_CAUSE_EM4) {
+    restored = WAKE_Restore(retention(), layout, state, size) == wakeRestored;
+  } else {
+    WAKE_Invalidate(retention());
+  }
+  return WAKE_Classify(cause, restored);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Save the state to BURAM and enter EM4; EMU_EM4Init() must have been
+ *   called.
+ *****************************************************************************/
+void WAKE_EnterEM4(uint8_t layout, const void *state, uint32_t size)
+{
+  WAKE_Save(retention(), layout, state, size);
+  EMU_EnterEM4();
+}
+#endif // !WAKE_HOST
+
+// Header word: magic, layout version, state size in bytes
+#define WAKE_MAGIC        0x574BUL        // "WK"
+#define HEADER(l, s)      ((WAKE_MAGIC << 16) | ((uint32_t)(l) << 8) | (s))
+#define HDR_MAGIC(h)      ((h) >> 16)
+
+/**************************************************************************//**
+ * @brief
+ *   CRC-32 (IEEE 802.3) of words, four bits at a time.
+ *****************************************************************************/
+static uint32_t crc32(uint32_t crc, uint32_t word)
+{
+  static const uint32_t nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+  int i;
+
+  crc ^= word;
+  for (i = 0; i < 8; i++) {
+    crc = (crc >> 4) ^ nibble[crc & 15];
+  }
+  return crc;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Store the state in the retention registers, with a header naming its
+ *   layout version and size and a CRC over both.
+ *
+ * @details
+ *   The header is written last, so a reset part way through leaves no
+ *   valid-looking state. Returns false if the state is too large.
+ *****************************************************************************/
+bool WAKE_Save(volatile uint32_t *ret,
+               uint8_t layout,
+               const void *state,
+               uint32_t size)
+{
+  uint32_t words = (size + 3) / 4;
+  uint32_t header = HEADER(layout, size);
+  uint32_t crc;
+  uint32_t n;
+  uint32_t w;
+  uint32_t i;
+
+  if (size > WAKE_MAX_STATE) {
+    return false;
+  }
+  ret[0] = 0;
+  crc = crc32(0xFFFFFFFFUL, header);
+  for (i = 0; i < words; i++) {
+    n = size - 4 * i < 4 ? size - 4 * i : 4;
+    w = 0;
+    memcpy(&w, (const uint8_t *)state + 4 * i, n);
+    ret[1 + i] = w;
+    crc = crc32(crc, w);
+  }
+  ret[1 + words] = ~crc;
+  ret[0] = header;
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Copy the saved state out if it has the expected layout and size and an
+ *   intact CRC.
+ *
+ * @details
+ *   The saved state is discarded either way, so it is restored at most
+ *   once: a wake-up without a fresh save starts cold.
+ *****************************************************************************/
+WAKE_Restore_TypeDef WAKE_Restore(volatile uint32_t *ret,
+                                  uint8_t layout,
+                                  void *state,
+                                  uint32_t size)
+{
+  uint32_t words = (size + 3) / 4;
+  uint32_t header = ret[0];
+  uint32_t crc;
+  uint32_t n;
+  uint32_t w;
+  uint32_t i;
+
+  ret[0] = 0;
+  if (HDR_MAGIC(header) != WAKE_MAGIC) {
+    return wakeErrEmpty;
+  }
+  if (header != HEADER(layout, size) || size > WAKE_MAX_STATE) {
+    return wakeErrLayout;
+  }
+  crc = crc32(0xFFFFFFFFUL, header);
+  for (i = 0; i < words; i++) {
+    crc = crc32(crc, ret[1 + i]);
+  }
+  if (~crc != ret[1 + words]) {
+    return wakeErrCrc;
+  }
+  for (i = 0; i < words; i++) {
+    n = size - 4 * i < 4 ? size - 4 * i : 4;
+    w = ret[1 + i];
+    memcpy((uint8_t *)state + 4 * i, &w, n);
+  }
+  return wakeRestored;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Discard any saved state.
+ *****************************************************************************/
+void WAKE_Invalidate(volatile uint32_t *ret)
+{
+  ret[0] = 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Tell why the device started from the reset cause bits (WAKE_CAUSE_x)
+ *   and whether the EM4 state was restored.
+ *
+ * @details
+ *   Several bits can be set together; power-on wins over everything, then
+ *   the reset pin, watchdogs, lockup and software resets, so a wake-up
+ *   counts as one only when EM4 is the sole cause.
+ *****************************************************************************/
+WAKE_Reason_TypeDef WAKE_Classify(uint32_t cause, bool restored)
+{
+  if (cause & WAKE_CAUSE_POR) {
+    return wakeCold;
+  }
+  if (cause & WAKE_CAUSE_PIN) {
+    return wakePin;
+  }
+  if (cause & (WAKE_CAUSE_WDOG0 | WAKE_CAUSE_WDOG1)) {
+    return wakeWatchdog;
+  }
+  if (cause & WAKE_CAUSE_LOCKUP) {
+    return wakeLockup;
+  }
+  if (cause & WAKE_CAUSE_SYSREQ) {
+    return wakeSoftware;
+  }
+  if (cause == WAKE_CAUSE_EM4) {
+    return restored ? wakeEm4 : wakeEm4Lost;
+  }
+  return wakeCold;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start timing boot phases from now, with a free-running clock such as
+ *   WAKE_Cycles().
+ *****************************************************************************/
+void WAKE_TimingStart(WAKE_Timing_TypeDef *timing, uint32_t (*now)(void))
+{
+  memset(timing, 0, sizeof(*timing));
+  timing->now = now;
+  timing->start = now();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Record the end of a boot phase; the instrumentation hook placed at each
+ *   step of the boot.
+ *****************************************************************************/
+void WAKE_Stamp(WAKE_Timing_TypeDef *timing, uint8_t phase)
+{
+  if (phase < WAKE_PHASES) {
+    timing->at[phase] = timing->now() - timing->start;
+    if (phase >= timing->phases) {
+      timing->phases = phase + 1;
+    }
+  }
+}
@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @file wake.h
+ * @brief EM4 wake-up path: application state kept in BURAM with a CRC, the
+ * reset cause classified, and boot phases timed.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef WAKE_H
+#define WAKE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// BURAM retention registers
+#define WAKE_RET_WORDS      32
+
+/// Largest state kept: the registers less a header and a CRC word
+#define WAKE_MAX_STATE      ((WAKE_RET_WORDS - 2) * 4)
+
+/// Boot phases that can be timed
+#define WAKE_PHASES         8
+
+/// Reset cause bits as in EMU_RSTCAUSE
+#define WAKE_CAUSE_POR      0x00000001UL
+#define WAKE_CAUSE_PIN      0x00000002UL
+#define WAKE_CAUSE_EM4      0x00000004UL
+#define WAKE_CAUSE_WDOG0    0x00000008UL
+#define WAKE_CAUSE_WDOG1    0x00000010UL
+#define WAKE_CAUSE_LOCKUP   0x00000020UL
+#define WAKE_CAUSE_SYSREQ   0x00000040UL
+
+/// Why the device started, in order of precedence
+typedef enum {
+  wakeCold,             ///< Power-on, brown-out or unknown: nothing kept
+  wakePin,              ///< Reset pin
+  wakeWatchdog,
+  wakeLockup,           ///< Core lockup
+  wakeSoftware,         ///< System reset request
+  wakeEm4,              ///< EM4 wake-up, state restored: fast path
+  wakeEm4Lost           ///< EM4 wake-up, state missing or corrupt
+} WAKE_Reason_TypeDef;
+
+/// Result of restoring the state
+typedef enum {
+  wakeRestored,
+  wakeErrEmpty,         ///< No state saved, or already restored once
+  wakeErrLayout,        ///< Saved with another layout version or size
+  wakeErrCrc            ///< Retention registers corrupt
+} WAKE_Restore_TypeDef;
+
+/// Boot phase times, in units of the clock given to WAKE_TimingStart()
+typedef struct {
+  uint32_t (*now)(void);
+  uint32_t start;
+  uint32_t at[WAKE_PHASES];     ///< Time from start to the end of each phase
+  uint8_t  phases;              ///< Highest phase stamped, plus one
+} WAKE_Timing_TypeDef;
+
+bool WAKE_Save(volatile uint32_t *ret,
+               uint8_t layout,
+               const void *state,
+               uint32_t size);
+WAKE_Restore_TypeDef WAKE_Restore(volatile uint32_t *ret,
+                                  uint8_t layout,
+                                  void *state,
+                                  uint32_t size);
+void WAKE_Invalidate(volatile uint32_t *ret);
+WAKE_Reason_TypeDef WAKE_Classify(uint32_t cause, bool restored);
+void WAKE_TimingStart(WAKE_Timing_TypeDef *timing, uint32_t (*now)(void));
+void WAKE_Stamp(WAKE_Timing_TypeDef *timing, uint8_t phase);
+
+#if !defined(WAKE_HOST)
+void WAKE_CycleCounterStart(void);
+uint32_t WAKE_Cycles(void);
+WAKE_Reason_TypeDef WAKE_Boot(uint8_t layout, void *state, uint32_t size);
+void WAKE_EnterEM4(uint8_t layout, const void *state, uint32_t size);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAKE_H
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file wake_sim.c
+ * @brief Host test and benchmark for the EM4 state snapshot codec, reset
+ * cause classification and boot phase timing.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DWAKE_HOST -I../src -o wake_sim wake_sim.c ../src/wake.c
+ *   ./wake_sim
+ *
+ * An array stands in for the BURAM retention registers. Every state size
+ * is saved and restored; every single-bit error, a reset part way through
+ * a save and layout changes must be refused. The exit status is non-zero
+ * if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "wake.h"
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static volatile uint32_t buram[WAKE_RET_WORDS];
+static uint32_t rng = 12345;
+
+static uint32_t rnd(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+static void randomState(uint8_t *s, uint32_t size)
+{
+  uint32_t i;
+
+  for (i = 0; i < size; i++) {
+    s[i] = (uint8_t)rnd();
+  }
+}
+
+static void testRoundTrip(void)
+{
+  uint8_t state[WAKE_MAX_STATE];
+  uint8_t out[WAKE_MAX_STATE + 4];
+  uint32_t size;
+  int ok = 1;
+
+  for (size = 0; size <= WAKE_MAX_STATE; size++) {
+    randomState(state, size);
+    memset(out, 0xEE, sizeof(out));
+    check(WAKE_Save(buram, 3, state, size), "state saved");
+    ok &= WAKE_Restore(buram, 3, out, size) == wakeRestored;
+    ok &= memcmp(out, state, size) == 0;
+    ok &= out[size] == 0xEE;
+    ok &= WAKE_Restore(buram, 3, out, size) == wakeErrEmpty;
+  }
+  check(ok, "every size restored exactly once, nothing written past it");
+  check(!WAKE_Save(buram, 3, state, WAKE_MAX_STATE + 1), "oversize refused");
+}
+
+static void testCorruption(void)
+{
+  uint8_t state[40];
+  uint8_t out[40];
+  uint8_t before[40];
+  uint32_t saved[WAKE_RET_WORDS];
+  uint32_t after[WAKE_RET_WORDS];
+  uint32_t word;
+  uint32_t bit;
+  uint32_t i;
+  int refused = 1;
+  int restored;
+
+  randomState(state, sizeof(state));
+  WAKE_Save(buram, 1, state, sizeof(state));
+  for (i = 0; i < WAKE_RET_WORDS; i++) {
+    saved[i] = buram[i];
+  }
+
+  // Any one bit of the header, state or CRC
+  for (word = 0; word < 2 + sizeof(state) / 4; word++) {
+    for (bit = 0; bit < 32; bit++) {
+      for (i = 0; i < WAKE_RET_WORDS; i++) {
+        buram[i] = saved[i];
+      }
+      buram[word] ^= 1u << bit;
+      refused &= WAKE_Restore(buram, 1, out, sizeof(out)) != wakeRestored;
+    }
+  }
+  check(refused, "every single-bit error refused");
+
+  // A reset after any number of register writes of a new save: the
+  // header is cleared first and written last
+  memcpy(before, state, sizeof(state));
+  randomState(state, sizeof(state));
+  WAKE_Save(buram, 1, state, sizeof(state));
+  for (i = 0; i < WAKE_RET_WORDS; i++) {
+    after[i] = buram[i];
+  }
+  for (word = 0; word <= 3 + sizeof(state) / 4; word++) {
+    for (i = 0; i < WAKE_RET_WORDS; i++) {
+      buram[i] = saved[i];
+    }
+    if (word >= 1) {
+      buram[0] = 0;
+    }
+    for (i = 1; i < word && i < 2 + sizeof(state) / 4; i++) {
+      buram[i] = after[i];
+    }
+    if (word == 3 + sizeof(state) / 4) {
+      buram[0] = after[0];
+    }
+    restored = WAKE_Restore(buram, 1, out, sizeof(out)) == wakeRestored;
+    check(restored == (word == 0 || word == 3 + sizeof(state) / 4),
+          "interrupted save restores nothing");
+    check(!restored || memcmp(out, word == 0 ? before : state,
+                              sizeof(out)) == 0,
+          "complete save restores the old or the new state");
+  }
+
+  // Other layout or size, e.g. after a firmware update
+  WAKE_Save(buram, 1, state, sizeof(state));
+  check(WAKE_Restore(buram, 2, out, sizeof(out)) == wakeErrLayout,
+        "other layout refused");
+  WAKE_Save(buram, 1, state, sizeof(state));
+  check(WAKE_Restore(buram, 1, out, sizeof(out) - 4) == wakeErrLayout,
+        "other size refused");
+  WAKE_Save(buram, 1, state, sizeof(state));
+  WAKE_Invalidate(buram);
+  check(WAKE_Restore(buram, 1, out, sizeof(out)) == wakeErrEmpty,
+        "invalidated state refused");
+  for (i = 0; i < WAKE_RET_WORDS; i++) {
+    buram[i] = rnd();
+  }
+  check(WAKE_Restore(buram, 1, out, sizeof(out)) != wakeRestored,
+        "power-on contents refused");
+}
+
+static void testClassify(void)
+{
+  static const struct {
+    uint32_t cause;
+    bool restored;
+    WAKE_Reason_TypeDef reason;
+  } cases[] = {
+    { WAKE_CAUSE_POR, false, wakeCold },
+    { WAKE_CAUSE_POR | WAKE_CAUSE_PIN, false, wakeCold },
+    { WAKE_CAUSE_POR | WAKE_CAUSE_EM4, true, wakeCold },
+    { WAKE_CAUSE_PIN, false, wakePin },
+    { WAKE_CAUSE_PIN | WAKE_CAUSE_EM4, true, wakePin },
+    { WAKE_CAUSE_WDOG0, false, wakeWatchdog },
+    { WAKE_CAUSE_WDOG1 | WAKE_CAUSE_EM4, true, wakeWatchdog },
+    { WAKE_CAUSE_LOCKUP, false, wakeLockup },
+    { WAKE_CAUSE_SYSREQ, false, wakeSoftware },
+    { WAKE_CAUSE_EM4, true, wakeEm4 },
+    { WAKE_CAUSE_EM4, false, wakeEm4Lost },
+    { 0, false, wakeCold },
+    { 0x80000000UL, false, wakeCold },
+  };
+  uint32_t i;
+  int ok = 1;
+
+  for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    ok &= WAKE_Classify(cases[i].cause, cases[i].restored) == cases[i].reason;
+  }
+  check(ok, "reset causes classified");
+}
+
+static uint32_t fakeClock;
+
+static uint32_t fakeNow(void)
+{
+  return fakeClock;
+}
+
+static void testTiming(void)
+{
+  WAKE_Timing_TypeDef t;
+
+  fakeClock = 0xFFFFFF00UL;                 // Wraps during the boot
+  WAKE_TimingStart(&t, fakeNow);
+  fakeClock += 100;
+  WAKE_Stamp(&t, 0);
+  fakeClock += 300;
+  WAKE_Stamp(&t, 2);
+  WAKE_Stamp(&t, WAKE_PHASES);              // Ignored
+  check(t.at[0] == 100 && t.at[1] == 0 && t.at[2] == 400,
+        "phases timed across a clock wrap");
+  check(t.phases == 3, "phase count");
+}
+
+static void benchmark(void)
+{
+  uint8_t state[48];
+  uint8_t out[48];
+  uint32_t i;
+  uint32_t n = 1000000;
+  clock_t start;
+  double seconds;
+  int ok = 1;
+
+  randomState(state, sizeof(state));
+  start = clock();
+  for (i = 0; i < n; i++) {
+    state[0] = (uint8_t)i;
+    WAKE_Save(buram, 1, state, sizeof(state));
+    ok &= WAKE_Restore(buram, 1, out, sizeof(out)) == wakeRestored;
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  check(ok, "benchmark round trips");
+  printf("save and restore of %u bytes: %.0f ns on this host\n",
+         (unsigned)sizeof(state), seconds * 1e9 / n);
+}
+
+int main(void)
+{
+  testRoundTrip();
+  testCorruption();
+  testClassify();
+  testTiming();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures != 0;
+}
@@ -0,0 +1,245 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Keeps the HFRCODPLL and LFRCO on frequency with a background
+ * calibration service, so the HFXO can stay off.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_burtc.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "rcocal.h"
+
+// Nominal frequencies; the HFXO on the radio boards is 39 MHz
+#define HFRCO_HZ      19000000
+#define LFRCO_HZ      32768
+#define LFXO_HZ       32768
+#define HFXO_HZ       39000000
+
+/*
+ * Measurement windows.  The HFRCODPLL is counted for 1024 LFXO cycles
+ * (31 ms), the LFRCO window is 512 of its own cycles (16 ms) counted by
+ * the HFXO.  Both give counts near 600000, so one count is under 2 ppm,
+ * and both stay below the 20-bit limit of the up counter.
+ */
+#define HFRCO_TOP     1023
+#define LFRCO_TOP     511
+
+#define HFRCO_IDEAL   RCOCAL_IDEAL(HFRCO_HZ, LFXO_HZ, HFRCO_TOP)
+#define LFRCO_IDEAL   RCOCAL_IDEAL(HFXO_HZ, LFRCO_HZ, LFRCO_TOP)
+
+// Report interval, in service ticks of 1 s
+#define REPORT_TICKS  10
+
+/*
+ * Calibration table.  Ideal counts and their ppm scale are worked out
+ * here by the compiler.  The step sizes are typical; the service learns
+ * the real ones.  The LFXO is the reference for the HFRCODPLL and runs
+ * all the time.  The HFXO is only started for the LFRCO measurement,
+ * every 16 s.
+ */
+static const RCOCAL_Channel_TypeDef channels[] = {
+  {
+    .name = "HFRCODPLL",
+    .downTop = HFRCO_TOP,
+    .ideal = HFRCO_IDEAL,
+    .ppmScale = RCOCAL_PPM_SCALE(HFRCO_IDEAL),
+    .rcoCountsDown = false,
+    .stepPpm = 3000 * RCOCAL_Q,
+    .tuneMax = _HFRCO_CAL_TUNING_MASK >> _HFRCO_CAL_TUNING_SHIFT,
+    .interval = 1,
+    .osc = cmuOsc_HFRCODPLL,
+    .downSel = cmuSelect_LFXO,
+    .upSel = cmuSelect_HFRCODPLL,
+    .burstHFXO = false,
+  },
+  {
+    .name = "LFRCO",
+    .downTop = LFRCO_TOP,
+    .ideal = LFRCO_IDEAL,
+    .ppmScale = RCOCAL_PPM_SCALE(LFRCO_IDEAL),
+    .rcoCountsDown = true,
+    .stepPpm = 1000 * RCOCAL_Q,
+    .tuneMax = _LFRCO_CAL_FREQTRIM_MASK >> _LFRCO_CAL_FREQTRIM_SHIFT,
+    .interval = 16,
+    .osc = cmuOsc_LFRCO,
+    .downSel = cmuSelect_LFRCO,
+    .upSel = cmuSelect_HFXO,
+    .burstHFXO = true,
+  },
+};
+
+#define CHANNELS  (sizeof(channels) / sizeof(channels[0]))
+
+static RCOCAL_Handle_TypeDef cal;
+static volatile uint32_t tick;
+
+/**************************************************************************//**
+ * @brief
+ *   Oscillator setup.  The core, USART0 and all other high frequency
+ *   clocks run from the HFRCODPLL; the HFXO is configured but left off.
+ *****************************************************************************/
+void initCMU(void)
+{
+  CMU_LFXOInit_TypeDef lfxoInit = CMU_LFXOINIT_DEFAULT;
+  CMU_HFXOInit_TypeDef hfxoInit = CMU_HFXOINIT_DEFAULT;
+
+  CMU_HFRCODPLLBandSet(cmuHFRCODPLLFreq_19M0Hz);
+  CMU_ClockSelectSet(cmuClock_SYSCLK, cmuSelect_HFRCODPLL);
+
+  CMU_LFXOInit(&lfxoInit);
+  CMU_HFXOInit(&hfxoInit);
+
+  // The LFRCO register clock gives access to its tuning
+  CMU_ClockEnable(cmuClock_LFRCO, true);
+  CMU_OscillatorEnable(cmuOsc_LFRCO, true, true);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   BURTC on the LFXO, interrupting every second for the service tick.
+ *****************************************************************************/
+void initBURTC(void)
+{
+  BURTC_Init_TypeDef burtcInit = BURTC_INIT_DEFAULT;
+
+  CMU_ClockSelectSet(cmuClock_EM4GRPACLK, cmuSelect_LFXO);
+  CMU_ClockEnable(cmuClock_BURTC, true);
+
+  burtcInit.compare0Top = true;
+  BURTC_Init(&burtcInit);
+  BURTC_CounterReset();
+  BURTC_CompareSet(0, LFXO_HZ - 1);
+
+  BURTC_IntClear(BURTC_IF_COMP);
+  BURTC_IntEnable(BURTC_IEN_COMP);
+  NVIC_ClearPendingIRQ(BURTC_IRQn);
+  NVIC_EnableIRQ(BURTC_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Service tick; starts a measurement when one is due.
+ *****************************************************************************/
+void BURTC_IRQHandler(void)
+{
+  BURTC_IntClear(BURTC_IF_COMP);
+
+  // The BURTC is in an asynchronous clock domain; let the clear complete
+  __DSB();
+
+  tick++;
+  RCOCAL_Poll(&cal, tick);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Calibration ready; the service retunes the oscillator measured.
+ *****************************************************************************/
+void CMU_IRQHandler(void)
+{
+  RCOCAL_IRQHandler(&cal);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Print the state of each oscillator.
+ *****************************************************************************/
+static void report(void)
+{
+  const RCOCAL_State_TypeDef *s;
+  unsigned int i;
+
+  for (i = 0; i < CHANNELS; i++) {
+    s = &cal.state[i];
+    printf("%-9s tune %3u  error %+6ld ppm  drift %+4ld ppm  step %5ld ppm"
+           "  %lu steps  %s\n",
+           channels[i].name, s->tune,
+           (long)(s->estimate / RCOCAL_Q), (long)(s->drift / RCOCAL_Q),
+           (long)(s->stepPpm / RCOCAL_Q), (unsigned long)s->steps,
+           s->locked ? "locked" : "tracking");
+  }
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  uint32_t lastReport = 0;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  initCMU();
+
+  // The UART runs from the HFRCODPLL as well
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+
+  printf("\nRC oscillator calibration service\n");
+
+  RCOCAL_Start(&cal, channels, CHANNELS);
+  initBURTC();
+
+  while (1) {
+    EMU_EnterEM1();
+
+    if (tick - lastReport >= REPORT_TICKS) {
+      lastReport = tick;
+      report();
+    }
+
+    // LED0 on while every oscillator is within its tuning deadband
+    if (cal.state[0].locked && cal.state[1].locked) {
+      GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    } else {
+      GPIO_PinOutClear(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    }
+  }
+}
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ * @file rcocal.c
+ * @brief Background RC oscillator calibration: periodic CMU calibration
+ * counts drive a drift-tracking estimator that trims the oscillators.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "rcocal.h"
+
+// Estimator gains, as divisors of the residual
+#define ALPHA_DIV   4     // Error
+#define BETA_DIV    32    // Drift per measurement
+#define LEARN_DIV   2     // Step size, after a step
+
+/*
+ * An estimate this far past a step away from zero takes a step.  After
+ * the step it lands 3/8 of a step on the other side, inside the band, so
+ * noise near the threshold cannot make the tuning toggle.
+ */
+#define DEADBAND(step)  ((step) * 5 / 8)
+
+#if !defined(RCOCAL_HOST)
+#include "em_device.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Start the service with the tuning values the oscillators have now.
+ *
+ * @details
+ *   The oscillators being tuned, and the references not marked for burst
+ *   use, must already be running. The calibration interrupt is enabled;
+ *   call RCOCAL_IRQHandler() from CMU_IRQHandler().
+ *****************************************************************************/
+void RCOCAL_Start(RCOCAL_Handle_TypeDef *handle,
+                  const RCOCAL_Channel_TypeDef *channels,
+                  int count)
+{
+  uint16_t tunes[RCOCAL_MAX_CHANNELS];
+  int i;
+
+  for (i = 0; i < count && i < RCOCAL_MAX_CHANNELS; i++) {
+    tunes[i] = (uint16_t)CMU_OscillatorTuningGet(channels[i].osc);
+  }
+  RCOCAL_Init(handle, channels, count, tunes);
+
+  CMU_IntClear(CMU_IF_CALRDY);
+  CMU_IntEnable(CMU_IEN_CALRDY);
+  NVIC_ClearPendingIRQ(CMU_IRQn);
+  NVIC_EnableIRQ(CMU_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start a measurement if one is due; call once per service tick.
+ *
+ * @return
+ *   true if a measurement was started.
+ *****************************************************************************/
+bool RCOCAL_Poll(RCOCAL_Handle_TypeDef *handle, uint32_t tick)
+{
+  const RCOCAL_Channel_TypeDef *c;
+  int ch = RCOCAL_Next(handle, tick);
+
+  if (ch < 0) {
+    return false;
+  }
+  c = &handle->channels[ch];
+
+  if (c->burstHFXO) {
+    CMU_OscillatorEnable(cmuOsc_HFXO, true, true);
+  }
+  CMU_CalibrateConfig(c->downTop, c->downSel, c->upSel);
+  CMU_CalibrateCont(false);
+  CMU_CalibrateStart();
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Finish a measurement and apply the tuning; call from CMU_IRQHandler().
+ *****************************************************************************/
+void RCOCAL_IRQHandler(RCOCAL_Handle_TypeDef *handle)
+{
+  const RCOCAL_Channel_TypeDef *c;
+  int ch = handle->active;
+
+  CMU_IntClear(CMU_IF_CALRDY);
+  if (ch < 0) {
+    return;
+  }
+  c = &handle->channels[ch];
+
+  CMU_CalibrateStop();
+  if (c->burstHFXO) {
+    CMU_OscillatorEnable(cmuOsc_HFXO, false, false);
+  }
+  if (RCOCAL_Update(handle, ch, CMU_CalibrateCountGet()) != 0) {
+    CMU_OscillatorTuningSet(c->osc, handle->state[ch].tune);
+  }
+}
+#endif // !RCOCAL_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize the service.
+ *
+ * @param[in] channels
+ *   Oscillators to track, usually a const table; it is not copied.
+ *
+ * @param[in] tunes
+ *   Tuning value of each oscillator now.
+ *****************************************************************************/
+void RCOCAL_Init(RCOCAL_Handle_TypeDef *handle,
+                 const RCOCAL_Channel_TypeDef *channels,
+                 int count,
+                 const uint16_t *tunes)
+{
+  int i;
+
+  memset(handle, 0, sizeof(*handle));
+  if (count > RCOCAL_MAX_CHANNELS) {
+    count = RCOCAL_MAX_CHANNELS;
+  }
+  handle->channels = channels;
+  handle->count = (uint8_t)count;
+  handle->active = -1;
+  for (i = 0; i < count; i++) {
+    handle->state[i].tune = tunes[i];
+    handle->state[i].stepPpm = channels[i].stepPpm;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Frequency error of an oscillator from one calibration count.
+ *
+ * @details
+ *   First order in the count difference, which is exact to 1% of the error
+ *   up to an error of 1%; larger errors are corrected by a jump followed by
+ *   tracking, which converges either way.
+ *
+ * @return
+ *   Error in ppm Q8; positive if the oscillator runs fast.
+ *****************************************************************************/
+int32_t RCOCAL_Error(const RCOCAL_Channel_TypeDef *channel, uint32_t count)
+{
+  int64_t diff = (int64_t)count - (int64_t)channel->ideal;
+  int32_t err = (int32_t)((diff * channel->ppmScale) / (65536 / RCOCAL_Q));
+
+  // A fast oscillator on the down counter ends the window early
+  return channel->rcoCountsDown ? -err : err;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Pick the channel to measure next and mark it as measuring.
+ *
+ * @details
+ *   The channel furthest past its interval goes first, or of those equally
+ *   late the one measured least often; channels never measured are due at
+ *   once. Nothing is started while a measurement is running, since the CMU
+ *   has a single calibration counter.
+ *
+ * @return
+ *   Channel index, or -1 if none is due.
+ *****************************************************************************/
+int RCOCAL_Next(RCOCAL_Handle_TypeDef *handle, uint32_t tick)
+{
+  int i, best = -1;
+  uint32_t late, bestLate = 0;
+
+  if (handle->active >= 0) {
+    return -1;
+  }
+  for (i = 0; i < handle->count; i++) {
+    const RCOCAL_State_TypeDef *s = &handle->state[i];
+    uint32_t age = tick - s->lastTick;
+
+    if (s->measurements != 0 && age < handle->channels[i].interval) {
+      continue;
+    }
+    late = (s->measurements == 0) ? UINT32_MAX
+           : age - handle->channels[i].interval;
+    if (best < 0 || late > bestLate
+        || (late == bestLate
+            && handle->channels[i].interval > handle->channels[best].interval)) {
+      best = i;
+      bestLate = late;
+    }
+  }
+  if (best >= 0) {
+    handle->state[best].lastTick = tick;
+    handle->active = (int8_t)best;
+  }
+  return best;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take one calibration count and choose the tuning.
+ *
+ * @details
+ *   An alpha-beta filter tracks the frequency error and its change per
+ *   measurement, so a steady temperature ramp is followed without lag, and
+ *   tuning decisions use the error expected at the next measurement. While
+ *   tracking, the tuning moves by at most one step. The first count, or an
+ *   error more than RCOCAL_ACQUIRE_STEPS steps from the prediction, resets
+ *   the filter and may correct by several steps at once. The measurement
+ *   after a step shows how far the step really moved the frequency; the
+ *   step size is learned from it, within a factor of 4 of the nominal.
+ *
+ * @return
+ *   Tuning steps taken; the new value is in state[ch].tune.
+ *****************************************************************************/
+int RCOCAL_Update(RCOCAL_Handle_TypeDef *handle, int ch, uint32_t count)
+{
+  const RCOCAL_Channel_TypeDef *c = &handle->channels[ch];
+  RCOCAL_State_TypeDef *s = &handle->state[ch];
+  int32_t meas = RCOCAL_Error(c, count);
+  int32_t pred = s->estimate + s->drift;
+  int32_t r = meas - pred;
+  int32_t acquire = RCOCAL_ACQUIRE_STEPS * s->stepPpm;
+  int32_t next;
+  int steps = 0, tune;
+
+  handle->active = -1;
+  s->measured = meas;
+  s->measurements++;
+
+  if (s->measurements == 1 || r > acquire || r < -acquire) {
+    s->estimate = meas;
+    s->drift = 0;
+  } else if (s->lastSteps != 0) {
+    // The residual is mostly the step size error; leave the drift alone
+    s->stepPpm += r / (s->lastSteps * LEARN_DIV);
+    if (s->stepPpm < c->stepPpm / 4) {
+      s->stepPpm = c->stepPpm / 4;
+    } else if (s->stepPpm > c->stepPpm * 4) {
+      s->stepPpm = c->stepPpm * 4;
+    }
+    s->estimate = pred + r / 2;
+  } else {
+    s->estimate = pred + r / ALPHA_DIV;
+    s->drift += r / BETA_DIV;
+  }
+
+  next = s->estimate + s->drift;
+  acquire = RCOCAL_ACQUIRE_STEPS * s->stepPpm;
+  if (next > acquire || next < -acquire) {
+    // Round to the nearest step
+    steps = (int)((next + (next > 0 ? s->stepPpm : -s->stepPpm) / 2)
+                  / -s->stepPpm);
+  } else if (next > DEADBAND(s->stepPpm)) {
+    steps = -1;
+  } else if (next < -DEADBAND(s->stepPpm)) {
+    steps = 1;
+  }
+
+  tune = (int)s->tune + steps;
+  if (tune < 0) {
+    tune = 0;
+  } else if (tune > c->tuneMax) {
+    tune = c->tuneMax;
+  }
+  steps = tune - (int)s->tune;
+
+  s->tune = (uint16_t)tune;
+  s->estimate += steps * s->stepPpm;
+  s->lastSteps = (int8_t)(steps > 127 ? 127 : (steps < -127 ? -127 : steps));
+  s->steps += (uint32_t)(steps < 0 ? -steps : steps);
+  if (steps > 1 || steps < -1) {
+    s->jumps++;
+  }
+  next = s->estimate + s->drift;
+  s->locked = (next <= DEADBAND(s->stepPpm) && next >= -DEADBAND(s->stepPpm));
+  return steps;
+}
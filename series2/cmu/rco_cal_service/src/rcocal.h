@@ -0,0 +1,138 @@
+/***************************************************************************//**
+ * @file rcocal.h
+ * @brief Background RC oscillator calibration: periodic CMU calibration
+ * counts drive a drift-tracking estimator that trims the oscillators.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef RCOCAL_H
+#define RCOCAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !defined(RCOCAL_HOST)
+#include "em_cmu.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Oscillators one service can track
+#define RCOCAL_MAX_CHANNELS   4
+
+/// Errors and steps are kept in ppm with 8 fraction bits
+#define RCOCAL_Q              256
+
+/// Errors larger than this many tuning steps are corrected in one jump
+#define RCOCAL_ACQUIRE_STEPS  4
+
+/**************************************************************************//**
+ * @brief
+ *   Expected calibration count, for the calibration table.
+ *
+ * @details
+ *   The down counter runs for downTop + 1 cycles of its clock, during which
+ *   the up counter counts its own clock. Constant arguments fold at compile
+ *   time; the device never divides or uses floating point for this.
+ *****************************************************************************/
+#define RCOCAL_IDEAL(upHz, downHz, downTop)                             \
+  ((uint32_t)(((uint64_t)(upHz) * ((uint64_t)(downTop) + 1)             \
+               + (uint64_t)(downHz) / 2) / (uint64_t)(downHz)))
+
+/// Converts a count difference to ppm, Q16; for the calibration table
+#define RCOCAL_PPM_SCALE(ideal) \
+  ((uint32_t)(((1000000ULL << 16) + (ideal) / 2) / (ideal)))
+
+/// One tuned oscillator and its measurement, all fixed at build time
+typedef struct {
+  const char *name;
+  uint32_t   downTop;       ///< Down counter top; the window is downTop + 1
+  uint32_t   ideal;         ///< RCOCAL_IDEAL() of the nominal frequencies
+  uint32_t   ppmScale;      ///< RCOCAL_PPM_SCALE(ideal)
+  bool       rcoCountsDown; ///< The tuned oscillator clocks the down counter
+  int32_t    stepPpm;       ///< Nominal change per tuning step, ppm Q8
+  uint16_t   tuneMax;       ///< Largest tuning value
+  uint16_t   interval;      ///< Service ticks between measurements
+#if !defined(RCOCAL_HOST)
+  CMU_Osc_TypeDef    osc;         ///< Oscillator tuned
+  CMU_Select_TypeDef downSel;
+  CMU_Select_TypeDef upSel;
+  bool               burstHFXO;   ///< Run the HFXO only while measuring
+#endif
+} RCOCAL_Channel_TypeDef;
+
+/// Tracking state of one oscillator
+typedef struct {
+  int32_t  estimate;      ///< Filtered frequency error, ppm Q8; > 0 is fast
+  int32_t  drift;         ///< Estimated change per measurement, ppm Q8
+  int32_t  stepPpm;       ///< Learned change per tuning step, ppm Q8
+  int32_t  measured;      ///< Error of the last count, ppm Q8
+  uint16_t tune;
+  int8_t   lastSteps;     ///< Steps taken after the previous measurement
+  bool     locked;        ///< Estimate within the tuning deadband
+  uint32_t lastTick;
+  uint32_t measurements;
+  uint32_t steps;         ///< Tuning steps taken in all
+  uint32_t jumps;         ///< Corrections of more than one step
+} RCOCAL_State_TypeDef;
+
+/// Service state
+typedef struct {
+  const RCOCAL_Channel_TypeDef *channels;
+  uint8_t                      count;
+  RCOCAL_State_TypeDef         state[RCOCAL_MAX_CHANNELS];
+  volatile int8_t              active;  ///< Channel measuring, -1 for none
+} RCOCAL_Handle_TypeDef;
+
+void RCOCAL_Init(RCOCAL_Handle_TypeDef *handle,
+                 const RCOCAL_Channel_TypeDef *channels,
+                 int count,
+                 const uint16_t *tunes);
+int32_t RCOCAL_Error(const RCOCAL_Channel_TypeDef *channel, uint32_t count);
+int RCOCAL_Update(RCOCAL_Handle_TypeDef *handle, int ch, uint32_t count);
+int RCOCAL_Next(RCOCAL_Handle_TypeDef *handle, uint32_t tick);
+
+#if !defined(RCOCAL_HOST)
+void RCOCAL_Start(RCOCAL_Handle_TypeDef *handle,
+                  const RCOCAL_Channel_TypeDef *channels,
+                  int count);
+bool RCOCAL_Poll(RCOCAL_Handle_TypeDef *handle, uint32_t tick);
+void RCOCAL_IRQHandler(RCOCAL_Handle_TypeDef *handle);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RCOCAL_H
@@ -0,0 +1,466 @@
+/***************************************************************************//**
+ * @file rcocal_sim.c
+ * @brief Host test and benchmark for the RC oscillator calibration service.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DRCOCAL_HOST -I../src -o rcocal_sim rcocal_sim.c ../src/rcocal.c -lm
+ *   ./rcocal_sim
+ *
+ * The two channels of the example run against a model of each oscillator:
+ * a factory offset, a temperature and a supply coefficient, and a tuning
+ * step that differs from the nominal one in the channel table. Counts are
+ * made the way the CMU makes them, with the sub-cycle phase of the window
+ * random. The service must acquire a large offset, hold a steady one
+ * without toggling, follow temperature ramps with the fewest steps,
+ * recover from a supply step, learn the real step size and stop at the end
+ * of the tuning range. The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rcocal.h"
+
+#define HFRCO_HZ      19000000
+#define LFRCO_HZ      32768
+#define LFXO_HZ       32768
+#define HFXO_HZ       39000000
+
+#define HFRCO_TOP     1023
+#define LFRCO_TOP     511
+
+// The example's channel table
+static const RCOCAL_Channel_TypeDef channels[] = {
+  {
+    .name = "HFRCODPLL",
+    .downTop = HFRCO_TOP,
+    .ideal = RCOCAL_IDEAL(HFRCO_HZ, LFXO_HZ, HFRCO_TOP),
+    .ppmScale = RCOCAL_PPM_SCALE(RCOCAL_IDEAL(HFRCO_HZ, LFXO_HZ, HFRCO_TOP)),
+    .rcoCountsDown = false,
+    .stepPpm = 3000 * RCOCAL_Q,
+    .tuneMax = 127,
+    .interval = 1,
+  },
+  {
+    .name = "LFRCO",
+    .downTop = LFRCO_TOP,
+    .ideal = RCOCAL_IDEAL(HFXO_HZ, LFRCO_HZ, LFRCO_TOP),
+    .ppmScale = RCOCAL_PPM_SCALE(RCOCAL_IDEAL(HFXO_HZ, LFRCO_HZ, LFRCO_TOP)),
+    .rcoCountsDown = true,
+    .stepPpm = 1000 * RCOCAL_Q,
+    .tuneMax = 255,
+    .interval = 16,
+  },
+};
+
+#define HF  0
+#define LF  1
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Oscillator model; all in ppm of the nominal frequency
+typedef struct {
+  double nominal;     ///< Hz
+  double offset;      ///< At 25 C, 3.0 V and the centre tuning
+  double tempco;      ///< Per degree C
+  double vco;         ///< Per volt
+  double step;        ///< Per tuning step
+  int    centre;
+} Osc_TypeDef;
+
+static double temperature = 25.0;
+static double supply = 3.0;
+
+static double oscError(const Osc_TypeDef *o, int tune)
+{
+  return o->offset + o->tempco * (temperature - 25.0)
+         + o->vco * (supply - 3.0) + o->step * (tune - o->centre);
+}
+
+static double rnd(void)
+{
+  return (double)rand() / ((double)RAND_MAX + 1.0);
+}
+
+// The count the CMU would return for the oscillator at this tuning
+static uint32_t measure(int ch, const Osc_TypeDef *o, int tune)
+{
+  const RCOCAL_Channel_TypeDef *c = &channels[ch];
+  double f = o->nominal * (1.0 + oscError(o, tune) * 1e-6);
+  double window, up;
+
+  if (c->rcoCountsDown) {
+    window = (c->downTop + 1) / f;
+    up = HFXO_HZ;
+  } else {
+    window = (c->downTop + 1) / (double)LFXO_HZ;
+    up = f;
+  }
+  return (uint32_t)floor(up * window + rnd());
+}
+
+// Measure one channel and update its tuning
+static int step(RCOCAL_Handle_TypeDef *h, int ch, const Osc_TypeDef *o)
+{
+  return RCOCAL_Update(h, ch, measure(ch, o, h->state[ch].tune));
+}
+
+static double trueError(const RCOCAL_Handle_TypeDef *h, int ch,
+                        const Osc_TypeDef *o)
+{
+  return fabs(oscError(o, h->state[ch].tune));
+}
+
+static void initOne(RCOCAL_Handle_TypeDef *h, const Osc_TypeDef *hf,
+                    const Osc_TypeDef *lf)
+{
+  uint16_t tunes[2];
+
+  tunes[HF] = (uint16_t)hf->centre;
+  tunes[LF] = (uint16_t)lf->centre;
+  RCOCAL_Init(h, channels, 2, tunes);
+}
+
+static const Osc_TypeDef hfrcoModel = {
+  HFRCO_HZ, 0, -150.0, 800.0, 2600.0, 64
+};
+static const Osc_TypeDef lfrcoModel = {
+  LFRCO_HZ, 0, 60.0, -300.0, 1200.0, 128
+};
+
+static void testTable(void)
+{
+  check(channels[HF].ideal == 593750, "HFRCO ideal count");
+  check(channels[LF].ideal == 609375, "LFRCO ideal count");
+  check(abs(RCOCAL_Error(&channels[HF], 593750 + 594) / RCOCAL_Q - 1000) <= 1,
+        "HFRCO error of +1000 ppm");
+  check(abs(RCOCAL_Error(&channels[LF], 609375 + 609) / RCOCAL_Q + 999) <= 1,
+        "LFRCO error of -1000 ppm");
+  check(RCOCAL_Error(&channels[HF], 593750) == 0, "zero error");
+}
+
+static void testAcquire(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  int i;
+
+  temperature = 25.0;
+  supply = 3.0;
+  hf.offset = 25000.0;
+  lf.offset = -9000.0;
+  initOne(&h, &hf, &lf);
+
+  for (i = 0; i < 4; i++) {
+    step(&h, HF, &hf);
+    step(&h, LF, &lf);
+  }
+  check(trueError(&h, HF, &hf) < hf.step * 0.7, "HFRCO acquired");
+  check(trueError(&h, LF, &lf) < lf.step * 0.7, "LFRCO acquired");
+  check(h.state[HF].jumps >= 1 && h.state[LF].jumps >= 1, "acquired by jump");
+  check(h.state[HF].locked && h.state[LF].locked, "locked after acquiring");
+}
+
+static void testHold(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  uint32_t before[2];
+  int i, k;
+
+  temperature = 25.0;
+  supply = 3.0;
+
+  // Offsets half a step either side of a code, the worst case for toggling
+  for (k = 0; k < 8; k++) {
+    hf.offset = hf.step * (0.45 + 0.02 * k) * (k & 1 ? -1 : 1);
+    lf.offset = lf.step * (0.45 + 0.02 * k) * (k & 1 ? 1 : -1);
+    initOne(&h, &hf, &lf);
+    for (i = 0; i < 20; i++) {
+      step(&h, HF, &hf);
+      step(&h, LF, &lf);
+    }
+    before[HF] = h.state[HF].steps;
+    before[LF] = h.state[LF].steps;
+    for (i = 0; i < 1000; i++) {
+      step(&h, HF, &hf);
+      step(&h, LF, &lf);
+    }
+    check(h.state[HF].steps == before[HF], "HFRCO holds its tuning");
+    check(h.state[LF].steps == before[LF], "LFRCO holds its tuning");
+    check(trueError(&h, HF, &hf) < hf.step * 0.7, "HFRCO held error");
+  }
+}
+
+// Follow a temperature profile; returns the largest error seen, in steps
+static double ramp(RCOCAL_Handle_TypeDef *h, int ch, const Osc_TypeDef *o,
+                   double from, double to, int n, int *reversals)
+{
+  double worst = 0.0, e;
+  int i, s, last = 0;
+
+  for (i = 0; i < n; i++) {
+    temperature = from + (to - from) * (i + 1) / n;
+    s = step(h, ch, o);
+    if (s != 0) {
+      if (last != 0 && (s > 0) != (last > 0)) {
+        (*reversals)++;
+      }
+      last = s;
+    }
+    e = trueError(h, ch, o) / o->step;
+    if (e > worst) {
+      worst = e;
+    }
+  }
+  return worst;
+}
+
+static void testRamp(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  double worst;
+  uint32_t s0, ideal, hfSteps;
+  int reversals = 0, i;
+
+  supply = 3.0;
+  temperature = 25.0;
+  initOne(&h, &hf, &lf);
+  for (i = 0; i < 10; i++) {
+    step(&h, HF, &hf);
+  }
+  s0 = h.state[HF].steps;
+
+  // 25 to 85 C in 20 minutes, one measurement a second
+  worst = ramp(&h, HF, &hf, 25.0, 85.0, 1200, &reversals);
+  ideal = (uint32_t)(fabs(hf.tempco) * 60.0 / hf.step + 0.5);
+  check(worst < 0.75, "HFRCO follows a rising ramp");
+  check(reversals == 0, "HFRCO steps one way on a ramp");
+  check(h.state[HF].steps - s0 <= ideal + 1, "HFRCO fewest steps rising");
+  check(h.state[HF].jumps == 0, "HFRCO ramp without jumps");
+
+  // And back down, faster
+  s0 = h.state[HF].steps;
+  reversals = 0;
+  worst = ramp(&h, HF, &hf, 85.0, -20.0, 900, &reversals);
+  ideal = (uint32_t)(fabs(hf.tempco) * 105.0 / hf.step + 0.5);
+  check(worst < 0.75, "HFRCO follows a falling ramp");
+  check(reversals == 0, "HFRCO steps one way falling");
+  check(h.state[HF].steps - s0 <= ideal + 1, "HFRCO fewest steps falling");
+  hfSteps = h.state[HF].steps;
+
+  // LFRCO, measured every 16 s, over an hour from -20 to 85 C
+  temperature = -20.0;
+  initOne(&h, &hf, &lf);
+  for (i = 0; i < 10; i++) {
+    step(&h, LF, &lf);
+  }
+  reversals = 0;
+  worst = ramp(&h, LF, &lf, -20.0, 85.0, 225, &reversals);
+  check(worst < 0.75, "LFRCO follows a ramp");
+  check(reversals == 0, "LFRCO steps one way on a ramp");
+  printf("ramps: HFRCO %u steps in 35 minutes, LFRCO %u in an hour\n",
+         hfSteps, h.state[LF].steps);
+}
+
+static void testSupplyStep(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  int i;
+
+  temperature = 40.0;
+  supply = 3.3;
+  initOne(&h, &hf, &lf);
+  for (i = 0; i < 30; i++) {
+    step(&h, HF, &hf);
+  }
+
+  // The supply falls to 1.8 V, a sudden change of about five steps
+  supply = 1.8;
+  hf.vco = 10000.0;
+  for (i = 0; i < 3; i++) {
+    step(&h, HF, &hf);
+  }
+  check(trueError(&h, HF, &hf) < hf.step * 0.7, "recovers from supply step");
+  for (i = 0; i < 200; i++) {
+    step(&h, HF, &hf);
+  }
+  check(trueError(&h, HF, &hf) < hf.step * 0.7, "settled after supply step");
+  check(h.state[HF].drift / RCOCAL_Q < 50 && h.state[HF].drift / RCOCAL_Q > -50,
+        "drift settles after a step");
+}
+
+static void testLearn(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  double learned;
+  int reversals = 0, i;
+
+  // Real steps 1.6 times the nominal
+  hf.step = 4800.0;
+  supply = 3.0;
+  temperature = 0.0;
+  initOne(&h, &hf, &lf);
+  hf.offset = 2000.0;
+  for (i = 0; i < 5; i++) {
+    step(&h, HF, &hf);
+  }
+  ramp(&h, HF, &hf, 0.0, 85.0, 1700, &reversals);
+  learned = (double)h.state[HF].stepPpm / RCOCAL_Q;
+  check(fabs(learned - hf.step) < hf.step * 0.15, "learns a larger step");
+  check(reversals == 0, "no hunting with a wrong nominal step");
+  check(trueError(&h, HF, &hf) < hf.step * 0.7, "locked with learned step");
+
+  // And a smaller one
+  hf.step = 1500.0;
+  temperature = 0.0;
+  initOne(&h, &hf, &lf);
+  reversals = 0;
+  ramp(&h, HF, &hf, 0.0, 85.0, 1700, &reversals);
+  learned = (double)h.state[HF].stepPpm / RCOCAL_Q;
+  check(fabs(learned - hf.step) < hf.step * 0.15, "learns a smaller step");
+  check(trueError(&h, HF, &hf) < hf.step * 0.7, "locked with smaller step");
+}
+
+static void testLimits(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  int i;
+
+  // Too slow for the tuning range to reach
+  temperature = 25.0;
+  supply = 3.0;
+  hf.offset = -400000.0;
+  initOne(&h, &hf, &lf);
+  for (i = 0; i < 50; i++) {
+    step(&h, HF, &hf);
+  }
+  check(h.state[HF].tune == channels[HF].tuneMax, "stops at tuneMax");
+
+  hf.offset = 400000.0;
+  initOne(&h, &hf, &lf);
+  for (i = 0; i < 50; i++) {
+    step(&h, HF, &hf);
+  }
+  check(h.state[HF].tune == 0, "stops at 0");
+}
+
+static void testSchedule(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  uint32_t tick, counts[2] = { 0, 0 };
+  int ch;
+
+  temperature = 25.0;
+  supply = 3.0;
+  initOne(&h, &hf, &lf);
+
+  ch = RCOCAL_Next(&h, 0);
+  check(ch == LF, "rarer channel first");
+  check(RCOCAL_Next(&h, 0) == -1, "one measurement at a time");
+  step(&h, LF, &lf);
+  check(RCOCAL_Next(&h, 0) == HF, "unmeasured channel at once");
+  step(&h, HF, &hf);
+  check(RCOCAL_Next(&h, 0) == -1, "nothing due");
+
+  // A tick a second for 160 s; the measurement ends before the next tick
+  for (tick = 1; tick <= 160; tick++) {
+    ch = RCOCAL_Next(&h, tick);
+    if (ch >= 0) {
+      counts[ch]++;
+      step(&h, ch, ch == HF ? &hf : &lf);
+    }
+  }
+  // When both are due, the rarer goes first and the other waits a tick
+  check(counts[LF] == 10, "LFRCO every 16 ticks");
+  check(counts[HF] >= 150 && counts[HF] <= 160, "HFRCO every tick");
+}
+
+static void benchmark(void)
+{
+  RCOCAL_Handle_TypeDef h;
+  Osc_TypeDef hf = hfrcoModel, lf = lfrcoModel;
+  static uint32_t counts[4096];
+  clock_t start;
+  double seconds;
+  int32_t sum = 0;
+  int i, n = 20000000;
+
+  temperature = 25.0;
+  supply = 3.0;
+  initOne(&h, &hf, &lf);
+  for (i = 0; i < 4096; i++) {
+    counts[i] = channels[HF].ideal + (uint32_t)(rand() % 5000) - 2500;
+  }
+
+  start = clock();
+  for (i = 0; i < n; i++) {
+    sum += RCOCAL_Update(&h, HF, counts[i & 4095]);
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  check(sum != 0x7FFFFFFF, "benchmark");
+  printf("one count through the estimator: %.1f ns on this host\n",
+         seconds * 1e9 / n);
+}
+
+int main(void)
+{
+  srand(1);
+  testTable();
+  testAcquire();
+  testHold();
+  testRamp();
+  testSupplyStep();
+  testLearn();
+  testLimits();
+  testSchedule();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
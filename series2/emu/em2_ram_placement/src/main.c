@@ -0,0 +1,210 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Example that keeps selected data in the retained RAM bank while the
+ * rest of RAM is powered down in EM2.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_burtc.h"
+#include "mx25flash_spi.h"
+#include "bspconfig.h"
+#include "memplace.h"
+
+// Number of 1 kHz ULFRCO clocks between wake-ups
+#define BURTC_IRQ_PERIOD  1000
+
+#define RING_SIZE         256   // samples kept across EM2
+#define SCRATCH_SIZE      8192  // EM0-only work area
+#define HISTOGRAM_BINS    16
+
+// Survives EM2 and warm resets; cleared after power-on and EM4
+typedef struct {
+  uint32_t bootCount;
+  uint32_t warmBootCount;
+  uint32_t lastResetCause;
+} Persistent_TypeDef;
+
+MEMPLACE_RETAINED_NOINIT Persistent_TypeDef persistent;
+
+// Survives EM2, cleared at reset: sample history written on every wake-up
+MEMPLACE_RETAINED uint16_t sampleRing[RING_SIZE];
+MEMPLACE_RETAINED uint32_t sampleCount;
+
+// Lost in EM2: only used while awake
+MEMPLACE_NORETAIN uint16_t scratch[SCRATCH_SIZE];
+
+// Lost in EM2, cleared again on every wake-up
+MEMPLACE_NORETAIN_ZERO uint32_t histogram[HISTOGRAM_BINS];
+
+// Watch these in the debugger
+MEMPLACE_Usage_TypeDef usage;
+uint16_t sampleMedian;
+
+/**************************************************************************//**
+ * @brief  BURTC Handler
+ *****************************************************************************/
+void BURTC_IRQHandler(void)
+{
+  BURTC_IntClear(BURTC_IF_COMP); // compare match
+}
+
+/**************************************************************************//**
+ * @brief  Configure BURTC to wake the device from EM2 every BURTC_IRQ_PERIOD
+ *****************************************************************************/
+void initBURTC(void)
+{
+  CMU_ClockSelectSet(cmuClock_EM4GRPACLK, cmuSelect_ULFRCO);
+  CMU_ClockEnable(cmuClock_BURTC, true);
+
+  BURTC_Init_TypeDef burtcInit = BURTC_INIT_DEFAULT;
+  burtcInit.compare0Top = true; // reset counter when counter reaches compare value
+  BURTC_Init(&burtcInit);
+
+  BURTC_CounterReset();
+  BURTC_CompareSet(0, BURTC_IRQ_PERIOD);
+
+  BURTC_IntEnable(BURTC_IEN_COMP);  // compare match
+  NVIC_EnableIRQ(BURTC_IRQn);
+  BURTC_Enable(true);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Work done on every wake-up: record a sample in the retained ring, then
+ *   use the non-retained scratch buffer and histogram to summarize it.
+ *****************************************************************************/
+void processSamples(void)
+{
+  uint32_t n;
+  uint32_t i, j;
+
+  // The low bits of the system tick counter stand in for a sensor reading
+  sampleRing[sampleCount % RING_SIZE] = (uint16_t)(SysTick->VAL ^ sampleCount);
+  sampleCount++;
+  n = sampleCount < RING_SIZE ? sampleCount : RING_SIZE;
+
+  // Insertion sort of the history in scratch RAM to find the median
+  for (i = 0; i < n; i++) {
+    uint16_t v = sampleRing[i];
+
+    for (j = i; j > 0 && scratch[j - 1] > v; j--) {
+      scratch[j] = scratch[j - 1];
+    }
+    scratch[j] = v;
+    histogram[v / (65536 / HISTOGRAM_BINS)]++;
+  }
+  sampleMedian = scratch[n / 2];
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  FlashStatus status;
+  uint32_t resetCause;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Decide whether the MEMPLACE_RETAINED_NOINIT data is still valid
+  if (MEMPLACE_Init(&resetCause)) {
+    persistent.warmBootCount++;
+  }
+  persistent.bootCount++;
+  persistent.lastResetCause = resetCause;
+
+  // Turn on DCDC regulator
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_WSTK_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+
+  /*
+   * When developing or debugging code that enters EM2 or
+   *  lower, it's a good idea to have an "escape hatch" type
+   * mechanism, e.g. a way to pause the device so that a debugger can
+   * connect in order to erase flash, among other things.
+   *
+   * Before proceeding with this example, make sure PB0 is not pressed.
+   * If the PB0 pin is low, turn on LED0 and execute the breakpoint
+   * instruction to stop the processor in EM0 and allow a debug
+   * connection to be made.
+   */
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
+  if (GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == 0) {
+    GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 1);
+    __BKPT(0);
+  }
+  // Pin not asserted, so disable input
+  else {
+    GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeDisabled, 0);
+    CMU_ClockEnable(cmuClock_GPIO, false);
+  }
+
+  // Enable voltage downscaling in EM mode 2(VSCALE0)
+  EMU_EM23Init_TypeDef em23Init = EMU_EM23INIT_DEFAULT;
+  em23Init.vScaleEM23Voltage = emuVScaleEM23_LowPower;
+
+  // Initialize EM23 energy modes
+  EMU_EM23Init(&em23Init);
+
+  // Init and power-down MX25 SPI flash
+  MX25_init();
+  MX25_RSTEN();
+  MX25_RST(&status);
+  MX25_DP();
+  MX25_deinit();
+
+  MEMPLACE_UsageGet(&usage);
+
+  // Keep only the retained bank powered in EM2
+  MEMPLACE_PowerDownUnretained();
+
+  // Free-running SysTick provides the stand-in sample values
+  SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+  initBURTC();
+
+  while (1) {
+    EMU_EnterEM2(false);
+
+    // Non-retained RAM holds garbage after EM2
+    MEMPLACE_WakeInit();
+    processSamples();
+  }
+}
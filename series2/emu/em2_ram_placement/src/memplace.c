@@ -0,0 +1,170 @@
+/***************************************************************************//**
+ * @file memplace.c
+ * @brief Placement of data in retained and powered-down RAM.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "em_device.h"
+#include "em_emu.h"
+#include "em_rmu.h"
+#include "memplace.h"
+
+#if MEMPLACE_ENABLED
+
+// Region bounds defined by the *_linker_script_ram_placement.ld scripts
+extern uint8_t __data_start__[], __data_end__[];
+extern uint8_t __bss_start__[], __bss_end__[];
+extern uint8_t __retained_noinit_start__[], __retained_noinit_end__[];
+extern uint8_t __retained_bss_start__[], __retained_bss_end__[];
+extern uint8_t __noretain_start__[], __noretain_end__[];
+extern uint8_t __noretain_bss_start__[], __noretain_bss_end__[];
+extern uint8_t __ram_noret_start__[], __ram_noret_end__[];
+extern uint8_t __HeapLimit[], __StackLimit[];
+
+#define MEMPLACE_MAGIC    0x52455441u
+
+// Marks the MEMPLACE_RETAINED_NOINIT contents as valid
+MEMPLACE_RETAINED_NOINIT static volatile uint32_t validMarker[2];
+
+/*******************************************************************************
+ * Reset causes after which SRAM contents cannot be trusted. Series 2 devices
+ * do not retain SRAM in EM4, so an EM4 wake-up counts as a cold start; BURAM
+ * is the place for state that must survive EM4.
+ ******************************************************************************/
+#if defined(EMU_RSTCAUSE_DVDDLEBOD)
+#define MEMPLACE_RSTCAUSE_LEBOD   EMU_RSTCAUSE_DVDDLEBOD
+#else
+#define MEMPLACE_RSTCAUSE_LEBOD   0
+#endif
+
+#define MEMPLACE_COLD_RESET_MASK (EMU_RSTCAUSE_POR       \
+                                  | EMU_RSTCAUSE_EM4     \
+                                  | EMU_RSTCAUSE_AVDDBOD \
+                                  | EMU_RSTCAUSE_DVDDBOD \
+                                  | EMU_RSTCAUSE_DECBOD  \
+                                  | MEMPLACE_RSTCAUSE_LEBOD)
+
+#endif // MEMPLACE_ENABLED
+
+/**************************************************************************//**
+ * @brief
+ *   Startup hook for retained data, to be called first thing in main().
+ *
+ * @details
+ *   The startup code clears .bss, MEMPLACE_RETAINED and MEMPLACE_NORETAIN_ZERO
+ *   through the linker zero table but leaves MEMPLACE_RETAINED_NOINIT alone.
+ *   This function keeps those contents after a warm reset (pin, watchdog,
+ *   lockup, software) and clears them after a power-on, brown-out or EM4
+ *   reset. The reset cause is read and cleared here.
+ *
+ * @param[out] resetCause
+ *   Optional; receives the EMU_RSTCAUSE flags of this reset.
+ *
+ * @return
+ *   true if the MEMPLACE_RETAINED_NOINIT contents were kept.
+ *****************************************************************************/
+bool MEMPLACE_Init(uint32_t *resetCause)
+{
+  uint32_t cause = RMU_ResetCauseGet();
+  bool valid = false;
+
+  RMU_ResetCauseClear();
+  if (resetCause != NULL) {
+    *resetCause = cause;
+  }
+
+#if MEMPLACE_ENABLED
+  valid = (cause & MEMPLACE_COLD_RESET_MASK) == 0
+          && validMarker[0] == MEMPLACE_MAGIC
+          && validMarker[1] == ~MEMPLACE_MAGIC;
+
+  if (!valid) {
+    memset(__retained_noinit_start__, 0,
+           (size_t)(__retained_noinit_end__ - __retained_noinit_start__));
+    validMarker[0] = MEMPLACE_MAGIC;
+    validMarker[1] = ~MEMPLACE_MAGIC;
+  }
+#endif
+
+  return valid;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Power down every RAM block above the retained bank for EM2/EM3.
+ *
+ * @note
+ *   The blocks stay usable in EM0/EM1, but MEMPLACE_NORETAIN and
+ *   MEMPLACE_NORETAIN_ZERO data is lost in every EM2/EM3 period from now on.
+ *   Call MEMPLACE_WakeInit() after each wake-up before using them.
+ *****************************************************************************/
+void MEMPLACE_PowerDownUnretained(void)
+{
+#if MEMPLACE_ENABLED
+  EMU_RamPowerDown((uint32_t)__ram_noret_start__, (uint32_t)__ram_noret_end__);
+#endif
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Clear MEMPLACE_NORETAIN_ZERO data after waking from EM2/EM3.
+ *****************************************************************************/
+void MEMPLACE_WakeInit(void)
+{
+#if MEMPLACE_ENABLED
+  memset(__noretain_bss_start__, 0,
+         (size_t)(__noretain_bss_end__ - __noretain_bss_start__));
+#endif
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Report the RAM used in each placement class.
+ *****************************************************************************/
+void MEMPLACE_UsageGet(MEMPLACE_Usage_TypeDef *usage)
+{
+  memset(usage, 0, sizeof(*usage));
+
+#if MEMPLACE_ENABLED
+  usage->retainedNoInit = (uint32_t)(__retained_noinit_end__
+                                     - __retained_noinit_start__);
+  usage->retained = (uint32_t)((__data_end__ - __data_start__)
+                               + (__bss_end__ - __bss_start__)
+                               + (__retained_bss_end__ - __retained_bss_start__));
+  usage->noRetain = (uint32_t)(__noretain_end__ - __noretain_start__);
+  usage->noRetainZero = (uint32_t)(__noretain_bss_end__
+                                   - __noretain_bss_start__);
+  usage->retainedFree = (uint32_t)(__StackLimit - __HeapLimit);
+  usage->noRetainFree = (uint32_t)(__ram_noret_end__ - __noretain_bss_end__);
+#endif
+}
@@ -0,0 +1,94 @@
+/***************************************************************************//**
+ * @file memplace.h
+ * @brief Placement of data in retained and powered-down RAM.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef MEMPLACE_H
+#define MEMPLACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * The section macros below need one of the *_linker_script_ram_placement.ld
+ * scripts in series2/linker_scripts. Without it (IAR, host builds) they expand
+ * to nothing, all data stays in the default RAM and MEMPLACE_ENABLED is 0.
+ *
+ *   MEMPLACE_RETAINED          kept in EM2/EM3, cleared at reset
+ *   MEMPLACE_RETAINED_NOINIT   kept in EM2/EM3 and across warm resets, never
+ *                              cleared by startup; see MEMPLACE_Init()
+ *   MEMPLACE_NORETAIN          lost in EM2/EM3, never initialized
+ *   MEMPLACE_NORETAIN_ZERO     lost in EM2/EM3, cleared at reset and by
+ *                              MEMPLACE_WakeInit()
+ *
+ * Objects given one of these macros must not have an initializer; the
+ * sections are not loaded from flash.
+ ******************************************************************************/
+#if defined(__GNUC__) && !defined(MEMPLACE_HOST)
+#define MEMPLACE_ENABLED            1
+#define MEMPLACE_RETAINED           __attribute__((section(".retained_bss")))
+#define MEMPLACE_RETAINED_NOINIT    __attribute__((section(".retained_noinit")))
+#define MEMPLACE_NORETAIN           __attribute__((section(".noretain")))
+#define MEMPLACE_NORETAIN_ZERO      __attribute__((section(".noretain_bss")))
+#else
+#define MEMPLACE_ENABLED            0
+#define MEMPLACE_RETAINED
+#define MEMPLACE_RETAINED_NOINIT
+#define MEMPLACE_NORETAIN
+#define MEMPLACE_NORETAIN_ZERO
+#endif
+
+/// Bytes used in each placement class, from the linker symbols
+typedef struct {
+  uint32_t retainedNoInit;
+  uint32_t retained;          ///< .data, .bss and MEMPLACE_RETAINED
+  uint32_t noRetain;
+  uint32_t noRetainZero;
+  uint32_t retainedFree;      ///< Retained bank left for heap and stack
+  uint32_t noRetainFree;
+} MEMPLACE_Usage_TypeDef;
+
+bool MEMPLACE_Init(uint32_t *resetCause);
+void MEMPLACE_PowerDownUnretained(void);
+void MEMPLACE_WakeInit(void);
+void MEMPLACE_UsageGet(MEMPLACE_Usage_TypeDef *usage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEMPLACE_H
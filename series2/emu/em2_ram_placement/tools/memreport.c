@@ -0,0 +1,381 @@
+/***************************************************************************//**
+ * @file memreport.c
+ * @brief Host tool that reports RAM use per placement class and region for
+ * images linked with the *_linker_script_ram_placement.ld scripts.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+/*
+ * Build (from this directory):
+ *   gcc -std=c99 -o memreport memreport.c
+ *
+ * Usage:
+ *   arm-none-eabi-nm -S -n image.axf > image.sym
+ *   memreport [-t N] [-r symbol]... [-u symbol]... script.ld image.sym
+ *
+ *   -t N       list the N largest objects of each class (default 5)
+ *   -r symbol  fail unless symbol lies in the retained RAM region
+ *   -u symbol  fail unless symbol lies in the RAM_NORET region
+ *
+ * The MEMORY regions are read from the linker script, everything else from
+ * the symbol table. The exit status is non-zero if a region is overflowed, a
+ * placement class ends up outside its region or a -r/-u check fails.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_REGIONS   8
+#define MAX_SYMBOLS   8192
+#define MAX_CHECKS    32
+#define NAME_LEN      64
+
+typedef struct {
+  char          name[NAME_LEN];
+  unsigned long origin;
+  unsigned long length;
+  unsigned long used;
+} Region_t;
+
+typedef struct {
+  char          name[NAME_LEN];
+  unsigned long addr;
+  unsigned long size;
+  char          type;
+} Symbol_t;
+
+typedef struct {
+  const char *label;
+  const char *region;
+  const char *start;
+  const char *end;
+} Class_t;
+
+// Placement classes in address order, bounded by linker script symbols
+static const Class_t classes[] = {
+  { "MEMPLACE_RETAINED_NOINIT", "RAM",       "__retained_noinit_start__", "__retained_noinit_end__" },
+  { ".data",                    "RAM",       "__data_start__",            "__data_end__" },
+  { ".bss",                     "RAM",       "__bss_start__",             "__bss_end__" },
+  { "MEMPLACE_RETAINED",        "RAM",       "__retained_bss_start__",    "__retained_bss_end__" },
+  { "heap",                     "RAM",       "__HeapBase",                "__HeapLimit" },
+  { "stack",                    "RAM",       "__StackLimit",              "__StackTop" },
+  { "MEMPLACE_NORETAIN",        "RAM_NORET", "__noretain_start__",        "__noretain_end__" },
+  { "MEMPLACE_NORETAIN_ZERO",   "RAM_NORET", "__noretain_bss_start__",    "__noretain_bss_end__" },
+};
+#define CLASS_COUNT   (sizeof(classes) / sizeof(classes[0]))
+
+static Region_t regions[MAX_REGIONS];
+static int regionCount;
+static Symbol_t symbols[MAX_SYMBOLS];
+static int symbolCount;
+
+static void fail(const char *what, const char *name)
+{
+  fprintf(stderr, "memreport: %s %s\n", what, name);
+  exit(2);
+}
+
+/***************************************************************************//**
+ * @brief Parse a linker script number: hex, decimal, or with a K/M suffix.
+ ******************************************************************************/
+static unsigned long parseNumber(const char *text)
+{
+  char *end;
+  unsigned long value = strtoul(text, &end, 0);
+
+  if (*end == 'K' || *end == 'k') {
+    value *= 1024;
+  } else if (*end == 'M' || *end == 'm') {
+    value *= 1024 * 1024;
+  }
+  return value;
+}
+
+/***************************************************************************//**
+ * @brief Read the regions of the MEMORY command of a linker script.
+ ******************************************************************************/
+static void readRegions(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  char line[256];
+  int inMemory = 0;
+
+  if (f == NULL) {
+    fail("cannot open", path);
+  }
+  while (fgets(line, sizeof(line), f) != NULL && regionCount < MAX_REGIONS) {
+    char *origin;
+    char *length;
+    Region_t *r;
+
+    if (strncmp(line, "MEMORY", 6) == 0) {
+      inMemory = 1;
+      continue;
+    }
+    if (!inMemory) {
+      continue;
+    }
+    if (strchr(line, '}') != NULL) {
+      break;
+    }
+    origin = strstr(line, "ORIGIN");
+    length = strstr(line, "LENGTH");
+    if (origin == NULL || length == NULL) {
+      continue;
+    }
+    r = &regions[regionCount++];
+    if (sscanf(line, " %63[A-Za-z0-9_]", r->name) != 1) {
+      fail("bad MEMORY line in", path);
+    }
+    r->origin = parseNumber(strchr(origin, '=') + 1 + strspn(strchr(origin, '=') + 1, " \t"));
+    r->length = parseNumber(strchr(length, '=') + 1 + strspn(strchr(length, '=') + 1, " \t"));
+  }
+  fclose(f);
+  if (regionCount == 0) {
+    fail("no MEMORY regions in", path);
+  }
+}
+
+/***************************************************************************//**
+ * @brief Read "address [size] type name" lines as printed by nm -S.
+ ******************************************************************************/
+static void readSymbols(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  char line[512];
+
+  if (f == NULL) {
+    fail("cannot open", path);
+  }
+  while (fgets(line, sizeof(line), f) != NULL && symbolCount < MAX_SYMBOLS) {
+    char a[32], b[32], c[NAME_LEN], d[NAME_LEN];
+    Symbol_t *s = &symbols[symbolCount];
+    int n = sscanf(line, "%31s %31s %63s %63s", a, b, c, d);
+
+    if (n == 4 && strlen(c) == 1) {
+      s->addr = strtoul(a, NULL, 16);
+      s->size = strtoul(b, NULL, 16);
+      s->type = c[0];
+      snprintf(s->name, sizeof(s->name), "%s", d);
+    } else if (n == 3 && strlen(b) == 1) {
+      s->addr = strtoul(a, NULL, 16);
+      s->size = 0;
+      s->type = b[0];
+      snprintf(s->name, sizeof(s->name), "%s", c);
+    } else {
+      continue;
+    }
+    symbolCount++;
+  }
+  fclose(f);
+}
+
+static const Symbol_t *findSymbol(const char *name)
+{
+  int i;
+
+  for (i = 0; i < symbolCount; i++) {
+    if (strcmp(symbols[i].name, name) == 0) {
+      return &symbols[i];
+    }
+  }
+  return NULL;
+}
+
+static Region_t *findRegion(const char *name)
+{
+  int i;
+
+  for (i = 0; i < regionCount; i++) {
+    if (strcmp(regions[i].name, name) == 0) {
+      return &regions[i];
+    }
+  }
+  return NULL;
+}
+
+static Region_t *regionOf(unsigned long addr)
+{
+  int i;
+
+  for (i = 0; i < regionCount; i++) {
+    if (addr >= regions[i].origin
+        && addr - regions[i].origin < regions[i].length) {
+      return &regions[i];
+    }
+  }
+  return NULL;
+}
+
+static int bySizeDescending(const void *a, const void *b)
+{
+  const Symbol_t *x = *(const Symbol_t * const *)a;
+  const Symbol_t *y = *(const Symbol_t * const *)b;
+
+  return (x->size < y->size) - (x->size > y->size);
+}
+
+/***************************************************************************//**
+ * @brief Print the largest data objects between two addresses.
+ ******************************************************************************/
+static void listObjects(unsigned long start, unsigned long end, int top)
+{
+  static const Symbol_t *found[MAX_SYMBOLS];
+  int count = 0;
+  int i;
+
+  for (i = 0; i < symbolCount; i++) {
+    const Symbol_t *s = &symbols[i];
+
+    if (s->size > 0 && s->addr >= start && s->addr < end
+        && strchr("bBdD", s->type) != NULL) {
+      found[count++] = s;
+    }
+  }
+  qsort(found, (size_t)count, sizeof(found[0]), bySizeDescending);
+  for (i = 0; i < count && i < top; i++) {
+    printf("      %8lu  %s\n", found[i]->size, found[i]->name);
+  }
+}
+
+/*******************************************************************************
+ **********************************   Main   ***********************************
+ ******************************************************************************/
+
+int main(int argc, char **argv)
+{
+  const char *retainedChecks[MAX_CHECKS];
+  const char *unretainedChecks[MAX_CHECKS];
+  int retainedCount = 0;
+  int unretainedCount = 0;
+  int top = 5;
+  int errors = 0;
+  int argi = 1;
+  const Symbol_t *etext, *dataStart, *dataEnd;
+  Region_t *ram, *noret, *flash;
+  unsigned i;
+
+  while (argi + 1 < argc && argv[argi][0] == '-') {
+    if (strcmp(argv[argi], "-t") == 0) {
+      top = atoi(argv[argi + 1]);
+    } else if (strcmp(argv[argi], "-r") == 0 && retainedCount < MAX_CHECKS) {
+      retainedChecks[retainedCount++] = argv[argi + 1];
+    } else if (strcmp(argv[argi], "-u") == 0 && unretainedCount < MAX_CHECKS) {
+      unretainedChecks[unretainedCount++] = argv[argi + 1];
+    } else {
+      break;
+    }
+    argi += 2;
+  }
+  if (argi + 2 != argc) {
+    fprintf(stderr, "usage: memreport [-t N] [-r symbol]... [-u symbol]... "
+                    "script.ld image.sym\n");
+    return 2;
+  }
+
+  readRegions(argv[argi]);
+  readSymbols(argv[argi + 1]);
+  flash = findRegion("FLASH");
+  ram = findRegion("RAM");
+  noret = findRegion("RAM_NORET");
+  if (ram == NULL || noret == NULL) {
+    fail("RAM and RAM_NORET regions expected in", argv[argi]);
+  }
+
+  // Region usage from the section bounds
+  etext = findSymbol("__etext");
+  dataStart = findSymbol("__data_start__");
+  dataEnd = findSymbol("__data_end__");
+  if (flash != NULL && etext != NULL && dataStart != NULL && dataEnd != NULL) {
+    flash->used = etext->addr - flash->origin + (dataEnd->addr - dataStart->addr);
+  }
+
+  printf("Placement class             Region        Start      Bytes\n");
+  for (i = 0; i < CLASS_COUNT; i++) {
+    const Class_t *c = &classes[i];
+    const Symbol_t *start = findSymbol(c->start);
+    const Symbol_t *end = findSymbol(c->end);
+    Region_t *expected = findRegion(c->region);
+    Region_t *actual;
+    unsigned long size;
+
+    if (start == NULL || end == NULL) {
+      printf("  %-26s missing %s / %s\n", c->label, c->start, c->end);
+      errors++;
+      continue;
+    }
+    size = end->addr - start->addr;
+    actual = size > 0 ? regionOf(start->addr) : expected;
+    if (actual != expected || (size > 0 && regionOf(end->addr - 1) != expected)) {
+      printf("  %-26s NOT IN %s\n", c->label, c->region);
+      errors++;
+      continue;
+    }
+    expected->used += size;
+    printf("  %-26s %-10s 0x%08lx %8lu\n", c->label, c->region, start->addr, size);
+    if (top > 0 && i != 4 && i != 5) {
+      listObjects(start->addr, end->addr, top);
+    }
+  }
+
+  printf("\nRegion        Origin       Length       Used   Use%%\n");
+  for (i = 0; i < (unsigned)regionCount; i++) {
+    Region_t *r = &regions[i];
+
+    printf("  %-10s 0x%08lx %10lu %10lu %5.1f%%\n", r->name, r->origin,
+           r->length, r->used, r->length ? 100.0 * r->used / r->length : 0.0);
+    if (r->used > r->length) {
+      printf("  %s overflowed\n", r->name);
+      errors++;
+    }
+  }
+
+  for (i = 0; i < (unsigned)(retainedCount + unretainedCount); i++) {
+    int retained = i < (unsigned)retainedCount;
+    const char *name = retained ? retainedChecks[i]
+                       : unretainedChecks[i - retainedCount];
+    const Symbol_t *s = findSymbol(name);
+    Region_t *want = retained ? ram : noret;
+
+    if (s == NULL) {
+      printf("%s: not found\n", name);
+      errors++;
+    } else if (regionOf(s->addr) != want) {
+      printf("%s: 0x%08lx is not in %s\n", name, s->addr, want->name);
+      errors++;
+    }
+  }
+
+  printf("%d errors\n", errors);
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,308 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Lets a sleep scheduler pick EM1, EM2 or EM3 and the EM2/3 voltage
+ * scale for every idle period, from the needs of the drivers.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "slp.h"
+
+// Timer periods, in ms at the 1 kHz time base
+#define SAMPLE_MS       1000
+#define PULSE_MS        2000
+#define PULSE_ON_MS     20
+#define CONSOLE_MS      5000
+#define REPORT_MS       10000
+
+// Time for the USART to shift out its last character at 115200 baud
+#define SERIAL_DRAIN_MS 3
+
+// Wake-up the radio window can wait for
+#define RADIO_WAKE_US   20
+
+// Samples moved by the LDMA after each reading
+#define SAMPLES         1024
+#define LDMA_CHANNEL    0
+
+static const SLP_LevelInfo_TypeDef levels[SLP_LEVELS] = SLP_LEVELS_DEFAULT;
+
+static const char *levelNames[SLP_LEVELS] = {
+  "EM0", "EM1", "EM2 fast", "EM2 low", "EM3 fast", "EM3 low"
+};
+
+static SLP_Handle_TypeDef slp;
+static SLP_Timer_TypeDef sampleTimer, pulseTimer, pulseEnd;
+static SLP_Timer_TypeDef consoleEnd, reportTimer, serialEnd;
+static int ldmaClient, consoleClient, radioClient, serialClient;
+static volatile bool consoleOpen, radioOpen;
+
+static uint32_t samples[SAMPLES];
+static uint32_t sampleLog[SAMPLES];
+static LDMA_Descriptor_t desc;
+
+/**************************************************************************//**
+ * @brief
+ *   BURTC IRQ handler; the wake-up for the next timer.
+ *****************************************************************************/
+void BURTC_IRQHandler(void)
+{
+  SLP_IRQHandler();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The sample transfer is done; EM2 and EM3 are allowed again.
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  LDMA_IntClear(1 << LDMA_CHANNEL);
+  SLP_Release(&slp, ldmaClient);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take a reading, then move it to the log with the LDMA.  The LDMA does
+ *   not run in EM2, so the scheduler is held in EM1 until it is done.
+ *****************************************************************************/
+static void sample(void *user)
+{
+  static uint32_t n;
+  LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_MEMORY();
+  unsigned int i;
+
+  (void)user;
+  for (i = 0; i < SAMPLES; i++) {
+    samples[i] = n++;
+  }
+
+  SLP_Require(&slp, ldmaClient, slpEM1, 0xFFFF);
+  desc = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_SINGLE_M2M_WORD(samples, sampleLog, SAMPLES);
+  LDMA_StartTransfer(LDMA_CHANNEL, &cfg, &desc);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   LED0 pulse; GPIO outputs hold their state in EM2 and EM3.
+ *****************************************************************************/
+static void ledOff(void *user)
+{
+  (void)user;
+  GPIO_PinOutClear(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+}
+
+static void pulse(void *user)
+{
+  (void)user;
+  GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  SLP_TimerStart(&slp, &pulseEnd, SLP_Now(), PULSE_ON_MS, 0, ledOff, NULL);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   printf() returns with the last character still in the USART shift
+ *   register, and USART0 stops in EM2; stay in EM1 until it is out.
+ *****************************************************************************/
+static void serialDone(void *user)
+{
+  (void)user;
+  SLP_Release(&slp, serialClient);
+}
+
+static void serialDrain(void)
+{
+  SLP_Require(&slp, serialClient, slpEM1, 0xFFFF);
+  SLP_TimerStart(&slp, &serialEnd, SLP_Now(), SERIAL_DRAIN_MS, 0,
+                 serialDone, NULL);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The console window ends; USART0 no longer needs to receive.
+ *****************************************************************************/
+static void consoleClose(void *user)
+{
+  (void)user;
+  printf("console closed\n");
+  serialDrain();
+  consoleOpen = false;
+  SLP_Release(&slp, consoleClient);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Print the time spent in each level and the projected current.
+ *****************************************************************************/
+static void report(void *user)
+{
+  uint64_t total = 0;
+  int i;
+
+  (void)user;
+  for (i = 0; i < SLP_LEVELS; i++) {
+    total += slp.ticks[i];
+  }
+  printf("\n%lu s%s%s\n", (unsigned long)(total / 1000),
+         radioOpen ? ", fast wake-up" : "", consoleOpen ? ", console" : "");
+  for (i = 0; i < SLP_LEVELS; i++) {
+    printf("  %-9s %3lu.%01lu%%  %6lu entries\n", levelNames[i],
+           (unsigned long)(slp.ticks[i] * 100 / total),
+           (unsigned long)(slp.ticks[i] * 1000 / total % 10),
+           (unsigned long)slp.entries[i]);
+  }
+  printf("  projected average %lu uA\n",
+         (unsigned long)(SLP_AverageNa(&slp) / 1000));
+  serialDrain();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Push buttons.  PB0 toggles a radio window that must wake within 20 us,
+ *   which keeps the EM2/3 voltage scale up.  PB1 opens a 5 s console
+ *   window; USART0 receives only in EM1.
+ *****************************************************************************/
+static void buttons(uint32_t flags)
+{
+  if (flags & (1 << BSP_GPIO_PB0_PIN)) {
+    radioOpen = !radioOpen;
+    if (radioOpen) {
+      SLP_Require(&slp, radioClient, slpEM3, RADIO_WAKE_US);
+    } else {
+      SLP_Release(&slp, radioClient);
+    }
+  }
+  if (flags & (1 << BSP_GPIO_PB1_PIN)) {
+    consoleOpen = true;
+    SLP_Require(&slp, consoleClient, slpEM1, 0xFFFF);
+    SLP_TimerStart(&slp, &consoleEnd, SLP_Now(), CONSOLE_MS, 0,
+                   consoleClose, NULL);
+  }
+}
+
+void GPIO_EVEN_IRQHandler(void)
+{
+  uint32_t flags = GPIO_IntGet() & 0x55555555;
+
+  GPIO_IntClear(flags);
+  buttons(flags);
+}
+
+void GPIO_ODD_IRQHandler(void)
+{
+  uint32_t flags = GPIO_IntGet() & 0xAAAAAAAA;
+
+  GPIO_IntClear(flags);
+  buttons(flags);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   LED0, and the push buttons on interrupts that wake from EM2 and EM3.
+ *****************************************************************************/
+static void initGPIO(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN,
+                  gpioModeInputPullFilter, 1);
+  GPIO_ExtIntConfig(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, BSP_GPIO_PB0_PIN,
+                    false, true, true);
+  GPIO_PinModeSet(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN,
+                  gpioModeInputPullFilter, 1);
+  GPIO_ExtIntConfig(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, BSP_GPIO_PB1_PIN,
+                    false, true, true);
+
+  NVIC_ClearPendingIRQ(GPIO_EVEN_IRQn);
+  NVIC_EnableIRQ(GPIO_EVEN_IRQn);
+  NVIC_ClearPendingIRQ(GPIO_ODD_IRQn);
+  NVIC_EnableIRQ(GPIO_ODD_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  uint32_t tickHz, now;
+  int c;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+  initGPIO();
+
+  CMU_ClockEnable(cmuClock_LDMA, true);
+  LDMA_Init(&ldmaInit);
+
+  printf("\nSleep scheduler\n");
+
+  tickHz = SLP_Start();
+  now = SLP_Now();
+  SLP_Init(&slp, levels, tickHz, now);
+  ldmaClient = SLP_Register(&slp, "ldma");
+  consoleClient = SLP_Register(&slp, "console");
+  radioClient = SLP_Register(&slp, "radio");
+  serialClient = SLP_Register(&slp, "serial");
+
+  SLP_TimerStart(&slp, &sampleTimer, now, SAMPLE_MS, SAMPLE_MS, sample, NULL);
+  SLP_TimerStart(&slp, &pulseTimer, now, PULSE_MS, PULSE_MS, pulse, NULL);
+  SLP_TimerStart(&slp, &reportTimer, now, REPORT_MS, REPORT_MS, report, NULL);
+
+  while (1) {
+    SLP_Idle(&slp);
+
+    // Echo what arrives while the console window is open
+    while (consoleOpen && (c = RETARGET_ReadChar()) >= 0) {
+      putchar(c);
+    }
+  }
+}
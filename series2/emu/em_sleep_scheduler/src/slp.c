@@ -0,0 +1,473 @@
+/***************************************************************************//**
+ * @file slp.c
+ * @brief Sleep scheduler: picks the deepest energy mode and EM2/3 voltage
+ * scale that every driver allows for the time to the next timer.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "slp.h"
+
+// Idle time assumed when no timer is pending, in us
+#define IDLE_FOREVER_US   3600000000ULL
+
+#if defined(SLP_HOST)
+#define CORE_DECLARE_IRQ_STATE
+#define CORE_ENTER_CRITICAL()
+#define CORE_EXIT_CRITICAL()
+#else
+#include "em_device.h"
+#include "em_burtc.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_emu.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Start the scheduler time base.
+ *
+ * @details
+ *   The BURTC counts the 1 kHz ULFRCO and runs free; compare 0 wakes the
+ *   device for the next timer. The ULFRCO keeps running in EM3, so the
+ *   time base never limits the energy mode. The SYSRTC, clocked from the
+ *   LFRCO as in i2c_follower, would stop in EM3.
+ *
+ * @return
+ *   Scheduler ticks per second.
+ *****************************************************************************/
+uint32_t SLP_Start(void)
+{
+  BURTC_Init_TypeDef burtcInit = BURTC_INIT_DEFAULT;
+
+  CMU_ClockSelectSet(cmuClock_EM4GRPACLK, cmuSelect_ULFRCO);
+  CMU_ClockEnable(cmuClock_BURTC, true);
+
+  burtcInit.compare0Top = false;
+  BURTC_Init(&burtcInit);
+
+  BURTC_IntClear(BURTC_IF_COMP);
+  NVIC_ClearPendingIRQ(BURTC_IRQn);
+  NVIC_EnableIRQ(BURTC_IRQn);
+
+  return CMU_ClockFreqGet(cmuClock_BURTC);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Current scheduler time in ticks.
+ *****************************************************************************/
+uint32_t SLP_Now(void)
+{
+  return BURTC_CounterGet();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Wake-up for the next timer; call from BURTC_IRQHandler().
+ *
+ * @details
+ *   Timers run from SLP_Idle() in thread mode, not here.
+ *****************************************************************************/
+void SLP_IRQHandler(void)
+{
+  BURTC_IntClear(BURTC_IF_COMP);
+
+  // The BURTC is in an asynchronous clock domain; let the clear complete
+  __DSB();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run due timers, then sleep as deep as allowed until the next event.
+ *
+ * @details
+ *   Call from the main loop with nothing else to do. The decision and the
+ *   sleep are made with interrupts masked, so an interrupt that changes a
+ *   requirement or starts a timer cannot be missed: it wakes the core from
+ *   WFI and runs once the critical section ends. Timers fire late by the
+ *   wake-up time of the level slept in; drivers that cannot allow that set
+ *   maxWakeUs.
+ *****************************************************************************/
+void SLP_Idle(SLP_Handle_TypeDef *handle)
+{
+  const SLP_LevelInfo_TypeDef *info;
+  SLP_Level_TypeDef level;
+  EMU_EM23Init_TypeDef em23Init = EMU_EM23INIT_DEFAULT;
+  uint32_t now, wake;
+  CORE_DECLARE_IRQ_STATE;
+
+  SLP_Dispatch(handle, SLP_Now());
+
+  CORE_ENTER_CRITICAL();
+  now = SLP_Now();
+  level = SLP_Decide(handle, now);
+  if (level == slpLevelEM0) {
+    CORE_EXIT_CRITICAL();
+    return;
+  }
+  SLP_Account(handle, slpLevelEM0, now - handle->lastWake);
+
+  if (handle->timers != NULL) {
+    BURTC_IntClear(BURTC_IF_COMP);
+    BURTC_CompareSet(0, handle->timers->expiry);
+    BURTC_IntEnable(BURTC_IEN_COMP);
+  } else {
+    BURTC_IntDisable(BURTC_IEN_COMP);
+  }
+
+  info = &handle->levels[level];
+  if (info->em >= slpEM2 && info->lowPower != handle->lowPower) {
+    em23Init.vScaleEM23Voltage = info->lowPower ? emuVScaleEM23_LowPower
+                                 : emuVScaleEM23_FastWakeup;
+    EMU_EM23Init(&em23Init);
+    handle->lowPower = info->lowPower;
+  }
+
+  switch (info->em) {
+    case slpEM1:
+      EMU_EnterEM1();
+      break;
+    case slpEM2:
+      EMU_EnterEM2(true);
+      break;
+    default:
+      EMU_EnterEM3(true);
+      break;
+  }
+
+  wake = SLP_Now();
+  SLP_Account(handle, level, wake - now);
+  handle->entries[level]++;
+  handle->lastWake = wake;
+  CORE_EXIT_CRITICAL();
+}
+#endif // !SLP_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize a scheduler with no clients and no timers.
+ *
+ * @param[in] levels
+ *   SLP_LEVELS entries, usually SLP_LEVELS_DEFAULT; not copied.
+ *
+ * @param[in] now
+ *   Current time; accounting starts here.
+ *****************************************************************************/
+void SLP_Init(SLP_Handle_TypeDef *handle,
+              const SLP_LevelInfo_TypeDef *levels,
+              uint32_t tickHz,
+              uint32_t now)
+{
+  memset(handle, 0, sizeof(*handle));
+  handle->levels = levels;
+  handle->tickHz = tickHz;
+  handle->lastWake = now;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add a driver that can hold the scheduler out of deep sleep.
+ *
+ * @param[in] name
+ *   Used for reports only; must stay valid.
+ *
+ * @return
+ *   Client index, or -1 if SLP_MAX_CLIENTS are registered already.
+ *****************************************************************************/
+int SLP_Register(SLP_Handle_TypeDef *handle, const char *name)
+{
+  SLP_Client_TypeDef *c;
+
+  if (handle->count >= SLP_MAX_CLIENTS) {
+    return -1;
+  }
+  c = &handle->clients[handle->count];
+  c->name = name;
+  c->active = false;
+  return handle->count++;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Hold the scheduler to a mode and wake-up time until SLP_Release().
+ *
+ * @details
+ *   Callable from interrupt handlers. A second call replaces the first.
+ *
+ * @param[in] deepest
+ *   Deepest energy mode the driver works in, e.g. slpEM1 while an LDMA
+ *   transfer runs, since the LDMA stops in EM2.
+ *
+ * @param[in] maxWakeUs
+ *   Longest wake-up the driver can wait for; 0xFFFF for any.
+ *****************************************************************************/
+void SLP_Require(SLP_Handle_TypeDef *handle,
+                 int client,
+                 SLP_EM_TypeDef deepest,
+                 uint16_t maxWakeUs)
+{
+  SLP_Client_TypeDef *c = &handle->clients[client];
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  c->deepest = deepest;
+  c->maxWakeUs = maxWakeUs;
+  c->active = true;
+  c->requests++;
+  CORE_EXIT_CRITICAL();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Drop the hold of a driver; callable from interrupt handlers.
+ *****************************************************************************/
+void SLP_Release(SLP_Handle_TypeDef *handle, int client)
+{
+  handle->clients[client].active = false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start or restart a timer.
+ *
+ * @param[in] now
+ *   Current time.
+ *
+ * @param[in] delay
+ *   Ticks to the first expiry.
+ *
+ * @param[in] period
+ *   Ticks between later expiries; 0 for a one-shot timer.
+ *
+ * @param[in] callback
+ *   Called from SLP_Dispatch(), in thread mode.
+ *****************************************************************************/
+void SLP_TimerStart(SLP_Handle_TypeDef *handle,
+                    SLP_Timer_TypeDef *timer,
+                    uint32_t now,
+                    uint32_t delay,
+                    uint32_t period,
+                    SLP_Callback_TypeDef callback,
+                    void *user)
+{
+  SLP_Timer_TypeDef **p;
+  CORE_DECLARE_IRQ_STATE;
+
+  SLP_TimerStop(handle, timer);
+  timer->expiry = now + delay;
+  timer->period = period;
+  timer->callback = callback;
+  timer->user = user;
+
+  CORE_ENTER_CRITICAL();
+  // After any timer with the same expiry, so equal timers run in order
+  for (p = &handle->timers; *p != NULL; p = &(*p)->next) {
+    if ((int32_t)(timer->expiry - (*p)->expiry) < 0) {
+      break;
+    }
+  }
+  timer->next = *p;
+  *p = timer;
+  timer->active = true;
+  CORE_EXIT_CRITICAL();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Stop a timer; nothing happens if it is not running.
+ *****************************************************************************/
+void SLP_TimerStop(SLP_Handle_TypeDef *handle, SLP_Timer_TypeDef *timer)
+{
+  SLP_Timer_TypeDef **p;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  if (timer->active) {
+    for (p = &handle->timers; *p != NULL; p = &(*p)->next) {
+      if (*p == timer) {
+        *p = timer->next;
+        break;
+      }
+    }
+    timer->active = false;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Ticks from now to the first timer.
+ *
+ * @return
+ *   0 if a timer is due, SLP_FOREVER if none is running.
+ *****************************************************************************/
+uint32_t SLP_NextExpiry(const SLP_Handle_TypeDef *handle, uint32_t now)
+{
+  int32_t left;
+
+  if (handle->timers == NULL) {
+    return SLP_FOREVER;
+  }
+  left = (int32_t)(handle->timers->expiry - now);
+  return left > 0 ? (uint32_t)left : 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run the callbacks of all due timers.
+ *
+ * @details
+ *   A periodic timer is queued again before its callback runs, so the
+ *   callback may stop or restart it. A periodic timer that fell behind
+ *   skips the periods it missed rather than running once for each.
+ *
+ * @return
+ *   Callbacks run.
+ *****************************************************************************/
+int SLP_Dispatch(SLP_Handle_TypeDef *handle, uint32_t now)
+{
+  SLP_Timer_TypeDef *t;
+  uint32_t late;
+  int runs = 0;
+
+  while (SLP_NextExpiry(handle, now) == 0) {
+    t = handle->timers;
+    if (t->period != 0) {
+      late = now - t->expiry;
+      SLP_TimerStart(handle, t, t->expiry,
+                     t->period * (late / t->period + 1),
+                     t->period, t->callback, t->user);
+    } else {
+      SLP_TimerStop(handle, t);
+    }
+    if (t->callback != NULL) {
+      t->callback(t->user);
+    }
+    runs++;
+  }
+  return runs;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Choose how to spend the time until the next timer.
+ *
+ * @details
+ *   The deepest mode and the shortest wake-up of all holding clients limit
+ *   the choice. Of the levels left, the one using the least charge over the
+ *   idle time, wake-up included, wins; a level is skipped if its wake-up is
+ *   longer than the idle time. The result is a pure function of the
+ *   scheduler state and the time.
+ *
+ * @return
+ *   slpLevelEM0 if a timer is due within SLP_MIN_TICKS or a client needs
+ *   the core awake.
+ *****************************************************************************/
+SLP_Level_TypeDef SLP_Decide(const SLP_Handle_TypeDef *handle, uint32_t now)
+{
+  SLP_EM_TypeDef deepest = slpEM3;
+  uint32_t maxWakeUs = 0xFFFF, idle;
+  uint64_t idleUs, charge, best = UINT64_MAX;
+  SLP_Level_TypeDef level, choice = slpLevelEM0;
+  const SLP_LevelInfo_TypeDef *info;
+  int i;
+
+  for (i = 0; i < handle->count; i++) {
+    const SLP_Client_TypeDef *c = &handle->clients[i];
+    if (c->active) {
+      if (c->deepest < deepest) {
+        deepest = c->deepest;
+      }
+      if (c->maxWakeUs < maxWakeUs) {
+        maxWakeUs = c->maxWakeUs;
+      }
+    }
+  }
+
+  idle = SLP_NextExpiry(handle, now);
+  if (idle < SLP_MIN_TICKS || deepest == slpEM0) {
+    return slpLevelEM0;
+  }
+  idleUs = (idle == SLP_FOREVER) ? IDLE_FOREVER_US
+           : (uint64_t)idle * 1000000 / handle->tickHz;
+
+  for (level = slpLevelEM1; level < SLP_LEVELS; level++) {
+    info = &handle->levels[level];
+    if (info->em > deepest
+        || (level != slpLevelEM1
+            && (info->wakeUs > maxWakeUs || info->wakeUs > idleUs))) {
+      continue;
+    }
+    // pC: nA for the idle time plus the wake-up charge
+    charge = (uint64_t)info->currentNa * idleUs / 1000
+             + (uint64_t)info->wakeNc * 1000;
+    if (charge < best) {
+      best = charge;
+      choice = level;
+    }
+  }
+  return choice;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add time spent in a level; SLP_Idle() does this on the device.
+ *****************************************************************************/
+void SLP_Account(SLP_Handle_TypeDef *handle,
+                 SLP_Level_TypeDef level,
+                 uint32_t ticks)
+{
+  handle->ticks[level] += ticks;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Average supply current projected from the time in each level, the
+ *   wake-ups and the level table.
+ *
+ * @return
+ *   nA; 0 before any time is accounted.
+ *****************************************************************************/
+uint32_t SLP_AverageNa(const SLP_Handle_TypeDef *handle)
+{
+  uint64_t total = 0, charge = 0;
+  int i;
+
+  for (i = 0; i < SLP_LEVELS; i++) {
+    total += handle->ticks[i];
+    // nA x ticks, and nC x ticks per second for the wake-ups
+    charge += handle->ticks[i] * handle->levels[i].currentNa
+              + (uint64_t)handle->entries[i] * handle->levels[i].wakeNc
+              * handle->tickHz;
+  }
+  return total ? (uint32_t)(charge / total) : 0;
+}
@@ -0,0 +1,177 @@
+/***************************************************************************//**
+ * @file slp.h
+ * @brief Sleep scheduler: picks the deepest energy mode and EM2/3 voltage
+ * scale that every driver allows for the time to the next timer.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef SLP_H
+#define SLP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Drivers that can hold the scheduler out of deep sleep
+#define SLP_MAX_CLIENTS   8
+
+/*
+ * Shortest sleep, in ticks.  A new BURTC compare value takes a few cycles
+ * of its clock to take effect, so a timer due sooner is waited for awake.
+ */
+#ifndef SLP_MIN_TICKS
+#define SLP_MIN_TICKS     3
+#endif
+
+/// No timer pending
+#define SLP_FOREVER       0xFFFFFFFFUL
+
+/// Energy modes, shallowest first
+typedef enum {
+  slpEM0,           ///< Stay awake
+  slpEM1,
+  slpEM2,
+  slpEM3
+} SLP_EM_TypeDef;
+
+/// What the idle loop can do; time is kept per level
+typedef enum {
+  slpLevelEM0,      ///< Awake; running code or with work pending
+  slpLevelEM1,
+  slpLevelEM2Fast,  ///< EM2, EM23 voltage scale kept up for a fast wake
+  slpLevelEM2Low,   ///< EM2, EM23 voltage scaled down
+  slpLevelEM3Fast,
+  slpLevelEM3Low,
+  SLP_LEVELS
+} SLP_Level_TypeDef;
+
+/// Cost of a level; used for decisions and the current projection
+typedef struct {
+  SLP_EM_TypeDef em;
+  bool           lowPower;    ///< EM23 voltage scaled down
+  uint16_t       wakeUs;      ///< Wake-up to the first instruction
+  uint32_t       currentNa;   ///< Supply current in the level
+  uint32_t       wakeNc;      ///< Extra charge of one entry and wake-up
+} SLP_LevelInfo_TypeDef;
+
+/*
+ * Typical values for an EFR32xG24 at 3.0 V with the core at 19 MHz from
+ * the HFRCODPLL; replace them with figures from the device datasheet or
+ * from measurements with the Energy Profiler.
+ */
+#define SLP_LEVELS_DEFAULT                          \
+  {                                                 \
+    { slpEM0, false, 0, 1200000, 0 },               \
+    { slpEM1, false, 1, 750000, 0 },                \
+    { slpEM2, false, 15, 1900, 30 },                \
+    { slpEM2, true, 45, 1400, 60 },                 \
+    { slpEM3, false, 15, 1500, 30 },                \
+    { slpEM3, true, 45, 1050, 60 },                 \
+  }
+
+typedef void (*SLP_Callback_TypeDef)(void *user);
+
+/// A one-shot or periodic timer; times are in scheduler ticks
+typedef struct SLP_Timer {
+  struct SLP_Timer     *next;
+  uint32_t             expiry;
+  uint32_t             period;    ///< 0 for one-shot
+  SLP_Callback_TypeDef callback;
+  void                 *user;
+  bool                 active;
+} SLP_Timer_TypeDef;
+
+/// A driver's hold on the scheduler
+typedef struct {
+  const char     *name;
+  bool           active;      ///< Holding; set by SLP_Require()
+  SLP_EM_TypeDef deepest;     ///< Deepest mode it can work in
+  uint16_t       maxWakeUs;   ///< Longest wake-up it can wait for
+  uint32_t       requests;
+} SLP_Client_TypeDef;
+
+/// Scheduler state
+typedef struct {
+  const SLP_LevelInfo_TypeDef *levels;
+  uint32_t            tickHz;
+  SLP_Client_TypeDef  clients[SLP_MAX_CLIENTS];
+  uint8_t             count;
+  SLP_Timer_TypeDef   *timers;                  ///< Sorted by expiry
+
+  // Accounting
+  uint32_t            lastWake;
+  uint64_t            ticks[SLP_LEVELS];
+  uint32_t            entries[SLP_LEVELS];
+  bool                lowPower;                 ///< EM23 scale now set
+} SLP_Handle_TypeDef;
+
+void SLP_Init(SLP_Handle_TypeDef *handle,
+              const SLP_LevelInfo_TypeDef *levels,
+              uint32_t tickHz,
+              uint32_t now);
+int SLP_Register(SLP_Handle_TypeDef *handle, const char *name);
+void SLP_Require(SLP_Handle_TypeDef *handle,
+                 int client,
+                 SLP_EM_TypeDef deepest,
+                 uint16_t maxWakeUs);
+void SLP_Release(SLP_Handle_TypeDef *handle, int client);
+void SLP_TimerStart(SLP_Handle_TypeDef *handle,
+                    SLP_Timer_TypeDef *timer,
+                    uint32_t now,
+                    uint32_t delay,
+                    uint32_t period,
+                    SLP_Callback_TypeDef callback,
+                    void *user);
+void SLP_TimerStop(SLP_Handle_TypeDef *handle, SLP_Timer_TypeDef *timer);
+uint32_t SLP_NextExpiry(const SLP_Handle_TypeDef *handle, uint32_t now);
+int SLP_Dispatch(SLP_Handle_TypeDef *handle, uint32_t now);
+SLP_Level_TypeDef SLP_Decide(const SLP_Handle_TypeDef *handle, uint32_t now);
+void SLP_Account(SLP_Handle_TypeDef *handle,
+                 SLP_Level_TypeDef level,
+                 uint32_t ticks);
+uint32_t SLP_AverageNa(const SLP_Handle_TypeDef *handle);
+
+#if !defined(SLP_HOST)
+uint32_t SLP_Start(void);
+uint32_t SLP_Now(void);
+void SLP_Idle(SLP_Handle_TypeDef *handle);
+void SLP_IRQHandler(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SLP_H
@@ -0,0 +1,480 @@
+/***************************************************************************//**
+ * @file slp_sim.c
+ * @brief Host test and benchmark for the sleep scheduler.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DSLP_HOST -I../src -o slp_sim slp_sim.c ../src/slp.c
+ *   ./slp_sim
+ *
+ * Checks the mode and voltage scale chosen for each combination of client
+ * holds and idle time, and the timer queue against a reference model with
+ * random starts and stops across the counter wrap. The example's workload
+ * then runs for a simulated hour on a 1 kHz time base: a sensor timer with
+ * an LDMA transfer after each sample, a console window that needs EM1, a
+ * radio window that needs a fast wake-up and a LED pulse. Every decision
+ * must respect the holds in force, and the projected average current is
+ * compared with fixed EM1 and EM2 idle loops. The exit status is non-zero
+ * if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "slp.h"
+
+#define TICK_HZ   1000
+
+static const SLP_LevelInfo_TypeDef levels[SLP_LEVELS] = SLP_LEVELS_DEFAULT;
+
+static const char *levelNames[SLP_LEVELS] = {
+  "EM0", "EM1", "EM2 fast", "EM2 low", "EM3 fast", "EM3 low"
+};
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void nop(void *user)
+{
+  (void)user;
+}
+
+static void testDecide(void)
+{
+  SLP_Handle_TypeDef h;
+  SLP_Timer_TypeDef t;
+  int uart, radio, ldma, poll;
+
+  SLP_Init(&h, levels, TICK_HZ, 0);
+  uart = SLP_Register(&h, "uart");
+  radio = SLP_Register(&h, "radio");
+  ldma = SLP_Register(&h, "ldma");
+  poll = SLP_Register(&h, "poll");
+
+  check(SLP_Decide(&h, 0) == slpLevelEM3Low, "no timer: deepest");
+
+  SLP_TimerStart(&h, &t, 0, 1000, 0, nop, NULL);
+  check(SLP_Decide(&h, 0) == slpLevelEM3Low, "1 s idle: EM3 low");
+
+  SLP_Require(&h, uart, slpEM2, 0xFFFF);
+  check(SLP_Decide(&h, 0) == slpLevelEM2Low, "EM2 client");
+
+  SLP_Require(&h, radio, slpEM3, 20);
+  check(SLP_Decide(&h, 0) == slpLevelEM2Fast, "fast wake client");
+  SLP_Release(&h, uart);
+  check(SLP_Decide(&h, 0) == slpLevelEM3Fast, "fast wake only");
+
+  SLP_Require(&h, radio, slpEM3, 0);
+  check(SLP_Decide(&h, 0) == slpLevelEM1, "no wake-up time: EM1");
+  SLP_Release(&h, radio);
+
+  SLP_Require(&h, ldma, slpEM1, 0xFFFF);
+  check(SLP_Decide(&h, 0) == slpLevelEM1, "EM1 client");
+  SLP_Require(&h, poll, slpEM0, 0xFFFF);
+  check(SLP_Decide(&h, 0) == slpLevelEM0, "EM0 client");
+  SLP_Release(&h, poll);
+  SLP_Release(&h, ldma);
+
+  // Voltage scaling pays off after 30 nC / 450 nA, about 67 ms
+  SLP_TimerStart(&h, &t, 0, 50, 0, nop, NULL);
+  check(SLP_Decide(&h, 0) == slpLevelEM3Fast, "short idle keeps VS up");
+  SLP_TimerStart(&h, &t, 0, 100, 0, nop, NULL);
+  check(SLP_Decide(&h, 0) == slpLevelEM3Low, "long idle scales down");
+
+  SLP_TimerStart(&h, &t, 0, SLP_MIN_TICKS - 1, 0, nop, NULL);
+  check(SLP_Decide(&h, 0) == slpLevelEM0, "too close to sleep");
+  SLP_TimerStart(&h, &t, 0, SLP_MIN_TICKS, 0, nop, NULL);
+  check(SLP_Decide(&h, 0) == slpLevelEM3Fast, "shortest sleep");
+  check(SLP_Decide(&h, SLP_MIN_TICKS) == slpLevelEM0, "timer due");
+  check(SLP_Decide(&h, SLP_MIN_TICKS + 5) == slpLevelEM0, "timer late");
+
+  check(SLP_Register(&h, "5") >= 0 && SLP_Register(&h, "6") >= 0
+        && SLP_Register(&h, "7") >= 0 && SLP_Register(&h, "8") >= 0,
+        "register up to the limit");
+  check(SLP_Register(&h, "9") == -1, "register past the limit");
+}
+
+// Timer queue against a reference model
+#define QT  64
+
+typedef struct {
+  SLP_Handle_TypeDef *h;
+  int               index;
+} QUser_TypeDef;
+
+static SLP_Timer_TypeDef qTimers[QT];
+static QUser_TypeDef qUsers[QT];
+static int qLog[4 * QT];
+static int qLogged;
+static int qStopSelf = -1;
+
+static void qCallback(void *user)
+{
+  QUser_TypeDef *u = user;
+
+  if (qLogged < 4 * QT) {
+    qLog[qLogged++] = u->index;
+  }
+  if (u->index == qStopSelf) {
+    SLP_TimerStop(u->h, &qTimers[u->index]);
+  }
+}
+
+typedef struct {
+  bool     active;
+  uint32_t expiry;
+  uint32_t period;
+  uint32_t seq;     // Start order, for equal expiries
+} Ref_TypeDef;
+
+static void testQueue(void)
+{
+  SLP_Handle_TypeDef h;
+  Ref_TypeDef ref[QT];
+  uint32_t now = 0xFFFF0000UL, seq = 0, step;
+  int round, i, j, best, expect[4 * QT], expected, errors = 0;
+
+  SLP_Init(&h, levels, TICK_HZ, now);
+  memset(ref, 0, sizeof(ref));
+  for (i = 0; i < QT; i++) {
+    qUsers[i].h = &h;
+    qUsers[i].index = i;
+  }
+
+  // Across the 32-bit wrap
+  for (round = 0; round < 20000; round++) {
+    i = rand() % QT;
+    if (rand() % 4 == 0) {
+      SLP_TimerStop(&h, &qTimers[i]);
+      ref[i].active = false;
+    } else {
+      uint32_t delay = (uint32_t)(rand() % 200);
+      uint32_t period = (rand() % 3 == 0) ? (uint32_t)(1 + rand() % 150) : 0;
+      SLP_TimerStart(&h, &qTimers[i], now, delay, period, qCallback,
+                     &qUsers[i]);
+      ref[i].active = true;
+      ref[i].expiry = now + delay;
+      ref[i].period = period;
+      ref[i].seq = seq++;
+    }
+
+    step = (uint32_t)(rand() % 40);
+    now += step;
+
+    // Reference: due timers in expiry, then start, order
+    expected = 0;
+    for (;;) {
+      best = -1;
+      for (j = 0; j < QT; j++) {
+        if (ref[j].active && (int32_t)(ref[j].expiry - now) <= 0
+            && (best < 0
+                || (int32_t)(ref[j].expiry - ref[best].expiry) < 0
+                || (ref[j].expiry == ref[best].expiry
+                    && ref[j].seq < ref[best].seq))) {
+          best = j;
+        }
+      }
+      if (best < 0) {
+        break;
+      }
+      expect[expected++] = best;
+      if (ref[best].period) {
+        uint32_t late = now - ref[best].expiry;
+        ref[best].expiry += ref[best].period * (late / ref[best].period + 1);
+        ref[best].seq = seq++;
+      } else {
+        ref[best].active = false;
+      }
+    }
+
+    qLogged = 0;
+    if (SLP_Dispatch(&h, now) != expected || qLogged != expected
+        || memcmp(qLog, expect, expected * sizeof(int)) != 0) {
+      errors++;
+    }
+    for (j = 0; j < QT; j++) {
+      if (qTimers[j].active != ref[j].active
+          || (ref[j].active && qTimers[j].expiry != ref[j].expiry)) {
+        errors++;
+        break;
+      }
+    }
+  }
+  check(errors == 0, "timer queue matches the reference");
+
+  // A periodic timer that stops itself runs once
+  SLP_Init(&h, levels, TICK_HZ, 0);
+  qStopSelf = 3;
+  SLP_TimerStart(&h, &qTimers[3], 0, 10, 10, qCallback, &qUsers[3]);
+  qUsers[3].h = &h;
+  qLogged = 0;
+  SLP_Dispatch(&h, 10);
+  SLP_Dispatch(&h, 100);
+  check(qLogged == 1 && !qTimers[3].active, "periodic timer stops itself");
+  qStopSelf = -1;
+
+  // A timer late by several periods runs once and keeps its phase
+  SLP_TimerStart(&h, &qTimers[4], 0, 10, 10, qCallback, &qUsers[4]);
+  qUsers[4].h = &h;
+  qLogged = 0;
+  SLP_Dispatch(&h, 55);
+  check(qLogged == 1 && qTimers[4].expiry == 60, "missed periods skipped");
+}
+
+/*
+ * The example's workload.  Callbacks keep the core awake for their work
+ * and start one-shot timers for the ends of LDMA transfers and windows.
+ */
+typedef struct {
+  SLP_Handle_TypeDef *h;
+  uint32_t          now;
+  uint32_t          busyUntil;
+  int               ldma, console, radio;
+  SLP_Timer_TypeDef sensor, sensorDone, pulse, pulseEnd;
+  SLP_Timer_TypeDef consoleOpen, consoleClose, radioOpen, radioClose;
+  uint32_t          samples;
+} Work_TypeDef;
+
+static Work_TypeDef work;
+
+static void busy(uint32_t ticks)
+{
+  if (work.now + ticks > work.busyUntil) {
+    work.busyUntil = work.now + ticks;
+  }
+}
+
+static void sensorDone(void *user)
+{
+  (void)user;
+  SLP_Release(work.h, work.ldma);
+}
+
+// Sample, then move the samples with the LDMA for 5 ms in EM1
+static void sensorRun(void *user)
+{
+  (void)user;
+  work.samples++;
+  busy(2);
+  SLP_Require(work.h, work.ldma, slpEM1, 0xFFFF);
+  SLP_TimerStart(work.h, &work.sensorDone, work.now, 7, 0, sensorDone, NULL);
+}
+
+static void pulseEnd(void *user)
+{
+  (void)user;
+}
+
+static void pulse(void *user)
+{
+  (void)user;
+  SLP_TimerStart(work.h, &work.pulseEnd, work.now, 20, 0, pulseEnd, NULL);
+}
+
+static void consoleClose(void *user)
+{
+  (void)user;
+  SLP_Release(work.h, work.console);
+}
+
+// A 5 s console window a minute; the USART receives only in EM1
+static void consoleOpen(void *user)
+{
+  (void)user;
+  SLP_Require(work.h, work.console, slpEM1, 0xFFFF);
+  SLP_TimerStart(work.h, &work.consoleClose, work.now, 5000, 0,
+                 consoleClose, NULL);
+}
+
+static void radioClose(void *user)
+{
+  (void)user;
+  SLP_Release(work.h, work.radio);
+}
+
+// A 10 s window every 5 minutes that must wake within 20 us
+static void radioOpen(void *user)
+{
+  (void)user;
+  SLP_Require(work.h, work.radio, slpEM3, 20);
+  SLP_TimerStart(work.h, &work.radioClose, work.now, 10000, 0,
+                 radioClose, NULL);
+}
+
+/*
+ * Run the workload for the given time.  fixed < 0 lets the scheduler
+ * choose; otherwise every sleep uses that level, or EM1 while a client
+ * needs it.  Returns the projected average current in nA.
+ */
+static uint32_t runWorkload(SLP_Handle_TypeDef *h, uint32_t duration,
+                            int fixed, int *violations)
+{
+  SLP_Level_TypeDef level;
+  uint32_t idle, end;
+  int i;
+
+  memset(&work, 0, sizeof(work));
+  work.h = h;
+  SLP_Init(h, levels, TICK_HZ, 0);
+  work.ldma = SLP_Register(h, "ldma");
+  work.console = SLP_Register(h, "console");
+  work.radio = SLP_Register(h, "radio");
+  SLP_TimerStart(h, &work.sensor, 0, 1000, 1000, sensorRun, NULL);
+  SLP_TimerStart(h, &work.pulse, 0, 2000, 2000, pulse, NULL);
+  SLP_TimerStart(h, &work.consoleOpen, 0, 30000, 60000, consoleOpen, NULL);
+  SLP_TimerStart(h, &work.radioOpen, 0, 150000, 300000, radioOpen, NULL);
+
+  end = duration;
+  while (work.now < end) {
+    SLP_Dispatch(h, work.now);
+    if (work.busyUntil > work.now) {
+      SLP_Account(h, slpLevelEM0, work.busyUntil - work.now);
+      work.now = work.busyUntil;
+      continue;
+    }
+
+    level = SLP_Decide(h, work.now);
+    if (level != slpLevelEM0 && fixed >= 0) {
+      level = (level == slpLevelEM1) ? slpLevelEM1 : (SLP_Level_TypeDef)fixed;
+    }
+
+    // Check the choice against the holds in force
+    for (i = 0; i < h->count; i++) {
+      const SLP_Client_TypeDef *c = &h->clients[i];
+      if (c->active && level != slpLevelEM0
+          && (levels[level].em > c->deepest
+              || (level > slpLevelEM1
+                  && levels[level].wakeUs > c->maxWakeUs))) {
+        (*violations)++;
+      }
+    }
+
+    idle = SLP_NextExpiry(h, work.now);
+    if (idle > end - work.now) {
+      idle = end - work.now;
+    }
+    if (level == slpLevelEM0) {
+      idle = idle ? idle : 1;
+    } else {
+      h->entries[level]++;
+    }
+    SLP_Account(h, level, idle);
+    work.now += idle;
+  }
+  return SLP_AverageNa(h);
+}
+
+static void testWorkload(void)
+{
+  static SLP_Handle_TypeDef h;
+  uint32_t sched, em1, em2, hour = 3600 * TICK_HZ;
+  uint64_t total = 0;
+  int violations = 0, i;
+
+  sched = runWorkload(&h, hour, -1, &violations);
+  check(violations == 0, "decisions respect every hold");
+  for (i = 0; i < SLP_LEVELS; i++) {
+    total += h.ticks[i];
+  }
+  check(total == hour, "every tick accounted");
+  check(work.samples == 3599, "sensor ran every second");
+
+  // Transfers during a console window overlap it; samples there are EM0
+  check(h.ticks[slpLevelEM1] >= 5 * (3599 - 300) + 60 * (5000 - 5 * 2),
+        "EM1 for every transfer and console window");
+  check(h.ticks[slpLevelEM3Fast] > 0 && h.ticks[slpLevelEM3Low] > 0,
+        "both EM3 voltage scales used");
+
+  printf("one hour of the example's workload:\n");
+  for (i = 0; i < SLP_LEVELS; i++) {
+    printf("  %-9s %7.3f%%  %6u entries\n", levelNames[i],
+           100.0 * (double)h.ticks[i] / hour, h.entries[i]);
+  }
+
+  violations = 0;
+  em1 = runWorkload(&h, hour, slpLevelEM1, &violations);
+  em2 = runWorkload(&h, hour, slpLevelEM2Fast, &violations);
+  check(violations == 0, "fixed EM2 respects EM1 holds");
+  check(sched < em2 && em2 < em1, "scheduler beats fixed modes");
+  printf("average current: scheduler %.1f uA, fixed EM2 %.1f uA, "
+         "fixed EM1 %.1f uA\n", sched / 1000.0, em2 / 1000.0, em1 / 1000.0);
+}
+
+static void benchmark(void)
+{
+  SLP_Handle_TypeDef h;
+  static SLP_Timer_TypeDef timers[16];
+  clock_t start;
+  double seconds;
+  uint32_t sum = 0;
+  int i, n = 20000000;
+
+  SLP_Init(&h, levels, TICK_HZ, 0);
+  for (i = 0; i < SLP_MAX_CLIENTS; i++) {
+    SLP_Register(&h, "client");
+    if (i & 1) {
+      SLP_Require(&h, i, slpEM3, (uint16_t)(100 + i));
+    }
+  }
+  for (i = 0; i < 16; i++) {
+    SLP_TimerStart(&h, &timers[i], 0, (uint32_t)(100 + 37 * i), 0, nop, NULL);
+  }
+
+  start = clock();
+  for (i = 0; i < n; i++) {
+    sum += SLP_Decide(&h, (uint32_t)(i & 63));
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  check(sum != 0, "benchmark");
+  printf("decision with %d clients: %.1f ns on this host\n",
+         SLP_MAX_CLIENTS, seconds * 1e9 / n);
+}
+
+int main(void)
+{
+  srand(1);
+  testDecide();
+  testQueue();
+  testWorkload();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,71 @@
+/***************************************************************************//**
+ * @file bootpoints.h
+ * @brief Boot profile checkpoints of this example, shared by the firmware
+ * and the host decoder.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef BOOTPOINTS_H
+#define BOOTPOINTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Each checkpoint is named after the work that ends at it. Add new ones at
+ * the end so profiles captured before still decode.
+ ******************************************************************************/
+#define BOOTPOINTS(X)                                          \
+  X(BOOT_SYSTEMINIT,      "SystemInit() entry")                \
+  X(BOOT_SYSTEMINIT_END,  "SystemInit(): VTOR, FPU, SMU")      \
+  X(BOOT_MAIN,            "C runtime: .data, .bss")            \
+  X(BOOT_CHIP_INIT,       "CHIP_Init()")                       \
+  X(BOOT_DCDC,            "EMU_DCDCInit()")                    \
+  X(BOOT_HFXO,            "HFXO start, SYSCLK switch")         \
+  X(BOOT_SERIAL,          "serial port")                       \
+  X(BOOT_GPIO,            "LED and button")                    \
+  X(BOOT_READY,           "ready")
+
+#define BOOTPOINTS_ENUM(id, name)  id,
+
+/// Checkpoint numbers
+typedef enum {
+  BOOTPOINTS(BOOTPOINTS_ENUM)
+  BOOT_POINT_COUNT
+} BootPoint_TypeDef;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOTPOINTS_H
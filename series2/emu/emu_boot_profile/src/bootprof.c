@@ -0,0 +1,177 @@
+/***************************************************************************//**
+ * @file bootprof.c
+ * @brief Boot profile: core cycle timestamps taken at named checkpoints
+ * from SystemInit() onwards, kept in RAM that survives warm resets.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "bootprof.h"
+
+#if !defined(BOOTPROF_HOST)
+#include "em_device.h"
+
+#define CYCLES()  (DWT->CYCCNT)
+#else
+#define CYCLES()  BOOTPROF_HostCycles()
+#endif
+
+// Not initialized by the startup code; see BOOTPROF_NOINIT
+BOOTPROF_NOINIT BOOTPROF_Store_TypeDef BOOTPROF_Store;
+
+/**************************************************************************//**
+ * @brief
+ *   Check that a table holds a profile and not leftover RAM contents.
+ *****************************************************************************/
+bool BOOTPROF_Valid(const BOOTPROF_Table_TypeDef *table)
+{
+  return (table->magic == BOOTPROF_MAGIC) && (table->boot != 0);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Number of marks held in a valid table.
+ *****************************************************************************/
+uint32_t BOOTPROF_Stored(const BOOTPROF_Table_TypeDef *table)
+{
+  return (table->count < BOOTPROF_MAX_MARKS) ? table->count
+         : BOOTPROF_MAX_MARKS;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start a new profile and take its first mark.
+ *
+ * @details
+ *   Called first thing in SystemInit(). It runs before .data and .bss are
+ *   set up, so it must not use any variable other than BOOTPROF_Store. A
+ *   valid profile left by the last boot becomes the previous one, which
+ *   keeps the profile of a boot that never got as far as printing it.
+ *
+ * @param[in] point
+ *   Checkpoint number of the first mark.
+ *
+ * @param[in] hz
+ *   Core clock frequency out of reset.
+ *****************************************************************************/
+void BOOTPROF_Start(uint32_t point, uint32_t hz)
+{
+  BOOTPROF_Table_TypeDef *current = &BOOTPROF_Store.current;
+  uint32_t boot = 1;
+
+  if (BOOTPROF_Valid(current)) {
+    BOOTPROF_Store.previous = *current;
+    boot = current->boot + 1;
+  } else {
+    BOOTPROF_Store.previous.magic = 0;
+  }
+
+  current->magic = BOOTPROF_MAGIC;
+  current->boot = boot;
+  current->count = 0;
+
+#if !defined(BOOTPROF_HOST)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+  BOOTPROF_Mark(point, hz);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take a mark at a checkpoint.
+ *
+ * @details
+ *   The counter is read before anything else, so a mark costs about 20
+ *   cycles after its timestamp. Marks past BOOTPROF_MAX_MARKS are counted
+ *   and dropped.
+ *
+ * @param[in] point
+ *   Checkpoint number; the host decoder names it.
+ *
+ * @param[in] hz
+ *   Core clock frequency now. The cycles up to the next mark are converted
+ *   to time with it.
+ *****************************************************************************/
+void BOOTPROF_Mark(uint32_t point, uint32_t hz)
+{
+  uint32_t now = CYCLES();
+  BOOTPROF_Table_TypeDef *current = &BOOTPROF_Store.current;
+  uint32_t n = current->count;
+
+  if (current->magic != BOOTPROF_MAGIC) {
+    return;
+  }
+  if (n < BOOTPROF_MAX_MARKS) {
+    current->marks[n].cycles = now;
+    current->marks[n].hz = hz;
+    current->marks[n].point = point;
+  }
+  current->count = n + 1;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Write a table as text for tools/bootdecode.
+ *
+ * @details
+ *   One header line "bootprof <boot> <count>", one line
+ *   "<point> <cycles in hex> <hz>" per stored mark and a final "end".
+ *
+ * @return
+ *   false if the table is not valid; nothing is written then.
+ *****************************************************************************/
+bool BOOTPROF_Dump(const BOOTPROF_Table_TypeDef *table,
+                   BOOTPROF_Emit_TypeDef emit)
+{
+  char line[40];
+  uint32_t i;
+
+  if (!BOOTPROF_Valid(table)) {
+    return false;
+  }
+
+  snprintf(line, sizeof(line), "bootprof %lu %lu",
+           (unsigned long)table->boot, (unsigned long)table->count);
+  emit(line);
+  for (i = 0; i < BOOTPROF_Stored(table); i++) {
+    snprintf(line, sizeof(line), "%lu %08lx %lu",
+             (unsigned long)table->marks[i].point,
+             (unsigned long)table->marks[i].cycles,
+             (unsigned long)table->marks[i].hz);
+    emit(line);
+  }
+  emit("end");
+  return true;
+}
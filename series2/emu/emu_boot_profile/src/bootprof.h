@@ -0,0 +1,109 @@
+/***************************************************************************//**
+ * @file bootprof.h
+ * @brief Boot profile: core cycle timestamps taken at named checkpoints
+ * from SystemInit() onwards, kept in RAM that survives warm resets.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef BOOTPROF_H
+#define BOOTPROF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * The tables are written from SystemInit(), before the C runtime copies
+ * .data and clears .bss, so they must live in RAM the startup code does not
+ * touch. With GCC this needs one of the *_linker_script_ram_placement.ld
+ * scripts in series2/linker_scripts; with IAR __no_init does the same.
+ ******************************************************************************/
+#if defined(BOOTPROF_HOST)
+#define BOOTPROF_NOINIT
+#elif defined(__GNUC__)
+#define BOOTPROF_NOINIT   __attribute__((section(".retained_noinit")))
+#elif defined(__ICCARM__)
+#define BOOTPROF_NOINIT   __no_init
+#endif
+
+/// Checkpoints kept per boot; later ones are counted but not stored
+#define BOOTPROF_MAX_MARKS  24
+
+/// Marks a table as written by this module ("BOOT")
+#define BOOTPROF_MAGIC      0x424F4F54UL
+
+/// One checkpoint
+typedef struct {
+  uint32_t cycles;      ///< Core clock cycles since BOOTPROF_Start()
+  uint32_t hz;          ///< Core clock frequency when the mark was taken
+  uint32_t point;       ///< Application checkpoint number
+} BOOTPROF_Mark_TypeDef;
+
+/// Checkpoints of one boot
+typedef struct {
+  uint32_t              magic;  ///< BOOTPROF_MAGIC when valid
+  uint32_t              boot;   ///< Boots since the last power-on, from 1
+  uint32_t              count;  ///< Marks taken, stored or not
+  BOOTPROF_Mark_TypeDef marks[BOOTPROF_MAX_MARKS];
+} BOOTPROF_Table_TypeDef;
+
+/// The boot being recorded and the one before it
+typedef struct {
+  BOOTPROF_Table_TypeDef current;
+  BOOTPROF_Table_TypeDef previous;  ///< Invalid after a power-on
+} BOOTPROF_Store_TypeDef;
+
+extern BOOTPROF_Store_TypeDef BOOTPROF_Store;
+
+/// Receives one line of BOOTPROF_Dump() output, without the newline
+typedef void (*BOOTPROF_Emit_TypeDef)(const char *line);
+
+void BOOTPROF_Start(uint32_t point, uint32_t hz);
+void BOOTPROF_Mark(uint32_t point, uint32_t hz);
+bool BOOTPROF_Valid(const BOOTPROF_Table_TypeDef *table);
+uint32_t BOOTPROF_Stored(const BOOTPROF_Table_TypeDef *table);
+bool BOOTPROF_Dump(const BOOTPROF_Table_TypeDef *table,
+                   BOOTPROF_Emit_TypeDef emit);
+
+#if defined(BOOTPROF_HOST)
+// Provided by the host program in place of DWT_CYCCNT
+uint32_t BOOTPROF_HostCycles(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOTPROF_H
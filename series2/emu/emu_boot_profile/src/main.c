@@ -0,0 +1,151 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Boot profile of SystemInit(), the C runtime startup, DCDC, clock
+ * and peripheral initialization, printed for the host decoder.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "bootprof.h"
+#include "bootpoints.h"
+
+// HFXO frequency on the radio boards
+#define HFXO_FREQ   39000000
+
+// Take a mark at the current core clock; SystemCoreClock is valid in main()
+#define MARK(point) BOOTPROF_Mark((point), SystemCoreClock)
+
+/**************************************************************************//**
+ * @brief  Start the HFXO and run the core from it
+ *****************************************************************************/
+void initCMU(void)
+{
+  // Initialization structure for HFXO configuration
+  CMU_HFXOInit_TypeDef hfxoInit = CMU_HFXOINIT_DEFAULT;
+
+  // Check if device has HFXO configuration information in DEVINFO page
+  if (DEVINFO->MODULEINFO & DEVINFO_MODULEINFO_HFXOCALVAL) {
+    // Use the DEVINFO page's CTUNE values
+    hfxoInit.ctuneXoAna = (DEVINFO->MODXOCAL & DEVINFO_MODXOCAL_HFXOCTUNEXOANA_DEFAULT)
+        >> _DEVINFO_MODXOCAL_HFXOCTUNEXOANA_SHIFT;
+    hfxoInit.ctuneXiAna = (DEVINFO->MODXOCAL & DEVINFO_MODXOCAL_HFXOCTUNEXIANA_DEFAULT)
+        >> _DEVINFO_MODXOCAL_HFXOCTUNEXIANA_SHIFT;
+  }
+
+  // Configure HFXO settings
+  CMU_HFXOInit(&hfxoInit);
+
+  // Set system HFXO frequency
+  SystemHFXOClockSet(HFXO_FREQ);
+
+  /*
+   * Selecting HFXO waits for it to start and be ready, which is usually
+   * the longest single step of a boot. The switch also updates
+   * SystemCoreClock for the following marks.
+   */
+  CMU_ClockSelectSet(cmuClock_SYSCLK, cmuSelect_HFXO);
+}
+
+/**************************************************************************//**
+ * @brief  LED0 shows the board is up; push button 0 resets it
+ *****************************************************************************/
+void initGPIO(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN,
+                  gpioModeInputPullFilter, 1);
+}
+
+/**************************************************************************//**
+ * @brief  Print one line of a boot profile
+ *****************************************************************************/
+static void emitLine(const char *line)
+{
+  printf("%s\n", line);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_WSTK_DEFAULT;
+
+  // The C runtime startup ran between SystemInit() and here
+  MARK(BOOT_MAIN);
+
+  // Chip errata
+  CHIP_Init();
+  MARK(BOOT_CHIP_INIT);
+
+  EMU_DCDCInit(&dcdcInit);
+  MARK(BOOT_DCDC);
+
+  initCMU();
+  MARK(BOOT_HFXO);
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+  MARK(BOOT_SERIAL);
+
+  initGPIO();
+  MARK(BOOT_GPIO);
+
+  // The application would start its real work here
+  GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  MARK(BOOT_READY);
+
+  /*
+   * Everything printed is for tools/bootdecode; paste the terminal output
+   * into it. The previous boot is still there after a warm reset, whether
+   * or not that boot got as far as printing its own profile.
+   */
+  printf("\n-- Boot profile, decode with tools/bootdecode\n");
+  BOOTPROF_Dump(&BOOTPROF_Store.previous, emitLine);
+  BOOTPROF_Dump(&BOOTPROF_Store.current, emitLine);
+  printf("-- Press PB0 to reset and profile another boot\n");
+  RETARGET_SerialFlush();
+
+  while (GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) != 0) {
+  }
+  NVIC_SystemReset();
+}
@@ -0,0 +1,400 @@
+/***************************************************************************//**
+ * @file bootdecode.c
+ * @brief Host decoder for the boot profiles printed by emu_boot_profile.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DBOOTPROF_HOST -I../src -o bootdecode bootdecode.c ../src/bootprof.c
+ *   ./bootdecode capture.txt      (or the terminal output on stdin)
+ *   ./bootdecode -t               (self-test)
+ *
+ * Every "bootprof" block in the input is printed as a table of checkpoints
+ * with the time each one was reached and the time the step before it took.
+ * Lines may carry terminal prefixes such as timestamps. A block with a
+ * missing or damaged line is reported and skipped.
+ *
+ * The self-test records profiles through ../src/bootprof.c with a counter
+ * standing in for DWT_CYCCNT, prints them and decodes the text again. The
+ * exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bootprof.h"
+#include "bootpoints.h"
+
+#define BOOTPOINTS_NAME(id, name)  name,
+
+static const char *const pointNames[BOOT_POINT_COUNT] = {
+  BOOTPOINTS(BOOTPOINTS_NAME)
+};
+
+/*******************************************************************************
+ * Decoder
+ ******************************************************************************/
+
+typedef enum {
+  lineIgnored,      // Not part of a profile
+  lineTaken,        // Part of the open profile
+  lineComplete,     // "end" of a well-formed profile
+  lineDamaged       // Profile abandoned
+} LineResult_TypeDef;
+
+typedef struct {
+  BOOTPROF_Table_TypeDef table;
+  uint32_t               lines;   // Mark lines read
+  bool                   open;
+} Decoder_TypeDef;
+
+static LineResult_TypeDef decodeLine(Decoder_TypeDef *d, const char *line)
+{
+  const char *header = strstr(line, "bootprof ");
+  unsigned long a, b, c;
+  char extra;
+
+  if (header != NULL) {
+    // A new header also ends a profile whose "end" was lost
+    LineResult_TypeDef result = d->open ? lineDamaged : lineTaken;
+
+    d->open = false;
+    if (sscanf(header, "bootprof %lu %lu %c", &a, &b, &extra) != 2 || a == 0) {
+      return lineDamaged;
+    }
+    memset(&d->table, 0, sizeof(d->table));
+    d->table.magic = BOOTPROF_MAGIC;
+    d->table.boot = a;
+    d->table.count = b;
+    d->lines = 0;
+    d->open = true;
+    return result;
+  }
+  if (!d->open) {
+    return lineIgnored;
+  }
+  if (strncmp(line, "end", 3) == 0) {
+    d->open = false;
+    return (d->lines == BOOTPROF_Stored(&d->table)) ? lineComplete
+           : lineDamaged;
+  }
+  if (sscanf(line, "%lu %lx %lu %c", &a, &b, &c, &extra) != 3
+      || d->lines >= BOOTPROF_Stored(&d->table) || c == 0) {
+    d->open = false;
+    return lineDamaged;
+  }
+  d->table.marks[d->lines].point = a;
+  d->table.marks[d->lines].cycles = b;
+  d->table.marks[d->lines].hz = c;
+  d->lines++;
+  return lineTaken;
+}
+
+static const char *pointName(uint32_t point)
+{
+  static char unknown[24];
+
+  if (point < BOOT_POINT_COUNT) {
+    return pointNames[point];
+  }
+  snprintf(unknown, sizeof(unknown), "checkpoint %lu", (unsigned long)point);
+  return unknown;
+}
+
+/*
+ * Time of the step ending at mark i. The cycles are counted at the clock of
+ * the mark before; when the clock changed during the step it is only known
+ * to lie between the times at the old and the new frequency.
+ */
+static double stepUs(const BOOTPROF_Table_TypeDef *t, uint32_t i,
+                     double *low, double *high)
+{
+  const BOOTPROF_Mark_TypeDef *from = &t->marks[i - 1];
+  const BOOTPROF_Mark_TypeDef *to = &t->marks[i];
+  double cycles = (double)(uint32_t)(to->cycles - from->cycles);
+  double atFrom = cycles * 1e6 / from->hz;
+  double atTo = cycles * 1e6 / to->hz;
+
+  *low = (atFrom < atTo) ? atFrom : atTo;
+  *high = (atFrom < atTo) ? atTo : atFrom;
+  return atFrom;
+}
+
+static void report(FILE *out, const BOOTPROF_Table_TypeDef *t)
+{
+  uint32_t stored = BOOTPROF_Stored(t);
+  double at = 0, step, low, high;
+  uint32_t i;
+
+  fprintf(out, "Boot %lu since power-on, %lu checkpoints\n",
+          (unsigned long)t->boot, (unsigned long)t->count);
+  fprintf(out, "  %-32s %10s %10s\n", "checkpoint", "at (us)", "step (us)");
+  for (i = 0; i < stored; i++) {
+    if (i == 0) {
+      fprintf(out, "  %-32s %10.2f %10s  %.1f MHz\n",
+              pointName(t->marks[0].point), 0.0, "",
+              t->marks[0].hz / 1e6);
+      continue;
+    }
+    step = stepUs(t, i, &low, &high);
+    at += step;
+    fprintf(out, "  %-32s %10.2f %10.2f", pointName(t->marks[i].point),
+            at, step);
+    if (t->marks[i].hz != t->marks[i - 1].hz) {
+      fprintf(out, "  clock %.1f -> %.1f MHz, step %.2f..%.2f",
+              t->marks[i - 1].hz / 1e6, t->marks[i].hz / 1e6, low, high);
+    }
+    fprintf(out, "\n");
+  }
+  if (t->count > stored) {
+    fprintf(out, "  %lu later checkpoints dropped, BOOTPROF_MAX_MARKS is %d\n",
+            (unsigned long)(t->count - stored), BOOTPROF_MAX_MARKS);
+  }
+  fprintf(out, "\n");
+}
+
+static int decodeFile(FILE *in)
+{
+  Decoder_TypeDef d = { 0 };
+  char line[256];
+  unsigned int lineNumber = 0;
+  int profiles = 0;
+
+  while (fgets(line, sizeof(line), in) != NULL) {
+    lineNumber++;
+    line[strcspn(line, "\r\n")] = '\0';
+    switch (decodeLine(&d, line)) {
+      case lineComplete:
+        report(stdout, &d.table);
+        profiles++;
+        break;
+      case lineDamaged:
+        fprintf(stderr, "line %u: damaged profile skipped\n", lineNumber);
+        break;
+      default:
+        break;
+    }
+  }
+  if (profiles == 0) {
+    fprintf(stderr, "no boot profile found\n");
+    return 1;
+  }
+  return 0;
+}
+
+/*******************************************************************************
+ * Self-test
+ ******************************************************************************/
+
+static uint32_t hostCycles;
+
+uint32_t BOOTPROF_HostCycles(void)
+{
+  return hostCycles;
+}
+
+// Text printed by BOOTPROF_Dump()
+static char capture[4096];
+static size_t captureLength;
+
+static void captureLine(const char *line)
+{
+  captureLength += snprintf(capture + captureLength,
+                            sizeof(capture) - captureLength, "%s\n", line);
+}
+
+static int failures;
+
+static void check(bool ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Decode the captured text, expecting exactly one complete profile
+static bool decodeCapture(BOOTPROF_Table_TypeDef *table)
+{
+  Decoder_TypeDef d = { 0 };
+  char *line = strtok(capture, "\n");
+  int complete = 0, damaged = 0;
+
+  for (; line != NULL; line = strtok(NULL, "\n")) {
+    switch (decodeLine(&d, line)) {
+      case lineComplete:
+        *table = d.table;
+        complete++;
+        break;
+      case lineDamaged:
+        damaged++;
+        break;
+      default:
+        break;
+    }
+  }
+  return (complete == 1) && (damaged == 0);
+}
+
+static bool sameTable(const BOOTPROF_Table_TypeDef *a,
+                      const BOOTPROF_Table_TypeDef *b)
+{
+  return (a->boot == b->boot) && (a->count == b->count)
+         && memcmp(a->marks, b->marks,
+                   BOOTPROF_Stored(a) * sizeof(a->marks[0])) == 0;
+}
+
+static bool near(double a, double b)
+{
+  return (a - b < 0.01) && (b - a < 0.01);
+}
+
+static int selfTest(void)
+{
+  BOOTPROF_Table_TypeDef decoded, first;
+  double low, high;
+  uint32_t i;
+
+  // Power-on: RAM holds anything
+  memset(&BOOTPROF_Store, 0xA5, sizeof(BOOTPROF_Store));
+  BOOTPROF_Mark(BOOT_MAIN, 1);
+  check(!BOOTPROF_Valid(&BOOTPROF_Store.current), "mark before start ignored");
+
+  hostCycles = 0;
+  BOOTPROF_Start(BOOT_SYSTEMINIT, 19000000);
+  check(!BOOTPROF_Valid(&BOOTPROF_Store.previous), "no previous after power-on");
+  check(BOOTPROF_Store.current.boot == 1, "first boot numbered 1");
+
+  hostCycles += 38;       // 2 us at 19 MHz
+  BOOTPROF_Mark(BOOT_SYSTEMINIT_END, 19000000);
+  hostCycles += 1900;     // 100 us
+  BOOTPROF_Mark(BOOT_MAIN, 19000000);
+  hostCycles += 19000;    // HFXO start, clock switched part way
+  BOOTPROF_Mark(BOOT_HFXO, 39000000);
+  hostCycles += 3900;     // 100 us at 39 MHz
+  BOOTPROF_Mark(BOOT_SERIAL, 39000000);
+  check(BOOTPROF_Store.current.count == 5, "five marks counted");
+
+  captureLength = 0;
+  check(BOOTPROF_Dump(&BOOTPROF_Store.current, captureLine), "dump valid");
+  check(decodeCapture(&decoded), "dump decodes");
+  check(sameTable(&decoded, &BOOTPROF_Store.current), "decoded table equal");
+  check(near(stepUs(&decoded, 1, &low, &high), 2.0), "SystemInit step");
+  check(near(stepUs(&decoded, 2, &low, &high), 100.0), "C runtime step");
+  stepUs(&decoded, 3, &low, &high);
+  check(near(low, 19000 / 39.0) && near(high, 1000.0), "clock change range");
+  check(near(stepUs(&decoded, 4, &low, &high), 100.0), "step at new clock");
+
+  // Warm reset: the profile becomes the previous one
+  first = BOOTPROF_Store.current;
+  hostCycles = 12345;
+  BOOTPROF_Start(BOOT_SYSTEMINIT, 19000000);
+  check(BOOTPROF_Valid(&BOOTPROF_Store.previous), "previous kept");
+  check(sameTable(&BOOTPROF_Store.previous, &first), "previous unchanged");
+  check(BOOTPROF_Store.current.boot == 2, "second boot numbered 2");
+  check(BOOTPROF_Store.current.marks[0].cycles == 12345, "first mark taken");
+
+  // More marks than the table holds, with the counter wrapping
+  hostCycles = 0xFFFFFF00;
+  BOOTPROF_Start(BOOT_SYSTEMINIT, 1000000);
+  for (i = 1; i < BOOTPROF_MAX_MARKS + 6; i++) {
+    hostCycles += 100;
+    BOOTPROF_Mark(BOOT_READY, 1000000);
+  }
+  check(BOOTPROF_Store.current.count == BOOTPROF_MAX_MARKS + 6, "all counted");
+  check(BOOTPROF_Stored(&BOOTPROF_Store.current) == BOOTPROF_MAX_MARKS,
+        "stored limited");
+  captureLength = 0;
+  BOOTPROF_Dump(&BOOTPROF_Store.current, captureLine);
+  check(decodeCapture(&decoded), "full table decodes");
+  check(sameTable(&decoded, &BOOTPROF_Store.current), "full table equal");
+  check(near(stepUs(&decoded, 3, &low, &high), 100.0), "step across wrap");
+
+  // Terminal prefixes before the header are skipped
+  captureLength = 0;
+  captureLine("[10:42:07.113] bootprof 7 1");
+  captureLine("0 00000000 19000000");
+  captureLine("end");
+  check(decodeCapture(&decoded) && decoded.boot == 7, "prefixed header");
+
+  // A lost mark line, a lost "end" and a damaged line are refused
+  captureLength = 0;
+  captureLine("bootprof 1 2");
+  captureLine("0 00000000 19000000");
+  captureLine("end");
+  check(!decodeCapture(&decoded), "lost mark line");
+
+  captureLength = 0;
+  captureLine("bootprof 1 1");
+  captureLine("0 00000000 19000000");
+  captureLine("bootprof 2 1");
+  captureLine("0 00000000 19000000");
+  captureLine("end");
+  check(!decodeCapture(&decoded), "lost end line");
+
+  captureLength = 0;
+  captureLine("bootprof 1 1");
+  captureLine("0 0000z000 19000000");
+  captureLine("end");
+  check(!decodeCapture(&decoded), "damaged mark line");
+
+  // Example report
+  first.boot = 1;
+  report(stdout, &first);
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *in = stdin;
+  int result;
+
+  if (argc > 1 && strcmp(argv[1], "-t") == 0) {
+    return selfTest();
+  }
+  if (argc > 1) {
+    in = fopen(argv[1], "r");
+    if (in == NULL) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  result = decodeFile(in);
+  if (in != stdin) {
+    fclose(in);
+  }
+  return result;
+}
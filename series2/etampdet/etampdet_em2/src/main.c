@@ -1,6 +1,7 @@
 /***************************************************************************//**
- * @file main_xg25.c
- * @brief This project demonstrates the tamper detection module for EFR32xG25.
+ * @file main.c
+ * @brief This project demonstrates the tamper detection module for EFR32xG25
+ * and EFR32xG27.
  * The example uses #defines to enable the ETAMPDET peripheral's channel 0
  * and/or channel 1, and requires an external jumper-wire connection between the
  * ETAMPIN0 <-> ETAMPOUT0 and/or ETAMPIN1 <-> ETAMPOUT1 pins, as specified
@@ -54,6 +55,7 @@
 #include "em_rmu.h"
 #include "bsp.h"
 #include "mx25flash_spi.h"
+#include "etampdet_em2_pins.h"
 
 #define POWER_DOWN_RAM  (1)
 
@@ -70,6 +72,22 @@
 #define ETAMP_CH0_EN 1
 #define ETAMP_CH1_EN 1
 
+// ETAMPDET pins of the device, from etampdet_em2_pins.h
+#define ETAMPIN0     BSP_COLUMN(0, BSP_BOARD(ETAMP_BOARD_))
+#define ETAMPOUT0    BSP_COLUMN(1, BSP_BOARD(ETAMP_BOARD_))
+#define ETAMPIN1     BSP_COLUMN(2, BSP_BOARD(ETAMP_BOARD_))
+#define ETAMPOUT1    BSP_COLUMN(3, BSP_BOARD(ETAMP_BOARD_))
+
+/*
+ * Waits for the ETAMPDET to disable; other register writes fault until it
+ * has.  xG27 reports the disable in SYNCBUSY, xG25 in the EN register.
+ */
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_7)
+#define ETAMPDET_WAIT_DISABLED()  while (ETAMPDET->SYNCBUSY != 0)
+#else
+#define ETAMPDET_WAIT_DISABLED()  while (ETAMPDET->EN != 0)
+#endif
+
 // Number of 32.768 KHz LFRCO clocks between BURTC interrupts
 #define BURTC_IRQ_PERIOD  16384 // 500 ms toggle rate
 
@@ -107,9 +125,6 @@ void powerDownSpiFlash(void)
  *****************************************************************************/
 void initGPIO(void)
 {
-  // Enable GPIO clock branch
-  CMU_ClockEnable(cmuClock_GPIO, true);
-
   // Configure LEDs as outputs; will toggle for tamper detection
   GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, !LED_OUT);
   GPIO_PinModeSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN, gpioModePushPull, !LED_OUT);
@@ -175,16 +190,19 @@ void initETAMPDET()
   // Enable register clock; ETAMPDET clock not currently defined in em_cmu.h
   CMU->CLKEN1_SET = CMU_CLKEN1_ETAMPDET;
 
+  // Enable GPIO clock branch
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
   if (chnl0_en == 1) { // Configure GPIO for ETAMPDET channel 0
     // Disable GPIO signals associated with used ETAMPER channel 0
-    GPIO_PinModeSet(gpioPortA, 5, gpioModeDisabled, 0);
-    GPIO_PinModeSet(gpioPortA, 6, gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPIN0), BSP_PIN(ETAMPIN0), gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPOUT0), BSP_PIN(ETAMPOUT0), gpioModeDisabled, 0);
   }
 
   if (chnl1_en == 1) { // Configure GPIO for ETAMPDET channel 1
     // Disable GPIO signals associated with used ETAMPER channel 1
-    GPIO_PinModeSet(gpioPortD, 5, gpioModeDisabled, 0);
-    GPIO_PinModeSet(gpioPortD, 4, gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPIN1), BSP_PIN(ETAMPIN1), gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPOUT1), BSP_PIN(ETAMPOUT1), gpioModeDisabled, 0);
   }
 
   // Make sure module is disabled before configuring
@@ -195,7 +213,7 @@ void initETAMPDET()
    *  register write is attempted before peripheral is disabled, hard fault will
    *  occur.
    */
-  while(ETAMPDET->EN && ETAMPDET_EN_DISABLING);
+  ETAMPDET_WAIT_DISABLED();
 
   // Configure upper and lower prescaler values
   ETAMPDET->CLKPRESCVAL = ETAMPDET_CLKPRESCVAL_LOWERPRESC_DivideBy64 |
@@ -268,7 +286,7 @@ void ETAMPDET_IRQHandler(void)
    *  further register writes to ETAMPDET peripheral cannot occur until disable
    *  completes; BURTC interrupt is the only task at risk of a delay.
    */
-  while(ETAMPDET->EN && ETAMPDET_EN_DISABLING);
+  ETAMPDET_WAIT_DISABLED();
 
   ETAMPDET->IEN_CLR = _ETAMPDET_IEN_MASK;
 
@@ -277,6 +295,12 @@ void ETAMPDET_IRQHandler(void)
   // Turn on BURTC interrupts for LED toggle; BURTC already running
   BURTC_IntEnable(BURTC_IEN_COMP);    // BURTC interrupt on compare match
   NVIC_EnableIRQ(BURTC_IRQn);
+
+  /*
+   *  Initialize GPIO for LEDs only now; on xG27, LED1 is on the ETAMPIN0
+   *  pin, which the ETAMPDET owns until it is disabled
+   */
+  initGPIO();
 }
 
 /**************************************************************************//**
@@ -320,9 +344,6 @@ int main(void)
    */
   escapeHatch();
 
-  // Initialize GPIO for LEDs
-  initGPIO();
-
   // Turn on DCDC regulator
   EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_WSTK_DEFAULT;
   EMU_DCDCInit(&dcdcInit);
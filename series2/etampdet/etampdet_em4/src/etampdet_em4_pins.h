@@ -0,0 +1,88 @@
+/***************************************************************************//**
+ * @file etampdet_em4_pins.h
+ * @brief ETAMPDET pins of each device supported by the example.  The table
+ * has no device dependencies, so tools/pins_check.c checks it on a PC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef ETAMPDET_EM4_PINS_H
+#define ETAMPDET_EM4_PINS_H
+
+#include "bsp_route.h"
+
+/*
+ * The ETAMPDET pins are fixed by the device; the example disables their
+ * GPIO function for the channels in use.  Each ETAMPOUT pin is wired to
+ * the ETAMPIN pin of its channel.
+ *
+ *                         IN0     OUT0    IN1     OUT1
+ */
+#define ETAMP_BOARD_XG25  ((A, 5), (A, 6), (D, 5), (D, 4))
+#define ETAMP_BOARD_XG27  ((B, 1), (C, 1), (C, 0), (C, 2))
+
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG)              \
+  && _SILICON_LABS_32B_SERIES_2_CONFIG != 5                 \
+  && _SILICON_LABS_32B_SERIES_2_CONFIG != 7
+#error "No pins for this device in etampdet_em4_pins.h"
+#endif
+
+// Checks of a row: real, distinct pins
+#define ETAMP_PIN(n, dev)           BSP_COLUMN(n, ETAMP_BOARD_##dev)
+#define ETAMP_BOARD_CHECK(dev)                                                \
+  BSP_CHECK(etamp_##dev##_pins_valid,                                         \
+            BSP_PIN_VALID(ETAMP_PIN(0, dev))                                  \
+            && BSP_PIN_VALID(ETAMP_PIN(1, dev))                               \
+            && BSP_PIN_VALID(ETAMP_PIN(2, dev))                               \
+            && BSP_PIN_VALID(ETAMP_PIN(3, dev)));                             \
+  BSP_CHECK(etamp_##dev##_pins_differ,                                        \
+            BSP_PIN_DIFFERENT(ETAMP_PIN(0, dev), ETAMP_PIN(1, dev))           \
+            && BSP_PIN_DIFFERENT(ETAMP_PIN(0, dev), ETAMP_PIN(2, dev))        \
+            && BSP_PIN_DIFFERENT(ETAMP_PIN(0, dev), ETAMP_PIN(3, dev))        \
+            && BSP_PIN_DIFFERENT(ETAMP_PIN(1, dev), ETAMP_PIN(2, dev))        \
+            && BSP_PIN_DIFFERENT(ETAMP_PIN(1, dev), ETAMP_PIN(3, dev))        \
+            && BSP_PIN_DIFFERENT(ETAMP_PIN(2, dev), ETAMP_PIN(3, dev)))
+
+// Every row is checked in every build, whichever device it is for
+ETAMP_BOARD_CHECK(XG25);
+ETAMP_BOARD_CHECK(XG27);
+
+// On the device, the row must also match the pins its header defines
+#if defined(ETAMPDET_ETAMPIN0_PORT)
+#define ETAMP_PIN_OF_DEVICE(n)      BSP_COLUMN(n, BSP_BOARD(ETAMP_BOARD_))
+BSP_CHECK(etamp_pins_fixed,
+          BSP_PIN_IS(ETAMP_PIN_OF_DEVICE(0), ETAMPDET_ETAMPIN0)
+          && BSP_PIN_IS(ETAMP_PIN_OF_DEVICE(1), ETAMPDET_ETAMPOUT0)
+          && BSP_PIN_IS(ETAMP_PIN_OF_DEVICE(2), ETAMPDET_ETAMPIN1)
+          && BSP_PIN_IS(ETAMP_PIN_OF_DEVICE(3), ETAMPDET_ETAMPOUT1));
+#endif
+
+#endif // ETAMPDET_EM4_PINS_H
@@ -1,6 +1,7 @@
 /***************************************************************************//**
  * @file main.c
- * @brief This project demonstrates the tamper detection module for EFR32xG27.
+ * @brief This project demonstrates the tamper detection module for EFR32xG25
+ * and EFR32xG27.
  * The example uses #defines to enable the ETAMPDET peripheral's channel 0
  * and/or channel 1, and requires an external jumper-wire connection between the
  * ETAMPIN0 <-> ETAMPOUT0 and/or ETAMPIN1 <-> ETAMPOUT1 pins, as specified
@@ -54,6 +55,7 @@
 #include "em_rmu.h"
 #include "bsp.h"
 #include "mx25flash_spi.h"
+#include "etampdet_em4_pins.h"
 
 volatile uint32_t msTicks; // counts 1ms timeTicks
 
@@ -76,6 +78,22 @@ volatile uint32_t msTicks; // counts 1ms timeTicks
 #define ETAMP_CH0_EN 1
 #define ETAMP_CH1_EN 1
 
+// ETAMPDET pins of the device, from etampdet_em4_pins.h
+#define ETAMPIN0     BSP_COLUMN(0, BSP_BOARD(ETAMP_BOARD_))
+#define ETAMPOUT0    BSP_COLUMN(1, BSP_BOARD(ETAMP_BOARD_))
+#define ETAMPIN1     BSP_COLUMN(2, BSP_BOARD(ETAMP_BOARD_))
+#define ETAMPOUT1    BSP_COLUMN(3, BSP_BOARD(ETAMP_BOARD_))
+
+/*
+ * Waits for the ETAMPDET to disable; other register writes fault until it
+ * has.  xG27 reports the disable in SYNCBUSY, xG25 in the EN register.
+ */
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_7)
+#define ETAMPDET_WAIT_DISABLED()  while (ETAMPDET->SYNCBUSY != 0)
+#else
+#define ETAMPDET_WAIT_DISABLED()  while (ETAMPDET->EN != 0)
+#endif
+
 /**************************************************************************//**
  * @brief SysTick_Handler
  * Interrupt Service Routine for system tick counter
@@ -174,14 +192,14 @@ void initETAMPDET(void)
 
   if (chnl0_en == 1) { // Configure GPIO for ETAMPDET channel 0
     // Disable GPIO signals associated with used ETAMPER channel 0
-    GPIO_PinModeSet(gpioPortB, 1, gpioModeDisabled, 0);
-    GPIO_PinModeSet(gpioPortC, 1, gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPIN0), BSP_PIN(ETAMPIN0), gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPOUT0), BSP_PIN(ETAMPOUT0), gpioModeDisabled, 0);
   }
 
   if (chnl1_en == 1) { // Configure GPIO for ETAMPDET channel 1
     // Disable GPIO signals associated with used ETAMPER channel 1
-    GPIO_PinModeSet(gpioPortC, 0, gpioModeDisabled, 0);
-    GPIO_PinModeSet(gpioPortC, 2, gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPIN1), BSP_PIN(ETAMPIN1), gpioModeDisabled, 0);
+    GPIO_PinModeSet(BSP_PORT(ETAMPOUT1), BSP_PIN(ETAMPOUT1), gpioModeDisabled, 0);
   }
 
   // Make sure module is disabled before configuring
@@ -192,7 +210,7 @@ void initETAMPDET(void)
    *  register write is attempted before peripheral is disabled, hard fault will
    *  occur.
    */
-  while (ETAMPDET->SYNCBUSY != 0);
+  ETAMPDET_WAIT_DISABLED();
 
   // Configure upper and lower prescaler values
   ETAMPDET->CLKPRESCVAL = ETAMPDET_CLKPRESCVAL_LOWERPRESC_DivideBy64 |
@@ -341,7 +359,10 @@ int main(void)
   escapeHatch();
 
   if ((cause & EMU_RSTCAUSE_EM4)) {
-    // Initialize GPIO for LEDs
+    /*
+     *  Initialize GPIO for LEDs only after a tamper wake-up; on xG27, LED1
+     *  is on the ETAMPIN0 pin, which the ETAMPDET owns while it runs
+     */
     initGPIO();
 
     // Setup SysTick Timer for 1 msec interrupts
@@ -364,7 +385,7 @@ int main(void)
      *  Register writes to ETAMPDET peripheral cannot occur until disable
      *  completes
      */
-    while (ETAMPDET->SYNCBUSY != 0);
+    ETAMPDET_WAIT_DISABLED();
 
     ETAMPDET->IEN_CLR = _ETAMPDET_IEN_MASK;
 
@@ -0,0 +1,111 @@
+/***************************************************************************//**
+ * @file pins_check.c
+ * @brief Host check of the pin table of every device.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -Wall -I../src -I../../../kit/common/bsp -o pins_check \
+ *       pins_check.c
+ *   ./pins_check
+ *
+ * Including the table checks every row at compile time: a pin that does not
+ * exist or is used twice fails the build.  The program then prints each row
+ * and compares it with the ETAMPDET pins of the device datasheets, written
+ * below the way the device headers define them.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "etampdet_em4_pins.h"
+
+// Fixed ETAMPDET pins, as ETAMPDET_<signal>_PORT/_PIN in the device headers
+#define XG25_ETAMPIN0_PORT    0
+#define XG25_ETAMPIN0_PIN     5
+#define XG25_ETAMPOUT0_PORT   0
+#define XG25_ETAMPOUT0_PIN    6
+#define XG25_ETAMPIN1_PORT    3
+#define XG25_ETAMPIN1_PIN     5
+#define XG25_ETAMPOUT1_PORT   3
+#define XG25_ETAMPOUT1_PIN    4
+
+#define XG27_ETAMPIN0_PORT    1
+#define XG27_ETAMPIN0_PIN     1
+#define XG27_ETAMPOUT0_PORT   2
+#define XG27_ETAMPOUT0_PIN    1
+#define XG27_ETAMPIN1_PORT    2
+#define XG27_ETAMPIN1_PIN     0
+#define XG27_ETAMPOUT1_PORT   2
+#define XG27_ETAMPOUT1_PIN    2
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void printPin(int port, int pin)
+{
+  printf("  P%c%02d", 'A' + port, pin);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Print a row and check each pin against the device's fixed pin.
+ ******************************************************************************/
+#define CHECK_PIN(n, dev, sig)                                                \
+  do {                                                                        \
+    printPin(BSP_PORTNUM(ETAMP_PIN(n, dev)), BSP_PIN(ETAMP_PIN(n, dev)));     \
+    check(BSP_PIN_IS(ETAMP_PIN(n, dev), dev##_##sig), #dev " " #sig);         \
+  } while (0)
+
+#define CHECK_BOARD(dev)                                                      \
+  do {                                                                        \
+    printf("%s", #dev);                                                       \
+    CHECK_PIN(0, dev, ETAMPIN0);                                              \
+    CHECK_PIN(1, dev, ETAMPOUT0);                                             \
+    CHECK_PIN(2, dev, ETAMPIN1);                                              \
+    CHECK_PIN(3, dev, ETAMPOUT1);                                             \
+    printf("\n");                                                             \
+  } while (0)
+
+int main(void)
+{
+  printf("board IN0   OUT0  IN1   OUT1\n");
+  CHECK_BOARD(XG25);
+  CHECK_BOARD(XG27);
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Traces a sampling data path with the binary event trace: TIMER0
+ * starts an IADC conversion 100 times a second, and the LDMA drains the
+ * records to the VCOM through EUSART0.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_eusart.h"
+#include "em_gpio.h"
+#include "em_iadc.h"
+#include "em_ldma.h"
+#include "em_timer.h"
+
+// BSP for board controller pin macros
+#include "bsp.h"
+
+#include "trace.h"
+#include "traceids.h"
+
+// Sampling rate
+#define SAMPLE_HZ           100
+
+// Drain the trace every 10 samples, 10 times a second
+#define DRAIN_PERIODS       10
+
+// LDMA channel for the trace drain
+#define TRACE_LDMA_CHANNEL  0
+
+// Set CLK_ADC to 10 MHz
+#define CLK_SRC_ADC_FREQ    20000000
+#define CLK_ADC_FREQ        10000000
+
+// TIMER0 periods since the start
+static volatile uint32_t period;
+
+/**************************************************************************//**
+ * @brief
+ *   Route EUSART0 to the board controller, as in async_dma_em2, and enable
+ *   the VCOM.
+ *****************************************************************************/
+void initGPIO(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  GPIO_PinModeSet(BSP_BCC_TXPORT, BSP_BCC_TXPIN, gpioModePushPull, 1);
+  GPIO_PinModeSet(BSP_BCC_RXPORT, BSP_BCC_RXPIN, gpioModeInput, 0);
+
+  GPIO->EUSARTROUTE[0].TXROUTE = (BSP_BCC_TXPORT << _GPIO_EUSART_TXROUTE_PORT_SHIFT)
+      | (BSP_BCC_TXPIN << _GPIO_EUSART_TXROUTE_PIN_SHIFT);
+  GPIO->EUSARTROUTE[0].RXROUTE = (BSP_BCC_RXPORT << _GPIO_EUSART_RXROUTE_PORT_SHIFT)
+      | (BSP_BCC_RXPIN << _GPIO_EUSART_RXROUTE_PIN_SHIFT);
+  GPIO->EUSARTROUTE[0].ROUTEEN = GPIO_EUSART_ROUTEEN_RXPEN |
+                                 GPIO_EUSART_ROUTEEN_TXPEN;
+
+  GPIO_PinModeSet(BSP_BCC_ENABLE_PORT, BSP_BCC_ENABLE_PIN, gpioModePushPull, 1);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   EUSART0 at 115200 baud.  The transmit complete interrupt marks the end
+ *   of each drain block on the wire.
+ *****************************************************************************/
+void initEUSART0(void)
+{
+  EUSART_UartInit_TypeDef init = EUSART_UART_INIT_DEFAULT_HF;
+
+  CMU_ClockEnable(cmuClock_EUSART0, true);
+  EUSART_UartInitHf(EUSART0, &init);
+
+  EUSART_IntClear(EUSART0, EUSART_IF_TXC);
+  EUSART_IntEnable(EUSART0, EUSART_IEN_TXC);
+  NVIC_ClearPendingIRQ(EUSART0_TX_IRQn);
+  NVIC_EnableIRQ(EUSART0_TX_IRQn);
+}
+
+void initLDMA(void)
+{
+  LDMA_Init_t init = LDMA_INIT_DEFAULT;
+
+  LDMA_Init(&init);
+  TRACE_DrainInit(TRACE_LDMA_CHANNEL, ldmaPeripheralSignal_EUSART0_TXFL,
+                  &EUSART0->TXDATA);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Single conversions of the supply, AVDD / 4, so that no pin is needed.
+ *****************************************************************************/
+void initIADC(void)
+{
+  IADC_Init_t init = IADC_INIT_DEFAULT;
+  IADC_AllConfigs_t initAllConfigs = IADC_ALLCONFIGS_DEFAULT;
+  IADC_InitSingle_t initSingle = IADC_INITSINGLE_DEFAULT;
+  IADC_SingleInput_t singleInput = IADC_SINGLEINPUT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_IADC0, true);
+  CMU_ClockSelectSet(cmuClock_IADCCLK, cmuSelect_FSRCO);
+
+  init.srcClkPrescale = IADC_calcSrcClkPrescale(IADC0, CLK_SRC_ADC_FREQ, 0);
+  initAllConfigs.configs[0].reference = iadcCfgReferenceInt1V2;
+  initAllConfigs.configs[0].vRef = 1210;
+  initAllConfigs.configs[0].adcClkPrescale = IADC_calcAdcClkPrescale(IADC0,
+                                                                     CLK_ADC_FREQ,
+                                                                     0,
+                                                                     iadcCfgModeNormal,
+                                                                     init.srcClkPrescale);
+
+  singleInput.posInput = iadcPosInputAvdd;
+  singleInput.negInput = iadcNegInputGnd;
+
+  IADC_init(IADC0, &init, &initAllConfigs);
+  IADC_initSingle(IADC0, &initSingle, &singleInput);
+
+  IADC_clearInt(IADC0, _IADC_IF_MASK);
+  IADC_enableInt(IADC0, IADC_IEN_SINGLEDONE);
+  NVIC_ClearPendingIRQ(IADC_IRQn);
+  NVIC_EnableIRQ(IADC_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   TIMER0 overflows SAMPLE_HZ times a second.  It counts core clock
+ *   cycles, so its count on entry to the handler is the interrupt latency.
+ *****************************************************************************/
+void initTIMER0(void)
+{
+  TIMER_Init_TypeDef init = TIMER_INIT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+  init.enable = false;
+  TIMER_Init(TIMER0, &init);
+  TIMER_TopSet(TIMER0, CMU_ClockFreqGet(cmuClock_TIMER0) / SAMPLE_HZ - 1);
+
+  TIMER_IntClear(TIMER0, _TIMER_IF_MASK);
+  TIMER_IntEnable(TIMER0, TIMER_IEN_OF);
+  NVIC_ClearPendingIRQ(TIMER0_IRQn);
+  NVIC_EnableIRQ(TIMER0_IRQn);
+  TIMER_Enable(TIMER0, true);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start a conversion each period.
+ *****************************************************************************/
+void TIMER0_IRQHandler(void)
+{
+  uint32_t count = TIMER0->CNT;
+
+  TIMER_IntClear(TIMER0, TIMER_IF_OF);
+  period++;
+  IADC_command(IADC0, iadcCmdStartSingle);
+  TRACE(TRACE_ID_TIMER, count, period);
+}
+
+void IADC_IRQHandler(void)
+{
+  IADC_Result_t sample = IADC_pullSingleFifoResult(IADC0);
+
+  IADC_clearInt(IADC0, IADC_IF_SINGLEDONE);
+  TRACE(TRACE_ID_IADC, sample.data, period);
+}
+
+void LDMA_IRQHandler(void)
+{
+  uint32_t flags = LDMA_IntGet();
+
+  // Stop in case there was an error
+  if (flags & LDMA_IF_ERROR) {
+    __BKPT(0);
+  }
+  TRACE_DrainIrq(flags);
+}
+
+void EUSART0_TX_IRQHandler(void)
+{
+  uint32_t flags = EUSART_IntGet(EUSART0);
+
+  EUSART_IntClear(EUSART0, EUSART_IF_TXC);
+  TRACE(TRACE_ID_EUSART, flags, 0);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  uint32_t drained = 0;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  TRACE_Init();
+
+  initGPIO();
+  initEUSART0();
+  initLDMA();
+  initIADC();
+  initTIMER0();
+
+  while (1) {
+    EMU_EnterEM1();
+    if (period - drained >= DRAIN_PERIODS) {
+      drained = period;
+      TRACE_DrainPoll();
+    }
+  }
+}
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ * @file trace.c
+ * @brief Binary event trace.  Writers reserve a record with an exclusive
+ * load and store on the ring head, fill it, and commit it by writing its
+ * sequence number last.  A single reader takes committed records in order.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include "trace.h"
+#include "traceids.h"
+
+#if !defined(TRACE_HOST)
+#include "em_device.h"
+#include "em_core.h"
+
+#define CYCLES()        (DWT->CYCCNT)
+#define COMMIT()        __DMB()
+#else
+#define CYCLES()        TRACE_HostCycles()
+#define COMMIT()        __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+#define MASK            (TRACE_RECORDS - 1)
+
+#if (TRACE_RECORDS & MASK) != 0
+#error "TRACE_RECORDS must be a power of 2"
+#endif
+
+static TRACE_Record_TypeDef ring[TRACE_RECORDS];
+static volatile uint32_t head;      // Next record number to reserve
+static volatile uint32_t tail;      // Oldest record not yet released
+static volatile uint32_t dropped;
+
+/**************************************************************************//**
+ * @brief
+ *   Take the next record number unless the ring is full.  An interrupt
+ *   between the load and the store makes the store fail, and the loop
+ *   tries again with the new head.
+ *****************************************************************************/
+static bool reserve(uint32_t *number)
+{
+  uint32_t h;
+
+#if !defined(TRACE_HOST)
+  do {
+    h = __LDREXW(&head);
+    if (h - tail >= TRACE_RECORDS) {
+      __CLREX();
+      return false;
+    }
+  } while (__STREXW(h + 1, &head) != 0);
+#else
+  h = __atomic_load_n(&head, __ATOMIC_RELAXED);
+  do {
+    if (h - tail >= TRACE_RECORDS) {
+      return false;
+    }
+  } while (!__atomic_compare_exchange_n(&head, &h, h + 1, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#endif
+  *number = h;
+  return true;
+}
+
+static void countDropped(void)
+{
+#if !defined(TRACE_HOST)
+  uint32_t d;
+
+  do {
+    d = __LDREXW(&dropped);
+  } while (__STREXW(d + 1, &dropped) != 0);
+#else
+  __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Empty the ring and, on the device, start the cycle counter.
+ *
+ * @details
+ *   Each record starts with a sequence number that does not match the
+ *   first record number to use it, so that it is not taken as committed.
+ *****************************************************************************/
+void TRACE_Init(void)
+{
+  uint32_t i;
+
+#if !defined(TRACE_HOST)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  for (i = 0; i < TRACE_RECORDS; i++) {
+    ring[i].seq = (uint16_t)(i + 1);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Record an event.  Safe from any interrupt priority and from thread
+ *   mode; when the ring is full the event is counted as dropped.
+ *
+ * @details
+ *   The time is read before the record is reserved.  A writer interrupted
+ *   between the two can therefore leave a record a little older than the
+ *   one before it; the decoder allows for this.
+ *****************************************************************************/
+void TRACE_Event(uint16_t id, uint32_t arg0, uint32_t arg1)
+{
+  uint32_t time = CYCLES();
+  uint32_t number;
+  TRACE_Record_TypeDef *r;
+
+  if (!reserve(&number)) {
+    countDropped();
+    return;
+  }
+  r = &ring[number & MASK];
+  r->time = time;
+  r->id = id;
+  r->arg0 = arg0;
+  r->arg1 = arg1;
+  COMMIT();
+  *(volatile uint16_t *)&r->seq = (uint16_t)number;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Committed records from the oldest on, up to the end of the ring.
+ *   Records reserved but not yet committed, and those after them, wait
+ *   for the next call.  Only one reader may use Peek and Release.
+ *
+ * @param[out] first
+ *   The oldest record.
+ *
+ * @param[in] max
+ *   Most records to return.
+ *
+ * @return
+ *   Number of records from *first that can be read.
+ *****************************************************************************/
+uint32_t TRACE_Peek(const TRACE_Record_TypeDef **first, uint32_t max)
+{
+  uint32_t t = tail;
+  uint32_t limit = head - t;
+  uint32_t i;
+
+  if (limit > TRACE_RECORDS - (t & MASK)) {
+    limit = TRACE_RECORDS - (t & MASK);
+  }
+  if (limit > max) {
+    limit = max;
+  }
+  for (i = 0; i < limit; i++) {
+    if (*(volatile uint16_t *)&ring[(t + i) & MASK].seq != (uint16_t)(t + i)) {
+      break;
+    }
+  }
+  *first = &ring[t & MASK];
+  return i;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Hand records returned by TRACE_Peek() back to the writers.
+ *****************************************************************************/
+void TRACE_Release(uint32_t count)
+{
+  tail += count;
+}
+
+uint32_t TRACE_Dropped(void)
+{
+  return dropped;
+}
+
+#if !defined(TRACE_HOST)
+/*******************************************************************************
+ * LDMA drain: a block is a header descriptor linked to a descriptor for
+ * the records, both to the transmit data register of a serial port.
+ ******************************************************************************/
+
+static unsigned int drainCh;
+static LDMA_TransferCfg_t drainCfg;
+static LDMA_Descriptor_t drainDesc[2];
+static TRACE_Header_TypeDef drainHeader;
+static volatile void *drainTx;
+static volatile uint32_t drainCount;  // Records of the block under way
+
+/**************************************************************************//**
+ * @brief
+ *   Set up the drain on an LDMA channel.  LDMA_Init() must have been
+ *   called, and the serial port set up.
+ *
+ * @param[in] ch
+ *   LDMA channel to use.
+ *
+ * @param[in] signal
+ *   Transmit request of the serial port, such as
+ *   ldmaPeripheralSignal_EUSART0_TXFL.
+ *
+ * @param[in] txData
+ *   Its transmit data register.
+ *****************************************************************************/
+void TRACE_DrainInit(unsigned int ch, LDMA_PeripheralSignal_t signal,
+                     volatile void *txData)
+{
+  drainCh = ch;
+  drainCfg = (LDMA_TransferCfg_t)LDMA_TRANSFER_CFG_PERIPHERAL(signal);
+  drainTx = txData;
+  drainCount = 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Send the committed records, if the drain is idle.  Call from thread
+ *   mode, for example after each wake-up.
+ *
+ * @details
+ *   The drain is not restarted when a block completes, since the block
+ *   itself adds records; those wait for the next call.
+ *****************************************************************************/
+void TRACE_DrainPoll(void)
+{
+  const TRACE_Record_TypeDef *first;
+  uint32_t count;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (drainCount == 0) {
+    count = TRACE_Peek(&first, TRACE_DRAIN_MAX);
+    if (count != 0) {
+      drainHeader.magic = TRACE_MAGIC;
+      drainHeader.count = (uint16_t)count;
+      drainHeader.dropped = dropped;
+      drainDesc[0] = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(&drainHeader, drainTx,
+                                         sizeof(drainHeader), 1);
+      drainDesc[1] = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(first, drainTx,
+                                        count * sizeof(TRACE_Record_TypeDef));
+      drainCount = count;
+      TRACE(TRACE_ID_DRAIN, count,
+            sizeof(drainHeader) + count * sizeof(TRACE_Record_TypeDef));
+      LDMA_StartTransfer(drainCh, &drainCfg, drainDesc);
+    }
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Call from LDMA_IRQHandler() with the pending flags.  Releases the
+ *   records of a completed block.
+ *
+ * @return
+ *   true if the drain channel's flag was set, and has been cleared.
+ *****************************************************************************/
+bool TRACE_DrainIrq(uint32_t flags)
+{
+  uint32_t count;
+
+  if (!(flags & (1UL << drainCh))) {
+    return false;
+  }
+  LDMA_IntClear(1UL << drainCh);
+  count = drainCount;
+  TRACE_Release(count);
+  drainCount = 0;
+  TRACE(TRACE_ID_LDMA, flags, count);
+  return true;
+}
+#endif
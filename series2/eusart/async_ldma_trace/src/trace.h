@@ -0,0 +1,108 @@
+/***************************************************************************//**
+ * @file trace.h
+ * @brief Binary event trace: fixed-size records written from any interrupt
+ * handler into a RAM ring without locks, and drained by the LDMA to a
+ * serial port.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Records in the ring; a power of 2
+#ifndef TRACE_RECORDS
+#define TRACE_RECORDS       256
+#endif
+
+/// Most records sent in one drain block: 2048 bytes, one LDMA descriptor
+#define TRACE_DRAIN_MAX     128
+
+/// First bytes of each drain block on the wire: "TR"
+#define TRACE_MAGIC         0x5254
+
+/// Set to 0 to compile TRACE() calls out
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE        1
+#endif
+
+/// One event, 16 bytes
+typedef struct {
+  uint32_t time;        ///< Core clock cycles, DWT_CYCCNT
+  uint16_t id;          ///< Event, see traceids.h
+  uint16_t seq;         ///< Low bits of the record number, written last
+  uint32_t arg0;
+  uint32_t arg1;
+} TRACE_Record_TypeDef;
+
+/// Sent ahead of the records of each drain block, 8 bytes
+typedef struct {
+  uint16_t magic;       ///< TRACE_MAGIC
+  uint16_t count;       ///< Records that follow
+  uint32_t dropped;     ///< Records lost to a full ring since TRACE_Init()
+} TRACE_Header_TypeDef;
+
+#if TRACE_ENABLE
+#define TRACE(id, arg0, arg1)  TRACE_Event((id), (arg0), (arg1))
+#else
+#define TRACE(id, arg0, arg1)  ((void)0)
+#endif
+
+void TRACE_Init(void);
+void TRACE_Event(uint16_t id, uint32_t arg0, uint32_t arg1);
+uint32_t TRACE_Peek(const TRACE_Record_TypeDef **first, uint32_t max);
+void TRACE_Release(uint32_t count);
+uint32_t TRACE_Dropped(void);
+
+#if !defined(TRACE_HOST)
+#include "em_ldma.h"
+
+void TRACE_DrainInit(unsigned int ch, LDMA_PeripheralSignal_t signal,
+                     volatile void *txData);
+void TRACE_DrainPoll(void);
+bool TRACE_DrainIrq(uint32_t flags);
+#else
+// Provided by the host program in place of DWT_CYCCNT
+uint32_t TRACE_HostCycles(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_H
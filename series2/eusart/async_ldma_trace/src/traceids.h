@@ -0,0 +1,67 @@
+/***************************************************************************//**
+ * @file traceids.h
+ * @brief Trace event numbers and names, shared by the firmware and the
+ * host decoder.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef TRACEIDS_H
+#define TRACEIDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Each event names its two arguments.  Add new ones at the end so traces
+ * captured before still decode.
+ ******************************************************************************/
+#define TRACE_IDS(X)                                                    \
+  X(TRACE_ID_TIMER,       "TIMER0",       "count at entry", "period")   \
+  X(TRACE_ID_IADC,        "IADC",         "result",        "period")    \
+  X(TRACE_ID_DRAIN,       "drain start",  "records",       "bytes")     \
+  X(TRACE_ID_LDMA,        "LDMA",         "flags",         "records")   \
+  X(TRACE_ID_EUSART,      "EUSART0 TX",   "flags",         "")
+
+#define TRACE_IDS_ENUM(id, name, arg0, arg1)  id,
+
+/// Trace event numbers
+typedef enum {
+  TRACE_IDS(TRACE_IDS_ENUM)
+  TRACE_ID_COUNT
+} TraceId_TypeDef;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACEIDS_H
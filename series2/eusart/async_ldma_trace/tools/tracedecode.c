@@ -0,0 +1,698 @@
+/***************************************************************************//**
+ * @file tracedecode.c
+ * @brief Host decoder for the binary event trace: finds the drain blocks in
+ * a capture of the serial port, lists the records and gives the latency
+ * distributions of the traced handlers.
+ *
+ *   gcc -std=c99 -O2 -pthread -DTRACE_HOST -I../src -o tracedecode \
+ *       tracedecode.c ../src/trace.c
+ *   ./tracedecode [-l] [-f hz] capture.bin
+ *   ./tracedecode -t
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "trace.h"
+#include "traceids.h"
+
+#define TRACE_IDS_NAME(id, name, arg0, arg1)  { name, arg0, arg1 },
+
+static const struct {
+  const char *name;
+  const char *arg0;
+  const char *arg1;
+} idNames[TRACE_ID_COUNT] = {
+  TRACE_IDS(TRACE_IDS_NAME)
+};
+
+#define HEADER_SIZE   sizeof(TRACE_Header_TypeDef)
+#define RECORD_SIZE   sizeof(TRACE_Record_TypeDef)
+
+// Core clock of the example, HFRCODPLL after reset
+#define DEFAULT_HZ    19000000.0
+
+/*******************************************************************************
+ * Decoder
+ ******************************************************************************/
+
+typedef struct {
+  const char  *name;
+  double      *values;    // In us
+  size_t      count;
+  size_t      size;
+} Series_TypeDef;
+
+enum {
+  seriesTimerLatency,
+  seriesTimerInterval,
+  seriesIadc,
+  seriesDrain,
+  seriesTxTail,
+  seriesCount
+};
+
+typedef struct {
+  double          hz;
+  bool            list;
+  bool            started;
+  uint64_t        time;       // Unwrapped cycles of the last record
+  uint32_t        lastRaw;
+  bool            seqKnown;
+  uint16_t        nextSeq;
+  uint32_t        blocks;
+  uint32_t        records;
+  uint32_t        lost;       // Missing from the capture
+  uint32_t        dropped;    // Lost to a full ring, from the last header
+  uint32_t        damaged;    // Blocks refused
+  uint32_t        skipped;    // Bytes outside blocks
+  bool            haveTimer, haveDrain, haveLdma;
+  uint64_t        timerTime, drainTime, ldmaTime;
+  uint32_t        timerPeriod;
+  Series_TypeDef  series[seriesCount];
+} Decoder_TypeDef;
+
+static const char *const seriesNames[seriesCount] = {
+  "TIMER0 interrupt latency",
+  "TIMER0 period",
+  "IADC start to handler",
+  "LDMA drain block",
+  "EUSART0 after LDMA",
+};
+
+static void decoderInit(Decoder_TypeDef *d, double hz, bool list)
+{
+  int i;
+
+  memset(d, 0, sizeof(*d));
+  d->hz = hz;
+  d->list = list;
+  for (i = 0; i < seriesCount; i++) {
+    d->series[i].name = seriesNames[i];
+  }
+}
+
+static void decoderFree(Decoder_TypeDef *d)
+{
+  int i;
+
+  for (i = 0; i < seriesCount; i++) {
+    free(d->series[i].values);
+  }
+}
+
+static void add(Series_TypeDef *s, double us)
+{
+  if (s->count == s->size) {
+    s->size = s->size ? 2 * s->size : 256;
+    s->values = realloc(s->values, s->size * sizeof(double));
+    if (s->values == NULL) {
+      perror("realloc");
+      exit(1);
+    }
+  }
+  s->values[s->count++] = us;
+}
+
+static double us(const Decoder_TypeDef *d, uint64_t cycles)
+{
+  return (double)cycles * 1e6 / d->hz;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16)
+         | ((uint32_t)p[3] << 24);
+}
+
+static TRACE_Record_TypeDef getRecord(const uint8_t *p)
+{
+  TRACE_Record_TypeDef r;
+
+  r.time = get32(p);
+  r.id = get16(p + 4);
+  r.seq = get16(p + 6);
+  r.arg0 = get32(p + 8);
+  r.arg1 = get32(p + 12);
+  return r;
+}
+
+/*
+ * The time goes on by the signed difference from the record before, so a
+ * record a little older than the one before it, from a nested writer,
+ * steps back rather than forward by a counter wrap.
+ */
+static void takeRecord(Decoder_TypeDef *d, const TRACE_Record_TypeDef *r)
+{
+  if (!d->started) {
+    d->started = true;
+    d->time = r->time;
+  } else {
+    d->time += (int64_t)(int32_t)(r->time - d->lastRaw);
+  }
+  d->lastRaw = r->time;
+  d->records++;
+
+  switch (r->id) {
+    case TRACE_ID_TIMER:
+      add(&d->series[seriesTimerLatency], us(d, r->arg0));
+      if (d->haveTimer) {
+        add(&d->series[seriesTimerInterval], us(d, d->time - d->timerTime));
+      }
+      d->haveTimer = true;
+      d->timerTime = d->time;
+      d->timerPeriod = r->arg1;
+      break;
+    case TRACE_ID_IADC:
+      if (d->haveTimer && (r->arg1 == d->timerPeriod)) {
+        add(&d->series[seriesIadc], us(d, d->time - d->timerTime));
+      }
+      break;
+    case TRACE_ID_DRAIN:
+      d->haveDrain = true;
+      d->drainTime = d->time;
+      break;
+    case TRACE_ID_LDMA:
+      if (d->haveDrain) {
+        add(&d->series[seriesDrain], us(d, d->time - d->drainTime));
+        d->haveDrain = false;
+      }
+      d->haveLdma = true;
+      d->ldmaTime = d->time;
+      break;
+    case TRACE_ID_EUSART:
+      if (d->haveLdma) {
+        add(&d->series[seriesTxTail], us(d, d->time - d->ldmaTime));
+        d->haveLdma = false;
+      }
+      break;
+    default:
+      break;
+  }
+
+  if (d->list) {
+    printf("%14.3f  %-12s", us(d, d->time), idNames[r->id].name);
+    if (idNames[r->id].arg0[0] != '\0') {
+      printf("  %s %lu", idNames[r->id].arg0, (unsigned long)r->arg0);
+    }
+    if (idNames[r->id].arg1[0] != '\0') {
+      printf("  %s %lu", idNames[r->id].arg1, (unsigned long)r->arg1);
+    }
+    printf("\n");
+  }
+}
+
+/*
+ * Length of the well-formed block at p, 0 if there is none, or -1 if the
+ * data ends before the block does. A block is taken only if its records
+ * are numbered in sequence and have known events.
+ */
+static long blockAt(const uint8_t *p, size_t length)
+{
+  uint16_t count, first;
+  uint32_t i;
+  TRACE_Record_TypeDef r;
+
+  if (length < HEADER_SIZE) {
+    return -1;
+  }
+  count = get16(p + 2);
+  if ((get16(p) != TRACE_MAGIC) || (count == 0) || (count > TRACE_DRAIN_MAX)) {
+    return 0;
+  }
+  if (length < HEADER_SIZE + count * RECORD_SIZE) {
+    return -1;
+  }
+  first = get16(p + HEADER_SIZE + 6);
+  for (i = 0; i < count; i++) {
+    r = getRecord(p + HEADER_SIZE + i * RECORD_SIZE);
+    if ((r.id >= TRACE_ID_COUNT) || (r.seq != (uint16_t)(first + i))) {
+      return 0;
+    }
+  }
+  return (long)(HEADER_SIZE + count * RECORD_SIZE);
+}
+
+/*
+ * Decode a capture. Bytes outside blocks, such as text or a block cut by
+ * the start of the capture, are skipped; records missing between blocks
+ * are counted from their sequence numbers.
+ */
+static void decodeBytes(Decoder_TypeDef *d, const uint8_t *data, size_t length)
+{
+  size_t pos = 0;
+  long size;
+  uint16_t count, seq;
+  uint32_t i;
+  TRACE_Record_TypeDef r;
+
+  while (pos < length) {
+    size = blockAt(data + pos, length - pos);
+    if (size < 0) {
+      d->skipped += length - pos;
+      break;
+    }
+    if (size == 0) {
+      if (get16(data + pos) == TRACE_MAGIC && length - pos >= HEADER_SIZE) {
+        d->damaged++;
+      }
+      d->skipped++;
+      pos++;
+      continue;
+    }
+    count = get16(data + pos + 2);
+    d->dropped = get32(data + pos + 4);
+    seq = get16(data + pos + HEADER_SIZE + 6);
+    if (d->seqKnown) {
+      d->lost += (uint16_t)(seq - d->nextSeq);
+    }
+    for (i = 0; i < count; i++) {
+      r = getRecord(data + pos + HEADER_SIZE + i * RECORD_SIZE);
+      takeRecord(d, &r);
+    }
+    d->seqKnown = true;
+    d->nextSeq = (uint16_t)(seq + count);
+    d->blocks++;
+    pos += (size_t)size;
+  }
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+static double percentile(const Series_TypeDef *s, double p)
+{
+  size_t i = (size_t)(p * (double)(s->count - 1) + 0.5);
+
+  return s->values[i];
+}
+
+static void report(Decoder_TypeDef *d)
+{
+  Series_TypeDef *s;
+  int i;
+
+  printf("%lu blocks, %lu records, %lu lost in the capture, %lu dropped "
+         "by a full ring, %lu blocks damaged\n",
+         (unsigned long)d->blocks, (unsigned long)d->records,
+         (unsigned long)d->lost, (unsigned long)d->dropped,
+         (unsigned long)d->damaged);
+  printf("  %-28s %8s %10s %10s %10s %10s\n", "us", "count", "min",
+         "median", "99 %", "max");
+  for (i = 0; i < seriesCount; i++) {
+    s = &d->series[i];
+    if (s->count == 0) {
+      continue;
+    }
+    qsort(s->values, s->count, sizeof(double), compareDoubles);
+    printf("  %-28s %8lu %10.3f %10.3f %10.3f %10.3f\n", s->name,
+           (unsigned long)s->count, s->values[0], percentile(s, 0.5),
+           percentile(s, 0.99), s->values[s->count - 1]);
+  }
+}
+
+static int decodeFile(FILE *in, double hz, bool list)
+{
+  Decoder_TypeDef d;
+  uint8_t *data = NULL;
+  size_t length = 0, size = 0, n;
+
+  do {
+    if (length == size) {
+      size = size ? 2 * size : 65536;
+      data = realloc(data, size);
+      if (data == NULL) {
+        perror("realloc");
+        return 1;
+      }
+    }
+    n = fread(data + length, 1, size - length, in);
+    length += n;
+  } while (n != 0);
+
+  decoderInit(&d, hz, list);
+  decodeBytes(&d, data, length);
+  free(data);
+  if (d.blocks == 0) {
+    fprintf(stderr, "no trace blocks found\n");
+    decoderFree(&d);
+    return 1;
+  }
+  report(&d);
+  decoderFree(&d);
+  return 0;
+}
+
+/*******************************************************************************
+ * Self-test
+ ******************************************************************************/
+
+static uint32_t hostCycles;
+static void (*cyclesHook)(void);
+
+uint32_t TRACE_HostCycles(void)
+{
+  if (cyclesHook != NULL) {
+    void (*hook)(void) = cyclesHook;
+
+    cyclesHook = NULL;
+    hook();
+  }
+  return hostCycles;
+}
+
+static int failures;
+
+static void check(bool ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint8_t stream[1 << 20];
+static size_t streamLength;
+
+// Drain the ring into the stream as TRACE_DrainPoll() does, block by block
+static uint32_t drain(void)
+{
+  const TRACE_Record_TypeDef *first;
+  TRACE_Header_TypeDef header;
+  uint32_t count, total = 0;
+
+  while ((count = TRACE_Peek(&first, TRACE_DRAIN_MAX)) != 0) {
+    header.magic = TRACE_MAGIC;
+    header.count = (uint16_t)count;
+    header.dropped = TRACE_Dropped();
+    memcpy(stream + streamLength, &header, HEADER_SIZE);
+    memcpy(stream + streamLength + HEADER_SIZE, first, count * RECORD_SIZE);
+    streamLength += HEADER_SIZE + count * RECORD_SIZE;
+    TRACE_Release(count);
+    total += count;
+  }
+  return total;
+}
+
+static void nested(void)
+{
+  TRACE_Event(TRACE_ID_EUSART, 7, 0);
+}
+
+static bool near(double a, double b)
+{
+  return (a - b < 0.001) && (b - a < 0.001);
+}
+
+static void testRing(void)
+{
+  const TRACE_Record_TypeDef *first;
+  uint32_t i, n;
+
+  TRACE_Init();
+  check(TRACE_Peek(&first, TRACE_DRAIN_MAX) == 0, "empty after init");
+
+  hostCycles = 100;
+  TRACE_Event(TRACE_ID_TIMER, 1, 2);
+  hostCycles = 200;
+  TRACE_Event(TRACE_ID_IADC, 3, 4);
+  n = TRACE_Peek(&first, TRACE_DRAIN_MAX);
+  check(n == 2, "two records");
+  check((first[0].time == 100) && (first[0].id == TRACE_ID_TIMER)
+        && (first[0].arg0 == 1) && (first[0].arg1 == 2) && (first[0].seq == 0),
+        "first record");
+  check((first[1].time == 200) && (first[1].seq == 1), "second record");
+  TRACE_Release(n);
+
+  // A writer that interrupts another before it reserves goes first
+  hostCycles = 300;
+  cyclesHook = nested;
+  TRACE_Event(TRACE_ID_TIMER, 5, 6);
+  n = TRACE_Peek(&first, TRACE_DRAIN_MAX);
+  check((n == 2) && (first[0].id == TRACE_ID_EUSART)
+        && (first[1].id == TRACE_ID_TIMER), "nested writer first");
+  TRACE_Release(n);
+
+  // A full ring drops and counts
+  for (i = 0; i < TRACE_RECORDS + 5; i++) {
+    TRACE_Event(TRACE_ID_IADC, i, 0);
+  }
+  check(TRACE_Dropped() == 5, "five dropped");
+  n = TRACE_Peek(&first, TRACE_RECORDS);
+  check(n == TRACE_RECORDS - 4, "peek stops at the end of the ring");
+  TRACE_Release(n);
+  n = TRACE_Peek(&first, TRACE_RECORDS);
+  check((n == 4) && (first[0].arg0 == TRACE_RECORDS - 4)
+        && (first[3].arg0 == TRACE_RECORDS - 1), "rest from the start");
+  TRACE_Release(n);
+
+  // Sequence numbers wrap at 16 bits
+  for (i = 0; i < 70000; i++) {
+    TRACE_Event(TRACE_ID_IADC, i, 0);
+    n = TRACE_Peek(&first, 1);
+    if (n != 1 || first->arg0 != i) {
+      break;
+    }
+    TRACE_Release(1);
+  }
+  check(i == 70000, "sequence number wrap");
+}
+
+/*
+ * Writers on several threads stand in for interrupt handlers: every
+ * record must come out once, complete, and in reservation order.
+ */
+#define WRITERS       4
+#define PER_WRITER    50000
+
+static void *writer(void *arg)
+{
+  uint32_t w = (uint32_t)(uintptr_t)arg;
+  uint32_t i, dropped = 0;
+
+  for (i = 0; i < PER_WRITER; i++) {
+    TRACE_Event(TRACE_ID_IADC, w, i);
+    // Let the reader run when the ring fills, also on a single CPU
+    if (TRACE_Dropped() != dropped) {
+      dropped = TRACE_Dropped();
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void testThreads(void)
+{
+  pthread_t threads[WRITERS];
+  uint32_t next[WRITERS] = { 0 };
+  uint32_t i, n, taken = 0, bad = 0, dropped;
+  const TRACE_Record_TypeDef *first;
+  uint16_t seq = 0;
+
+  TRACE_Init();
+  for (i = 0; i < WRITERS; i++) {
+    pthread_create(&threads[i], NULL, writer, (void *)(uintptr_t)i);
+  }
+  for (;;) {
+    n = TRACE_Peek(&first, TRACE_DRAIN_MAX);
+    if (n == 0) {
+      sched_yield();
+    }
+    for (i = 0; i < n; i++) {
+      const TRACE_Record_TypeDef *r = &first[i];
+
+      if ((r->seq != seq) || (r->arg0 >= WRITERS) || (r->arg1 < next[r->arg0])) {
+        bad++;
+      } else {
+        next[r->arg0] = r->arg1 + 1;
+      }
+      seq++;
+    }
+    TRACE_Release(n);
+    taken += n;
+    dropped = TRACE_Dropped();
+    if (taken + dropped == WRITERS * PER_WRITER) {
+      break;
+    }
+  }
+  for (i = 0; i < WRITERS; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  printf("threads: %lu records taken, %lu dropped\n", (unsigned long)taken,
+         (unsigned long)dropped);
+  check(bad == 0, "records complete and in order across threads");
+  check(taken > dropped, "most records taken");
+  check(TRACE_Peek(&first, 1) == 0, "nothing left over");
+}
+
+static void testDecode(void)
+{
+  Decoder_TypeDef d;
+  uint32_t p, base = 0xFFF00000;    // The counter wraps during the run
+  size_t block = HEADER_SIZE + 23 * RECORD_SIZE;
+
+  // 50 periods of 10 ms at 19 MHz, with the conversion done 50 us after
+  // the timer, and a drain every 10 periods
+  TRACE_Init();
+  streamLength = 0;
+  for (p = 1; p <= 50; p++) {
+    hostCycles = base + p * 190000;
+    TRACE_Event(TRACE_ID_TIMER, 40 + p % 8, p);
+    hostCycles += 950;
+    TRACE_Event(TRACE_ID_IADC, 2000 + p, p);
+    if (p % 10 == 0) {
+      hostCycles += 1000;
+      TRACE_Event(TRACE_ID_DRAIN, 22, 8 + 22 * RECORD_SIZE);
+      hostCycles += 19000;
+      TRACE_Event(TRACE_ID_LDMA, 1, 22);
+      hostCycles += 1900;
+      TRACE_Event(TRACE_ID_EUSART, 0x40, 0);
+      drain();
+    }
+  }
+  decoderInit(&d, DEFAULT_HZ, false);
+  decodeBytes(&d, stream, streamLength);
+  check((d.blocks == 5) && (d.records == 115) && (d.lost == 0)
+        && (d.damaged == 0) && (d.skipped == 0), "clean capture");
+  report(&d);
+  check(d.series[seriesTimerInterval].count == 49, "49 periods");
+  check(near(d.series[seriesTimerInterval].values[0], 10000.0)
+        && near(d.series[seriesTimerInterval].values[48], 10000.0),
+        "period 10 ms across the wrap");
+  check(near(d.series[seriesTimerLatency].values[0], 40 / 19.0)
+        && near(d.series[seriesTimerLatency].values[49], 47 / 19.0),
+        "latency from the count");
+  check((d.series[seriesIadc].count == 50)
+        && near(d.series[seriesIadc].values[49], 50.0), "conversion 50 us");
+  check(near(d.series[seriesDrain].values[4], 1000.0), "drain 1 ms");
+  check(near(d.series[seriesTxTail].values[4], 100.0), "EUSART 100 us");
+  decoderFree(&d);
+
+  // Text first, the second block lost, the third damaged and the last cut
+  memmove(stream + 5, stream, streamLength);
+  memcpy(stream, "boot\n", 5);
+  memmove(stream + 5 + block, stream + 5 + 2 * block,
+          streamLength - 2 * block);
+  streamLength += 5 - block - 7;
+  stream[5 + block + HEADER_SIZE + 4] = 0xEE;
+  decoderInit(&d, DEFAULT_HZ, false);
+  decodeBytes(&d, stream, streamLength);
+  check(d.blocks == 2, "first and fourth blocks taken");
+  check(d.damaged == 1, "damaged block refused");
+  check(d.lost == 2 * 23, "records of the lost and damaged blocks counted");
+  decoderFree(&d);
+}
+
+static void benchmark(void)
+{
+  struct timespec a, b;
+  const TRACE_Record_TypeDef *first;
+  uint32_t i, n;
+  const uint32_t events = 10000000;
+  double ns;
+
+  TRACE_Init();
+  clock_gettime(CLOCK_MONOTONIC, &a);
+  for (i = 0; i < events; i++) {
+    TRACE_Event(TRACE_ID_TIMER, i, 0);
+    if ((i & (TRACE_DRAIN_MAX - 1)) == TRACE_DRAIN_MAX - 1) {
+      n = TRACE_Peek(&first, TRACE_DRAIN_MAX);
+      TRACE_Release(n);
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &b);
+  ns = ((b.tv_sec - a.tv_sec) * 1e9 + (b.tv_nsec - a.tv_nsec)) / events;
+  printf("TRACE_Event() with draining: %.1f ns on this host\n", ns);
+}
+
+static int selfTest(void)
+{
+  testRing();
+  testThreads();
+  testDecode();
+  benchmark();
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *in = stdin;
+  double hz = DEFAULT_HZ;
+  bool list = false;
+  int i, result;
+
+  if (argc > 1 && strcmp(argv[1], "-t") == 0) {
+    return selfTest();
+  }
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-l") == 0) {
+      list = true;
+    } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+      hz = atof(argv[++i]);
+    } else {
+      fprintf(stderr, "usage: tracedecode [-l] [-f hz] [capture.bin]\n"
+              "       tracedecode -t\n");
+      return 1;
+    }
+  }
+  if (i < argc) {
+    in = fopen(argv[i], "rb");
+    if (in == NULL) {
+      perror(argv[i]);
+      return 1;
+    }
+  }
+  result = decodeFile(in, hz, list);
+  if (in != stdin) {
+    fclose(in);
+  }
+  return result;
+}
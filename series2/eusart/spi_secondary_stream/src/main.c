@@ -0,0 +1,343 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief This project demonstrates an SPI secondary that streams: the EUSART
+ * stays enabled, LDMA channels run continuously into a receive ring and from
+ * a double-buffered response, and chip select edges split the stream into
+ * frames.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_eusart.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_timer.h"
+
+#include "spistream.h"
+
+// SPI ports and pins
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_5)
+#define EUS1MOSI_PORT   gpioPortC
+#define EUS1MOSI_PIN    0
+#define EUS1MISO_PORT   gpioPortC
+#define EUS1MISO_PIN    1
+#define EUS1SCLK_PORT   gpioPortC
+#define EUS1SCLK_PIN    2
+#define EUS1CS_PORT     gpioPortB
+#define EUS1CS_PIN      4
+#elif defined(_SILICON_LABS_32B_SERIES_2_CONFIG_8)
+#define EUS1MOSI_PORT   gpioPortD
+#define EUS1MOSI_PIN    7
+#define EUS1MISO_PORT   gpioPortD
+#define EUS1MISO_PIN    8
+#define EUS1SCLK_PORT   gpioPortD
+#define EUS1SCLK_PIN    9
+#define EUS1CS_PORT     gpioPortD
+#define EUS1CS_PIN      10
+#else
+#define EUS1MOSI_PORT   gpioPortC
+#define EUS1MOSI_PIN    1
+#define EUS1MISO_PORT   gpioPortC
+#define EUS1MISO_PIN    2
+#define EUS1SCLK_PORT   gpioPortC
+#define EUS1SCLK_PIN    3
+#define EUS1CS_PORT     gpioPortC
+#define EUS1CS_PIN      0
+#endif
+
+// LDMA channels for receive and transmit servicing
+#define RX_LDMA_CHANNEL 0
+#define TX_LDMA_CHANNEL 1
+
+// Tick that tracks the ring position (and ends frames in timeout mode)
+#define TICK_HZ         1000
+
+// Receive ring, written only by the LDMA
+static volatile uint8_t ring[SPISTREAM_RING];
+
+// Stream state; inspect the counters in the debugger
+SPISTREAM_Handle_TypeDef stream;
+
+// Last frame copied out of the ring
+uint8_t frame[SPISTREAM_RING];
+uint32_t frameLength;
+
+// Frames processed by the main loop
+uint32_t frames;
+
+static volatile uint32_t ticks;
+
+/**************************************************************************//**
+ * @brief
+ *    GPIO initialization
+ *****************************************************************************/
+void initGPIO(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  // Enable EUSART interface pins
+  GPIO->EUSARTROUTE[1].ROUTEEN = GPIO_EUSART_ROUTEEN_RXPEN |    // MISO
+                                 GPIO_EUSART_ROUTEEN_TXPEN |    // MOSI
+                                 GPIO_EUSART_ROUTEEN_SCLKPEN |
+                                 GPIO_EUSART_ROUTEEN_CSPEN;
+
+  // Route EUSART1 RX, TX, CLK, and CS to the specified pins.
+  GPIO->EUSARTROUTE[1].TXROUTE = (EUS1MOSI_PORT << _GPIO_EUSART_TXROUTE_PORT_SHIFT)
+      | (EUS1MOSI_PIN << _GPIO_EUSART_TXROUTE_PIN_SHIFT);
+  GPIO->EUSARTROUTE[1].RXROUTE = (EUS1MISO_PORT << _GPIO_EUSART_RXROUTE_PORT_SHIFT)
+      | (EUS1MISO_PIN << _GPIO_EUSART_RXROUTE_PIN_SHIFT);
+  GPIO->EUSARTROUTE[1].SCLKROUTE = (EUS1SCLK_PORT << _GPIO_EUSART_SCLKROUTE_PORT_SHIFT)
+      | (EUS1SCLK_PIN << _GPIO_EUSART_SCLKROUTE_PIN_SHIFT);
+  GPIO->EUSARTROUTE[1].CSROUTE = (EUS1CS_PORT << _GPIO_EUSART_CSROUTE_PORT_SHIFT)
+      | (EUS1CS_PIN << _GPIO_EUSART_CSROUTE_PIN_SHIFT);
+
+  // Configure MOSI (TX) pin as an input
+  GPIO_PinModeSet(EUS1MOSI_PORT, EUS1MOSI_PIN, gpioModeInput, 0);
+
+  // Configure MISO (RX) pin as an output
+  GPIO_PinModeSet(EUS1MISO_PORT, EUS1MISO_PIN, gpioModePushPull, 0);
+
+  // Configure SCLK pin as an input
+  GPIO_PinModeSet(EUS1SCLK_PORT, EUS1SCLK_PIN, gpioModeInput, 0);
+
+  // Configure CS pin as an input pulled high
+  GPIO_PinModeSet(EUS1CS_PORT, EUS1CS_PIN, gpioModeInputPull, 1);
+
+  // Request an interrupt on a CS pin low-to-high transition (frame end)
+  GPIO_ExtIntConfig(EUS1CS_PORT, EUS1CS_PIN, EUS1CS_PIN, true, false, true);
+
+  // Enable NVIC GPIO interrupt
+#if (EUS1CS_PIN & 1)
+  NVIC_ClearPendingIRQ(GPIO_ODD_IRQn);
+  NVIC_EnableIRQ(GPIO_ODD_IRQn);
+#else
+  NVIC_ClearPendingIRQ(GPIO_EVEN_IRQn);
+  NVIC_EnableIRQ(GPIO_EVEN_IRQn);
+#endif
+}
+
+/**************************************************************************//**
+ * @brief
+ *    EUSART1 initialization
+ *****************************************************************************/
+void initEUSART1(void)
+{
+  CMU_ClockEnable(cmuClock_EUSART1, true);
+
+  // SPI advanced configuration (part of the initializer)
+  EUSART_SpiAdvancedInit_TypeDef adv = EUSART_SPI_ADVANCED_INIT_DEFAULT;
+
+  adv.msbFirst = true;        // SPI standard MSB first
+
+  // Default secondary initializer (8-bit data)
+  EUSART_SpiInit_TypeDef init = EUSART_SPI_SLAVE_INIT_DEFAULT_HF;
+
+  init.advancedSettings = &adv;   // Advanced settings structure
+  init.enable = eusartDisable;    // Do not enable yet
+
+  // Configure EUSART1
+  EUSART_SpiInit(EUSART1, &init);
+
+  /*
+   * Set FORCELOAD so that the first byte of each frame comes from the
+   * transmit FIFO rather than the default frame; this requires the EUSART
+   * to be disabled.  Unlike the spi_secondary_dma example, the EUSART then
+   * stays enabled for good: the LDMA channels never stop, so no bytes are
+   * missed between frames.
+   */
+  EUSART1->EN_CLR = EUSART_EN_EN;
+
+  // Wait while the EUSART disables itself
+  while ((EUSART1->EN & EUSART_EN_DISABLING));
+
+  // Set FORCELOAD, then re-enable
+  EUSART1->CFG2_SET = EUSART_CFG2_FORCELOAD;
+  EUSART1->EN_SET = EUSART_EN_EN;
+}
+
+/**************************************************************************//**
+ * @brief
+ *    TIMER0 initialization: a TICK_HZ overflow interrupt
+ *****************************************************************************/
+void initTIMER0(void)
+{
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+  timerInit.enable = false;
+  TIMER_Init(TIMER0, &timerInit);
+  TIMER_TopSet(TIMER0, CMU_ClockFreqGet(cmuClock_TIMER0) / TICK_HZ - 1);
+
+  TIMER_IntEnable(TIMER0, TIMER_IEN_OF);
+  NVIC_ClearPendingIRQ(TIMER0_IRQn);
+  NVIC_EnableIRQ(TIMER0_IRQn);
+  TIMER_Enable(TIMER0, true);
+}
+
+/**************************************************************************//**
+ * @brief GPIO IRQHandler: chip select deasserted
+ *
+ * @note
+ *   Runs at the same priority as TIMER0_IRQHandler so the two never
+ *   preempt each other while updating the stream.
+ *****************************************************************************/
+#if (EUS1CS_PIN & 1)
+void GPIO_ODD_IRQHandler(void)
+#else
+void GPIO_EVEN_IRQHandler(void)
+#endif
+{
+  // Clear the rising edge interrupt flag
+  GPIO_IntClear(1 << EUS1CS_PIN);
+
+  SPISTREAM_FrameEndIRQ(&stream, ticks);
+}
+
+/**************************************************************************//**
+ * @brief TIMER0 IRQHandler: stream tick
+ *****************************************************************************/
+void TIMER0_IRQHandler(void)
+{
+  TIMER_IntClear(TIMER0, TIMER_IF_OF);
+  ticks++;
+
+  SPISTREAM_TickIRQ(&stream, ticks);
+}
+
+/**************************************************************************//**
+ * @brief EUSART1 RX and TX IRQHandlers: FIFO overflow and underflow
+ *****************************************************************************/
+void EUSART1_RX_IRQHandler(void)
+{
+  SPISTREAM_ErrorIRQ(&stream);
+}
+
+void EUSART1_TX_IRQHandler(void)
+{
+  SPISTREAM_ErrorIRQ(&stream);
+}
+
+/**************************************************************************//**
+ * @brief
+ *    Build the response to a frame: a sequence number, the frame length, a
+ *    byte sum and then the frame echoed back.
+ *****************************************************************************/
+static void respond(const uint8_t *data, uint32_t length)
+{
+  uint8_t *next = SPISTREAM_ResponseBuffer(&stream);
+  uint32_t echo = length;
+  uint8_t sum = 0;
+  uint32_t i;
+
+  // The previous response has not gone out yet; skip this one
+  if (next == NULL) {
+    return;
+  }
+
+  for (i = 0; i < length; i++) {
+    sum += data[i];
+  }
+  if (echo > SPISTREAM_RESPONSE_MAX - 3) {
+    echo = SPISTREAM_RESPONSE_MAX - 3;
+  }
+
+  next[0] = (uint8_t)frames;
+  next[1] = (uint8_t)length;
+  next[2] = sum;
+  memcpy(&next[3], data, echo);
+  SPISTREAM_ResponseCommit(&stream, (uint16_t)(echo + 3));
+}
+
+/**************************************************************************//**
+ * @brief
+ *    Main function
+ *****************************************************************************/
+int main(void)
+{
+  SPISTREAM_Init_TypeDef streamInit = SPISTREAM_INIT_DEFAULT;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Initialize DCDC with kit specific parameters
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+
+  // Run from the HFXO to maximize performance
+  CMU_HFXOInit_TypeDef hfxoInit = CMU_HFXOINIT_DEFAULT;
+  CMU_HFXOInit(&hfxoInit);
+
+  // Set DPLL to 80 MHz (40 MHz PCLK)
+  CMU_DPLLInit_TypeDef initDPLL = CMU_DPLL_HFXO_TO_80MHZ;
+
+  // Attempt DPLL lock; halt on failure
+  if (CMU_DPLLLock(&initDPLL) == false)
+    __BKPT(0);
+
+  /*
+   * Set the optimal number of wait states for the selected HFCLK
+   * frequency.  Highest performance is achieved without voltage
+   * scaling, which is specified by 0 for the second parameter.
+   */
+  CMU_UpdateWaitStates(SystemCoreClockGet(), 0);
+
+  // Initialize EUSART1 and the LDMA, then start the stream
+  initEUSART1();
+
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  LDMA_Init(&ldmaInit);
+
+  SPISTREAM_Start(&stream, &streamInit, ring, RX_LDMA_CHANNEL, TX_LDMA_CHANNEL);
+
+  // Frame ends and ticks
+  initGPIO();
+  initTIMER0();
+
+  while (1)
+  {
+    // Handle every frame received since the last pass
+    while (SPISTREAM_FrameRead(&stream, ring, frame, sizeof(frame), &frameLength))
+    {
+      frames++;
+      respond(frame, frameLength);
+    }
+
+    // Wake on the next frame end or tick
+    EMU_EnterEM1();
+  }
+}
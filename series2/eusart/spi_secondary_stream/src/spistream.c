@@ -0,0 +1,380 @@
+/***************************************************************************//**
+ * @file spistream.c
+ * @brief SPI secondary streaming: continuous receive ring split into frames
+ * and a double-buffered prepared response.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "spistream.h"
+
+#if !defined(SPISTREAM_HOST)
+#include "em_device.h"
+#include "em_eusart.h"
+#include "em_ldma.h"
+
+static LDMA_Descriptor_t rxDesc;
+static LDMA_Descriptor_t txDesc[2];
+static volatile uint8_t *rxRing;
+static unsigned int rxCh;
+static unsigned int txCh;
+static uint8_t fillByte;
+
+static const LDMA_TransferCfg_t rxCfg =
+  LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_EUSART1_RXFL);
+static const LDMA_TransferCfg_t txCfg =
+  LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_EUSART1_TXFL);
+
+/**************************************************************************//**
+ * @brief
+ *   Ring index the receive channel writes next.
+ *****************************************************************************/
+static uint32_t rxWriteIndex(void)
+{
+  return (LDMA->CH[rxCh].DST - (uint32_t)rxRing) % SPISTREAM_RING;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Restart the transmit channel at the front response, followed by the
+ *   fill byte for as long as the main keeps clocking.
+ *****************************************************************************/
+static void armTx(const SPISTREAM_Handle_TypeDef *handle)
+{
+  uint16_t length;
+  const uint8_t *response = SPISTREAM_ResponseFront(handle, &length);
+
+  LDMA_StopTransfer(txCh);
+  EUSART1->CMD = EUSART_CMD_CLEARTX;
+
+  if (length > 0) {
+    txDesc[0] = (LDMA_Descriptor_t)
+      LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(response, &EUSART1->TXDATA, length, 1);
+    LDMA_StartTransfer(txCh, &txCfg, &txDesc[0]);
+  } else {
+    LDMA_StartTransfer(txCh, &txCfg, &txDesc[1]);
+  }
+  LDMA_IntDisable(1 << txCh);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start streaming on EUSART1.
+ *
+ * @details
+ *   EUSART1 must be enabled in secondary mode and LDMA_Init() must have been
+ *   called. The receive channel writes every byte into the ring and loops
+ *   forever without interrupts; the transmit channel sends the front
+ *   response and then the fill byte. The application calls
+ *   SPISTREAM_FrameEndIRQ() on chip select deassertion, SPISTREAM_TickIRQ()
+ *   from a periodic timer and SPISTREAM_ErrorIRQ() from the EUSART1
+ *   interrupt handlers.
+ *
+ * @param[in] ring
+ *   SPISTREAM_RING bytes, written only by the LDMA.
+ *****************************************************************************/
+void SPISTREAM_Start(SPISTREAM_Handle_TypeDef *handle,
+                     const SPISTREAM_Init_TypeDef *init,
+                     volatile uint8_t *ring,
+                     unsigned int rxChannel,
+                     unsigned int txChannel)
+{
+  SPISTREAM_Init(handle, init);
+  handle->config.writeIndex = rxWriteIndex;
+  rxRing = ring;
+  rxCh = rxChannel;
+  txCh = txChannel;
+  fillByte = init->fill;
+
+  // The receive descriptor links to itself, so the ring never stops
+  rxDesc = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(&EUSART1->RXDATA, ring, SPISTREAM_RING, 0);
+  LDMA_StartTransfer(rxCh, &rxCfg, &rxDesc);
+  LDMA_IntDisable(1 << rxCh);
+
+  // Fill byte after the response, also looping on itself
+  txDesc[1] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(&fillByte, &EUSART1->TXDATA, 1, 0);
+  armTx(handle);
+
+  // FIFO overflow and underflow mean the LDMA could not keep up
+  EUSART_IntClear(EUSART1, EUSART_IF_RXOF | EUSART_IF_TXUF);
+  EUSART_IntEnable(EUSART1, EUSART_IEN_RXOF | EUSART_IEN_TXUF);
+  NVIC_ClearPendingIRQ(EUSART1_RX_IRQn);
+  NVIC_EnableIRQ(EUSART1_RX_IRQn);
+  NVIC_ClearPendingIRQ(EUSART1_TX_IRQn);
+  NVIC_EnableIRQ(EUSART1_TX_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Chip select deassertion: close the frame and line up the next response.
+ *****************************************************************************/
+void SPISTREAM_FrameEndIRQ(SPISTREAM_Handle_TypeDef *handle, uint32_t now)
+{
+  // Let the LDMA empty the receive FIFO first
+  while (EUSART1->STATUS & EUSART_STATUS_RXFL) {
+  }
+
+  if (SPISTREAM_FrameEnd(handle, now)) {
+    armTx(handle);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Periodic tick: track the ring position and, in timeout mode, close idle
+ *   frames.
+ *****************************************************************************/
+void SPISTREAM_TickIRQ(SPISTREAM_Handle_TypeDef *handle, uint32_t now)
+{
+  if (SPISTREAM_Poll(handle, now)) {
+    armTx(handle);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count receive overflows and transmit underflows.
+ *****************************************************************************/
+void SPISTREAM_ErrorIRQ(SPISTREAM_Handle_TypeDef *handle)
+{
+  uint32_t flags = EUSART_IntGetEnabled(EUSART1);
+
+  EUSART_IntClear(EUSART1, flags);
+  if (flags & EUSART_IF_RXOF) {
+    handle->rxOverflows++;
+  }
+  if (flags & EUSART_IF_TXUF) {
+    handle->txUnderflows++;
+  }
+}
+#endif // !SPISTREAM_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Reset the stream.
+ *****************************************************************************/
+void SPISTREAM_Init(SPISTREAM_Handle_TypeDef *handle,
+                    const SPISTREAM_Init_TypeDef *init)
+{
+  memset(handle, 0, sizeof(*handle));
+  handle->config = *init;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Absolute position the receiver writes next.
+ *
+ * @details
+ *   Ring index i of position p is p % SPISTREAM_RING, so the position only
+ *   needs the last recorded one and the current write index, as long as
+ *   fewer than SPISTREAM_RING bytes arrived in between. position is read
+ *   once, so this is safe against an update from interrupt context.
+ *****************************************************************************/
+static uint32_t livePosition(const SPISTREAM_Handle_TypeDef *handle)
+{
+  uint32_t position = handle->position;
+  uint32_t w = handle->config.writeIndex();
+
+  return position + ((w - position) % SPISTREAM_RING);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Queue the open frame and switch to the prepared response.
+ *****************************************************************************/
+static void closeFrame(SPISTREAM_Handle_TypeDef *handle)
+{
+  uint32_t length = handle->position - handle->frameStart;
+  uint16_t sent = handle->responseLength[handle->front];
+  uint8_t next = (uint8_t)((handle->frameHead + 1) % SPISTREAM_FRAMES);
+
+  // The main clocked past the response; the rest was fill
+  if (length > sent) {
+    handle->underflows++;
+    handle->padBytes += length - sent;
+  }
+
+  if (next == handle->frameTail) {
+    handle->overruns++;
+  } else {
+    handle->frames[handle->frameHead].start = handle->frameStart;
+    handle->frames[handle->frameHead].length = length;
+    handle->frameHead = next;
+  }
+  handle->frameStart = handle->position;
+  handle->frameCount++;
+
+  // Each response is sent once; without a new one, only fill is sent
+  if (handle->ready) {
+    handle->front ^= 1;
+    handle->ready = false;
+  } else {
+    handle->responseLength[handle->front] = 0;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Track the receive position; in timeout mode, close a frame that has
+ *   been idle for the configured number of ticks.
+ *
+ * @note
+ *   Must be called at least once per SPISTREAM_RING bytes of traffic.
+ *
+ * @return
+ *   true if a frame was closed and the transmitter must be rearmed.
+ *****************************************************************************/
+bool SPISTREAM_Poll(SPISTREAM_Handle_TypeDef *handle, uint32_t now)
+{
+  uint32_t position = livePosition(handle);
+
+  if (position != handle->position) {
+    handle->position = position;
+    handle->lastActivity = now;
+    return false;
+  }
+
+  if (handle->config.mode == spistreamFrameTimeout
+      && position != handle->frameStart
+      && now - handle->lastActivity >= handle->config.timeout) {
+    closeFrame(handle);
+    return true;
+  }
+  return false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   End of frame (chip select deasserted).
+ *
+ * @return
+ *   true if a non-empty frame was closed and the transmitter must be
+ *   rearmed.
+ *****************************************************************************/
+bool SPISTREAM_FrameEnd(SPISTREAM_Handle_TypeDef *handle, uint32_t now)
+{
+  uint32_t position = livePosition(handle);
+
+  if (position != handle->position) {
+    handle->position = position;
+    handle->lastActivity = now;
+  }
+  if (position == handle->frameStart) {
+    return false;
+  }
+  closeFrame(handle);
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Copy the oldest received frame out of the ring.
+ *
+ * @details
+ *   Frames whose data the receiver has overwritten before or during the
+ *   copy are dropped and counted as overruns. Frames longer than maxLength
+ *   are truncated.
+ *
+ * @return
+ *   false if no frame is waiting.
+ *****************************************************************************/
+bool SPISTREAM_FrameRead(SPISTREAM_Handle_TypeDef *handle,
+                         const volatile uint8_t *ring,
+                         uint8_t *out,
+                         uint32_t maxLength,
+                         uint32_t *length)
+{
+  while (handle->frameTail != handle->frameHead) {
+    SPISTREAM_Frame_TypeDef f = handle->frames[handle->frameTail];
+    uint32_t n = f.length < maxLength ? f.length : maxLength;
+    uint32_t at = f.start % SPISTREAM_RING;
+    uint32_t first = SPISTREAM_RING - at < n ? SPISTREAM_RING - at : n;
+    bool intact = livePosition(handle) - f.start <= SPISTREAM_RING;
+
+    if (intact) {
+      memcpy(out, (const uint8_t *)ring + at, first);
+      memcpy(out + first, (const uint8_t *)ring, n - first);
+
+      // The receiver may have wrapped onto the frame during the copy
+      intact = livePosition(handle) - f.start <= SPISTREAM_RING;
+    }
+    handle->frameTail = (uint8_t)((handle->frameTail + 1) % SPISTREAM_FRAMES);
+
+    if (intact) {
+      *length = n;
+      return true;
+    }
+    handle->overruns++;
+  }
+  return false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Buffer for the next response, or NULL while the last committed one has
+ *   not been taken by a frame end yet.
+ *****************************************************************************/
+uint8_t *SPISTREAM_ResponseBuffer(SPISTREAM_Handle_TypeDef *handle)
+{
+  if (handle->ready) {
+    return NULL;
+  }
+  return handle->response[handle->front ^ 1];
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Make the prepared response the one sent in the frame after the current
+ *   one.
+ *****************************************************************************/
+void SPISTREAM_ResponseCommit(SPISTREAM_Handle_TypeDef *handle,
+                              uint16_t length)
+{
+  if (length > SPISTREAM_RESPONSE_MAX) {
+    length = SPISTREAM_RESPONSE_MAX;
+  }
+  handle->responseLength[handle->front ^ 1] = length;
+  handle->ready = true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Response the transmitter sends in the current frame.
+ *****************************************************************************/
+const uint8_t *SPISTREAM_ResponseFront(const SPISTREAM_Handle_TypeDef *handle,
+                                       uint16_t *length)
+{
+  *length = handle->responseLength[handle->front];
+  return handle->response[handle->front];
+}
@@ -0,0 +1,143 @@
+/***************************************************************************//**
+ * @file spistream.h
+ * @brief SPI secondary streaming: continuous receive ring split into frames
+ * and a double-buffered prepared response.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef SPISTREAM_H
+#define SPISTREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Receive ring size; a power of two no larger than the LDMA transfer limit
+#define SPISTREAM_RING          2048
+
+/// Frames waiting to be read
+#define SPISTREAM_FRAMES        16
+
+/// Longest prepared response
+#define SPISTREAM_RESPONSE_MAX  256
+
+/// How frames are delimited
+typedef enum {
+  spistreamFrameCs,       ///< Chip select deassertion ends a frame
+  spistreamFrameTimeout   ///< No bytes for timeout ticks ends a frame
+} SPISTREAM_FrameMode_TypeDef;
+
+/// Stream configuration
+typedef struct {
+  SPISTREAM_FrameMode_TypeDef mode;
+  uint32_t timeout;             ///< Idle ticks ending a frame (timeout mode)
+  uint8_t  fill;                ///< Sent when no response byte is left
+  uint32_t (*writeIndex)(void); ///< Ring index the receiver writes next;
+                                ///< set by SPISTREAM_Start() on the target
+} SPISTREAM_Init_TypeDef;
+
+/// Default configuration: chip select framing, 0xFF fill
+#define SPISTREAM_INIT_DEFAULT                                        \
+  {                                                                   \
+    spistreamFrameCs,   /* Chip select ends a frame */                \
+    2,                  /* 2 idle ticks end a frame in timeout mode */\
+    0xFF,               /* Fill byte */                               \
+    NULL,               /* Set by SPISTREAM_Start() */                \
+  }
+
+/// A received frame, by absolute stream position
+typedef struct {
+  uint32_t start;
+  uint32_t length;
+} SPISTREAM_Frame_TypeDef;
+
+/// Stream state; all fields are read-only for the application
+typedef struct {
+  SPISTREAM_Init_TypeDef  config;
+
+  // Receive side, updated at frame ends and ticks
+  volatile uint32_t       position;     ///< Bytes received since start
+  uint32_t                frameStart;   ///< Position of the open frame
+  uint32_t                lastActivity; ///< Tick of the last received byte
+  SPISTREAM_Frame_TypeDef frames[SPISTREAM_FRAMES];
+  volatile uint8_t        frameHead;    ///< Written at frame ends
+  volatile uint8_t        frameTail;    ///< Written by the reader
+
+  // Transmit side: front is being sent, back is being prepared
+  uint8_t                 response[2][SPISTREAM_RESPONSE_MAX];
+  volatile uint16_t       responseLength[2];
+  volatile uint8_t        front;
+  volatile bool           ready;        ///< Back buffer committed
+
+  uint32_t frameCount;                  ///< Frames closed
+  uint32_t overruns;                    ///< Frames lost: overwritten or queue full
+  uint32_t underflows;                  ///< Frames clocked past their response
+  uint32_t padBytes;                    ///< Fill bytes sent in those frames
+  uint32_t rxOverflows;                 ///< Receive FIFO overflows (hardware)
+  uint32_t txUnderflows;                ///< Transmit FIFO underflows (hardware)
+} SPISTREAM_Handle_TypeDef;
+
+void SPISTREAM_Init(SPISTREAM_Handle_TypeDef *handle,
+                    const SPISTREAM_Init_TypeDef *init);
+bool SPISTREAM_Poll(SPISTREAM_Handle_TypeDef *handle, uint32_t now);
+bool SPISTREAM_FrameEnd(SPISTREAM_Handle_TypeDef *handle, uint32_t now);
+bool SPISTREAM_FrameRead(SPISTREAM_Handle_TypeDef *handle,
+                         const volatile uint8_t *ring,
+                         uint8_t *out,
+                         uint32_t maxLength,
+                         uint32_t *length);
+uint8_t *SPISTREAM_ResponseBuffer(SPISTREAM_Handle_TypeDef *handle);
+void SPISTREAM_ResponseCommit(SPISTREAM_Handle_TypeDef *handle,
+                              uint16_t length);
+const uint8_t *SPISTREAM_ResponseFront(const SPISTREAM_Handle_TypeDef *handle,
+                                       uint16_t *length);
+
+#if !defined(SPISTREAM_HOST)
+void SPISTREAM_Start(SPISTREAM_Handle_TypeDef *handle,
+                     const SPISTREAM_Init_TypeDef *init,
+                     volatile uint8_t *ring,
+                     unsigned int rxChannel,
+                     unsigned int txChannel);
+void SPISTREAM_FrameEndIRQ(SPISTREAM_Handle_TypeDef *handle, uint32_t now);
+void SPISTREAM_TickIRQ(SPISTREAM_Handle_TypeDef *handle, uint32_t now);
+void SPISTREAM_ErrorIRQ(SPISTREAM_Handle_TypeDef *handle);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPISTREAM_H
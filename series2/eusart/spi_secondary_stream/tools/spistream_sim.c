@@ -0,0 +1,329 @@
+/***************************************************************************//**
+ * @file spistream_sim.c
+ * @brief Host test and benchmark for the SPI secondary stream framing.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DSPISTREAM_HOST -I../src -o spistream_sim spistream_sim.c ../src/spistream.c
+ *   ./spistream_sim
+ *
+ * A model receive channel writes bytes into the ring the way the looping
+ * LDMA descriptor does, and the frame end, tick and reader calls are made in
+ * the order the interrupts and the main loop would make them. The model can
+ * also inject bytes while a frame is being copied, to check that a frame
+ * overwritten mid-copy is dropped. The exit status is non-zero if a check
+ * fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "spistream.h"
+
+static volatile uint8_t ring[SPISTREAM_RING];
+static uint32_t written;          // Bytes the model receiver has written
+static uint32_t injectCall;       // writeIndex() call that injects bytes
+static uint32_t injectBytes;
+static uint32_t calls;
+static uint8_t frame[SPISTREAM_RING];
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Byte value at absolute stream position p
+static uint8_t pattern(uint32_t p)
+{
+  return (uint8_t)(p * 7 + (p >> 8));
+}
+
+static void receive(uint32_t count)
+{
+  while (count--) {
+    ring[written % SPISTREAM_RING] = pattern(written);
+    written++;
+  }
+}
+
+static uint32_t modelWriteIndex(void)
+{
+  if (++calls == injectCall) {
+    receive(injectBytes);
+  }
+  return written % SPISTREAM_RING;
+}
+
+static void reset(SPISTREAM_Handle_TypeDef *h, SPISTREAM_FrameMode_TypeDef mode)
+{
+  SPISTREAM_Init_TypeDef init = { mode, 3, 0xFF, modelWriteIndex };
+
+  memset((void *)ring, 0, sizeof(ring));
+  written = 0;
+  calls = 0;
+  injectCall = 0;
+  SPISTREAM_Init(h, &init);
+}
+
+// Read one frame and compare it with the pattern at the expected position
+static int readFrame(SPISTREAM_Handle_TypeDef *h, uint32_t start,
+                     uint32_t length)
+{
+  uint32_t got = 0;
+  uint32_t i;
+
+  if (!SPISTREAM_FrameRead(h, ring, frame, sizeof(frame), &got)
+      || got != length) {
+    return 0;
+  }
+  for (i = 0; i < length; i++) {
+    if (frame[i] != pattern(start + i)) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void testChipSelect(void)
+{
+  SPISTREAM_Handle_TypeDef h;
+  static const uint32_t lengths[] = { 10, 1, 300, 2047, 64 };
+  uint32_t start = 0;
+  uint32_t got;
+  unsigned int i;
+
+  reset(&h, spistreamFrameCs);
+  check(!SPISTREAM_FrameEnd(&h, 0), "empty chip select pulse closes nothing");
+
+  for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    receive(lengths[i]);
+    check(SPISTREAM_FrameEnd(&h, i), "frame end closes a frame");
+    check(readFrame(&h, start, lengths[i]), "frame content and length");
+    start += lengths[i];
+  }
+  check(!SPISTREAM_FrameRead(&h, ring, frame, sizeof(frame), &got),
+        "no frame left");
+  check(h.frameCount == 5 && h.overruns == 0, "chip select frame count");
+
+  // Truncation to the reader's buffer
+  receive(100);
+  SPISTREAM_FrameEnd(&h, 10);
+  check(SPISTREAM_FrameRead(&h, ring, frame, 40, &got) && got == 40
+        && frame[39] == pattern(start + 39), "long frame truncated");
+}
+
+static void testTimeout(void)
+{
+  SPISTREAM_Handle_TypeDef h;
+  uint32_t now = 0;
+  int closed = 0;
+
+  reset(&h, spistreamFrameTimeout);
+
+  // 20 bytes over 4 ticks, a gap, then 5 bytes
+  for (; now < 4; now++) {
+    receive(5);
+    closed += SPISTREAM_Poll(&h, now);
+  }
+  check(closed == 0, "no timeout while bytes keep arriving");
+  closed += SPISTREAM_Poll(&h, now++);
+  closed += SPISTREAM_Poll(&h, now++);
+  check(closed == 0, "no timeout before the idle limit");
+  closed += SPISTREAM_Poll(&h, now++);
+  check(closed == 1, "timeout closes the frame after 3 idle ticks");
+  closed += SPISTREAM_Poll(&h, now++);
+  check(closed == 1, "idle line without data closes nothing");
+
+  receive(5);
+  SPISTREAM_Poll(&h, now++);
+  while (now < 20) {
+    closed += SPISTREAM_Poll(&h, now++);
+  }
+  check(closed == 2, "second frame after the gap");
+  check(readFrame(&h, 0, 20) && readFrame(&h, 20, 5), "timeout frame contents");
+}
+
+static void testQueueFull(void)
+{
+  SPISTREAM_Handle_TypeDef h;
+  uint32_t i;
+  uint32_t got;
+  uint32_t n = 0;
+
+  reset(&h, spistreamFrameCs);
+  for (i = 0; i < 20; i++) {
+    receive(8);
+    SPISTREAM_FrameEnd(&h, i);
+  }
+  while (SPISTREAM_FrameRead(&h, ring, frame, sizeof(frame), &got)) {
+    check(frame[0] == pattern(n * 8), "queued frames kept in order");
+    n++;
+  }
+  check(n == SPISTREAM_FRAMES - 1, "queue holds SPISTREAM_FRAMES - 1 frames");
+  check(h.overruns == 20 - n && h.frameCount == 20, "full queue counted");
+}
+
+static void testRingOverrun(void)
+{
+  SPISTREAM_Handle_TypeDef h;
+  uint32_t i;
+
+  reset(&h, spistreamFrameCs);
+
+  // A frame overwritten by later traffic before the reader gets to it
+  receive(100);
+  SPISTREAM_FrameEnd(&h, 0);
+  for (i = 0; i < 5; i++) {
+    receive(500);
+    SPISTREAM_Poll(&h, i);
+  }
+  SPISTREAM_FrameEnd(&h, 5);
+  check(readFrame(&h, 100, 2500) == 0 && h.overruns == 2,
+        "overwritten frames dropped");
+
+  // A frame overwritten while it is being copied
+  reset(&h, spistreamFrameCs);
+  receive(1000);
+  SPISTREAM_FrameEnd(&h, 0);
+  injectCall = calls + 2;
+  injectBytes = 1100;
+  check(readFrame(&h, 0, 1000) == 0 && h.overruns == 1,
+        "frame overwritten during the copy dropped");
+
+  // Position tracking across many wraps with ticks in a long frame
+  reset(&h, spistreamFrameCs);
+  for (i = 0; i < 10; i++) {
+    receive(1500);
+    SPISTREAM_Poll(&h, i);
+  }
+  SPISTREAM_FrameEnd(&h, 10);
+  receive(33);
+  SPISTREAM_FrameEnd(&h, 11);
+  check(h.position == 15033, "position tracked across ring wraps");
+  check(readFrame(&h, 15000, 33), "frame after a long frame");
+}
+
+static void testResponse(void)
+{
+  SPISTREAM_Handle_TypeDef h;
+  const uint8_t *front;
+  uint16_t len;
+  uint8_t *back;
+
+  reset(&h, spistreamFrameCs);
+  SPISTREAM_ResponseFront(&h, &len);
+  check(len == 0, "no response before the first commit");
+
+  back = SPISTREAM_ResponseBuffer(&h);
+  memcpy(back, "0123456789", 10);
+  SPISTREAM_ResponseCommit(&h, 10);
+  check(SPISTREAM_ResponseBuffer(&h) == NULL, "back buffer held until taken");
+
+  // Frame 1 still sends the (empty) first front buffer
+  receive(10);
+  SPISTREAM_FrameEnd(&h, 0);
+  check(h.underflows == 1 && h.padBytes == 10, "first frame all fill");
+  front = SPISTREAM_ResponseFront(&h, &len);
+  check(len == 10 && memcmp(front, "0123456789", 10) == 0,
+        "committed response sent in the next frame");
+
+  back = SPISTREAM_ResponseBuffer(&h);
+  check(back != NULL && back != front, "back buffer free after the swap");
+  memcpy(back, "abcdefghijklmnop", 16);
+  SPISTREAM_ResponseCommit(&h, 16);
+
+  // Frame 2 is clocked 2 bytes past its response
+  receive(12);
+  SPISTREAM_FrameEnd(&h, 1);
+  check(h.underflows == 2 && h.padBytes == 12, "pad bytes counted");
+  front = SPISTREAM_ResponseFront(&h, &len);
+  check(len == 16 && front[0] == 'a', "second response");
+
+  // Frame 3 is shorter than its response; nothing new was committed
+  receive(4);
+  SPISTREAM_FrameEnd(&h, 2);
+  check(h.underflows == 2, "short frame is no underflow");
+  SPISTREAM_ResponseFront(&h, &len);
+  check(len == 0, "a response is sent only once");
+
+  SPISTREAM_ResponseCommit(&h, 1000);
+  front = SPISTREAM_ResponseFront(&h, &len);
+  receive(1);
+  SPISTREAM_FrameEnd(&h, 3);
+  SPISTREAM_ResponseFront(&h, &len);
+  check(len == SPISTREAM_RESPONSE_MAX, "response length limited");
+}
+
+static void benchmark(void)
+{
+  SPISTREAM_Handle_TypeDef h;
+  const uint32_t frames = 2000000;
+  const uint32_t length = 64;
+  uint32_t got;
+  uint32_t i;
+  clock_t t0;
+  double ns;
+  double busNs = length * 8 * 1e9 / 10e6;
+  uint32_t sum = 0;
+
+  reset(&h, spistreamFrameCs);
+  t0 = clock();
+  for (i = 0; i < frames; i++) {
+    // The receiver costs no CPU time; only its write index moves
+    written += length;
+    SPISTREAM_FrameEnd(&h, i);
+    SPISTREAM_FrameRead(&h, ring, frame, sizeof(frame), &got);
+    sum += frame[0];
+  }
+  ns = (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / frames;
+  printf("%u-byte frames: %.1f ns CPU per frame (frame end + copy out), "
+         "%.0f ns on the bus at 10 Mbps (check %u)\n",
+         (unsigned)length, ns, busNs, (unsigned)(sum & 0xFF));
+  check(h.overruns == 0 && h.frameCount == frames, "benchmark frames intact");
+}
+
+int main(void)
+{
+  testChipSelect();
+  testTimeout();
+  testQueueFull();
+  testRingOverrun();
+  testResponse();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
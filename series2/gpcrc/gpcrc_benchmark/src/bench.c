@@ -0,0 +1,242 @@
+/***************************************************************************//**
+ * @file bench.c
+ * @brief Micro-benchmark harness.  On the device, kernels are timed with
+ * DWT_CYCCNT with interrupts masked; with BENCH_HOST, with clock_gettime(),
+ * or the x86 time stamp counter with BENCH_HOST_RDTSC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#if defined(BENCH_HOST)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include "bench.h"
+
+#if !defined(BENCH_HOST)
+#include "em_device.h"
+#include "em_core.h"
+
+#define NOW()           (DWT->CYCCNT)
+#define UNIT            "cycles"
+#elif defined(BENCH_HOST_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+
+#define NOW()           ((uint32_t)__rdtsc())
+#define UNIT            "tsc"
+#else
+#include <time.h>
+
+static uint32_t hostNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+#define NOW()           hostNs()
+#define UNIT            "ns"
+#endif
+
+// Runs of an empty kernel used to measure the timing overhead
+#define OVERHEAD_RUNS   16
+
+static uint32_t overhead;
+static uint32_t samples[BENCH_MAX_REPS];
+
+static void empty(void)
+{
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Time one run of a kernel.  The counter is 32 bits wide, so a run can
+ *   last up to 2^32 units: 53 s at 80 MHz.
+ *****************************************************************************/
+static uint32_t timeRun(BENCH_Kernel_TypeDef run)
+{
+  uint32_t start, end;
+#if !defined(BENCH_HOST)
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+#endif
+  start = NOW();
+  run();
+  end = NOW();
+#if !defined(BENCH_HOST)
+  CORE_EXIT_CRITICAL();
+#endif
+  return end - start;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the counter and measure the cost of timing an empty kernel,
+ *   which BENCH_Run() takes off every sample.
+ *****************************************************************************/
+void BENCH_Init(void)
+{
+  uint32_t i, t;
+
+#if !defined(BENCH_HOST)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  overhead = UINT32_MAX;
+  for (i = 0; i < OVERHEAD_RUNS; i++) {
+    t = timeRun(empty);
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+}
+
+uint32_t BENCH_Now(void)
+{
+  return NOW();
+}
+
+uint32_t BENCH_Overhead(void)
+{
+  return overhead;
+}
+
+const char *BENCH_Unit(void)
+{
+  return UNIT;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Rate of the unit in Hz, to convert results to time; 0 for the time
+ *   stamp counter, whose rate is not known.
+ *****************************************************************************/
+uint32_t BENCH_Hz(void)
+{
+#if !defined(BENCH_HOST)
+  return SystemCoreClockGet();
+#elif defined(BENCH_HOST_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+  return 0;
+#else
+  return 1000000000UL;
+#endif
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Minimum, median and maximum of a set of samples, which are sorted in
+ *   place.  With an even count, the median is the upper middle sample.
+ *****************************************************************************/
+void BENCH_Stats(uint32_t *values, uint32_t count,
+                 BENCH_Result_TypeDef *result)
+{
+  uint32_t i, j, v;
+
+  // Insertion sort: the counts are small
+  for (i = 1; i < count; i++) {
+    v = values[i];
+    for (j = i; (j > 0) && (values[j - 1] > v); j--) {
+      values[j] = values[j - 1];
+    }
+    values[j] = v;
+  }
+  result->reps = count;
+  result->min = (count != 0) ? values[0] : 0;
+  result->median = (count != 0) ? values[count / 2] : 0;
+  result->max = (count != 0) ? values[count - 1] : 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run a case: the warm-up runs, then the timed runs.
+ *****************************************************************************/
+void BENCH_Run(const BENCH_Case_TypeDef *bcase,
+               const BENCH_Config_TypeDef *config,
+               BENCH_Result_TypeDef *result)
+{
+  uint32_t i, t;
+  uint32_t reps = (config->reps > BENCH_MAX_REPS) ? BENCH_MAX_REPS
+                  : config->reps;
+
+  for (i = 0; i < config->warmup; i++) {
+    bcase->run();
+  }
+  for (i = 0; i < reps; i++) {
+    t = timeRun(bcase->run);
+    samples[i] = (t > overhead) ? (t - overhead) : 0;
+  }
+  result->name = bcase->name;
+  result->bytes = bcase->bytes;
+  BENCH_Stats(samples, reps, result);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Column names of the lines from BENCH_Report().  Every line starts with
+ *   "bench," so that it can be picked out of other output.
+ *****************************************************************************/
+void BENCH_Header(BENCH_Emit_TypeDef emit)
+{
+  emit("bench,name,unit,hz,bytes,reps,min,median,max");
+}
+
+void BENCH_Report(const BENCH_Result_TypeDef *result, BENCH_Emit_TypeDef emit)
+{
+  char line[BENCH_LINE_SIZE];
+
+  snprintf(line, sizeof(line), "bench,%s,%s,%lu,%lu,%lu,%lu,%lu,%lu",
+           result->name, UNIT, (unsigned long)BENCH_Hz(),
+           (unsigned long)result->bytes, (unsigned long)result->reps,
+           (unsigned long)result->min, (unsigned long)result->median,
+           (unsigned long)result->max);
+  emit(line);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run a table of cases and report each one after the header.
+ *****************************************************************************/
+void BENCH_RunAll(const BENCH_Case_TypeDef *const *cases, uint32_t count,
+                  const BENCH_Config_TypeDef *config, BENCH_Emit_TypeDef emit)
+{
+  BENCH_Result_TypeDef result;
+  uint32_t i;
+
+  BENCH_Header(emit);
+  for (i = 0; i < count; i++) {
+    BENCH_Run(cases[i], config, &result);
+    BENCH_Report(&result, emit);
+  }
+}
@@ -0,0 +1,120 @@
+/***************************************************************************//**
+ * @file bench.h
+ * @brief Micro-benchmark harness: times registered kernels with the DWT
+ * cycle counter on the device, or the host clock on a PC, and reports the
+ * minimum, median and maximum as CSV lines.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Most timed runs per case
+#define BENCH_MAX_REPS      64
+
+/// Longest line passed to the emit function, without the newline
+#define BENCH_LINE_SIZE     112
+
+/// A kernel: one run of the code under test
+typedef void (*BENCH_Kernel_TypeDef)(void);
+
+/// A registered case
+typedef struct {
+  const char            *name;  ///< Short name, without commas
+  BENCH_Kernel_TypeDef  run;
+  uint32_t              bytes;  ///< Data processed per run, 0 if none
+} BENCH_Case_TypeDef;
+
+/*******************************************************************************
+ * Define a case and the body of its kernel:
+ *
+ *   BENCH_CASE(crcTable, "crc32_table", sizeof(buffer))
+ *   {
+ *     result = crcTable(buffer, sizeof(buffer));
+ *   }
+ *
+ * declares the const BENCH_Case_TypeDef crcTable, which can then be listed
+ * in the table passed to BENCH_RunAll().  Kernels should leave their
+ * results in volatile or global storage, so the compiler keeps the work.
+ ******************************************************************************/
+#define BENCH_CASE(id, name, bytes)                    \
+  static void id##Run(void);                           \
+  const BENCH_Case_TypeDef id = { (name), id##Run, (bytes) }; \
+  static void id##Run(void)
+
+/// How a case is run
+typedef struct {
+  uint32_t warmup;      ///< Untimed runs first, to fill caches and tables
+  uint32_t reps;        ///< Timed runs, up to BENCH_MAX_REPS
+} BENCH_Config_TypeDef;
+
+#define BENCH_CONFIG_DEFAULT  { 2, 31 }
+
+/// Statistics of one case, in BENCH_Unit() after the timing overhead
+typedef struct {
+  const char  *name;
+  uint32_t    bytes;
+  uint32_t    reps;
+  uint32_t    min;
+  uint32_t    median;
+  uint32_t    max;
+} BENCH_Result_TypeDef;
+
+/// Receives one line of output, without the newline
+typedef void (*BENCH_Emit_TypeDef)(const char *line);
+
+void BENCH_Init(void);
+uint32_t BENCH_Now(void);
+uint32_t BENCH_Overhead(void);
+const char *BENCH_Unit(void);
+uint32_t BENCH_Hz(void);
+void BENCH_Stats(uint32_t *values, uint32_t count,
+                 BENCH_Result_TypeDef *result);
+void BENCH_Run(const BENCH_Case_TypeDef *bcase,
+               const BENCH_Config_TypeDef *config,
+               BENCH_Result_TypeDef *result);
+void BENCH_Header(BENCH_Emit_TypeDef emit);
+void BENCH_Report(const BENCH_Result_TypeDef *result, BENCH_Emit_TypeDef emit);
+void BENCH_RunAll(const BENCH_Case_TypeDef *const *cases, uint32_t count,
+                  const BENCH_Config_TypeDef *config, BENCH_Emit_TypeDef emit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_H
@@ -0,0 +1,226 @@
+/***************************************************************************//**
+ * @file kernels.c
+ * @brief Data path kernels timed by the benchmark, registered with
+ * BENCH_CASE().  The GPCRC case is left out of host builds.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "kernels.h"
+
+#if !defined(BENCH_HOST)
+#include "em_cmu.h"
+#include "em_gpcrc.h"
+#endif
+
+// Reflected CRC-32 polynomial
+#define CRC32_POLY    0xEDB88320UL
+
+static uint32_t crcTable[256];
+static uint8_t block[KERNELS_BLOCK_SIZE];
+static uint8_t copy[KERNELS_BLOCK_SIZE];
+static uint32_t pdmFifo[KERNELS_PDM_SAMPLES];
+static int16_t left[KERNELS_PDM_SAMPLES];
+static int16_t right[KERNELS_PDM_SAMPLES];
+
+// Results of the last runs, kept so the kernels are not optimized out
+static volatile uint32_t crcBitwise, crcTableResult, crcGpcrc;
+
+/**************************************************************************//**
+ * @brief
+ *   CRC-32, one bit at a time: the smallest code, the reference.
+ *****************************************************************************/
+uint32_t KERNELS_CrcBitwise(const uint8_t *data, size_t len)
+{
+  uint32_t crc = 0xFFFFFFFFUL;
+  int bit;
+
+  while (len--) {
+    crc ^= *data++;
+    for (bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (CRC32_POLY & (0UL - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   CRC-32, a byte at a time from a 1 KB table, as in gpcrc_software.
+ *****************************************************************************/
+uint32_t KERNELS_CrcTable(const uint8_t *data, size_t len)
+{
+  uint32_t crc = 0xFFFFFFFFUL;
+
+  while (len--) {
+    crc = crcTable[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Split PDM FIFO words in the double 16-bit format into left and right
+ *   PCM samples, as the pdm_stereo examples do after each LDMA block.
+ *****************************************************************************/
+void KERNELS_PdmUnpack(const uint32_t *fifo,
+                       int16_t *leftOut,
+                       int16_t *rightOut,
+                       size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    leftOut[i] = (int16_t)(fifo[i] & 0xFFFF);
+    rightOut[i] = (int16_t)(fifo[i] >> 16);
+  }
+}
+
+#if !defined(BENCH_HOST)
+/**************************************************************************//**
+ * @brief
+ *   CRC-32 on the GPCRC, a word at a time.  The input bits are reversed,
+ *   so the reflected result is read from DATAREV.
+ *****************************************************************************/
+static uint32_t crcGpcrcRun(const uint8_t *data, size_t len)
+{
+  const uint32_t *words = (const uint32_t *)data;
+  size_t i;
+
+  GPCRC_Start(GPCRC);
+  for (i = 0; i < len / 4; i++) {
+    GPCRC_InputU32(GPCRC, words[i]);
+  }
+  return ~GPCRC_DataReverseGet(GPCRC);
+}
+
+static void gpcrcInit(void)
+{
+  GPCRC_Init_TypeDef init = GPCRC_INIT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_GPCRC, true);
+  init.initValue = 0xFFFFFFFFUL;
+  init.reverseBits = true;
+  GPCRC_Init(GPCRC, &init);
+}
+#endif
+
+BENCH_CASE(benchCopy, "memcpy_1k", KERNELS_BLOCK_SIZE)
+{
+  memcpy(copy, block, sizeof(copy));
+}
+
+BENCH_CASE(benchCrcBitwise, "crc32_bitwise_1k", KERNELS_BLOCK_SIZE)
+{
+  crcBitwise = KERNELS_CrcBitwise(block, sizeof(block));
+}
+
+BENCH_CASE(benchCrcTable, "crc32_table_1k", KERNELS_BLOCK_SIZE)
+{
+  crcTableResult = KERNELS_CrcTable(block, sizeof(block));
+}
+
+#if !defined(BENCH_HOST)
+BENCH_CASE(benchCrcGpcrc, "crc32_gpcrc_1k", KERNELS_BLOCK_SIZE)
+{
+  crcGpcrc = crcGpcrcRun(block, sizeof(block));
+}
+#endif
+
+BENCH_CASE(benchPdmUnpack, "pdm_unpack_64", sizeof(pdmFifo))
+{
+  KERNELS_PdmUnpack(pdmFifo, left, right, KERNELS_PDM_SAMPLES);
+}
+
+const BENCH_Case_TypeDef *const KERNELS_Cases[] = {
+  &benchCopy,
+  &benchCrcBitwise,
+  &benchCrcTable,
+#if !defined(BENCH_HOST)
+  &benchCrcGpcrc,
+#endif
+  &benchPdmUnpack,
+};
+
+const uint32_t KERNELS_Count = sizeof(KERNELS_Cases) / sizeof(KERNELS_Cases[0]);
+
+/**************************************************************************//**
+ * @brief
+ *   Build the CRC table, fill the input data and, on the device, set up
+ *   the GPCRC for CRC-32.
+ *****************************************************************************/
+void KERNELS_Init(void)
+{
+  uint32_t i, crc, state = 1;
+  int bit;
+
+  for (i = 0; i < 256; i++) {
+    crc = i;
+    for (bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (CRC32_POLY & (0UL - (crc & 1)));
+    }
+    crcTable[i] = crc;
+  }
+  // Pseudo-random data, the same on every run and target
+  for (i = 0; i < KERNELS_BLOCK_SIZE; i++) {
+    state = state * 1664525UL + 1013904223UL;
+    block[i] = (uint8_t)(state >> 24);
+  }
+  for (i = 0; i < KERNELS_PDM_SAMPLES; i++) {
+    pdmFifo[i] = ((i * 0x0101UL) << 16) | (0xFFFFUL - i);
+  }
+#if !defined(BENCH_HOST)
+  gpcrcInit();
+#endif
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Check that the kernels agree with each other after a benchmark run.
+ *
+ * @return
+ *   true if every CRC kernel gave the same result and the PDM samples were
+ *   unpacked.
+ *****************************************************************************/
+bool KERNELS_Check(void)
+{
+  bool ok = (crcBitwise == crcTableResult)
+            && (crcBitwise == KERNELS_CrcBitwise(block, sizeof(block)))
+            && (left[1] == (int16_t)0xFFFE) && (right[1] == 0x0101);
+
+#if !defined(BENCH_HOST)
+  ok = ok && (crcGpcrc == crcBitwise);
+#else
+  (void)crcGpcrc;
+#endif
+  return ok;
+}
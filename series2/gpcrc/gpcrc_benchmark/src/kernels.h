@@ -0,0 +1,74 @@
+/***************************************************************************//**
+ * @file kernels.h
+ * @brief Data path kernels timed by the benchmark: CRC-32 in software and
+ * on the GPCRC, PDM stereo unpacking and a memory copy baseline.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "bench.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Bytes per CRC and copy run
+#define KERNELS_BLOCK_SIZE    1024
+
+/// Stereo samples per PDM run, as in pdm_stereo_ldma
+#define KERNELS_PDM_SAMPLES   64
+
+/// CRC-32 (IEEE 802.3) of "123456789"
+#define KERNELS_CRC_CHECK     0xCBF43926UL
+
+extern const BENCH_Case_TypeDef *const KERNELS_Cases[];
+extern const uint32_t KERNELS_Count;
+
+void KERNELS_Init(void);
+uint32_t KERNELS_CrcBitwise(const uint8_t *data, size_t len);
+uint32_t KERNELS_CrcTable(const uint8_t *data, size_t len);
+void KERNELS_PdmUnpack(const uint32_t *fifo,
+                       int16_t *leftOut,
+                       int16_t *rightOut,
+                       size_t count);
+bool KERNELS_Check(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNELS_H
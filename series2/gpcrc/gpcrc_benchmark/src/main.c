@@ -0,0 +1,83 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Times CRC-32, PDM unpacking and memory copy kernels with the DWT
+ * cycle counter and prints the results over the VCOM as CSV lines.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "retargetserial.h"
+
+#include "bench.h"
+#include "kernels.h"
+
+static void emit(const char *line)
+{
+  printf("%s\n", line);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  BENCH_Config_TypeDef config = BENCH_CONFIG_DEFAULT;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  KERNELS_Init();
+  BENCH_Init();
+
+  printf("\nBenchmark, overhead %lu cycles\n",
+         (unsigned long)BENCH_Overhead());
+  BENCH_RunAll(KERNELS_Cases, KERNELS_Count, &config, emit);
+  printf("check %s\n", KERNELS_Check() ? "ok" : "FAILED");
+  RETARGET_SerialFlush();
+
+  while (1) {
+    EMU_EnterEM1();
+  }
+}
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file bench_sim.c
+ * @brief Builds the benchmark harness and kernels on a PC: checks the
+ * statistics and the kernels, then runs the same cases as the device and
+ * prints the same CSV lines, timed with clock_gettime().
+ *
+ *   gcc -std=c99 -O2 -DBENCH_HOST -I../src -o bench_sim bench_sim.c \
+ *       ../src/bench.c ../src/kernels.c
+ *   ./bench_sim
+ *
+ * Add -DBENCH_HOST_RDTSC on x86 to count time stamp counter ticks instead.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "kernels.h"
+
+static int failures;
+static unsigned int lines;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void emit(const char *line)
+{
+  unsigned int commas = 0;
+  const char *p;
+
+  for (p = line; *p != '\0'; p++) {
+    commas += (*p == ',');
+  }
+  check(strncmp(line, "bench,", 6) == 0, "lines start with bench,");
+  check(commas == 8, "nine columns");
+  puts(line);
+  lines++;
+}
+
+static void testStats(void)
+{
+  uint32_t odd[] = { 9, 3, 7, 1, 5 };
+  uint32_t even[] = { 4, 8, 2, 6 };
+  uint32_t one[] = { 42 };
+  BENCH_Result_TypeDef r;
+
+  BENCH_Stats(odd, 5, &r);
+  check((r.min == 1) && (r.median == 5) && (r.max == 9) && (r.reps == 5),
+        "odd count");
+  BENCH_Stats(even, 4, &r);
+  check((r.min == 2) && (r.median == 6) && (r.max == 8), "even count");
+  BENCH_Stats(one, 1, &r);
+  check((r.min == 42) && (r.median == 42) && (r.max == 42), "one sample");
+  BENCH_Stats(one, 0, &r);
+  check((r.min == 0) && (r.max == 0) && (r.reps == 0), "no samples");
+}
+
+static void testKernels(void)
+{
+  static const uint8_t digits[] = "123456789";
+  uint32_t fifo[2] = { 0x80007FFFUL, 0x0001FFFFUL };
+  int16_t l[2], r[2];
+
+  check(KERNELS_CrcBitwise(digits, 9) == KERNELS_CRC_CHECK, "bitwise CRC-32");
+  check(KERNELS_CrcTable(digits, 9) == KERNELS_CRC_CHECK, "table CRC-32");
+  check(KERNELS_CrcTable(digits, 0) == 0, "CRC-32 of nothing");
+  KERNELS_PdmUnpack(fifo, l, r, 2);
+  check((l[0] == 32767) && (r[0] == -32768) && (l[1] == -1) && (r[1] == 1),
+        "PDM unpack signs");
+}
+
+int main(void)
+{
+  BENCH_Config_TypeDef config = BENCH_CONFIG_DEFAULT;
+  BENCH_Config_TypeDef many = { 0, BENCH_MAX_REPS + 10 };
+  BENCH_Result_TypeDef r;
+
+  testStats();
+  KERNELS_Init();
+  testKernels();
+
+  BENCH_Init();
+  printf("overhead %lu %s\n", (unsigned long)BENCH_Overhead(), BENCH_Unit());
+  BENCH_Run(KERNELS_Cases[0], &many, &r);
+  check(r.reps == BENCH_MAX_REPS, "reps capped");
+  check((r.min <= r.median) && (r.median <= r.max), "ordered statistics");
+
+  BENCH_RunAll(KERNELS_Cases, KERNELS_Count, &config, emit);
+  check(lines == KERNELS_Count + 1, "a line per case and a header");
+  check(KERNELS_Check(), "kernels agree");
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
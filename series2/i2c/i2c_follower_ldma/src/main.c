@@ -0,0 +1,291 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief This project demonstrates an I2C follower that serves a virtual
+ * register map without handling individual bytes: the LDMA moves every
+ * received byte into a ring buffer and feeds read data from the map, and the
+ * CPU only runs at address matches and STOP conditions. It answers the same
+ * leader projects as i2c_follower.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_i2c.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "peripheral_sysrtc.h"
+#include "bsp.h"
+#include "mx25flash_spi.h"
+#include "regmap.h"
+
+// Defines
+#define I2C_ADDRESS                     0xE2
+#define REGMAP_SIZE                     32
+
+// LDMA channels serving RXDATA and TXDATA
+#define I2C_RX_LDMA_CH                  0
+#define I2C_TX_LDMA_CH                  1
+
+// I2C pins
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_8)
+#define I2C_SDA_PIN                     11
+#define I2C_SCL_PIN                     12
+#else
+#define I2C_SDA_PIN                     5
+#define I2C_SCL_PIN                     6
+#endif
+
+// Read-only status registers
+#define REG_ID                          0x10  // 0x5A
+#define REG_TRANSACTIONS                0x14  // 32-bit, little endian
+#define REG_CYCLES                      0x18  // Average ISR cycles/transaction
+#define REG_ERRORS                      0x1C  // Bus errors and rejected writes
+
+/*
+ * Register map: 0x00-0x0F can be written by the leader (the 10-byte buffer of
+ * the leader examples lives at 0x00), 0x10-0x1F is status maintained here.
+ */
+uint8_t registers[REGMAP_SIZE];
+
+static const REGMAP_Region_TypeDef regions[] = {
+  { 0x00, 16, true },
+  { 0x10, 16, false },
+};
+
+REGMAP_Handle_TypeDef regmap;
+
+// Interrupt cost, accumulated with the DWT cycle counter
+uint32_t isrCycles;
+uint32_t isrCount;
+
+/***************************************************************************//**
+ * @brief
+ *    Powers down the SPI flash on the radio board
+ ******************************************************************************/
+void powerDownSpiFlash(void)
+{
+  FlashStatus status;
+
+  MX25_init();
+  MX25_RSTEN();
+  MX25_RST(&status);
+  MX25_DP();
+  MX25_deinit();
+}
+
+/***************************************************************************//**
+ * @brief Enable clocks
+ ******************************************************************************/
+void initCMU(void)
+{
+  // Enable clocks to the I2C and GPIO
+  CMU_ClockEnable(cmuClock_I2C0, true);
+  CMU_ClockEnable(cmuClock_GPIO, true);
+}
+
+/***************************************************************************//**
+ * @brief GPIO initialization
+ ******************************************************************************/
+void initGPIO(void)
+{
+  // Configure LED0 and LED1 as output
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN, gpioModePushPull, 0);
+}
+
+/***************************************************************************//**
+ * @brief SYSRTC initialization
+ ******************************************************************************/
+void initSYSRTC(void)
+{
+  // Select LFRCO as source for SYSRTC clock branch
+  CMU_ClockSelectSet(cmuClock_SYSRTCCLK, cmuSelect_LFRCO);
+
+  // Enable SYSRTC clock
+  CMU_ClockEnable(cmuClock_SYSRTC, true);
+
+  // Setup SYSRTC parameters
+  sl_sysrtc_config_t sysrtcConfig = SYSRTC_CONFIG_DEFAULT;
+
+  // Initialize SYSRTC
+  sl_sysrtc_reset();
+  sl_sysrtc_init(&sysrtcConfig);
+
+  // Start the SYSRTC
+  sl_sysrtc_enable();
+}
+
+/***************************************************************************//**
+ * @brief Setup I2C as follower serving the register map
+ ******************************************************************************/
+void initI2C(void)
+{
+  I2C_Init_TypeDef i2cInit = I2C_INIT_DEFAULT;
+  REGMAP_Init_TypeDef regmapInit = {
+    registers,
+    REGMAP_SIZE,
+    regions,
+    sizeof(regions) / sizeof(regions[0]),
+    true                      // Auto-increment wraps to register 0
+  };
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+
+  // Configure to be addressable as follower
+  i2cInit.master = false;
+
+  // Enable GPIO pins for SDA and SCL
+  GPIO_PinModeSet(gpioPortA, I2C_SDA_PIN, gpioModeWiredAndPullUpFilter, 1);
+  GPIO_PinModeSet(gpioPortA, I2C_SCL_PIN, gpioModeWiredAndPullUpFilter, 1);
+
+  // Route I2C pins to GPIO
+  GPIO->I2CROUTE[0].SDAROUTE = (GPIO->I2CROUTE[0].SDAROUTE & ~_GPIO_I2C_SDAROUTE_MASK)
+                        | (gpioPortA << _GPIO_I2C_SDAROUTE_PORT_SHIFT
+                        | (I2C_SDA_PIN << _GPIO_I2C_SDAROUTE_PIN_SHIFT));
+  GPIO->I2CROUTE[0].SCLROUTE = (GPIO->I2CROUTE[0].SCLROUTE & ~_GPIO_I2C_SCLROUTE_MASK)
+                        | (gpioPortA << _GPIO_I2C_SCLROUTE_PORT_SHIFT
+                        | (I2C_SCL_PIN << _GPIO_I2C_SCLROUTE_PIN_SHIFT));
+  GPIO->I2CROUTE[0].ROUTEEN = GPIO_I2C_ROUTEEN_SDAPEN | GPIO_I2C_ROUTEEN_SCLPEN;
+
+  // Initialize the I2C
+  I2C_Init(I2C0, &i2cInit);
+
+  // Serve the register map with the LDMA
+  REGMAP_Init(&regmap, &regmapInit);
+  LDMA_Init(&ldmaInit);
+  REGMAP_FollowerStart(&regmap, I2C_ADDRESS, I2C_RX_LDMA_CH, I2C_TX_LDMA_CH);
+}
+
+/***************************************************************************//**
+ * @brief I2C Interrupt Handler; runs at address matches and STOP only
+ ******************************************************************************/
+void I2C0_IRQHandler(void)
+{
+  uint32_t start = DWT->CYCCNT;
+
+  REGMAP_FollowerIRQHandler(&regmap);
+
+  isrCycles += DWT->CYCCNT - start;
+  isrCount++;
+
+  // LED0 on during a transaction, LED1 on after a bus error
+  if (regmap.state != regmapStateIdle) {
+    GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  }
+  if (regmap.busErrors) {
+    GPIO_PinOutSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN);
+  }
+}
+
+/***************************************************************************//**
+ * @brief Store a 32-bit value in the register map, little endian
+ ******************************************************************************/
+static void setRegister32(uint8_t reg, uint32_t value)
+{
+  registers[reg]     = (uint8_t)value;
+  registers[reg + 1] = (uint8_t)(value >> 8);
+  registers[reg + 2] = (uint8_t)(value >> 16);
+  registers[reg + 3] = (uint8_t)(value >> 24);
+}
+
+/***************************************************************************//**
+ * @brief Refresh the read-only status registers between transactions
+ ******************************************************************************/
+static void updateStatusRegisters(void)
+{
+  uint32_t transactions = regmap.transactions;
+
+  setRegister32(REG_TRANSACTIONS, transactions);
+  setRegister32(REG_CYCLES, transactions ? isrCycles / transactions : 0);
+  setRegister32(REG_ERRORS, (regmap.busErrors << 16)
+                | (regmap.writesRejected & 0xFFFF));
+}
+
+/***************************************************************************//**
+ * @brief Main function
+ ******************************************************************************/
+int main(void)
+{
+  // Chip errata
+  CHIP_Init();
+
+  // Enable DC-DC converter
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+
+  // Enable voltage downscaling in energy modes EM2 and EM3
+  EMU_EM23Init_TypeDef em23Init = EMU_EM23INIT_DEFAULT;
+  em23Init.vScaleEM23Voltage = emuVScaleEM23_LowPower;
+  EMU_EM23Init(&em23Init);
+
+  // Power down the SPI flash
+  powerDownSpiFlash();
+
+  // Initialize the SYSRTC
+  initSYSRTC();
+
+  // Cycle counter for the interrupt cost
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  registers[REG_ID] = 0x5A;
+
+  // Initialize the I2C
+  initCMU();
+  initGPIO();
+  initI2C();
+
+  while (1) {
+    // The LDMA moves the data; keep it running in EM1 until the STOP
+    while (regmap.state != regmapStateIdle) {
+      EMU_EnterEM1();
+    }
+
+    // EM2 entry is a critical section and interrupts are disabled to prevent
+    // race conditions
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+
+    if (regmap.state == regmapStateIdle) {
+      // No reply can be in progress while idle
+      updateStatusRegisters();
+      GPIO_PinOutClear(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+
+      // Enter EM2; an I2C address match will wake up the device
+      EMU_EnterEM2(true);
+    }
+
+    CORE_EXIT_CRITICAL();
+  }
+}
@@ -0,0 +1,330 @@
+/***************************************************************************//**
+ * @file regmap.c
+ * @brief I2C follower virtual register map served by the LDMA.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "regmap.h"
+
+#if !defined(REGMAP_HOST)
+#include "em_device.h"
+#include "em_i2c.h"
+#include "em_ldma.h"
+
+// Every byte received from the bus, written by the LDMA only
+static volatile uint8_t rxRing[REGMAP_RX_RING];
+
+static LDMA_Descriptor_t rxDesc;
+static LDMA_Descriptor_t txDesc[2];
+static unsigned int rxCh;
+static unsigned int txCh;
+
+// Sent for reads past the end of a map that does not wrap
+static const uint8_t fillByte = 0xFF;
+
+/**************************************************************************//**
+ * @brief
+ *   Ring index the receive channel writes next.
+ *****************************************************************************/
+static uint32_t rxWriteIndex(void)
+{
+  return (LDMA->CH[rxCh].DST - (uint32_t)rxRing) % REGMAP_RX_RING;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Feed TXDATA from the register pointer on, wrapping or padding at the
+ *   end of the map.
+ *****************************************************************************/
+static void startTx(const REGMAP_Handle_TypeDef *h)
+{
+  LDMA_TransferCfg_t cfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_I2C0_TXBL);
+  uint16_t size = h->config.size;
+  uint16_t p = h->pointer;
+
+  txDesc[0] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(h->config.map + p, &I2C0->TXDATA,
+                                     size - p, 1);
+  if (h->config.wrap) {
+    // Whole map over and over
+    txDesc[1] = (LDMA_Descriptor_t)
+      LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(h->config.map, &I2C0->TXDATA, size, 0);
+  } else {
+    // 0xFF until the leader stops reading
+    txDesc[1] = (LDMA_Descriptor_t)
+      LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(&fillByte, &I2C0->TXDATA, 1, 0);
+  }
+  txDesc[0].xfer.doneIfs = 0;
+  txDesc[1].xfer.doneIfs = 0;
+  txDesc[0].xfer.ignoreSrec = 0;
+  txDesc[1].xfer.ignoreSrec = 0;
+
+  LDMA_StartTransfer(txCh, &cfg, p < size ? &txDesc[0] : &txDesc[1]);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Abort the reply and drop bytes already loaded into the transmitter.
+ *****************************************************************************/
+static void stopTx(void)
+{
+  LDMA_StopTransfer(txCh);
+  I2C0->CMD = I2C_CMD_CLEARTX;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Serve the register map on I2C0.
+ *
+ * @details
+ *   I2C0 must be initialized as a follower and LDMA_Init() called. Received
+ *   bytes are acknowledged by the I2C and copied into the receive ring by
+ *   rxChannel; replies are fed from the map by txChannel. Only the address
+ *   match, STOP and bus error interrupts are enabled.
+ *****************************************************************************/
+void REGMAP_FollowerStart(REGMAP_Handle_TypeDef *handle,
+                          uint8_t address,
+                          unsigned int rxChannel,
+                          unsigned int txChannel)
+{
+  LDMA_TransferCfg_t cfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_I2C0_RXDATAV);
+
+  (void)handle;
+  rxCh = rxChannel;
+  txCh = txChannel;
+
+  // Receive into the ring forever without interrupts
+  rxDesc = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(&I2C0->RXDATA, rxRing, REGMAP_RX_RING, 0);
+  rxDesc.xfer.doneIfs = 0;
+  rxDesc.xfer.ignoreSrec = 0;
+  LDMA_StartTransfer(rxCh, &cfg, &rxDesc);
+
+  I2C_SlaveAddressSet(I2C0, address);
+  I2C_SlaveAddressMaskSet(I2C0, 0xFE); // must match exact address
+
+  // Acknowledge the address and every data byte in hardware
+  I2C0->CTRL_SET = I2C_CTRL_AUTOACK;
+
+  I2C_IntClear(I2C0, _I2C_IF_MASK);
+  I2C_IntEnable(I2C0, I2C_IEN_ADDR | I2C_IEN_SSTOP | I2C_IEN_BUSERR
+                | I2C_IEN_ARBLOST);
+  NVIC_ClearPendingIRQ(I2C0_IRQn);
+  NVIC_EnableIRQ(I2C0_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Call from I2C0_IRQHandler().
+ *
+ * @note
+ *   A transaction may complete before its address match is handled, but the
+ *   STOP of one transaction must be handled before the next one starts.
+ *****************************************************************************/
+void REGMAP_FollowerIRQHandler(REGMAP_Handle_TypeDef *handle)
+{
+  uint32_t pending = I2C0->IF & (I2C_IF_ADDR | I2C_IF_SSTOP
+                                 | I2C_IF_BUSERR | I2C_IF_ARBLOST);
+
+  I2C_IntClear(I2C0, pending);
+
+  if (pending & I2C_IF_ADDR) {
+    // Let the receive channel move the address byte into the ring
+    while (I2C0->STATUS & I2C_STATUS_RXDATAV);
+
+    stopTx();
+    if (REGMAP_Start(handle, rxRing, REGMAP_RX_RING, rxWriteIndex())) {
+      startTx(handle);
+    }
+  }
+
+  if (pending & (I2C_IF_SSTOP | I2C_IF_BUSERR | I2C_IF_ARBLOST)) {
+    if (pending & (I2C_IF_BUSERR | I2C_IF_ARBLOST)) {
+      handle->busErrors++;
+    }
+    stopTx();
+    REGMAP_Stop(handle, rxRing, REGMAP_RX_RING, rxWriteIndex());
+  }
+}
+#endif // !REGMAP_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Set up the register map.
+ *
+ * @details
+ *   Registers not covered by a writable region are read-only. All registers
+ *   can be read.
+ *****************************************************************************/
+void REGMAP_Init(REGMAP_Handle_TypeDef *handle,
+                 const REGMAP_Init_TypeDef *init)
+{
+  uint16_t r, i;
+
+  memset(handle, 0, sizeof(*handle));
+  handle->config = *init;
+  if (handle->config.size > REGMAP_MAX_SIZE) {
+    handle->config.size = REGMAP_MAX_SIZE;
+  }
+
+  for (r = 0; r < init->regionCount; r++) {
+    const REGMAP_Region_TypeDef *region = &init->regions[r];
+
+    for (i = region->start;
+         i < region->start + region->length && i < handle->config.size;
+         i++) {
+      if (region->writable) {
+        handle->writable[i / 32] |= 1UL << (i % 32);
+      } else {
+        handle->writable[i / 32] &= ~(1UL << (i % 32));
+      }
+    }
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Handle one byte received in a write transaction.
+ *****************************************************************************/
+static void writeByte(REGMAP_Handle_TypeDef *h, uint8_t value)
+{
+  uint16_t size = h->config.size;
+
+  if (h->state == regmapStatePointer) {
+    h->pointer = h->config.wrap ? value % size : value;
+    h->lastWriteStart = h->pointer;
+    h->lastWriteCount = 0;
+    h->state = regmapStateWrite;
+    return;
+  }
+  if (h->state != regmapStateWrite) {
+    return;
+  }
+
+  if (h->pointer < size
+      && (h->writable[h->pointer / 32] & (1UL << (h->pointer % 32)))) {
+    h->config.map[h->pointer] = value;
+    h->bytesWritten++;
+    h->lastWriteCount++;
+  } else {
+    h->writesRejected++;
+  }
+
+  // Auto-increment; without wrap the pointer stays past the end
+  if (h->pointer < size) {
+    h->pointer++;
+  }
+  if (h->config.wrap && h->pointer == size) {
+    h->pointer = 0;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Handle the received bytes up to, but not including, end.
+ *****************************************************************************/
+static void parse(REGMAP_Handle_TypeDef *h,
+                  const volatile uint8_t *ring,
+                  uint32_t ringSize,
+                  uint32_t end)
+{
+  while (h->readIndex != end) {
+    writeByte(h, ring[h->readIndex]);
+    h->readIndex = (h->readIndex + 1) % ringSize;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Handle an address match (START or repeated START).
+ *
+ * @details
+ *   The receive ring holds every byte received from the bus, including the
+ *   address bytes. After a STOP the address byte is the next unparsed byte,
+ *   and any bytes behind it are write data that arrived before this call.
+ *   After a repeated START the address byte is the newest byte, because a
+ *   read stretches the clock until the transmit data is set up; the bytes
+ *   before it complete the preceding write.
+ *
+ * @param[in] writeIndex
+ *   Ring index the receive channel writes next.
+ *
+ * @return
+ *   true if the leader reads; the reply starts at handle->pointer.
+ *****************************************************************************/
+bool REGMAP_Start(REGMAP_Handle_TypeDef *handle,
+                  const volatile uint8_t *ring,
+                  uint32_t ringSize,
+                  uint32_t writeIndex)
+{
+  uint32_t addressIndex;
+
+  writeIndex %= ringSize;
+  if (handle->readIndex == writeIndex) {
+    return false;
+  }
+
+  if (handle->state == regmapStateIdle) {
+    addressIndex = handle->readIndex;
+  } else {
+    addressIndex = (writeIndex + ringSize - 1) % ringSize;
+    parse(handle, ring, ringSize, addressIndex);
+  }
+  handle->readIndex = (addressIndex + 1) % ringSize;
+  handle->transactions++;
+
+  if (ring[addressIndex] & 1) {
+    handle->state = regmapStateRead;
+    return true;
+  }
+
+  handle->state = regmapStatePointer;
+  parse(handle, ring, ringSize, writeIndex);
+  return false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Handle a STOP condition or a bus error; stores the remaining write data.
+ *****************************************************************************/
+void REGMAP_Stop(REGMAP_Handle_TypeDef *handle,
+                 const volatile uint8_t *ring,
+                 uint32_t ringSize,
+                 uint32_t writeIndex)
+{
+  parse(handle, ring, ringSize, writeIndex % ringSize);
+  handle->state = regmapStateIdle;
+}
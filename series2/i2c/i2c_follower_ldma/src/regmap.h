@@ -0,0 +1,115 @@
+/***************************************************************************//**
+ * @file regmap.h
+ * @brief I2C follower virtual register map served by the LDMA.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef REGMAP_H
+#define REGMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Largest register map; register pointers are 8 bits
+#define REGMAP_MAX_SIZE     256
+
+/// Bytes received between two START/STOP conditions must fit in this ring
+#define REGMAP_RX_RING      64
+
+/// Range of registers with the same access
+typedef struct {
+  uint16_t start;
+  uint16_t length;
+  bool     writable;   ///< Leader writes are stored; otherwise dropped
+} REGMAP_Region_TypeDef;
+
+/// Register map configuration
+typedef struct {
+  uint8_t                     *map;          ///< Register contents
+  uint16_t                    size;          ///< Bytes in map (<= 256)
+  const REGMAP_Region_TypeDef *regions;      ///< Writable ranges etc.
+  uint8_t                     regionCount;
+  bool                        wrap;          ///< Auto-increment wraps to 0
+} REGMAP_Init_TypeDef;
+
+/// Protocol state between START and STOP
+typedef enum {
+  regmapStateIdle,     ///< Between transactions
+  regmapStatePointer,  ///< Write addressed; next byte is the register pointer
+  regmapStateWrite,    ///< Following bytes are written from the pointer on
+  regmapStateRead      ///< Leader reads from the pointer on
+} REGMAP_State_TypeDef;
+
+/// Register map state; all fields are read-only for the application
+typedef struct {
+  REGMAP_Init_TypeDef  config;
+  uint32_t             writable[REGMAP_MAX_SIZE / 32];
+  REGMAP_State_TypeDef state;
+  uint16_t             pointer;        ///< Current register pointer
+  uint32_t             readIndex;      ///< Next receive ring entry to parse
+
+  uint16_t lastWriteStart;             ///< First register of the last write
+  uint16_t lastWriteCount;             ///< Registers changed by it
+  uint32_t transactions;               ///< Address matches
+  uint32_t bytesWritten;
+  uint32_t writesRejected;             ///< Writes to read-only or no register
+  uint32_t busErrors;                  ///< Transactions ended by a bus error
+} REGMAP_Handle_TypeDef;
+
+void REGMAP_Init(REGMAP_Handle_TypeDef *handle,
+                 const REGMAP_Init_TypeDef *init);
+bool REGMAP_Start(REGMAP_Handle_TypeDef *handle,
+                  const volatile uint8_t *ring,
+                  uint32_t ringSize,
+                  uint32_t writeIndex);
+void REGMAP_Stop(REGMAP_Handle_TypeDef *handle,
+                 const volatile uint8_t *ring,
+                 uint32_t ringSize,
+                 uint32_t writeIndex);
+
+#if !defined(REGMAP_HOST)
+void REGMAP_FollowerStart(REGMAP_Handle_TypeDef *handle,
+                          uint8_t address,
+                          unsigned int rxChannel,
+                          unsigned int txChannel);
+void REGMAP_FollowerIRQHandler(REGMAP_Handle_TypeDef *handle);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REGMAP_H
@@ -0,0 +1,383 @@
+/***************************************************************************//**
+ * @file regmap_sim.c
+ * @brief Host protocol test and benchmark for the I2C follower register map.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DREGMAP_HOST -I../src -o regmap_sim regmap_sim.c ../src/regmap.c
+ *   ./regmap_sim
+ *
+ * The follower is modeled as the hardware sees it: every byte the leader
+ * sends, address bytes included, is appended to the receive ring as the
+ * LDMA would, REGMAP_Start() runs on each address match and REGMAP_Stop()
+ * on each STOP, and read data is taken from the map the way the transmit
+ * descriptors walk it. Transactions are checked against a plain reference
+ * model of the register map, both for fixed cases and for random traffic
+ * with and without wrap. The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "regmap.h"
+
+#define ADDRESS       0xE2
+#define MAP_SIZE      32
+
+static uint8_t map[MAP_SIZE];
+
+// 0x00-0x0F read/write, 0x10-0x1F read-only, as in the example
+static const REGMAP_Region_TypeDef regions[] = {
+  { 0x00, 16, true },
+  { 0x10, 16, false },
+};
+
+// Follower model: receive ring as filled by the LDMA
+static REGMAP_Handle_TypeDef h;
+static uint8_t ring[REGMAP_RX_RING];
+static uint32_t written;
+
+// Reference model
+static uint8_t refMap[MAP_SIZE];
+static uint16_t refPointer;
+static uint32_t refWritten, refRejected;
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void init(bool wrap)
+{
+  REGMAP_Init_TypeDef cfg = { map, MAP_SIZE, regions, 2, false };
+  uint32_t i;
+
+  cfg.wrap = wrap;
+  for (i = 0; i < MAP_SIZE; i++) {
+    map[i] = refMap[i] = (uint8_t)(0xA0 + i);
+  }
+  REGMAP_Init(&h, &cfg);
+  written = 0;
+  refPointer = 0;
+  refWritten = refRejected = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Bus events as the follower sees them.
+ ******************************************************************************/
+static void busByte(uint8_t b)
+{
+  ring[written % REGMAP_RX_RING] = b;
+  written++;
+}
+
+static bool busStart(void)
+{
+  return REGMAP_Start(&h, ring, REGMAP_RX_RING, written);
+}
+
+static void busStop(void)
+{
+  REGMAP_Stop(&h, ring, REGMAP_RX_RING, written);
+}
+
+// Byte k of a reply, as the transmit descriptors produce it
+static uint8_t txByte(uint32_t k)
+{
+  uint32_t p = h.pointer + k;
+
+  if (p < h.config.size) {
+    return map[p];
+  }
+  return h.config.wrap ? map[p % h.config.size] : 0xFF;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reference model of the same register map.
+ ******************************************************************************/
+static bool refWritable(uint16_t reg)
+{
+  return reg < 16;
+}
+
+static void refWrite(uint8_t reg, const uint8_t *data, uint32_t n)
+{
+  uint32_t i;
+
+  refPointer = h.config.wrap ? reg % MAP_SIZE : reg;
+  for (i = 0; i < n; i++) {
+    if (refPointer < MAP_SIZE && refWritable(refPointer)) {
+      refMap[refPointer] = data[i];
+      refWritten++;
+    } else {
+      refRejected++;
+    }
+    if (refPointer < MAP_SIZE) {
+      refPointer++;
+    }
+    if (h.config.wrap && refPointer == MAP_SIZE) {
+      refPointer = 0;
+    }
+  }
+}
+
+static uint8_t refRead(uint32_t k)
+{
+  uint32_t p = refPointer + k;
+
+  if (p < MAP_SIZE) {
+    return refMap[p];
+  }
+  return h.config.wrap ? refMap[p % MAP_SIZE] : 0xFF;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Leader transactions. A late write has all its bytes received before the
+ *   address match interrupt runs.
+ ******************************************************************************/
+static void leaderWrite(uint8_t reg, const uint8_t *data, uint32_t n, int late)
+{
+  uint32_t i;
+
+  busByte(ADDRESS);
+  if (!late) {
+    check(!busStart(), "write seen as read");
+  }
+  busByte(reg);
+  for (i = 0; i < n; i++) {
+    busByte(data[i]);
+  }
+  if (late) {
+    check(!busStart(), "late write seen as read");
+  }
+  busStop();
+  refWrite(reg, data, n);
+}
+
+// Register pointer write, repeated START, read
+static void leaderRead(uint8_t reg, uint8_t *out, uint32_t n)
+{
+  uint32_t i;
+
+  busByte(ADDRESS);
+  check(!busStart(), "pointer write seen as read");
+  busByte(reg);
+  busByte(ADDRESS | 1);
+  check(busStart(), "repeated start not seen as read");
+  for (i = 0; i < n; i++) {
+    out[i] = txByte(i);
+  }
+  busStop();
+  refWrite(reg, NULL, 0);
+}
+
+// Read from the current register pointer
+static void leaderReadCurrent(uint8_t *out, uint32_t n)
+{
+  uint32_t i;
+
+  busByte(ADDRESS | 1);
+  check(busStart(), "read not seen as read");
+  for (i = 0; i < n; i++) {
+    out[i] = txByte(i);
+  }
+  busStop();
+}
+
+static void checkRead(const uint8_t *out, uint32_t n, const char *what)
+{
+  uint32_t i;
+
+  for (i = 0; i < n; i++) {
+    if (out[i] != refRead(i)) {
+      printf("  %s: byte %lu is 0x%02X, expected 0x%02X\n", what,
+             (unsigned long)i, out[i], refRead(i));
+      failures++;
+      return;
+    }
+  }
+}
+
+static void checkState(const char *what)
+{
+  check(memcmp(map, refMap, MAP_SIZE) == 0, what);
+  check(h.bytesWritten == refWritten && h.writesRejected == refRejected,
+        "write counters");
+  check(h.state == regmapStateIdle, "not idle after STOP");
+}
+
+static void fixedCases(void)
+{
+  static const uint8_t data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+  uint8_t out[40];
+
+  printf("fixed cases:\n");
+  init(true);
+
+  // The 10-byte read, increment, write back cycle of the leader examples
+  leaderRead(0, out, 10);
+  checkRead(out, 10, "initial read");
+  leaderWrite(0, data, 10, 0);
+  leaderRead(0, out, 10);
+  checkRead(out, 10, "read back");
+  check(out[9] == 10, "write not stored");
+  checkState("read/write cycle");
+
+  // Write across the read/write to read-only boundary
+  leaderWrite(0x0E, data, 4, 0);
+  checkState("write into read-only");
+  check(h.writesRejected == 2 && h.lastWriteStart == 0x0E
+        && h.lastWriteCount == 2, "read-only bytes not rejected");
+
+  // Auto-increment read across regions and around the end of the map
+  leaderRead(0x1C, out, 40);
+  checkRead(out, 40, "wrapping read");
+
+  // Write that wraps from the end of the map to register 0
+  leaderWrite(0x1F, data, 3, 0);
+  checkState("wrapping write");
+  check(map[0] == 2 && map[1] == 3, "wrapping write not stored");
+
+  // Pointer left after a write, then a read from the current pointer
+  leaderWrite(0x04, data, 2, 0);
+  leaderReadCurrent(out, 4);
+  check(out[0] == map[6], "current pointer read");
+
+  // All bytes received before the address match is handled
+  leaderWrite(0x08, data + 4, 5, 1);
+  checkState("late address match");
+
+  // Without wrap, reads past the end return 0xFF and writes are dropped
+  init(false);
+  leaderRead(0x1E, out, 6);
+  checkRead(out, 6, "read past the end");
+  check(out[2] == 0xFF, "no padding past the end");
+  leaderWrite(0xF0, data, 3, 0);
+  checkState("write past the end");
+  check(h.writesRejected == 3, "writes past the end not rejected");
+}
+
+static uint32_t rnd(void)
+{
+  static uint32_t seed = 1;
+
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+static void randomTraffic(bool wrap)
+{
+  uint8_t data[48], out[64];
+  uint32_t i, k, n;
+
+  init(wrap);
+  for (i = 0; i < 20000; i++) {
+    uint8_t reg = (uint8_t)(rnd() % (wrap ? 256 : 48));
+
+    n = rnd() % sizeof(data);
+    for (k = 0; k < n; k++) {
+      data[k] = (uint8_t)rnd();
+    }
+    switch (rnd() % 3) {
+      case 0:
+        leaderWrite(reg, data, n, rnd() % 4 == 0);
+        break;
+      case 1:
+        leaderRead(reg, out, n);
+        checkRead(out, n, "random read");
+        break;
+      default:
+        leaderReadCurrent(out, n);
+        checkRead(out, n, "random current read");
+        break;
+    }
+    if (failures) {
+      break;
+    }
+  }
+  checkState(wrap ? "random traffic, wrap" : "random traffic, no wrap");
+  printf("random traffic (%s): %lu transactions, %lu bytes written, "
+         "%lu rejected\n", wrap ? "wrap" : "no wrap",
+         (unsigned long)h.transactions, (unsigned long)h.bytesWritten,
+         (unsigned long)h.writesRejected);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   CPU time spent in REGMAP per transaction, and interrupts per transaction
+ *   compared with servicing every byte in the I2C interrupt handler.
+ ******************************************************************************/
+static void benchmark(void)
+{
+  static const uint8_t data[8] = { 0 };
+  uint8_t out[8];
+  uint32_t i, loops = 2000000;
+  clock_t start;
+  double ns;
+
+  init(true);
+  start = clock();
+  for (i = 0; i < loops; i++) {
+    leaderWrite(0, data, sizeof(data), 0);
+  }
+  ns = (double)(clock() - start) / CLOCKS_PER_SEC * 1e9 / loops;
+  printf("8-byte write: %.1f ns per transaction (model included), "
+         "2 interrupts instead of %u\n", ns, 2 + 1 + (unsigned)sizeof(data));
+
+  start = clock();
+  for (i = 0; i < loops; i++) {
+    leaderRead(0, out, sizeof(out));
+  }
+  ns = (double)(clock() - start) / CLOCKS_PER_SEC * 1e9 / loops;
+  printf("8-byte read:  %.1f ns per transaction (model included), "
+         "3 interrupts instead of %u\n", ns, 3 + 1 + (unsigned)sizeof(out));
+}
+
+int main(void)
+{
+  fixedCases();
+  randomTraffic(true);
+  randomTraffic(false);
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,93 @@
+/***************************************************************************//**
+ * @file i2c_leader_dma_pins.h
+ * @brief I2C pins of each board supported by the example.  The table has
+ * no device dependencies, so tools/pins_check.c checks it on a PC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef I2C_LEADER_DMA_PINS_H
+#define I2C_LEADER_DMA_PINS_H
+
+#include "bsp_route.h"
+
+/*
+ * SCL and SDA are EXP header pins 15 and 16, where the Si7021 sensor of
+ * the mainboard and its pull-ups are.  SENSOR_ENABLE powers them.
+ *
+ * BRD4181A does not connect EXP 15/16 or SENSOR_ENABLE, so xG21 uses EXP
+ * header pins 4 and 6 with external pull-ups.  BRD4270B does not connect
+ * SENSOR_ENABLE either.
+ *
+ *                         SCL      SDA      SENSOR_ENABLE
+ */
+#define I2C_BOARD_XG21    ((C, 0), (C, 1), (NONE, 0))
+#define I2C_BOARD_XG22    ((B, 2), (B, 3), (C, 7))
+#define I2C_BOARD_XG23    ((C, 5), (C, 7), (C, 9))
+#define I2C_BOARD_XG24    ((C, 5), (C, 7), (D, 3))
+#define I2C_BOARD_XG25    ((B, 2), (B, 3), (NONE, 0))
+#define I2C_BOARD_XG27    ((B, 2), (B, 3), (C, 7))
+#define I2C_BOARD_XG28    ((C, 5), (C, 7), (C, 11))
+
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG)              \
+  && (_SILICON_LABS_32B_SERIES_2_CONFIG == 6                \
+      || _SILICON_LABS_32B_SERIES_2_CONFIG > 8)
+#error "No I2C pins for this device in i2c_leader_dma_pins.h"
+#endif
+
+// Checks of a row: real, distinct pins
+#define I2C_BOARD_CHECK(dev)                                                  \
+  BSP_CHECK(i2c_##dev##_scl_valid,                                            \
+            BSP_PIN_VALID(BSP_COLUMN(0, I2C_BOARD_##dev)));                   \
+  BSP_CHECK(i2c_##dev##_sda_valid,                                            \
+            BSP_PIN_VALID(BSP_COLUMN(1, I2C_BOARD_##dev)));                   \
+  BSP_CHECK(i2c_##dev##_enable_valid,                                         \
+            !BSP_HAS_PIN(BSP_COLUMN(2, I2C_BOARD_##dev))                      \
+            || BSP_PIN_VALID(BSP_COLUMN(2, I2C_BOARD_##dev)));                \
+  BSP_CHECK(i2c_##dev##_scl_sda_differ,                                       \
+            BSP_PIN_DIFFERENT(BSP_COLUMN(0, I2C_BOARD_##dev),                 \
+                              BSP_COLUMN(1, I2C_BOARD_##dev)));               \
+  BSP_CHECK(i2c_##dev##_enable_differs,                                       \
+            BSP_PIN_DIFFERENT(BSP_COLUMN(0, I2C_BOARD_##dev),                 \
+                              BSP_COLUMN(2, I2C_BOARD_##dev))                 \
+            && BSP_PIN_DIFFERENT(BSP_COLUMN(1, I2C_BOARD_##dev),              \
+                                 BSP_COLUMN(2, I2C_BOARD_##dev)))
+
+// Every row is checked in every build, whichever device it is for
+I2C_BOARD_CHECK(XG21);
+I2C_BOARD_CHECK(XG22);
+I2C_BOARD_CHECK(XG23);
+I2C_BOARD_CHECK(XG24);
+I2C_BOARD_CHECK(XG25);
+I2C_BOARD_CHECK(XG27);
+I2C_BOARD_CHECK(XG28);
+
+#endif // I2C_LEADER_DMA_PINS_H
@@ -1,5 +1,5 @@
 /***************************************************************************//**
- * @file main_xg28.c
+ * @file main.c
  *
  * @brief This example demonstrates I2C leader operation with DMA.
  *        Having the LDMA handle the movement of data between the I2C
@@ -19,8 +19,8 @@
  * written back to the follower and read again to verify that the
  * updated data was correctly received.
  *
- * Upon success, LED0 is toggled and the device re-enters the while
- * loop, waiting for button 0 to run the test again.  If there is an
+ * Upon success, LED0 (LED1 on EFR32xG27) is toggled and the device
+ * re-enters the while loop, waiting for button 0 to run the test again.  If there is an
  * I2C error or if the verification of the received data fails, LED1 is
  * turned on and the code halts at a breakpoint so that the received
  * data and I2C status and interrupt flag registers can be examined.
@@ -67,14 +67,24 @@
 #include "em_ldma.h"
 
 #include "bsp.h"
-
-// I2C pins (SCL = PC5/EXP15; SDA = PC7/EXP16)
-#define I2C_SCL_PORT            gpioPortC
-#define I2C_SCL_PIN             5
-#define I2C_SDA_PORT            gpioPortC
-#define I2C_SDA_PIN             7
-#define I2C_DOMAIN_POWER_PORT   gpioPortC
-#define I2C_DOMAIN_POWER_PIN    11
+#include "i2c_leader_dma_pins.h"
+
+// I2C pins of the board being built
+#define I2C_SCL                 BSP_COLUMN(0, BSP_BOARD(I2C_BOARD_))
+#define I2C_SDA                 BSP_COLUMN(1, BSP_BOARD(I2C_BOARD_))
+#define I2C_DOMAIN_POWER        BSP_COLUMN(2, BSP_BOARD(I2C_BOARD_))
+
+/*
+ * PB0 and LED0 share a GPIO on the EFR32xG27 radio board (BRD4194A), so
+ * LED1 shows the passes there.  Its polarity is reversed.
+ */
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_7)
+#define LED_PASS_PORT           BSP_GPIO_LED1_PORT
+#define LED_PASS_PIN            BSP_GPIO_LED1_PIN
+#else
+#define LED_PASS_PORT           BSP_GPIO_LED0_PORT
+#define LED_PASS_PIN            BSP_GPIO_LED0_PIN
+#endif
 
 // Address of the I2C follower device (left-shifted to bits [7:1])
 #define I2C_FOLLOWER_ADDRESS    0xE2
@@ -105,11 +115,21 @@ volatile I2C_TransferReturn_TypeDef i2c_xferStatus;
  ******************************************************************************/
 void initGPIO(void)
 {
+  /*
+   * Note: On EFR32xG21 devices, CMU_ClockEnable() calls have no effect
+   * as clocks are enabled/disabled on-demand in response to peripheral
+   * requests.
+   */
   CMU_ClockEnable(cmuClock_GPIO, true);
 
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_7)
+  // Configure LED1 as an output (polarities reversed on BRD4194A)
+  GPIO_PinModeSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN, gpioModePushPull, 1);
+#else
   // Configure LED0 and LED1 as outputs
   GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
   GPIO_PinModeSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN, gpioModePushPull, 0);
+#endif
 
   // Configure PB0 as input and interrupt
   GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPull, 1);
@@ -140,23 +160,26 @@ void initI2C(void)
   // Use default settings
   I2C_Init_TypeDef i2cInit = I2C_INIT_DEFAULT;
 
+#if BSP_HAS_PIN(I2C_DOMAIN_POWER)
   /*
    * Power up the Si7021 RHT sensor domain on the mainboard.  This
    * also powers up the sensor's local SCL and SDA pull-ups, which
    * eliminates the need to jumper resistors to the EXP header pins.
    */
-  GPIO_PinModeSet(I2C_DOMAIN_POWER_PORT, I2C_DOMAIN_POWER_PIN, gpioModePushPull, 1);
+  GPIO_PinModeSet(BSP_PORT(I2C_DOMAIN_POWER), BSP_PIN(I2C_DOMAIN_POWER),
+                  gpioModePushPull, 1);
+#endif
 
   // Configure SCL and SDA for open-drain operation
-  GPIO_PinModeSet(I2C_SCL_PORT, I2C_SCL_PIN, gpioModeWiredAndPullUpFilter, 1);
-  GPIO_PinModeSet(I2C_SDA_PORT, I2C_SDA_PIN, gpioModeWiredAndPullUpFilter, 1);
+  GPIO_PinModeSet(BSP_PORT(I2C_SCL), BSP_PIN(I2C_SCL),
+                  gpioModeWiredAndPullUpFilter, 1);
+  GPIO_PinModeSet(BSP_PORT(I2C_SDA), BSP_PIN(I2C_SDA),
+                  gpioModeWiredAndPullUpFilter, 1);
 
   // Route I2C pins to GPIO
-  GPIO->I2CROUTE[0].SCLROUTE = (I2C_SCL_PORT << _GPIO_I2C_SCLROUTE_PORT_SHIFT
-                             | (I2C_SCL_PIN << _GPIO_I2C_SCLROUTE_PIN_SHIFT));
-  GPIO->I2CROUTE[0].SDAROUTE = (I2C_SDA_PORT << _GPIO_I2C_SDAROUTE_PORT_SHIFT
-                             | (I2C_SDA_PIN  << _GPIO_I2C_SDAROUTE_PIN_SHIFT));
-  GPIO->I2CROUTE[0].ROUTEEN = GPIO_I2C_ROUTEEN_SCLPEN | GPIO_I2C_ROUTEEN_SDAPEN;
+  BSP_ROUTE_SET(I2C0, SCL, I2C_SCL);
+  BSP_ROUTE_SET(I2C0, SDA, I2C_SDA);
+  GPIO->BSP_GPIO_ROUTE(I2C0).ROUTEEN = GPIO_I2C_ROUTEEN_SCLPEN | GPIO_I2C_ROUTEEN_SDAPEN;
 
   // Initialize the I2C
   I2C_Init(I2C0, &i2cInit);
@@ -525,8 +548,8 @@ int main(void)
       }
       else
       {
-        // Toggle LED0 on each pass
-        GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+        // Toggle LED0 (LED1 on EFR32xG27) on each pass
+        GPIO_PinOutToggle(LED_PASS_PORT, LED_PASS_PIN);
 
         // Transmission complete; set to run test again
         i2c_startTx = false;
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file pins_check.c
+ * @brief Host check of the pin table of every board.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -Wall -I../src -I../../../kit/common/bsp -o pins_check \
+ *       pins_check.c
+ *   ./pins_check
+ *
+ * Including the table checks every row at compile time: a pin that does not
+ * exist or is used twice fails the build.  The program then resolves each
+ * row the way main.c does on the device, with the route register layout of
+ * the Series 2 GPIO, and prints the pins.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "i2c_leader_dma_pins.h"
+
+// Route register fields, as in the device headers
+#define _GPIO_I2C_SCLROUTE_PORT_SHIFT   0
+#define _GPIO_I2C_SCLROUTE_PIN_SHIFT    16
+#define _GPIO_I2C_SDAROUTE_PORT_SHIFT   0
+#define _GPIO_I2C_SDAROUTE_PIN_SHIFT    16
+
+typedef enum {
+  gpioPortA = 0,
+  gpioPortB = 1,
+  gpioPortC = 2,
+  gpioPortD = 3,
+} GPIO_Port_TypeDef;
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void printPin(int port, int pin)
+{
+  if (port == BSP_PORTNUM_NONE) {
+    printf("  %-6s", "-");
+  } else {
+    printf("  P%c%02d  ", 'A' + port, pin);
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Print a row and check that its routes and ports come out as written.
+ ******************************************************************************/
+#define CHECK_BOARD(dev)                                                      \
+  do {                                                                        \
+    printf("%s", #dev);                                                       \
+    printPin(BSP_PORTNUM(BSP_COLUMN(0, I2C_BOARD_##dev)),                     \
+             BSP_PIN(BSP_COLUMN(0, I2C_BOARD_##dev)));                        \
+    printPin(BSP_PORTNUM(BSP_COLUMN(1, I2C_BOARD_##dev)),                     \
+             BSP_PIN(BSP_COLUMN(1, I2C_BOARD_##dev)));                        \
+    printPin(BSP_PORTNUM(BSP_COLUMN(2, I2C_BOARD_##dev)),                     \
+             BSP_PIN(BSP_COLUMN(2, I2C_BOARD_##dev)));                        \
+    printf("\n");                                                             \
+    check(BSP_ROUTE(I2C, SCL, BSP_COLUMN(0, I2C_BOARD_##dev))                 \
+          == ((uint32_t)BSP_PORT(BSP_COLUMN(0, I2C_BOARD_##dev))              \
+              | ((uint32_t)BSP_PIN(BSP_COLUMN(0, I2C_BOARD_##dev)) << 16)),   \
+          #dev " SCL route");                                                 \
+    check(BSP_ROUTE(I2C, SDA, BSP_COLUMN(1, I2C_BOARD_##dev))                 \
+          == ((uint32_t)BSP_PORT(BSP_COLUMN(1, I2C_BOARD_##dev))              \
+              | ((uint32_t)BSP_PIN(BSP_COLUMN(1, I2C_BOARD_##dev)) << 16)),   \
+          #dev " SDA route");                                                 \
+  } while (0)
+
+int main(void)
+{
+  printf("board SCL     SDA     SENSOR_ENABLE\n");
+  CHECK_BOARD(XG21);
+  CHECK_BOARD(XG22);
+  CHECK_BOARD(XG23);
+  CHECK_BOARD(XG24);
+  CHECK_BOARD(XG25);
+  CHECK_BOARD(XG27);
+  CHECK_BOARD(XG28);
+
+  // Spot checks of the columns against the table
+  check(BSP_PORT(BSP_COLUMN(2, I2C_BOARD_XG24)) == gpioPortD
+        && BSP_PIN(BSP_COLUMN(2, I2C_BOARD_XG24)) == 3,
+        "XG24 SENSOR_ENABLE is PD03");
+  check(!BSP_HAS_PIN(BSP_COLUMN(2, I2C_BOARD_XG25)),
+        "XG25 has no SENSOR_ENABLE");
+  check(BSP_ROUTE(I2C, SCL, BSP_COLUMN(0, I2C_BOARD_XG28)) == 0x00050002UL,
+        "XG28 SCL route is PC05");
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
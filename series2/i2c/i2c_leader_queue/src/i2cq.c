@@ -0,0 +1,532 @@
+/***************************************************************************//**
+ * @file i2cq.c
+ * @brief Queued I2C leader transactions run back to back by LDMA descriptor
+ * chains.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "i2cq.h"
+
+#if !defined(I2CQ_HOST)
+#include "em_device.h"
+#include "em_core.h"
+#include "em_i2c.h"
+#include "em_ldma.h"
+
+// One descriptor per chain step, at the same index
+static LDMA_Descriptor_t desc[I2CQ_MAX_STEPS];
+static unsigned int txCh;
+static unsigned int rxCh;
+
+// A transaction owns the bus
+static volatile bool active;
+
+static const LDMA_TransferCfg_t txCfg =
+  LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_I2C0_TXBL);
+static const LDMA_TransferCfg_t rxCfg =
+  LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_I2C0_RXDATAV);
+
+/**************************************************************************//**
+ * @brief
+ *   Turn count steps starting at first into linked descriptors; the last
+ *   one ends the chain.
+ *****************************************************************************/
+static void compileChain(const I2CQ_Handle_TypeDef *handle,
+                         uint32_t first,
+                         uint32_t count)
+{
+  uint32_t i;
+
+  for (i = first; i < first + count; i++) {
+    const I2CQ_Step_TypeDef *s = &handle->steps[i];
+
+    switch (s->kind) {
+      case i2cqStepTx:
+        desc[i] = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_M2P_BYTE((uint32_t)(s->data),
+                                           (uint32_t)(&I2C0->TXDATA),
+                                           s->count,
+                                           1);
+        break;
+      case i2cqStepRx:
+        desc[i] = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_P2M_BYTE((uint32_t)(&I2C0->RXDATA),
+                                           (uint32_t)(s->data),
+                                           s->count,
+                                           1);
+        break;
+      case i2cqStepStart:
+        desc[i] = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_WRITE(I2C_CMD_START,
+                                        (uint32_t)(&I2C0->CMD),
+                                        1);
+        break;
+      case i2cqStepAckOff:
+        desc[i] = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_WRITE(I2C_CTRL_AUTOACK,
+                                        (uint32_t)(&I2C0->CTRL_CLR),
+                                        1);
+        break;
+      default:
+        desc[i] = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_WRITE((I2C_CMD_NACK | I2C_CMD_STOP),
+                                        (uint32_t)(&I2C0->CMD),
+                                        1);
+        break;
+    }
+  }
+
+  // Transfer and write descriptors keep the link bit in the same place
+  desc[first + count - 1].xfer.link = 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start an LDMA chain without the channel done interrupt; completion and
+ *   errors are signaled by the I2C.
+ *****************************************************************************/
+static void startChain(unsigned int ch,
+                       const LDMA_TransferCfg_t *cfg,
+                       uint32_t first)
+{
+  LDMA_StartTransfer(ch, cfg, &desc[first]);
+  LDMA_IntDisable(1 << ch);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the current transaction, if any.
+ *
+ * @details
+ *   The transmit chain writes the address byte and then START, so the CPU
+ *   only has to enable the channels. A read without a command phase gets
+ *   its receive chain started up front; after a command phase it is started
+ *   at the repeated START.
+ *****************************************************************************/
+static void startTransaction(I2CQ_Handle_TypeDef *handle)
+{
+  I2CQ_Transaction_TypeDef *x = I2CQ_Current(handle);
+  uint32_t ien = I2C_IEN_MSTOP | I2C_IEN_ARBLOST | I2C_IEN_BUSERR | I2C_IEN_NACK;
+
+  if (x == NULL) {
+    return;
+  }
+  active = true;
+
+  I2C0->CMD = I2C_CMD_CLEARTX;
+  I2C_IntClear(I2C0, _I2C_IF_MASK);
+
+  if (x->rxLen == 0) {
+    // Send STOP as soon as the last byte has gone out
+    I2C0->CTRL_SET = I2C_CTRL_AUTOSE;
+  } else {
+    // ACK all bytes received except the last one
+    I2C0->CTRL_SET = I2C_CTRL_AUTOACK;
+    if (x->txLen == 0) {
+      startChain(rxCh, &rxCfg, x->stepFirst + x->txSteps);
+    } else {
+      ien |= I2C_IEN_TXC;
+    }
+  }
+
+  I2C0->IEN = ien;
+  startChain(txCh, &txCfg, x->stepFirst);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   End the running transaction and start the next one.
+ *****************************************************************************/
+static void finishTransaction(I2CQ_Handle_TypeDef *handle,
+                              I2CQ_Status_TypeDef status)
+{
+  LDMA_StopTransfer(txCh);
+  LDMA_StopTransfer(rxCh);
+  I2C0->IEN = 0;
+  I2C_IntClear(I2C0, _I2C_IF_MASK);
+  I2C0->CTRL_CLR = I2C_CTRL_AUTOACK | I2C_CTRL_AUTOSE;
+  active = false;
+
+  // The batch callback may submit and start the next batch itself
+  I2CQ_Complete(handle, status);
+  if (!active) {
+    startTransaction(handle);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take over I2C0 as queued leader.
+ *
+ * @details
+ *   I2C_Init() and LDMA_Init() must have been called. The application's
+ *   I2C0_IRQHandler() must call I2CQ_IRQHandler().
+ *****************************************************************************/
+void I2CQ_LeaderStart(I2CQ_Handle_TypeDef *handle,
+                      unsigned int txChannel,
+                      unsigned int rxChannel)
+{
+  I2CQ_Init(handle);
+  txCh = txChannel;
+  rxCh = rxChannel;
+  active = false;
+
+  I2C0->IEN = 0;
+  I2C_IntClear(I2C0, _I2C_IF_MASK);
+  I2C0->CTRL_CLR = I2C_CTRL_AUTOACK | I2C_CTRL_AUTOSE;
+  NVIC_ClearPendingIRQ(I2C0_IRQn);
+  NVIC_EnableIRQ(I2C0_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Queue a batch and start it if the bus is idle.
+ *
+ * @details
+ *   Can be called from the batch callback. The batch and its transactions
+ *   and buffers must stay valid until the callback has run.
+ *
+ * @return
+ *   false if the batch is invalid or does not fit in the step pool.
+ *****************************************************************************/
+bool I2CQ_Submit(I2CQ_Handle_TypeDef *handle, I2CQ_Batch_TypeDef *batch)
+{
+  bool ok;
+  uint8_t i;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+
+  ok = I2CQ_Enqueue(handle, batch);
+  if (ok) {
+    for (i = 0; i < batch->count; i++) {
+      I2CQ_Transaction_TypeDef *x = &batch->xfers[i];
+
+      compileChain(handle, x->stepFirst, x->txSteps);
+      if (x->readSteps) {
+        compileChain(handle, x->stepFirst + x->txSteps, x->readSteps);
+      }
+      if (x->rxSteps) {
+        compileChain(handle, x->stepFirst + x->txSteps + x->readSteps,
+                     x->rxSteps);
+      }
+    }
+    if (!active) {
+      startTransaction(handle);
+    }
+  }
+
+  CORE_EXIT_CRITICAL();
+  return ok;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   I2C0 interrupt handling: repeated START, completion and errors.
+ *
+ * @details
+ *   A write or a read raises one interrupt (MSTOP), a write-then-read two
+ *   (TXC, MSTOP). Errors abort the transaction and the batch continues with
+ *   the next one.
+ *****************************************************************************/
+void I2CQ_IRQHandler(I2CQ_Handle_TypeDef *handle)
+{
+  uint32_t flags = I2C_IntGetEnabled(I2C0);
+  I2CQ_Transaction_TypeDef *x = I2CQ_Current(handle);
+
+  if (flags & (I2C_IF_ARBLOST | I2C_IF_BUSERR | I2C_IF_NACK)) {
+    I2C0->CMD = I2C_CMD_ABORT;
+    if (flags & I2C_IF_ARBLOST) {
+      finishTransaction(handle, i2cqStatusArbLost);
+    } else if (flags & I2C_IF_BUSERR) {
+      finishTransaction(handle, i2cqStatusBusErr);
+    } else {
+      finishTransaction(handle, i2cqStatusNack);
+    }
+  } else if (flags & I2C_IF_MSTOP) {
+    finishTransaction(handle, i2cqStatusDone);
+  } else if ((flags & I2C_IF_TXC) && x != NULL) {
+    I2C_IntDisable(I2C0, I2C_IEN_TXC | I2C_IEN_NACK);
+    I2C_IntClear(I2C0, I2C_IF_TXC);
+
+    // Command sent: receive chain first, then address and repeated START
+    startChain(rxCh, &rxCfg, x->stepFirst + x->txSteps + x->readSteps);
+    startChain(txCh, &txCfg, x->stepFirst + x->txSteps);
+  }
+}
+#endif // !I2CQ_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Reset the queue.
+ *****************************************************************************/
+void I2CQ_Init(I2CQ_Handle_TypeDef *handle)
+{
+  memset(handle, 0, sizeof(*handle));
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Number of chain steps a transaction needs.
+ *****************************************************************************/
+static uint32_t stepsNeeded(const I2CQ_Transaction_TypeDef *x)
+{
+  // Address, START and the bytes to write
+  uint32_t n = 2 + (x->txLen > 0 ? 1 : 0);
+
+  if (x->rxLen > 0) {
+    if (x->txLen > 0) {
+      // Address and repeated START
+      n += 2;
+    }
+    // Bytes, AUTOACK off, last byte, NACK and STOP
+    n += x->rxLen > 1 ? 4 : 3;
+  }
+  return n;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Reserve count contiguous steps; a chain cannot wrap around the pool.
+ *
+ * @return
+ *   Index of the first step, or -1 if there is no room.
+ *****************************************************************************/
+static int32_t allocSteps(I2CQ_Handle_TypeDef *handle, uint32_t count)
+{
+  uint32_t in = handle->stepIn;
+  uint32_t out = handle->stepOut;
+
+  if (handle->head == NULL) {
+    handle->stepIn = handle->stepOut = 0;
+    in = out = 0;
+  }
+
+  // Keep in != out while steps are in use, so full and empty differ
+  if (in >= out) {
+    if (I2CQ_MAX_STEPS - in >= count) {
+      return (int32_t)in;
+    }
+    if (count < out) {
+      return 0;
+    }
+  } else if (out - in > count) {
+    return (int32_t)in;
+  }
+  return -1;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Append a step.
+ *****************************************************************************/
+static I2CQ_Step_TypeDef *addStep(I2CQ_Step_TypeDef *s,
+                                  I2CQ_StepKind_TypeDef kind,
+                                  uint8_t *data,
+                                  uint16_t count)
+{
+  s->kind = (uint8_t)kind;
+  s->data = data;
+  s->count = count;
+  return s + 1;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Generate the chain steps of a transaction at step index first.
+ *
+ * @details
+ *   Steps are stored as [transmit][repeated START][receive]:
+ *   - transmit: address byte, START, command/data bytes
+ *   - repeated START: read address byte, START (write-then-read only)
+ *   - receive: all but the last byte, AUTOACK off, last byte, NACK and STOP
+ *****************************************************************************/
+static void buildSteps(I2CQ_Handle_TypeDef *handle,
+                       I2CQ_Transaction_TypeDef *x,
+                       uint32_t first)
+{
+  I2CQ_Step_TypeDef *s = &handle->steps[first];
+  I2CQ_Step_TypeDef *mark = s;
+  bool readOnly = x->txLen == 0 && x->rxLen > 0;
+
+  x->addrByte[0] = x->address & 0xFE;
+  x->addrByte[1] = x->address | 0x01;
+  x->stepFirst = (uint16_t)first;
+  x->status = i2cqStatusPending;
+
+  s = addStep(s, i2cqStepTx, &x->addrByte[readOnly ? 1 : 0], 1);
+  s = addStep(s, i2cqStepStart, NULL, 0);
+  if (x->txLen > 0) {
+    s = addStep(s, i2cqStepTx, (uint8_t *)x->tx, x->txLen);
+  }
+  x->txSteps = (uint8_t)(s - mark);
+  mark = s;
+
+  if (x->rxLen > 0 && !readOnly) {
+    s = addStep(s, i2cqStepTx, &x->addrByte[1], 1);
+    s = addStep(s, i2cqStepStart, NULL, 0);
+  }
+  x->readSteps = (uint8_t)(s - mark);
+  mark = s;
+
+  if (x->rxLen > 1) {
+    s = addStep(s, i2cqStepRx, x->rx, x->rxLen - 1);
+  }
+  if (x->rxLen > 0) {
+    s = addStep(s, i2cqStepAckOff, NULL, 0);
+    s = addStep(s, i2cqStepRx, x->rx + x->rxLen - 1, 1);
+    s = addStep(s, i2cqStepNackStop, NULL, 0);
+  }
+  x->rxSteps = (uint8_t)(s - mark);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Generate the chain steps of a batch and append it to the queue.
+ *
+ * @details
+ *   I2CQ_Submit() adds the descriptors and starts the bus on the target.
+ *   Steps are allocated from a pool shared by all queued batches and freed
+ *   as each batch completes.
+ *
+ * @return
+ *   false if the batch is empty, a length is out of range or the pool has
+ *   no room; the batch is not queued then.
+ *****************************************************************************/
+bool I2CQ_Enqueue(I2CQ_Handle_TypeDef *handle, I2CQ_Batch_TypeDef *batch)
+{
+  uint32_t need = 0;
+  int32_t first;
+  uint8_t i;
+
+  if (batch->count == 0 || batch->busy) {
+    handle->rejected++;
+    return false;
+  }
+  for (i = 0; i < batch->count; i++) {
+    const I2CQ_Transaction_TypeDef *x = &batch->xfers[i];
+
+    if (x->txLen > I2CQ_MAX_LENGTH || x->rxLen > I2CQ_MAX_LENGTH
+        || (x->txLen > 0 && x->tx == NULL)
+        || (x->rxLen > 0 && x->rx == NULL)) {
+      handle->rejected++;
+      return false;
+    }
+    need += stepsNeeded(x);
+  }
+
+  first = allocSteps(handle, need);
+  if (first < 0) {
+    handle->rejected++;
+    return false;
+  }
+
+  for (i = 0; i < batch->count; i++) {
+    I2CQ_Transaction_TypeDef *x = &batch->xfers[i];
+
+    buildSteps(handle, x, (uint32_t)first);
+    first += x->txSteps + x->readSteps + x->rxSteps;
+  }
+  handle->stepIn = (uint16_t)first;
+  batch->stepEnd = (uint16_t)first;
+  batch->failed = 0;
+  batch->busy = true;
+  batch->next = NULL;
+
+  if (handle->tail != NULL) {
+    handle->tail->next = batch;
+  } else {
+    handle->head = batch;
+    handle->index = 0;
+  }
+  handle->tail = batch;
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Transaction on the bus, or NULL if the queue is empty.
+ *****************************************************************************/
+I2CQ_Transaction_TypeDef *I2CQ_Current(const I2CQ_Handle_TypeDef *handle)
+{
+  if (handle->head == NULL) {
+    return NULL;
+  }
+  return &handle->head->xfers[handle->index];
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Record the result of the running transaction and move on.
+ *
+ * @details
+ *   When it was the last of its batch, the batch leaves the queue, its
+ *   steps are freed and its callback runs.
+ *
+ * @return
+ *   The completed batch, or NULL if it still has transactions to run.
+ *****************************************************************************/
+I2CQ_Batch_TypeDef *I2CQ_Complete(I2CQ_Handle_TypeDef *handle,
+                                  I2CQ_Status_TypeDef status)
+{
+  I2CQ_Batch_TypeDef *batch = handle->head;
+
+  if (batch == NULL) {
+    return NULL;
+  }
+
+  batch->xfers[handle->index].status = status;
+  handle->transactions++;
+  if (status != i2cqStatusDone) {
+    handle->errors++;
+    batch->failed++;
+  }
+
+  if (++handle->index < batch->count) {
+    return NULL;
+  }
+
+  handle->head = batch->next;
+  if (handle->head == NULL) {
+    handle->tail = NULL;
+  }
+  handle->index = 0;
+  handle->stepOut = batch->stepEnd;
+  handle->batches++;
+  batch->busy = false;
+
+  if (batch->callback != NULL) {
+    batch->callback(batch);
+  }
+  return batch;
+}
@@ -0,0 +1,157 @@
+/***************************************************************************//**
+ * @file i2cq.h
+ * @brief Queued I2C leader transactions run back to back by LDMA descriptor
+ * chains.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef I2CQ_H
+#define I2CQ_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Chain steps (LDMA descriptors) shared by all queued batches
+#define I2CQ_MAX_STEPS      128
+
+/// Longest write or read; the LDMA transfer count limit
+#define I2CQ_MAX_LENGTH     2048
+
+/// Result of one transaction
+typedef enum {
+  i2cqStatusPending,   ///< Queued or in progress
+  i2cqStatusDone,      ///< Completed with STOP
+  i2cqStatusNack,      ///< Address or data byte not acknowledged
+  i2cqStatusBusErr,    ///< Misplaced START/STOP on the bus
+  i2cqStatusArbLost    ///< Another leader won the bus
+} I2CQ_Status_TypeDef;
+
+/// One write, read or write-then-read (repeated START) transaction
+typedef struct {
+  uint8_t             address;  ///< Follower address, left-shifted
+  const uint8_t       *tx;      ///< Command/register and data bytes
+  uint16_t            txLen;    ///< 0 for a read
+  uint8_t             *rx;
+  uint16_t            rxLen;    ///< 0 for a write
+  I2CQ_Status_TypeDef status;   ///< Set as the transaction completes
+
+  // Private to the engine; the LDMA reads the address bytes from here
+  uint8_t             addrByte[2];
+  uint16_t            stepFirst;
+  uint8_t             txSteps;   ///< Steps up to the first byte on the bus
+  uint8_t             readSteps; ///< Steps of the repeated START
+  uint8_t             rxSteps;
+} I2CQ_Transaction_TypeDef;
+
+/// Transaction initializers
+#define I2CQ_WRITE(addr, txBuf, txCount) \
+  { (addr), (txBuf), (txCount), NULL, 0, i2cqStatusPending, { 0 }, 0, 0, 0, 0 }
+#define I2CQ_READ(addr, rxBuf, rxCount) \
+  { (addr), NULL, 0, (rxBuf), (rxCount), i2cqStatusPending, { 0 }, 0, 0, 0, 0 }
+#define I2CQ_WRITE_READ(addr, txBuf, txCount, rxBuf, rxCount) \
+  { (addr), (txBuf), (txCount), (rxBuf), (rxCount), i2cqStatusPending, { 0 }, 0, 0, 0, 0 }
+
+struct I2CQ_Batch;
+
+/// Called once per batch, from interrupt context on the target
+typedef void (*I2CQ_Callback_TypeDef)(struct I2CQ_Batch *batch);
+
+/// Transactions run back to back with one completion callback
+typedef struct I2CQ_Batch {
+  I2CQ_Transaction_TypeDef *xfers;     ///< Must stay valid until the callback
+  uint8_t                  count;
+  I2CQ_Callback_TypeDef    callback;   ///< May be NULL
+  void                     *user;
+
+  uint8_t                  failed;     ///< Transactions that did not complete
+  bool                     busy;       ///< Queued and not yet completed
+
+  // Private to the engine
+  uint16_t                 stepEnd;
+  struct I2CQ_Batch        *next;
+} I2CQ_Batch_TypeDef;
+
+/// Kinds of chain steps; each becomes one LDMA descriptor
+typedef enum {
+  i2cqStepTx,          ///< Bytes to TXDATA on TXBL
+  i2cqStepRx,          ///< Bytes from RXDATA on RXDATAV
+  i2cqStepStart,       ///< Write START to CMD
+  i2cqStepAckOff,      ///< Clear AUTOACK so the last byte is NACKed
+  i2cqStepNackStop     ///< Write NACK and STOP to CMD
+} I2CQ_StepKind_TypeDef;
+
+/// One chain step
+typedef struct {
+  uint8_t  kind;       ///< I2CQ_StepKind_TypeDef
+  uint16_t count;      ///< Bytes, for i2cqStepTx and i2cqStepRx
+  uint8_t  *data;
+} I2CQ_Step_TypeDef;
+
+/// Engine state; all fields are read-only for the application
+typedef struct {
+  I2CQ_Step_TypeDef  steps[I2CQ_MAX_STEPS];
+  uint16_t           stepIn;           ///< Next free step
+  uint16_t           stepOut;          ///< Oldest step in use
+  I2CQ_Batch_TypeDef *head;            ///< Running batch
+  I2CQ_Batch_TypeDef *tail;
+  uint8_t            index;            ///< Running transaction in head
+
+  uint32_t batches;                    ///< Completed batches
+  uint32_t transactions;               ///< Completed transactions
+  uint32_t errors;                     ///< Transactions that failed
+  uint32_t rejected;                   ///< Batches refused by I2CQ_Enqueue
+} I2CQ_Handle_TypeDef;
+
+void I2CQ_Init(I2CQ_Handle_TypeDef *handle);
+bool I2CQ_Enqueue(I2CQ_Handle_TypeDef *handle, I2CQ_Batch_TypeDef *batch);
+I2CQ_Transaction_TypeDef *I2CQ_Current(const I2CQ_Handle_TypeDef *handle);
+I2CQ_Batch_TypeDef *I2CQ_Complete(I2CQ_Handle_TypeDef *handle,
+                                  I2CQ_Status_TypeDef status);
+
+#if !defined(I2CQ_HOST)
+void I2CQ_LeaderStart(I2CQ_Handle_TypeDef *handle,
+                      unsigned int txChannel,
+                      unsigned int rxChannel);
+bool I2CQ_Submit(I2CQ_Handle_TypeDef *handle, I2CQ_Batch_TypeDef *batch);
+void I2CQ_IRQHandler(I2CQ_Handle_TypeDef *handle);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // I2CQ_H
@@ -0,0 +1,328 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief This project demonstrates a queued I2C leader: batches of write,
+ * read and write-then-read transactions to several followers are run back
+ * to back by LDMA descriptor chains, with one callback per batch.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_i2c.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+
+#include "bsp.h"
+#include "i2cq.h"
+
+// I2C pins (SCL = EXP15; SDA = EXP16) and sensor domain power
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_5)
+#define I2C_SCL_PORT            gpioPortB
+#define I2C_SCL_PIN             2
+#define I2C_SDA_PORT            gpioPortB
+#define I2C_SDA_PIN             3
+#else
+#define I2C_SCL_PORT            gpioPortC
+#define I2C_SCL_PIN             5
+#define I2C_SDA_PORT            gpioPortC
+#define I2C_SDA_PIN             7
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_3)
+#define I2C_DOMAIN_POWER_PORT   gpioPortC
+#define I2C_DOMAIN_POWER_PIN    9
+#elif defined(_SILICON_LABS_32B_SERIES_2_CONFIG_8)
+#define I2C_DOMAIN_POWER_PORT   gpioPortC
+#define I2C_DOMAIN_POWER_PIN    11
+#else
+#define I2C_DOMAIN_POWER_PORT   gpioPortD
+#define I2C_DOMAIN_POWER_PIN    3
+#endif
+#endif
+
+// Follower addresses (left-shifted to bits [7:1])
+#define I2C_FOLLOWER_ADDRESS    0xE2
+#define SI7021_ADDRESS          0x80
+
+// LDMA channels
+#define I2C_DMA_TXCHAN          0
+#define I2C_DMA_RXCHAN          1
+
+// Buffer configuration
+#define I2C_BUFFER_SIZE         10
+
+I2CQ_Handle_TypeDef i2cq;
+
+/*
+ * Poll batch: Si7021 user register and firmware revision, then the
+ * follower's buffer. Each is a write-then-read with a repeated START.
+ */
+static const uint8_t si7021ReadUser[] = { 0xE7 };
+static const uint8_t si7021ReadFwRev[] = { 0x84, 0xB8 };
+static const uint8_t followerReg0[] = { 0x00 };
+
+uint8_t si7021User;
+uint8_t si7021FwRev;
+uint8_t i2c_rxBuffer[I2C_BUFFER_SIZE];
+
+static I2CQ_Transaction_TypeDef pollXfers[] = {
+  I2CQ_WRITE_READ(SI7021_ADDRESS, si7021ReadUser, 1, &si7021User, 1),
+  I2CQ_WRITE_READ(SI7021_ADDRESS, si7021ReadFwRev, 2, &si7021FwRev, 1),
+  I2CQ_WRITE_READ(I2C_FOLLOWER_ADDRESS, followerReg0, 1,
+                  i2c_rxBuffer, I2C_BUFFER_SIZE),
+};
+
+/*
+ * Update batch: write the incremented buffer (register address first) and
+ * read it back.
+ */
+uint8_t i2c_txBuffer[1 + I2C_BUFFER_SIZE];
+uint8_t i2c_verifyBuffer[I2C_BUFFER_SIZE];
+
+static I2CQ_Transaction_TypeDef updateXfers[] = {
+  I2CQ_WRITE(I2C_FOLLOWER_ADDRESS, i2c_txBuffer, 1 + I2C_BUFFER_SIZE),
+  I2CQ_WRITE_READ(I2C_FOLLOWER_ADDRESS, followerReg0, 1,
+                  i2c_verifyBuffer, I2C_BUFFER_SIZE),
+};
+
+static void pollDone(I2CQ_Batch_TypeDef *batch);
+static void updateDone(I2CQ_Batch_TypeDef *batch);
+
+static I2CQ_Batch_TypeDef pollBatch = {
+  pollXfers, sizeof(pollXfers) / sizeof(pollXfers[0]), pollDone, NULL
+};
+static I2CQ_Batch_TypeDef updateBatch = {
+  updateXfers, sizeof(updateXfers) / sizeof(updateXfers[0]), updateDone, NULL
+};
+
+// Test state and result
+volatile bool i2c_startTx;
+volatile bool i2c_testDone;
+volatile bool i2c_testPassed;
+
+// Core clock cycles from submitting the poll batch to the last callback
+uint32_t testCycles;
+static uint32_t testStart;
+
+/***************************************************************************//**
+ * @brief GPIO initialization
+ ******************************************************************************/
+void initGPIO(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  // Configure LED0 and LED1 as outputs
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN, gpioModePushPull, 0);
+
+  // Configure PB0 as input and interrupt
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPull, 1);
+  GPIO_ExtIntConfig(BSP_GPIO_PB0_PORT,
+                    BSP_GPIO_PB0_PIN,
+                    BSP_GPIO_PB0_PIN,
+                    false,
+                    true,
+                    true);
+
+  // Enable NVIC GPIO interrupt
+#if (BSP_GPIO_PB0_PIN & 1)
+  NVIC_ClearPendingIRQ(GPIO_ODD_IRQn);
+  NVIC_EnableIRQ(GPIO_ODD_IRQn);
+#else
+  NVIC_ClearPendingIRQ(GPIO_EVEN_IRQn);
+  NVIC_EnableIRQ(GPIO_EVEN_IRQn);
+#endif
+}
+
+/***************************************************************************//**
+ * @brief Setup I2C and the transaction queue
+ ******************************************************************************/
+void initI2C(void)
+{
+  I2C_Init_TypeDef i2cInit = I2C_INIT_DEFAULT;
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_I2C0, true);
+
+#if defined(I2C_DOMAIN_POWER_PORT)
+  /*
+   * Power up the Si7021 RHT sensor domain on the mainboard.  This
+   * also powers up the sensor's local SCL and SDA pull-ups, which
+   * eliminates the need to jumper resistors to the EXP header pins.
+   */
+  GPIO_PinModeSet(I2C_DOMAIN_POWER_PORT, I2C_DOMAIN_POWER_PIN, gpioModePushPull, 1);
+#endif
+
+  // Configure SCL and SDA for open-drain operation
+  GPIO_PinModeSet(I2C_SCL_PORT, I2C_SCL_PIN, gpioModeWiredAndPullUpFilter, 1);
+  GPIO_PinModeSet(I2C_SDA_PORT, I2C_SDA_PIN, gpioModeWiredAndPullUpFilter, 1);
+
+  // Route I2C pins to GPIO
+  GPIO->I2CROUTE[0].SCLROUTE = (I2C_SCL_PORT << _GPIO_I2C_SCLROUTE_PORT_SHIFT
+                             | (I2C_SCL_PIN << _GPIO_I2C_SCLROUTE_PIN_SHIFT));
+  GPIO->I2CROUTE[0].SDAROUTE = (I2C_SDA_PORT << _GPIO_I2C_SDAROUTE_PORT_SHIFT
+                             | (I2C_SDA_PIN  << _GPIO_I2C_SDAROUTE_PIN_SHIFT));
+  GPIO->I2CROUTE[0].ROUTEEN = GPIO_I2C_ROUTEEN_SCLPEN | GPIO_I2C_ROUTEEN_SDAPEN;
+
+  // Initialize the I2C and hand it to the queue
+  I2C_Init(I2C0, &i2cInit);
+  LDMA_Init(&ldmaInit);
+  I2CQ_LeaderStart(&i2cq, I2C_DMA_TXCHAN, I2C_DMA_RXCHAN);
+}
+
+/***************************************************************************//**
+ * @brief I2C interrupt handler; runs once per transaction, twice with a
+ *        repeated START
+ ******************************************************************************/
+void I2C0_IRQHandler(void)
+{
+  I2CQ_IRQHandler(&i2cq);
+}
+
+/**************************************************************************//**
+ * @brief LDMA interrupt handler
+ *
+ * @note No channel completion interrupts are used; the I2C interrupts
+ *       signal the end of each transaction. The LDMA error interrupt
+ *       is still enabled by LDMA_Init() to catch bad descriptors.
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  uint32_t flags = LDMA_IntGetEnabled();
+
+  if (flags & LDMA_IF_ERROR) {
+    // Breakpoint on error
+    __BKPT(1);
+  }
+  LDMA_IntClear(flags);
+}
+
+/***************************************************************************//**
+ * @brief Poll batch callback: increment the follower buffer and queue the
+ *        write and read-back
+ ******************************************************************************/
+static void pollDone(I2CQ_Batch_TypeDef *batch)
+{
+  int i;
+
+  (void)batch;
+
+  // The Si7021 may be absent (xG25); only the follower must answer
+  if (pollXfers[2].status != i2cqStatusDone) {
+    i2c_testPassed = false;
+    i2c_testDone = true;
+    return;
+  }
+
+  i2c_txBuffer[0] = followerReg0[0];
+  for (i = 0; i < I2C_BUFFER_SIZE; i++) {
+    i2c_txBuffer[1 + i] = i2c_rxBuffer[i] + 1;
+  }
+  if (!I2CQ_Submit(&i2cq, &updateBatch)) {
+    i2c_testPassed = false;
+    i2c_testDone = true;
+  }
+}
+
+/***************************************************************************//**
+ * @brief Update batch callback: verify the read-back
+ ******************************************************************************/
+static void updateDone(I2CQ_Batch_TypeDef *batch)
+{
+  testCycles = DWT->CYCCNT - testStart;
+  i2c_testPassed = batch->failed == 0
+                   && memcmp(i2c_verifyBuffer, &i2c_txBuffer[1],
+                             I2C_BUFFER_SIZE) == 0;
+  i2c_testDone = true;
+}
+
+/**************************************************************************//**
+ * @brief GPIO interrupt handler
+ *****************************************************************************/
+#if (BSP_GPIO_PB0_PIN & 1)
+void GPIO_ODD_IRQHandler(void)
+#else
+void GPIO_EVEN_IRQHandler(void)
+#endif
+{
+  // Clear pending
+  uint32_t flags = GPIO_IntGet();
+  GPIO_IntClear(flags);
+
+  // Button 0 pressed; start the poll/update/verify sequence
+  i2c_startTx = true;
+}
+
+/***************************************************************************//**
+ * @brief Main function
+ ******************************************************************************/
+int main(void)
+{
+  // Chip errata
+  CHIP_Init();
+
+  // Cycle counter for the sequence duration
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  // Initialize peripherals
+  initGPIO();
+  initI2C();
+
+  while (1) {
+    if (i2c_startTx) {
+      i2c_startTx = false;
+      i2c_testDone = false;
+      testStart = DWT->CYCCNT;
+
+      // Both batches run from here on without the main loop
+      if (!I2CQ_Submit(&i2cq, &pollBatch)) {
+        __BKPT(3);
+      }
+      while (!i2c_testDone) {
+        EMU_EnterEM1();
+      }
+
+      if (i2c_testPassed) {
+        // Toggle LED0 on each pass
+        GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+      } else {
+        // Indicate error with LED1 and breakpoint on failure
+        GPIO_PinOutSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN);
+        __BKPT(4);
+      }
+    }
+  }
+}
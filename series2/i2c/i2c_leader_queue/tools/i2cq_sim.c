@@ -0,0 +1,585 @@
+/***************************************************************************//**
+ * @file i2cq_sim.c
+ * @brief Host test and benchmark for the queued I2C leader engine.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DI2CQ_HOST -I../src -o i2cq_sim i2cq_sim.c ../src/i2cq.c
+ *   ./i2cq_sim
+ *
+ * The chain steps generated for each transaction are executed the way the
+ * LDMA and the I2C would run their descriptors: transmit steps feed bytes
+ * to the bus, START takes the first queued byte as address, receive steps
+ * take bytes from the follower, and the last byte must be NACKed before the
+ * STOP. Followers are register maps; absent addresses NACK. Results are
+ * checked against a model that applies each transaction directly.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "i2cq.h"
+
+#define DEVICES       16
+
+// Follower register map
+typedef struct {
+  uint8_t  address;
+  bool     present;
+  uint8_t  regs[256];
+  uint8_t  pointer;
+} Device_TypeDef;
+
+static Device_TypeDef bus[DEVICES];
+static Device_TypeDef ref[DEVICES];
+
+static I2CQ_Handle_TypeDef h;
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Followers 0x10-0x2E (left-shifted 0x20-0x5C); every fourth one absent.
+ ******************************************************************************/
+static void initDevices(void)
+{
+  int i, r;
+
+  for (i = 0; i < DEVICES; i++) {
+    bus[i].address = (uint8_t)((0x10 + 2 * i) << 1);
+    bus[i].present = (i % 4) != 3;
+    bus[i].pointer = 0;
+    for (r = 0; r < 256; r++) {
+      bus[i].regs[r] = (uint8_t)(r * 7 + i);
+    }
+  }
+  memcpy(ref, bus, sizeof(bus));
+}
+
+static Device_TypeDef *findDevice(Device_TypeDef *set, uint8_t address)
+{
+  int i;
+
+  for (i = 0; i < DEVICES; i++) {
+    if (set[i].address == (address & 0xFE) && set[i].present) {
+      return &set[i];
+    }
+  }
+  return NULL;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Bus model state for the running transaction.
+ ******************************************************************************/
+static struct {
+  Device_TypeDef *dev;
+  bool    reading;
+  uint32_t written;       // Bytes written since the address
+  uint8_t queue[4];       // Bytes waiting in the transmit buffer
+  uint32_t queued;
+  bool    started;
+  uint32_t interrupts;
+  uint64_t bits;          // SCL periods used
+} m;
+
+static bool busAddress(uint8_t address)
+{
+  m.bits += 1 + 9;        // (repeated) START, address and ACK
+  m.dev = findDevice(bus, address);
+  m.reading = (address & 1) != 0;
+  m.written = 0;
+  return m.dev != NULL;
+}
+
+static bool busWrite(uint8_t b)
+{
+  m.bits += 9;
+  if (m.written++ == 0) {
+    m.dev->pointer = b;
+  } else {
+    m.dev->regs[m.dev->pointer++] = b;
+  }
+  return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Run a transmit chain.
+ ******************************************************************************/
+static I2CQ_Status_TypeDef runTx(const I2CQ_Step_TypeDef *s, uint32_t n)
+{
+  uint32_t i, k;
+
+  m.queued = 0;
+  m.started = false;
+  for (i = 0; i < n; i++, s++) {
+    switch (s->kind) {
+      case i2cqStepTx:
+        for (k = 0; k < s->count; k++) {
+          if (!m.started) {
+            check(m.queued < sizeof(m.queue), "transmit buffer overrun");
+            m.queue[m.queued++ % sizeof(m.queue)] = s->data[k];
+          } else if (!busWrite(s->data[k])) {
+            return i2cqStatusNack;
+          }
+        }
+        break;
+      case i2cqStepStart:
+        check(m.queued == 1, "START without exactly the address queued");
+        check(!m.started, "second START in one chain");
+        m.started = true;
+        if (!busAddress(m.queue[0])) {
+          return i2cqStatusNack;
+        }
+        break;
+      default:
+        check(0, "unexpected step in transmit chain");
+        break;
+    }
+  }
+  check(m.started, "transmit chain without START");
+  return i2cqStatusDone;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Run a receive chain into the transaction's buffer.
+ ******************************************************************************/
+static void runRx(const I2CQ_Transaction_TypeDef *x,
+                  const I2CQ_Step_TypeDef *s,
+                  uint32_t n)
+{
+  uint32_t i, k, got = 0;
+  bool ack = true;
+  bool stopped = false;
+
+  check(m.reading, "receive chain without read address");
+  for (i = 0; i < n; i++, s++) {
+    check(!stopped, "steps after STOP");
+    switch (s->kind) {
+      case i2cqStepRx:
+        check(s->data == x->rx + got, "receive destination not contiguous");
+        for (k = 0; k < s->count; k++) {
+          s->data[k] = m.dev->regs[m.dev->pointer++];
+          m.bits += 9;
+          got++;
+          // The leader must ACK all bytes but the last
+          check(ack == (got < x->rxLen), "wrong ACK/NACK on a read byte");
+        }
+        break;
+      case i2cqStepAckOff:
+        ack = false;
+        break;
+      case i2cqStepNackStop:
+        stopped = true;
+        break;
+      default:
+        check(0, "unexpected step in receive chain");
+        break;
+    }
+  }
+  check(got == x->rxLen, "receive count");
+  check(stopped, "receive chain without STOP");
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Run the current transaction as the hardware would and complete it.
+ ******************************************************************************/
+static I2CQ_Batch_TypeDef *runOne(void)
+{
+  I2CQ_Transaction_TypeDef *x = I2CQ_Current(&h);
+  const I2CQ_Step_TypeDef *s;
+  I2CQ_Status_TypeDef status;
+
+  if (x == NULL) {
+    return NULL;
+  }
+  s = &h.steps[x->stepFirst];
+
+  status = runTx(s, x->txSteps);
+  if (status == i2cqStatusDone && x->readSteps) {
+    m.interrupts++;       // TXC: repeated START
+    status = runTx(s + x->txSteps, x->readSteps);
+  }
+  if (status == i2cqStatusDone && x->rxSteps) {
+    runRx(x, s + x->txSteps + x->readSteps, x->rxSteps);
+  }
+  m.bits += 1;            // STOP
+  m.interrupts++;         // MSTOP or error
+  return I2CQ_Complete(&h, status);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Apply a transaction to the reference followers.
+ ******************************************************************************/
+static I2CQ_Status_TypeDef reference(const I2CQ_Transaction_TypeDef *x,
+                                     uint8_t *out)
+{
+  Device_TypeDef *d = findDevice(ref, x->address);
+  uint32_t i;
+
+  if (d == NULL) {
+    return i2cqStatusNack;
+  }
+  for (i = 0; i < x->txLen; i++) {
+    if (i == 0) {
+      d->pointer = x->tx[0];
+    } else {
+      d->regs[d->pointer++] = x->tx[i];
+    }
+  }
+  for (i = 0; i < x->rxLen; i++) {
+    out[i] = d->regs[d->pointer++];
+  }
+  return i2cqStatusDone;
+}
+
+static uint32_t callbacks;
+static I2CQ_Batch_TypeDef *lastCallback;
+
+static void onBatch(I2CQ_Batch_TypeDef *batch)
+{
+  callbacks++;
+  lastCallback = batch;
+  check(!batch->busy, "batch still busy in callback");
+}
+
+/***************************************************************************//**
+ * @brief
+ *   A dozen sensors polled in one batch, one of them absent, plus a probe.
+ ******************************************************************************/
+static void sensorBatch(void)
+{
+  static uint8_t cmd[12][3];
+  static uint8_t rx[12][8];
+  static uint8_t expect[12][8];
+  I2CQ_Transaction_TypeDef xfers[13];
+  I2CQ_Batch_TypeDef batch = { xfers, 13, onBatch, NULL, 0, false, 0, NULL };
+  I2CQ_Status_TypeDef want[13];
+  int i;
+
+  for (i = 0; i < 12; i++) {
+    uint8_t addr = bus[i].address;
+
+    cmd[i][0] = (uint8_t)(0x10 * (i % 4));
+    cmd[i][1] = (uint8_t)(0xA0 + i);
+    cmd[i][2] = (uint8_t)(0xB0 + i);
+    switch (i % 3) {
+      case 0:   // Register read
+        xfers[i] = (I2CQ_Transaction_TypeDef)
+                   I2CQ_WRITE_READ(addr, cmd[i], 1, rx[i], 2 + i % 6);
+        break;
+      case 1:   // Configuration write
+        xfers[i] = (I2CQ_Transaction_TypeDef)I2CQ_WRITE(addr, cmd[i], 3);
+        break;
+      default:  // Read from the current pointer, one byte
+        xfers[i] = (I2CQ_Transaction_TypeDef)I2CQ_READ(addr, rx[i], 1);
+        break;
+    }
+  }
+  // Address-only probe of an absent follower
+  xfers[12] = (I2CQ_Transaction_TypeDef)I2CQ_WRITE(bus[3].address, NULL, 0);
+
+  for (i = 0; i < 13; i++) {
+    want[i] = reference(&xfers[i], expect[i < 12 ? i : 0]);
+  }
+
+  callbacks = 0;
+  check(I2CQ_Enqueue(&h, &batch), "sensor batch refused");
+  while (h.head != NULL && runOne() == NULL) {
+  }
+  check(callbacks == 1 && lastCallback == &batch, "one callback per batch");
+  check(batch.failed == 4, "absent followers not reported");
+  for (i = 0; i < 13; i++) {
+    check(xfers[i].status == want[i], "transaction status");
+    if (i < 12 && want[i] == i2cqStatusDone) {
+      check(memcmp(rx[i], expect[i], xfers[i].rxLen) == 0, "read data");
+    }
+  }
+  check(memcmp(bus, ref, sizeof(bus)) == 0, "follower registers");
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Invalid batches are refused without touching the queue.
+ ******************************************************************************/
+static void invalidBatches(void)
+{
+  static uint8_t buf[4];
+  I2CQ_Transaction_TypeDef x[1];
+  I2CQ_Batch_TypeDef batch = { x, 1, NULL, NULL, 0, false, 0, NULL };
+  uint32_t rejected = h.rejected;
+
+  x[0] = (I2CQ_Transaction_TypeDef)I2CQ_READ(0x20, buf, I2CQ_MAX_LENGTH + 1);
+  check(!I2CQ_Enqueue(&h, &batch), "overlong read accepted");
+  x[0] = (I2CQ_Transaction_TypeDef)I2CQ_READ(0x20, NULL, 2);
+  check(!I2CQ_Enqueue(&h, &batch), "read without buffer accepted");
+  batch.count = 0;
+  check(!I2CQ_Enqueue(&h, &batch), "empty batch accepted");
+  check(h.rejected == rejected + 3 && h.head == NULL, "queue changed");
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Random batches queued ahead of the bus: the step pool wraps, fills up
+ *   and drains, batches complete in order and their steps never overlap.
+ ******************************************************************************/
+#define POOL_BATCHES  8
+
+static I2CQ_Transaction_TypeDef rqXfers[POOL_BATCHES][8];
+static I2CQ_Batch_TypeDef rqBatches[POOL_BATCHES];
+static uint8_t rqTx[POOL_BATCHES][8][6];
+static uint8_t rqRx[POOL_BATCHES][8][6];
+static uint8_t rqExpect[POOL_BATCHES][8][6];
+static I2CQ_Status_TypeDef rqWant[POOL_BATCHES][8];
+static uint32_t rqDone;
+
+/***************************************************************************//**
+ * @brief
+ *   Check that the steps of the queued batches do not overlap.
+ ******************************************************************************/
+static void checkPool(void)
+{
+  const I2CQ_Batch_TypeDef *q;
+  uint8_t used[I2CQ_MAX_STEPS] = { 0 };
+  uint32_t i, k;
+
+  for (q = h.head; q != NULL; q = q->next) {
+    for (i = 0; i < q->count; i++) {
+      const I2CQ_Transaction_TypeDef *x = &q->xfers[i];
+      uint32_t end = x->stepFirst + x->txSteps + x->readSteps + x->rxSteps;
+
+      check(end <= I2CQ_MAX_STEPS, "chain runs past the pool");
+      for (k = x->stepFirst; k < end && k < I2CQ_MAX_STEPS; k++) {
+        check(!used[k], "steps of queued batches overlap");
+        used[k] = 1;
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Run one queued transaction and check its batch when it completes.
+ ******************************************************************************/
+static void runQueued(void)
+{
+  uint32_t b = rqDone % POOL_BATCHES;
+  I2CQ_Batch_TypeDef *batch;
+  uint32_t i;
+
+  // The reference runs a batch when it reaches the bus
+  if (h.index == 0) {
+    for (i = 0; i < rqBatches[b].count; i++) {
+      rqWant[b][i] = reference(&rqXfers[b][i], rqExpect[b][i]);
+    }
+  }
+  batch = runOne();
+  if (batch == NULL) {
+    return;
+  }
+  check(batch == &rqBatches[b], "batches completed out of order");
+  for (i = 0; i < batch->count; i++) {
+    const I2CQ_Transaction_TypeDef *x = &batch->xfers[i];
+
+    check(x->status == rqWant[b][i], "random status");
+    if (rqWant[b][i] == i2cqStatusDone && x->rxLen) {
+      check(memcmp(rqRx[b][i], rqExpect[b][i], x->rxLen) == 0,
+            "random read data");
+    }
+  }
+  rqDone++;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Random batches queued ahead of the bus: the step pool wraps, fills up
+ *   and drains, batches complete in order and their steps never overlap.
+ ******************************************************************************/
+static void randomQueue(void)
+{
+  uint32_t submitted = 0, full = 0, iter, i, j;
+
+  srand(7);
+  rqDone = 0;
+  for (iter = 0; iter < 200000; iter++) {
+    if (rand() % 2 && submitted - rqDone < POOL_BATCHES) {
+      uint32_t b = submitted % POOL_BATCHES;
+      I2CQ_Batch_TypeDef *batch = &rqBatches[b];
+      uint8_t n = (uint8_t)(1 + rand() % 8);
+
+      for (i = 0; i < n; i++) {
+        uint8_t addr = bus[rand() % DEVICES].address;
+        uint16_t tl = (uint16_t)(rand() % 7);
+        uint16_t rl = (uint16_t)(rand() % 7);
+
+        for (j = 0; j < 6; j++) {
+          rqTx[b][i][j] = (uint8_t)rand();
+        }
+        rqXfers[b][i] = (I2CQ_Transaction_TypeDef)
+                        I2CQ_WRITE_READ(addr, tl ? rqTx[b][i] : NULL, tl,
+                                        rl ? rqRx[b][i] : NULL, rl);
+      }
+      memset(batch, 0, sizeof(*batch));
+      batch->xfers = rqXfers[b];
+      batch->count = n;
+      batch->callback = onBatch;
+      if (I2CQ_Enqueue(&h, batch)) {
+        checkPool();
+        submitted++;
+      } else {
+        full++;
+      }
+    } else if (h.head != NULL) {
+      runQueued();
+    }
+  }
+  while (h.head != NULL) {
+    runQueued();
+  }
+  check(rqDone == submitted, "random batches lost");
+  check(memcmp(bus, ref, sizeof(bus)) == 0, "random follower registers");
+  printf("random queue: %lu batches, %lu transactions, pool full %lu times\n",
+         (unsigned long)submitted, (unsigned long)h.transactions,
+         (unsigned long)full);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   A batch that resubmits itself from its callback keeps polling.
+ ******************************************************************************/
+static uint32_t rounds;
+
+static void resubmit(I2CQ_Batch_TypeDef *batch)
+{
+  if (++rounds < 100) {
+    check(I2CQ_Enqueue(&h, batch), "resubmit from callback");
+  }
+}
+
+static void periodicBatch(void)
+{
+  static const uint8_t reg = 0x20;
+  static uint8_t rx[4];
+  I2CQ_Transaction_TypeDef x[2] = {
+    I2CQ_WRITE_READ(0x20, &reg, 1, rx, 2),
+    I2CQ_WRITE_READ(0x24, &reg, 1, rx + 2, 2),
+  };
+  I2CQ_Batch_TypeDef batch = { x, 2, resubmit, NULL, 0, false, 0, NULL };
+
+  rounds = 0;
+  check(I2CQ_Enqueue(&h, &batch), "periodic batch refused");
+  while (h.head != NULL) {
+    runOne();
+  }
+  check(rounds == 100, "periodic batch rounds");
+  memcpy(ref, bus, sizeof(bus));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Engine CPU time per transaction (step generation at submit plus
+ *   completion) and the bus-limited transaction rate for a typical batch.
+ ******************************************************************************/
+static void benchmark(void)
+{
+  static const uint8_t reg[12] = { 0 };
+  static uint8_t rx[12][6];
+  I2CQ_Transaction_TypeDef xfers[12];
+  I2CQ_Batch_TypeDef batch = { xfers, 12, NULL, NULL, 0, false, 0, NULL };
+  uint32_t i, loops = 200000;
+  uint64_t bits;
+  uint32_t interrupts;
+  clock_t start;
+  double ns;
+
+  // 12 sensors, 1 register byte then 2-6 data bytes each
+  for (i = 0; i < 12; i++) {
+    xfers[i] = (I2CQ_Transaction_TypeDef)
+               I2CQ_WRITE_READ(bus[i].address, &reg[i], 1, rx[i], 2 + i % 5);
+    bus[i].present = true;
+  }
+
+  start = clock();
+  for (i = 0; i < loops; i++) {
+    uint32_t k;
+
+    if (!I2CQ_Enqueue(&h, &batch)) {
+      check(0, "benchmark batch refused");
+      return;
+    }
+    for (k = 0; k < 12; k++) {
+      I2CQ_Complete(&h, i2cqStatusDone);
+    }
+  }
+  ns = (double)(clock() - start) / CLOCKS_PER_SEC * 1e9 / (loops * 12.0);
+  printf("engine: %.1f ns per transaction, %.2f M transactions/s of CPU\n",
+         ns, 1e3 / ns);
+
+  memset(&m, 0, sizeof(m));
+  check(I2CQ_Enqueue(&h, &batch), "benchmark batch refused");
+  while (h.head != NULL && runOne() == NULL) {
+  }
+  bits = m.bits;
+  interrupts = m.interrupts;
+  printf("12-sensor batch: %lu bit times, %lu interrupts, 1 callback; "
+         "bus limit %.0f transactions/s at 100 kHz, %.0f at 400 kHz\n",
+         (unsigned long)bits, (unsigned long)interrupts,
+         12 * 100e3 / bits, 12 * 400e3 / bits);
+}
+
+int main(void)
+{
+  initDevices();
+  I2CQ_Init(&h);
+
+  printf("fixed cases:\n");
+  sensorBatch();
+  invalidBatches();
+  periodicBatch();
+  randomQueue();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -1,5 +1,5 @@
 /***************************************************************************//**
- * @file main_scan_gpio_prs_ldma.c
+ * @file main.c
  *
  * @brief Use the IADC to take repeated, non-blocking measurements on
  * two external inputs.  A general-purpose input triggers conversions
@@ -47,7 +47,7 @@
 #include "em_prs.h"
 #include "em_ldma.h"
 
-#include "bspconfig.h"
+#include "iadc_scan_gpio_prs_ldma_pins.h"
 
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
@@ -58,26 +58,18 @@
 #define CLK_ADC_FREQ        10000000  // CLK_ADC - 10 MHz max in normal mode
 
 /*
- * Specify the IADC input using the IADC_PosInput_t typedef.  This
- * must be paired with a corresponding macro definition that allocates
- * the corresponding ABUS to the IADC.  These are...
- *
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
- *
- * ...for port A, port B, and port C/D pins, even and odd, respectively.
+ * Pins of the board being built.  Each IADC input also needs its half
+ * of the analog bus of its port (ABUS, BBUS or CDBUS, even or odd pins)
+ * allocated to ADC0; BSP_BUSALLOC() picks it from the pin.
  */
-#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortBPin2;
-#define IADC_INPUT_1_PORT_PIN     iadcPosInputPortBPin3;
+#define IADC_INPUT_0              BSP_COLUMN(0, BSP_BOARD(SCAN_BOARD_))
+#define IADC_INPUT_1              BSP_COLUMN(1, BSP_BOARD(SCAN_BOARD_))
+
+// LDMA transfer complete GPIO toggle pin
+#define LDMA_OUTPUT_0             BSP_COLUMN(2, BSP_BOARD(SCAN_BOARD_))
 
-#define IADC_INPUT_0_BUS          BBUSALLOC
-#define IADC_INPUT_0_BUSALLOC     GPIO_BBUSALLOC_BEVEN0_ADC0
-#define IADC_INPUT_1_BUS          BBUSALLOC
-#define IADC_INPUT_1_BUSALLOC     GPIO_BBUSALLOC_BODD0_ADC0
+// GPIO scan trigger input (works in EM2; requires port A/B GPIO)
+#define BUTTON_0                  BSP_COLUMN(3, BSP_BOARD(SCAN_BOARD_))
 
 // Use specified LDMA/PRS channel
 #define IADC_LDMA_CH              0
@@ -108,19 +100,24 @@ uint32_t scanBuffer[NUM_SAMPLES];
  *****************************************************************************/
 void initGPIO(void)
 {
-  // Enable GPIO clock branch
+  /*
+   * Enable GPIO clock branch.  On EFR32xG21 devices, CMU_ClockEnable()
+   * calls have no effect as clocks are enabled on demand.
+   */
   CMU_ClockEnable(cmuClock_GPIO, true);
 
-  // Show sample completion state on LED1
-  GPIO_PinModeSet(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN, gpioModePushPull, 0);
+  // Show sample completion state on the LDMA output
+  GPIO_PinModeSet(BSP_PORT(LDMA_OUTPUT_0), BSP_PIN(LDMA_OUTPUT_0),
+                  gpioModePushPull, 0);
 
-  // Configure push button 0 as input
-  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
+  // Configure the button as input
+  GPIO_PinModeSet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0),
+                  gpioModeInputPullFilter, 1);
 
-  // Enable PB0 pin routing for external interrupt, but NOT the interrupts
-  GPIO_ExtIntConfig(BSP_GPIO_PB0_PORT,
-                    BSP_GPIO_PB0_PIN,
-                    BSP_GPIO_PB0_PIN,
+  // Enable button pin routing for external interrupt, but NOT the interrupts
+  GPIO_ExtIntConfig(BSP_PORT(BUTTON_0),
+                    BSP_PIN(BUTTON_0),
+                    BSP_PIN(BUTTON_0),
                     false,
                     false,
                     false);
@@ -136,7 +133,7 @@ void initPRS(void)
   // Connect the specified PRS channel to the GPIO producer
   PRS_SourceAsyncSignalSet(PRS_CHANNEL,
                            PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO,
-                           BSP_GPIO_PB0_PIN);
+                           BSP_PIN(BUTTON_0));
 
   // Connect the specified PRS channel to the IADC as the consumer
   PRS_ConnectConsumer(PRS_CHANNEL,
@@ -235,11 +232,11 @@ void initIADC(void)
    * Configure entries in scan table.  CH0 is single-ended from
    * input 0; CH1 is single-ended from input 1.
    */
-  scanTable.entries[0].posInput = IADC_INPUT_0_PORT_PIN;
+  scanTable.entries[0].posInput = BSP_IADC_INPUT(IADC_INPUT_0);
   scanTable.entries[0].negInput = iadcNegInputGnd;
   scanTable.entries[0].includeInScan = true;
 
-  scanTable.entries[1].posInput = IADC_INPUT_1_PORT_PIN;
+  scanTable.entries[1].posInput = BSP_IADC_INPUT(IADC_INPUT_1);
   scanTable.entries[1].negInput = iadcNegInputGnd;
   scanTable.entries[1].includeInScan = true;
 
@@ -250,8 +247,8 @@ void initIADC(void)
   IADC_initScan(IADC0, &initScan, &scanTable);
 
   // Allocate the analog bus for ADC0 inputs
-  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
-  GPIO->IADC_INPUT_1_BUS |= IADC_INPUT_1_BUSALLOC;
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_0) |= BSP_BUSALLOC(IADC_INPUT_0, ADC0);
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_1) |= BSP_BUSALLOC(IADC_INPUT_1, ADC0);
 }
 
 /**************************************************************************//**
@@ -300,8 +297,8 @@ void LDMA_IRQHandler(void)
   // Clear interrupt flags
   LDMA_IntClear(1 << IADC_LDMA_CH);
 
-  // Toggle LED1 to notify that transfers are complete
-  GPIO_PinOutToggle(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN);
+  // Toggle the LDMA output to notify that transfers are complete
+  GPIO_PinOutToggle(BSP_PORT(LDMA_OUTPUT_0), BSP_PIN(LDMA_OUTPUT_0));
 }
 
 /**************************************************************************//**
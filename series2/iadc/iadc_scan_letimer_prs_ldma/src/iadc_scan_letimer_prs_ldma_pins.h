@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file iadc_scan_letimer_prs_ldma_pins.h
+ * @brief IADC input and GPIO output pins of each board supported by the
+ * example.  The table has no device dependencies, so tools/pins_check.c
+ * checks it on a PC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef IADC_SCAN_LETIMER_PRS_LDMA_PINS_H
+#define IADC_SCAN_LETIMER_PRS_LDMA_PINS_H
+
+#include "bsp_route.h"
+
+/*
+ * The IADC inputs and the LETIMER output work in EM2, so they must be on
+ * port A or B.  The LDMA output is toggled from the LDMA interrupt, in
+ * EM0, and can be on any port.
+ *
+ *                          INPUT_0  INPUT_1  LETIMER  LDMA
+ */
+#define SCAN_BOARD_XG21   ((A, 0), (A, 5), (A, 6), (B, 0))
+#define SCAN_BOARD_XG22   ((A, 0), (A, 5), (A, 6), (D, 2))
+#define SCAN_BOARD_XG23   ((B, 0), (B, 1), (A, 5), (D, 2))
+#define SCAN_BOARD_XG24   ((B, 0), (B, 1), (A, 5), (D, 2))
+#define SCAN_BOARD_XG25   ((B, 0), (B, 1), (A, 5), (C, 5))
+#define SCAN_BOARD_XG27   ((B, 0), (B, 1), (A, 5), (D, 2))
+#define SCAN_BOARD_XG28   ((B, 0), (B, 1), (A, 5), (C, 5))
+
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG)              \
+  && (_SILICON_LABS_32B_SERIES_2_CONFIG == 6                \
+      || _SILICON_LABS_32B_SERIES_2_CONFIG > 8)
+#error "No pins for this device in iadc_scan_letimer_prs_ldma_pins.h"
+#endif
+
+// Checks of a row: real, distinct pins, and EM2 pins where needed
+#define SCAN_PIN(n, dev)            BSP_COLUMN(n, SCAN_BOARD_##dev)
+#define SCAN_BOARD_CHECK(dev)                                                 \
+  BSP_CHECK(scan_##dev##_input0_em2,                                          \
+            BSP_PIN_VALID(SCAN_PIN(0, dev)) && BSP_PIN_EM2(SCAN_PIN(0, dev))); \
+  BSP_CHECK(scan_##dev##_input1_em2,                                          \
+            BSP_PIN_VALID(SCAN_PIN(1, dev)) && BSP_PIN_EM2(SCAN_PIN(1, dev))); \
+  BSP_CHECK(scan_##dev##_letimer_em2,                                         \
+            BSP_PIN_VALID(SCAN_PIN(2, dev)) && BSP_PIN_EM2(SCAN_PIN(2, dev))); \
+  BSP_CHECK(scan_##dev##_ldma_valid, BSP_PIN_VALID(SCAN_PIN(3, dev)));        \
+  BSP_CHECK(scan_##dev##_pins_differ,                                         \
+            BSP_PIN_DIFFERENT(SCAN_PIN(0, dev), SCAN_PIN(1, dev))             \
+            && BSP_PIN_DIFFERENT(SCAN_PIN(0, dev), SCAN_PIN(2, dev))          \
+            && BSP_PIN_DIFFERENT(SCAN_PIN(0, dev), SCAN_PIN(3, dev))          \
+            && BSP_PIN_DIFFERENT(SCAN_PIN(1, dev), SCAN_PIN(2, dev))          \
+            && BSP_PIN_DIFFERENT(SCAN_PIN(1, dev), SCAN_PIN(3, dev))          \
+            && BSP_PIN_DIFFERENT(SCAN_PIN(2, dev), SCAN_PIN(3, dev)))
+
+// Every row is checked in every build, whichever device it is for
+SCAN_BOARD_CHECK(XG21);
+SCAN_BOARD_CHECK(XG22);
+SCAN_BOARD_CHECK(XG23);
+SCAN_BOARD_CHECK(XG24);
+SCAN_BOARD_CHECK(XG25);
+SCAN_BOARD_CHECK(XG27);
+SCAN_BOARD_CHECK(XG28);
+
+#endif // IADC_SCAN_LETIMER_PRS_LDMA_PINS_H
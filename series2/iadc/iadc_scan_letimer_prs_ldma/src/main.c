@@ -1,10 +1,10 @@
 /***************************************************************************//**
- * @file main_scan_letimer_prs_ldma.c
+ * @file main.c
  * @brief Use the IADC to take repeated nonblocking measurements on two external
  * inputs which in turn triggers the LDMA to transfer the IADC measurement to
  * memory, all while remaining in EM2. IADC conversion is requested periodically
  * by LETIMER via PRS, also running in EM2. After NUM_SAMPLES conversions the
- * LDMA will trigger an interrupt from EM2 and toggle LED0 on the WSTK.
+ * LDMA will trigger an interrupt from EM2 and toggle a GPIO.
  *******************************************************************************
  * # License
  * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
@@ -48,6 +48,8 @@
 #include "em_ldma.h"
 #include "em_letimer.h"
 
+#include "iadc_scan_letimer_prs_ldma_pins.h"
+
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
  ******************************************************************************/
@@ -57,38 +59,22 @@
 #define CLK_ADC_FREQ              10000000 // CLK_ADC - 10MHz max in normal mode
 
 /*
- * Specify the IADC input using the IADC_PosInput_t typedef.  This
- * must be paired with a corresponding macro definition that allocates
- * the corresponding ABUS to the IADC.  These are...
- *
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
- *
- * ...for port A, port B, and port C/D pins, even and odd, respectively.
+ * Pins of the board being built.  Each IADC input also needs its half
+ * of the analog bus of its port (ABUS, BBUS or CDBUS, even or odd pins)
+ * allocated to ADC0; BSP_BUSALLOC() picks it from the pin.
  */
-#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortBPin0;
-#define IADC_INPUT_1_PORT_PIN     iadcPosInputPortBPin1;
+#define IADC_INPUT_0              BSP_COLUMN(0, BSP_BOARD(SCAN_BOARD_))
+#define IADC_INPUT_1              BSP_COLUMN(1, BSP_BOARD(SCAN_BOARD_))
 
-#define IADC_INPUT_0_BUS          BBUSALLOC
-#define IADC_INPUT_0_BUSALLOC     GPIO_BBUSALLOC_BEVEN0_ADC0
-#define IADC_INPUT_1_BUS          BBUSALLOC
-#define IADC_INPUT_1_BUSALLOC     GPIO_BBUSALLOC_BODD0_ADC0
+// LETIMER GPIO toggle pin (toggled in EM2; requires port A/B GPIO)
+#define LETIMER_OUTPUT_0          BSP_COLUMN(2, BSP_BOARD(SCAN_BOARD_))
 
-// LDMA transfer complete GPIO toggle port/pin
-#define LDMA_OUTPUT_0_PORT        gpioPortC
-#define LDMA_OUTPUT_0_PIN         5
+// LDMA transfer complete GPIO toggle pin
+#define LDMA_OUTPUT_0             BSP_COLUMN(3, BSP_BOARD(SCAN_BOARD_))
 
 // Desired LETIMER frequency in Hz
 #define LETIMER_FREQ              1
 
-// LETIMER GPIO toggle port/pin (toggled in EM2; requires port A/B GPIO)
-#define LETIMER_OUTPUT_0_PORT     gpioPortA
-#define LETIMER_OUTPUT_0_PIN      5
-
 // Use specified LDMA/PRS channel
 #define IADC_LDMA_CH              0
 #define PRS_CHANNEL               0
@@ -116,12 +102,17 @@ uint32_t scanBuffer[NUM_SAMPLES];
  *****************************************************************************/
 void initGPIO (void)
 {
-  // Enable GPIO clock branch
+  /*
+   * Enable GPIO clock branch.  On EFR32xG21 devices, CMU_ClockEnable()
+   * calls have no effect as clocks are enabled on demand.
+   */
   CMU_ClockEnable(cmuClock_GPIO, true);
 
   // Configure LDMA/LETIMER as outputs
-  GPIO_PinModeSet(LDMA_OUTPUT_0_PORT, LDMA_OUTPUT_0_PIN, gpioModePushPull, 0);
-  GPIO_PinModeSet(LETIMER_OUTPUT_0_PORT, LETIMER_OUTPUT_0_PIN, gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_PORT(LDMA_OUTPUT_0), BSP_PIN(LDMA_OUTPUT_0),
+                  gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_PORT(LETIMER_OUTPUT_0), BSP_PIN(LETIMER_OUTPUT_0),
+                  gpioModePushPull, 0);
 }
 
 /**************************************************************************//**
@@ -230,11 +221,11 @@ void initIADC (void)
    * Configure entries in scan table.  CH0 is single-ended from
    * input 0; CH1 is single-ended from input 1.
    */
-  initScanTable.entries[0].posInput = IADC_INPUT_0_PORT_PIN;
+  initScanTable.entries[0].posInput = BSP_IADC_INPUT(IADC_INPUT_0);
   initScanTable.entries[0].negInput = iadcNegInputGnd;
   initScanTable.entries[0].includeInScan = true;
 
-  initScanTable.entries[1].posInput = IADC_INPUT_1_PORT_PIN;
+  initScanTable.entries[1].posInput = BSP_IADC_INPUT(IADC_INPUT_1);
   initScanTable.entries[1].negInput = iadcNegInputGnd;
   initScanTable.entries[1].includeInScan = true;
 
@@ -245,8 +236,8 @@ void initIADC (void)
   IADC_initScan(IADC0, &initScan, &initScanTable);
 
   // Allocate the analog bus for ADC0 inputs
-  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
-  GPIO->IADC_INPUT_1_BUS |= IADC_INPUT_1_BUSALLOC;
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_0) |= BSP_BUSALLOC(IADC_INPUT_0, ADC0);
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_1) |= BSP_BUSALLOC(IADC_INPUT_1, ADC0);
 }
 
 /**************************************************************************//**
@@ -281,10 +272,8 @@ void initLetimer(void)
   letimerInit.repMode = letimerRepeatFree;
 
   // Enable LETIMER0 output0
-  GPIO->LETIMERROUTE.ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
-  GPIO->LETIMERROUTE.OUT0ROUTE = \
-      (LETIMER_OUTPUT_0_PORT << _GPIO_LETIMER_OUT0ROUTE_PORT_SHIFT) \
-      | (LETIMER_OUTPUT_0_PIN << _GPIO_LETIMER_OUT0ROUTE_PIN_SHIFT);
+  GPIO->BSP_GPIO_ROUTE(LETIMER0).ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
+  BSP_ROUTE_SET(LETIMER0, OUT0, LETIMER_OUTPUT_0);
 
   // Initialize LETIMER
   LETIMER_Init(LETIMER0, &letimerInit);
@@ -334,8 +323,8 @@ void LDMA_IRQHandler(void)
   // Clear interrupt flags
   LDMA_IntClear(LDMA_IF_DONE0);
 
-  // Toggle LED0 to notify that transfers are complete
-  GPIO_PinOutToggle(LDMA_OUTPUT_0_PORT, LDMA_OUTPUT_0_PIN);
+  // Toggle the GPIO to notify that transfers are complete
+  GPIO_PinOutToggle(BSP_PORT(LDMA_OUTPUT_0), BSP_PIN(LDMA_OUTPUT_0));
 }
 
 /**************************************************************************//**
@@ -0,0 +1,146 @@
+/***************************************************************************//**
+ * @file pins_check.c
+ * @brief Host check of the pin table of every board.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -Wall -I../src -I../../../kit/common/bsp -o pins_check \
+ *       pins_check.c
+ *   ./pins_check
+ *
+ * Including the table checks every row at compile time: a pin that does not
+ * exist, is used twice, or stops in EM2 while it must work there fails the
+ * build.  The program then resolves each row the way main.c does on the
+ * device, with the Series 2 register layouts, and prints the pins and the
+ * analog bus allocations.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "iadc_scan_letimer_prs_ldma_pins.h"
+
+// Route register fields, as in the device headers
+#define _GPIO_LETIMER_OUT0ROUTE_PORT_SHIFT  0
+#define _GPIO_LETIMER_OUT0ROUTE_PIN_SHIFT   16
+
+// Bus allocation fields for ADC0, as in the device headers
+#define GPIO_ABUSALLOC_AEVEN0_ADC0          0x00000001UL
+#define GPIO_ABUSALLOC_AODD0_ADC0           0x00010000UL
+#define GPIO_BBUSALLOC_BEVEN0_ADC0          0x00000001UL
+#define GPIO_BBUSALLOC_BODD0_ADC0           0x00010000UL
+#define GPIO_CDBUSALLOC_CDEVEN0_ADC0        0x00000001UL
+#define GPIO_CDBUSALLOC_CDODD0_ADC0         0x00010000UL
+
+// Bus allocation registers
+static struct {
+  uint32_t ABUSALLOC;
+  uint32_t BBUSALLOC;
+  uint32_t CDBUSALLOC;
+} gpio, *GPIO = &gpio;
+
+// IADC inputs of ports A and B, numbered as port * 16 + pin
+enum {
+  iadcPosInputPortAPin0 = 0, iadcPosInputPortAPin5 = 5,
+  iadcPosInputPortBPin0 = 16, iadcPosInputPortBPin1 = 17,
+};
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void printPin(int port, int pin)
+{
+  printf("  P%c%02d  ", 'A' + port, pin);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Print a row, allocate its inputs as main.c does, and check the result.
+ ******************************************************************************/
+#define CHECK_BOARD(dev)                                                      \
+  do {                                                                        \
+    printf("%s", #dev);                                                       \
+    printPin(BSP_PORTNUM(SCAN_PIN(0, dev)), BSP_PIN(SCAN_PIN(0, dev)));       \
+    printPin(BSP_PORTNUM(SCAN_PIN(1, dev)), BSP_PIN(SCAN_PIN(1, dev)));       \
+    printPin(BSP_PORTNUM(SCAN_PIN(2, dev)), BSP_PIN(SCAN_PIN(2, dev)));       \
+    printPin(BSP_PORTNUM(SCAN_PIN(3, dev)), BSP_PIN(SCAN_PIN(3, dev)));       \
+    gpio.ABUSALLOC = gpio.BBUSALLOC = gpio.CDBUSALLOC = 0;                    \
+    GPIO->BSP_BUSALLOC_REG(SCAN_PIN(0, dev))                                  \
+      |= BSP_BUSALLOC(SCAN_PIN(0, dev), ADC0);                                \
+    GPIO->BSP_BUSALLOC_REG(SCAN_PIN(1, dev))                                  \
+      |= BSP_BUSALLOC(SCAN_PIN(1, dev), ADC0);                                \
+    printf("  %08lX  %08lX\n", (unsigned long)gpio.ABUSALLOC,                 \
+           (unsigned long)gpio.BBUSALLOC);                                    \
+    check(gpio.CDBUSALLOC == 0, #dev " CD bus untouched");                    \
+    check(BSP_IADC_INPUT(SCAN_PIN(0, dev))                                    \
+          == BSP_PORTNUM(SCAN_PIN(0, dev)) * 16 + BSP_PIN(SCAN_PIN(0, dev)),  \
+          #dev " input 0");                                                   \
+    check(BSP_IADC_INPUT(SCAN_PIN(1, dev))                                    \
+          == BSP_PORTNUM(SCAN_PIN(1, dev)) * 16 + BSP_PIN(SCAN_PIN(1, dev)),  \
+          #dev " input 1");                                                   \
+    check(BSP_ROUTE(LETIMER, OUT0, SCAN_PIN(2, dev))                          \
+          == ((uint32_t)BSP_PORTNUM(SCAN_PIN(2, dev))                         \
+              | ((uint32_t)BSP_PIN(SCAN_PIN(2, dev)) << 16)),                 \
+          #dev " LETIMER route");                                             \
+    check((BSP_PIN(SCAN_PIN(0, dev)) & 1) != (BSP_PIN(SCAN_PIN(1, dev)) & 1), \
+          #dev " inputs on an even and an odd pin");                          \
+  } while (0)
+
+int main(void)
+{
+  printf("board INPUT_0 INPUT_1 LETIMER LDMA    ABUSALLOC BBUSALLOC\n");
+  CHECK_BOARD(XG21);
+  CHECK_BOARD(XG22);
+  CHECK_BOARD(XG23);
+  CHECK_BOARD(XG24);
+  CHECK_BOARD(XG25);
+  CHECK_BOARD(XG27);
+  CHECK_BOARD(XG28);
+
+  // Spot checks against the values the examples used to write by hand
+  gpio.ABUSALLOC = gpio.BBUSALLOC = 0;
+  GPIO->BSP_BUSALLOC_REG(SCAN_PIN(0, XG24)) |= BSP_BUSALLOC(SCAN_PIN(0, XG24), ADC0);
+  GPIO->BSP_BUSALLOC_REG(SCAN_PIN(1, XG24)) |= BSP_BUSALLOC(SCAN_PIN(1, XG24), ADC0);
+  check(gpio.BBUSALLOC == (GPIO_BBUSALLOC_BEVEN0_ADC0 | GPIO_BBUSALLOC_BODD0_ADC0)
+        && gpio.ABUSALLOC == 0,
+        "XG24 allocates both halves of BBUS");
+  check(BSP_IADC_INPUT(SCAN_PIN(1, XG21)) == iadcPosInputPortAPin5,
+        "XG21 input 1 is PA05");
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+/***************************************************************************//**
+ * @file iadc_single_calibration_pins.h
+ * @brief IADC input, LED and button pins of each board supported by the
+ * example.  The table has no device dependencies, so tools/pins_check.c
+ * checks it on a PC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef IADC_SINGLE_CALIBRATION_PINS_H
+#define IADC_SINGLE_CALIBRATION_PINS_H
+
+#include "bsp_route.h"
+
+/*
+ * The differential inputs need one even and one odd half of the analog
+ * buses.  The example runs in EM0, so any port will do.  xG27 uses LED1,
+ * as LED0 shares PB00 with the button.
+ *
+ *                         INPUT_POS INPUT_NEG LED     BUTTON
+ */
+#define CAL_BOARD_XG21    ((C, 4), (C, 5), (B, 0), (D, 2))
+#define CAL_BOARD_XG22    ((C, 4), (C, 5), (D, 2), (B, 0))
+#define CAL_BOARD_XG23    ((D, 4), (D, 5), (B, 2), (B, 1))
+#define CAL_BOARD_XG24    ((D, 4), (D, 5), (B, 2), (B, 1))
+#define CAL_BOARD_XG25    ((D, 4), (D, 5), (C, 6), (B, 0))
+#define CAL_BOARD_XG27    ((A, 5), (A, 6), (B, 1), (B, 0))
+#define CAL_BOARD_XG28    ((D, 4), (D, 5), (B, 2), (B, 1))
+
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG)              \
+  && (_SILICON_LABS_32B_SERIES_2_CONFIG == 6                \
+      || _SILICON_LABS_32B_SERIES_2_CONFIG > 8)
+#error "No pins for this device in iadc_single_calibration_pins.h"
+#endif
+
+// Checks of a row: real, distinct pins, and inputs on an even and an odd pin
+#define CAL_PIN(n, dev)             BSP_COLUMN(n, CAL_BOARD_##dev)
+#define CAL_BOARD_CHECK(dev)                                                  \
+  BSP_CHECK(cal_##dev##_pins_valid,                                           \
+            BSP_PIN_VALID(CAL_PIN(0, dev)) && BSP_PIN_VALID(CAL_PIN(1, dev))  \
+            && BSP_PIN_VALID(CAL_PIN(2, dev))                                 \
+            && BSP_PIN_VALID(CAL_PIN(3, dev)));                               \
+  BSP_CHECK(cal_##dev##_inputs_even_odd,                                      \
+            (BSP_PIN(CAL_PIN(0, dev)) & 1) != (BSP_PIN(CAL_PIN(1, dev)) & 1)); \
+  BSP_CHECK(cal_##dev##_pins_differ,                                          \
+            BSP_PIN_DIFFERENT(CAL_PIN(0, dev), CAL_PIN(1, dev))               \
+            && BSP_PIN_DIFFERENT(CAL_PIN(0, dev), CAL_PIN(2, dev))            \
+            && BSP_PIN_DIFFERENT(CAL_PIN(0, dev), CAL_PIN(3, dev))            \
+            && BSP_PIN_DIFFERENT(CAL_PIN(1, dev), CAL_PIN(2, dev))            \
+            && BSP_PIN_DIFFERENT(CAL_PIN(1, dev), CAL_PIN(3, dev))            \
+            && BSP_PIN_DIFFERENT(CAL_PIN(2, dev), CAL_PIN(3, dev)))
+
+// Every row is checked in every build, whichever device it is for
+CAL_BOARD_CHECK(XG21);
+CAL_BOARD_CHECK(XG22);
+CAL_BOARD_CHECK(XG23);
+CAL_BOARD_CHECK(XG24);
+CAL_BOARD_CHECK(XG25);
+CAL_BOARD_CHECK(XG27);
+CAL_BOARD_CHECK(XG28);
+
+#endif // IADC_SINGLE_CALIBRATION_PINS_H
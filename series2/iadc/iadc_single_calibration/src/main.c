@@ -1,4 +1,5 @@
 /***************************************************************************//**
+ * @file main.c
  * @brief Use the IADC and an external supply to calibrate the gain and offset,
  * then take repeated blocking differential measurements on single set of
  * differential inputs
@@ -39,7 +40,7 @@
 #include "em_cmu.h"
 #include "em_iadc.h"
 #include "em_gpio.h"
-#include "bsp.h"
+#include "iadc_single_calibration_pins.h"
 
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
@@ -53,26 +54,18 @@
 #define CLK_ADC_FREQ                10000000 // CLK_ADC - 10MHz max in normal mode
 
 /*
- * Specify the IADC input using the IADC_PosInput_t typedef.  This
- * must be paired with a corresponding macro definition that allocates
- * the corresponding ABUS to the IADC.  These are...
- *
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
- *
- * ...for port A, port B, and port C/D pins, even and odd, respectively.
+ * Pins of the board being built.  Each IADC input also needs its half
+ * of the analog bus of its port (ABUS, BBUS or CDBUS, even or odd pins)
+ * allocated to ADC0; BSP_BUSALLOC() picks it from the pin.
  */
-#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortDPin4;
-#define IADC_INPUT_1_PORT_PIN     iadcNegInputPortDPin5;
+#define IADC_INPUT_POS            BSP_COLUMN(0, BSP_BOARD(CAL_BOARD_))
+#define IADC_INPUT_NEG            BSP_COLUMN(1, BSP_BOARD(CAL_BOARD_))
+
+// LED lit while conversions are being performed
+#define LED_OUTPUT                BSP_COLUMN(2, BSP_BOARD(CAL_BOARD_))
 
-#define IADC_INPUT_0_BUS          CDBUSALLOC
-#define IADC_INPUT_0_BUSALLOC     GPIO_CDBUSALLOC_CDEVEN0_ADC0
-#define IADC_INPUT_1_BUS          CDBUSALLOC
-#define IADC_INPUT_1_BUSALLOC     GPIO_CDBUSALLOC_CDODD0_ADC0
+// Push button that steps through the calibration
+#define BUTTON_0                  BSP_COLUMN(3, BSP_BOARD(CAL_BOARD_))
 
 #define IADC_SCALE_OFFSET_MAX_NEG   0x00020000UL // 18-bit 2's compliment
 #define IADC_SCALE_OFFSET_ZERO      0x00000000UL
@@ -96,10 +89,10 @@ void initGPIO (void)
   CMU_ClockEnable(cmuClock_GPIO, true);
 
   // Configure push button PB0 as a user input; will use as a toggle to indicate when inputs are ready
-  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
+  GPIO_PinModeSet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0), gpioModeInputPullFilter, 1);
 
-  // Configure LED0 as output, will indicate when conversions are being performed
-  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  // Configure the LED as output, will indicate when conversions are being performed
+  GPIO_PinModeSet(BSP_PORT(LED_OUTPUT), BSP_PIN(LED_OUTPUT), gpioModePushPull, 0);
 }
 
 /**************************************************************************//**
@@ -140,8 +133,8 @@ void initIADC (void)
   initAllConfigs.configs[0].twosComplement = iadcCfgTwosCompBipolar; // Force IADC to use bipolar inputs for conversion
 
   // Assign pins to positive and negative inputs in differential mode
-  initSingleInput.posInput   = IADC_INPUT_0_PORT_PIN;
-  initSingleInput.negInput   = IADC_INPUT_1_PORT_PIN;
+  initSingleInput.posInput   = BSP_IADC_INPUT(IADC_INPUT_POS);
+  initSingleInput.negInput   = BSP_IADC_NEG_INPUT(IADC_INPUT_NEG);
 
   // Initialize the IADC
   IADC_init(IADC0, &init, &initAllConfigs);
@@ -150,8 +143,8 @@ void initIADC (void)
   IADC_initSingle(IADC0, &initSingle, &initSingleInput);
 
   // Allocate the analog bus for ADC0 inputs
-  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
-  GPIO->IADC_INPUT_1_BUS |= IADC_INPUT_1_BUSALLOC;
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_POS) |= BSP_BUSALLOC(IADC_INPUT_POS, ADC0);
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_NEG) |= BSP_BUSALLOC(IADC_INPUT_NEG, ADC0);
 }
 
 /**************************************************************************//**
@@ -164,7 +157,7 @@ double IADCAverageConversion(uint32_t numSamples)
     IADC_Result_t sample;
 
     // indicate to user IADC is busy
-    GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    GPIO_PinOutSet(BSP_PORT(LED_OUTPUT), BSP_PIN(LED_OUTPUT));
 
     // Averaging loop
     average = 0; // reset accumulator
@@ -184,7 +177,7 @@ double IADCAverageConversion(uint32_t numSamples)
     average /= NUM_SAMPLES;
 
     // turn off indicator LED
-    GPIO_PinOutClear(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    GPIO_PinOutClear(BSP_PORT(LED_OUTPUT), BSP_PIN(LED_OUTPUT));
 
     return average;
 }
@@ -197,8 +190,10 @@ void IADCRescale(uint32_t newScale)
     // Disable the IADC
     IADC0->EN_CLR = IADC_EN_EN;
 
-    // wait for IADC to disable
+#if defined(_IADC_EN_DISABLING_MASK)
+    // wait for IADC to disable, on devices that report it
     while((IADC0->EN & _IADC_EN_DISABLING_MASK) == IADC_EN_DISABLING);
+#endif
 
     // configure new scale settings
     IADC0->CFG[0].SCALE = newScale;
@@ -233,16 +228,16 @@ int main(void)
 
   // Apply a full-scale positive input to the IADC
   // Wait until differential voltage is applied
-  while(GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) != PB_PRESSED); //user feedback
-  while(GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == PB_PRESSED); //make it a toggle
+  while(GPIO_PinInGet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0)) != PB_PRESSED); //user feedback
+  while(GPIO_PinInGet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0)) == PB_PRESSED); //make it a toggle
 
   // Take multiple conversions and average to reduce system-level noise
   result_fullscale = IADCAverageConversion(NUM_SAMPLES);
 
-  // Apply a zero differential input to the IADC (short P25-P24)
+  // Apply a zero differential input to the IADC (short the two inputs)
   // Wait until differential voltage is applied
-  while(GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) != PB_PRESSED); // user feedback
-  while(GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == PB_PRESSED);
+  while(GPIO_PinInGet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0)) != PB_PRESSED); // user feedback
+  while(GPIO_PinInGet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0)) == PB_PRESSED);
 
   result_zero = IADCAverageConversion(NUM_SAMPLES);
 
@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file iadc_single_gpio_prs_ldma_pins.h
+ * @brief IADC input, LED and button pins of each board supported by the
+ * example.  The table has no device dependencies, so tools/pins_check.c
+ * checks it on a PC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef IADC_SINGLE_GPIO_PRS_LDMA_PINS_H
+#define IADC_SINGLE_GPIO_PRS_LDMA_PINS_H
+
+#include "bsp_route.h"
+
+/*
+ * The IADC input and the button that triggers the conversions through
+ * the PRS work in EM2, so they must be on port A or B.  The button is
+ * push button 0, except on xG21, where PB0 is on PD02 and PA05 is
+ * jumpered to it.  The LED is toggled from the LDMA interrupt, in EM0,
+ * and can be on any port; xG27 uses LED1, as LED0 shares PB00 with the
+ * button.
+ *
+ *                           INPUT_0  LED      BUTTON
+ */
+#define SINGLE_BOARD_XG21   ((A, 0), (B, 0), (A, 5))
+#define SINGLE_BOARD_XG22   ((A, 5), (D, 2), (B, 0))
+#define SINGLE_BOARD_XG23   ((A, 5), (B, 2), (B, 1))
+#define SINGLE_BOARD_XG24   ((A, 5), (B, 2), (B, 1))
+#define SINGLE_BOARD_XG25   ((A, 5), (C, 6), (B, 0))
+#define SINGLE_BOARD_XG27   ((A, 5), (B, 1), (B, 0))
+#define SINGLE_BOARD_XG28   ((A, 5), (B, 2), (B, 1))
+
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG)              \
+  && (_SILICON_LABS_32B_SERIES_2_CONFIG == 6                \
+      || _SILICON_LABS_32B_SERIES_2_CONFIG > 8)
+#error "No pins for this device in iadc_single_gpio_prs_ldma_pins.h"
+#endif
+
+// Checks of a row: real, distinct pins, and EM2 pins where needed
+#define SINGLE_PIN(n, dev)          BSP_COLUMN(n, SINGLE_BOARD_##dev)
+#define SINGLE_BOARD_CHECK(dev)                                               \
+  BSP_CHECK(single_##dev##_input0_em2,                                        \
+            BSP_PIN_VALID(SINGLE_PIN(0, dev))                                 \
+            && BSP_PIN_EM2(SINGLE_PIN(0, dev)));                              \
+  BSP_CHECK(single_##dev##_led_valid, BSP_PIN_VALID(SINGLE_PIN(1, dev)));     \
+  BSP_CHECK(single_##dev##_button_em2,                                        \
+            BSP_PIN_VALID(SINGLE_PIN(2, dev))                                 \
+            && BSP_PIN_EM2(SINGLE_PIN(2, dev)));                              \
+  BSP_CHECK(single_##dev##_pins_differ,                                       \
+            BSP_PIN_DIFFERENT(SINGLE_PIN(0, dev), SINGLE_PIN(1, dev))         \
+            && BSP_PIN_DIFFERENT(SINGLE_PIN(0, dev), SINGLE_PIN(2, dev))      \
+            && BSP_PIN_DIFFERENT(SINGLE_PIN(1, dev), SINGLE_PIN(2, dev)))
+
+// Every row is checked in every build, whichever device it is for
+SINGLE_BOARD_CHECK(XG21);
+SINGLE_BOARD_CHECK(XG22);
+SINGLE_BOARD_CHECK(XG23);
+SINGLE_BOARD_CHECK(XG24);
+SINGLE_BOARD_CHECK(XG25);
+SINGLE_BOARD_CHECK(XG27);
+SINGLE_BOARD_CHECK(XG28);
+
+#endif // IADC_SINGLE_GPIO_PRS_LDMA_PINS_H
@@ -1,9 +1,10 @@
 /***************************************************************************//**
+ * @file main.c
  * @brief Use the IADC to take repeated non-blocking measurements on single
  * input which in turn triggers the LDMA to transfer the IADC measurement to
  * memory, all while remaining in EM2. IADC conversion is triggered through GPIO
  * via PRS. After NUM_SAMPLES conversions the LDMA will trigger an interrupt
- * from EM2 and toggle LED0 on the WSTK.
+ * from EM2 and toggle an LED on the WSTK.
  *******************************************************************************
  * # License
  * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
@@ -46,7 +47,7 @@
 #include "em_ldma.h"
 #include "em_prs.h"
 
-#include "bsp.h"
+#include "iadc_single_gpio_prs_ldma_pins.h"
 
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
@@ -57,23 +58,22 @@
 #define CLK_ADC_FREQ              10000000 // CLK_ADC - 10 MHz max in normal mode
 
 /*
- * Specify the IADC input using the IADC_PosInput_t typedef.  This
- * must be paired with a corresponding macro definition that allocates
- * the corresponding ABUS to the IADC.  These are...
- *
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
- *
- * ...for port A, port B, and port C/D pins, even and odd, respectively.
+ * Pins of the board being built.  The IADC input also needs its half
+ * of the analog bus of its port (ABUS, BBUS or CDBUS, even or odd pins)
+ * allocated to ADC0; BSP_BUSALLOC() picks it from the pin.
  */
-#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortAPin5;
+#define IADC_INPUT_0              BSP_COLUMN(0, BSP_BOARD(SINGLE_BOARD_))
+
+// LED toggled when the transfers are complete (reversed on BRD4194A)
+#define LED_OUTPUT                BSP_COLUMN(1, BSP_BOARD(SINGLE_BOARD_))
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_7)
+#define LED_OFF                   1
+#else
+#define LED_OFF                   0
+#endif
 
-#define IADC_INPUT_0_BUS          ABUSALLOC
-#define IADC_INPUT_0_BUSALLOC     GPIO_ABUSALLOC_AODD0_ADC0
+// GPIO conversion trigger input (works in EM2; requires port A/B GPIO)
+#define BUTTON_0                  BSP_COLUMN(2, BSP_BOARD(SINGLE_BOARD_))
 
 // Use specified LDMA/PRS channel
 #define IADC_LDMA_CH              0
@@ -103,17 +103,22 @@ uint32_t singleBuffer[NUM_SAMPLES];
  *****************************************************************************/
 void initGPIO (void)
 {
-  // Enable GPIO clock branch
+  /*
+   * Enable GPIO clock branch.  On EFR32xG21 devices, CMU_ClockEnable()
+   * calls have no effect as clocks are enabled on demand.
+   */
   CMU_ClockEnable(cmuClock_GPIO, true);
 
-  // Configure LED0 as output
-  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  // Configure the LED as output, off
+  GPIO_PinModeSet(BSP_PORT(LED_OUTPUT), BSP_PIN(LED_OUTPUT),
+                  gpioModePushPull, LED_OFF);
 
-  // Configure pushbutton 0 as input and enable interrupt
-  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
-  GPIO_ExtIntConfig(BSP_GPIO_PB0_PORT,
-                    BSP_GPIO_PB0_PIN,
-                    BSP_GPIO_PB0_PIN,
+  // Configure the button as input and enable interrupt
+  GPIO_PinModeSet(BSP_PORT(BUTTON_0), BSP_PIN(BUTTON_0),
+                  gpioModeInputPullFilter, 1);
+  GPIO_ExtIntConfig(BSP_PORT(BUTTON_0),
+                    BSP_PIN(BUTTON_0),
+                    BSP_PIN(BUTTON_0),
                     false,
                     false,
                     false);
@@ -128,7 +133,8 @@ void initPRS (void)
   CMU_ClockEnable(cmuClock_PRS, true);
 
   /* Set up PRS GPIO and IADC as producer and consumer respectively */
-  PRS_SourceAsyncSignalSet(PRS_CHANNEL, PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO, BSP_GPIO_PB0_PIN);
+  PRS_SourceAsyncSignalSet(PRS_CHANNEL, PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO,
+                           BSP_PIN(BUTTON_0));
   PRS_ConnectConsumer(PRS_CHANNEL, prsTypeAsync, prsConsumerIADC0_SINGLETRIGGER);
 }
 
@@ -220,11 +226,11 @@ void initIADC (void)
   initSingle.fifoDmaWakeup = true;
   initSingle.start = true;
 
-  initSingleInput.posInput   = IADC_INPUT_0_PORT_PIN;
+  initSingleInput.posInput   = BSP_IADC_INPUT(IADC_INPUT_0);
   initSingleInput.negInput   = iadcNegInputGnd;
 
   // Allocate the analog bus for ADC0 inputs
-  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_0) |= BSP_BUSALLOC(IADC_INPUT_0, ADC0);
 
   // Initialize IADC
   IADC_init(IADC0, &init, &initAllConfigs);
@@ -270,8 +276,8 @@ void LDMA_IRQHandler(void)
   // Clear interrupt flags
   LDMA_IntClear(LDMA_IF_DONE0);
 
-  // Toggle LED0 to notify that transfers are complete
-  GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  // Toggle the LED to notify that transfers are complete
+  GPIO_PinOutToggle(BSP_PORT(LED_OUTPUT), BSP_PIN(LED_OUTPUT));
 }
 
 /**************************************************************************//**
@@ -42,6 +42,7 @@
 #include "em_gpio.h"
 #include "em_letimer.h"
 #include "bsp.h"
+#include "bsp_route.h"
 
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
@@ -221,9 +222,9 @@ void initLetimer(void)
   letimerInit.ufoa0 = letimerUFOAToggle;
   letimerInit.repMode = letimerRepeatFree;
 
-  // Enable LETIMER0 output0
-  GPIO->LETIMERROUTE.ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
-  GPIO->LETIMERROUTE.OUT0ROUTE = \
+  // Enable LETIMER0 output0; the route is LETIMERROUTE[0] on xG21 and xG22
+  GPIO->BSP_GPIO_ROUTE(LETIMER0).ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
+  GPIO->BSP_GPIO_ROUTE(LETIMER0).OUT0ROUTE = \
       (LETIMER_OUTPUT_0_PORT << _GPIO_LETIMER_OUT0ROUTE_PORT_SHIFT) \
       | (LETIMER_OUTPUT_0_PIN << _GPIO_LETIMER_OUT0ROUTE_PIN_SHIFT);
 
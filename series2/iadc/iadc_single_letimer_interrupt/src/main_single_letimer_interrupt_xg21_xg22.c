@@ -1,296 +0,0 @@
-/***************************************************************************//**
- * @file main_single_letimer_interrupt.c
- * @brief Use the IADC to take repeated nonblocking measurements on single
- * input, requested periodically by LETIMER interrupt
- *******************************************************************************
- * # License
- * <b>Copyright 2020 Silicon Laboratories Inc. www.silabs.com</b>
- *******************************************************************************
- *
- * SPDX-License-Identifier: Zlib
- *
- * The licensor of this software is Silicon Laboratories Inc.
- *
- * This software is provided 'as-is', without any express or implied
- * warranty. In no event will the authors be held liable for any damages
- * arising from the use of this software.
- *
- * Permission is granted to anyone to use this software for any purpose,
- * including commercial applications, and to alter it and redistribute it
- * freely, subject to the following restrictions:
- *
- * 1. The origin of this software must not be misrepresented; you must not
- *    claim that you wrote the original software. If you use this software
- *    in a product, an acknowledgment in the product documentation would be
- *    appreciated but is not required.
- * 2. Altered source versions must be plainly marked as such, and must not be
- *    misrepresented as being the original software.
- * 3. This notice may not be removed or altered from any source distribution.
- *
- *******************************************************************************
- * # Evaluation Quality
- * This code has been minimally tested to ensure that it builds and is suitable 
- * as a demonstration for evaluation purposes only. This code will be maintained
- * at the sole discretion of Silicon Labs.
- ******************************************************************************/
-
-#include <stdio.h>
-#include "em_device.h"
-#include "em_chip.h"
-#include "em_core.h"
-#include "em_cmu.h"
-#include "em_emu.h"
-#include "em_iadc.h"
-#include "em_gpio.h"
-#include "em_letimer.h"
-#include "bsp.h"
-
-/*******************************************************************************
- *******************************   DEFINES   ***********************************
- ******************************************************************************/
-
-// Set CLK_ADC to 10MHz
-#define CLK_SRC_ADC_FREQ          20000000 // CLK_SRC_ADC
-#define CLK_ADC_FREQ              10000000 // CLK_ADC - 10MHz max in normal mode
-
-/*
- * Specify the IADC input using the IADC_PosInput_t typedef.  This
- * must be paired with a corresponding macro definition that allocates
- * the corresponding ABUS to the IADC.  These are...
- *
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
- *
- * ...for port A, port B, and port C/D pins, even and odd, respectively.
- */
-#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortAPin5;
-
-#define IADC_INPUT_0_BUS          ABUSALLOC
-#define IADC_INPUT_0_BUSALLOC     GPIO_ABUSALLOC_AODD0_ADC0
-
-// Desired LETIMER frequency in Hz
-#define LETIMER_FREQ              1
-
-// LETIMER GPIO toggle port/pin (toggled in EM2; requires port A/B GPIO)
-#define LETIMER_OUTPUT_0_PORT     gpioPortB
-#define LETIMER_OUTPUT_0_PIN      1
-
-/*
- * This example enters EM2 in the infinite while loop; Setting this define to 1
- * enables debug connectivity in the EMU_CTRL register, which will consume about
- * 0.5uA additional supply current
- */
-#define EM2DEBUG                  1
-
-/*******************************************************************************
- ***************************   GLOBAL VARIABLES   ******************************
- ******************************************************************************/
-
-// Stores latest IADC sample and conversion to Volts
-static volatile IADC_Result_t sample;
-static volatile double singleResult;    // Volts
-
-/**************************************************************************//**
- * @brief  GPIO Initializer
- *****************************************************************************/
-void initGPIO (void)
-{
-  // Enable GPIO clock branch
-  CMU_ClockEnable(cmuClock_GPIO, true);
-  /* Note: For EFR32xG21 radio devices, library function calls to 
-   * CMU_ClockEnable() have no effect as oscillators are automatically turned
-   * on/off based on demand from the peripherals; CMU_ClockEnable() is a dummy
-   * function for EFR32xG21 for library consistency/compatibility.
-   */
-   
-  // Configure LED0/LETIMER as outputs
-  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
-  GPIO_PinModeSet(LETIMER_OUTPUT_0_PORT, LETIMER_OUTPUT_0_PIN, gpioModePushPull, 0);
-}
-
-/**************************************************************************//**
- * @brief  IADC Initializer
- *****************************************************************************/
-void initIADC (void)
-{
-  // Declare init structs
-  IADC_Init_t init = IADC_INIT_DEFAULT;
-  IADC_AllConfigs_t initAllConfigs = IADC_ALLCONFIGS_DEFAULT;
-  IADC_InitSingle_t initSingle = IADC_INITSINGLE_DEFAULT;
-  IADC_SingleInput_t initSingleInput = IADC_SINGLEINPUT_DEFAULT;
-
-  // Enable IADC0 clock branch
-  CMU_ClockEnable(cmuClock_IADC0, true);
-
-  // Reset IADC to reset configuration in case it has been modified by
-  // other code
-  IADC_reset(IADC0);
-
-  // Select clock for IADC
-  CMU_ClockSelectSet(cmuClock_IADCCLK, cmuSelect_FSRCO);  // FSRCO - 20MHz
-
-  // Modify init structs and initialize
-  init.warmup = iadcWarmupNormal;
-
-  // Set the HFSCLK prescale value here
-  init.srcClkPrescale = IADC_calcSrcClkPrescale(IADC0, CLK_SRC_ADC_FREQ, 0);
-
-  // Configuration 0 is used by both scan and single conversions by default
-  // Use internal bandgap (supply voltage in mV) as reference
-  initAllConfigs.configs[0].reference = iadcCfgReferenceInt1V2;
-  initAllConfigs.configs[0].vRef = 1210;
-  initAllConfigs.configs[0].analogGain = iadcCfgAnalogGain0P5x;
-
-  // Divides CLK_SRC_ADC to set the CLK_ADC frequency
-  initAllConfigs.configs[0].adcClkPrescale = IADC_calcAdcClkPrescale(IADC0,
-                                             CLK_ADC_FREQ,
-                                             0,
-                                             iadcCfgModeNormal,
-                                             init.srcClkPrescale);
-
-  // Assign pins to positive and negative inputs in differential mode
-  initSingleInput.posInput   = IADC_INPUT_0_PORT_PIN;
-  initSingleInput.negInput   = iadcNegInputGnd;
-
-  // Allocate the analog bus for ADC0 inputs
-  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
-
-  // Initialize IADC
-  IADC_init(IADC0, &init, &initAllConfigs);
-
-  // Initialize Single
-  IADC_initSingle(IADC0, &initSingle, &initSingleInput);
-
-  // Clear any previous interrupt flags
-  IADC_clearInt(IADC0, _IADC_IF_MASK);
-
-  // Enable single done interrupts
-  IADC_enableInt(IADC0, IADC_IEN_SINGLEDONE);
-
-  // Enable ADC interrupts
-  NVIC_ClearPendingIRQ(IADC_IRQn);
-  NVIC_EnableIRQ(IADC_IRQn);
-}
-
-/**************************************************************************//**
- * @brief  IADC Handler
- *****************************************************************************/
-void IADC_IRQHandler(void)
-{
-  uint32_t flags = IADC_getInt(IADC0);
-
-  // Toggle GPIO
-  GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
-
-  // Read data from the FIFO
-  sample = IADC_pullSingleFifoResult(IADC0);
-
-  // For single-ended the result range is 0 to +Vref, i.e., 12 bits for the
-  // conversion value.
-  singleResult = sample.data * 2.42 / 0xFFF;
-
-  // Clear IADC interrupt flags
-  IADC_clearInt(IADC0, flags);
-}
-
-/**************************************************************************//**
- * @brief Clock initialization
- *****************************************************************************/
-void initClock(void)
-{
-  CMU_LFXOInit_TypeDef lfxoInit = CMU_LFXOINIT_DEFAULT;
-
-  // Select LFXO for the LETIMER
-  CMU_LFXOInit(&lfxoInit);
-  CMU_ClockSelectSet(cmuClock_EM23GRPACLK, cmuSelect_LFXO);
-}
-
-/**************************************************************************//**
- * @brief LETIMER initialization
- *****************************************************************************/
-void initLetimer(void)
-{
-  LETIMER_Init_TypeDef letimerInit = LETIMER_INIT_DEFAULT;
-
-  // Enable LETIMER0 clock tree
-  CMU_ClockEnable(cmuClock_LETIMER0, true);
-
-  // Calculate the top value (frequency) based on clock source
-  uint32_t topValue = CMU_ClockFreqGet(cmuClock_LETIMER0) / LETIMER_FREQ;
-
-  // Reload top on underflow, PWM output, and run in free mode
-  letimerInit.comp0Top = true;
-  letimerInit.topValue = topValue;
-  letimerInit.ufoa0 = letimerUFOAToggle;
-  letimerInit.repMode = letimerRepeatFree;
-
-  // Enable LETIMER0 output0
-  GPIO->LETIMERROUTE[0].ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
-  GPIO->LETIMERROUTE[0].OUT0ROUTE = \
-      (LETIMER_OUTPUT_0_PORT << _GPIO_LETIMER_OUT0ROUTE_PORT_SHIFT) \
-      | (LETIMER_OUTPUT_0_PIN << _GPIO_LETIMER_OUT0ROUTE_PIN_SHIFT);
-
-  // Initialize LETIMER
-  LETIMER_Init(LETIMER0, &letimerInit);
-
-  // Clear any previous interrupt flags
-  LETIMER_IntClear(LETIMER0, _LETIMER_IF_MASK);
-
-  // Enable underflow interrupts
-  LETIMER_IntEnable(LETIMER0, LETIMER_IEN_UF);
-
-  // Enable LETIMER interrupts
-  NVIC_ClearPendingIRQ(LETIMER0_IRQn);
-  NVIC_EnableIRQ(LETIMER0_IRQn);
-}
-
-/**************************************************************************//**
- * @brief  LETIMER Handler
- *****************************************************************************/
-void LETIMER0_IRQHandler(void)
-{
-  uint32_t flags = LETIMER_IntGet(LETIMER0);
-
-  // Trigger an IADC single conversion
-  IADC_command(IADC0, iadcCmdStartSingle);
-
-  // Clear LETIMER interrupt flags
-  LETIMER_IntClear(LETIMER0, flags);
-}
-
-/**************************************************************************//**
- * @brief  Main function
- *****************************************************************************/
-int main(void)
-{
-  CHIP_Init();
-
-  // Initialize GPIO
-  initGPIO();
-
-  // Initialize the IADC
-  initIADC();
-
-  // Initialize LFXO
-  initClock();
-
-  // Initialize the LETIMER
-  initLetimer();
-
-#ifdef EM2DEBUG
-#if (EM2DEBUG == 1)
-  // Enable debug connectivity in EM2
-  EMU->CTRL_SET = EMU_CTRL_EM2DBGEN;
-#endif
-#endif
-
-  while (1)
-  {
-    // Enter EM2 sleep
-    EMU_EnterEM2(true);
-  }
-}
@@ -1,5 +1,5 @@
 /***************************************************************************//**
- * @file main_single_letimer_prs_ldma.c
+ * @file main.c
  *
  * @brief Use the IADC to take repeated, non-blocking measurements on
  * a single channel.  The LETIMER triggers conversions via the PRS,
@@ -49,6 +49,7 @@
 #include "em_prs.h"
 
 #include "bspconfig.h"
+#include "bsp_route.h"
 
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
@@ -277,10 +278,11 @@ void initLETIMER(void)
   letimerInit.ufoa0 = letimerUFOAPulse;
   letimerInit.repMode = letimerRepeatFree;
 
-  // Enable LETIMER output 0
-  GPIO->LETIMERROUTE[0].ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
-  GPIO->LETIMERROUTE[0].OUT0ROUTE = (LETIMER_OUTPUT_0_PORT << _GPIO_LETIMER_OUT0ROUTE_PORT_SHIFT) |
-                                    (LETIMER_OUTPUT_0_PIN << _GPIO_LETIMER_OUT0ROUTE_PIN_SHIFT);
+  // Enable LETIMER output 0; the route is LETIMERROUTE[0] on xG21 and xG22
+  GPIO->BSP_GPIO_ROUTE(LETIMER0).ROUTEEN = GPIO_LETIMER_ROUTEEN_OUT0PEN;
+  GPIO->BSP_GPIO_ROUTE(LETIMER0).OUT0ROUTE =
+    (LETIMER_OUTPUT_0_PORT << _GPIO_LETIMER_OUT0ROUTE_PORT_SHIFT)
+    | (LETIMER_OUTPUT_0_PIN << _GPIO_LETIMER_OUT0ROUTE_PIN_SHIFT);
 
   // Initialize LETIMER
   LETIMER_Init(LETIMER0, &letimerInit);
@@ -0,0 +1,330 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Records IADC single conversions continuously into LDMA ring buffers
+ * and, when a result leaves the window compare bounds, keeps the samples
+ * before and after it as a capture, like the single-shot trigger of an
+ * oscilloscope.  Captures are handed to the main loop in place.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_emu.h"
+#include "em_iadc.h"
+#include "em_ldma.h"
+#include "em_gpio.h"
+
+#include "bspconfig.h"
+#include "wcap.h"
+
+/*******************************************************************************
+ *******************************   DEFINES   ***********************************
+ ******************************************************************************/
+
+// Set CLK_ADC to 1 MHz (this corresponds to a sample rate of 100 ksps)
+#define CLK_SRC_ADC_FREQ    20000000  // CLK_SRC_ADC
+#define CLK_ADC_FREQ        1000000   // CLK_ADC
+
+// Samples kept before the trigger sample and from it on: 2.56 ms and 5.12 ms
+#define PRE_TRIGGER         256
+#define POST_TRIGGER        512
+
+// Window compare bounds, 12-bit; results at or outside them trigger
+#define WINDOW_LOWER_BOUND  0x400     // 0.605V
+#define WINDOW_UPPER_BOUND  0xC00     // 1.815V
+
+/*
+ * Specify the IADC input using the IADC_PosInput_t typedef.  This
+ * must be paired with a corresponding macro definition that allocates
+ * the corresponding ABUS to the IADC.  These are...
+ *
+ * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
+ * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
+ * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
+ * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
+ * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
+ * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
+ *
+ * ...for port A, port B, and port C/D pins, even and odd, respectively.
+ * The input must be on port A or B to be converted in EM2.
+ */
+#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortBPin0;
+
+#define IADC_INPUT_0_BUS          BBUSALLOC
+#define IADC_INPUT_0_BUSALLOC     GPIO_BBUSALLOC_BEVEN0_ADC0
+
+// Use specified LDMA channel
+#define IADC_LDMA_CH              0
+
+/*
+ * This example enters EM2 in the main while() loop. Setting this
+ * #define to 1 enables debug connectivity in EM2, which increases
+ * current consumption by about 0.5 uA.
+ */
+#define EM2DEBUG                  1
+
+/*******************************************************************************
+ ***************************   GLOBAL VARIABLES   *******************************
+ ******************************************************************************/
+
+// Capture rings; one is recorded while the main loop reads the other
+static uint32_t ring0[1024];
+static uint32_t ring1[1024];
+
+static WCAP_Handle_TypeDef capture;
+
+// Summary of the last capture, for viewing in the debugger
+volatile uint32_t captureCount;
+volatile uint16_t captureTriggerValue;
+volatile uint16_t captureMin;
+volatile uint16_t captureMax;
+volatile uint32_t captureOutside;   // Samples outside the window
+volatile uint32_t captureOverruns;  // Faults missed while both rings were full
+
+/**************************************************************************//**
+ * @brief  GPIO initialization
+ *****************************************************************************/
+void initGPIO(void)
+{
+  /*
+   * On EFR32xG21 devices, CMU_ClockEnable() calls have no effect as
+   * clocks are enabled/disabled on-demand in response to peripheral
+   * requests.  Deleting such lines is safe on xG21 devices and will
+   * provide a small reduction in code size.
+   */
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  // Configure LED0 as output; toggled on each capture
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+}
+
+/**************************************************************************//**
+ * @brief  IADC initialization
+ *****************************************************************************/
+void initIADC(void)
+{
+  // Declare initialization structures
+  IADC_Init_t init = IADC_INIT_DEFAULT;
+  IADC_AllConfigs_t initAllConfigs = IADC_ALLCONFIGS_DEFAULT;
+  IADC_InitSingle_t initSingle = IADC_INITSINGLE_DEFAULT;
+  IADC_SingleInput_t initSingleInput = IADC_SINGLEINPUT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_IADC0, true);
+
+  // Use the FSRC0 as the IADC clock so it can run in EM2
+  CMU_ClockSelectSet(cmuClock_IADCCLK, cmuSelect_FSRCO);
+
+  // Conversions are back to back, so keep the IADC warm
+  init.warmup = iadcWarmupKeepWarm;
+
+  // Set the HFSCLK prescale value here
+  init.srcClkPrescale = IADC_calcSrcClkPrescale(IADC0, CLK_SRC_ADC_FREQ, 0);
+
+  /*
+   * The window compare flag is set for results outside the window when
+   * the greater-than-or-equal bound is above the less-than-or-equal
+   * bound.  Both are 16-bit left-justified; the 12-bit result is
+   * compared to their upper 12 bits.
+   */
+  init.greaterThanEqualThres = WINDOW_UPPER_BOUND << 4;
+  init.lessThanEqualThres = WINDOW_LOWER_BOUND << 4;
+
+  /*
+   * Configuration 0 is used by both scan and single conversions by
+   * default.  Use internal bandgap as the reference and specify the
+   * reference voltage in mV.
+   */
+  initAllConfigs.configs[0].reference = iadcCfgReferenceInt1V2;
+  initAllConfigs.configs[0].vRef = 1210;
+  initAllConfigs.configs[0].osrHighSpeed = iadcCfgOsrHighSpeed2x;
+  initAllConfigs.configs[0].analogGain = iadcCfgAnalogGain0P5x;
+
+  /*
+   * With the default 2x oversampling rate (OSRHS)...
+   *
+   * conversion time = ((4 * OSRHS) + 2) / fCLK_ADC
+   *
+   * ...which is 10 us, or 100 ksps, at 1 MHz.
+   */
+  initAllConfigs.configs[0].adcClkPrescale = IADC_calcAdcClkPrescale(IADC0,
+                                                                     CLK_ADC_FREQ,
+                                                                     0,
+                                                                     iadcCfgModeNormal,
+                                                                     init.srcClkPrescale);
+
+  /*
+   * Convert continuously once started and request the LDMA for every
+   * result, also in EM2, so that the capture has no gaps.
+   */
+  initSingle.triggerAction = iadcTriggerActionContinuous;
+  initSingle.dataValidLevel = iadcFifoCfgDvl1;
+  initSingle.fifoDmaWakeup = true;
+
+  // Single-ended input with window comparisons
+  initSingleInput.posInput = IADC_INPUT_0_PORT_PIN;
+  initSingleInput.negInput = iadcNegInputGnd;
+  initSingleInput.compare = true;
+
+  // Initialize IADC
+  IADC_init(IADC0, &init, &initAllConfigs);
+
+  // Initialize single conversions
+  IADC_initSingle(IADC0, &initSingle, &initSingleInput);
+
+  // Allocate the analog bus for ADC0 inputs
+  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
+
+  // The window compare interrupt is enabled by the capture when it arms
+  NVIC_ClearPendingIRQ(IADC_IRQn);
+  NVIC_EnableIRQ(IADC_IRQn);
+}
+
+/**************************************************************************//**
+ * @brief  LDMA and capture initialization
+ *****************************************************************************/
+void initCapture(void)
+{
+  static volatile uint32_t *const rings[WCAP_RINGS] = { ring0, ring1 };
+  LDMA_Init_t init = LDMA_INIT_DEFAULT;
+  WCAP_Init_TypeDef captureInit = WCAP_INIT_DEFAULT;
+
+  // Initialize LDMA with default configuration
+  LDMA_Init(&init);
+
+  captureInit.ringSize = sizeof(ring0) / sizeof(ring0[0]);
+  captureInit.preTrigger = PRE_TRIGGER;
+  captureInit.postTrigger = POST_TRIGGER;
+  captureInit.lowThreshold = WINDOW_LOWER_BOUND;
+  captureInit.highThreshold = WINDOW_UPPER_BOUND;
+  if (!WCAP_Init(&capture, &captureInit, rings)) {
+    while (1);
+  }
+
+  WCAP_CaptureStart(&capture, IADC_LDMA_CH);
+}
+
+/**************************************************************************//**
+ * @brief  LDMA Handler
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  WCAP_CaptureLdmaIRQ(&capture);
+}
+
+/**************************************************************************//**
+ * @brief  IADC Handler
+ *****************************************************************************/
+void IADC_IRQHandler(void)
+{
+  WCAP_CaptureCompareIRQ(&capture);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Summarize a capture, reading the samples where the LDMA left them.
+ *****************************************************************************/
+static void processCapture(const WCAP_Event_TypeDef *event)
+{
+  uint16_t min = 0xFFF, max = 0;
+  uint32_t outside = 0;
+  uint32_t i;
+
+  for (i = 0; i < event->count; i++) {
+    uint16_t value = WCAP_EventSample(event, i);
+
+    min = (value < min) ? value : min;
+    max = (value > max) ? value : max;
+    if (value <= WINDOW_LOWER_BOUND || value >= WINDOW_UPPER_BOUND) {
+      outside++;
+    }
+  }
+
+  captureTriggerValue = WCAP_EventSample(event, event->trigger);
+  captureMin = min;
+  captureMax = max;
+  captureOutside = outside;
+  captureCount = event->sequence + 1;
+  captureOverruns = capture.overruns;
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  WCAP_Event_TypeDef event;
+  CORE_DECLARE_IRQ_STATE;
+
+  CHIP_Init();
+
+  initGPIO();
+
+  initIADC();
+
+#ifdef EM2DEBUG
+#if (EM2DEBUG == 1)
+  // Enable debug connectivity in EM2
+  EMU->CTRL_SET = EMU_CTRL_EM2DBGEN;
+#endif
+#endif
+
+  initCapture();
+
+  // Start conversions
+  IADC_command(IADC0, iadcCmdStartSingle);
+
+  while (1) {
+    while (WCAP_CaptureGet(&capture, &event)) {
+      processCapture(&event);
+
+      // Toggle LED0 for each capture
+      GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+
+      // Give the ring back for the next capture
+      WCAP_CaptureRelease(&capture, &event);
+    }
+
+    /*
+     * Sleep until the window compare trips or a chunk completes.  A
+     * capture completed after the check above still wakes the core, as
+     * pending interrupts end WFI with interrupts masked.  Without this,
+     * a capture left in the queue could stop the recording for good.
+     */
+    CORE_ENTER_ATOMIC();
+    if (capture.readyCount == 0) {
+      EMU_EnterEM2(true);
+    }
+    CORE_EXIT_ATOMIC();
+  }
+}
@@ -0,0 +1,486 @@
+/***************************************************************************//**
+ * @file wcap.c
+ * @brief Window compare triggered IADC capture with pre- and post-trigger
+ * samples, recorded by the LDMA into circular buffers.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "wcap.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Samples written from ring index from up to ring index to.
+ *****************************************************************************/
+static uint32_t distance(const WCAP_Handle_TypeDef *h, uint32_t from,
+                         uint32_t to)
+{
+  return (to + h->config.ringSize - from) % h->config.ringSize;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   True if a result trips the window compare, as the IADC evaluates it.
+ *****************************************************************************/
+static bool outside(const WCAP_Handle_TypeDef *h, uint32_t value)
+{
+  return value <= h->config.lowThreshold || value >= h->config.highThreshold;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Make a ring the one the LDMA fills and collect history in it.
+ *****************************************************************************/
+static void startRing(WCAP_Handle_TypeDef *h, uint8_t ring)
+{
+  h->ringBusy[ring] = true;
+  h->active = ring;
+  h->state = wcapStateFilling;
+  h->lastIndex = 0;
+  h->filled = 0;
+  h->located = false;
+  h->guessed = false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Find the sample that tripped the window compare.
+ *
+ * @details
+ *   The interrupt runs a few samples after the trip, and the sample may
+ *   still be in the IADC FIFO, so the trip position is only approximate.
+ *   Every sample written since arming and before the trigger was inside the
+ *   window, so the trigger is the first sample outside it, searching from
+ *   searchDepth samples before the trip but not from before arming. If the
+ *   LDMA has written searchDepth samples past the trip without one, the
+ *   trip position is used.
+ *****************************************************************************/
+static void locate(WCAP_Handle_TypeDef *h, uint32_t writeIndex)
+{
+  const volatile uint32_t *ring = h->rings[h->active];
+  uint32_t depth = h->config.searchDepth;
+  uint32_t start, span, i;
+
+  // Without a chunk end since arming, the arm position is recent
+  if (!h->armAged && distance(h, h->armIndex, h->hitIndex) < depth) {
+    depth = distance(h, h->armIndex, h->hitIndex);
+  }
+  start = (h->hitIndex + h->config.ringSize - depth) % h->config.ringSize;
+  span = distance(h, start, writeIndex);
+
+  for (i = 0; i < span; i++) {
+    uint32_t k = (start + i) % h->config.ringSize;
+
+    if (outside(h, ring[k])) {
+      h->trigger = k;
+      h->located = true;
+      return;
+    }
+  }
+
+  if (distance(h, h->hitIndex, writeIndex) >= h->config.searchDepth) {
+    h->trigger = h->hitIndex;
+    h->located = true;
+    h->guessed = true;
+    h->unlocated++;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Post-trigger bookkeeping at a write position.
+ *****************************************************************************/
+static WCAP_Action_TypeDef collect(WCAP_Handle_TypeDef *h, uint32_t writeIndex)
+{
+  if (!h->located) {
+    locate(h, writeIndex);
+    if (!h->located) {
+      return wcapActionNone;
+    }
+  }
+  if (distance(h, h->trigger, writeIndex) >= h->config.postTrigger) {
+    return wcapActionComplete;
+  }
+  return wcapActionNone;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Check the configuration and reset the capture to collect history in
+ *   the first ring.
+ *
+ * @details
+ *   Once triggered, the capture is stopped at the first chunk end with
+ *   postTrigger samples written, so the LDMA writes up to chunkSize samples
+ *   more than needed; the ring must hold them, the pre- and post-trigger
+ *   samples and searchDepth samples of interrupt latency. The trigger search
+ *   relies on a chunk taking at least twice searchDepth samples.
+ *
+ * @param[in] rings
+ *   WCAP_RINGS buffers of init->ringSize words each.
+ *
+ * @return
+ *   false if the configuration cannot work.
+ *****************************************************************************/
+bool WCAP_Init(WCAP_Handle_TypeDef *handle,
+               const WCAP_Init_TypeDef *init,
+               volatile uint32_t *const rings[WCAP_RINGS])
+{
+  uint32_t i;
+
+  memset(handle, 0, sizeof(*handle));
+  if (init->chunkSize == 0
+      || init->chunkSize > WCAP_MAX_CHUNK
+      || init->ringSize % init->chunkSize != 0
+      || init->ringSize / init->chunkSize > WCAP_MAX_CHUNKS
+      || init->postTrigger == 0
+      || 2 * init->searchDepth > init->chunkSize
+      || init->preTrigger + init->postTrigger + init->chunkSize
+      + init->searchDepth > init->ringSize
+      || init->lowThreshold >= init->highThreshold) {
+    return false;
+  }
+
+  handle->config = *init;
+  for (i = 0; i < WCAP_RINGS; i++) {
+    handle->rings[i] = rings[i];
+  }
+  startRing(handle, 0);
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Bookkeeping after the LDMA finished a chunk.
+ *
+ * @details
+ *   While filling, the ring is armed once it holds preTrigger samples.
+ *   Once triggered, the capture is complete when postTrigger samples from
+ *   the trigger on have been written.
+ *
+ * @param[in] writeIndex
+ *   Ring index the LDMA writes next, read after clearing the chunk flag.
+ *****************************************************************************/
+WCAP_Action_TypeDef WCAP_ChunkDone(WCAP_Handle_TypeDef *handle,
+                                   uint32_t writeIndex)
+{
+  uint32_t delta = distance(handle, handle->lastIndex, writeIndex);
+
+  handle->lastIndex = writeIndex;
+  switch (handle->state) {
+    case wcapStateFilling:
+      handle->filled += delta;
+      if (handle->filled < handle->config.preTrigger) {
+        return wcapActionNone;
+      }
+      handle->state = wcapStateArmed;
+      handle->armIndex = writeIndex;
+      handle->armAged = false;
+      return wcapActionArm;
+
+    case wcapStateTriggered:
+      return collect(handle, writeIndex);
+
+    default:
+      return wcapActionNone;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Bookkeeping after the window compare tripped.
+ *
+ * @details
+ *   The caller disables the compare interrupt and enables the chunk
+ *   interrupt to collect the post-trigger samples.
+ *
+ * @param[in] writeIndex
+ *   Ring index the LDMA writes next.
+ *
+ * @param[in] chunkEnded
+ *   The LDMA finished a chunk since arming.
+ *****************************************************************************/
+WCAP_Action_TypeDef WCAP_Trip(WCAP_Handle_TypeDef *handle,
+                              uint32_t writeIndex,
+                              bool chunkEnded)
+{
+  if (handle->state != wcapStateArmed) {
+    return wcapActionNone;
+  }
+  handle->state = wcapStateTriggered;
+  handle->hitIndex = writeIndex;
+  handle->armAged = chunkEnded;
+  handle->located = false;
+  handle->guessed = false;
+  return collect(handle, writeIndex);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Hand out the ring of a completed capture, after the LDMA was stopped.
+ *
+ * @return
+ *   true if another ring is free; the caller restarts the LDMA on it.
+ *   Otherwise the capture stays idle until WCAP_Release().
+ *****************************************************************************/
+bool WCAP_Finish(WCAP_Handle_TypeDef *handle)
+{
+  const WCAP_Init_TypeDef *c = &handle->config;
+  WCAP_Event_TypeDef *event;
+  uint8_t next;
+
+  event = &handle->ready[(handle->readyHead + handle->readyCount) % WCAP_RINGS];
+  event->ring = handle->rings[handle->active];
+  event->ringSize = c->ringSize;
+  event->first = (handle->trigger + c->ringSize - c->preTrigger) % c->ringSize;
+  event->count = c->preTrigger + c->postTrigger;
+  event->trigger = c->preTrigger;
+  event->sequence = handle->captures++;
+  event->ringNumber = handle->active;
+  event->located = !handle->guessed;
+  handle->readyCount++;
+
+  for (next = 0; next < WCAP_RINGS && handle->ringBusy[next]; next++) {
+  }
+  if (next == WCAP_RINGS) {
+    handle->state = wcapStateIdle;
+    handle->overruns++;
+    return false;
+  }
+  startRing(handle, next);
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take the oldest completed capture.
+ *
+ * @details
+ *   The event refers to the samples in place; the ring is not written again
+ *   until the event is given back with WCAP_Release().
+ *****************************************************************************/
+bool WCAP_Get(WCAP_Handle_TypeDef *handle, WCAP_Event_TypeDef *event)
+{
+  if (handle->readyCount == 0) {
+    return false;
+  }
+  *event = handle->ready[handle->readyHead];
+  handle->readyHead = (handle->readyHead + 1) % WCAP_RINGS;
+  handle->readyCount--;
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Give back the ring of a capture taken with WCAP_Get().
+ *
+ * @return
+ *   true if the capture was idle and now fills the ring; the caller
+ *   restarts the LDMA on it.
+ *****************************************************************************/
+bool WCAP_Release(WCAP_Handle_TypeDef *handle,
+                  const WCAP_Event_TypeDef *event)
+{
+  handle->ringBusy[event->ringNumber] = false;
+  if (handle->state != wcapStateIdle) {
+    return false;
+  }
+  startRing(handle, event->ringNumber);
+  return true;
+}
+
+#if !defined(WCAP_HOST)
+#include "em_device.h"
+#include "em_core.h"
+#include "em_iadc.h"
+#include "em_ldma.h"
+
+// Chunk descriptors of each ring, linked in a loop
+static LDMA_Descriptor_t captureDesc[WCAP_RINGS][WCAP_MAX_CHUNKS];
+
+/**************************************************************************//**
+ * @brief
+ *   Ring index the LDMA writes next, from the channel's destination address.
+ *****************************************************************************/
+static uint32_t writeIndex(const WCAP_Handle_TypeDef *h)
+{
+  uint32_t offset = LDMA->CH[h->ldmaChannel].DST
+                    - (uint32_t)h->rings[h->active];
+
+  return (offset / sizeof(uint32_t)) % h->config.ringSize;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the LDMA at the beginning of the active ring.
+ *****************************************************************************/
+static void startLdma(const WCAP_Handle_TypeDef *h)
+{
+  LDMA_TransferCfg_t cfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_IADC0_IADC_SINGLE);
+  uint32_t chMask = 1UL << h->ldmaChannel;
+
+  // Results left in the FIFO while stopped are not contiguous with the new ones
+  while (IADC_getSingleFifoCnt(IADC0) > 0) {
+    (void)IADC_pullSingleFifoResult(IADC0);
+  }
+  LDMA_StartTransfer(h->ldmaChannel, &cfg, &captureDesc[h->active][0]);
+  LDMA_IntClear(chMask);
+  LDMA_IntEnable(chMask);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Stop the LDMA, hand out the capture and go on in the next ring.
+ *****************************************************************************/
+static void complete(WCAP_Handle_TypeDef *h)
+{
+  LDMA_StopTransfer(h->ldmaChannel);
+  if (WCAP_Finish(h)) {
+    startLdma(h);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start recording IADC single conversions into the rings.
+ *
+ * @details
+ *   Each ring is covered by ringSize / chunkSize descriptors linked in a
+ *   loop. Every descriptor raises the channel's done flag, but the interrupt
+ *   is only enabled while filling or triggered; while armed, the CPU only
+ *   wakes up for the window compare. LDMA_Init() must have been called, and
+ *   the IADC set up for continuous single conversions with window compare,
+ *   one result per LDMA request and DMA wake-up. The LDMA and IADC
+ *   interrupts must have the same priority.
+ *****************************************************************************/
+void WCAP_CaptureStart(WCAP_Handle_TypeDef *handle, unsigned int ldmaChannel)
+{
+  uint32_t chunk = handle->config.chunkSize;
+  uint32_t chunks = handle->config.ringSize / chunk;
+  uint32_t r, k;
+
+  handle->ldmaChannel = ldmaChannel;
+  for (r = 0; r < WCAP_RINGS; r++) {
+    for (k = 0; k < chunks; k++) {
+      int link = (k + 1 < chunks) ? 1 : 1 - (int)chunks;
+
+      captureDesc[r][k] = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_P2M_WORD(&IADC0->SINGLEFIFODATA,
+                                         handle->rings[r] + k * chunk,
+                                         chunk, link);
+      // Transfer on every result
+      captureDesc[r][k].xfer.ignoreSrec = 0;
+    }
+  }
+  startLdma(handle);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Call from LDMA_IRQHandler().
+ *****************************************************************************/
+void WCAP_CaptureLdmaIRQ(WCAP_Handle_TypeDef *handle)
+{
+  uint32_t chMask = 1UL << handle->ldmaChannel;
+
+  LDMA_IntClear(chMask);
+  switch (WCAP_ChunkDone(handle, writeIndex(handle))) {
+    case wcapActionArm:
+      // Results converted before arming must not trip
+      LDMA_IntDisable(chMask);
+      IADC_clearInt(IADC0, IADC_IF_SINGLECMP);
+      IADC_enableInt(IADC0, IADC_IEN_SINGLECMP);
+      break;
+
+    case wcapActionComplete:
+      complete(handle);
+      break;
+
+    default:
+      break;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Call from IADC_IRQHandler() on the window compare flag.
+ *****************************************************************************/
+void WCAP_CaptureCompareIRQ(WCAP_Handle_TypeDef *handle)
+{
+  uint32_t chMask = 1UL << handle->ldmaChannel;
+  bool chunkEnded = (LDMA_IntGet() & chMask) != 0;
+
+  IADC_disableInt(IADC0, IADC_IEN_SINGLECMP);
+  IADC_clearInt(IADC0, IADC_IF_SINGLECMP);
+  if (WCAP_Trip(handle, writeIndex(handle), chunkEnded)
+      == wcapActionComplete) {
+    complete(handle);
+  } else {
+    // A chunk flag raised while armed runs the LDMA handler at once
+    LDMA_IntEnable(chMask);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   WCAP_Get() for thread mode.
+ *****************************************************************************/
+bool WCAP_CaptureGet(WCAP_Handle_TypeDef *handle, WCAP_Event_TypeDef *event)
+{
+  bool got;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  got = WCAP_Get(handle, event);
+  CORE_EXIT_ATOMIC();
+  return got;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   WCAP_Release() for thread mode; restarts the LDMA if the capture was
+ *   idle.
+ *****************************************************************************/
+void WCAP_CaptureRelease(WCAP_Handle_TypeDef *handle,
+                         const WCAP_Event_TypeDef *event)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (WCAP_Release(handle, event)) {
+    startLdma(handle);
+  }
+  CORE_EXIT_ATOMIC();
+}
+#endif // !WCAP_HOST
@@ -0,0 +1,168 @@
+/***************************************************************************//**
+ * @file wcap.h
+ * @brief Window compare triggered IADC capture with pre- and post-trigger
+ * samples, recorded by the LDMA into circular buffers.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef WCAP_H
+#define WCAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of capture rings; one is filled while the other is handed out
+#define WCAP_RINGS          2
+
+/// Most LDMA descriptors (chunks) per ring
+#define WCAP_MAX_CHUNKS     16
+
+/// Most samples per chunk, i.e. per LDMA descriptor
+#define WCAP_MAX_CHUNK      2048
+
+/// Capture engine state
+typedef enum {
+  wcapStateIdle,        ///< No free ring; waiting for WCAP_Release()
+  wcapStateFilling,     ///< Collecting pre-trigger history, not armed
+  wcapStateArmed,       ///< Window compare interrupt enabled
+  wcapStateTriggered,   ///< Collecting post-trigger samples
+} WCAP_State_TypeDef;
+
+/// What the caller must do to the hardware after a bookkeeping step
+typedef enum {
+  wcapActionNone,       ///< Nothing
+  wcapActionArm,        ///< Clear and enable the window compare interrupt
+  wcapActionComplete,   ///< Stop the LDMA and call WCAP_Finish()
+} WCAP_Action_TypeDef;
+
+/// Capture configuration
+typedef struct {
+  uint32_t ringSize;      ///< Samples per ring
+  uint32_t chunkSize;     ///< Samples per LDMA descriptor; divides ringSize
+  uint32_t preTrigger;    ///< Samples kept before the trigger sample
+  uint32_t postTrigger;   ///< Samples kept from the trigger sample on
+  uint32_t searchDepth;   ///< Samples before the trip searched for the trigger
+  uint16_t lowThreshold;  ///< Results at or below this trigger, 12-bit
+  uint16_t highThreshold; ///< Results at or above this trigger, 12-bit
+} WCAP_Init_TypeDef;
+
+/// Default configuration: 1024-sample rings, 256 before and 512 after
+#define WCAP_INIT_DEFAULT                                             \
+  {                                                                   \
+    1024,     /* 1024 samples per ring */                             \
+    128,      /* Eight descriptors per ring */                        \
+    256,      /* 256 samples before the trigger */                    \
+    512,      /* 512 samples from the trigger on */                   \
+    16,       /* Trip handled within 16 samples */                    \
+    0x400,    /* Trigger at or below 0.605 V */                       \
+    0xC00,    /* Trigger at or above 1.815 V */                       \
+  }
+
+/// Completed capture; the samples stay in the ring until WCAP_Release()
+typedef struct {
+  const volatile uint32_t *ring;  ///< Ring holding the samples
+  uint32_t ringSize;              ///< Samples in the ring
+  uint32_t first;                 ///< Ring index of the first sample
+  uint32_t count;                 ///< preTrigger + postTrigger
+  uint32_t trigger;               ///< Index of the trigger sample in the capture
+  uint32_t sequence;              ///< Captures completed before this one
+  uint8_t  ringNumber;            ///< Ring to give back with WCAP_Release()
+  bool     located;               ///< false if the trigger sample was not found
+} WCAP_Event_TypeDef;
+
+/// Capture state; all fields are read-only for the application
+typedef struct {
+  WCAP_Init_TypeDef config;
+  volatile uint32_t *rings[WCAP_RINGS];
+  bool     ringBusy[WCAP_RINGS];  ///< Ring handed out or being filled
+  uint8_t  active;                ///< Ring the LDMA writes
+  WCAP_State_TypeDef state;
+  uint32_t lastIndex;             ///< Write index at the last step
+  uint32_t filled;                ///< Samples written since the ring started
+  uint32_t armIndex;              ///< Write index when armed
+  uint32_t hitIndex;              ///< Write index when the trip was handled
+  bool     armAged;               ///< A chunk ended between arming and the trip
+  bool     located;               ///< trigger is known
+  bool     guessed;               ///< trigger is the trip position, not found
+  uint32_t trigger;               ///< Ring index of the trigger sample
+
+  WCAP_Event_TypeDef ready[WCAP_RINGS];
+  uint8_t  readyHead;
+  uint8_t  readyCount;
+
+  uint32_t captures;              ///< Completed captures
+  uint32_t overruns;              ///< Captures that left no free ring
+  uint32_t unlocated;             ///< Trips without a trigger sample
+  unsigned int ldmaChannel;
+} WCAP_Handle_TypeDef;
+
+/***************************************************************************//**
+ * @brief
+ *   Sample i of a capture; the trigger sample is i == event->trigger.
+ ******************************************************************************/
+static inline uint16_t WCAP_EventSample(const WCAP_Event_TypeDef *event,
+                                        uint32_t i)
+{
+  return (uint16_t)event->ring[(event->first + i) % event->ringSize];
+}
+
+bool WCAP_Init(WCAP_Handle_TypeDef *handle,
+               const WCAP_Init_TypeDef *init,
+               volatile uint32_t *const rings[WCAP_RINGS]);
+WCAP_Action_TypeDef WCAP_ChunkDone(WCAP_Handle_TypeDef *handle,
+                                   uint32_t writeIndex);
+WCAP_Action_TypeDef WCAP_Trip(WCAP_Handle_TypeDef *handle,
+                              uint32_t writeIndex,
+                              bool chunkEnded);
+bool WCAP_Finish(WCAP_Handle_TypeDef *handle);
+bool WCAP_Get(WCAP_Handle_TypeDef *handle, WCAP_Event_TypeDef *event);
+bool WCAP_Release(WCAP_Handle_TypeDef *handle,
+                  const WCAP_Event_TypeDef *event);
+
+#if !defined(WCAP_HOST)
+void WCAP_CaptureStart(WCAP_Handle_TypeDef *handle, unsigned int ldmaChannel);
+void WCAP_CaptureLdmaIRQ(WCAP_Handle_TypeDef *handle);
+void WCAP_CaptureCompareIRQ(WCAP_Handle_TypeDef *handle);
+bool WCAP_CaptureGet(WCAP_Handle_TypeDef *handle, WCAP_Event_TypeDef *event);
+void WCAP_CaptureRelease(WCAP_Handle_TypeDef *handle,
+                         const WCAP_Event_TypeDef *event);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WCAP_H
@@ -0,0 +1,457 @@
+/***************************************************************************//**
+ * @file wcap_sim.c
+ * @brief Host test of the window compare capture bookkeeping.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DWCAP_HOST -I../src -o wcap_sim wcap_sim.c ../src/wcap.c
+ *   ./wcap_sim
+ *
+ * Synthetic waveforms are converted one sample at a time by a model of the
+ * IADC, its 4-entry FIFO and window compare, the LDMA writing the rings in
+ * chunks, and interrupts serviced 0 to 3 samples late. The handlers do what
+ * the device handlers in wcap.c do, and a model of the main loop takes each
+ * capture, holds it for a while and gives it back. The waveforms are:
+ *
+ *   spikes  1 to 3 sample spikes above the window
+ *   sags    50 to 400 sample drops below the window
+ *   stuck   long stretches outside the window
+ *   burst   spikes faster than the main loop gives the rings back
+ *
+ * Every capture is checked while it is held and again when it is given back:
+ * its samples must be the waveform around the trigger, contiguous, and the
+ * trigger the first sample outside the window since arming. Triggered
+ * captures must complete within a chunk of their post-trigger samples, and
+ * the burst waveform must run out of rings and recover.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wcap.h"
+
+#define SAMPLE_HZ       100000
+#define RUN_SAMPLES     2000000u        // 20 s per waveform
+#define RING_SIZE       1024
+#define FIFO_DEPTH      4
+#define MAX_LATENCY     3               // interrupt latency, in samples
+#define MAX_FAULTS      4096
+
+typedef struct {
+  uint64_t start;
+  uint32_t length;
+  uint16_t level;
+} Fault_TypeDef;
+
+typedef struct {
+  const char *name;
+  uint32_t gapLo, gapHi;                // samples between faults
+  uint32_t lengthLo, lengthHi;          // fault length
+  uint16_t level;                       // fault result
+  uint32_t holdLo, holdHi;              // main loop hold time
+  bool     expectOverruns;
+} Scenario_TypeDef;
+
+// Device model
+typedef struct {
+  uint64_t fifoTime[FIFO_DEPTH];
+  uint32_t fifoCount;
+  bool     cmpIF, cmpIEN;
+  bool     ldmaOn, ldmaIF, ldmaIEN;
+  uint8_t  ldmaRing;
+  uint32_t wpos;
+  int64_t  cmpDue, ldmaDue;             // sample the pending interrupt runs at
+} Hw_TypeDef;
+
+// Main loop model and results
+typedef struct {
+  bool     holding;
+  WCAP_Event_TypeDef event;
+  uint64_t releaseAt;
+  uint32_t expectSequence;
+  uint64_t armTime[WCAP_RINGS];         // first sample written after arming
+  uint64_t armConvert[WCAP_RINGS];      // first sample converted after arming
+  uint64_t triggeredAt;
+  uint32_t verified;
+  uint32_t wakeups;
+  uint32_t longest;                     // samples from trip to completion
+  uint32_t failures;
+} Sim_TypeDef;
+
+static Fault_TypeDef faults[MAX_FAULTS];
+static uint32_t faultCount;
+static uint32_t ringMem[WCAP_RINGS][RING_SIZE];
+static uint64_t slotTime[WCAP_RINGS][RING_SIZE];
+static WCAP_Handle_TypeDef wcap;
+static Hw_TypeDef hw;
+static Sim_TypeDef sim;
+static uint64_t now;
+static uint32_t seed = 12345;
+
+static uint32_t between(uint32_t lo, uint32_t hi)
+{
+  seed = seed * 1103515245u + 12345u;
+  return lo + (seed >> 8) % (hi - lo + 1);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   IADC result of sample t: a 50 Hz sine inside the window with noise,
+ *   unless t falls in a fault.
+ ******************************************************************************/
+static uint16_t wave(uint64_t t)
+{
+  uint32_t lo = 0, hi = faultCount, h;
+  uint32_t phase = (uint32_t)(t % 2000);
+  int32_t value;
+
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+
+    if (faults[mid].start + faults[mid].length <= t) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  if (lo < faultCount && faults[lo].start <= t) {
+    return faults[lo].level;
+  }
+
+  // Triangle approximation of the sine keeps the model integer-only
+  value = phase < 1000 ? (int32_t)phase : 2000 - (int32_t)phase;
+  h = (uint32_t)(t * 2654435761u) >> 24;
+  return (uint16_t)(0x500 + value * 0x600 / 1000 + (int32_t)(h % 17) - 8);
+}
+
+static bool outside(uint16_t value)
+{
+  return value <= wcap.config.lowThreshold
+         || value >= wcap.config.highThreshold;
+}
+
+static void buildFaults(const Scenario_TypeDef *s)
+{
+  uint64_t t = 5000;
+
+  faultCount = 0;
+  while (faultCount < MAX_FAULTS) {
+    t += between(s->gapLo, s->gapHi);
+    if (t >= RUN_SAMPLES) {
+      break;
+    }
+    faults[faultCount].start = t;
+    faults[faultCount].length = between(s->lengthLo, s->lengthHi);
+    faults[faultCount].level = s->level;
+    t += faults[faultCount].length;
+    faultCount++;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   LDMA started on the active ring, as startLdma() in wcap.c.
+ ******************************************************************************/
+static void startLdma(void)
+{
+  hw.fifoCount = 0;
+  hw.ldmaRing = wcap.active;
+  hw.wpos = 0;
+  hw.ldmaOn = true;
+  hw.ldmaIF = false;
+  hw.ldmaIEN = true;
+}
+
+static void complete(void)
+{
+  sim.longest = (uint32_t)(now - sim.triggeredAt) > sim.longest
+                ? (uint32_t)(now - sim.triggeredAt) : sim.longest;
+  hw.ldmaOn = false;
+  hw.ldmaIEN = false;
+  if (WCAP_Finish(&wcap)) {
+    startLdma();
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Model of WCAP_CaptureLdmaIRQ().
+ ******************************************************************************/
+static void ldmaHandler(void)
+{
+  sim.wakeups++;
+  hw.ldmaIF = false;
+  switch (WCAP_ChunkDone(&wcap, hw.wpos)) {
+    case wcapActionArm:
+      hw.ldmaIEN = false;
+      hw.cmpIF = false;
+      hw.cmpIEN = true;
+      sim.armTime[wcap.active] = hw.fifoCount ? hw.fifoTime[0] : now + 1;
+      sim.armConvert[wcap.active] = now + 1;
+      break;
+
+    case wcapActionComplete:
+      complete();
+      break;
+
+    default:
+      break;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Model of WCAP_CaptureCompareIRQ().
+ ******************************************************************************/
+static void compareHandler(void)
+{
+  bool chunkEnded = hw.ldmaIF;
+
+  sim.wakeups++;
+  hw.cmpIEN = false;
+  hw.cmpIF = false;
+  sim.triggeredAt = now;
+  if (WCAP_Trip(&wcap, hw.wpos, chunkEnded) == wcapActionComplete) {
+    complete();
+  } else {
+    hw.ldmaIEN = true;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Check a capture against the waveform.
+ ******************************************************************************/
+static void verify(const WCAP_Event_TypeDef *e, const char *when)
+{
+  uint32_t r = e->ringNumber, i;
+  uint64_t trigger = slotTime[r][(e->first + e->trigger) % RING_SIZE];
+  uint64_t s;
+  int bad = 0;
+
+  if (!e->located || e->count != wcap.config.preTrigger
+      + wcap.config.postTrigger || trigger < e->trigger) {
+    bad = 1;
+  }
+  for (i = 0; !bad && i < e->count; i++) {
+    uint64_t t = trigger - e->trigger + i;
+
+    if (slotTime[r][(e->first + i) % RING_SIZE] != t
+        || WCAP_EventSample(e, i) != wave(t)) {
+      bad = 2;
+    }
+  }
+  if (!bad && (!outside(wave(trigger)) || trigger < sim.armTime[r])) {
+    bad = 3;
+  }
+  for (s = sim.armConvert[r]; !bad && s < trigger; s++) {
+    if (outside(wave(s))) {
+      bad = 4;
+    }
+  }
+  if (bad) {
+    printf("  FAIL: capture %lu %s: %s\n", (unsigned long)e->sequence, when,
+           bad == 1 ? "bad event" : bad == 2 ? "samples differ from waveform"
+           : bad == 3 ? "trigger not outside the window after arming"
+           : "earlier sample outside the window");
+    sim.failures++;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Main loop model: take a capture, hold it, give it back.
+ ******************************************************************************/
+static void mainLoop(const Scenario_TypeDef *s)
+{
+  if (sim.holding && now >= sim.releaseAt) {
+    verify(&sim.event, "on release");
+    if (WCAP_Release(&wcap, &sim.event)) {
+      startLdma();
+    }
+    sim.holding = false;
+  }
+  if (!sim.holding && WCAP_Get(&wcap, &sim.event)) {
+    if (sim.event.sequence != sim.expectSequence++) {
+      printf("  FAIL: capture %lu out of order\n",
+             (unsigned long)sim.event.sequence);
+      sim.failures++;
+    }
+    verify(&sim.event, "when taken");
+    sim.verified++;
+    sim.holding = true;
+    sim.releaseAt = now + between(s->holdLo, s->holdHi);
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Convert one sample and let the LDMA and the interrupts run.
+ ******************************************************************************/
+static void step(void)
+{
+  uint16_t value = wave(now);
+
+  if (hw.fifoCount < FIFO_DEPTH) {
+    hw.fifoTime[hw.fifoCount++] = now;
+  }
+  if (outside(value)) {
+    hw.cmpIF = true;
+  }
+
+  // The LDMA sometimes has not yet taken the newest result
+  if (hw.ldmaOn) {
+    uint32_t keep = between(0, 3) == 0 ? 1 : 0, i;
+
+    while (hw.fifoCount > keep) {
+      uint64_t t = hw.fifoTime[0];
+
+      ringMem[hw.ldmaRing][hw.wpos] = wave(t);
+      slotTime[hw.ldmaRing][hw.wpos] = t;
+      hw.wpos++;
+      if (hw.wpos % wcap.config.chunkSize == 0) {
+        hw.ldmaIF = true;
+      }
+      hw.wpos %= RING_SIZE;
+      for (i = 1; i < hw.fifoCount; i++) {
+        hw.fifoTime[i - 1] = hw.fifoTime[i];
+      }
+      hw.fifoCount--;
+    }
+  }
+
+  // Pending interrupts run 0 to MAX_LATENCY samples later
+  if (!(hw.cmpIF && hw.cmpIEN)) {
+    hw.cmpDue = -1;
+  } else if (hw.cmpDue < 0) {
+    hw.cmpDue = (int64_t)(now + between(0, MAX_LATENCY));
+  }
+  if (!(hw.ldmaIF && hw.ldmaIEN)) {
+    hw.ldmaDue = -1;
+  } else if (hw.ldmaDue < 0) {
+    hw.ldmaDue = (int64_t)(now + between(0, MAX_LATENCY));
+  }
+  if (hw.cmpDue >= 0 && (uint64_t)hw.cmpDue <= now) {
+    hw.cmpDue = -1;
+    compareHandler();
+  }
+  if (hw.ldmaDue >= 0 && (uint64_t)hw.ldmaDue <= now && hw.ldmaIF
+      && hw.ldmaIEN) {
+    hw.ldmaDue = -1;
+    ldmaHandler();
+  }
+}
+
+static int run(const Scenario_TypeDef *s)
+{
+  static volatile uint32_t *const rings[WCAP_RINGS] = {
+    ringMem[0], ringMem[1]
+  };
+  WCAP_Init_TypeDef init = WCAP_INIT_DEFAULT;
+  const WCAP_Init_TypeDef *c = &wcap.config;
+  uint32_t limit;
+  int failures;
+
+  buildFaults(s);
+  memset(&hw, 0, sizeof(hw));
+  memset(&sim, 0, sizeof(sim));
+  memset(slotTime, 0xFF, sizeof(slotTime));
+  hw.cmpDue = hw.ldmaDue = -1;
+
+  init.ringSize = RING_SIZE;
+  if (!WCAP_Init(&wcap, &init, rings)) {
+    printf("%-7s configuration rejected\n", s->name);
+    return 1;
+  }
+  startLdma();
+  for (now = 0; now < RUN_SAMPLES; now++) {
+    step();
+    mainLoop(s);
+  }
+
+  limit = c->postTrigger + c->chunkSize + c->searchDepth + MAX_LATENCY;
+  printf("%-7s %4lu faults %5lu captures %4lu overruns %6lu wake-ups/s, "
+         "trip to done <= %lu samples\n",
+         s->name, (unsigned long)faultCount, (unsigned long)wcap.captures,
+         (unsigned long)wcap.overruns,
+         (unsigned long)((uint64_t)sim.wakeups * SAMPLE_HZ / RUN_SAMPLES),
+         (unsigned long)sim.longest);
+
+  failures = (int)sim.failures;
+  if (wcap.captures == 0 || sim.verified + 2 < wcap.captures) {
+    printf("  FAIL: captures not taken\n");
+    failures++;
+  }
+  if (wcap.unlocated != 0) {
+    printf("  FAIL: %lu trigger(s) not located\n",
+           (unsigned long)wcap.unlocated);
+    failures++;
+  }
+  if (sim.longest > limit) {
+    printf("  FAIL: capture took more than %lu samples\n",
+           (unsigned long)limit);
+    failures++;
+  }
+  if (s->expectOverruns != (wcap.overruns != 0)) {
+    printf("  FAIL: %s overruns\n", s->expectOverruns ? "expected" : "no");
+    failures++;
+  }
+  return failures;
+}
+
+int main(void)
+{
+  static const Scenario_TypeDef scenarios[] = {
+    { "spikes", 3000, 20000, 1, 3, 0xE80, 100, 2000, false },
+    { "sags", 2000, 8000, 50, 400, 0x200, 100, 800, false },
+    { "stuck", 30000, 60000, 10000, 30000, 0xF00, 50, 300, false },
+    { "burst", 800, 1500, 1, 3, 0xE80, 5000, 20000, true },
+  };
+  WCAP_Init_TypeDef bad = WCAP_INIT_DEFAULT;
+  volatile uint32_t *const rings[WCAP_RINGS] = { ringMem[0], ringMem[1] };
+  int failures = 0;
+  uint32_t i;
+
+  for (i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+    failures += run(&scenarios[i]);
+  }
+
+  // Pre- and post-trigger samples that do not fit beside a chunk
+  bad.postTrigger = 700;
+  if (WCAP_Init(&wcap, &bad, rings)) {
+    printf("  FAIL: oversized capture accepted\n");
+    failures++;
+  }
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/***************************************************************************//**
+ * @file
+ * @brief Compile-time pin tables: GPIO routes, analog bus allocation and
+ * IADC inputs from a (port, pin) description of each board.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef BSP_ROUTE_H
+#define BSP_ROUTE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup BSP_ROUTE Compile-time pin tables
+ * @brief Pin tables resolved by the preprocessor
+ * @details
+ *  An example that runs on several boards describes its pins in one table,
+ *  with a row per device and a column per signal.  A pin is written as
+ *  (port letter, pin number), such as (C, 5), or as (NONE, 0) when the
+ *  board does not have it:
+ *
+ *  @verbatim
+ *  //                     SCL     SDA     SENSOR_ENABLE
+ *  #define EXAMPLE_XG21  ((C, 0), (C, 1), (NONE, 0))
+ *  #define EXAMPLE_XG24  ((C, 5), (C, 7), (D, 3))
+ *
+ *  #define EXAMPLE_SCL   BSP_COLUMN(0, BSP_BOARD(EXAMPLE_))
+ *  @endverbatim
+ *
+ *  BSP_BOARD() picks the row of the device being built, and the macros
+ *  below turn a pin into its GPIO port, route register value, analog bus
+ *  allocation or IADC input.  All of them are constant expressions, so a
+ *  route costs one store and no table lookup at run time.
+ *
+ *  The macros that name registers or emlib constants need the device
+ *  headers.  The others are plain numbers, so a table can be included and
+ *  checked with BSP_CHECK() on a PC for every row at once.
+ * @{
+ ******************************************************************************/
+
+/// Paste two tokens after expanding them
+#define BSP_CAT(a, b)               BSP_CAT_(a, b)
+#define BSP_CAT_(a, b)              a##b
+
+/// Row of the table for the device being built, e.g. EXAMPLE_XG24
+#define BSP_BOARD(prefix) \
+  BSP_CAT(prefix, BSP_CAT(XG2, _SILICON_LABS_32B_SERIES_2_CONFIG))
+
+/// Column n of a table row, counting from 0
+#define BSP_COLUMN(n, row)          BSP_CALL(BSP_CAT(BSP_COLUMN_, n), (BSP_UNPAREN row, ~))
+#define BSP_CALL(macro, args)       macro args
+#define BSP_UNPAREN(...)            __VA_ARGS__
+#define BSP_COLUMN_0(a, ...)                    a
+#define BSP_COLUMN_1(a, b, ...)                 b
+#define BSP_COLUMN_2(a, b, c, ...)              c
+#define BSP_COLUMN_3(a, b, c, d, ...)           d
+#define BSP_COLUMN_4(a, b, c, d, e, ...)        e
+#define BSP_COLUMN_5(a, b, c, d, e, f, ...)     f
+#define BSP_COLUMN_6(a, b, c, d, e, f, g, ...)  g
+
+/// Port letter and number of a pin
+#define BSP_PIN_LETTER(pin)         BSP_PIN_LETTER_ pin
+#define BSP_PIN_LETTER_(port, num)  port
+#define BSP_PIN(pin)                BSP_PIN_ pin
+#define BSP_PIN_(port, num)         num
+
+/// Port of a pin as a number, as in GPIO_Port_TypeDef
+#define BSP_PORTNUM(pin)            BSP_CAT(BSP_PORTNUM_, BSP_PIN_LETTER(pin))
+#define BSP_PORTNUM_A               0
+#define BSP_PORTNUM_B               1
+#define BSP_PORTNUM_C               2
+#define BSP_PORTNUM_D               3
+#define BSP_PORTNUM_NONE            15
+
+/// GPIO_Port_TypeDef of a pin, e.g. gpioPortC
+#define BSP_PORT(pin)               BSP_CAT(gpioPort, BSP_PIN_LETTER(pin))
+
+/// True if the board has the pin; usable in #if
+#define BSP_HAS_PIN(pin)            (BSP_PORTNUM(pin) != BSP_PORTNUM_NONE)
+
+/// True if the pin is a real GPIO pin
+#define BSP_PIN_VALID(pin)          (BSP_PORTNUM(pin) <= 3 && BSP_PIN(pin) <= 15)
+
+/// True if the pin keeps working in EM2 and EM3 (ports A and B)
+#define BSP_PIN_EM2(pin)            (BSP_PORTNUM(pin) <= 1)
+
+/// True if the two pins are different
+#define BSP_PIN_DIFFERENT(a, b) \
+  (BSP_PORTNUM(a) != BSP_PORTNUM(b) || BSP_PIN(a) != BSP_PIN(b))
+
+/// True if the pin is the fixed pin of a signal in the device headers,
+/// e.g. BSP_PIN_IS((B, 1), ETAMPDET_ETAMPIN0) for ETAMPDET_ETAMPIN0_PORT/_PIN
+#define BSP_PIN_IS(pin, sig) \
+  (BSP_PORTNUM(pin) == sig##_PORT && BSP_PIN(pin) == sig##_PIN)
+
+/// Fails the build, also on the host, if the condition is false
+#define BSP_CHECK(name, cond)       extern char name[(cond) ? 1 : -1]
+
+/***************************************************************************//**
+ * GPIO routes.  BSP_GPIO_ROUTE() names the route registers of a peripheral
+ * instance, and BSP_ROUTE_SET() routes one of its signals to a pin:
+ *
+ *   BSP_ROUTE_SET(I2C0, SCL, EXAMPLE_SCL);
+ *   GPIO->BSP_GPIO_ROUTE(I2C0).ROUTEEN = GPIO_I2C_ROUTEEN_SCLPEN;
+ ******************************************************************************/
+#define BSP_GPIO_ROUTE(inst)        BSP_CAT(BSP_ROUTEREG_, inst)
+#define BSP_ROUTE_SET(inst, sig, pin) \
+  (GPIO->BSP_GPIO_ROUTE(inst).sig##ROUTE = BSP_ROUTE(BSP_CAT(BSP_ROUTETYPE_, inst), sig, pin))
+
+/// Value of a route register for a pin, e.g. BSP_ROUTE(I2C, SCL, (C, 5))
+#define BSP_ROUTE(type, sig, pin)   BSP_ROUTE_(type, sig, pin)
+#define BSP_ROUTE_(type, sig, pin)                                         \
+  (((uint32_t)BSP_PORTNUM(pin) << _GPIO_##type##_##sig##ROUTE_PORT_SHIFT) \
+   | ((uint32_t)BSP_PIN(pin) << _GPIO_##type##_##sig##ROUTE_PIN_SHIFT))
+
+#define BSP_ROUTEREG_I2C0           I2CROUTE[0]
+#define BSP_ROUTEREG_I2C1           I2CROUTE[1]
+#define BSP_ROUTEREG_TIMER0         TIMERROUTE[0]
+#define BSP_ROUTEREG_TIMER1         TIMERROUTE[1]
+#define BSP_ROUTEREG_USART0         USARTROUTE[0]
+#define BSP_ROUTEREG_EUSART0        EUSARTROUTE[0]
+#define BSP_ROUTEREG_EUSART1        EUSARTROUTE[1]
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_1) \
+  || defined(_SILICON_LABS_32B_SERIES_2_CONFIG_2)
+#define BSP_ROUTEREG_LETIMER0       LETIMERROUTE[0]
+#else
+#define BSP_ROUTEREG_LETIMER0       LETIMERROUTE
+#endif
+
+#define BSP_ROUTETYPE_I2C0          I2C
+#define BSP_ROUTETYPE_I2C1          I2C
+#define BSP_ROUTETYPE_TIMER0        TIMER
+#define BSP_ROUTETYPE_TIMER1        TIMER
+#define BSP_ROUTETYPE_USART0        USART
+#define BSP_ROUTETYPE_EUSART0       EUSART
+#define BSP_ROUTETYPE_EUSART1       EUSART
+#define BSP_ROUTETYPE_LETIMER0      LETIMER
+
+/***************************************************************************//**
+ * Analog buses.  Port A and port B have a bus each, and ports C and D
+ * share one; even and odd pins are allocated separately.  For an IADC
+ * input on a pin:
+ *
+ *   GPIO->BSP_BUSALLOC_REG(EXAMPLE_IN) |= BSP_BUSALLOC(EXAMPLE_IN, ADC0);
+ ******************************************************************************/
+#define BSP_BUS(pin)                BSP_CAT(BSP_BUS_, BSP_PIN_LETTER(pin))
+#define BSP_BUS_A                   A
+#define BSP_BUS_B                   B
+#define BSP_BUS_C                   CD
+#define BSP_BUS_D                   CD
+
+/// Bus allocation register of a pin, e.g. ABUSALLOC
+#define BSP_BUSALLOC_REG(pin)       BSP_CAT(BSP_BUS(pin), BUSALLOC)
+
+/// Allocation of the pin's half of its bus to a peripheral
+#define BSP_BUSALLOC(pin, periph)   BSP_BUSALLOC_(BSP_BUS(pin), BSP_PIN(pin), periph)
+#define BSP_BUSALLOC_(bus, num, periph)       \
+  (((num) & 1) ? BSP_BUSFIELD(bus, ODD0, periph) \
+   : BSP_BUSFIELD(bus, EVEN0, periph))
+#define BSP_BUSFIELD(bus, half, periph) \
+  GPIO_##bus##BUSALLOC_##bus##half##_##periph
+
+/// IADC_PosInput_t of a pin, e.g. iadcPosInputPortBPin0
+#define BSP_IADC_INPUT(pin)         BSP_IADC_INPUT_(BSP_PIN_LETTER(pin), BSP_PIN(pin))
+#define BSP_IADC_INPUT_(port, num)  BSP_IADC_INPUT__(port, num)
+#define BSP_IADC_INPUT__(port, num) iadcPosInputPort##port##Pin##num
+
+/// IADC_NegInput_t of a pin, e.g. iadcNegInputPortBPin1
+#define BSP_IADC_NEG_INPUT(pin)     BSP_IADC_NEG_INPUT_(BSP_PIN_LETTER(pin), BSP_PIN(pin))
+#define BSP_IADC_NEG_INPUT_(port, num)  BSP_IADC_NEG_INPUT__(port, num)
+#define BSP_IADC_NEG_INPUT__(port, num) iadcNegInputPort##port##Pin##num
+
+/** @} (end addtogroup BSP_ROUTE) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BSP_ROUTE_H */
@@ -0,0 +1,300 @@
+/***************************************************************************//**
+ * @file em_cmu.h
+ * @brief Host fake of the clock management API: clock enables, clock
+ * selects and the frequencies derived from them.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EM_CMU_H
+#define EM_CMU_H
+
+#include <stdbool.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Clock branches and bus clocks of an xG24
+typedef enum {
+  cmuClock_SYSCLK,
+  cmuClock_HCLK,
+  cmuClock_CORE,
+  cmuClock_EXPCLK,
+  cmuClock_PCLK,
+  cmuClock_LSPCLK,
+  cmuClock_TRACECLK,
+  cmuClock_EM01GRPACLK,
+  cmuClock_EM01GRPCCLK,
+  cmuClock_EM23GRPACLK,
+  cmuClock_EM4GRPACLK,
+  cmuClock_IADCCLK,
+  cmuClock_WDOG0CLK,
+  cmuClock_WDOG1CLK,
+  cmuClock_SYSRTCCLK,
+  cmuClock_EUSART0CLK,
+  cmuClock_LFXO,
+  cmuClock_LFRCO,
+  cmuClock_ULFRCO,
+  cmuClock_HFRCOEM23,
+  cmuClock_HFXO,
+  cmuClock_HFRCODPLL,
+
+  // Bus clocks of peripherals
+  cmuClock_GPIO,
+  cmuClock_LDMA,
+  cmuClock_LDMAXBAR,
+  cmuClock_PRS,
+  cmuClock_GPCRC,
+  cmuClock_TIMER0,
+  cmuClock_TIMER1,
+  cmuClock_TIMER2,
+  cmuClock_TIMER3,
+  cmuClock_TIMER4,
+  cmuClock_USART0,
+  cmuClock_EUSART0,
+  cmuClock_EUSART1,
+  cmuClock_I2C0,
+  cmuClock_I2C1,
+  cmuClock_IADC0,
+  cmuClock_LETIMER0,
+  cmuClock_BURTC,
+  cmuClock_BURAM,
+  cmuClock_SYSRTC,
+  cmuClock_WDOG0,
+  cmuClock_WDOG1,
+  cmuClock_ACMP0,
+  cmuClock_ACMP1,
+  cmuClock_VDAC0,
+  cmuClock_PCNT0,
+  cmuClock_MSC,
+  cmuClock_DCDC,
+  cmuClock_SMU,
+  cmuClock_ICACHE,
+  cmuClock_KEYSCAN,
+  cmuClock_DMEM,
+  cmuClock_MVP,
+  cmuClock_SEMAILBOX,
+  cmuClock_LESENSE,
+  cmuClock_PDM,
+  cmuClock_PDMREF,
+  cmuClock_COUNT
+} CMU_Clock_TypeDef;
+
+/// Clock sources for CMU_ClockSelectSet()
+typedef enum {
+  cmuSelect_Error,
+  cmuSelect_Disabled,
+  cmuSelect_FSRCO,
+  cmuSelect_HFXO,
+  cmuSelect_HFRCODPLL,
+  cmuSelect_HFRCOEM23,
+  cmuSelect_CLKIN0,
+  cmuSelect_LFXO,
+  cmuSelect_LFRCO,
+  cmuSelect_ULFRCO,
+  cmuSelect_EM01GRPACLK,
+  cmuSelect_EM23GRPACLK,
+  cmuSelect_HCLK,
+  cmuSelect_HCLKDIV1024,
+  cmuSelect_RFDIV,
+} CMU_Select_TypeDef;
+
+typedef enum {
+  cmuOsc_LFXO,
+  cmuOsc_LFRCO,
+  cmuOsc_FSRCO,
+  cmuOsc_HFXO,
+  cmuOsc_HFRCODPLL,
+  cmuOsc_HFRCOEM23,
+  cmuOsc_ULFRCO,
+} CMU_Osc_TypeDef;
+
+/// HFRCODPLL bands; the values are the frequencies in Hz
+typedef enum {
+  cmuHFRCODPLLFreq_1M0Hz  = 1000000U,
+  cmuHFRCODPLLFreq_2M0Hz  = 2000000U,
+  cmuHFRCODPLLFreq_4M0Hz  = 4000000U,
+  cmuHFRCODPLLFreq_7M0Hz  = 7000000U,
+  cmuHFRCODPLLFreq_13M0Hz = 13000000U,
+  cmuHFRCODPLLFreq_16M0Hz = 16000000U,
+  cmuHFRCODPLLFreq_19M0Hz = 19000000U,
+  cmuHFRCODPLLFreq_26M0Hz = 26000000U,
+  cmuHFRCODPLLFreq_32M0Hz = 32000000U,
+  cmuHFRCODPLLFreq_38M0Hz = 38000000U,
+  cmuHFRCODPLLFreq_48M0Hz = 48000000U,
+  cmuHFRCODPLLFreq_56M0Hz = 56000000U,
+  cmuHFRCODPLLFreq_64M0Hz = 64000000U,
+  cmuHFRCODPLLFreq_80M0Hz = 80000000U,
+} CMU_HFRCODPLLFreq_TypeDef;
+
+typedef enum {
+  cmuLfxoOscMode_Crystal,
+  cmuLfxoOscMode_AcCoupledSine,
+  cmuLfxoOscMode_External,
+} CMU_LfxoOscMode_TypeDef;
+
+typedef enum {
+  cmuLfxoStartupDelay_2Cycles,
+  cmuLfxoStartupDelay_256Cycles,
+  cmuLfxoStartupDelay_1KCycles,
+  cmuLfxoStartupDelay_2KCycles,
+  cmuLfxoStartupDelay_4KCycles,
+  cmuLfxoStartupDelay_8KCycles,
+  cmuLfxoStartupDelay_16KCycles,
+  cmuLfxoStartupDelay_32KCycles,
+} CMU_LfxoStartupDelay_TypeDef;
+
+/// Field for field as in emlib, so that the BSP init macros fit
+typedef struct {
+  uint8_t                       gain;
+  uint8_t                       capTune;
+  CMU_LfxoStartupDelay_TypeDef  timeout;
+  CMU_LfxoOscMode_TypeDef       mode;
+  bool                          highAmplitudeEn;
+  bool                          agcEn;
+  bool                          failDetEM4WUEn;
+  bool                          failDetEn;
+  bool                          disOnDemand;
+  bool                          forceEn;
+  bool                          regLock;
+} CMU_LFXOInit_TypeDef;
+
+#define CMU_LFXOINIT_DEFAULT                                              \
+  { 1, 63, cmuLfxoStartupDelay_4KCycles, cmuLfxoOscMode_Crystal, false,   \
+    true, false, false, false, false, false }
+
+typedef enum {
+  cmuHfxoCbLsbTimeout_8us,
+  cmuHfxoCbLsbTimeout_20us,
+  cmuHfxoCbLsbTimeout_41us,
+  cmuHfxoCbLsbTimeout_62us,
+  cmuHfxoCbLsbTimeout_83us,
+  cmuHfxoCbLsbTimeout_104us,
+  cmuHfxoCbLsbTimeout_125us,
+  cmuHfxoCbLsbTimeout_166us,
+  cmuHfxoCbLsbTimeout_208us,
+  cmuHfxoCbLsbTimeout_250us,
+  cmuHfxoCbLsbTimeout_333us,
+  cmuHfxoCbLsbTimeout_416us,
+  cmuHfxoCbLsbTimeout_833us,
+  cmuHfxoCbLsbTimeout_1250us,
+  cmuHfxoCbLsbTimeout_2083us,
+  cmuHfxoCbLsbTimeout_3750us,
+} CMU_HfxoCbLsbTimeout_TypeDef;
+
+typedef enum {
+  cmuHfxoSteadyStateTimeout_16us,
+  cmuHfxoSteadyStateTimeout_41us,
+  cmuHfxoSteadyStateTimeout_83us,
+  cmuHfxoSteadyStateTimeout_125us,
+  cmuHfxoSteadyStateTimeout_166us,
+  cmuHfxoSteadyStateTimeout_208us,
+  cmuHfxoSteadyStateTimeout_250us,
+  cmuHfxoSteadyStateTimeout_333us,
+  cmuHfxoSteadyStateTimeout_416us,
+  cmuHfxoSteadyStateTimeout_500us,
+  cmuHfxoSteadyStateTimeout_666us,
+  cmuHfxoSteadyStateTimeout_833us,
+  cmuHfxoSteadyStateTimeout_1666us,
+  cmuHfxoSteadyStateTimeout_2500us,
+  cmuHfxoSteadyStateTimeout_4166us,
+  cmuHfxoSteadyStateTimeout_7500us,
+} CMU_HfxoSteadyStateTimeout_TypeDef;
+
+typedef enum {
+  cmuHfxoCoreDegen_None,
+  cmuHfxoCoreDegen_33,
+  cmuHfxoCoreDegen_50,
+  cmuHfxoCoreDegen_100,
+} CMU_HfxoCoreDegen_TypeDef;
+
+typedef enum {
+  cmuHfxoCtuneFixCap_None,
+  cmuHfxoCtuneFixCap_Xi,
+  cmuHfxoCtuneFixCap_Xo,
+  cmuHfxoCtuneFixCap_Both,
+} CMU_HfxoCtuneFixCap_TypeDef;
+
+typedef enum {
+  cmuHfxoOscMode_Crystal,
+  cmuHfxoOscMode_ExternalSine,
+  cmuHfxoOscMode_ExternalSinePkDet,
+} CMU_HfxoOscMode_TypeDef;
+
+typedef struct {
+  CMU_HfxoCbLsbTimeout_TypeDef        timeoutCbLsb;
+  CMU_HfxoSteadyStateTimeout_TypeDef  timeoutSteadyFirstLock;
+  CMU_HfxoSteadyStateTimeout_TypeDef  timeoutSteady;
+  uint8_t                             ctuneXoStartup;
+  uint8_t                             ctuneXiStartup;
+  uint8_t                             coreBiasStartup;
+  uint8_t                             imCoreBiasStartup;
+  CMU_HfxoCoreDegen_TypeDef           coreDegenAna;
+  CMU_HfxoCtuneFixCap_TypeDef         ctuneFixAna;
+  uint8_t                             ctuneXoAna;
+  uint8_t                             ctuneXiAna;
+  uint8_t                             coreBiasAna;
+  bool                                enXiDcBiasAna;
+  CMU_HfxoOscMode_TypeDef             mode;
+  bool                                forceXo2GndAna;
+  bool                                forceXi2GndAna;
+  bool                                disOnDemand;
+  bool                                forceEn;
+  bool                                regLock;
+} CMU_HFXOInit_TypeDef;
+
+/// Frequency of the HFXO on the radio boards
+#ifndef HOST_HFXO_HZ
+#define HOST_HFXO_HZ    39000000UL
+#endif
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable);
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock);
+void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref);
+CMU_Select_TypeDef CMU_ClockSelectGet(CMU_Clock_TypeDef clock);
+void CMU_ClockDivSet(CMU_Clock_TypeDef clock, uint32_t div);
+uint32_t CMU_ClockDivGet(CMU_Clock_TypeDef clock);
+void CMU_HFRCODPLLBandSet(CMU_HFRCODPLLFreq_TypeDef freq);
+CMU_HFRCODPLLFreq_TypeDef CMU_HFRCODPLLBandGet(void);
+void CMU_LFXOInit(const CMU_LFXOInit_TypeDef *init);
+void CMU_HFXOInit(const CMU_HFXOInit_TypeDef *init);
+void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait);
+
+// Host only: bus fault on access to a peripheral whose clock is off
+void HOST_ClockRequire(CMU_Clock_TypeDef clock, const char *peripheral);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EM_CMU_H
@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @file em_core.h
+ * @brief Host fake of the critical section API.  Critical and atomic
+ * sections both mask all interrupts through PRIMASK.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EM_CORE_H
+#define EM_CORE_H
+
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t CORE_irqState_t;
+
+#define CORE_DECLARE_IRQ_STATE        CORE_irqState_t irqState
+#define CORE_ENTER_CRITICAL()         irqState = CORE_EnterCritical()
+#define CORE_EXIT_CRITICAL()          CORE_ExitCritical(irqState)
+#define CORE_YIELD_CRITICAL()         CORE_YieldCritical()
+#define CORE_ENTER_ATOMIC()           irqState = CORE_EnterAtomic()
+#define CORE_EXIT_ATOMIC()            CORE_ExitAtomic(irqState)
+#define CORE_YIELD_ATOMIC()           CORE_YieldAtomic()
+#define CORE_CRITICAL_SECTION(yourcode) \
+  {                                     \
+    CORE_DECLARE_IRQ_STATE;             \
+    CORE_ENTER_CRITICAL();              \
+    {                                   \
+      yourcode                          \
+    }                                   \
+    CORE_EXIT_CRITICAL();               \
+  }
+#define CORE_ATOMIC_SECTION(yourcode)   CORE_CRITICAL_SECTION(yourcode)
+
+static inline CORE_irqState_t CORE_EnterCritical(void)
+{
+  CORE_irqState_t state = __get_PRIMASK();
+
+  __disable_irq();
+  return state;
+}
+
+static inline void CORE_ExitCritical(CORE_irqState_t state)
+{
+  if (state == 0) {
+    __enable_irq();
+  }
+}
+
+static inline void CORE_YieldCritical(void)
+{
+  if (__get_PRIMASK() != 0) {
+    __enable_irq();
+    __disable_irq();
+  }
+}
+
+#define CORE_EnterAtomic  CORE_EnterCritical
+#define CORE_ExitAtomic   CORE_ExitCritical
+#define CORE_YieldAtomic  CORE_YieldCritical
+
+static inline void CORE_CriticalDisableIrq(void)
+{
+  __disable_irq();
+}
+
+static inline void CORE_CriticalEnableIrq(void)
+{
+  __enable_irq();
+}
+
+static inline void CORE_AtomicDisableIrq(void)
+{
+  __disable_irq();
+}
+
+static inline void CORE_AtomicEnableIrq(void)
+{
+  __enable_irq();
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EM_CORE_H
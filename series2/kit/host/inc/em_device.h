@@ -0,0 +1,407 @@
+/***************************************************************************//**
+ * @file em_device.h
+ * @brief Host fake of the device header: register blocks held in host RAM,
+ * interrupt numbers and the CMSIS core functions the examples use.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EM_DEVICE_H
+#define EM_DEVICE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The fake models an EFR32xG24.  Only the registers that the modelled
+ * peripherals use, or that examples write directly, are present; an
+ * example that touches anything else fails to compile rather than run
+ * against a register nobody models.
+ */
+#define HOST_DEVICE
+#define _SILICON_LABS_32B_SERIES_2
+#define _SILICON_LABS_32B_SERIES            2
+#define _SILICON_LABS_32B_SERIES_2_CONFIG_4
+#define _SILICON_LABS_32B_SERIES_2_CONFIG   4
+#define _EFR_DEVICE
+
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+/// Interrupt numbers; the core exceptions are negative as in CMSIS
+typedef enum {
+  SysTick_IRQn = -1,
+  SMU_SECURE_IRQn = 0,
+  EMU_IRQn,
+  TIMER0_IRQn,
+  TIMER1_IRQn,
+  TIMER2_IRQn,
+  TIMER3_IRQn,
+  TIMER4_IRQn,
+  USART0_RX_IRQn,
+  USART0_TX_IRQn,
+  EUSART0_RX_IRQn,
+  EUSART0_TX_IRQn,
+  EUSART1_RX_IRQn,
+  EUSART1_TX_IRQn,
+  ICACHE0_IRQn,
+  BURTC_IRQn,
+  LETIMER0_IRQn,
+  SYSCFG_IRQn,
+  MPAHBRAM_IRQn,
+  LDMA_IRQn,
+  LFXO_IRQn,
+  LFRCO_IRQn,
+  ULFRCO_IRQn,
+  GPIO_ODD_IRQn,
+  GPIO_EVEN_IRQn,
+  I2C0_IRQn,
+  I2C1_IRQn,
+  EMUDG_IRQn,
+  HFXO0_IRQn,
+  HFRCO0_IRQn,
+  HFRCOEM23_IRQn,
+  CMU_IRQn,
+  IADC_IRQn,
+  MSC_IRQn,
+  DPLL0_IRQn,
+  EMUEFP_IRQn,
+  DCDC_IRQn,
+  VDAC0_IRQn,
+  PCNT0_IRQn,
+  SW0_IRQn,
+  SW1_IRQn,
+  SW2_IRQn,
+  SW3_IRQn,
+  KERNEL0_IRQn,
+  KERNEL1_IRQn,
+  M33CTI0_IRQn,
+  M33CTI1_IRQn,
+  FPUEXH_IRQn,
+  SETAMPERHOST_IRQn,
+  SEMBRX_IRQn,
+  SEMBTX_IRQn,
+  SYSRTC_APP_IRQn,
+  SYSRTC_SEQ_IRQn,
+  KEYSCAN_IRQn,
+  RFECA0_IRQn,
+  RFECA1_IRQn,
+  VDAC1_IRQn,
+  AHB2AHB0_IRQn,
+  AHB2AHB1_IRQn,
+  EXT_IRQ_COUNT
+} IRQn_Type;
+
+/*******************************************************************************
+ ********************************  CMSIS core  *********************************
+ ******************************************************************************/
+
+/// Core clock in Hz; follows CMU_HFRCODPLLBandSet()
+extern uint32_t SystemCoreClock;
+uint32_t SystemCoreClockGet(void);
+
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+uint32_t NVIC_GetPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type irq);
+uint32_t SysTick_Config(uint32_t ticks);
+
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __WFI(void);
+void __WFE(void);
+void __SEV(void);
+void __BKPT_host(void);
+
+#define __BKPT(value)   __BKPT_host()
+#define __NOP()         ((void)0)
+#define __DSB()         ((void)0)
+#define __ISB()         ((void)0)
+#define __DMB()         ((void)0)
+#define __CLZ(x)        ((uint8_t)((x) ? __builtin_clz(x) : 32))
+#define __RBIT(x)       HOST_Rbit(x)
+#define __REV(x)        __builtin_bswap32(x)
+
+static inline uint32_t HOST_Rbit(uint32_t x)
+{
+  x = ((x >> 1) & 0x55555555UL) | ((x & 0x55555555UL) << 1);
+  x = ((x >> 2) & 0x33333333UL) | ((x & 0x33333333UL) << 2);
+  x = ((x >> 4) & 0x0F0F0F0FUL) | ((x & 0x0F0F0F0FUL) << 4);
+  return __builtin_bswap32(x);
+}
+
+/*******************************************************************************
+ ************************************  GPIO  ***********************************
+ ******************************************************************************/
+
+typedef struct {
+  __IOM uint32_t CTRL;
+  __IOM uint32_t MODEL;             ///< Mode of pins 0-7, 4 bits each
+  uint32_t       RESERVED0[1U];
+  __IOM uint32_t MODEH;             ///< Mode of pins 8-15, 4 bits each
+  __IOM uint32_t DOUT;
+  __IOM uint32_t DIN;
+} GPIO_PORT_TypeDef;
+
+typedef struct {
+  __IOM uint32_t ROUTEEN;
+  __IOM uint32_t CC0ROUTE;
+  __IOM uint32_t CC1ROUTE;
+  __IOM uint32_t CC2ROUTE;
+  __IOM uint32_t CDTI0ROUTE;
+  __IOM uint32_t CDTI1ROUTE;
+  __IOM uint32_t CDTI2ROUTE;
+  uint32_t       RESERVED0[1U];
+} GPIO_TIMERROUTE_TypeDef;
+
+typedef struct {
+  GPIO_PORT_TypeDef       P[4U];
+  __IOM uint32_t          LOCK;
+  __IOM uint32_t          EXTIPSELL;    ///< Port of interrupts 0-7, 4 bits each
+  __IOM uint32_t          EXTIPSELH;
+  __IOM uint32_t          EXTIPINSELL;  ///< Pin in group of interrupts 0-7
+  __IOM uint32_t          EXTIPINSELH;
+  __IOM uint32_t          EXTIRISE;
+  __IOM uint32_t          EXTIFALL;
+  __IOM uint32_t          IF;
+  __IOM uint32_t          IEN;
+  __IOM uint32_t          EM4WUEN;
+  __IOM uint32_t          EM4WUPOL;
+  GPIO_TIMERROUTE_TypeDef TIMERROUTE[5U];
+  __IOM uint32_t          IF_SET;
+  __IOM uint32_t          IF_CLR;
+  __IOM uint32_t          IEN_SET;
+  __IOM uint32_t          IEN_CLR;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef HOST_GPIO;
+#define GPIO                              (&HOST_GPIO)
+
+#define GPIO_PORT_MAX                     3
+#define GPIO_PIN_MAX                      15
+#define GPIO_TIMER_ROUTEEN_CC0PEN         (0x1UL << 0)
+#define GPIO_TIMER_ROUTEEN_CC1PEN         (0x1UL << 1)
+#define GPIO_TIMER_ROUTEEN_CC2PEN         (0x1UL << 2)
+#define _GPIO_TIMER_CC0ROUTE_PORT_SHIFT   0
+#define _GPIO_TIMER_CC0ROUTE_PORT_MASK    0x3UL
+#define _GPIO_TIMER_CC0ROUTE_PIN_SHIFT    16
+#define _GPIO_TIMER_CC0ROUTE_PIN_MASK     0xF0000UL
+#define _GPIO_TIMER_CC1ROUTE_PORT_SHIFT   0
+#define _GPIO_TIMER_CC1ROUTE_PIN_SHIFT    16
+#define _GPIO_TIMER_CC2ROUTE_PORT_SHIFT   0
+#define _GPIO_TIMER_CC2ROUTE_PIN_SHIFT    16
+
+/*******************************************************************************
+ ************************************  LDMA  ***********************************
+ ******************************************************************************/
+
+#define DMA_CHAN_COUNT                    8
+
+typedef struct {
+  __IOM uint32_t CFG;
+  __IOM uint32_t LOOP;
+  __IOM uint32_t CTRL;
+  __IOM uint32_t SRC;
+  __IOM uint32_t DST;
+  __IOM uint32_t LINK;
+  uint32_t       RESERVED0[6U];
+} LDMA_CH_TypeDef;
+
+typedef struct {
+  __IOM uint32_t  EN;
+  __IOM uint32_t  CTRL;
+  __IOM uint32_t  STATUS;
+  __IOM uint32_t  CHEN;
+  __IOM uint32_t  CHDIS;
+  __IOM uint32_t  CHSTATUS;
+  __IOM uint32_t  CHBUSY;
+  __IOM uint32_t  CHDONE;
+  __IOM uint32_t  DBGHALT;
+  __IOM uint32_t  SWREQ;            ///< Written by examples; taken at sync
+  __IOM uint32_t  REQDIS;
+  __IOM uint32_t  REQPEND;
+  __IOM uint32_t  LINKLOAD;
+  __IOM uint32_t  REQCLEAR;
+  __IOM uint32_t  IF;
+  __IOM uint32_t  IEN;
+  LDMA_CH_TypeDef CH[DMA_CHAN_COUNT];
+  __IOM uint32_t  IF_SET;
+  __IOM uint32_t  IF_CLR;
+  __IOM uint32_t  IEN_SET;
+  __IOM uint32_t  IEN_CLR;
+} LDMA_TypeDef;
+
+extern LDMA_TypeDef HOST_LDMA;
+#define LDMA                              (&HOST_LDMA)
+
+#define LDMA_IF_DONE0                     (0x1UL << 0)
+#define LDMA_IF_DONE1                     (0x1UL << 1)
+#define LDMA_IF_DONE2                     (0x1UL << 2)
+#define LDMA_IF_DONE3                     (0x1UL << 3)
+#define LDMA_IF_DONE4                     (0x1UL << 4)
+#define LDMA_IF_DONE5                     (0x1UL << 5)
+#define LDMA_IF_DONE6                     (0x1UL << 6)
+#define LDMA_IF_DONE7                     (0x1UL << 7)
+#define LDMA_IF_ERROR                     (0x1UL << 31)
+#define _LDMA_IF_MASK                     0x800000FFUL
+#define _LDMA_CH_LOOP_LOOPCNT_MASK        0xFFUL
+
+// Request sources and signals of the LDMAXBAR, as source | signal
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_NONE       (0x0UL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_LDMAXBAR   (0x1UL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER0     (0x3UL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER1     (0x4UL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_USART0     (0x5UL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER2     (0x9UL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER3     (0xAUL << 16)
+#define LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER4     (0xDUL << 16)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_LDMAXBARPRSREQ0     (0x0UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_LDMAXBARPRSREQ1     (0x1UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER0CC0           (0x0UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER0CC1           (0x1UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER0CC2           (0x2UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER0UFOF          (0x3UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER1CC0           (0x0UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER1CC1           (0x1UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER1CC2           (0x2UL << 0)
+#define LDMAXBAR_CH_REQSEL_SIGSEL_TIMER1UFOF          (0x3UL << 0)
+#define _LDMAXBAR_CH_REQSEL_SOURCESEL_MASK      0x3F0000UL
+#define _LDMAXBAR_CH_REQSEL_SIGSEL_MASK         0xFUL
+
+/*******************************************************************************
+ ***********************************  TIMER  ***********************************
+ ******************************************************************************/
+
+#define TIMER_COUNT                       5
+
+typedef struct {
+  __IOM uint32_t CFG;
+  __IOM uint32_t CTRL;
+  __IOM uint32_t OC;
+  uint32_t       RESERVED0[1U];
+  __IOM uint32_t OCB;
+  __IM uint32_t  ICF;
+  __IM uint32_t  ICOF;
+  uint32_t       RESERVED1[1U];
+} TIMER_CC_TypeDef;
+
+typedef struct {
+  __IM uint32_t    IPVERSION;
+  __IOM uint32_t   CFG;
+  __IOM uint32_t   CTRL;
+  __IOM uint32_t   CMD;
+  __IOM uint32_t   STATUS;
+  __IOM uint32_t   IF;
+  __IOM uint32_t   IEN;
+  __IOM uint32_t   TOP;
+  __IOM uint32_t   TOPB;
+  __IOM uint32_t   CNT;
+  uint32_t         RESERVED0[1U];
+  __IOM uint32_t   LOCK;
+  __IOM uint32_t   EN;
+  TIMER_CC_TypeDef CC[3U];
+  __IOM uint32_t   IF_SET;
+  __IOM uint32_t   IF_CLR;
+  __IOM uint32_t   IEN_SET;
+  __IOM uint32_t   IEN_CLR;
+} TIMER_TypeDef;
+
+extern TIMER_TypeDef HOST_TIMER[TIMER_COUNT];
+#define TIMER0                            (&HOST_TIMER[0])
+#define TIMER1                            (&HOST_TIMER[1])
+#define TIMER2                            (&HOST_TIMER[2])
+#define TIMER3                            (&HOST_TIMER[3])
+#define TIMER4                            (&HOST_TIMER[4])
+#define TIMER_NUM(ref)                    ((int)((ref) - HOST_TIMER))
+#define TIMER_REF_VALID(ref)              (TIMER_NUM(ref) >= 0 \
+                                           && TIMER_NUM(ref) < TIMER_COUNT)
+#define TIMER_MAX_COUNT(ref)              (TIMER_NUM(ref) <= 1 ? 0xFFFFFFFFUL \
+                                           : 0xFFFFUL)
+
+#define TIMER_IF_OF                       (0x1UL << 0)
+#define TIMER_IF_UF                       (0x1UL << 1)
+#define TIMER_IF_DIRCHG                   (0x1UL << 2)
+#define TIMER_IF_CC0                      (0x1UL << 4)
+#define TIMER_IF_CC1                      (0x1UL << 5)
+#define TIMER_IF_CC2                      (0x1UL << 6)
+#define TIMER_IEN_OF                      TIMER_IF_OF
+#define TIMER_IEN_UF                      TIMER_IF_UF
+#define TIMER_IEN_DIRCHG                  TIMER_IF_DIRCHG
+#define TIMER_IEN_CC0                     TIMER_IF_CC0
+#define TIMER_IEN_CC1                     TIMER_IF_CC1
+#define TIMER_IEN_CC2                     TIMER_IF_CC2
+#define _TIMER_IF_MASK                    0x00000077UL
+#define TIMER_STATUS_RUNNING              (0x1UL << 0)
+#define TIMER_STATUS_DIR                  (0x1UL << 1)
+#define TIMER_CMD_START                   (0x1UL << 0)
+#define TIMER_CMD_STOP                    (0x1UL << 1)
+#define TIMER_EN_EN                       (0x1UL << 0)
+
+/*******************************************************************************
+ ***********************************  USART  ***********************************
+ ******************************************************************************/
+
+/// Present so bsp.h and retargetserial.h build; USART is not modelled
+typedef struct {
+  __IM uint32_t  IPVERSION;
+  __IOM uint32_t EN;
+  __IOM uint32_t CTRL;
+  __IOM uint32_t FRAME;
+  __IOM uint32_t STATUS;
+  __IOM uint32_t IF;
+  __IOM uint32_t IEN;
+  __IOM uint32_t RXDATA;
+  __IOM uint32_t TXDATA;
+} USART_TypeDef;
+
+extern USART_TypeDef HOST_USART0;
+#define USART0                            (&HOST_USART0)
+#define USART_STATUS_TXC                  (0x1UL << 5)
+#define USART_STATUS_TXIDLE               (0x1UL << 13)
+#define USART_STATUS_RXDATAV              (0x1UL << 7)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EM_DEVICE_H
@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @file em_gpio.h
+ * @brief Host fake of the GPIO API: pin modes, outputs, inputs driven by
+ * the scenario and external interrupts.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EM_GPIO_H
+#define EM_GPIO_H
+
+#include <stdbool.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  gpioPortA = 0,
+  gpioPortB = 1,
+  gpioPortC = 2,
+  gpioPortD = 3,
+} GPIO_Port_TypeDef;
+
+/// Pin modes, with the MODEL/MODEH field values of series 2
+typedef enum {
+  gpioModeDisabled                  = 0,
+  gpioModeInput                     = 1,
+  gpioModeInputPull                 = 2,
+  gpioModeInputPullFilter           = 3,
+  gpioModePushPull                  = 4,
+  gpioModePushPullAlternate         = 5,
+  gpioModeWiredOr                   = 6,
+  gpioModeWiredOrPullDown           = 7,
+  gpioModeWiredAnd                  = 8,
+  gpioModeWiredAndFilter            = 9,
+  gpioModeWiredAndPullUp            = 10,
+  gpioModeWiredAndPullUpFilter      = 11,
+  gpioModeWiredAndAlternate         = 12,
+  gpioModeWiredAndAlternateFilter   = 13,
+  gpioModeWiredAndAlternatePullUp   = 14,
+  gpioModeWiredAndAlternatePullUpFilter = 15,
+} GPIO_Mode_TypeDef;
+
+typedef enum {
+  gpioDriveStrengthWeakAlternateWeak,
+  gpioDriveStrengthStrongAlternateWeak,
+  gpioDriveStrengthWeakAlternateStrong,
+  gpioDriveStrengthStrongAlternateStrong,
+} GPIO_DriveStrength_TypeDef;
+
+#define GPIO_PORT_VALID(port)     ((unsigned int)(port) <= GPIO_PORT_MAX)
+#define GPIO_PIN_VALID(pin)       ((unsigned int)(pin) <= GPIO_PIN_MAX)
+
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin,
+                     GPIO_Mode_TypeDef mode, unsigned int out);
+GPIO_Mode_TypeDef GPIO_PinModeGet(GPIO_Port_TypeDef port, unsigned int pin);
+unsigned int GPIO_PinInGet(GPIO_Port_TypeDef port, unsigned int pin);
+unsigned int GPIO_PinOutGet(GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutSet(GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutClear(GPIO_Port_TypeDef port, unsigned int pin);
+void GPIO_PinOutToggle(GPIO_Port_TypeDef port, unsigned int pin);
+uint32_t GPIO_PortInGet(GPIO_Port_TypeDef port);
+uint32_t GPIO_PortOutGet(GPIO_Port_TypeDef port);
+void GPIO_PortOutSet(GPIO_Port_TypeDef port, uint32_t pins);
+void GPIO_PortOutClear(GPIO_Port_TypeDef port, uint32_t pins);
+void GPIO_PortOutToggle(GPIO_Port_TypeDef port, uint32_t pins);
+void GPIO_PortOutSetVal(GPIO_Port_TypeDef port, uint32_t val, uint32_t mask);
+void GPIO_SlewrateSet(GPIO_Port_TypeDef port, uint32_t slewrate,
+                      uint32_t slewrateAlt);
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port,
+                           GPIO_DriveStrength_TypeDef strength);
+void GPIO_ExtIntConfig(GPIO_Port_TypeDef port, unsigned int pin,
+                       unsigned int intNo, bool risingEdge,
+                       bool fallingEdge, bool enable);
+uint32_t GPIO_IntGet(void);
+uint32_t GPIO_IntGetEnabled(void);
+void GPIO_IntClear(uint32_t flags);
+void GPIO_IntEnable(uint32_t flags);
+void GPIO_IntDisable(uint32_t flags);
+void GPIO_IntSet(uint32_t flags);
+void GPIO_EM4EnablePinWakeup(uint32_t pinmask, uint32_t polaritymask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EM_GPIO_H
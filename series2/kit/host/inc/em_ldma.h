@@ -0,0 +1,467 @@
+/***************************************************************************//**
+ * @file em_ldma.h
+ * @brief Host fake of the LDMA API: descriptors as laid out in memory,
+ * transfer configurations and the descriptor macros.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EM_LDMA_H
+#define EM_LDMA_H
+
+#include <stdbool.h>
+#include "em_device.h"
+#include "host.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  ldmaCtrlBlockSizeUnit1    = 0,
+  ldmaCtrlBlockSizeUnit2    = 1,
+  ldmaCtrlBlockSizeUnit3    = 2,
+  ldmaCtrlBlockSizeUnit4    = 3,
+  ldmaCtrlBlockSizeUnit6    = 4,
+  ldmaCtrlBlockSizeUnit8    = 5,
+  ldmaCtrlBlockSizeUnit16   = 7,
+  ldmaCtrlBlockSizeUnit32   = 9,
+  ldmaCtrlBlockSizeUnit64   = 10,
+  ldmaCtrlBlockSizeUnit128  = 11,
+  ldmaCtrlBlockSizeUnit256  = 12,
+  ldmaCtrlBlockSizeUnit512  = 13,
+  ldmaCtrlBlockSizeUnit1024 = 14,
+  ldmaCtrlBlockSizeAll      = 15,
+} LDMA_CtrlBlockSize_t;
+
+typedef enum {
+  ldmaCtrlStructTypeXfer  = 0,
+  ldmaCtrlStructTypeSync  = 1,
+  ldmaCtrlStructTypeWrite = 2,
+} LDMA_CtrlStructType_t;
+
+typedef enum {
+  ldmaCtrlReqModeBlock = 0,
+  ldmaCtrlReqModeAll   = 1,
+} LDMA_CtrlReqMode_t;
+
+typedef enum {
+  ldmaCtrlSrcIncOne  = 0,
+  ldmaCtrlSrcIncTwo  = 1,
+  ldmaCtrlSrcIncFour = 2,
+  ldmaCtrlSrcIncNone = 3,
+} LDMA_CtrlSrcInc_t;
+
+typedef enum {
+  ldmaCtrlSizeByte = 0,
+  ldmaCtrlSizeHalf = 1,
+  ldmaCtrlSizeWord = 2,
+} LDMA_CtrlSize_t;
+
+typedef enum {
+  ldmaCtrlDstIncOne  = 0,
+  ldmaCtrlDstIncTwo  = 1,
+  ldmaCtrlDstIncFour = 2,
+  ldmaCtrlDstIncNone = 3,
+} LDMA_CtrlDstInc_t;
+
+typedef enum {
+  ldmaCtrlSrcAddrModeAbs = 0,
+  ldmaCtrlSrcAddrModeRel = 1,
+} LDMA_CtrlSrcAddrMode_t;
+
+typedef enum {
+  ldmaCtrlDstAddrModeAbs = 0,
+  ldmaCtrlDstAddrModeRel = 1,
+} LDMA_CtrlDstAddrMode_t;
+
+typedef enum {
+  ldmaLinkModeAbs = 0,
+  ldmaLinkModeRel = 1,
+} LDMA_LinkMode_t;
+
+typedef enum {
+  ldmaCfgArbSlotsAs1 = 0,
+  ldmaCfgArbSlotsAs2 = 1,
+  ldmaCfgArbSlotsAs4 = 2,
+  ldmaCfgArbSlotsAs8 = 3,
+} LDMA_CfgArbSlots_t;
+
+typedef enum {
+  ldmaCfgSrcIncSignPos = 0,
+  ldmaCfgSrcIncSignNeg = 1,
+} LDMA_CfgSrcIncSign_t;
+
+typedef enum {
+  ldmaCfgDstIncSignPos = 0,
+  ldmaCfgDstIncSignNeg = 1,
+} LDMA_CfgDstIncSign_t;
+
+/*
+ * Request signals.  Only the TIMER requests are raised by a model; a
+ * channel waiting on another peripheral waits for ever.
+ */
+typedef enum {
+  ldmaPeripheralSignal_NONE = LDMAXBAR_CH_REQSEL_SOURCESEL_NONE,
+  ldmaPeripheralSignal_LDMAXBAR_PRSREQ0 =
+    LDMAXBAR_CH_REQSEL_SIGSEL_LDMAXBARPRSREQ0
+    | LDMAXBAR_CH_REQSEL_SOURCESEL_LDMAXBAR,
+  ldmaPeripheralSignal_LDMAXBAR_PRSREQ1 =
+    LDMAXBAR_CH_REQSEL_SIGSEL_LDMAXBARPRSREQ1
+    | LDMAXBAR_CH_REQSEL_SOURCESEL_LDMAXBAR,
+  ldmaPeripheralSignal_TIMER0_CC0 = (0x3UL << 16) | 0,
+  ldmaPeripheralSignal_TIMER0_CC1 = (0x3UL << 16) | 1,
+  ldmaPeripheralSignal_TIMER0_CC2 = (0x3UL << 16) | 2,
+  ldmaPeripheralSignal_TIMER0_UFOF = (0x3UL << 16) | 3,
+  ldmaPeripheralSignal_TIMER1_CC0 = (0x4UL << 16) | 0,
+  ldmaPeripheralSignal_TIMER1_CC1 = (0x4UL << 16) | 1,
+  ldmaPeripheralSignal_TIMER1_CC2 = (0x4UL << 16) | 2,
+  ldmaPeripheralSignal_TIMER1_UFOF = (0x4UL << 16) | 3,
+  ldmaPeripheralSignal_USART0_RXDATAV = (0x5UL << 16) | 0,
+  ldmaPeripheralSignal_USART0_RXDATAVRIGHT = (0x5UL << 16) | 1,
+  ldmaPeripheralSignal_USART0_TXBL = (0x5UL << 16) | 2,
+  ldmaPeripheralSignal_USART0_TXBLRIGHT = (0x5UL << 16) | 3,
+  ldmaPeripheralSignal_USART0_TXEMPTY = (0x5UL << 16) | 4,
+  ldmaPeripheralSignal_I2C0_RXDATAV = (0x6UL << 16) | 0,
+  ldmaPeripheralSignal_I2C0_TXBL = (0x6UL << 16) | 1,
+  ldmaPeripheralSignal_I2C1_RXDATAV = (0x7UL << 16) | 0,
+  ldmaPeripheralSignal_I2C1_TXBL = (0x7UL << 16) | 1,
+  ldmaPeripheralSignal_IADC0_IADC_SCAN = (0x8UL << 16) | 0,
+  ldmaPeripheralSignal_IADC0_IADC_SINGLE = (0x8UL << 16) | 1,
+  ldmaPeripheralSignal_TIMER2_CC0 = (0x9UL << 16) | 0,
+  ldmaPeripheralSignal_TIMER2_CC1 = (0x9UL << 16) | 1,
+  ldmaPeripheralSignal_TIMER2_CC2 = (0x9UL << 16) | 2,
+  ldmaPeripheralSignal_TIMER2_UFOF = (0x9UL << 16) | 3,
+  ldmaPeripheralSignal_TIMER3_CC0 = (0xAUL << 16) | 0,
+  ldmaPeripheralSignal_TIMER3_CC1 = (0xAUL << 16) | 1,
+  ldmaPeripheralSignal_TIMER3_CC2 = (0xAUL << 16) | 2,
+  ldmaPeripheralSignal_TIMER3_UFOF = (0xAUL << 16) | 3,
+  ldmaPeripheralSignal_EUSART0_RXFL = (0xBUL << 16) | 0,
+  ldmaPeripheralSignal_EUSART0_TXFL = (0xBUL << 16) | 1,
+  ldmaPeripheralSignal_EUSART1_RXFL = (0xCUL << 16) | 0,
+  ldmaPeripheralSignal_EUSART1_TXFL = (0xCUL << 16) | 1,
+  ldmaPeripheralSignal_TIMER4_CC0 = (0xDUL << 16) | 0,
+  ldmaPeripheralSignal_TIMER4_CC1 = (0xDUL << 16) | 1,
+  ldmaPeripheralSignal_TIMER4_CC2 = (0xDUL << 16) | 2,
+  ldmaPeripheralSignal_TIMER4_UFOF = (0xDUL << 16) | 3,
+  ldmaPeripheralSignal_MSC_WDATA = (0xEUL << 16) | 0,
+  ldmaPeripheralSignal_PDM_RXDATAV = (0xFUL << 16) | 0,
+  ldmaPeripheralSignal_EUART0_RXFL = ldmaPeripheralSignal_EUSART0_RXFL,
+  ldmaPeripheralSignal_EUART0_TXFL = ldmaPeripheralSignal_EUSART0_TXFL,
+} LDMA_PeripheralSignal_t;
+
+/// A descriptor, bit for bit as the LDMA reads it; 4 words
+typedef union {
+  struct {
+    uint32_t  structType   : 2;
+    uint32_t  reserved0    : 1;
+    uint32_t  structReq    : 1;
+    uint32_t  xferCnt      : 11;
+    uint32_t  byteSwap     : 1;
+    uint32_t  blockSize    : 4;
+    uint32_t  doneIfs      : 1;
+    uint32_t  reqMode      : 1;
+    uint32_t  decLoopCnt   : 1;
+    uint32_t  ignoreSrec   : 1;
+    uint32_t  srcInc       : 2;
+    uint32_t  size         : 2;
+    uint32_t  dstInc       : 2;
+    uint32_t  srcAddrMode  : 1;
+    uint32_t  dstAddrMode  : 1;
+
+    uint32_t  srcAddr;
+    uint32_t  dstAddr;
+
+    uint32_t  linkMode     : 1;
+    uint32_t  link         : 1;
+    uint32_t  linkAddr     : 30;  ///< Address or jump, in words
+  } xfer;
+
+  struct {
+    uint32_t  structType   : 2;
+    uint32_t  reserved0    : 1;
+    uint32_t  structReq    : 1;
+    uint32_t  xferCnt      : 11;
+    uint32_t  byteSwap     : 1;
+    uint32_t  blockSize    : 4;
+    uint32_t  doneIfs      : 1;
+    uint32_t  reqMode      : 1;
+    uint32_t  decLoopCnt   : 1;
+    uint32_t  ignoreSrec   : 1;
+    uint32_t  srcInc       : 2;
+    uint32_t  size         : 2;
+    uint32_t  dstInc       : 2;
+    uint32_t  srcAddrMode  : 1;
+    uint32_t  dstAddrMode  : 1;
+
+    uint32_t  syncSet      : 8;
+    uint32_t  syncClr      : 8;
+    uint32_t  reserved1    : 16;
+    uint32_t  matchVal     : 8;
+    uint32_t  matchEn      : 8;
+    uint32_t  reserved2    : 16;
+
+    uint32_t  linkMode     : 1;
+    uint32_t  link         : 1;
+    uint32_t  linkAddr     : 30;
+  } sync;
+
+  struct {
+    uint32_t  structType   : 2;
+    uint32_t  reserved0    : 1;
+    uint32_t  structReq    : 1;
+    uint32_t  xferCnt      : 11;
+    uint32_t  byteSwap     : 1;
+    uint32_t  blockSize    : 4;
+    uint32_t  doneIfs      : 1;
+    uint32_t  reqMode      : 1;
+    uint32_t  decLoopCnt   : 1;
+    uint32_t  ignoreSrec   : 1;
+    uint32_t  srcInc       : 2;
+    uint32_t  size         : 2;
+    uint32_t  dstInc       : 2;
+    uint32_t  srcAddrMode  : 1;
+    uint32_t  dstAddrMode  : 1;
+
+    uint32_t  immVal;
+    uint32_t  dstAddr;
+
+    uint32_t  linkMode     : 1;
+    uint32_t  link         : 1;
+    uint32_t  linkAddr     : 30;
+  } wri;
+} LDMA_Descriptor_t;
+
+typedef struct {
+  uint8_t   ldmaInitCtrlNumFixed;
+  uint8_t   ldmaInitCtrlSyncPrsClrEn;
+  uint8_t   ldmaInitCtrlSyncPrsSetEn;
+  uint8_t   ldmaInitIrqPriority;
+} LDMA_Init_t;
+
+typedef struct {
+  uint32_t              ldmaReqSel;
+  uint8_t               ldmaCtrlSyncPrsClrOff;
+  uint8_t               ldmaCtrlSyncPrsClrOn;
+  uint8_t               ldmaCtrlSyncPrsSetOff;
+  uint8_t               ldmaCtrlSyncPrsSetOn;
+  bool                  ldmaReqDis;
+  bool                  ldmaDbgHalt;
+  LDMA_CfgArbSlots_t    ldmaCfgArbSlots;
+  LDMA_CfgSrcIncSign_t  ldmaCfgSrcIncSign;
+  LDMA_CfgDstIncSign_t  ldmaCfgDstIncSign;
+  uint8_t               ldmaLoopCnt;
+} LDMA_TransferCfg_t;
+
+/// Size of a descriptor in words, the unit of relative links
+#define LDMA_DESCRIPTOR_NDWORDS   4
+
+#define LDMA_INIT_DEFAULT { 0, 0, 0, 3 }
+
+#define LDMA_TRANSFER_CFG_MEMORY()                          \
+  { 0, 0, 0, 0, 0, false, false, ldmaCfgArbSlotsAs1,        \
+    ldmaCfgSrcIncSignPos, ldmaCfgDstIncSignPos, 0 }
+
+#define LDMA_TRANSFER_CFG_MEMORY_LOOP(loopCnt)              \
+  { 0, 0, 0, 0, 0, false, false, ldmaCfgArbSlotsAs1,        \
+    ldmaCfgSrcIncSignPos, ldmaCfgDstIncSignPos, (loopCnt) }
+
+#define LDMA_TRANSFER_CFG_PERIPHERAL(signal)                \
+  { (signal), 0, 0, 0, 0, false, false, ldmaCfgArbSlotsAs1, \
+    ldmaCfgSrcIncSignPos, ldmaCfgDstIncSignPos, 0 }
+
+#define LDMA_TRANSFER_CFG_PERIPHERAL_LOOP(signal, loopCnt)  \
+  { (signal), 0, 0, 0, 0, false, false, ldmaCfgArbSlotsAs1, \
+    ldmaCfgSrcIncSignPos, ldmaCfgDstIncSignPos, (loopCnt) }
+
+/*
+ * Descriptor macros, as in emlib.  Addresses go through HOST_Addr(), which
+ * stops the simulation if host memory is above the 32-bit range; small
+ * negative numbers pass, as offsets for relative addressing.
+ */
+#define LDMA_DESCRIPTOR_XFER(sz, src, dest, count, sinc, dinc, req, mode, \
+                             bsize, ifs, lnk, lmode, ljmp)                \
+  {                                                                       \
+    .xfer =                                                               \
+    {                                                                     \
+      .structType   = ldmaCtrlStructTypeXfer,                             \
+      .structReq    = (req),                                              \
+      .xferCnt      = (count) - 1,                                        \
+      .byteSwap     = 0,                                                  \
+      .blockSize    = (bsize),                                            \
+      .doneIfs      = (ifs),                                              \
+      .reqMode      = (mode),                                             \
+      .decLoopCnt   = 0,                                                  \
+      .ignoreSrec   = 0,                                                  \
+      .srcInc       = (sinc),                                             \
+      .size         = (sz),                                               \
+      .dstInc       = (dinc),                                             \
+      .srcAddrMode  = ldmaCtrlSrcAddrModeAbs,                             \
+      .dstAddrMode  = ldmaCtrlDstAddrModeAbs,                             \
+      .srcAddr      = HOST_Addr((uintptr_t)(src)),                       \
+      .dstAddr      = HOST_Addr((uintptr_t)(dest)),                      \
+      .linkMode     = (lmode),                                            \
+      .link         = (lnk),                                              \
+      .linkAddr     = (ljmp) * LDMA_DESCRIPTOR_NDWORDS                    \
+    }                                                                     \
+  }
+
+#define LDMA_DESCRIPTOR_SINGLE_M2M(size, src, dest, count)                 \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncOne,          \
+                       ldmaCtrlDstIncOne, 1, ldmaCtrlReqModeAll,           \
+                       ldmaCtrlBlockSizeUnit1, 1, 0, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_M2M(size, src, dest, count, linkjmp)       \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncOne,          \
+                       ldmaCtrlDstIncOne, 1, ldmaCtrlReqModeAll,           \
+                       ldmaCtrlBlockSizeUnit1, 0, 1, ldmaLinkModeRel,      \
+                       linkjmp)
+#define LDMA_DESCRIPTOR_LINKABS_M2M(size, src, dest, count)                \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncOne,          \
+                       ldmaCtrlDstIncOne, 1, ldmaCtrlReqModeAll,           \
+                       ldmaCtrlBlockSizeUnit1, 0, 1, ldmaLinkModeAbs, 0)
+#define LDMA_DESCRIPTOR_SINGLE_P2M(size, src, dest, count)                 \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncNone,         \
+                       ldmaCtrlDstIncOne, 0, ldmaCtrlReqModeBlock,         \
+                       ldmaCtrlBlockSizeUnit1, 1, 0, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_P2M(size, src, dest, count, linkjmp)       \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncNone,         \
+                       ldmaCtrlDstIncOne, 0, ldmaCtrlReqModeBlock,         \
+                       ldmaCtrlBlockSizeUnit1, 1, 1, ldmaLinkModeRel,      \
+                       linkjmp)
+#define LDMA_DESCRIPTOR_SINGLE_M2P(size, src, dest, count)                 \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncOne,          \
+                       ldmaCtrlDstIncNone, 0, ldmaCtrlReqModeBlock,        \
+                       ldmaCtrlBlockSizeUnit1, 1, 0, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_M2P(size, src, dest, count, linkjmp)       \
+  LDMA_DESCRIPTOR_XFER(size, src, dest, count, ldmaCtrlSrcIncOne,          \
+                       ldmaCtrlDstIncNone, 0, ldmaCtrlReqModeBlock,        \
+                       ldmaCtrlBlockSizeUnit1, 1, 1, ldmaLinkModeRel,      \
+                       linkjmp)
+
+#define LDMA_DESCRIPTOR_SINGLE_M2M_BYTE(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_M2M(ldmaCtrlSizeByte, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_M2M_HALF(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_M2M(ldmaCtrlSizeHalf, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_M2M_WORD(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_M2M(ldmaCtrlSizeWord, src, dest, count)
+#define LDMA_DESCRIPTOR_LINKREL_M2M_BYTE(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_M2M(ldmaCtrlSizeByte, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKREL_M2M_HALF(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_M2M(ldmaCtrlSizeHalf, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKREL_M2M_WORD(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_M2M(ldmaCtrlSizeWord, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKABS_M2M_BYTE(src, dest, count) \
+  LDMA_DESCRIPTOR_LINKABS_M2M(ldmaCtrlSizeByte, src, dest, count)
+#define LDMA_DESCRIPTOR_LINKABS_M2M_HALF(src, dest, count) \
+  LDMA_DESCRIPTOR_LINKABS_M2M(ldmaCtrlSizeHalf, src, dest, count)
+#define LDMA_DESCRIPTOR_LINKABS_M2M_WORD(src, dest, count) \
+  LDMA_DESCRIPTOR_LINKABS_M2M(ldmaCtrlSizeWord, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_P2M(ldmaCtrlSizeByte, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_P2M_HALF(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_P2M(ldmaCtrlSizeHalf, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_P2M_WORD(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_P2M(ldmaCtrlSizeWord, src, dest, count)
+#define LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_P2M(ldmaCtrlSizeByte, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKREL_P2M_HALF(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_P2M(ldmaCtrlSizeHalf, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKREL_P2M_WORD(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_P2M(ldmaCtrlSizeWord, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_M2P(ldmaCtrlSizeByte, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_M2P_HALF(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_M2P(ldmaCtrlSizeHalf, src, dest, count)
+#define LDMA_DESCRIPTOR_SINGLE_M2P_WORD(src, dest, count) \
+  LDMA_DESCRIPTOR_SINGLE_M2P(ldmaCtrlSizeWord, src, dest, count)
+#define LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_M2P(ldmaCtrlSizeByte, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKREL_M2P_HALF(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_M2P(ldmaCtrlSizeHalf, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_LINKREL_M2P_WORD(src, dest, count, linkjmp) \
+  LDMA_DESCRIPTOR_LINKREL_M2P(ldmaCtrlSizeWord, src, dest, count, linkjmp)
+#define LDMA_DESCRIPTOR_SINGLE_P2P_BYTE(src, dest, count)                  \
+  LDMA_DESCRIPTOR_XFER(ldmaCtrlSizeByte, src, dest, count,                 \
+                       ldmaCtrlSrcIncNone, ldmaCtrlDstIncNone, 0,          \
+                       ldmaCtrlReqModeBlock, ldmaCtrlBlockSizeUnit1, 1,    \
+                       0, 0, 0)
+
+#define LDMA_DESCRIPTOR_WRITE(value, address, ifs, lnk, ljmp)             \
+  {                                                                       \
+    .wri =                                                                \
+    {                                                                     \
+      .structType   = ldmaCtrlStructTypeWrite,                            \
+      .structReq    = 1,                                                  \
+      .xferCnt      = 0,                                                  \
+      .byteSwap     = 0,                                                  \
+      .blockSize    = 0,                                                  \
+      .doneIfs      = (ifs),                                              \
+      .reqMode      = 0,                                                  \
+      .decLoopCnt   = 0,                                                  \
+      .ignoreSrec   = 0,                                                  \
+      .srcInc       = 0,                                                  \
+      .size         = 0,                                                  \
+      .dstInc       = 0,                                                  \
+      .srcAddrMode  = 0,                                                  \
+      .dstAddrMode  = 0,                                                  \
+      .immVal       = (value),                                            \
+      .dstAddr      = HOST_Addr((uintptr_t)(address)),                   \
+      .linkMode     = ldmaLinkModeRel,                                    \
+      .link         = (lnk),                                              \
+      .linkAddr     = (ljmp) * LDMA_DESCRIPTOR_NDWORDS                    \
+    }                                                                     \
+  }
+
+#define LDMA_DESCRIPTOR_SINGLE_WRITE(value, address) \
+  LDMA_DESCRIPTOR_WRITE(value, address, 1, 0, 0)
+#define LDMA_DESCRIPTOR_LINKREL_WRITE(value, address, linkjmp) \
+  LDMA_DESCRIPTOR_WRITE(value, address, 0, 1, linkjmp)
+
+void LDMA_Init(const LDMA_Init_t *init);
+void LDMA_DeInit(void);
+void LDMA_StartTransfer(int ch, const LDMA_TransferCfg_t *transfer,
+                        const LDMA_Descriptor_t *descriptor);
+void LDMA_StopTransfer(int ch);
+bool LDMA_TransferDone(int ch);
+uint32_t LDMA_TransferRemainingCount(int ch);
+void LDMA_EnableChannelRequest(int ch, bool enable);
+uint32_t LDMA_IntGet(void);
+uint32_t LDMA_IntGetEnabled(void);
+void LDMA_IntClear(uint32_t flags);
+void LDMA_IntEnable(uint32_t flags);
+void LDMA_IntDisable(uint32_t flags);
+void LDMA_IntSet(uint32_t flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EM_LDMA_H
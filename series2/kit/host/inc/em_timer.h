@@ -0,0 +1,192 @@
+/***************************************************************************//**
+ * @file em_timer.h
+ * @brief Host fake of the TIMER API: up and down counting, compare, PWM
+ * and input capture on pins.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef EM_TIMER_H
+#define EM_TIMER_H
+
+#include <stdbool.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  timerCCModeOff,
+  timerCCModeCapture,
+  timerCCModeCompare,
+  timerCCModePWM,
+} TIMER_CCMode_TypeDef;
+
+typedef enum {
+  timerClkSelHFPerClk,
+  timerClkSelCC1,
+  timerClkSelCascade,
+} TIMER_ClkSel_TypeDef;
+
+typedef enum {
+  timerEdgeRising,
+  timerEdgeFalling,
+  timerEdgeBoth,
+  timerEdgeNone,
+} TIMER_Edge_TypeDef;
+
+typedef enum {
+  timerEventEveryEdge,
+  timerEventEvery2ndEdge,
+  timerEventRising,
+  timerEventFalling,
+} TIMER_Event_TypeDef;
+
+typedef enum {
+  timerInputActionNone,
+  timerInputActionStart,
+  timerInputActionStop,
+  timerInputActionReloadStart,
+} TIMER_InputAction_TypeDef;
+
+typedef enum {
+  timerModeUp,
+  timerModeDown,
+  timerModeUpDown,
+  timerModeQDec,
+} TIMER_Mode_TypeDef;
+
+typedef enum {
+  timerOutputActionNone,
+  timerOutputActionToggle,
+  timerOutputActionClear,
+  timerOutputActionSet,
+} TIMER_OutputAction_TypeDef;
+
+/// Prescaler; the value plus one is the division factor
+typedef enum {
+  timerPrescale1    = 0,
+  timerPrescale2    = 1,
+  timerPrescale4    = 3,
+  timerPrescale8    = 7,
+  timerPrescale16   = 15,
+  timerPrescale32   = 31,
+  timerPrescale64   = 63,
+  timerPrescale128  = 127,
+  timerPrescale256  = 255,
+  timerPrescale512  = 511,
+  timerPrescale1024 = 1023,
+} TIMER_Prescale_TypeDef;
+
+typedef enum {
+  timerPrsInputNone,
+  timerPrsInputSync,
+  timerPrsInputAsyncLevel,
+  timerPrsInputAsyncPulse,
+} TIMER_PrsInput_TypeDef;
+
+typedef enum {
+  timerPrsOutputPulse,
+  timerPrsOutputLevel,
+  timerPrsOutputDefault,
+} TIMER_PrsOutput_t;
+
+typedef struct {
+  bool                      enable;
+  bool                      debugRun;
+  TIMER_Prescale_TypeDef    prescale;
+  TIMER_ClkSel_TypeDef      clkSel;
+  bool                      count2x;
+  bool                      ati;
+  bool                      rssCoist;
+  TIMER_InputAction_TypeDef fallAction;
+  TIMER_InputAction_TypeDef riseAction;
+  TIMER_Mode_TypeDef        mode;
+  bool                      dmaClrAct;
+  bool                      quadModeX4;
+  bool                      oneShot;
+  bool                      sync;
+  bool                      disSyncOut;
+} TIMER_Init_TypeDef;
+
+#define TIMER_INIT_DEFAULT                                                 \
+  { true, true, timerPrescale1, timerClkSelHFPerClk, false, false, false, \
+    timerInputActionNone, timerInputActionNone, timerModeUp, false,       \
+    false, false, false, false }
+
+typedef struct {
+  TIMER_Event_TypeDef         eventCtrl;
+  TIMER_Edge_TypeDef          edge;
+  uint32_t                    prsSel;
+  TIMER_OutputAction_TypeDef  cufoa;
+  TIMER_OutputAction_TypeDef  cofoa;
+  TIMER_OutputAction_TypeDef  cmoa;
+  TIMER_CCMode_TypeDef        mode;
+  bool                        filter;
+  bool                        prsInput;
+  bool                        coist;
+  bool                        outInvert;
+  TIMER_PrsOutput_t           prsOutput;
+  TIMER_PrsInput_TypeDef      prsInputType;
+} TIMER_InitCC_TypeDef;
+
+#define TIMER_INITCC_DEFAULT                                             \
+  { timerEventEveryEdge, timerEdgeRising, 0, timerOutputActionNone,     \
+    timerOutputActionNone, timerOutputActionToggle, timerCCModeOff,     \
+    false, false, false, false, timerPrsOutputDefault, timerPrsInputNone }
+
+void TIMER_Init(TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init);
+void TIMER_InitCC(TIMER_TypeDef *timer, unsigned int ch,
+                  const TIMER_InitCC_TypeDef *init);
+void TIMER_Reset(TIMER_TypeDef *timer);
+void TIMER_Enable(TIMER_TypeDef *timer, bool enable);
+uint32_t TIMER_CounterGet(TIMER_TypeDef *timer);
+void TIMER_CounterSet(TIMER_TypeDef *timer, uint32_t val);
+uint32_t TIMER_TopGet(TIMER_TypeDef *timer);
+void TIMER_TopSet(TIMER_TypeDef *timer, uint32_t val);
+void TIMER_TopBufSet(TIMER_TypeDef *timer, uint32_t val);
+void TIMER_CompareSet(TIMER_TypeDef *timer, unsigned int ch, uint32_t val);
+void TIMER_CompareBufSet(TIMER_TypeDef *timer, unsigned int ch, uint32_t val);
+uint32_t TIMER_CaptureGet(TIMER_TypeDef *timer, unsigned int ch);
+uint32_t TIMER_CaptureBufGet(TIMER_TypeDef *timer, unsigned int ch);
+uint32_t TIMER_IntGet(TIMER_TypeDef *timer);
+uint32_t TIMER_IntGetEnabled(TIMER_TypeDef *timer);
+void TIMER_IntClear(TIMER_TypeDef *timer, uint32_t flags);
+void TIMER_IntEnable(TIMER_TypeDef *timer, uint32_t flags);
+void TIMER_IntDisable(TIMER_TypeDef *timer, uint32_t flags);
+void TIMER_IntSet(TIMER_TypeDef *timer, uint32_t flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EM_TIMER_H
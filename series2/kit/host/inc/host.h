@@ -0,0 +1,142 @@
+/***************************************************************************//**
+ * @file host.h
+ * @brief Simulated time, interrupts and test hooks of the host fake emlib.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "em_device.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Time is kept in picoseconds from reset, so that periods of every clock
+ * in the device are exact enough over hours of simulated time.
+ */
+#define HOST_PS_PER_S         1000000000000ULL
+#define HOST_US(us)           ((uint64_t)(us) * 1000000ULL)
+#define HOST_MS(ms)           ((uint64_t)(ms) * 1000000000ULL)
+
+/// Simulated time when no limit is set, unless HOST_SIM_MS overrides it
+#ifndef HOST_DEFAULT_LIMIT_MS
+#define HOST_DEFAULT_LIMIT_MS 1000
+#endif
+
+/// Wall-clock seconds after which a stuck simulation is stopped
+#ifndef HOST_WALL_SECONDS
+#define HOST_WALL_SECONDS     20
+#endif
+
+/// Handler runs without simulated time passing that count as a storm
+#ifndef HOST_STORM_LIMIT
+#define HOST_STORM_LIMIT      100000
+#endif
+
+/// Cycles taken by each polling call, such as a flag read in a loop
+#ifndef HOST_POLL_CYCLES
+#define HOST_POLL_CYCLES      4
+#endif
+
+typedef void (*HOST_EventFn_TypeDef)(void *ctx);
+
+/// An event in the simulated time line; owned by the caller
+typedef struct HOST_Event {
+  struct HOST_Event     *next;
+  uint64_t              time;       ///< ps
+  HOST_EventFn_TypeDef  fn;
+  void                  *ctx;
+  bool                  queued;
+  bool                  hfClock;    ///< Stops in EM2 and below on hardware
+} HOST_Event_TypeDef;
+
+/// Called on every pin level change
+typedef void (*HOST_PinWatch_TypeDef)(unsigned int port, unsigned int pin,
+                                      int level, uint64_t time);
+
+/// Called when an LDMA channel completes a descriptor
+typedef void (*HOST_LdmaWatch_TypeDef)(int ch, uint32_t descriptor,
+                                       uint64_t time);
+
+// Time line
+uint64_t HOST_TimePs(void);
+uint64_t HOST_CyclesPs(uint64_t cycles, uint32_t hz);
+void HOST_EventAt(HOST_Event_TypeDef *event, uint64_t time,
+                  HOST_EventFn_TypeDef fn, void *ctx);
+void HOST_EventCancel(HOST_Event_TypeDef *event);
+void HOST_Busy(uint64_t cycles);
+void HOST_Poll(void);
+void HOST_Sync(void);
+void HOST_Sleep(int em);
+void HOST_SetLimit(uint64_t ps);
+
+// End of the simulation
+void HOST_Finish(const char *reason, int status);
+void HOST_Unsupported(const char *what);
+uint32_t HOST_Addr(uintptr_t address);
+void *HOST_Ptr(uint32_t addr);
+
+// Statistics
+uint64_t HOST_TimeInEm(int em);
+uint32_t HOST_IrqCount(IRQn_Type irq);
+uint32_t HOST_Em2Violations(void);
+
+// Stimulus and probes
+void HOST_GpioInput(unsigned int port, unsigned int pin, int level);
+int HOST_GpioLevel(unsigned int port, unsigned int pin);
+void HOST_GpioWatch(HOST_PinWatch_TypeDef fn);
+void HOST_LdmaWatch(HOST_LdmaWatch_TypeDef fn);
+void HOST_SerialInput(const char *text);
+
+// Scenario hooks; weak defaults do nothing
+void HOST_Setup(void);
+int HOST_Teardown(void);
+
+// Between models
+void HOST_GpioSync(void);
+void HOST_GpioDrive(unsigned int port, unsigned int pin, int level);
+void HOST_LdmaSync(void);
+void HOST_LdmaRequest(uint32_t source, uint32_t signal);
+void HOST_TimerSync(void);
+void HOST_ClockChanged(void);
+void HOST_TimerPin(unsigned int port, unsigned int pin, int level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_H
@@ -0,0 +1,244 @@
+/***************************************************************************//**
+ * @file em_cmu.c
+ * @brief Host fake of the clock management API.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_cmu.h"
+#include "host.h"
+
+#define LF_HZ       32768UL
+#define ULFRCO_HZ   1000UL
+#define FSRCO_HZ    20000000UL
+
+static bool clockOn[cmuClock_COUNT];
+static uint32_t hfrcodpllHz = 19000000UL;
+static CMU_Select_TypeDef sysclkSel = cmuSelect_HFRCODPLL;
+static CMU_Select_TypeDef em01grpaSel = cmuSelect_HFRCODPLL;
+static CMU_Select_TypeDef em23grpaSel = cmuSelect_LFRCO;
+static CMU_Select_TypeDef em4grpaSel = cmuSelect_LFRCO;
+static CMU_Select_TypeDef sysrtcSel = cmuSelect_LFRCO;
+static CMU_Select_TypeDef iadcSel = cmuSelect_FSRCO;
+static CMU_Select_TypeDef eusart0Sel = cmuSelect_EM01GRPACLK;
+static CMU_Select_TypeDef wdog0Sel = cmuSelect_LFRCO;
+static CMU_Select_TypeDef wdog1Sel = cmuSelect_LFRCO;
+
+static uint32_t selectHz(CMU_Select_TypeDef sel)
+{
+  switch (sel) {
+    case cmuSelect_FSRCO:
+      return FSRCO_HZ;
+    case cmuSelect_HFXO:
+      return HOST_HFXO_HZ;
+    case cmuSelect_HFRCODPLL:
+      return hfrcodpllHz;
+    case cmuSelect_HFRCOEM23:
+      return 19000000UL;
+    case cmuSelect_LFXO:
+    case cmuSelect_LFRCO:
+      return LF_HZ;
+    case cmuSelect_ULFRCO:
+      return ULFRCO_HZ;
+    case cmuSelect_HCLK:
+      return selectHz(sysclkSel);
+    case cmuSelect_HCLKDIV1024:
+      return selectHz(sysclkSel) / 1024;
+    case cmuSelect_EM01GRPACLK:
+      return selectHz(em01grpaSel);
+    case cmuSelect_EM23GRPACLK:
+      return selectHz(em23grpaSel);
+    default:
+      return 0;
+  }
+}
+
+static CMU_Select_TypeDef *selector(CMU_Clock_TypeDef clock)
+{
+  switch (clock) {
+    case cmuClock_SYSCLK:
+    case cmuClock_HCLK:
+    case cmuClock_CORE:
+      return &sysclkSel;
+    case cmuClock_EM01GRPACLK:
+      return &em01grpaSel;
+    case cmuClock_EM23GRPACLK:
+      return &em23grpaSel;
+    case cmuClock_EM4GRPACLK:
+      return &em4grpaSel;
+    case cmuClock_SYSRTCCLK:
+      return &sysrtcSel;
+    case cmuClock_IADCCLK:
+      return &iadcSel;
+    case cmuClock_EUSART0CLK:
+      return &eusart0Sel;
+    case cmuClock_WDOG0CLK:
+      return &wdog0Sel;
+    case cmuClock_WDOG1CLK:
+      return &wdog1Sel;
+    default:
+      return NULL;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The core clock and the timers follow frequency changes.
+ *****************************************************************************/
+static void clockChanged(void)
+{
+  SystemCoreClock = selectHz(sysclkSel);
+  HOST_ClockChanged();
+}
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+  clockOn[clock] = enable;
+}
+
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+{
+  CMU_Select_TypeDef *sel = selector(clock);
+
+  if (sel != NULL) {
+    return selectHz(*sel);
+  }
+  switch (clock) {
+    case cmuClock_LFXO:
+    case cmuClock_LFRCO:
+      return LF_HZ;
+    case cmuClock_ULFRCO:
+      return ULFRCO_HZ;
+    case cmuClock_HFXO:
+      return HOST_HFXO_HZ;
+    case cmuClock_HFRCODPLL:
+      return hfrcodpllHz;
+    case cmuClock_HFRCOEM23:
+      return selectHz(cmuSelect_HFRCOEM23);
+    case cmuClock_TIMER0:
+    case cmuClock_TIMER1:
+    case cmuClock_TIMER2:
+    case cmuClock_TIMER3:
+    case cmuClock_TIMER4:
+    case cmuClock_USART0:
+    case cmuClock_EUSART1:
+    case cmuClock_I2C1:
+    case cmuClock_PDM:
+      return selectHz(em01grpaSel);
+    case cmuClock_LETIMER0:
+    case cmuClock_LESENSE:
+      return selectHz(em23grpaSel);
+    case cmuClock_BURTC:
+      return selectHz(em4grpaSel);
+    case cmuClock_SYSRTC:
+      return selectHz(sysrtcSel);
+    case cmuClock_EUSART0:
+      return selectHz(eusart0Sel);
+    case cmuClock_IADC0:
+      return selectHz(iadcSel);
+    default:
+      // Bus clocks of the other peripherals run at HCLK
+      return selectHz(sysclkSel);
+  }
+}
+
+void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref)
+{
+  CMU_Select_TypeDef *sel = selector(clock);
+
+  if (sel == NULL) {
+    HOST_Unsupported("clock select of this clock");
+  }
+  *sel = ref;
+  clockChanged();
+}
+
+CMU_Select_TypeDef CMU_ClockSelectGet(CMU_Clock_TypeDef clock)
+{
+  CMU_Select_TypeDef *sel = selector(clock);
+
+  return (sel != NULL) ? *sel : cmuSelect_Error;
+}
+
+void CMU_ClockDivSet(CMU_Clock_TypeDef clock, uint32_t div)
+{
+  (void)clock;
+  if (div != 1) {
+    HOST_Unsupported("clock dividers");
+  }
+}
+
+uint32_t CMU_ClockDivGet(CMU_Clock_TypeDef clock)
+{
+  (void)clock;
+  return 1;
+}
+
+void CMU_HFRCODPLLBandSet(CMU_HFRCODPLLFreq_TypeDef freq)
+{
+  hfrcodpllHz = (uint32_t)freq;
+  clockChanged();
+}
+
+CMU_HFRCODPLLFreq_TypeDef CMU_HFRCODPLLBandGet(void)
+{
+  return (CMU_HFRCODPLLFreq_TypeDef)hfrcodpllHz;
+}
+
+void CMU_LFXOInit(const CMU_LFXOInit_TypeDef *init)
+{
+  (void)init;
+}
+
+void CMU_HFXOInit(const CMU_HFXOInit_TypeDef *init)
+{
+  (void)init;
+}
+
+void CMU_OscillatorEnable(CMU_Osc_TypeDef osc, bool enable, bool wait)
+{
+  (void)osc;
+  (void)enable;
+  (void)wait;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Register access with the bus clock off faults on series 2 devices.
+ *****************************************************************************/
+void HOST_ClockRequire(CMU_Clock_TypeDef clock, const char *peripheral)
+{
+  if (!clockOn[clock]) {
+    fprintf(stderr, "host: %s accessed with its bus clock off\n", peripheral);
+    HOST_Finish("bus fault", 2);
+  }
+}
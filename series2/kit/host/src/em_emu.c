@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ * @file em_emu.c
+ * @brief Host fake of the energy management API.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_emu.h"
+#include "host.h"
+
+void EMU_DCDCInit(const EMU_DCDCInit_TypeDef *init)
+{
+  (void)init;
+}
+
+void EMU_EnterEM1(void)
+{
+  HOST_Sleep(1);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   EM2 and EM3 sleep.  HF clocked peripherals keep running in the model;
+ *   their events are counted as violations in the summary instead.
+ *****************************************************************************/
+void EMU_EnterEM2(bool restore)
+{
+  (void)restore;
+  HOST_Sleep(2);
+}
+
+void EMU_EnterEM3(bool restore)
+{
+  (void)restore;
+  HOST_Sleep(3);
+}
+
+void EMU_EnterEM4(void)
+{
+  HOST_Finish("EM4", 0);
+}
+
+void EMU_Restore(void)
+{
+}
@@ -0,0 +1,404 @@
+/***************************************************************************//**
+ * @file em_gpio.c
+ * @brief Host fake of the GPIO API.  Pin levels follow from the mode, the
+ * output, the pull, what the scenario drives and what peripherals drive.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_cmu.h"
+#include "em_gpio.h"
+#include "host.h"
+
+#define PORTS     (GPIO_PORT_MAX + 1)
+#define PINS      (GPIO_PIN_MAX + 1)
+#define WATCHES   8
+
+GPIO_TypeDef HOST_GPIO;
+
+// Levels driven from outside the device and by peripherals; -1 is none
+static int8_t external[PORTS][PINS];
+static int8_t peripheral[PORTS][PINS];
+static uint8_t wire[PORTS][PINS];
+static bool started;
+static HOST_PinWatch_TypeDef watches[WATCHES];
+
+static void start(void)
+{
+  unsigned int port, pin;
+
+  if (!started) {
+    started = true;
+    for (port = 0; port < PORTS; port++) {
+      for (pin = 0; pin < PINS; pin++) {
+        external[port][pin] = -1;
+        peripheral[port][pin] = -1;
+      }
+    }
+  }
+}
+
+static GPIO_Mode_TypeDef mode(unsigned int port, unsigned int pin)
+{
+  uint32_t reg = (pin < 8) ? GPIO->P[port].MODEL : GPIO->P[port].MODEH;
+
+  return (GPIO_Mode_TypeDef)((reg >> ((pin & 7) * 4)) & 0xF);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Level on a pin.  A floating input reads low, a floating wired-and
+ *   output high.
+ *****************************************************************************/
+static int level(unsigned int port, unsigned int pin)
+{
+  GPIO_Mode_TypeDef m = mode(port, pin);
+  int ext = external[port][pin];
+  int out = (peripheral[port][pin] >= 0) ? peripheral[port][pin]
+            : (int)((GPIO->P[port].DOUT >> pin) & 1);
+
+  switch (m) {
+    case gpioModeDisabled:
+    case gpioModeInputPull:
+    case gpioModeInputPullFilter:
+      // Disabled pins keep the pull-up that DOUT selects
+      return (ext >= 0) ? ext : (int)((GPIO->P[port].DOUT >> pin) & 1);
+    case gpioModeInput:
+      return (ext >= 0) ? ext : 0;
+    case gpioModePushPull:
+    case gpioModePushPullAlternate:
+      return out;
+    case gpioModeWiredOr:
+    case gpioModeWiredOrPullDown:
+      return out ? 1 : ((ext >= 0) ? ext : 0);
+    default:
+      return !out ? 0 : ((ext >= 0) ? ext : 1);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Update DIN and the wire levels; edges on pins selected for external
+ *   interrupts set their flags.
+ *****************************************************************************/
+static void update(void)
+{
+  unsigned int port, pin, i;
+  int now, was;
+  uint32_t din;
+
+  start();
+  for (port = 0; port < PORTS; port++) {
+    din = 0;
+    for (pin = 0; pin < PINS; pin++) {
+      now = level(port, pin);
+      was = wire[port][pin];
+      if (mode(port, pin) != gpioModeDisabled) {
+        din |= (uint32_t)now << pin;
+      }
+      if (now == was) {
+        continue;
+      }
+      wire[port][pin] = (uint8_t)now;
+      HOST_TimerPin(port, pin, now);
+      for (i = 0; i < WATCHES; i++) {
+        if (watches[i] != NULL) {
+          watches[i](port, pin, now, HOST_TimePs());
+        }
+      }
+    }
+    for (i = 0; i < 16; i++) {
+      uint32_t sel = (i < 8) ? GPIO->EXTIPSELL : GPIO->EXTIPSELH;
+      uint32_t pinSel = (i < 8) ? GPIO->EXTIPINSELL : GPIO->EXTIPINSELH;
+      uint32_t extPort = (sel >> ((i & 7) * 4)) & 0xF;
+      uint32_t extPin = (i & ~3U) + ((pinSel >> ((i & 7) * 4)) & 0x3);
+      uint32_t before = (GPIO->P[port].DIN >> extPin) & 1;
+      uint32_t after = (din >> extPin) & 1;
+
+      if ((extPort != port) || (before == after)) {
+        continue;
+      }
+      if ((after && (GPIO->EXTIRISE & (1UL << i)))
+          || (!after && (GPIO->EXTIFALL & (1UL << i)))) {
+        GPIO->IF |= 1UL << i;
+      }
+    }
+    GPIO->P[port].DIN = din;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take writes to the set and clear aliases and direct register writes.
+ *****************************************************************************/
+void HOST_GpioSync(void)
+{
+  GPIO->IF = (GPIO->IF | GPIO->IF_SET) & ~GPIO->IF_CLR;
+  GPIO->IEN = (GPIO->IEN | GPIO->IEN_SET) & ~GPIO->IEN_CLR;
+  GPIO->IF_SET = GPIO->IF_CLR = GPIO->IEN_SET = GPIO->IEN_CLR = 0;
+  update();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Drive a pin from outside the device, as a button or another chip.
+ *
+ * @param[in] level
+ *   0 or 1, or -1 to release the pin.
+ *****************************************************************************/
+void HOST_GpioInput(unsigned int port, unsigned int pin, int level)
+{
+  start();
+  external[port][pin] = (int8_t)level;
+  HOST_GpioSync();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Output of a peripheral routed to a pin, which overrides DOUT.
+ *****************************************************************************/
+void HOST_GpioDrive(unsigned int port, unsigned int pin, int level)
+{
+  start();
+  peripheral[port][pin] = (int8_t)level;
+  update();
+}
+
+int HOST_GpioLevel(unsigned int port, unsigned int pin)
+{
+  HOST_GpioSync();
+  return wire[port][pin];
+}
+
+void HOST_GpioWatch(HOST_PinWatch_TypeDef fn)
+{
+  unsigned int i;
+
+  for (i = 0; i < WATCHES; i++) {
+    if (watches[i] == NULL) {
+      watches[i] = fn;
+      return;
+    }
+  }
+  HOST_Unsupported("more than 8 pin watches");
+}
+
+/*******************************************************************************
+ *******************************   EMLIB API   *********************************
+ ******************************************************************************/
+
+static void access(void)
+{
+  HOST_ClockRequire(cmuClock_GPIO, "GPIO");
+}
+
+void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin,
+                     GPIO_Mode_TypeDef mode, unsigned int out)
+{
+  volatile uint32_t *reg = (pin < 8) ? &GPIO->P[port].MODEL
+                           : &GPIO->P[port].MODEH;
+  unsigned int shift = (pin & 7) * 4;
+
+  access();
+  // DOUT first, so that an output does not glitch, as in emlib
+  if (out) {
+    GPIO->P[port].DOUT |= 1UL << pin;
+  } else {
+    GPIO->P[port].DOUT &= ~(1UL << pin);
+  }
+  *reg = (*reg & ~(0xFUL << shift)) | ((uint32_t)mode << shift);
+  HOST_Sync();
+}
+
+GPIO_Mode_TypeDef GPIO_PinModeGet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+  access();
+  return mode(port, pin);
+}
+
+unsigned int GPIO_PinInGet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+  access();
+  HOST_Poll();
+  return (GPIO->P[port].DIN >> pin) & 1;
+}
+
+unsigned int GPIO_PinOutGet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+  access();
+  return (GPIO->P[port].DOUT >> pin) & 1;
+}
+
+void GPIO_PinOutSet(GPIO_Port_TypeDef port, unsigned int pin)
+{
+  GPIO_PortOutSet(port, 1UL << pin);
+}
+
+void GPIO_PinOutClear(GPIO_Port_TypeDef port, unsigned int pin)
+{
+  GPIO_PortOutClear(port, 1UL << pin);
+}
+
+void GPIO_PinOutToggle(GPIO_Port_TypeDef port, unsigned int pin)
+{
+  GPIO_PortOutToggle(port, 1UL << pin);
+}
+
+uint32_t GPIO_PortInGet(GPIO_Port_TypeDef port)
+{
+  access();
+  HOST_Poll();
+  return GPIO->P[port].DIN;
+}
+
+uint32_t GPIO_PortOutGet(GPIO_Port_TypeDef port)
+{
+  access();
+  return GPIO->P[port].DOUT;
+}
+
+void GPIO_PortOutSet(GPIO_Port_TypeDef port, uint32_t pins)
+{
+  access();
+  GPIO->P[port].DOUT |= pins;
+  HOST_Sync();
+}
+
+void GPIO_PortOutClear(GPIO_Port_TypeDef port, uint32_t pins)
+{
+  access();
+  GPIO->P[port].DOUT &= ~pins;
+  HOST_Sync();
+}
+
+void GPIO_PortOutToggle(GPIO_Port_TypeDef port, uint32_t pins)
+{
+  access();
+  GPIO->P[port].DOUT ^= pins;
+  HOST_Sync();
+}
+
+void GPIO_PortOutSetVal(GPIO_Port_TypeDef port, uint32_t val, uint32_t mask)
+{
+  access();
+  GPIO->P[port].DOUT = (GPIO->P[port].DOUT & ~mask) | (val & mask);
+  HOST_Sync();
+}
+
+void GPIO_SlewrateSet(GPIO_Port_TypeDef port, uint32_t slewrate,
+                      uint32_t slewrateAlt)
+{
+  (void)port;
+  (void)slewrate;
+  (void)slewrateAlt;
+  access();
+}
+
+void GPIO_DriveStrengthSet(GPIO_Port_TypeDef port,
+                           GPIO_DriveStrength_TypeDef strength)
+{
+  (void)port;
+  (void)strength;
+  access();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Select a pin for an external interrupt.  On series 2, interrupt n can
+ *   only take pins n & ~3 to (n & ~3) + 3 of a port.
+ *****************************************************************************/
+void GPIO_ExtIntConfig(GPIO_Port_TypeDef port, unsigned int pin,
+                       unsigned int intNo, bool risingEdge,
+                       bool fallingEdge, bool enable)
+{
+  volatile uint32_t *sel = (intNo < 8) ? &GPIO->EXTIPSELL : &GPIO->EXTIPSELH;
+  volatile uint32_t *pinSel = (intNo < 8) ? &GPIO->EXTIPINSELL
+                              : &GPIO->EXTIPINSELH;
+  unsigned int shift = (intNo & 7) * 4;
+  uint32_t mask = 1UL << intNo;
+
+  access();
+  if ((intNo > 15) || ((pin & ~3U) != (intNo & ~3U))) {
+    HOST_Unsupported("GPIO_ExtIntConfig() pin outside the interrupt's group");
+  }
+  *sel = (*sel & ~(0xFUL << shift)) | ((uint32_t)port << shift);
+  *pinSel = (*pinSel & ~(0xFUL << shift)) | ((uint32_t)(pin & 3) << shift);
+  GPIO->EXTIRISE = risingEdge ? (GPIO->EXTIRISE | mask)
+                   : (GPIO->EXTIRISE & ~mask);
+  GPIO->EXTIFALL = fallingEdge ? (GPIO->EXTIFALL | mask)
+                   : (GPIO->EXTIFALL & ~mask);
+  GPIO->IF &= ~mask;
+  GPIO->IEN = enable ? (GPIO->IEN | mask) : (GPIO->IEN & ~mask);
+  HOST_Sync();
+}
+
+uint32_t GPIO_IntGet(void)
+{
+  HOST_Poll();
+  return GPIO->IF;
+}
+
+uint32_t GPIO_IntGetEnabled(void)
+{
+  HOST_Poll();
+  return GPIO->IF & GPIO->IEN;
+}
+
+void GPIO_IntClear(uint32_t flags)
+{
+  GPIO->IF &= ~flags;
+  HOST_Sync();
+}
+
+void GPIO_IntEnable(uint32_t flags)
+{
+  GPIO->IEN |= flags;
+  HOST_Sync();
+}
+
+void GPIO_IntDisable(uint32_t flags)
+{
+  GPIO->IEN &= ~flags;
+  HOST_Sync();
+}
+
+void GPIO_IntSet(uint32_t flags)
+{
+  GPIO->IF |= flags;
+  HOST_Sync();
+}
+
+void GPIO_EM4EnablePinWakeup(uint32_t pinmask, uint32_t polaritymask)
+{
+  (void)pinmask;
+  (void)polaritymask;
+  HOST_Unsupported("EM4 wake-up");
+}
@@ -0,0 +1,400 @@
+/***************************************************************************//**
+ * @file em_ldma.c
+ * @brief Host fake of the LDMA API.  Channels walk descriptor lists in host
+ * memory and move data when a transfer completes in simulated time.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "em_cmu.h"
+#include "em_ldma.h"
+#include "host.h"
+
+/*
+ * Cost of a transfer, in HCLK cycles: a descriptor fetch, then a read and
+ * a write per unit.  Channels are not arbitrated; each runs on its own.
+ */
+#ifndef HOST_LDMA_FETCH_CYCLES
+#define HOST_LDMA_FETCH_CYCLES  4
+#endif
+#ifndef HOST_LDMA_UNIT_CYCLES
+#define HOST_LDMA_UNIT_CYCLES   2
+#endif
+
+// Lowest address a descriptor may point at; below it is a bus error
+#define LOWEST_ADDRESS          0x1000UL
+
+typedef struct {
+  LDMA_Descriptor_t   desc;       ///< As loaded
+  uint32_t            descAddr;
+  uint32_t            reqSel;
+  uint32_t            remaining;  ///< Units left in the descriptor
+  uint32_t            units;      ///< Units of the block under way
+  bool                loaded;
+  bool                request;
+  HOST_Event_TypeDef  event;
+} Channel_TypeDef;
+
+LDMA_TypeDef HOST_LDMA;
+
+static Channel_TypeDef channels[DMA_CHAN_COUNT];
+static HOST_LdmaWatch_TypeDef watch;
+
+static const uint16_t blockUnits[16] = {
+  1, 2, 3, 4, 6, 8, 0, 16, 0, 32, 64, 128, 256, 512, 1024, 0
+};
+
+static void load(int ch, uint32_t addr);
+static void kick(int ch);
+
+static void error(int ch)
+{
+  LDMA->IF |= LDMA_IF_ERROR;
+  LDMA->CHEN &= ~(1UL << ch);
+  channels[ch].loaded = false;
+}
+
+static uint32_t incUnits(uint32_t inc)
+{
+  return (inc == ldmaCtrlSrcIncNone) ? 0 : (1UL << inc);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The channel has finished a descriptor: follow the loop or the link.
+ *   With decLoopCnt, the link is taken while the loop count is not zero,
+ *   whatever the link bit says; at zero, the channel goes on to the next
+ *   descriptor in memory if the link bit is set.
+ *****************************************************************************/
+static void next(int ch)
+{
+  Channel_TypeDef *c = &channels[ch];
+  uint32_t jump;
+
+  c->loaded = false;
+  if (c->desc.xfer.doneIfs) {
+    LDMA->IF |= 1UL << ch;
+  }
+  if (watch != NULL) {
+    watch(ch, c->descAddr, HOST_TimePs());
+  }
+  if (c->desc.xfer.decLoopCnt && (LDMA->CH[ch].LOOP != 0)) {
+    LDMA->CH[ch].LOOP--;
+  } else if (c->desc.xfer.decLoopCnt && c->desc.xfer.link) {
+    load(ch, c->descAddr + sizeof(LDMA_Descriptor_t));
+    return;
+  } else if (!c->desc.xfer.link) {
+    LDMA->CHEN &= ~(1UL << ch);
+    LDMA->CHDONE |= 1UL << ch;
+    return;
+  }
+  jump = (uint32_t)c->desc.xfer.linkAddr << 2;
+  if (c->desc.xfer.linkMode == ldmaLinkModeRel) {
+    load(ch, c->descAddr + jump);
+  } else {
+    load(ch, jump);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Fetch a descriptor into the channel.  Write descriptors complete on
+ *   the spot; transfer descriptors wait for a request unless structReq.
+ *****************************************************************************/
+static void load(int ch, uint32_t addr)
+{
+  Channel_TypeDef *c = &channels[ch];
+  LDMA_CH_TypeDef *regs = &LDMA->CH[ch];
+
+  if (addr < LOWEST_ADDRESS) {
+    error(ch);
+    return;
+  }
+  memcpy(&c->desc, HOST_Ptr(addr), sizeof(c->desc));
+  c->descAddr = addr;
+  switch (c->desc.xfer.structType) {
+    case ldmaCtrlStructTypeWrite:
+      if (c->desc.wri.dstAddr < LOWEST_ADDRESS) {
+        error(ch);
+        return;
+      }
+      *(volatile uint32_t *)HOST_Ptr(c->desc.wri.dstAddr) = c->desc.wri.immVal;
+      next(ch);
+      return;
+    case ldmaCtrlStructTypeXfer:
+      break;
+    default:
+      HOST_Unsupported("LDMA sync descriptors");
+  }
+  memcpy((void *)&regs->CTRL, &c->desc, sizeof(uint32_t));
+  regs->SRC = c->desc.xfer.srcAddrMode ? regs->SRC + c->desc.xfer.srcAddr
+              : c->desc.xfer.srcAddr;
+  regs->DST = c->desc.xfer.dstAddrMode ? regs->DST + c->desc.xfer.dstAddr
+              : c->desc.xfer.dstAddr;
+  memcpy((void *)&regs->LINK, (const uint32_t *)&c->desc + 3,
+         sizeof(uint32_t));
+  c->remaining = c->desc.xfer.xferCnt + 1;
+  c->loaded = true;
+  if (c->desc.xfer.structReq) {
+    c->request = true;
+  }
+  kick(ch);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   End of a block: move the data, then wait for the next request or
+ *   move to the next descriptor.
+ *****************************************************************************/
+static void blockDone(void *ctx)
+{
+  int ch = (int)(intptr_t)ctx;
+  Channel_TypeDef *c = &channels[ch];
+  LDMA_CH_TypeDef *regs = &LDMA->CH[ch];
+  uint32_t size = 1UL << c->desc.xfer.size;
+  uint32_t srcStep = incUnits(c->desc.xfer.srcInc) * size;
+  uint32_t dstStep = incUnits(c->desc.xfer.dstInc) * size;
+  uint32_t i, value = 0;
+
+  if ((regs->SRC < LOWEST_ADDRESS) || (regs->DST < LOWEST_ADDRESS)) {
+    error(ch);
+    return;
+  }
+  for (i = 0; i < c->units; i++) {
+    memcpy(&value, HOST_Ptr(regs->SRC), size);
+    memcpy(HOST_Ptr(regs->DST), &value, size);
+    regs->SRC += srcStep;
+    regs->DST += dstStep;
+  }
+  c->remaining -= c->units;
+  c->units = 0;
+  LDMA->CHBUSY &= ~(1UL << ch);
+  if (c->remaining == 0) {
+    next(ch);
+  } else {
+    kick(ch);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the next block if the channel has a request and is idle.
+ *****************************************************************************/
+static void kick(int ch)
+{
+  Channel_TypeDef *c = &channels[ch];
+  uint32_t units;
+
+  if (!(LDMA->CHEN & (1UL << ch)) || !c->loaded || !c->request
+      || (c->units != 0)) {
+    return;
+  }
+  c->request = false;
+  units = blockUnits[c->desc.xfer.blockSize];
+  if ((c->desc.xfer.reqMode == ldmaCtrlReqModeAll) || (units == 0)
+      || (units > c->remaining)) {
+    units = c->remaining;
+  }
+  c->units = units;
+  LDMA->CHBUSY |= 1UL << ch;
+  c->event.hfClock = true;
+  HOST_EventAt(&c->event, HOST_TimePs()
+               + HOST_CyclesPs(HOST_LDMA_FETCH_CYCLES
+                               + HOST_LDMA_UNIT_CYCLES * units,
+                               SystemCoreClock),
+               blockDone, (void *)(intptr_t)ch);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take SWREQ and the set and clear aliases.
+ *****************************************************************************/
+void HOST_LdmaSync(void)
+{
+  int ch;
+  uint32_t swreq = LDMA->SWREQ;
+
+  LDMA->IF = (LDMA->IF | LDMA->IF_SET) & ~LDMA->IF_CLR;
+  LDMA->IEN = (LDMA->IEN | LDMA->IEN_SET) & ~LDMA->IEN_CLR;
+  LDMA->IF_SET = LDMA->IF_CLR = LDMA->IEN_SET = LDMA->IEN_CLR = 0;
+  LDMA->SWREQ = 0;
+  for (ch = 0; swreq != 0; ch++, swreq >>= 1) {
+    if ((swreq & 1) && (LDMA->CHEN & (1UL << ch))) {
+      channels[ch].request = true;
+      kick(ch);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Request from a peripheral to the channels that select it.
+ *****************************************************************************/
+void HOST_LdmaRequest(uint32_t source, uint32_t signal)
+{
+  int ch;
+
+  for (ch = 0; ch < DMA_CHAN_COUNT; ch++) {
+    if ((LDMA->CHEN & (1UL << ch)) && !(LDMA->REQDIS & (1UL << ch))
+        && (channels[ch].reqSel == (source | signal))) {
+      channels[ch].request = true;
+      kick(ch);
+    }
+  }
+}
+
+void HOST_LdmaWatch(HOST_LdmaWatch_TypeDef fn)
+{
+  watch = fn;
+}
+
+/*******************************************************************************
+ *******************************   EMLIB API   *********************************
+ ******************************************************************************/
+
+void LDMA_Init(const LDMA_Init_t *init)
+{
+  CMU_ClockEnable(cmuClock_LDMA, true);
+  CMU_ClockEnable(cmuClock_LDMAXBAR, true);
+  LDMA->EN = 1;
+  LDMA->IEN = LDMA_IF_ERROR;
+  LDMA->IF = 0;
+  NVIC_SetPriority(LDMA_IRQn, init->ldmaInitIrqPriority);
+  NVIC_ClearPendingIRQ(LDMA_IRQn);
+  NVIC_EnableIRQ(LDMA_IRQn);
+}
+
+void LDMA_DeInit(void)
+{
+  int ch;
+
+  NVIC_DisableIRQ(LDMA_IRQn);
+  for (ch = 0; ch < DMA_CHAN_COUNT; ch++) {
+    LDMA_StopTransfer(ch);
+  }
+  LDMA->EN = 0;
+  CMU_ClockEnable(cmuClock_LDMA, false);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start a channel on a descriptor list.  As in emlib, the channel's done
+ *   interrupt is enabled.
+ *****************************************************************************/
+void LDMA_StartTransfer(int ch, const LDMA_TransferCfg_t *transfer,
+                        const LDMA_Descriptor_t *descriptor)
+{
+  Channel_TypeDef *c = &channels[ch];
+
+  HOST_ClockRequire(cmuClock_LDMA, "LDMA");
+  HOST_Sync();
+  if (transfer->ldmaCfgSrcIncSign || transfer->ldmaCfgDstIncSign) {
+    HOST_Unsupported("LDMA negative increments");
+  }
+  HOST_EventCancel(&c->event);
+  c->reqSel = transfer->ldmaReqSel;
+  c->request = false;
+  c->units = 0;
+  LDMA->CH[ch].LOOP = transfer->ldmaLoopCnt;
+  LDMA->IEN |= 1UL << ch;
+  LDMA->REQDIS = transfer->ldmaReqDis ? (LDMA->REQDIS | (1UL << ch))
+                 : (LDMA->REQDIS & ~(1UL << ch));
+  LDMA->CHDONE &= ~(1UL << ch);
+  LDMA->CHBUSY &= ~(1UL << ch);
+  LDMA->CHEN |= 1UL << ch;
+  load(ch, HOST_Addr((uintptr_t)descriptor));
+  HOST_Sync();
+}
+
+void LDMA_StopTransfer(int ch)
+{
+  HOST_EventCancel(&channels[ch].event);
+  channels[ch].loaded = false;
+  channels[ch].units = 0;
+  LDMA->IEN &= ~(1UL << ch);
+  LDMA->CHEN &= ~(1UL << ch);
+  LDMA->CHBUSY &= ~(1UL << ch);
+}
+
+bool LDMA_TransferDone(int ch)
+{
+  HOST_Poll();
+  return (LDMA->CHDONE & (1UL << ch)) != 0;
+}
+
+uint32_t LDMA_TransferRemainingCount(int ch)
+{
+  HOST_Poll();
+  return channels[ch].loaded ? channels[ch].remaining : 0;
+}
+
+void LDMA_EnableChannelRequest(int ch, bool enable)
+{
+  LDMA->REQDIS = enable ? (LDMA->REQDIS & ~(1UL << ch))
+                 : (LDMA->REQDIS | (1UL << ch));
+}
+
+uint32_t LDMA_IntGet(void)
+{
+  HOST_Poll();
+  return LDMA->IF;
+}
+
+uint32_t LDMA_IntGetEnabled(void)
+{
+  HOST_Poll();
+  return LDMA->IF & LDMA->IEN;
+}
+
+void LDMA_IntClear(uint32_t flags)
+{
+  LDMA->IF &= ~flags;
+  HOST_Sync();
+}
+
+void LDMA_IntEnable(uint32_t flags)
+{
+  LDMA->IEN |= flags;
+  HOST_Sync();
+}
+
+void LDMA_IntDisable(uint32_t flags)
+{
+  LDMA->IEN &= ~flags;
+  HOST_Sync();
+}
+
+void LDMA_IntSet(uint32_t flags)
+{
+  LDMA->IF |= flags;
+  HOST_Sync();
+}
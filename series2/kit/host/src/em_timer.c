@@ -0,0 +1,595 @@
+/***************************************************************************//**
+ * @file em_timer.c
+ * @brief Host fake of the TIMER API.  The counter is worked out from the
+ * simulated time, and events are scheduled only at the counts where
+ * something happens: overflows, underflows and compare matches.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "em_cmu.h"
+#include "em_gpio.h"
+#include "em_timer.h"
+#include "host.h"
+
+typedef struct {
+  HOST_Event_TypeDef    event;
+  bool                  reset;        ///< Reset values set
+  bool                  running;
+  bool                  busy;         ///< In advance()
+  TIMER_Mode_TypeDef    mode;
+  bool                  oneShot;
+  uint32_t              div;          ///< Prescaler division
+  uint32_t              hz;           ///< Clock before the prescaler
+  uint64_t              origin;       ///< Time of tick 0, ps
+  uint64_t              ticks;        ///< Ticks since origin counted in CNT
+
+  // Per channel
+  TIMER_InitCC_TypeDef  cc[3];
+  int                   out[3];
+  bool                  ocbValid[3];
+  bool                  topbValid;
+  unsigned int          edges[3];     ///< For every second edge captures
+
+  // Register values at the last sync, to see direct writes
+  uint32_t              top, oc[3], ocb[3], topb, cnt;
+} Timer_TypeDef;
+
+TIMER_TypeDef HOST_TIMER[TIMER_COUNT];
+
+static Timer_TypeDef timers[TIMER_COUNT];
+
+static const CMU_Clock_TypeDef clocks[TIMER_COUNT] = {
+  cmuClock_TIMER0, cmuClock_TIMER1, cmuClock_TIMER2, cmuClock_TIMER3,
+  cmuClock_TIMER4
+};
+
+// LDMA request sources of the timers
+static const uint32_t ldmaSources[TIMER_COUNT] = {
+  LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER0, LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER1,
+  LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER2, LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER3,
+  LDMAXBAR_CH_REQSEL_SOURCESEL_TIMER4
+};
+
+static void schedule(int n);
+
+static Timer_TypeDef *state(TIMER_TypeDef *timer)
+{
+  int n = TIMER_NUM(timer);
+  Timer_TypeDef *t = &timers[n];
+
+  HOST_ClockRequire(clocks[n], "TIMER");
+  if (!t->reset) {
+    t->reset = true;
+    t->div = 1;
+    timer->TOP = t->top = TIMER_MAX_COUNT(timer);
+  }
+  return t;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Level on the pin of a compare channel, if it is routed to one.
+ *****************************************************************************/
+static void drive(int n, unsigned int ch)
+{
+  GPIO_TIMERROUTE_TypeDef *route = &GPIO->TIMERROUTE[n];
+  uint32_t reg = (ch == 0) ? route->CC0ROUTE
+                 : (ch == 1) ? route->CC1ROUTE : route->CC2ROUTE;
+  Timer_TypeDef *t = &timers[n];
+
+  if (!(route->ROUTEEN & (GPIO_TIMER_ROUTEEN_CC0PEN << ch))) {
+    return;
+  }
+  HOST_GpioDrive((reg >> _GPIO_TIMER_CC0ROUTE_PORT_SHIFT) & 0x3,
+                 (reg >> _GPIO_TIMER_CC0ROUTE_PIN_SHIFT) & 0xF,
+                 t->out[ch] ^ t->cc[ch].outInvert);
+}
+
+static void action(int n, unsigned int ch, TIMER_OutputAction_TypeDef act)
+{
+  Timer_TypeDef *t = &timers[n];
+
+  switch (act) {
+    case timerOutputActionToggle:
+      t->out[ch] ^= 1;
+      break;
+    case timerOutputActionClear:
+      t->out[ch] = 0;
+      break;
+    case timerOutputActionSet:
+      t->out[ch] = 1;
+      break;
+    default:
+      return;
+  }
+  drive(n, ch);
+}
+
+static bool comparing(const Timer_TypeDef *t, unsigned int ch)
+{
+  return (t->cc[ch].mode == timerCCModeCompare)
+         || (t->cc[ch].mode == timerCCModePWM);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Wrap of the counter: buffered values load, outputs take their
+ *   overflow or underflow action.
+ *****************************************************************************/
+static void wrap(int n)
+{
+  TIMER_TypeDef *timer = &HOST_TIMER[n];
+  Timer_TypeDef *t = &timers[n];
+  bool up = (t->mode == timerModeUp);
+  unsigned int ch;
+
+  timer->IF |= up ? TIMER_IF_OF : TIMER_IF_UF;
+  if (t->topbValid) {
+    timer->TOP = t->top = timer->TOPB;
+    t->topbValid = false;
+  }
+  for (ch = 0; ch < 3; ch++) {
+    if (t->ocbValid[ch]) {
+      timer->CC[ch].OC = t->oc[ch] = timer->CC[ch].OCB;
+      t->ocbValid[ch] = false;
+    }
+    if (t->cc[ch].mode == timerCCModePWM) {
+      action(n, ch, timerOutputActionSet);
+    } else if (t->cc[ch].mode == timerCCModeCompare) {
+      action(n, ch, up ? t->cc[ch].cofoa : t->cc[ch].cufoa);
+    }
+  }
+  HOST_LdmaRequest(ldmaSources[n], 3);
+  if (t->oneShot) {
+    t->running = false;
+    timer->STATUS &= ~TIMER_STATUS_RUNNING;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Ticks from the current count to the next count where something
+ *   happens: the wrap, or a compare match.
+ *****************************************************************************/
+static uint64_t distance(int n)
+{
+  TIMER_TypeDef *timer = &HOST_TIMER[n];
+  Timer_TypeDef *t = &timers[n];
+  uint32_t c = timer->CNT, top = timer->TOP, oc;
+  uint64_t d;
+  unsigned int ch;
+
+  if (t->mode == timerModeUp) {
+    // Past TOP, the counter runs on to its maximum before it wraps
+    d = (c <= top) ? (uint64_t)top - c + 1
+        : (uint64_t)TIMER_MAX_COUNT(timer) - c + 1;
+  } else {
+    d = (uint64_t)c + 1;
+  }
+  for (ch = 0; ch < 3; ch++) {
+    oc = timer->CC[ch].OC;
+    if (!comparing(t, ch)) {
+      continue;
+    }
+    if ((t->mode == timerModeUp) && (oc > c) && (oc - c < d)) {
+      d = oc - c;
+    } else if ((t->mode == timerModeDown) && (oc < c) && (c - oc < d)) {
+      d = c - oc;
+    }
+  }
+  return d;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count the ticks up to now, stopping at each count where something
+ *   happens to raise flags, change outputs and load buffers.
+ *****************************************************************************/
+static void advance(int n)
+{
+  TIMER_TypeDef *timer = &HOST_TIMER[n];
+  Timer_TypeDef *t = &timers[n];
+  uint64_t target, d, step, last;
+  unsigned int ch;
+
+  if (!t->running || t->busy) {
+    return;
+  }
+  t->busy = true;
+  target = (uint64_t)(((unsigned __int128)(HOST_TimePs() - t->origin)
+                       * t->hz) / ((unsigned __int128)HOST_PS_PER_S * t->div));
+  while (t->running && (t->ticks < target)) {
+    d = distance(n);
+    step = (target - t->ticks < d) ? target - t->ticks : d;
+    t->ticks += step;
+    if (step < d) {
+      timer->CNT = (t->mode == timerModeUp) ? timer->CNT + (uint32_t)step
+                   : timer->CNT - (uint32_t)step;
+      break;
+    }
+    last = (timer->CNT <= timer->TOP) ? timer->TOP : TIMER_MAX_COUNT(timer);
+    if ((t->mode == timerModeUp) && ((uint64_t)timer->CNT + step - 1 == last)) {
+      timer->CNT = 0;
+      wrap(n);
+    } else if ((t->mode == timerModeDown)
+               && ((uint64_t)timer->CNT + 1 == step)) {
+      timer->CNT = timer->TOP;
+      wrap(n);
+    } else {
+      timer->CNT = (t->mode == timerModeUp) ? timer->CNT + (uint32_t)step
+                   : timer->CNT - (uint32_t)step;
+    }
+    for (ch = 0; ch < 3; ch++) {
+      if (comparing(t, ch) && (timer->CNT == timer->CC[ch].OC)) {
+        timer->IF |= TIMER_IF_CC0 << ch;
+        action(n, ch, (t->cc[ch].mode == timerCCModePWM)
+               ? timerOutputActionClear : t->cc[ch].cmoa);
+        HOST_LdmaRequest(ldmaSources[n], ch);
+      }
+    }
+  }
+  t->cnt = timer->CNT;
+  t->busy = false;
+}
+
+static void fire(void *ctx)
+{
+  int n = (int)(intptr_t)ctx;
+
+  advance(n);
+  schedule(n);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Set the event for the next count where something happens.
+ *****************************************************************************/
+static void schedule(int n)
+{
+  Timer_TypeDef *t = &timers[n];
+  uint64_t tick;
+
+  if (!t->running) {
+    HOST_EventCancel(&t->event);
+    return;
+  }
+  tick = t->ticks + distance(n);
+  t->event.hfClock = true;
+  HOST_EventAt(&t->event, t->origin + HOST_CyclesPs(tick * t->div, t->hz),
+               fire, (void *)(intptr_t)n);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Restart the tick count from now, for a new clock rate or a start.
+ *****************************************************************************/
+static void rebase(int n)
+{
+  Timer_TypeDef *t = &timers[n];
+
+  t->hz = CMU_ClockFreqGet(clocks[n]);
+  t->origin = HOST_TimePs();
+  t->ticks = 0;
+}
+
+static void start(int n, bool run)
+{
+  TIMER_TypeDef *timer = &HOST_TIMER[n];
+  Timer_TypeDef *t = &timers[n];
+
+  advance(n);
+  if (run && !t->running) {
+    rebase(n);
+  }
+  t->running = run;
+  timer->STATUS = run ? (timer->STATUS | TIMER_STATUS_RUNNING)
+                  : (timer->STATUS & ~TIMER_STATUS_RUNNING);
+  schedule(n);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take the set and clear aliases, CMD and direct writes to the counter,
+ *   top and compare registers.
+ *****************************************************************************/
+void HOST_TimerSync(void)
+{
+  TIMER_TypeDef *timer;
+  Timer_TypeDef *t;
+  unsigned int ch;
+  int n;
+  bool changed;
+
+  for (n = 0; n < TIMER_COUNT; n++) {
+    timer = &HOST_TIMER[n];
+    t = &timers[n];
+    timer->IF = (timer->IF | timer->IF_SET) & ~timer->IF_CLR;
+    timer->IEN = (timer->IEN | timer->IEN_SET) & ~timer->IEN_CLR;
+    timer->IF_SET = timer->IF_CLR = timer->IEN_SET = timer->IEN_CLR = 0;
+    if (!t->reset) {
+      continue;
+    }
+    if (timer->CMD & (TIMER_CMD_START | TIMER_CMD_STOP)) {
+      start(n, (timer->CMD & TIMER_CMD_START) != 0);
+      timer->CMD = 0;
+    }
+    changed = (timer->TOP != t->top) || (timer->CNT != t->cnt);
+    if (timer->TOPB != t->topb) {
+      t->topbValid = true;
+      t->topb = timer->TOPB;
+    }
+    for (ch = 0; ch < 3; ch++) {
+      changed |= timer->CC[ch].OC != t->oc[ch];
+      if (timer->CC[ch].OCB != t->ocb[ch]) {
+        t->ocbValid[ch] = true;
+        t->ocb[ch] = timer->CC[ch].OCB;
+      }
+      t->oc[ch] = timer->CC[ch].OC;
+    }
+    t->top = timer->TOP;
+    t->cnt = timer->CNT;
+    if (changed) {
+      schedule(n);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The clock of the timers changed: count at the old rate up to now, then
+ *   at the new one.
+ *****************************************************************************/
+void HOST_ClockChanged(void)
+{
+  int n;
+
+  for (n = 0; n < TIMER_COUNT; n++) {
+    if (timers[n].running) {
+      advance(n);
+      rebase(n);
+      schedule(n);
+    }
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Pin edge, for channels that capture from the pin routed to them.
+ *****************************************************************************/
+void HOST_TimerPin(unsigned int port, unsigned int pin, int level)
+{
+  TIMER_TypeDef *timer;
+  Timer_TypeDef *t;
+  TIMER_InitCC_TypeDef *cc;
+  uint32_t route;
+  unsigned int ch;
+  int n;
+
+  for (n = 0; n < TIMER_COUNT; n++) {
+    timer = &HOST_TIMER[n];
+    t = &timers[n];
+    for (ch = 0; ch < 3; ch++) {
+      cc = &t->cc[ch];
+      route = (ch == 0) ? GPIO->TIMERROUTE[n].CC0ROUTE
+              : (ch == 1) ? GPIO->TIMERROUTE[n].CC1ROUTE
+              : GPIO->TIMERROUTE[n].CC2ROUTE;
+      if ((cc->mode != timerCCModeCapture) || !t->running
+          || (((route >> _GPIO_TIMER_CC0ROUTE_PORT_SHIFT) & 0x3) != port)
+          || (((route >> _GPIO_TIMER_CC0ROUTE_PIN_SHIFT) & 0xF) != pin)
+          || ((cc->edge == timerEdgeRising) && !level)
+          || ((cc->edge == timerEdgeFalling) && level)
+          || (cc->edge == timerEdgeNone)
+          || ((cc->eventCtrl == timerEventEvery2ndEdge)
+              && ((++t->edges[ch] & 1) != 0))) {
+        continue;
+      }
+      advance(n);
+      *(volatile uint32_t *)&timer->CC[ch].ICOF = timer->CC[ch].ICF;
+      *(volatile uint32_t *)&timer->CC[ch].ICF = timer->CNT;
+      timer->IF |= TIMER_IF_CC0 << ch;
+      HOST_LdmaRequest(ldmaSources[n], ch);
+    }
+  }
+}
+
+/*******************************************************************************
+ *******************************   EMLIB API   *********************************
+ ******************************************************************************/
+
+void TIMER_Init(TIMER_TypeDef *timer, const TIMER_Init_TypeDef *init)
+{
+  Timer_TypeDef *t = state(timer);
+  int n = TIMER_NUM(timer);
+
+  if ((init->mode == timerModeUpDown) || (init->mode == timerModeQDec)) {
+    HOST_Unsupported("TIMER up/down and quadrature modes");
+  }
+  if (init->clkSel != timerClkSelHFPerClk) {
+    HOST_Unsupported("TIMER clock from CC1 or cascade");
+  }
+  start(n, false);
+  t->mode = init->mode;
+  t->oneShot = init->oneShot;
+  t->div = (uint32_t)init->prescale + 1;
+  timer->EN = TIMER_EN_EN;
+  timer->CNT = t->cnt = 0;
+  timer->IF = 0;
+  start(n, init->enable);
+}
+
+void TIMER_InitCC(TIMER_TypeDef *timer, unsigned int ch,
+                  const TIMER_InitCC_TypeDef *init)
+{
+  Timer_TypeDef *t = state(timer);
+  int n = TIMER_NUM(timer);
+
+  if (init->prsInput) {
+    HOST_Unsupported("TIMER PRS inputs");
+  }
+  if ((init->mode == timerCCModePWM) && (t->mode != timerModeUp)) {
+    HOST_Unsupported("TIMER PWM other than counting up");
+  }
+  advance(n);
+  t->cc[ch] = *init;
+  t->out[ch] = init->coist;
+  t->edges[ch] = 0;
+  if (comparing(t, ch)) {
+    drive(n, ch);
+  }
+  schedule(n);
+}
+
+void TIMER_Reset(TIMER_TypeDef *timer)
+{
+  int n = TIMER_NUM(timer);
+
+  HOST_EventCancel(&timers[n].event);
+  timers[n] = (Timer_TypeDef){ 0 };
+  memset((void *)timer, 0, sizeof(*timer));
+}
+
+void TIMER_Enable(TIMER_TypeDef *timer, bool enable)
+{
+  state(timer);
+  start(TIMER_NUM(timer), enable);
+}
+
+uint32_t TIMER_CounterGet(TIMER_TypeDef *timer)
+{
+  state(timer);
+  HOST_Poll();
+  advance(TIMER_NUM(timer));
+  return timer->CNT;
+}
+
+void TIMER_CounterSet(TIMER_TypeDef *timer, uint32_t val)
+{
+  Timer_TypeDef *t = state(timer);
+  int n = TIMER_NUM(timer);
+
+  advance(n);
+  timer->CNT = t->cnt = val;
+  schedule(n);
+}
+
+uint32_t TIMER_TopGet(TIMER_TypeDef *timer)
+{
+  state(timer);
+  return timer->TOP;
+}
+
+void TIMER_TopSet(TIMER_TypeDef *timer, uint32_t val)
+{
+  Timer_TypeDef *t = state(timer);
+  int n = TIMER_NUM(timer);
+
+  advance(n);
+  timer->TOP = t->top = val;
+  schedule(n);
+}
+
+void TIMER_TopBufSet(TIMER_TypeDef *timer, uint32_t val)
+{
+  Timer_TypeDef *t = state(timer);
+
+  timer->TOPB = t->topb = val;
+  t->topbValid = true;
+}
+
+void TIMER_CompareSet(TIMER_TypeDef *timer, unsigned int ch, uint32_t val)
+{
+  Timer_TypeDef *t = state(timer);
+  int n = TIMER_NUM(timer);
+
+  advance(n);
+  timer->CC[ch].OC = t->oc[ch] = val;
+  schedule(n);
+}
+
+void TIMER_CompareBufSet(TIMER_TypeDef *timer, unsigned int ch, uint32_t val)
+{
+  Timer_TypeDef *t = state(timer);
+
+  timer->CC[ch].OCB = t->ocb[ch] = val;
+  t->ocbValid[ch] = true;
+}
+
+uint32_t TIMER_CaptureGet(TIMER_TypeDef *timer, unsigned int ch)
+{
+  state(timer);
+  HOST_Poll();
+  return timer->CC[ch].ICF;
+}
+
+uint32_t TIMER_CaptureBufGet(TIMER_TypeDef *timer, unsigned int ch)
+{
+  state(timer);
+  HOST_Poll();
+  return timer->CC[ch].ICOF;
+}
+
+uint32_t TIMER_IntGet(TIMER_TypeDef *timer)
+{
+  HOST_Poll();
+  return timer->IF;
+}
+
+uint32_t TIMER_IntGetEnabled(TIMER_TypeDef *timer)
+{
+  HOST_Poll();
+  return timer->IF & timer->IEN;
+}
+
+void TIMER_IntClear(TIMER_TypeDef *timer, uint32_t flags)
+{
+  timer->IF &= ~flags;
+  HOST_Sync();
+}
+
+void TIMER_IntEnable(TIMER_TypeDef *timer, uint32_t flags)
+{
+  timer->IEN |= flags;
+  HOST_Sync();
+}
+
+void TIMER_IntDisable(TIMER_TypeDef *timer, uint32_t flags)
+{
+  timer->IEN &= ~flags;
+  HOST_Sync();
+}
+
+void TIMER_IntSet(TIMER_TypeDef *timer, uint32_t flags)
+{
+  timer->IF |= flags;
+  HOST_Sync();
+}
@@ -0,0 +1,615 @@
+/***************************************************************************//**
+ * @file host.c
+ * @brief Simulated time line, NVIC and core of the host fake emlib.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "host.h"
+
+/*
+ * Interrupt handlers of the example, if it defines them.  A handler that
+ * is missing stays a null weak reference, like a vector left at the
+ * default handler.
+ */
+#define HOST_IRQ_LIST(X)                                                      \
+  X(SMU_SECURE) X(EMU) X(TIMER0) X(TIMER1) X(TIMER2) X(TIMER3) X(TIMER4)      \
+  X(USART0_RX) X(USART0_TX) X(EUSART0_RX) X(EUSART0_TX) X(EUSART1_RX)         \
+  X(EUSART1_TX) X(ICACHE0) X(BURTC) X(LETIMER0) X(SYSCFG) X(MPAHBRAM) X(LDMA) \
+  X(LFXO) X(LFRCO) X(ULFRCO) X(GPIO_ODD) X(GPIO_EVEN) X(I2C0) X(I2C1)         \
+  X(EMUDG) X(HFXO0) X(HFRCO0) X(HFRCOEM23) X(CMU) X(IADC) X(MSC) X(DPLL0)     \
+  X(EMUEFP) X(DCDC) X(VDAC0) X(PCNT0) X(SW0) X(SW1) X(SW2) X(SW3) X(KERNEL0)  \
+  X(KERNEL1) X(M33CTI0) X(M33CTI1) X(FPUEXH) X(SETAMPERHOST) X(SEMBRX)        \
+  X(SEMBTX) X(SYSRTC_APP) X(SYSRTC_SEQ) X(KEYSCAN) X(RFECA0) X(RFECA1)        \
+  X(VDAC1) X(AHB2AHB0) X(AHB2AHB1)
+
+#define HOST_IRQ_DECLARE(name) \
+  void name##_IRQHandler(void) __attribute__((weak));
+#define HOST_IRQ_HANDLER(name)  [name##_IRQn] = name##_IRQHandler,
+#define HOST_IRQ_NAME(name)     [name##_IRQn] = #name,
+
+HOST_IRQ_LIST(HOST_IRQ_DECLARE)
+void SysTick_Handler(void) __attribute__((weak));
+
+// Index of SysTick in the tables, after the external interrupts
+#define SYSTICK_INDEX   EXT_IRQ_COUNT
+#define IRQ_SLOTS       (EXT_IRQ_COUNT + 1)
+
+static void (*const handlers[IRQ_SLOTS])(void) = {
+  HOST_IRQ_LIST(HOST_IRQ_HANDLER)
+};
+static const char *const irqNames[IRQ_SLOTS] = {
+  HOST_IRQ_LIST(HOST_IRQ_NAME)
+  [SYSTICK_INDEX] = "SysTick",
+};
+
+uint32_t SystemCoreClock = 19000000UL;
+
+// Time line
+static uint64_t now, limit = HOST_MS(HOST_DEFAULT_LIMIT_MS);
+static int em;
+static uint64_t emTime[5];
+static HOST_Event_TypeDef *queue;
+static uint32_t em2Violations;
+
+// NVIC
+static bool enabled[IRQ_SLOTS], pending[IRQ_SLOTS];
+static uint8_t priority[IRQ_SLOTS];
+static uint32_t irqCount[IRQ_SLOTS];
+static uint32_t primask;
+static int active = -1;
+static uint64_t stormTime;
+static uint32_t stormRuns;
+static bool syncing, finishing;
+
+// SysTick
+static HOST_Event_TypeDef sysTick;
+static uint32_t sysTickReload;
+
+static int slot(IRQn_Type irq)
+{
+  int i = (irq == SysTick_IRQn) ? SYSTICK_INDEX : (int)irq;
+
+  if ((i < 0) || (i >= IRQ_SLOTS)) {
+    HOST_Unsupported("interrupt number out of range");
+  }
+  return i;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Level of a peripheral interrupt line, from its flags and enables.
+ *****************************************************************************/
+static bool irqLine(int i)
+{
+  switch (i) {
+    case GPIO_EVEN_IRQn:
+      return (GPIO->IF & GPIO->IEN & 0x55555555UL) != 0;
+    case GPIO_ODD_IRQn:
+      return (GPIO->IF & GPIO->IEN & 0xAAAAAAAAUL) != 0;
+    case LDMA_IRQn:
+      return (LDMA->IF & LDMA->IEN) != 0;
+    case TIMER0_IRQn:
+    case TIMER1_IRQn:
+    case TIMER2_IRQn:
+    case TIMER3_IRQn:
+    case TIMER4_IRQn:
+      return (HOST_TIMER[i - TIMER0_IRQn].IF
+              & HOST_TIMER[i - TIMER0_IRQn].IEN) != 0;
+    default:
+      return false;
+  }
+}
+
+static bool isPending(int i)
+{
+  return pending[i] || irqLine(i);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The enabled interrupt to take next, or -1.  Lower priority values
+ *   win, then lower numbers; SysTick goes first at equal priority.
+ *****************************************************************************/
+static int nextIrq(void)
+{
+  int best = -1, i;
+
+  if (enabled[SYSTICK_INDEX] && pending[SYSTICK_INDEX]) {
+    best = SYSTICK_INDEX;
+  }
+  for (i = 0; i < EXT_IRQ_COUNT; i++) {
+    if (enabled[i] && isPending(i)
+        && ((best < 0) || (priority[i] < priority[best]))) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run the handlers of pending interrupts, unless masked or already in
+ *   a handler; handlers do not nest.
+ *****************************************************************************/
+static void dispatch(void)
+{
+  int i;
+
+  while ((primask == 0) && (active < 0) && ((i = nextIrq()) >= 0)) {
+    if (handlers[i] == NULL && i != SYSTICK_INDEX) {
+      fprintf(stderr, "host: %s interrupt has no handler\n", irqNames[i]);
+      HOST_Finish("default handler", 2);
+    }
+    if (stormTime == now) {
+      if (++stormRuns > HOST_STORM_LIMIT) {
+        fprintf(stderr, "host: %s handler does not clear its flags\n",
+                irqNames[i]);
+        HOST_Finish("interrupt storm", 2);
+      }
+    } else {
+      stormTime = now;
+      stormRuns = 0;
+    }
+    pending[i] = false;
+    irqCount[i]++;
+    active = i;
+    if (i == SYSTICK_INDEX) {
+      if (SysTick_Handler != NULL) {
+        SysTick_Handler();
+      }
+    } else {
+      handlers[i]();
+    }
+    active = -1;
+    syncing = true;
+    HOST_GpioSync();
+    HOST_LdmaSync();
+    HOST_TimerSync();
+    syncing = false;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take the register writes made since the last call and run the
+ *   interrupts they raise.  Every fake emlib function calls it.
+ *****************************************************************************/
+void HOST_Sync(void)
+{
+  if (syncing) {
+    return;
+  }
+  syncing = true;
+  HOST_GpioSync();
+  HOST_LdmaSync();
+  HOST_TimerSync();
+  syncing = false;
+  dispatch();
+}
+
+/*******************************************************************************
+ *******************************   TIME LINE   *********************************
+ ******************************************************************************/
+
+uint64_t HOST_TimePs(void)
+{
+  return now;
+}
+
+uint64_t HOST_CyclesPs(uint64_t cycles, uint32_t hz)
+{
+  return (uint64_t)(((unsigned __int128)cycles * HOST_PS_PER_S + hz - 1) / hz);
+}
+
+void HOST_EventCancel(HOST_Event_TypeDef *event)
+{
+  HOST_Event_TypeDef **p;
+
+  if (!event->queued) {
+    return;
+  }
+  for (p = &queue; *p != event; p = &(*p)->next) {
+  }
+  *p = event->next;
+  event->queued = false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Schedule an event, or move it if already scheduled.  Events at the
+ *   same time run in the order they were scheduled.
+ *
+ * @param[in] event
+ *   Caller-owned event; hfClock should be set by models whose clock stops
+ *   in EM2, so that runs in EM2 are reported.
+ *
+ * @param[in] time
+ *   Absolute time in ps; times in the past run at the current time.
+ *****************************************************************************/
+void HOST_EventAt(HOST_Event_TypeDef *event, uint64_t time,
+                  HOST_EventFn_TypeDef fn, void *ctx)
+{
+  HOST_Event_TypeDef **p;
+
+  HOST_EventCancel(event);
+  event->time = (time < now) ? now : time;
+  event->fn = fn;
+  event->ctx = ctx;
+  for (p = &queue; (*p != NULL) && ((*p)->time <= event->time);
+       p = &(*p)->next) {
+  }
+  event->next = *p;
+  *p = event;
+  event->queued = true;
+}
+
+static void advanceTo(uint64_t t)
+{
+  if (t >= limit) {
+    emTime[em] += limit - now;
+    now = limit;
+    HOST_Finish("time limit", 0);
+  }
+  emTime[em] += t - now;
+  now = t;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run the first event, at its time.
+ *****************************************************************************/
+static void runEvent(void)
+{
+  HOST_Event_TypeDef *event = queue;
+
+  advanceTo(event->time);
+  queue = event->next;
+  event->queued = false;
+  if ((em >= 2) && event->hfClock) {
+    em2Violations++;
+  }
+  event->fn(event->ctx);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Let the core run for a number of HCLK cycles in EM0.  Events on the
+ *   way run, and so do the interrupts they raise.
+ *****************************************************************************/
+void HOST_Busy(uint64_t cycles)
+{
+  uint64_t end = now + HOST_CyclesPs(cycles, SystemCoreClock);
+
+  HOST_Sync();
+  while ((queue != NULL) && (queue->time <= end)) {
+    runEvent();
+    HOST_Sync();
+  }
+  advanceTo(end);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   A register read in a polling loop: time passes, so the loop ends.
+ *****************************************************************************/
+void HOST_Poll(void)
+{
+  HOST_Busy(HOST_POLL_CYCLES);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Sleep in an energy mode until an enabled interrupt is pending, then
+ *   run it as WFI does.  With nothing left to wake the core, the
+ *   simulation ends.
+ *****************************************************************************/
+void HOST_Sleep(int mode)
+{
+  int i;
+  bool wake = false;
+
+  HOST_Sync();
+  em = mode;
+  while (!wake) {
+    for (i = 0; i < IRQ_SLOTS; i++) {
+      if (enabled[i] && isPending(i)) {
+        wake = true;
+      }
+    }
+    if (!wake) {
+      if (queue == NULL) {
+        HOST_Finish("idle", 0);
+      }
+      runEvent();
+      syncing = true;
+      HOST_GpioSync();
+      HOST_LdmaSync();
+      HOST_TimerSync();
+      syncing = false;
+    }
+  }
+  em = 0;
+  dispatch();
+}
+
+void HOST_SetLimit(uint64_t ps)
+{
+  limit = ps;
+}
+
+/*******************************************************************************
+ *************************   END OF THE SIMULATION   ***************************
+ ******************************************************************************/
+
+__attribute__((weak)) void HOST_Setup(void)
+{
+}
+
+__attribute__((weak)) int HOST_Teardown(void)
+{
+  return 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Print the time in each energy mode and the interrupts taken, then
+ *   exit with the status of the scenario's HOST_Teardown(), or with
+ *   the given status if non-zero.
+ *****************************************************************************/
+void HOST_Finish(const char *reason, int status)
+{
+  int i, teardown;
+
+  if (finishing) {
+    return;
+  }
+  finishing = true;
+  fflush(stdout);
+  printf("\nhost: %s at %.6f s\n", reason, (double)now / HOST_PS_PER_S);
+  printf("host: EM0 %.6f s, EM1 %.6f s, EM2 %.6f s, EM3 %.6f s\n",
+         (double)emTime[0] / HOST_PS_PER_S, (double)emTime[1] / HOST_PS_PER_S,
+         (double)emTime[2] / HOST_PS_PER_S, (double)emTime[3] / HOST_PS_PER_S);
+  for (i = 0; i < IRQ_SLOTS; i++) {
+    if (irqCount[i] != 0) {
+      printf("host: %s interrupts %lu\n", irqNames[i],
+             (unsigned long)irqCount[i]);
+    }
+  }
+  if (em2Violations != 0) {
+    printf("host: %lu events of HF clocked peripherals ran in EM2 or EM3\n",
+           (unsigned long)em2Violations);
+  }
+  teardown = HOST_Teardown();
+  fflush(stdout);
+  exit((status != 0) ? status : teardown);
+}
+
+void HOST_Unsupported(const char *what)
+{
+  fprintf(stderr, "host: not modelled: %s\n", what);
+  HOST_Finish("unsupported", 2);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   32-bit bus address of host memory, for descriptors and registers that
+ *   hold addresses.  Needs a -no-pie build so that data sits low.  Small
+ *   negative numbers are offsets, and pass.
+ *****************************************************************************/
+uint32_t HOST_Addr(uintptr_t address)
+{
+  if ((address > 0xFFFFFFFFUL) && (address < (uintptr_t)INT32_MIN)) {
+    fprintf(stderr, "host: address 0x%lx is above 4 GB; build with -no-pie "
+            "and keep buffers out of the stack\n", (unsigned long)address);
+    exit(2);
+  }
+  return (uint32_t)address;
+}
+
+void *HOST_Ptr(uint32_t addr)
+{
+  return (void *)(uintptr_t)addr;
+}
+
+uint64_t HOST_TimeInEm(int mode)
+{
+  return emTime[mode];
+}
+
+uint32_t HOST_IrqCount(IRQn_Type irq)
+{
+  return irqCount[slot(irq)];
+}
+
+uint32_t HOST_Em2Violations(void)
+{
+  return em2Violations;
+}
+
+static void wallClock(int sig)
+{
+  (void)sig;
+  static const char msg[] = "\nhost: wall-clock limit; the code spins "
+                            "without calling the emlib\n";
+  (void)!write(2, msg, sizeof(msg) - 1);
+  _exit(3);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Reset: set the limits and run the scenario's HOST_Setup().  The
+ *   simulated time can be set with HOST_SIM_MS in the environment.
+ *****************************************************************************/
+void CHIP_Init(void)
+{
+  static bool done;
+  const char *ms = getenv("HOST_SIM_MS");
+
+  if (done) {
+    return;
+  }
+  done = true;
+  if (ms != NULL) {
+    limit = HOST_MS(strtoull(ms, NULL, 10));
+  }
+  signal(SIGALRM, wallClock);
+  alarm(HOST_WALL_SECONDS);
+  HOST_Setup();
+}
+
+/*******************************************************************************
+ *******************************   CMSIS CORE   ********************************
+ ******************************************************************************/
+
+uint32_t SystemCoreClockGet(void)
+{
+  return SystemCoreClock;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+  enabled[slot(irq)] = true;
+  HOST_Sync();
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+  enabled[slot(irq)] = false;
+}
+
+uint32_t NVIC_GetEnableIRQ(IRQn_Type irq)
+{
+  return enabled[slot(irq)];
+}
+
+void NVIC_SetPendingIRQ(IRQn_Type irq)
+{
+  pending[slot(irq)] = true;
+  HOST_Sync();
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type irq)
+{
+  // A line still high pends again, as on hardware
+  pending[slot(irq)] = false;
+}
+
+uint32_t NVIC_GetPendingIRQ(IRQn_Type irq)
+{
+  int i = slot(irq);
+
+  HOST_Sync();
+  return (i == SYSTICK_INDEX) ? pending[i] : isPending(i);
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t prio)
+{
+  priority[slot(irq)] = (uint8_t)prio;
+}
+
+uint32_t NVIC_GetPriority(IRQn_Type irq)
+{
+  return priority[slot(irq)];
+}
+
+static void sysTickFire(void *ctx)
+{
+  (void)ctx;
+  pending[SYSTICK_INDEX] = true;
+  HOST_EventAt(&sysTick, sysTick.time
+               + HOST_CyclesPs(sysTickReload, SystemCoreClock),
+               sysTickFire, NULL);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   SysTick on HCLK with its interrupt, as the CMSIS function sets it up.
+ *****************************************************************************/
+uint32_t SysTick_Config(uint32_t ticks)
+{
+  if ((ticks == 0) || (ticks > 0x1000000UL)) {
+    return 1;
+  }
+  sysTickReload = ticks;
+  sysTick.hfClock = true;
+  enabled[SYSTICK_INDEX] = true;
+  HOST_EventAt(&sysTick, now + HOST_CyclesPs(ticks, SystemCoreClock),
+               sysTickFire, NULL);
+  return 0;
+}
+
+void __disable_irq(void)
+{
+  primask = 1;
+}
+
+void __enable_irq(void)
+{
+  primask = 0;
+  HOST_Sync();
+}
+
+uint32_t __get_PRIMASK(void)
+{
+  return primask;
+}
+
+void __set_PRIMASK(uint32_t value)
+{
+  primask = value & 1;
+  HOST_Sync();
+}
+
+void __WFI(void)
+{
+  HOST_Sleep(1);
+}
+
+void __WFE(void)
+{
+  HOST_Sleep(1);
+}
+
+void __SEV(void)
+{
+}
+
+void __BKPT_host(void)
+{
+  HOST_Finish("breakpoint", 0);
+}
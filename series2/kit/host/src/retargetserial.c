@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ * @file retargetserial.c
+ * @brief Host version of the serial retarget driver: output goes to
+ * stdout, input comes from HOST_SerialInput().
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "retargetserial.h"
+#include "host.h"
+
+static const char *input;
+
+/**************************************************************************//**
+ * @brief
+ *   Text for RETARGET_ReadChar() to return, as if typed in the terminal.
+ *   The string must stay valid until it has been read.
+ *****************************************************************************/
+void HOST_SerialInput(const char *text)
+{
+  input = text;
+}
+
+void RETARGET_SerialInit(void)
+{
+}
+
+void RETARGET_SerialCrLf(int on)
+{
+  (void)on;
+}
+
+bool RETARGET_SerialEnableFlowControl(void)
+{
+  return false;
+}
+
+void RETARGET_RequireEm1(bool requireEm1)
+{
+  (void)requireEm1;
+}
+
+int RETARGET_ReadChar(void)
+{
+  HOST_Poll();
+  if ((input == NULL) || (*input == '\0')) {
+    return -1;
+  }
+  return (unsigned char)*input++;
+}
+
+int RETARGET_WriteChar(char c)
+{
+  return putchar(c);
+}
+
+void RETARGET_SerialFlush(void)
+{
+  fflush(stdout);
+}
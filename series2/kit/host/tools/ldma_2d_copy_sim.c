@@ -0,0 +1,100 @@
+/***************************************************************************//**
+ * @file ldma_2d_copy_sim.c
+ * @brief Runs the unchanged ldma_2d_copy example on the host fake emlib: a
+ * 3 x 4 block moves from row 1, column 0 to row 1, column 2, and nothing
+ * else in the destination changes.
+ *
+ *   gcc -std=c99 -O2 -no-pie -I../inc -o ldma_2d_copy_sim ldma_2d_copy_sim.c \
+ *       ../src/host.c ../src/em_*.c ../../../ldma/ldma_2d_copy/src/main.c
+ *   ./ldma_2d_copy_sim
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "host.h"
+
+#define WIDTH   10
+#define HEIGHT  8
+
+// The example's buffers
+extern uint16_t src2d[HEIGHT][WIDTH];
+extern uint16_t dst2d[HEIGHT][WIDTH];
+
+static int failures;
+static unsigned int descriptors;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void done(int ch, uint32_t descriptor, uint64_t time)
+{
+  (void)ch;
+  (void)descriptor;
+  (void)time;
+  descriptors++;
+}
+
+void HOST_Setup(void)
+{
+  HOST_LdmaWatch(done);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Compare the destination with the expected block, cell by cell.
+ *****************************************************************************/
+int HOST_Teardown(void)
+{
+  unsigned int row, col, wrong = 0;
+  uint16_t expect;
+
+  for (row = 0; row < HEIGHT; row++) {
+    for (col = 0; col < WIDTH; col++) {
+      expect = ((row >= 1) && (row <= 4) && (col >= 2) && (col <= 4))
+               ? src2d[row][col - 2] : 0;
+      if (dst2d[row][col] != expect) {
+        wrong++;
+      }
+    }
+  }
+  printf("descriptors run %u, cells wrong %u\n", descriptors, wrong);
+  check(wrong == 0, "block copied and nothing else written");
+  check(descriptors == 4, "one descriptor, then three rows through the loop");
+  check(HOST_IrqCount(LDMA_IRQn) == 0, "no done interrupts");
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/***************************************************************************//**
+ * @file ldma_linked_list_looped_sim.c
+ * @brief Runs the unchanged ldma_linked_list_looped example on the host fake
+ * emlib: A and B four times each through the loop count, then C.
+ *
+ *   gcc -std=c99 -O2 -no-pie -I../inc -I../../EFR32MG24_BRD4186C \
+ *       -I../../common/bsp -I../../common/drivers \
+ *       -o ldma_linked_list_looped_sim ldma_linked_list_looped_sim.c \
+ *       ../src/host.c ../src/em_*.c \
+ *       ../src/retargetserial.c ../../../ldma/ldma_linked_list_looped/src/main.c
+ *   ./ldma_linked_list_looped_sim
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+
+// The example's buffers
+extern uint8_t dstBuffer[4];
+extern uint8_t srcC[4];
+
+static int failures;
+static char seen[16];
+static unsigned int transfers;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The letter in the destination after each descriptor.
+ *****************************************************************************/
+static void done(int ch, uint32_t descriptor, uint64_t time)
+{
+  (void)ch;
+  (void)descriptor;
+  (void)time;
+  if (transfers < sizeof(seen) - 1) {
+    seen[transfers++] = (char)dstBuffer[0];
+  }
+}
+
+void HOST_Setup(void)
+{
+  HOST_LdmaWatch(done);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The example sleeps in EM1 with nothing left to wake it: check the
+ *   sequence and the interrupts.
+ *****************************************************************************/
+int HOST_Teardown(void)
+{
+  printf("transfers %s\n", seen);
+  check(strcmp(seen, "ABABABABC") == 0, "A and B four times, then C");
+  check(memcmp(dstBuffer, srcC, 4) == 0, "destination ends with C");
+  check(HOST_IrqCount(LDMA_IRQn) == 9, "one interrupt per descriptor");
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * @file ldma_single_button_sim.c
+ * @brief Runs the unchanged ldma_single_button example on the host fake
+ * emlib, in its software request build: one block of 128 half words and one
+ * interrupt.
+ *
+ *   gcc -std=c99 -O2 -no-pie -I../inc -I../../EFR32MG24_BRD4186C \
+ *       -I../../common/bsp -o ldma_single_button_sim \
+ *       ldma_single_button_sim.c ../src/host.c ../src/em_*.c \
+ *       ../../../ldma/ldma_single_button/src/main.c
+ *   ./ldma_single_button_sim
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "host.h"
+
+#define BUFFER_SIZE 128
+
+// The example's buffers
+extern uint16_t srcBuffer[BUFFER_SIZE];
+extern uint16_t dstBuffer[BUFFER_SIZE];
+
+static int failures;
+static uint64_t finished;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void done(int ch, uint32_t descriptor, uint64_t time)
+{
+  (void)ch;
+  (void)descriptor;
+  finished = time;
+}
+
+void HOST_Setup(void)
+{
+  HOST_LdmaWatch(done);
+}
+
+int HOST_Teardown(void)
+{
+  printf("transfer done at %.3f us\n", (double)finished / HOST_US(1));
+  check(finished != 0, "transfer completed");
+  check(memcmp(srcBuffer, dstBuffer, sizeof(dstBuffer)) == 0,
+        "destination matches source");
+  check(HOST_IrqCount(LDMA_IRQn) == 1, "one done interrupt");
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
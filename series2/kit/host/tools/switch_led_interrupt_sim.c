@@ -0,0 +1,124 @@
+/***************************************************************************//**
+ * @file switch_led_interrupt_sim.c
+ * @brief Runs the unchanged switch_led_interrupt example on the host fake
+ * emlib.  The scenario presses PB0, PB1 and PB0 again; each press toggles
+ * its LED, and the device sleeps in EM3 in between.
+ *
+ *   gcc -std=c99 -O2 -no-pie -I../inc -I../../EFR32MG24_BRD4186C \
+ *       -I../../common/bsp -o switch_led_interrupt_sim \
+ *       switch_led_interrupt_sim.c ../src/host.c ../src/em_*.c \
+ *       ../../../gpio/switch_led_interrupt/src/main_switch_led_int_s2.c
+ *   ./switch_led_interrupt_sim
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_gpio.h"
+#include "bsp.h"
+#include "host.h"
+
+typedef struct {
+  uint64_t      time;
+  unsigned int  port;
+  unsigned int  pin;
+  int           level;
+} Press_TypeDef;
+
+// Buttons are active low; a press lasts 10 ms
+static const Press_TypeDef presses[] = {
+  { HOST_MS(10), BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, 0 },
+  { HOST_MS(20), BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, -1 },
+  { HOST_MS(30), BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, 0 },
+  { HOST_MS(40), BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, -1 },
+  { HOST_MS(50), BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, 0 },
+  { HOST_MS(60), BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, -1 },
+};
+#define PRESSES (sizeof(presses) / sizeof(presses[0]))
+
+static HOST_Event_TypeDef events[PRESSES];
+static int failures;
+static unsigned int led0Changes, led1Changes;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void press(void *ctx)
+{
+  const Press_TypeDef *p = ctx;
+
+  HOST_GpioInput(p->port, p->pin, p->level);
+}
+
+static void led(unsigned int port, unsigned int pin, int level, uint64_t time)
+{
+  (void)level;
+  // Count changes once the LEDs are set up, after the first 1 ms
+  if ((port != BSP_GPIO_LED0_PORT) || (time < HOST_MS(1))) {
+    return;
+  }
+  if (pin == BSP_GPIO_LED0_PIN) {
+    led0Changes++;
+  } else if (pin == BSP_GPIO_LED1_PIN) {
+    led1Changes++;
+  }
+}
+
+void HOST_Setup(void)
+{
+  unsigned int i;
+
+  HOST_GpioWatch(led);
+  for (i = 0; i < PRESSES; i++) {
+    HOST_EventAt(&events[i], presses[i].time, press, (void *)&presses[i]);
+  }
+}
+
+int HOST_Teardown(void)
+{
+  double total = (double)HOST_TimePs();
+
+  check(led0Changes == 2, "LED0 toggled by both PB0 presses");
+  check(led1Changes == 1, "LED1 toggled by the PB1 press");
+  check(HOST_GpioLevel(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN) == 1,
+        "LED0 back on");
+  check(HOST_GpioLevel(BSP_GPIO_LED1_PORT, BSP_GPIO_LED1_PIN) == 0,
+        "LED1 off");
+  check(HOST_IrqCount(GPIO_ODD_IRQn) == 3, "one interrupt per press");
+  check((double)HOST_TimeInEm(3) > 0.99 * total, "asleep in EM3");
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+/***************************************************************************//**
+ * @file timer_pwm_interrupt_sim.c
+ * @brief Runs the unchanged timer_pwm_interrupt example on the host fake
+ * emlib for 20 ms and measures the waveform on PA6: 1 kHz at 30 % duty,
+ * with one compare interrupt per period.
+ *
+ *   gcc -std=c99 -O2 -no-pie -I../inc -o timer_pwm_interrupt_sim \
+ *       timer_pwm_interrupt_sim.c ../src/host.c ../src/em_*.c \
+ *       ../../../timer/timer_pwm_interrupt/src/main.c
+ *   ./timer_pwm_interrupt_sim
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_gpio.h"
+#include "host.h"
+
+#define RUN_MS      20
+
+static int failures;
+static unsigned int rises;
+static uint64_t firstRise, lastRise, high, wholeHigh;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Time stamp the rising edges on PA6 and add up the time it is high,
+ *   up to the last whole period.
+ *****************************************************************************/
+static void pa6(unsigned int port, unsigned int pin, int level, uint64_t time)
+{
+  if ((port != gpioPortA) || (pin != 6)) {
+    return;
+  }
+  if (level) {
+    if (rises++ == 0) {
+      firstRise = time;
+    }
+    lastRise = time;
+    wholeHigh = high;
+  } else if (rises != 0) {
+    high += time - lastRise;
+  }
+}
+
+void HOST_Setup(void)
+{
+  HOST_SetLimit(HOST_MS(RUN_MS));
+  HOST_GpioWatch(pa6);
+}
+
+int HOST_Teardown(void)
+{
+  double period, duty;
+
+  if (rises < 2) {
+    printf("FAIL: no waveform on PA6\n");
+    return 1;
+  }
+  period = (double)(lastRise - firstRise) / (rises - 1);
+  duty = 100.0 * (double)wholeHigh / (double)(lastRise - firstRise);
+  printf("period %.3f us, duty %.2f %%, %u periods\n",
+         period / HOST_US(1), duty, rises - 1);
+  check((period > HOST_US(999)) && (period < HOST_US(1001)), "1 kHz");
+  check((duty > 29.5) && (duty < 30.5), "30 % duty");
+  check((HOST_IrqCount(TIMER0_IRQn) >= RUN_MS - 1)
+        && (HOST_IrqCount(TIMER0_IRQn) <= RUN_MS + 1),
+        "one compare interrupt per period");
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,522 @@
+/***************************************************************************//**
+ * @file blit.c
+ * @brief 2D LDMA blits: rectangle copy, transpose and fill between strided
+ * buffers, compiled into one descriptor chain per batch.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "blit.h"
+
+#if !defined(BLIT_HOST)
+#include "em_device.h"
+#include "em_ldma.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Start the chain on an LDMA channel.
+ *
+ * @details
+ *   LDMA_Init() must have been called. The descriptors run back to back
+ *   without CPU help; only the last raises the channel done interrupt,
+ *   which BLIT_IRQHandler() turns into the callback. The chain, its fill
+ *   values and the buffers must stay valid until then. A finished chain
+ *   may be started again to repeat the same blits.
+ *
+ * @param[in] callback
+ *   Called from the LDMA interrupt when the chain ends; may be NULL.
+ *****************************************************************************/
+BLIT_Status_TypeDef BLIT_Start(BLIT_Chain_TypeDef *chain,
+                               unsigned int channel,
+                               BLIT_Callback_TypeDef callback,
+                               void *user)
+{
+  static const LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_MEMORY();
+
+  if (chain->busy) {
+    return blitErrBusy;
+  }
+  if (chain->count == 0) {
+    return blitErrParam;
+  }
+
+  chain->channel = channel;
+  chain->callback = callback;
+  chain->user = user;
+  chain->busy = true;
+
+  LDMA_StartTransfer(channel, &cfg, &chain->desc[0]);
+
+  // LDMA_StartTransfer() takes the done interrupt from the first descriptor
+  LDMA_IntEnable(1 << channel);
+  return blitOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   LDMA interrupt handling for a chain; call from LDMA_IRQHandler().
+ *****************************************************************************/
+void BLIT_IRQHandler(BLIT_Chain_TypeDef *chain)
+{
+  uint32_t mask = 1 << chain->channel;
+  uint32_t flags = LDMA_IntGet();
+  bool error = (flags & LDMA_IF_ERROR) != 0;
+
+  if (!chain->busy || !(flags & (mask | LDMA_IF_ERROR))) {
+    return;
+  }
+  LDMA_IntClear(flags & (mask | LDMA_IF_ERROR));
+  if (error) {
+    LDMA_StopTransfer(chain->channel);
+  }
+  LDMA_IntDisable(mask);
+  chain->busy = false;
+  if (chain->callback) {
+    chain->callback(chain->user, error);
+  }
+}
+#endif // !BLIT_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Largest transfer unit, 4, 2 or 1 bytes, that divides every address
+ *   and length or'ed into bits.
+ *****************************************************************************/
+static uint8_t unitFor(uintptr_t bits)
+{
+  if ((bits & 3) == 0) {
+    return 4;
+  }
+  return (bits & 1) ? 1 : 2;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Append one descriptor that ends the chain.
+ *
+ * @param[in] srcInc
+ *   Units between source reads; 0 reads the same unit every time.
+ *****************************************************************************/
+static void append(BLIT_Chain_TypeDef *chain,
+                   const uint8_t *src,
+                   uint8_t *dst,
+                   uint16_t count,
+                   uint8_t unit,
+                   uint8_t srcInc,
+                   uint8_t dstInc)
+{
+  BLIT_Desc_TypeDef *d = &chain->desc[chain->count];
+
+#if defined(BLIT_HOST)
+  d->src = src;
+  d->dst = dst;
+  d->count = count;
+  d->unit = unit;
+  d->srcInc = srcInc;
+  d->dstInc = dstInc;
+  d->done = true;
+  if (chain->count > 0) {
+    d[-1].done = false;
+  }
+#else
+  static const uint8_t sizes[] = {
+    0, ldmaCtrlSizeByte, ldmaCtrlSizeHalf, 0, ldmaCtrlSizeWord
+  };
+  static const uint8_t srcIncs[] = {
+    ldmaCtrlSrcIncNone, ldmaCtrlSrcIncOne, ldmaCtrlSrcIncTwo, 0,
+    ldmaCtrlSrcIncFour
+  };
+  static const uint8_t dstIncs[] = {
+    0, ldmaCtrlDstIncOne, ldmaCtrlDstIncTwo, 0, ldmaCtrlDstIncFour
+  };
+
+  *d = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_LINKREL_M2M_BYTE((uint32_t)src,
+                                                           (uint32_t)dst,
+                                                           count,
+                                                           1);
+  d->xfer.size = sizes[unit];
+  d->xfer.srcInc = srcIncs[srcInc];
+  d->xfer.dstInc = dstIncs[dstInc];
+  d->xfer.link = 0;
+  if (chain->count > 0) {
+    // Only the last descriptor interrupts
+    d[-1].xfer.link = 1;
+    d[-1].xfer.doneIfs = 0;
+  }
+#endif
+
+  chain->count++;
+  chain->units += count;
+  chain->bytes += (uint32_t)count * unit;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Append a run of units, split into transfers the LDMA can count.
+ *
+ * @return
+ *   false if the chain is full.
+ *****************************************************************************/
+static bool emit(BLIT_Chain_TypeDef *chain,
+                 const uint8_t *src,
+                 uint8_t *dst,
+                 uint32_t units,
+                 uint8_t unit,
+                 uint8_t srcInc,
+                 uint8_t dstInc)
+{
+  uint32_t n;
+
+  while (units > 0) {
+    if (chain->count >= BLIT_MAX_STEPS) {
+      return false;
+    }
+    n = (units > BLIT_MAX_COUNT) ? BLIT_MAX_COUNT : units;
+    append(chain, src, dst, (uint16_t)n, unit, srcInc, dstInc);
+    src += n * srcInc * unit;
+    dst += n * dstInc * unit;
+    units -= n;
+  }
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Append a row-by-row copy or fill.
+ *
+ * @details
+ *   Rows that follow each other in both buffers are sent as one run. In
+ *   reverse, rows go from the last up, for a copy to an overlapping
+ *   destination further on in memory.
+ *
+ * @param[in] srcInc
+ *   1 to copy, 0 to fill from the unit at src.
+ *****************************************************************************/
+static bool addRows(BLIT_Chain_TypeDef *chain,
+                    const uint8_t *src,
+                    uint32_t srcStride,
+                    uint8_t *dst,
+                    uint32_t dstStride,
+                    uint16_t rows,
+                    uint32_t rowBytes,
+                    uint8_t unit,
+                    uint8_t srcInc,
+                    bool reverse)
+{
+  uint32_t r, row;
+
+  if (!reverse && (rows == 1 || dstStride == rowBytes)
+      && (srcInc == 0 || rows == 1 || srcStride == rowBytes)) {
+    return emit(chain, src, dst, rows * rowBytes / unit, unit, srcInc, 1);
+  }
+  for (r = 0; r < rows; r++) {
+    row = reverse ? rows - 1 - r : r;
+    if (!emit(chain, src + row * srcStride, dst + row * dstStride,
+              rowBytes / unit, unit, srcInc, 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Check that a w x h rectangle at x, y lies inside a surface.
+ *****************************************************************************/
+static BLIT_Status_TypeDef checkRect(const BLIT_Surface_TypeDef *s,
+                                     uint32_t x,
+                                     uint32_t y,
+                                     uint32_t w,
+                                     uint32_t h)
+{
+  if (s->base == NULL || s->elemSize == 0 || s->elemSize > 4
+      || s->stride < (uint32_t)s->width * s->elemSize || w == 0 || h == 0) {
+    return blitErrParam;
+  }
+  if (x + w > s->width || y + h > s->height) {
+    return blitErrRange;
+  }
+  return blitOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Address of element x in row y.
+ *****************************************************************************/
+static uint8_t *at(const BLIT_Surface_TypeDef *s, uint32_t x, uint32_t y)
+{
+  return (uint8_t *)s->base + y * s->stride + x * s->elemSize;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Undo a partly added operation.
+ *****************************************************************************/
+static BLIT_Status_TypeDef rollback(BLIT_Chain_TypeDef *chain,
+                                    uint16_t count,
+                                    uint32_t units,
+                                    uint32_t bytes)
+{
+  chain->count = count;
+  chain->units = units;
+  chain->bytes = bytes;
+#if defined(BLIT_HOST)
+  if (count > 0) {
+    chain->desc[count - 1].done = true;
+  }
+#else
+  if (count > 0) {
+    chain->desc[count - 1].xfer.link = 0;
+    chain->desc[count - 1].xfer.doneIfs = 1;
+  }
+#endif
+  return blitErrSteps;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Empty a chain.
+ *****************************************************************************/
+void BLIT_Init(BLIT_Chain_TypeDef *chain)
+{
+  memset(chain, 0, sizeof(*chain));
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add a rectangle copy to the chain.
+ *
+ * @details
+ *   Copies rect of src to dst with its top left element at dx, dy. Both
+ *   surfaces must have the same element size. Each row becomes one
+ *   descriptor, or one descriptor covers all rows when they are
+ *   contiguous in both buffers. Transfers are words when every row start,
+ *   row length and stride allows it, else halfwords or bytes.
+ *
+ *   Source and destination may overlap, for example to scroll a
+ *   framebuffer, if both have the same stride. The rows are then copied
+ *   in an order that reads every row before it is overwritten. A shift to
+ *   the right by less than the rectangle width, within the same rows,
+ *   cannot be done with forward transfers and is refused.
+ *
+ * @return
+ *   blitOk, or an error with the chain unchanged.
+ *****************************************************************************/
+BLIT_Status_TypeDef BLIT_Copy(BLIT_Chain_TypeDef *chain,
+                              const BLIT_Surface_TypeDef *dst,
+                              uint16_t dx,
+                              uint16_t dy,
+                              const BLIT_Surface_TypeDef *src,
+                              const BLIT_Rect_TypeDef *rect)
+{
+  BLIT_Status_TypeDef status;
+  uint32_t rowBytes = (uint32_t)rect->w * src->elemSize;
+  uint16_t count = chain->count;
+  uint32_t units = chain->units, bytes = chain->bytes;
+  uint8_t *s, *d, unit;
+  bool reverse = false;
+
+  if (chain->busy) {
+    return blitErrBusy;
+  }
+  if (src->elemSize != dst->elemSize) {
+    return blitErrParam;
+  }
+  status = checkRect(src, rect->x, rect->y, rect->w, rect->h);
+  if (status == blitOk) {
+    status = checkRect(dst, dx, dy, rect->w, rect->h);
+  }
+  if (status != blitOk) {
+    return status;
+  }
+
+  s = at(src, rect->x, rect->y);
+  d = at(dst, dx, dy);
+  if (d < s + (rect->h - 1) * src->stride + rowBytes
+      && s < d + (rect->h - 1) * dst->stride + rowBytes) {
+    if (src->stride != dst->stride || (d > s && d - s < rowBytes)) {
+      return blitErrOverlap;
+    }
+    reverse = d > s;
+  }
+
+  unit = unitFor((uintptr_t)s | (uintptr_t)d | rowBytes
+                 | (rect->h > 1 ? src->stride | dst->stride : 0));
+  if (!addRows(chain, s, src->stride, d, dst->stride, rect->h, rowBytes,
+               unit, 1, reverse)) {
+    return rollback(chain, count, units, bytes);
+  }
+  return blitOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add a transposed rectangle copy to the chain.
+ *
+ * @details
+ *   Row r, column c of rect goes to row dy + c, column dx + r of dst; the
+ *   destination is rect->h wide and rect->w high. The LDMA can only step
+ *   1, 2 or 4 units between reads or writes. If the source stride is 1,
+ *   2 or 4 elements, each destination row is one descriptor that walks a
+ *   source column. Otherwise, if the destination stride is, each source
+ *   row is one descriptor that writes a destination column. Failing both,
+ *   each element takes a descriptor. The two areas must not overlap.
+ *
+ * @return
+ *   blitOk, or an error with the chain unchanged.
+ *****************************************************************************/
+BLIT_Status_TypeDef BLIT_Transpose(BLIT_Chain_TypeDef *chain,
+                                   const BLIT_Surface_TypeDef *dst,
+                                   uint16_t dx,
+                                   uint16_t dy,
+                                   const BLIT_Surface_TypeDef *src,
+                                   const BLIT_Rect_TypeDef *rect)
+{
+  BLIT_Status_TypeDef status;
+  uint8_t e = src->elemSize;
+  uint16_t count = chain->count;
+  uint32_t units = chain->units, bytes = chain->bytes;
+  uint32_t srcStep, dstStep, r, c;
+  uint8_t *s, *d, unit;
+  bool ok = true;
+
+  if (chain->busy) {
+    return blitErrBusy;
+  }
+  if (e != dst->elemSize) {
+    return blitErrParam;
+  }
+  status = checkRect(src, rect->x, rect->y, rect->w, rect->h);
+  if (status == blitOk) {
+    status = checkRect(dst, dx, dy, rect->h, rect->w);
+  }
+  if (status != blitOk) {
+    return status;
+  }
+
+  s = at(src, rect->x, rect->y);
+  d = at(dst, dx, dy);
+  if (d < s + (rect->h - 1) * src->stride + (uint32_t)rect->w * e
+      && s < d + (rect->w - 1) * dst->stride + (uint32_t)rect->h * e) {
+    return blitErrOverlap;
+  }
+
+  unit = unitFor((uintptr_t)s | (uintptr_t)d | src->stride | dst->stride | e);
+  srcStep = (src->stride % e == 0) ? src->stride / e : 0;
+  dstStep = (dst->stride % e == 0) ? dst->stride / e : 0;
+
+  if (unit == e && (srcStep == 1 || srcStep == 2 || srcStep == 4)) {
+    // One destination row per descriptor
+    for (c = 0; ok && c < rect->w; c++) {
+      ok = emit(chain, s + c * e, d + c * dst->stride, rect->h, e,
+                (uint8_t)srcStep, 1);
+    }
+  } else if (unit == e && (dstStep == 1 || dstStep == 2 || dstStep == 4)) {
+    // One destination column per descriptor
+    for (r = 0; ok && r < rect->h; r++) {
+      ok = emit(chain, s + r * src->stride, d + r * e, rect->w, e,
+                1, (uint8_t)dstStep);
+    }
+  } else {
+    for (c = 0; ok && c < rect->w; c++) {
+      for (r = 0; ok && r < rect->h; r++) {
+        ok = emit(chain, s + r * src->stride + c * e,
+                  d + c * dst->stride + r * e, e / unit, unit, 1, 1);
+      }
+    }
+  }
+  if (!ok) {
+    return rollback(chain, count, units, bytes);
+  }
+  return blitOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add a rectangle fill to the chain.
+ *
+ * @details
+ *   Every element of rect in dst is set to value. The element size must
+ *   be 1, 2 or 4 bytes and the rows element-aligned; the value is kept in
+ *   the chain and repeated over word transfers where alignment allows.
+ *   Up to BLIT_MAX_FILLS different values fit in one chain.
+ *
+ * @return
+ *   blitOk, or an error with the chain unchanged.
+ *****************************************************************************/
+BLIT_Status_TypeDef BLIT_Fill(BLIT_Chain_TypeDef *chain,
+                              const BLIT_Surface_TypeDef *dst,
+                              const BLIT_Rect_TypeDef *rect,
+                              uint32_t value)
+{
+  BLIT_Status_TypeDef status;
+  uint8_t e = dst->elemSize;
+  uint32_t rowBytes = (uint32_t)rect->w * e;
+  uint16_t count = chain->count;
+  uint32_t units = chain->units, bytes = chain->bytes;
+  uint8_t *d, unit, i;
+
+  if (chain->busy) {
+    return blitErrBusy;
+  }
+  status = checkRect(dst, rect->x, rect->y, rect->w, rect->h);
+  if (status != blitOk) {
+    return status;
+  }
+  d = at(dst, rect->x, rect->y);
+  unit = unitFor((uintptr_t)d | rowBytes | (rect->h > 1 ? dst->stride : 0));
+  if (e == 3 || unit < e) {
+    return blitErrParam;
+  }
+
+  // The same value in every byte lane of the source word
+  if (e == 1) {
+    value = (value & 0xFF) * 0x01010101;
+  } else if (e == 2) {
+    value = (value & 0xFFFF) * 0x00010001;
+  }
+  for (i = 0; i < chain->fills && chain->fill[i] != value; i++) {
+  }
+  if (i == BLIT_MAX_FILLS) {
+    return blitErrSteps;
+  }
+
+  if (!addRows(chain, (const uint8_t *)&chain->fill[i], 0, d, dst->stride,
+               rect->h, rowBytes, unit, 0, false)) {
+    return rollback(chain, count, units, bytes);
+  }
+  if (i == chain->fills) {
+    chain->fill[i] = value;
+    chain->fills++;
+  }
+  return blitOk;
+}
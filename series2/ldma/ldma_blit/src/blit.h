@@ -0,0 +1,151 @@
+/***************************************************************************//**
+ * @file blit.h
+ * @brief 2D LDMA blits: rectangle copy, transpose and fill between strided
+ * buffers, compiled into one descriptor chain per batch.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef BLIT_H
+#define BLIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !defined(BLIT_HOST)
+#include "em_ldma.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Descriptors in one chain
+#ifndef BLIT_MAX_STEPS
+#define BLIT_MAX_STEPS      256
+#endif
+
+/// Fill values held by one chain
+#define BLIT_MAX_FILLS      8
+
+/// Longest single LDMA transfer, in units
+#define BLIT_MAX_COUNT      2048
+
+#if defined(BLIT_HOST)
+/// Host stand-in for an LDMA memory-to-memory transfer descriptor
+typedef struct {
+  const uint8_t *src;
+  uint8_t       *dst;
+  uint16_t      count;    ///< Units
+  uint8_t       unit;     ///< Bytes per unit: 1, 2 or 4
+  uint8_t       srcInc;   ///< Units between source reads: 0, 1, 2 or 4
+  uint8_t       dstInc;   ///< Units between destination writes: 1, 2 or 4
+  bool          done;     ///< Last descriptor; raises the done interrupt
+} BLIT_Desc_TypeDef;
+#else
+typedef LDMA_Descriptor_t BLIT_Desc_TypeDef;
+#endif
+
+/// A 2D buffer of elements; row y starts at base + y * stride
+typedef struct {
+  void     *base;
+  uint32_t stride;        ///< Bytes from one row to the next
+  uint16_t width;         ///< Elements per row
+  uint16_t height;        ///< Rows
+  uint8_t  elemSize;      ///< Bytes per element
+} BLIT_Surface_TypeDef;
+
+/// Rectangle, in elements
+typedef struct {
+  uint16_t x;
+  uint16_t y;
+  uint16_t w;
+  uint16_t h;
+} BLIT_Rect_TypeDef;
+
+typedef enum {
+  blitOk,
+  blitErrParam,     ///< Empty rectangle or unsupported element size
+  blitErrRange,     ///< Rectangle outside a surface
+  blitErrOverlap,   ///< Overlapping copy the LDMA cannot do in order
+  blitErrSteps,     ///< Chain full; nothing was added
+  blitErrBusy       ///< Chain is running
+} BLIT_Status_TypeDef;
+
+typedef void (*BLIT_Callback_TypeDef)(void *user, bool error);
+
+/// Descriptor chain; built with the BLIT_Copy/Transpose/Fill functions
+typedef struct {
+  BLIT_Desc_TypeDef     desc[BLIT_MAX_STEPS];
+  uint16_t              count;        ///< Descriptors used
+  uint32_t              fill[BLIT_MAX_FILLS];
+  uint8_t               fills;
+  uint32_t              units;        ///< LDMA transfers in the chain
+  uint32_t              bytes;        ///< Bytes written by the chain
+
+  // Set by BLIT_Start()
+  volatile bool         busy;
+  unsigned int          channel;
+  BLIT_Callback_TypeDef callback;
+  void                  *user;
+} BLIT_Chain_TypeDef;
+
+void BLIT_Init(BLIT_Chain_TypeDef *chain);
+BLIT_Status_TypeDef BLIT_Copy(BLIT_Chain_TypeDef *chain,
+                              const BLIT_Surface_TypeDef *dst,
+                              uint16_t dx,
+                              uint16_t dy,
+                              const BLIT_Surface_TypeDef *src,
+                              const BLIT_Rect_TypeDef *rect);
+BLIT_Status_TypeDef BLIT_Transpose(BLIT_Chain_TypeDef *chain,
+                                   const BLIT_Surface_TypeDef *dst,
+                                   uint16_t dx,
+                                   uint16_t dy,
+                                   const BLIT_Surface_TypeDef *src,
+                                   const BLIT_Rect_TypeDef *rect);
+BLIT_Status_TypeDef BLIT_Fill(BLIT_Chain_TypeDef *chain,
+                              const BLIT_Surface_TypeDef *dst,
+                              const BLIT_Rect_TypeDef *rect,
+                              uint32_t value);
+
+#if !defined(BLIT_HOST)
+BLIT_Status_TypeDef BLIT_Start(BLIT_Chain_TypeDef *chain,
+                               unsigned int channel,
+                               BLIT_Callback_TypeDef callback,
+                               void *user);
+void BLIT_IRQHandler(BLIT_Chain_TypeDef *chain);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLIT_H
@@ -0,0 +1,268 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Draws a small RGB565 frame and transposes sensor matrices with
+ * LDMA blit chains, then checks the results against CPU loops.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "blit.h"
+
+// DMA channel used for the example
+#define LDMA_CHANNEL    0
+
+// Framebuffer and sprite, RGB565
+#define FB_WIDTH        64
+#define FB_HEIGHT       48
+#define SPRITE_SIZE     16
+
+#define BLUE            0x001F
+#define RED             0xF800
+#define WHITE           0xFFFF
+
+// Sensor matrices: 8 channels by 4 and by 6 samples
+#define CHANNELS        8
+#define SAMPLES         4
+#define SAMPLES_LONG    6
+
+static uint16_t fb[FB_HEIGHT][FB_WIDTH];
+static uint16_t sprite[SPRITE_SIZE][SPRITE_SIZE];
+static uint8_t samples[SAMPLES_LONG][CHANNELS];
+static uint8_t byChannel[CHANNELS][SAMPLES];
+static uint8_t byChannelLong[CHANNELS][SAMPLES_LONG];
+
+// Expected results, built by the CPU
+static uint16_t fbRef[FB_HEIGHT][FB_WIDTH];
+
+static BLIT_Chain_TypeDef chain;
+static volatile bool done;
+static volatile bool failed;
+
+/***************************************************************************//**
+ * @brief
+ *   LDMA IRQ handler.
+ ******************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  BLIT_IRQHandler(&chain);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Chain finished.
+ ******************************************************************************/
+static void blitDone(void *user, bool error)
+{
+  (void)user;
+  failed = error;
+  done = true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Run the chain and sleep in EM1 until it ends.
+ ******************************************************************************/
+static bool runChain(const char *name)
+{
+  done = false;
+  if (BLIT_Start(&chain, LDMA_CHANNEL, blitDone, NULL) != blitOk) {
+    return false;
+  }
+  while (!done) {
+    EMU_EnterEM1();
+  }
+  printf("%-10s %3u descriptors, %5lu transfers, %5lu bytes\n", name,
+         chain.count, chain.units, chain.bytes);
+  return !failed;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Draw the frame with the CPU: background, status bar, two sprites, then
+ *   scroll the lower part of the screen up by 4 rows.
+ ******************************************************************************/
+static void drawReference(void)
+{
+  int x, y;
+
+  for (y = 0; y < FB_HEIGHT; y++) {
+    for (x = 0; x < FB_WIDTH; x++) {
+      fbRef[y][x] = (y < 6) ? RED : BLUE;
+    }
+  }
+  for (y = 0; y < SPRITE_SIZE; y++) {
+    for (x = 0; x < SPRITE_SIZE; x++) {
+      fbRef[8 + y][4 + x] = sprite[y][x];
+    }
+    for (x = 0; x < 11; x++) {
+      fbRef[24 + y][41 + x] = sprite[y][2 + x];
+    }
+  }
+  for (y = 6; y < FB_HEIGHT - 4; y++) {
+    memmove(fbRef[y], fbRef[y + 4], sizeof(fbRef[0]));
+  }
+  for (x = 0; x < FB_WIDTH; x++) {
+    fbRef[FB_HEIGHT - 4][x] = fbRef[FB_HEIGHT - 3][x] = WHITE;
+    fbRef[FB_HEIGHT - 2][x] = fbRef[FB_HEIGHT - 1][x] = WHITE;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The same frame as one LDMA chain.
+ ******************************************************************************/
+static bool drawFrame(void)
+{
+  BLIT_Surface_TypeDef screen = { fb, sizeof(fb[0]), FB_WIDTH, FB_HEIGHT, 2 };
+  BLIT_Surface_TypeDef spr = {
+    sprite, sizeof(sprite[0]), SPRITE_SIZE, SPRITE_SIZE, 2
+  };
+  BLIT_Rect_TypeDef bar = { 0, 0, FB_WIDTH, 6 };
+  BLIT_Rect_TypeDef body = { 0, 6, FB_WIDTH, FB_HEIGHT - 6 };
+  BLIT_Rect_TypeDef whole = { 0, 0, SPRITE_SIZE, SPRITE_SIZE };
+  BLIT_Rect_TypeDef part = { 2, 0, 11, SPRITE_SIZE };
+  BLIT_Rect_TypeDef scroll = { 0, 10, FB_WIDTH, FB_HEIGHT - 10 };
+  BLIT_Rect_TypeDef bottom = { 0, FB_HEIGHT - 4, FB_WIDTH, 4 };
+
+  BLIT_Init(&chain);
+  if (BLIT_Fill(&chain, &screen, &bar, RED) != blitOk
+      || BLIT_Fill(&chain, &screen, &body, BLUE) != blitOk
+      || BLIT_Copy(&chain, &screen, 4, 8, &spr, &whole) != blitOk
+      || BLIT_Copy(&chain, &screen, 41, 24, &spr, &part) != blitOk
+      || BLIT_Copy(&chain, &screen, 0, 6, &screen, &scroll) != blitOk
+      || BLIT_Fill(&chain, &screen, &bottom, WHITE) != blitOk) {
+    return false;
+  }
+  return runChain("frame");
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Turn sample-major matrices into channel-major ones.
+ *
+ * @details
+ *   byChannel rows are 4 bytes apart, so each sample row is written down a
+ *   column with one descriptor. byChannelLong rows are 6 bytes apart,
+ *   which the LDMA cannot step, so it takes one descriptor per element.
+ ******************************************************************************/
+static bool transposeSamples(void)
+{
+  BLIT_Surface_TypeDef in = { samples, CHANNELS, CHANNELS, SAMPLES_LONG, 1 };
+  BLIT_Surface_TypeDef out = { byChannel, SAMPLES, SAMPLES, CHANNELS, 1 };
+  BLIT_Surface_TypeDef outLong = {
+    byChannelLong, SAMPLES_LONG, SAMPLES_LONG, CHANNELS, 1
+  };
+  BLIT_Rect_TypeDef first = { 0, 0, CHANNELS, SAMPLES };
+  BLIT_Rect_TypeDef all = { 0, 0, CHANNELS, SAMPLES_LONG };
+  bool ok;
+  int s, c;
+
+  BLIT_Init(&chain);
+  ok = BLIT_Transpose(&chain, &out, 0, 0, &in, &first) == blitOk
+       && runChain("transpose");
+  BLIT_Init(&chain);
+  ok = ok && BLIT_Transpose(&chain, &outLong, 0, 0, &in, &all) == blitOk
+       && runChain("transpose");
+
+  for (s = 0; ok && s < SAMPLES_LONG; s++) {
+    for (c = 0; c < CHANNELS; c++) {
+      ok = ok && byChannelLong[c][s] == samples[s][c]
+           && (s >= SAMPLES || byChannel[c][s] == samples[s][c]);
+    }
+  }
+  return ok;
+}
+
+/***************************************************************************//**
+ * @brief  Main function
+ ******************************************************************************/
+int main(void)
+{
+  LDMA_Init_t init = LDMA_INIT_DEFAULT;
+  bool ok;
+  int x, y;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+
+  CMU_ClockEnable(cmuClock_LDMA, true);
+  LDMA_Init(&init);
+
+  // Test content: a gradient sprite and a numbered sample matrix
+  for (y = 0; y < SPRITE_SIZE; y++) {
+    for (x = 0; x < SPRITE_SIZE; x++) {
+      sprite[y][x] = (uint16_t)((x << 12) | (y << 7) | (x + y));
+    }
+  }
+  for (y = 0; y < SAMPLES_LONG; y++) {
+    for (x = 0; x < CHANNELS; x++) {
+      samples[y][x] = (uint8_t)(y * 16 + x);
+    }
+  }
+
+  printf("\nLDMA blit\n");
+  drawReference();
+  ok = drawFrame() && memcmp(fb, fbRef, sizeof(fb)) == 0;
+  printf("-- frame %s\n", ok ? "matches" : "differs");
+  ok = transposeSamples() && ok;
+  printf("-- %s\n", ok ? "all blits correct" : "blit error");
+
+  if (ok) {
+    GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  }
+
+  while (1) {
+    EMU_EnterEM1();
+  }
+}
@@ -0,0 +1,430 @@
+/***************************************************************************//**
+ * @file blit_sim.c
+ * @brief Host test and benchmark for the 2D LDMA blit library.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DBLIT_HOST -I../src -o blit_sim blit_sim.c ../src/blit.c
+ *   ./blit_sim
+ *
+ * A model of the LDMA runs the compiled chains one unit at a time, reading
+ * then writing as the hardware does, so that overlapping copies show the
+ * same damage they would on the device. Random copies, transposes and
+ * fills over padded, unaligned surfaces with 1 to 4 byte elements are
+ * compared with plain C loops; the number of descriptors and transfers is
+ * checked against the best the LDMA can do. The exit status is non-zero
+ * if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "blit.h"
+
+#define ARENA   10240
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// Two arenas: the LDMA model works on one, the reference loops on the other
+static uint8_t dmaMem[ARENA + 8];
+static uint8_t refMem[ARENA + 8];
+
+/*
+ * Run a chain like the LDMA: descriptors in order, one unit at a time,
+ * until the descriptor that raises the done interrupt.
+ */
+static uint32_t runChain(const BLIT_Chain_TypeDef *chain)
+{
+  uint32_t transfers = 0, n;
+  uint16_t i;
+
+  for (i = 0; i < chain->count; i++) {
+    const BLIT_Desc_TypeDef *d = &chain->desc[i];
+    uint8_t unit[4];
+
+    check(d->count >= 1 && d->count <= BLIT_MAX_COUNT, "transfer count");
+    check(((uintptr_t)d->src % d->unit) == 0
+          && ((uintptr_t)d->dst % d->unit) == 0, "aligned transfers");
+    for (n = 0; n < d->count; n++) {
+      memcpy(unit, d->src + n * d->srcInc * d->unit, d->unit);
+      memcpy(d->dst + n * d->dstInc * d->unit, unit, d->unit);
+      transfers++;
+    }
+    if (d->done) {
+      check(i == chain->count - 1, "done only on the last descriptor");
+      break;
+    }
+  }
+  return transfers;
+}
+
+// Same surface in the other arena
+static BLIT_Surface_TypeDef ref(const BLIT_Surface_TypeDef *s)
+{
+  BLIT_Surface_TypeDef r = *s;
+
+  r.base = refMem + ((uint8_t *)s->base - dmaMem);
+  return r;
+}
+
+static uint8_t *elem(const BLIT_Surface_TypeDef *s, uint32_t x, uint32_t y)
+{
+  return (uint8_t *)s->base + y * s->stride + x * s->elemSize;
+}
+
+static void refCopy(const BLIT_Surface_TypeDef *dst, uint16_t dx, uint16_t dy,
+                    const BLIT_Surface_TypeDef *src,
+                    const BLIT_Rect_TypeDef *rect, bool transpose)
+{
+  static uint8_t tmp[ARENA];
+  uint32_t r, c, e = src->elemSize;
+
+  // Through a copy, as if the whole source were read first
+  for (r = 0; r < rect->h; r++) {
+    memcpy(tmp + (r * rect->w) * e, elem(src, rect->x, rect->y + r),
+           rect->w * e);
+  }
+  for (r = 0; r < rect->h; r++) {
+    for (c = 0; c < rect->w; c++) {
+      memcpy(transpose ? elem(dst, dx + r, dy + c) : elem(dst, dx + c, dy + r),
+             tmp + (r * rect->w + c) * e, e);
+    }
+  }
+}
+
+static void refFill(const BLIT_Surface_TypeDef *dst,
+                    const BLIT_Rect_TypeDef *rect, uint32_t value)
+{
+  uint32_t r, c;
+
+  for (r = 0; r < rect->h; r++) {
+    for (c = 0; c < rect->w; c++) {
+      memcpy(elem(dst, rect->x + c, rect->y + r), &value, dst->elemSize);
+    }
+  }
+}
+
+static uint32_t rnd(uint32_t n)
+{
+  return (uint32_t)rand() % n;
+}
+
+// A random surface of up to 48 x 24 elements somewhere in the arena
+static BLIT_Surface_TypeDef randomSurface(uint8_t elemSize, uint32_t offset)
+{
+  BLIT_Surface_TypeDef s;
+
+  s.elemSize = elemSize;
+  s.width = 1 + rnd(48);
+  s.height = 1 + rnd(24);
+  s.stride = s.width * elemSize + (rnd(2) ? rnd(9) : 0);
+  s.base = dmaMem + offset + rnd(8);
+  return s;
+}
+
+static BLIT_Rect_TypeDef randomRect(const BLIT_Surface_TypeDef *s)
+{
+  BLIT_Rect_TypeDef r;
+
+  r.w = 1 + rnd(s->width);
+  r.h = 1 + rnd(s->height);
+  r.x = rnd(s->width - r.w + 1);
+  r.y = rnd(s->height - r.h + 1);
+  return r;
+}
+
+static void randomize(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < sizeof(dmaMem); i++) {
+    dmaMem[i] = (uint8_t)rand();
+  }
+  memcpy(refMem, dmaMem, sizeof(dmaMem));
+}
+
+static void testRandom(void)
+{
+  BLIT_Chain_TypeDef chain;
+  BLIT_Surface_TypeDef a, b, ra, rb;
+  BLIT_Rect_TypeDef rect;
+  BLIT_Status_TypeDef st;
+  int op, ok = 0;
+
+  // Until 10000 blits were accepted and run
+  while (ok < 10000) {
+    randomize();
+    a = randomSurface(1 + rnd(4), 0);
+    b = randomSurface(a.elemSize, 5120);
+    ra = ref(&a);
+    rb = ref(&b);
+    rect = randomRect(&a);
+    op = rnd(3);
+    BLIT_Init(&chain);
+
+    if (op == 0) {
+      uint16_t dx = rnd(b.width - (rect.w > b.width ? b.width : rect.w) + 1);
+      uint16_t dy = rnd(b.height - (rect.h > b.height ? b.height : rect.h) + 1);
+
+      st = BLIT_Copy(&chain, &b, dx, dy, &a, &rect);
+      if (rect.w > b.width || rect.h > b.height) {
+        check(st == blitErrRange, "copy out of range refused");
+        continue;
+      }
+      refCopy(&rb, dx, dy, &ra, &rect, false);
+      check(chain.bytes == (uint32_t)rect.w * rect.h * a.elemSize,
+            "copy bytes");
+    } else if (op == 1) {
+      uint16_t dx = rnd(b.width - (rect.h > b.width ? b.width : rect.h) + 1);
+      uint16_t dy = rnd(b.height - (rect.w > b.height ? b.height : rect.w) + 1);
+
+      st = BLIT_Transpose(&chain, &b, dx, dy, &a, &rect);
+      if (rect.h > b.width || rect.w > b.height) {
+        check(st == blitErrRange, "transpose out of range refused");
+        continue;
+      }
+      if (st == blitErrSteps) {
+        check(chain.count == 0, "full chain left empty");
+        continue;
+      }
+      refCopy(&rb, dx, dy, &ra, &rect, true);
+    } else {
+      uint32_t value = (uint32_t)rand() * 65599u;
+
+      st = BLIT_Fill(&chain, &a, &rect, value);
+      if (st == blitErrParam) {
+        // Element size 3, or elements not aligned to their size
+        check(a.elemSize == 3 || ((uintptr_t)elem(&a, rect.x, rect.y)
+                                  | (rect.h > 1 ? a.stride : 0))
+              % a.elemSize != 0, "fill refused only when unaligned");
+        continue;
+      }
+      refFill(&ra, &rect, value);
+    }
+    check(st == blitOk, "random blit accepted");
+    if (st != blitOk) {
+      continue;
+    }
+    check(runChain(&chain) == chain.units, "transfer count matches");
+    if (memcmp(dmaMem, refMem, sizeof(dmaMem)) != 0) {
+      printf("op %d elem %u rect %u,%u %ux%u strides %lu %lu\n", op,
+             a.elemSize, rect.x, rect.y, rect.w, rect.h,
+             (unsigned long)a.stride, (unsigned long)b.stride);
+      check(0, "random blit matches the reference");
+    }
+    ok++;
+  }
+}
+
+static void testEfficiency(void)
+{
+  static uint16_t fb[48][64];
+  static uint16_t sprite[16][16];
+  static uint8_t matrix[6][8], matrixT[8][6], narrow[8][4];
+  BLIT_Surface_TypeDef fbs = { fb, sizeof(fb[0]), 64, 48, 2 };
+  BLIT_Surface_TypeDef sps = { sprite, sizeof(sprite[0]), 16, 16, 2 };
+  BLIT_Surface_TypeDef ms = { matrix, 8, 8, 6, 1 };
+  BLIT_Surface_TypeDef mts = { matrixT, 6, 6, 8, 1 };
+  BLIT_Surface_TypeDef ns = { narrow, 4, 4, 8, 1 };
+  BLIT_Surface_TypeDef bytes = { (uint8_t *)fb + 1, 5000, 5000, 1, 1 };
+  BLIT_Rect_TypeDef all = { 0, 0, 64, 48 }, line = { 0, 0, 5000, 1 };
+  BLIT_Rect_TypeDef spr = { 0, 0, 16, 16 };
+  BLIT_Rect_TypeDef odd = { 0, 0, 15, 16 };
+  BLIT_Rect_TypeDef mat = { 0, 0, 8, 4 };
+  BLIT_Rect_TypeDef mat6 = { 0, 0, 8, 6 };
+  BLIT_Chain_TypeDef chain;
+
+  // Whole contiguous framebuffer: one run of words
+  BLIT_Init(&chain);
+  check(BLIT_Fill(&chain, &fbs, &all, 0x1234) == blitOk, "fill whole");
+  check(chain.count == 1 && chain.units == 64 * 48 / 2, "fill whole: words");
+  check(chain.fills == 1 && chain.fill[0] == 0x12341234, "fill value");
+
+  // Longer than one LDMA transfer
+  BLIT_Init(&chain);
+  check(BLIT_Fill(&chain, &bytes, &line, 0x5A) == blitOk, "long line");
+  check(chain.count == 3 && chain.units == 5000, "long line: split");
+  check(chain.desc[1].dst == (uint8_t *)fb + 1 + BLIT_MAX_COUNT,
+        "long line: second part");
+
+  // Sprite: one descriptor of words per row
+  BLIT_Init(&chain);
+  check(BLIT_Copy(&chain, &fbs, 8, 8, &sps, &spr) == blitOk, "sprite");
+  check(chain.count == 16 && chain.units == 16 * 16 / 2, "sprite: words");
+
+  // Odd width: halfwords
+  BLIT_Init(&chain);
+  check(BLIT_Copy(&chain, &fbs, 8, 8, &sps, &odd) == blitOk, "odd sprite");
+  check(chain.count == 16 && chain.units == 15 * 16, "odd sprite: halfwords");
+
+  // Destination stride of 4 elements: one descriptor per source row
+  BLIT_Init(&chain);
+  check(BLIT_Transpose(&chain, &ns, 0, 0, &ms, &mat) == blitOk,
+        "transpose to stride 4");
+  check(chain.count == 4 && chain.units == 32,
+        "transpose to stride 4: one descriptor per source row");
+  BLIT_Init(&chain);
+  check(BLIT_Transpose(&chain, &mts, 0, 0, &ms, &mat6) == blitOk,
+        "transpose 8x6");
+  check(chain.count == 48, "transpose 8x6: one descriptor per element");
+
+  // Fill values are shared
+  BLIT_Init(&chain);
+  BLIT_Fill(&chain, &fbs, &spr, 7);
+  BLIT_Fill(&chain, &fbs, &odd, 7);
+  BLIT_Fill(&chain, &fbs, &spr, 8);
+  check(chain.fills == 2, "fill values shared");
+}
+
+static void testOverlap(void)
+{
+  BLIT_Surface_TypeDef s = { dmaMem, 40, 40, 40, 1 }, rs = ref(&s);
+  BLIT_Surface_TypeDef t = { dmaMem + 3, 40, 40, 40, 1 };
+  BLIT_Surface_TypeDef u = { dmaMem, 44, 40, 40, 1 };
+  BLIT_Rect_TypeDef up = { 0, 4, 40, 36 }, down = { 0, 0, 40, 36 };
+  BLIT_Rect_TypeDef right = { 0, 0, 30, 40 }, diag = { 2, 2, 30, 30 };
+  BLIT_Chain_TypeDef chain;
+
+  // Scroll up, down, left
+  randomize();
+  BLIT_Init(&chain);
+  check(BLIT_Copy(&chain, &s, 0, 0, &s, &up) == blitOk, "scroll up");
+  refCopy(&rs, 0, 0, &rs, &up, false);
+  runChain(&chain);
+  check(memcmp(dmaMem, refMem, sizeof(dmaMem)) == 0, "scroll up matches");
+  check(chain.count == 1, "scroll up: one run");
+
+  randomize();
+  BLIT_Init(&chain);
+  check(BLIT_Copy(&chain, &s, 0, 4, &s, &down) == blitOk, "scroll down");
+  refCopy(&rs, 0, 4, &rs, &down, false);
+  runChain(&chain);
+  check(memcmp(dmaMem, refMem, sizeof(dmaMem)) == 0, "scroll down matches");
+  check(chain.count == 36, "scroll down: rows bottom up");
+
+  randomize();
+  BLIT_Init(&chain);
+  check(BLIT_Copy(&chain, &s, 0, 1, &s, &diag) == blitOk, "down and left");
+  refCopy(&rs, 0, 1, &rs, &diag, false);
+  runChain(&chain);
+  check(memcmp(dmaMem, refMem, sizeof(dmaMem)) == 0, "down and left matches");
+
+  BLIT_Init(&chain);
+  check(BLIT_Copy(&chain, &s, 10, 0, &s, &right) == blitErrOverlap,
+        "scroll right refused");
+  check(BLIT_Copy(&chain, &t, 0, 0, &s, &right) == blitErrOverlap,
+        "shift right by 3 bytes refused");
+  check(BLIT_Copy(&chain, &u, 0, 0, &s, &down) == blitErrOverlap,
+        "overlap with different strides refused");
+  check(BLIT_Transpose(&chain, &s, 0, 0, &s, &diag) == blitErrOverlap,
+        "transpose in place refused");
+  check(chain.count == 0, "refused blits leave the chain empty");
+}
+
+static void testErrors(void)
+{
+  static uint8_t buf[4096];
+  static BLIT_Chain_TypeDef chain;
+  BLIT_Surface_TypeDef s = { buf, 64, 64, 64, 1 };
+  BLIT_Surface_TypeDef h = { buf, 128, 64, 32, 2 };
+  BLIT_Surface_TypeDef bad = { buf, 10, 64, 64, 1 };
+  BLIT_Rect_TypeDef empty = { 0, 0, 0, 4 };
+  BLIT_Rect_TypeDef out = { 60, 0, 8, 8 }, one = { 0, 0, 1, 1 };
+  BLIT_Rect_TypeDef col = { 0, 0, 3, 64 };
+  int i;
+
+  BLIT_Init(&chain);
+  check(BLIT_Fill(&chain, &s, &empty, 0) == blitErrParam, "empty rect");
+  check(BLIT_Fill(&chain, &s, &out, 0) == blitErrRange, "rect outside");
+  check(BLIT_Fill(&chain, &bad, &one, 0) == blitErrParam, "short stride");
+  check(BLIT_Copy(&chain, &s, 0, 0, &h, &one) == blitErrParam,
+        "element sizes differ");
+
+  // Chain full: the blit that does not fit is left out whole
+  for (i = 0; i < BLIT_MAX_FILLS; i++) {
+    check(BLIT_Fill(&chain, &s, &one, i) == blitOk, "fill value");
+  }
+  check(BLIT_Fill(&chain, &s, &one, 99) == blitErrSteps, "fill values full");
+  while (chain.count + 64 <= BLIT_MAX_STEPS) {
+    BLIT_Fill(&chain, &s, &col, 1);
+  }
+  i = chain.count;
+  check(BLIT_Fill(&chain, &s, &col, 1) == blitErrSteps, "chain full");
+  check(chain.count == i && chain.desc[i - 1].done, "chain restored");
+
+  chain.busy = true;
+  check(BLIT_Fill(&chain, &s, &one, 0) == blitErrBusy, "busy");
+}
+
+static void benchmark(void)
+{
+  static BLIT_Chain_TypeDef chain;
+  static uint16_t fb[240][320];
+  BLIT_Surface_TypeDef fbs = { fb, sizeof(fb[0]), 320, 240, 2 };
+  BLIT_Rect_TypeDef r = { 3, 5, 100, 200 };
+  uint32_t n = 20000, i, rows = 0;
+  clock_t start;
+  double seconds;
+
+  start = clock();
+  for (i = 0; i < n; i++) {
+    BLIT_Init(&chain);
+    BLIT_Copy(&chain, &fbs, 150, 20, &fbs, &r);
+    rows += chain.count;
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  check(rows == n * 200, "benchmark chains");
+  printf("chain build: %.1f ns per row on this host\n",
+         seconds * 1e9 / rows);
+}
+
+int main(void)
+{
+  srand(1);
+  testErrors();
+  testEfficiency();
+  testOverlap();
+  testRandom();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
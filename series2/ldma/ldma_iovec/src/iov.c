@@ -0,0 +1,436 @@
+/***************************************************************************//**
+ * @file iov.c
+ * @brief LDMA scatter/gather over I/O vectors, with descriptor chains built
+ * from a shared pool.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "iov.h"
+
+#if defined(IOV_HOST)
+#define CORE_DECLARE_IRQ_STATE
+#define CORE_ENTER_CRITICAL()
+#define CORE_EXIT_CRITICAL()
+#else
+#include "em_device.h"
+#include "em_core.h"
+#include "em_ldma.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Start a built transfer on an LDMA channel.
+ *
+ * @details
+ *   LDMA_Init() must have been called. The chain runs without CPU help and
+ *   raises one interrupt at the end; IOV_IRQHandler() then returns its
+ *   descriptors to the pool and calls back. The buffers must stay valid
+ *   until then. Several transfers from the same pool may run at once on
+ *   different channels.
+ *
+ * @param[in] callback
+ *   Called from the LDMA interrupt when the transfer ends; may be NULL.
+ *****************************************************************************/
+IOV_Status_TypeDef IOV_Start(IOV_Pool_TypeDef *pool,
+                             IOV_Xfer_TypeDef *xfer,
+                             unsigned int channel,
+                             IOV_Callback_TypeDef callback,
+                             void *user)
+{
+  static const LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_MEMORY();
+
+  if (channel >= IOV_CHANNELS || channel >= DMA_CHAN_COUNT
+      || xfer->count == 0) {
+    return iovErrParam;
+  }
+  if (xfer->busy || pool->active[channel] != NULL) {
+    return iovErrBusy;
+  }
+
+  xfer->callback = callback;
+  xfer->user = user;
+  xfer->busy = true;
+  pool->active[channel] = xfer;
+
+  LDMA_StartTransfer(channel, &cfg, &pool->desc[xfer->first]);
+
+  // LDMA_StartTransfer() takes the done interrupt from the first descriptor
+  LDMA_IntEnable(1 << channel);
+  return iovOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   LDMA interrupt handling for a pool; call from LDMA_IRQHandler().
+ *
+ * @details
+ *   An LDMA error does not say which channel caused it, so every running
+ *   transfer of the pool is stopped and reported as failed.
+ *****************************************************************************/
+void IOV_IRQHandler(IOV_Pool_TypeDef *pool)
+{
+  uint32_t flags = LDMA_IntGet();
+  bool error = (flags & LDMA_IF_ERROR) != 0;
+  IOV_Xfer_TypeDef *xfer;
+  unsigned int ch;
+
+  if (error) {
+    LDMA_IntClear(LDMA_IF_ERROR);
+  }
+  for (ch = 0; ch < IOV_CHANNELS; ch++) {
+    xfer = pool->active[ch];
+    if (xfer == NULL || !(error || (flags & (1 << ch)))) {
+      continue;
+    }
+    LDMA_IntClear(1 << ch);
+    LDMA_IntDisable(1 << ch);
+    if (error) {
+      LDMA_StopTransfer(ch);
+    }
+    pool->active[ch] = NULL;
+    IOV_Release(pool, xfer);
+    xfer->busy = false;
+    if (xfer->callback) {
+      xfer->callback(xfer->user, error);
+    }
+  }
+}
+#endif // !IOV_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Largest transfer unit, 4, 2 or 1 bytes, that divides every address
+ *   and length or'ed into bits.
+ *****************************************************************************/
+static uint8_t unitFor(uintptr_t bits)
+{
+  if ((bits & 3) == 0) {
+    return 4;
+  }
+  return (bits & 1) ? 1 : 2;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take a descriptor from the pool and make it the end of the chain.
+ *
+ * @return
+ *   false if the pool is empty.
+ *****************************************************************************/
+static bool append(IOV_Pool_TypeDef *pool,
+                   IOV_Xfer_TypeDef *xfer,
+                   const uint8_t *src,
+                   uint8_t *dst,
+                   uint16_t count,
+                   uint8_t unit)
+{
+  IOV_Desc_TypeDef *d;
+  uint8_t i;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  i = pool->free;
+  if (i != IOV_END) {
+    pool->free = pool->link[i];
+    pool->available--;
+    if (pool->available < pool->lowWater) {
+      pool->lowWater = pool->available;
+    }
+  }
+  CORE_EXIT_CRITICAL();
+  if (i == IOV_END) {
+    return false;
+  }
+
+  d = &pool->desc[i];
+#if defined(IOV_HOST)
+  d->src = src;
+  d->dst = dst;
+  d->count = count;
+  d->unit = unit;
+  d->done = true;
+  if (xfer->count > 0) {
+    pool->desc[xfer->last].done = false;
+  }
+#else
+  static const uint8_t sizes[] = {
+    0, ldmaCtrlSizeByte, ldmaCtrlSizeHalf, 0, ldmaCtrlSizeWord
+  };
+
+  *d = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_SINGLE_M2M_BYTE((uint32_t)src,
+                                                          (uint32_t)dst,
+                                                          count);
+  d->xfer.size = sizes[unit];
+  if (xfer->count > 0) {
+    // Pool descriptors are not in order; link by absolute address
+    LDMA_Descriptor_t *prev = &pool->desc[xfer->last];
+
+    prev->xfer.doneIfs = 0;
+    prev->xfer.linkMode = ldmaLinkModeAbs;
+    prev->xfer.linkAddr = (uint32_t)d >> 2;
+    prev->xfer.link = 1;
+  }
+#endif
+
+  pool->link[i] = IOV_END;
+  if (xfer->count == 0) {
+    xfer->first = i;
+  } else {
+    pool->link[xfer->last] = i;
+  }
+  xfer->last = i;
+  xfer->count++;
+  xfer->units += count;
+  xfer->bytes += (uint32_t)count * unit;
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add a run with one transfer width, split into transfers the LDMA can
+ *   count.
+ *****************************************************************************/
+static bool addRun(IOV_Pool_TypeDef *pool,
+                   IOV_Xfer_TypeDef *xfer,
+                   const uint8_t *src,
+                   uint8_t *dst,
+                   uint32_t len)
+{
+  uint8_t unit = unitFor((uintptr_t)src | (uintptr_t)dst | len);
+  uint32_t units = len / unit, n;
+
+  while (units > 0) {
+    n = (units > IOV_MAX_COUNT) ? IOV_MAX_COUNT : units;
+    if (!append(pool, xfer, src, dst, (uint16_t)n, unit)) {
+      return false;
+    }
+    src += n * unit;
+    dst += n * unit;
+    units -= n;
+  }
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add one segment.
+ *
+ * @details
+ *   The widest unit is limited by how source and destination are aligned
+ *   to each other. A long segment whose ends are not aligned to that unit
+ *   is split in three: the head and tail in narrower transfers and the
+ *   middle in the widest. A short one is moved in one narrower descriptor.
+ *****************************************************************************/
+static bool addSegment(IOV_Pool_TypeDef *pool,
+                       IOV_Xfer_TypeDef *xfer,
+                       const uint8_t *src,
+                       uint8_t *dst,
+                       uint32_t len)
+{
+  uint8_t best = unitFor((uintptr_t)src ^ (uintptr_t)dst);
+  uint32_t head, body;
+
+  if (best == 1 || len < IOV_SPLIT_MIN
+      || unitFor((uintptr_t)src | len) >= best) {
+    return addRun(pool, xfer, src, dst, len);
+  }
+
+  head = (uint32_t)(-(uintptr_t)src) & (best - 1);
+  body = (len - head) & ~(uint32_t)(best - 1);
+  return addRun(pool, xfer, src, dst, head)
+         && addRun(pool, xfer, src + head, dst + head, body)
+         && addRun(pool, xfer, src + head + body, dst + head + body,
+                   len - head - body);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Build a gather or scatter chain.
+ *
+ * @param[in] mem
+ *   The contiguous side: destination of a gather, source of a scatter.
+ *****************************************************************************/
+static IOV_Status_TypeDef build(IOV_Pool_TypeDef *pool,
+                                IOV_Xfer_TypeDef *xfer,
+                                uint8_t *mem,
+                                const IOV_Vec_TypeDef *iov,
+                                int n,
+                                bool gather)
+{
+  uint32_t offset = 0, len;
+  uint8_t *base;
+  bool ok = true;
+  int i = 0;
+
+  if (xfer->busy) {
+    return iovErrBusy;
+  }
+  IOV_Release(pool, xfer);
+  if (mem == NULL || n < 0 || (n > 0 && iov == NULL)) {
+    return iovErrParam;
+  }
+
+  while (ok && i < n) {
+    base = iov[i].base;
+    len = iov[i].len;
+
+    // Buffers that follow each other in memory are one segment
+    for (i++; i < n && iov[i].base == base + len; i++) {
+      len += iov[i].len;
+    }
+    if (len == 0) {
+      continue;
+    }
+    xfer->segments++;
+    if (gather) {
+      ok = addSegment(pool, xfer, base, mem + offset, len);
+    } else {
+      ok = addSegment(pool, xfer, mem + offset, base, len);
+    }
+    offset += len;
+  }
+
+  if (!ok) {
+    IOV_Release(pool, xfer);
+    return iovErrPool;
+  }
+  return xfer->count ? iovOk : iovErrParam;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Empty pool of IOV_POOL_SIZE descriptors.
+ *****************************************************************************/
+void IOV_PoolInit(IOV_Pool_TypeDef *pool)
+{
+  int i;
+
+  memset(pool, 0, sizeof(*pool));
+  for (i = 0; i < IOV_POOL_SIZE; i++) {
+    pool->link[i] = (i + 1 < IOV_POOL_SIZE) ? i + 1 : IOV_END;
+  }
+  pool->free = 0;
+  pool->available = IOV_POOL_SIZE;
+  pool->lowWater = IOV_POOL_SIZE;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Empty transfer; call once before its first use.
+ *****************************************************************************/
+void IOV_XferInit(IOV_Xfer_TypeDef *xfer)
+{
+  memset(xfer, 0, sizeof(*xfer));
+  xfer->first = IOV_END;
+  xfer->last = IOV_END;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Build a transfer that gathers n buffers, in order, into dst.
+ *
+ * @details
+ *   Any chain the transfer held is released first. Buffers that follow
+ *   each other in memory are merged; each segment then takes one to three
+ *   descriptors, more if longer than IOV_MAX_COUNT units.
+ *
+ * @return
+ *   iovOk, or an error with the transfer empty.
+ *****************************************************************************/
+IOV_Status_TypeDef IOV_Gather(IOV_Pool_TypeDef *pool,
+                              IOV_Xfer_TypeDef *xfer,
+                              void *dst,
+                              const IOV_Vec_TypeDef *iov,
+                              int n)
+{
+  return build(pool, xfer, dst, iov, n, true);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Build a transfer that scatters src, in order, over n buffers.
+ *
+ * @return
+ *   iovOk, or an error with the transfer empty.
+ *****************************************************************************/
+IOV_Status_TypeDef IOV_Scatter(IOV_Pool_TypeDef *pool,
+                               IOV_Xfer_TypeDef *xfer,
+                               const void *src,
+                               const IOV_Vec_TypeDef *iov,
+                               int n)
+{
+  return build(pool, xfer, (uint8_t *)src, iov, n, false);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Return the descriptors of a transfer that is not running to the pool.
+ *
+ * @details
+ *   Done by IOV_IRQHandler() when a transfer ends; needed only to drop a
+ *   transfer that was built but not started.
+ *****************************************************************************/
+void IOV_Release(IOV_Pool_TypeDef *pool, IOV_Xfer_TypeDef *xfer)
+{
+  uint8_t i, next;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  for (i = xfer->first; xfer->count > 0; i = next, xfer->count--) {
+    next = pool->link[i];
+    pool->link[i] = pool->free;
+    pool->free = i;
+    pool->available++;
+  }
+  CORE_EXIT_CRITICAL();
+
+  xfer->first = IOV_END;
+  xfer->last = IOV_END;
+  xfer->segments = 0;
+  xfer->bytes = 0;
+  xfer->units = 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Total length of n buffers.
+ *****************************************************************************/
+uint32_t IOV_Length(const IOV_Vec_TypeDef *iov, int n)
+{
+  uint32_t len = 0;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    len += iov[i].len;
+  }
+  return len;
+}
@@ -0,0 +1,148 @@
+/***************************************************************************//**
+ * @file iov.h
+ * @brief LDMA scatter/gather over I/O vectors, with descriptor chains built
+ * from a shared pool.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef IOV_H
+#define IOV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !defined(IOV_HOST)
+#include "em_ldma.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Descriptors in a pool, shared by all its transfers
+#ifndef IOV_POOL_SIZE
+#define IOV_POOL_SIZE     32
+#endif
+
+/// LDMA channels a pool can drive at once
+#define IOV_CHANNELS      8
+
+/// Longest single LDMA transfer, in units
+#define IOV_MAX_COUNT     2048
+
+/// Segments at least this long are split to move their aligned middle as words
+#define IOV_SPLIT_MIN     16
+
+/// No descriptor
+#define IOV_END           0xFF
+
+#if defined(IOV_HOST)
+/// Host stand-in for an LDMA memory-to-memory transfer descriptor
+typedef struct {
+  const uint8_t *src;
+  uint8_t       *dst;
+  uint16_t      count;    ///< Units
+  uint8_t       unit;     ///< Bytes per unit: 1, 2 or 4
+  bool          done;     ///< Last descriptor; raises the done interrupt
+} IOV_Desc_TypeDef;
+#else
+typedef LDMA_Descriptor_t IOV_Desc_TypeDef;
+#endif
+
+/// One buffer of a scatter or gather list
+typedef struct {
+  void     *base;
+  uint32_t len;           ///< Bytes; 0 is skipped
+} IOV_Vec_TypeDef;
+
+typedef enum {
+  iovOk,
+  iovErrParam,      ///< Nothing to move, or no such channel
+  iovErrPool,       ///< Not enough free descriptors; nothing was taken
+  iovErrBusy        ///< Transfer or channel running
+} IOV_Status_TypeDef;
+
+typedef void (*IOV_Callback_TypeDef)(void *user, bool error);
+
+/// A gather or scatter, as a chain of pool descriptors
+typedef struct {
+  uint8_t               first;        ///< Pool index, IOV_END if empty
+  uint8_t               last;
+  uint8_t               count;        ///< Descriptors
+  uint8_t               segments;     ///< After merging adjacent buffers
+  uint32_t              bytes;
+  uint32_t              units;        ///< LDMA transfers
+
+  // Set by IOV_Start()
+  volatile bool         busy;
+  IOV_Callback_TypeDef  callback;
+  void                  *user;
+} IOV_Xfer_TypeDef;
+
+typedef struct {
+  IOV_Desc_TypeDef      desc[IOV_POOL_SIZE];
+  uint8_t               link[IOV_POOL_SIZE];  ///< Next in a chain or free list
+  uint8_t               free;                 ///< Free list head
+  uint8_t               available;
+  uint8_t               lowWater;             ///< Fewest ever available
+  IOV_Xfer_TypeDef      *active[IOV_CHANNELS];
+} IOV_Pool_TypeDef;
+
+void IOV_PoolInit(IOV_Pool_TypeDef *pool);
+void IOV_XferInit(IOV_Xfer_TypeDef *xfer);
+IOV_Status_TypeDef IOV_Gather(IOV_Pool_TypeDef *pool,
+                              IOV_Xfer_TypeDef *xfer,
+                              void *dst,
+                              const IOV_Vec_TypeDef *iov,
+                              int n);
+IOV_Status_TypeDef IOV_Scatter(IOV_Pool_TypeDef *pool,
+                               IOV_Xfer_TypeDef *xfer,
+                               const void *src,
+                               const IOV_Vec_TypeDef *iov,
+                               int n);
+void IOV_Release(IOV_Pool_TypeDef *pool, IOV_Xfer_TypeDef *xfer);
+uint32_t IOV_Length(const IOV_Vec_TypeDef *iov, int n);
+
+#if !defined(IOV_HOST)
+IOV_Status_TypeDef IOV_Start(IOV_Pool_TypeDef *pool,
+                             IOV_Xfer_TypeDef *xfer,
+                             unsigned int channel,
+                             IOV_Callback_TypeDef callback,
+                             void *user);
+void IOV_IRQHandler(IOV_Pool_TypeDef *pool);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IOV_H
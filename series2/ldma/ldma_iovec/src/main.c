@@ -0,0 +1,235 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Assembles and splits packets with LDMA gather and scatter chains
+ * and compares them with memcpy().
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "iov.h"
+
+// DMA channels used for the example
+#define TX_CHANNEL      0
+#define RX_CHANNEL      1
+
+// Packet layout
+#define HEADER_LEN      6
+#define PAYLOAD_LEN     100
+#define TRAILER_LEN     2
+#define FRAME_LEN       (HEADER_LEN + PAYLOAD_LEN + TRAILER_LEN)
+
+// Packets sent in the benchmark
+#define PACKETS         1000
+
+static IOV_Pool_TypeDef pool;
+static IOV_Xfer_TypeDef tx;
+static IOV_Xfer_TypeDef rx;
+
+// Transmit side: a header, a window of the sample log and a trailer
+static uint8_t header[HEADER_LEN];
+static uint8_t sampleLog[512];
+static const uint8_t trailer[TRAILER_LEN] = { 0x5A, 0xA5 };
+static uint8_t txFrame[FRAME_LEN];
+static uint8_t txExpected[FRAME_LEN];
+
+// Receive side: a frame split into its parts
+static uint8_t rxFrame[FRAME_LEN];
+static uint8_t rxHeader[HEADER_LEN];
+static uint8_t rxPayload[PAYLOAD_LEN];
+static uint8_t rxTrailer[TRAILER_LEN];
+
+static volatile bool failed;
+
+/***************************************************************************//**
+ * @brief
+ *   LDMA IRQ handler.
+ ******************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  IOV_IRQHandler(&pool);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   A transfer finished.
+ ******************************************************************************/
+static void xferDone(void *user, bool error)
+{
+  (void)user;
+  if (error) {
+    failed = true;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start the cycle counter.
+ ******************************************************************************/
+static void initCycles(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Build the next packet header.
+ ******************************************************************************/
+static void makeHeader(uint32_t seq)
+{
+  header[0] = FRAME_LEN;
+  header[1] = 0x41;
+  header[2] = (uint8_t)seq;
+  header[3] = (uint8_t)(seq >> 8);
+  header[4] = 0x12;
+  header[5] = 0x34;
+}
+
+/***************************************************************************//**
+ * @brief  Main function
+ ******************************************************************************/
+int main(void)
+{
+  LDMA_Init_t init = LDMA_INIT_DEFAULT;
+  IOV_Vec_TypeDef txIov[3], rxIov[3];
+  uint32_t copyCycles = 0, buildCycles = 0, runCycles = 0, t;
+  uint32_t seq, offset, errors = 0;
+  unsigned int i;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+
+  CMU_ClockEnable(cmuClock_LDMA, true);
+  LDMA_Init(&init);
+  initCycles();
+
+  IOV_PoolInit(&pool);
+  IOV_XferInit(&tx);
+  IOV_XferInit(&rx);
+  for (i = 0; i < sizeof(sampleLog); i++) {
+    sampleLog[i] = (uint8_t)(i * 7 + 3);
+  }
+
+  txIov[0].base = header;
+  txIov[0].len = HEADER_LEN;
+  txIov[1].len = PAYLOAD_LEN;
+  txIov[2].base = (void *)trailer;
+  txIov[2].len = TRAILER_LEN;
+
+  rxIov[0].base = rxHeader;
+  rxIov[0].len = HEADER_LEN;
+  rxIov[1].base = rxPayload;
+  rxIov[1].len = PAYLOAD_LEN;
+  rxIov[2].base = rxTrailer;
+  rxIov[2].len = TRAILER_LEN;
+
+  printf("\nLDMA scatter/gather\n");
+
+  for (seq = 0; seq < PACKETS; seq++) {
+    // The payload window moves through the log at any alignment
+    offset = (seq * 37) % (sizeof(sampleLog) - PAYLOAD_LEN);
+    txIov[1].base = &sampleLog[offset];
+    makeHeader(seq);
+
+    // Reference: the same packet by memcpy()
+    t = DWT->CYCCNT;
+    memcpy(txExpected, header, HEADER_LEN);
+    memcpy(txExpected + HEADER_LEN, &sampleLog[offset], PAYLOAD_LEN);
+    memcpy(txExpected + HEADER_LEN + PAYLOAD_LEN, trailer, TRAILER_LEN);
+    copyCycles += DWT->CYCCNT - t;
+
+    // The last frame sent comes back as the received one
+    memcpy(rxFrame, txFrame, FRAME_LEN);
+
+    t = DWT->CYCCNT;
+    IOV_Gather(&pool, &tx, txFrame, txIov, 3);
+    IOV_Scatter(&pool, &rx, rxFrame, rxIov, 3);
+    buildCycles += DWT->CYCCNT - t;
+
+    // Both chains from the same pool run at the same time
+    t = DWT->CYCCNT;
+    IOV_Start(&pool, &tx, TX_CHANNEL, xferDone, NULL);
+    IOV_Start(&pool, &rx, RX_CHANNEL, xferDone, NULL);
+    while (tx.busy || rx.busy) {
+    }
+    runCycles += DWT->CYCCNT - t;
+
+    if (memcmp(txFrame, txExpected, FRAME_LEN) != 0
+        || memcmp(rxHeader, rxFrame, HEADER_LEN) != 0
+        || memcmp(rxPayload, rxFrame + HEADER_LEN, PAYLOAD_LEN) != 0
+        || memcmp(rxTrailer, rxFrame + HEADER_LEN + PAYLOAD_LEN,
+                  TRAILER_LEN) != 0) {
+      errors++;
+    }
+  }
+
+  printf("-- %u packets of %u bytes from 3 buffers, %lu errors\n",
+         PACKETS, FRAME_LEN, errors);
+  printf("-- memcpy:       %5lu cycles per packet\n", copyCycles / PACKETS);
+  printf("-- chain build:  %5lu cycles per gather and scatter pair\n",
+         buildCycles / PACKETS);
+  printf("-- LDMA run:     %5lu cycles for both, CPU free\n",
+         runCycles / PACKETS);
+  printf("-- pool: %u of %u descriptors used at most\n",
+         IOV_POOL_SIZE - pool.lowWater, IOV_POOL_SIZE);
+
+  if (errors == 0 && !failed) {
+    GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+  }
+
+  while (1) {
+    EMU_EnterEM1();
+  }
+}
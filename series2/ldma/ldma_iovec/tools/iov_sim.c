@@ -0,0 +1,353 @@
+/***************************************************************************//**
+ * @file iov_sim.c
+ * @brief Host test and benchmark for the LDMA scatter/gather library.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DIOV_HOST -I../src -o iov_sim iov_sim.c ../src/iov.c
+ *   ./iov_sim
+ *
+ * A model of the LDMA follows each chain through the pool, one unit at a
+ * time, and the result is compared with memcpy() of every buffer in turn.
+ * Random vectors with unaligned addresses, empty and adjacent buffers
+ * check the data; fixed cases check merging, transfer widths, pool use and
+ * errors. The benchmark compares building a packet chain with copying the
+ * packet by memcpy(). The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "iov.h"
+
+#define ARENA   32768
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// The LDMA model works on one arena, memcpy() on the other
+static uint8_t dmaMem[ARENA];
+static uint8_t refMem[ARENA];
+
+/*
+ * Run a transfer like the LDMA: from the first descriptor along the links
+ * until the one that raises the done interrupt.
+ */
+static uint32_t run(const IOV_Pool_TypeDef *pool, const IOV_Xfer_TypeDef *x)
+{
+  uint32_t transfers = 0, n, steps = 0;
+  uint8_t i = x->first;
+
+  while (i != IOV_END && steps++ < IOV_POOL_SIZE) {
+    const IOV_Desc_TypeDef *d = &pool->desc[i];
+
+    check(d->count >= 1 && d->count <= IOV_MAX_COUNT, "transfer count");
+    check(((uintptr_t)d->src % d->unit) == 0
+          && ((uintptr_t)d->dst % d->unit) == 0, "aligned transfers");
+    for (n = 0; n < d->count; n++) {
+      memcpy(d->dst + n * d->unit, d->src + n * d->unit, d->unit);
+      transfers++;
+    }
+    if (d->done) {
+      check(i == x->last && pool->link[i] == IOV_END,
+            "done only on the last descriptor");
+      break;
+    }
+    i = pool->link[i];
+  }
+  check(steps == x->count, "chain length");
+  return transfers;
+}
+
+static uint32_t rnd(uint32_t n)
+{
+  return (uint32_t)rand() % n;
+}
+
+static void randomize(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < ARENA; i++) {
+    dmaMem[i] = (uint8_t)rand();
+  }
+  memcpy(refMem, dmaMem, ARENA);
+}
+
+// Same address in the other arena
+static void *ref(const void *p)
+{
+  return refMem + ((const uint8_t *)p - dmaMem);
+}
+
+static void testRandom(void)
+{
+  IOV_Pool_TypeDef pool;
+  IOV_Xfer_TypeDef x;
+  IOV_Vec_TypeDef iov[8];
+  IOV_Status_TypeDef st;
+  uint8_t *mem, *p;
+  uint32_t off;
+  int i, n, k, gather, ok = 0;
+
+  IOV_PoolInit(&pool);
+  IOV_XferInit(&x);
+  while (ok < 20000) {
+    randomize();
+    n = 1 + rnd(8);
+    gather = rnd(2);
+    mem = dmaMem + ARENA / 2 + rnd(8);
+
+    // Buffers in the lower half; some adjacent to the one before
+    p = dmaMem + rnd(64);
+    for (i = 0; i < n; i++) {
+      if (i > 0 && rnd(3) == 0) {
+        p = (uint8_t *)iov[i - 1].base + iov[i - 1].len;
+      } else {
+        p += rnd(64);
+      }
+      iov[i].base = p;
+      iov[i].len = rnd(4) ? rnd(200) : rnd(1500);
+      p += iov[i].len;
+    }
+
+    if (gather) {
+      st = IOV_Gather(&pool, &x, mem, iov, n);
+    } else {
+      st = IOV_Scatter(&pool, &x, mem, iov, n);
+    }
+    if (IOV_Length(iov, n) == 0) {
+      check(st == iovErrParam && x.count == 0, "nothing to move");
+      continue;
+    }
+    if (st == iovErrPool) {
+      check(x.count == 0 && pool.available == IOV_POOL_SIZE,
+            "pool exhausted: nothing taken");
+      continue;
+    }
+    check(st == iovOk, "random transfer built");
+    check(x.bytes == IOV_Length(iov, n), "transfer length");
+    check(run(&pool, &x) == x.units, "transfer count matches");
+
+    for (i = 0, off = 0; i < n; off += iov[i].len, i++) {
+      if (gather) {
+        memcpy((uint8_t *)ref(mem) + off, ref(iov[i].base), iov[i].len);
+      } else {
+        memcpy(ref(iov[i].base), (uint8_t *)ref(mem) + off, iov[i].len);
+      }
+    }
+    if (memcmp(dmaMem, refMem, ARENA) != 0) {
+      printf("%s of %d buffers:", gather ? "gather" : "scatter", n);
+      for (k = 0; k < n; k++) {
+        printf(" %u+%lu", (unsigned)((uint8_t *)iov[k].base - dmaMem),
+               (unsigned long)iov[k].len);
+      }
+      printf("\n");
+      check(0, "random transfer matches memcpy");
+    }
+    IOV_Release(&pool, &x);
+    check(pool.available == IOV_POOL_SIZE, "all descriptors returned");
+    ok++;
+  }
+}
+
+static void testWidths(void)
+{
+  static uint32_t words[4096];
+  uint8_t *b = (uint8_t *)words;
+  IOV_Pool_TypeDef pool;
+  IOV_Xfer_TypeDef x;
+  IOV_Vec_TypeDef adj[3] = {
+    { b + 0, 16 }, { b + 16, 8 }, { b + 24, 40 }
+  };
+  IOV_Vec_TypeDef one[1];
+
+  IOV_PoolInit(&pool);
+  IOV_XferInit(&x);
+
+  // Adjacent buffers merge; aligned ends give words
+  check(IOV_Gather(&pool, &x, b + 4096, adj, 3) == iovOk, "adjacent");
+  check(x.segments == 1 && x.count == 1 && x.units == 16,
+        "adjacent: one run of words");
+
+  // Same misalignment on both sides: byte head, words, byte tail
+  one[0].base = b + 1;
+  one[0].len = 64;
+  check(IOV_Gather(&pool, &x, b + 4097, one, 1) == iovOk, "misaligned");
+  check(x.count == 3 && x.units == 3 + 15 + 1, "misaligned: split");
+  check(pool.desc[pool.link[x.first]].unit == 4, "misaligned: words inside");
+
+  // Too short to be worth splitting
+  one[0].len = 9;
+  check(IOV_Gather(&pool, &x, b + 4097, one, 1) == iovOk, "short");
+  check(x.count == 1 && x.units == 9, "short: one run of bytes");
+
+  // Halfword-aligned to each other
+  one[0].base = b + 2;
+  one[0].len = 64;
+  check(IOV_Gather(&pool, &x, b + 4100, one, 1) == iovOk, "halfword pair");
+  check(x.count == 1 && x.units == 32, "halfword pair: halfwords");
+  one[0].base = b + 1;
+  check(IOV_Gather(&pool, &x, b + 4099, one, 1) == iovOk, "odd halfwords");
+  check(x.count == 3 && x.units == 1 + 31 + 1, "odd halfwords: split");
+
+  // Never aligned to each other: bytes
+  one[0].base = b + 1;
+  check(IOV_Gather(&pool, &x, b + 4096, one, 1) == iovOk, "bytes");
+  check(x.count == 1 && x.units == 64, "bytes: one run");
+
+  // Longer than one LDMA transfer
+  one[0].base = b + 1;
+  one[0].len = 5000;
+  check(IOV_Scatter(&pool, &x, b + 8192, one, 1) == iovOk, "long");
+  check(x.count == 3 && x.units == 5000, "long: split at 2048 units");
+  check(pool.available == IOV_POOL_SIZE - 3, "long: pool use");
+  IOV_Release(&pool, &x);
+}
+
+static void testPool(void)
+{
+  static uint8_t buf[1024];
+  IOV_Pool_TypeDef pool;
+  IOV_Xfer_TypeDef a, b, c;
+  IOV_Vec_TypeDef iov[IOV_POOL_SIZE];
+  int i;
+
+  IOV_PoolInit(&pool);
+  IOV_XferInit(&a);
+  IOV_XferInit(&b);
+  IOV_XferInit(&c);
+
+  // Every other byte: one descriptor per buffer
+  for (i = 0; i < IOV_POOL_SIZE; i++) {
+    iov[i].base = buf + 2 * i;
+    iov[i].len = 1;
+  }
+  check(IOV_Gather(&pool, &a, buf + 512, iov, 20) == iovOk, "first of two");
+  check(IOV_Gather(&pool, &b, buf + 600, iov, 12) == iovOk, "second of two");
+  check(pool.available == 0 && pool.lowWater == 0, "pool used up");
+  check(IOV_Gather(&pool, &c, buf + 700, iov, 1) == iovErrPool,
+        "empty pool refused");
+
+  // Freed descriptors come back in a different order
+  IOV_Release(&pool, &a);
+  check(IOV_Gather(&pool, &c, buf + 700, iov, 20) == iovOk,
+        "reuse released descriptors");
+  memset(buf + 700, 0, 20);
+  for (i = 0; i < 20; i++) {
+    buf[2 * i] = (uint8_t)(i + 1);
+  }
+  run(&pool, &c);
+  for (i = 0; i < 20; i++) {
+    check(buf[700 + i] == i + 1, "reused chain order");
+  }
+  IOV_Release(&pool, &b);
+  IOV_Release(&pool, &c);
+  check(pool.available == IOV_POOL_SIZE, "all returned");
+
+  // A chain that does not fit takes nothing
+  check(IOV_Gather(&pool, &a, buf + 512, iov, IOV_POOL_SIZE) == iovOk,
+        "whole pool");
+  IOV_Release(&pool, &a);
+  check(IOV_Gather(&pool, &b, buf + 512, iov, 4) == iovOk, "some");
+  check(IOV_Gather(&pool, &a, buf + 512, iov, IOV_POOL_SIZE) == iovErrPool
+        && pool.available == IOV_POOL_SIZE - 4, "too big: nothing taken");
+
+  // Errors
+  check(IOV_Gather(&pool, &a, NULL, iov, 1) == iovErrParam, "no memory");
+  check(IOV_Gather(&pool, &a, buf, iov, 0) == iovErrParam, "no buffers");
+  b.busy = true;
+  check(IOV_Gather(&pool, &b, buf, iov, 1) == iovErrBusy, "busy");
+}
+
+static void benchmark(void)
+{
+  static uint8_t header[8], payload[128], trailer[4], frame[256];
+  IOV_Pool_TypeDef pool;
+  IOV_Xfer_TypeDef x;
+  IOV_Vec_TypeDef iov[3] = {
+    { header, 6 }, { payload + 1, 100 }, { trailer, 2 }
+  };
+  uint32_t n = 2000000, i, sum = 0;
+  clock_t start;
+  double build, copy;
+
+  IOV_PoolInit(&pool);
+  IOV_XferInit(&x);
+
+  start = clock();
+  for (i = 0; i < n; i++) {
+    payload[1] = (uint8_t)i;
+    IOV_Gather(&pool, &x, frame + (i & 1), iov, 3);
+    sum += x.units;
+  }
+  build = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for (i = 0; i < n; i++) {
+    uint8_t *p = frame + (i & 1);
+
+    payload[1] = (uint8_t)i;
+    memcpy(p, iov[0].base, iov[0].len);
+    memcpy(p + 6, iov[1].base, iov[1].len);
+    memcpy(p + 106, iov[2].base, iov[2].len);
+    sum += frame[7];
+  }
+  copy = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  check(sum != 0, "benchmark ran");
+  IOV_Gather(&pool, &x, frame, iov, 3);
+  printf("108-byte packet from 3 buffers: %u descriptors, %lu LDMA transfers\n",
+         x.count, (unsigned long)x.units);
+  printf("chain build: %.1f ns, memcpy: %.1f ns on this host\n",
+         build * 1e9 / n, copy * 1e9 / n);
+}
+
+int main(void)
+{
+  srand(1);
+  testWidths();
+  testPool();
+  testRandom();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
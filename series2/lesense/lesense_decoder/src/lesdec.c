@@ -0,0 +1,126 @@
+/***************************************************************************//**
+ * @file lesdec.c
+ * @brief Loads and models LESENSE decoder tables generated by lesdec.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "lesdec.h"
+
+#if !defined(LESDEC_HOST)
+#include "em_device.h"
+#include "em_lesense.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Program the decoder arcs of a generated table and enter its initial
+ *   state.
+ *
+ * @note
+ *   Call this while LESENSE is initialized but before the scan is started.
+ *   Arcs beyond the table keep their LESENSE_DECODER_CONF_DEFAULT settings.
+ *****************************************************************************/
+void LESDEC_Load(const LESDEC_Table_TypeDef *table)
+{
+  // Decoder PRS actions indexed by the PRS2..PRS0 output mask
+  static const LESENSE_StTransAct_TypeDef prsAct[8] = {
+    lesenseTransActNone,  lesenseTransActPRS0,
+    lesenseTransActPRS1,  lesenseTransActPRS01,
+    lesenseTransActPRS2,  lesenseTransActPRS02,
+    lesenseTransActPRS12, lesenseTransActPRS012
+  };
+  LESENSE_DecStAll_TypeDef decStAll = LESENSE_DECODER_CONF_DEFAULT;
+  size_t maxArcs = sizeof(decStAll.St) / sizeof(decStAll.St[0]);
+  size_t i;
+
+  for (i = 0; i < table->arcCount && i < maxArcs; i++) {
+    const LESDEC_Arc_TypeDef *arc = &table->arcs[i];
+
+    decStAll.St[i].curState  = arc->curState;
+    decStAll.St[i].nextState = arc->nextState;
+    decStAll.St[i].compMask  = arc->compMask;
+    decStAll.St[i].compVal   = arc->compVal;
+    decStAll.St[i].prsAct    = prsAct[arc->prsMask & 0x7];
+    decStAll.St[i].setInt    = arc->setInt;
+  }
+
+  LESENSE_DecoderStateAllConfig(&decStAll);
+  LESENSE_DecoderStateSet(table->initialState);
+}
+#endif
+
+/**************************************************************************//**
+ * @brief
+ *   Advance the decoder model by one scan.
+ *
+ * @details
+ *   Like the LESENSE decoder, the arcs leaving the current state are compared
+ *   against the sensor state in table order and the first match is taken.
+ *   Without a match the decoder stays where it is and nothing is signalled.
+ *
+ * @param[in] sensorState
+ *   Scan result shifted into the decoder, bit n = channel n.
+ *
+ * @param[out] event
+ *   Optional; receives the interrupt and PRS activity of this step.
+ *
+ * @return
+ *   The decoder state after the scan.
+ *****************************************************************************/
+uint32_t LESDEC_Step(const LESDEC_Table_TypeDef *table,
+                     uint32_t state,
+                     uint32_t sensorState,
+                     LESDEC_Event_TypeDef *event)
+{
+  size_t i;
+
+  if (event != NULL) {
+    event->matched = false;
+    event->interrupt = false;
+    event->prsMask = 0;
+  }
+
+  for (i = 0; i < table->arcCount; i++) {
+    const LESDEC_Arc_TypeDef *arc = &table->arcs[i];
+    uint32_t care = ~(uint32_t)arc->compMask & ((1u << LESDEC_SENSOR_BITS) - 1);
+
+    if (arc->curState == state
+        && (sensorState & care) == (arc->compVal & care)) {
+      if (event != NULL) {
+        event->matched = true;
+        event->interrupt = arc->setInt;
+        event->prsMask = arc->prsMask;
+      }
+      return arc->nextState;
+    }
+  }
+  return state;
+}
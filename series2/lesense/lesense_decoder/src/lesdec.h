@@ -0,0 +1,87 @@
+/***************************************************************************//**
+ * @file lesdec.h
+ * @brief LESENSE decoder transition tables and table-driven decoder model.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef LESDEC_H
+#define LESDEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of sensor state bits compared by the decoder
+#define LESDEC_SENSOR_BITS    4
+
+/// One decoder arc (transition), as generated by tools/lesdec.c
+typedef struct {
+  uint8_t curState;   ///< State the arc leaves
+  uint8_t nextState;  ///< State the arc enters
+  uint8_t compMask;   ///< Sensor bits to ignore (1 = don't care)
+  uint8_t compVal;    ///< Sensor value to match on the other bits
+  uint8_t prsMask;    ///< Decoder PRS outputs pulsed (bit n = PRS n)
+  bool    setInt;     ///< Raise the DEC interrupt when the arc is taken
+} LESDEC_Arc_TypeDef;
+
+/// A generated decoder table. Arcs are matched in table order.
+typedef struct {
+  const LESDEC_Arc_TypeDef *arcs;
+  size_t                    arcCount;
+  uint8_t                   initialState;
+} LESDEC_Table_TypeDef;
+
+/// What one decoder step did
+typedef struct {
+  bool    matched;    ///< An arc matched the sensor state
+  bool    interrupt;  ///< The matching arc raises the DEC interrupt
+  uint8_t prsMask;    ///< PRS outputs pulsed by the matching arc
+} LESDEC_Event_TypeDef;
+
+#if !defined(LESDEC_HOST)
+void LESDEC_Load(const LESDEC_Table_TypeDef *table);
+#endif
+
+uint32_t LESDEC_Step(const LESDEC_Table_TypeDef *table,
+                     uint32_t state,
+                     uint32_t sensorState,
+                     LESDEC_Event_TypeDef *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LESDEC_H
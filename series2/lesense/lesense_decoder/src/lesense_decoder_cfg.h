@@ -0,0 +1,38 @@
+/* Generated by lesdec from lesense_decoder.sm. Do not edit. */
+
+#ifndef LESENSE_DECODER_CFG_H
+#define LESENSE_DECODER_CFG_H
+
+#include "lesdec.h"
+
+#define LESDEC_STATE_NO_TURN            0
+#define LESDEC_STATE_LEFT_TURN          1
+#define LESDEC_STATE_RIGHT_TURN         2
+#define LESDEC_STATE_BOTH_TURN          3
+
+static const LESDEC_Arc_TypeDef lesdecArcs[] = {
+  // cur next  mask   val    prs  irq
+  {  0,  0, 0xC, 0x0, 0x0, false }, // NO_TURN -> NO_TURN on 00
+  {  0,  1, 0xC, 0x1, 0x0, true  }, // NO_TURN -> LEFT_TURN on 01
+  {  0,  2, 0xC, 0x2, 0x0, true  }, // NO_TURN -> RIGHT_TURN on 10
+  {  0,  3, 0xC, 0x3, 0x0, true  }, // NO_TURN -> BOTH_TURN on 11
+  {  1,  0, 0xC, 0x0, 0x0, true  }, // LEFT_TURN -> NO_TURN on 00
+  {  1,  1, 0xC, 0x1, 0x0, false }, // LEFT_TURN -> LEFT_TURN on 01
+  {  1,  2, 0xC, 0x2, 0x0, true  }, // LEFT_TURN -> RIGHT_TURN on 10
+  {  1,  3, 0xC, 0x3, 0x0, true  }, // LEFT_TURN -> BOTH_TURN on 11
+  {  3,  3, 0xC, 0x3, 0x0, false }, // BOTH_TURN -> BOTH_TURN on 11
+  {  3,  1, 0xC, 0x1, 0x0, true  }, // BOTH_TURN -> LEFT_TURN on 01
+  {  3,  2, 0xC, 0x2, 0x0, true  }, // BOTH_TURN -> RIGHT_TURN on 10
+  {  3,  0, 0xC, 0x0, 0x0, true  }, // BOTH_TURN -> NO_TURN on 00
+  {  2,  0, 0xC, 0x0, 0x0, true  }, // RIGHT_TURN -> NO_TURN on 00
+  {  2,  1, 0xC, 0x1, 0x0, true  }, // RIGHT_TURN -> LEFT_TURN on 01
+  {  2,  2, 0xC, 0x2, 0x0, false }, // RIGHT_TURN -> RIGHT_TURN on 10
+  {  2,  3, 0xC, 0x3, 0x0, true  }, // RIGHT_TURN -> BOTH_TURN on 11
+};
+
+static const LESDEC_Table_TypeDef lesdecTable = {
+  lesdecArcs, sizeof(lesdecArcs) / sizeof(lesdecArcs[0]),
+  LESDEC_STATE_NO_TURN
+};
+
+#endif // LESENSE_DECODER_CFG_H
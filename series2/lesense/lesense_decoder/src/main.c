@@ -47,16 +47,18 @@
 #include "bspconfig.h"
 #include "bsp.h"
 #include "mx25flash_spi.h"
+#include "lesdec.h"
+#include "lesense_decoder_cfg.h"
 
 #define PD01REGNORETAIN   0  // EM0/1 peripheral register retention
 #define EM2_DEBUG         1  // EM2 debug enable
 #define SCAN_FREQ         8  // 8 Hz
 #define STATE_LED         1  // state transition LED demo, turn off to view
                              // state transition current consumption
-#define NO_TURN           0
-#define LEFT_TURN         1
-#define RIGHT_TURN        2
-#define BOTH_TURN         3
+#define NO_TURN           LESDEC_STATE_NO_TURN
+#define LEFT_TURN         LESDEC_STATE_LEFT_TURN
+#define RIGHT_TURN        LESDEC_STATE_RIGHT_TURN
+#define BOTH_TURN         LESDEC_STATE_BOTH_TURN
 
 // Determine the BBUSALLOC to allocate to ACMP0
 #if (BSP_GPIO_PB0_PIN % 2 == 0 && BSP_GPIO_PB1_PIN % 2 == 0)
@@ -200,105 +202,11 @@ void initLESENSE(void)
   /****************************************************************************
     * @description: Configure LESENSE decoder states
     * There are a total of 2 push buttons to be scanned so a total of four
-    * states are needed. The initial starting state is state 0, and state
-    * transition will happen when the compare value matches with the sensorState
-    * result on the non-masked channel.
+    * states are needed. The arcs are generated from decoder/lesense_decoder.sm
+    * by tools/lesdec.c; edit the state machine there and regenerate
+    * lesense_decoder_cfg.h rather than changing the table by hand.
     ***************************************************************************/
-  LESENSE_DecStAll_TypeDef initStAll = LESENSE_DECODER_CONF_DEFAULT;
-
-  initStAll.St[0].curState  = 0;     // state 0 = no_turn
-  initStAll.St[0].nextState = 0;     // Set next state to itself
-  initStAll.St[0].compMask  = 0xC;   // enable both channels
-  initStAll.St[0].compVal   = 0x00;  // no button pressed
-
-  initStAll.St[1].curState  = 0;     // state 0 = no_turn
-  initStAll.St[1].nextState = 1;     // Set next state to 1 = left_turn
-  initStAll.St[1].compMask  = 0xC;   // enable both channels
-  initStAll.St[1].compVal   = 0x01;  // compare match on PB0 detect
-  initStAll.St[1].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[2].curState  = 0;     // state 0 = no_turn
-  initStAll.St[2].nextState = 2;     // Set next state to 2 = right_turn
-  initStAll.St[2].compMask  = 0xC;   // enable both channels
-  initStAll.St[2].compVal   = 0x02;  // compare match on PB1 detect
-  initStAll.St[2].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[3].curState  = 0;     // state 0 = no_turn
-  initStAll.St[3].nextState = 3;     // Set next state to 3 = both_turn
-  initStAll.St[3].compMask  = 0xC;   // enable both channels
-  initStAll.St[3].compVal   = 0x03;  // compare match on both buttons
-  initStAll.St[3].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[4].curState  = 1;     // state 1 = left_turn
-  initStAll.St[4].nextState = 0;     // Set next state to state 0 = no_turn
-  initStAll.St[4].compMask  = 0xC;   // enable both channels
-  initStAll.St[4].compVal   = 0x00;  // if no press, go back to state 0
-  initStAll.St[4].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[5].curState  = 1;     // state 1 = left_turn
-  initStAll.St[5].nextState = 1;     // Set next state to itself
-  initStAll.St[5].compMask  = 0xC;   // enable both channels
-  initStAll.St[5].compVal   = 0x01;  // compare match on PB0
-
-  initStAll.St[6].curState  = 1;     // state 1 = left_turn
-  initStAll.St[6].nextState = 2;     // Set next state to state 2 = right_turn
-  initStAll.St[6].compMask  = 0xC;   // enable both channels
-  initStAll.St[6].compVal   = 0x02;  // compare match on PB1
-  initStAll.St[6].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[7].curState  = 1;     // state 1 = left_turn
-  initStAll.St[7].nextState = 3;     // Set next state to state 3 = both_turn
-  initStAll.St[7].compMask  = 0xC;   // enable both channels
-  initStAll.St[7].compVal   = 0x03;  // compare match on both channel
-  initStAll.St[7].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[8].curState  = 3;     // state 3 = both_turn
-  initStAll.St[8].nextState = 3;     // Set next state to itself
-  initStAll.St[8].compMask  = 0xC;   // enable both channels
-  initStAll.St[8].compVal   = 0x03;  // if both pressed, stay in state 3
-
-  initStAll.St[9].curState  = 3;     // state 3 = both_turn
-  initStAll.St[9].nextState = 1;     // Set next state to state 1 = left_turn
-  initStAll.St[9].compMask  = 0xC;   // enable both channels
-  initStAll.St[9].compVal   = 0x01;  // compare match on PB0
-  initStAll.St[9].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[10].curState  = 3;     // state 3 = both_turn
-  initStAll.St[10].nextState = 2;     // Set next state to state 2 = right_turn
-  initStAll.St[10].compMask  = 0xC;   // enable both channels
-  initStAll.St[10].compVal   = 0x02;  // compare match on PB1
-  initStAll.St[10].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[11].curState  = 3;     // state 3 = both_turn
-  initStAll.St[11].nextState = 0;     // Set next state to state 0 = no_turn
-  initStAll.St[11].compMask  = 0xC;   // enable both channels
-  initStAll.St[11].compVal   = 0x00;  // if none pressed, go to state 0
-  initStAll.St[11].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[12].curState  = 2;     // state 2 = right_turn
-  initStAll.St[12].nextState = 0;     // Set next state to state 0 = no_turn
-  initStAll.St[12].compMask  = 0xC;   // enable both channels
-  initStAll.St[12].compVal   = 0x00;  // if none pressed, go to state 0
-  initStAll.St[12].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[13].curState  = 2;     // state 2 = right_turn
-  initStAll.St[13].nextState = 1;     // Set next state to state 1 = left_turn
-  initStAll.St[13].compMask  = 0xC;   // enable both channels
-  initStAll.St[13].compVal   = 0x01;  // compare match on PB0
-  initStAll.St[13].setInt    = true;  // enable interrupt upon match
-
-  initStAll.St[14].curState  = 2;     // state 2 = right_turn
-  initStAll.St[14].nextState = 2;     // Set next state to itself
-  initStAll.St[14].compMask  = 0xC;   // enable both channels
-  initStAll.St[14].compVal   = 0x02;  // compare match on PB1
-
-  initStAll.St[15].curState  = 2;     // state 2 = right_turn
-  initStAll.St[15].nextState = 3;     // Set next state to state 3 = both_turn
-  initStAll.St[15].compMask  = 0xC;   // enable both channels
-  initStAll.St[15].compVal   = 0x03;  // compare match on both buttons
-  initStAll.St[15].setInt    = true;  // enable interrupt upon match
-
-  LESENSE_DecoderStateAllConfig(&initStAll); // Initialize decoder
+  LESDEC_Load(&lesdecTable);
 
   // Configure channel 0 and channel 1
   LESENSE_ChannelConfig(&initLesenseCh, 0);
@@ -0,0 +1,546 @@
+/***************************************************************************//**
+ * @file lesdec.c
+ * @brief Host tool that generates LESENSE decoder tables from a state
+ * transition description and replays sensor scan vectors through them.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+/*
+ * Build (from this directory):
+ *   gcc -std=c99 -DLESDEC_HOST -I../src -o lesdec lesdec.c ../src/lesdec.c
+ *
+ * Usage:
+ *   lesdec compile [-n maxArcs] [-o out.h] machine.sm
+ *   lesdec sim     [-v] machine.sm scans.vec
+ *
+ * State machine statements (one per line, '#' starts a comment):
+ *   sensors N                       number of channels in the sensor state
+ *   state NAME [VALUE]              decoder state, numbered in order by default
+ *   initial NAME                    state entered when the table is loaded
+ *   arc FROM -> TO PATTERN [irq] [prs0] [prs1] [prs2]
+ *
+ * PATTERN gives one character per sensor, most significant channel first:
+ * '1' and '0' must match, 'x' is don't care. "10" means channel 1 high and
+ * channel 0 low.
+ *
+ * Scan vector lines hold one recorded sensor state in the same notation,
+ * optionally repeated ("01*20") and optionally followed by the expected
+ * decoder state after the scan (": LEFT_TURN").
+ ******************************************************************************/
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lesdec.h"
+
+#define MAX_STATES   32
+#define MAX_ARCS     64
+#define NAME_LEN     32
+#define NONE         (-1)
+
+typedef struct {
+  char name[NAME_LEN];
+  int  value;
+} State_t;
+
+static State_t states[MAX_STATES];
+static int stateCount;
+static LESDEC_Arc_TypeDef arcs[MAX_ARCS];
+static int arcLine[MAX_ARCS];
+static int arcCount;
+static int sensorCount = NONE;
+static int initialState = NONE;
+static int maxArcs = 32;
+
+static const char *fileName;
+static int lineNumber;
+
+/***************************************************************************//**
+ * @brief Report an error with its location and exit.
+ ******************************************************************************/
+static void fail(const char *fmt, ...)
+{
+  va_list ap;
+
+  if (lineNumber > 0) {
+    fprintf(stderr, "%s:%d: ", fileName, lineNumber);
+  } else {
+    fprintf(stderr, "%s: ", fileName);
+  }
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+  exit(2);
+}
+
+static void warn(int line, const char *fmt, ...)
+{
+  va_list ap;
+
+  fprintf(stderr, "%s:%d: warning: ", fileName, line);
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+}
+
+static int findState(const char *name)
+{
+  int i;
+
+  for (i = 0; i < stateCount; i++) {
+    if (strcmp(states[i].name, name) == 0) {
+      return i;
+    }
+  }
+  fail("unknown state '%s'", name);
+  return NONE;
+}
+
+static const char *stateName(int value)
+{
+  int i;
+
+  for (i = 0; i < stateCount; i++) {
+    if (states[i].value == value) {
+      return states[i].name;
+    }
+  }
+  return "?";
+}
+
+/***************************************************************************//**
+ * @brief Parse a sensor pattern into a compare value and don't-care mask.
+ ******************************************************************************/
+static void parsePattern(const char *text, uint8_t *val, uint8_t *mask)
+{
+  int n = (int)strlen(text);
+  int i;
+
+  if (sensorCount == NONE) {
+    fail("'sensors' must come before the first pattern");
+  }
+  if (n != sensorCount) {
+    fail("pattern '%s' must have %d characters", text, sensorCount);
+  }
+  // Channels outside the sensor state are never compared
+  *val = 0;
+  *mask = (uint8_t)(((1u << LESDEC_SENSOR_BITS) - 1) & ~((1u << n) - 1));
+  for (i = 0; i < n; i++) {
+    unsigned bit = 1u << (n - 1 - i);
+
+    if (text[i] == '1') {
+      *val |= (uint8_t)bit;
+    } else if (text[i] == 'x' || text[i] == 'X') {
+      *mask |= (uint8_t)bit;
+    } else if (text[i] != '0') {
+      fail("bad pattern character '%c'", text[i]);
+    }
+  }
+}
+
+static void formatPattern(char *out, uint8_t val, uint8_t mask)
+{
+  int i;
+
+  for (i = 0; i < sensorCount; i++) {
+    unsigned bit = 1u << (sensorCount - 1 - i);
+
+    out[i] = (mask & bit) ? 'x' : (val & bit) ? '1' : '0';
+  }
+  out[sensorCount] = '\0';
+}
+
+/*******************************************************************************
+ ****************************   State machine reader   *************************
+ ******************************************************************************/
+
+static void readMachine(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  char line[256];
+
+  fileName = path;
+  if (f == NULL) {
+    fail("cannot open state machine");
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char *tok[12];
+    char *hash = strchr(line, '#');
+    int n = 0;
+
+    lineNumber++;
+    if (hash != NULL) {
+      *hash = '\0';
+    }
+    for (tok[0] = strtok(line, " \t\r\n"); tok[n] != NULL && n < 11;
+         tok[++n] = strtok(NULL, " \t\r\n")) {
+    }
+    if (n == 0) {
+      continue;
+    }
+
+    if (strcmp(tok[0], "sensors") == 0 && n == 2) {
+      sensorCount = atoi(tok[1]);
+      if (sensorCount < 1 || sensorCount > LESDEC_SENSOR_BITS) {
+        fail("sensors must be 1..%d", LESDEC_SENSOR_BITS);
+      }
+    } else if (strcmp(tok[0], "state") == 0 && (n == 2 || n == 3)) {
+      State_t *s;
+      int i;
+
+      if (stateCount == MAX_STATES) {
+        fail("too many states");
+      }
+      s = &states[stateCount];
+      snprintf(s->name, sizeof(s->name), "%s", tok[1]);
+      s->value = n == 3 ? atoi(tok[2]) : stateCount;
+      if (s->value < 0 || s->value >= MAX_STATES) {
+        fail("state value must be 0..%d", MAX_STATES - 1);
+      }
+      for (i = 0; i < stateCount; i++) {
+        if (strcmp(states[i].name, s->name) == 0 || states[i].value == s->value) {
+          fail("state '%s' duplicates '%s'", s->name, states[i].name);
+        }
+      }
+      stateCount++;
+    } else if (strcmp(tok[0], "initial") == 0 && n == 2) {
+      initialState = states[findState(tok[1])].value;
+    } else if (strcmp(tok[0], "arc") == 0 && n >= 5 && strcmp(tok[2], "->") == 0) {
+      LESDEC_Arc_TypeDef *arc;
+      int i;
+
+      if (arcCount == MAX_ARCS) {
+        fail("too many arcs");
+      }
+      arc = &arcs[arcCount];
+      memset(arc, 0, sizeof(*arc));
+      arc->curState = (uint8_t)states[findState(tok[1])].value;
+      arc->nextState = (uint8_t)states[findState(tok[3])].value;
+      parsePattern(tok[4], &arc->compVal, &arc->compMask);
+      for (i = 5; i < n; i++) {
+        if (strcmp(tok[i], "irq") == 0) {
+          arc->setInt = true;
+        } else if (strncmp(tok[i], "prs", 3) == 0 && tok[i][3] >= '0'
+                   && tok[i][3] <= '2' && tok[i][4] == '\0') {
+          arc->prsMask |= (uint8_t)(1u << (tok[i][3] - '0'));
+        } else {
+          fail("unknown arc action '%s'", tok[i]);
+        }
+      }
+      arcLine[arcCount++] = lineNumber;
+    } else {
+      fail("cannot parse statement '%s'", tok[0]);
+    }
+  }
+  fclose(f);
+  lineNumber = 0;
+
+  if (stateCount == 0 || arcCount == 0) {
+    fail("no states or arcs defined");
+  }
+  if (initialState == NONE) {
+    initialState = states[0].value;
+  }
+}
+
+/***************************************************************************//**
+ * @brief Check the table for hardware limits and likely authoring errors.
+ ******************************************************************************/
+static void checkMachine(void)
+{
+  int reached[MAX_STATES] = { 0 };
+  int changed = 1;
+  int i, j;
+
+  if (arcCount > maxArcs) {
+    fail("%d arcs exceed the decoder's %d", arcCount, maxArcs);
+  }
+
+  // An arc shadowed by an earlier arc of the same state can never be taken
+  for (i = 0; i < arcCount; i++) {
+    for (j = 0; j < i; j++) {
+      const LESDEC_Arc_TypeDef *a = &arcs[j];
+      const LESDEC_Arc_TypeDef *b = &arcs[i];
+      uint8_t care = (uint8_t)~a->compMask;
+
+      if (a->curState == b->curState
+          && (b->compMask & care) == 0
+          && (b->compVal & care) == (a->compVal & care)) {
+        warn(arcLine[i], "arc is shadowed by the arc on line %d", arcLine[j]);
+      }
+    }
+  }
+
+  reached[initialState] = 1;
+  while (changed) {
+    changed = 0;
+    for (i = 0; i < arcCount; i++) {
+      if (reached[arcs[i].curState] && !reached[arcs[i].nextState]) {
+        reached[arcs[i].nextState] = 1;
+        changed = 1;
+      }
+    }
+  }
+  for (i = 0; i < stateCount; i++) {
+    if (!reached[states[i].value]) {
+      fprintf(stderr, "%s: warning: state '%s' is unreachable\n", fileName,
+              states[i].name);
+    }
+  }
+}
+
+/*******************************************************************************
+ ********************************   Generator   ********************************
+ ******************************************************************************/
+
+static void emitHeader(FILE *out, const char *machine, const char *outName)
+{
+  const char *base = strrchr(outName, '/');
+  const char *source = strrchr(machine, '/');
+  char guard[64];
+  char pattern[LESDEC_SENSOR_BITS + 1];
+  size_t n;
+  int i;
+
+  base = base != NULL ? base + 1 : outName;
+  source = source != NULL ? source + 1 : machine;
+  for (n = 0; base[n] != '\0' && n < sizeof(guard) - 1; n++) {
+    guard[n] = isalnum((unsigned char)base[n])
+               ? (char)toupper((unsigned char)base[n]) : '_';
+  }
+  guard[n] = '\0';
+
+  fprintf(out, "/* Generated by lesdec from %s. Do not edit. */\n\n", source);
+  fprintf(out, "#ifndef %s\n#define %s\n\n#include \"lesdec.h\"\n\n", guard, guard);
+  for (i = 0; i < stateCount; i++) {
+    fprintf(out, "#define LESDEC_STATE_%-18s %d\n", states[i].name,
+            states[i].value);
+  }
+
+  fprintf(out, "\nstatic const LESDEC_Arc_TypeDef lesdecArcs[] = {\n");
+  fprintf(out, "  // cur next  mask   val    prs  irq\n");
+  for (i = 0; i < arcCount; i++) {
+    const LESDEC_Arc_TypeDef *a = &arcs[i];
+
+    formatPattern(pattern, a->compVal, a->compMask);
+    fprintf(out, "  { %2u, %2u, 0x%X, 0x%X, 0x%X, %-5s }, // %s -> %s on %s\n",
+            a->curState, a->nextState, a->compMask, a->compVal, a->prsMask,
+            a->setInt ? "true" : "false", stateName(a->curState),
+            stateName(a->nextState), pattern);
+  }
+  fprintf(out, "};\n\n");
+  fprintf(out, "static const LESDEC_Table_TypeDef lesdecTable = {\n");
+  fprintf(out, "  lesdecArcs, sizeof(lesdecArcs) / sizeof(lesdecArcs[0]),\n");
+  fprintf(out, "  LESDEC_STATE_%s\n};\n\n", stateName(initialState));
+  fprintf(out, "#endif // %s\n", guard);
+}
+
+/*******************************************************************************
+ ********************************   Simulator   ********************************
+ ******************************************************************************/
+
+static int simulate(const char *vectorPath, int verbose)
+{
+  LESDEC_Table_TypeDef table = { arcs, 0, 0 };
+  unsigned long scansIn[MAX_STATES] = { 0 };
+  unsigned long scans = 0;
+  unsigned long transitions = 0;
+  unsigned long interrupts = 0;
+  unsigned long prsPulses[3] = { 0 };
+  uint32_t state;
+  char line[256];
+  FILE *f;
+  int failures = 0;
+  int i;
+
+  table.arcCount = (size_t)arcCount;
+  table.initialState = (uint8_t)initialState;
+  state = table.initialState;
+
+  fileName = vectorPath;
+  f = fopen(vectorPath, "r");
+  if (f == NULL) {
+    fail("cannot open scan vectors");
+  }
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char *colon;
+    char *star;
+    char *pattern;
+    char *expect = NULL;
+    uint8_t val;
+    uint8_t mask;
+    long repeat = 1;
+
+    lineNumber++;
+    if ((colon = strchr(line, '#')) != NULL) {
+      *colon = '\0';
+    }
+    if ((colon = strchr(line, ':')) != NULL) {
+      *colon = '\0';
+      expect = strtok(colon + 1, " \t\r\n");
+    }
+    pattern = strtok(line, " \t\r\n");
+    if (pattern == NULL) {
+      continue;
+    }
+    if ((star = strchr(pattern, '*')) != NULL) {
+      *star = '\0';
+      repeat = strtol(star + 1, NULL, 10);
+    }
+    parsePattern(pattern, &val, &mask);
+    if (mask != (uint8_t)(((1u << LESDEC_SENSOR_BITS) - 1) & ~((1u << sensorCount) - 1))) {
+      fail("recorded scans cannot contain don't-care bits");
+    }
+
+    while (repeat-- > 0) {
+      LESDEC_Event_TypeDef ev;
+      uint32_t next = LESDEC_Step(&table, state, val, &ev);
+
+      scansIn[state]++;
+      scans++;
+      if (next != state) {
+        transitions++;
+      }
+      if (ev.interrupt) {
+        interrupts++;
+      }
+      for (i = 0; i < 3; i++) {
+        if (ev.prsMask & (1u << i)) {
+          prsPulses[i]++;
+        }
+      }
+      if (verbose || next != state || ev.interrupt || ev.prsMask != 0) {
+        printf("scan %6lu  %s  %-12s -> %-12s%s", scans, pattern,
+               stateName((int)state), stateName((int)next),
+               ev.interrupt ? "  IRQ" : "");
+        for (i = 0; i < 3; i++) {
+          if (ev.prsMask & (1u << i)) {
+            printf("  PRS%d", i);
+          }
+        }
+        printf("\n");
+      }
+      state = next;
+    }
+
+    if (expect != NULL && strcmp(expect, stateName((int)state)) != 0) {
+      printf("line %d: FAIL state %s, expected %s\n", lineNumber,
+             stateName((int)state), expect);
+      failures++;
+    }
+  }
+  fclose(f);
+
+  printf("\n%lu scans, %lu transitions, %lu interrupts", scans, transitions,
+         interrupts);
+  if (scans > 0) {
+    printf(" (%.2f%% of scans wake the CPU)", 100.0 * interrupts / scans);
+  }
+  printf("\nPRS pulses: PRS0 %lu, PRS1 %lu, PRS2 %lu\n", prsPulses[0],
+         prsPulses[1], prsPulses[2]);
+  for (i = 0; i < stateCount; i++) {
+    printf("  %-16s %lu scans\n", states[i].name, scansIn[states[i].value]);
+  }
+  printf("%d failures\n", failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*******************************************************************************
+ **********************************   Main   ***********************************
+ ******************************************************************************/
+
+static void usage(void)
+{
+  fprintf(stderr,
+          "usage: lesdec compile [-n maxArcs] [-o out.h] machine.sm\n"
+          "       lesdec sim     [-v] machine.sm scans.vec\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  const char *outName = NULL;
+  int verbose = 0;
+  int argi = 2;
+
+  if (argc < 3) {
+    usage();
+  }
+  while (argi < argc && argv[argi][0] == '-') {
+    if (strcmp(argv[argi], "-v") == 0) {
+      verbose = 1;
+      argi++;
+      continue;
+    }
+    if (argi + 1 >= argc) {
+      usage();
+    }
+    if (strcmp(argv[argi], "-n") == 0) {
+      maxArcs = atoi(argv[argi + 1]);
+    } else if (strcmp(argv[argi], "-o") == 0) {
+      outName = argv[argi + 1];
+    } else {
+      usage();
+    }
+    argi += 2;
+  }
+
+  if (strcmp(argv[1], "compile") == 0 && argi + 1 == argc) {
+    FILE *out = stdout;
+
+    readMachine(argv[argi]);
+    checkMachine();
+    if (outName != NULL && (out = fopen(outName, "w")) == NULL) {
+      perror(outName);
+      return 2;
+    }
+    emitHeader(out, argv[argi],
+               outName != NULL ? outName : "lesense_decoder_cfg.h");
+    if (out != stdout) {
+      fclose(out);
+    }
+    return 0;
+  }
+  if (strcmp(argv[1], "sim") == 0 && argi + 2 == argc) {
+    readMachine(argv[argi]);
+    checkMachine();
+    return simulate(argv[argi + 1], verbose);
+  }
+  usage();
+  return 2;
+}
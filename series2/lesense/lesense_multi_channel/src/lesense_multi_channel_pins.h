@@ -0,0 +1,83 @@
+/***************************************************************************//**
+ * @file lesense_multi_channel_pins.h
+ * @brief IADC inputs scanned by the LESENSE channels on each board supported
+ * by the example.  The table has no device dependencies, so
+ * tools/pins_check.c checks it on a PC.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef LESENSE_MULTI_CHANNEL_PINS_H
+#define LESENSE_MULTI_CHANNEL_PINS_H
+
+#include "bsp_route.h"
+
+/*
+ * LESENSE scans the IADC inputs in EM2, so they must be on port A or B.
+ * Channels 0 and 1 are on the push buttons, and channels 2 and 3 on the
+ * expansion header.
+ *
+ *                            CH0      CH1      CH2      CH3
+ */
+#define LESENSE_BOARD_XG23  ((B, 1), (B, 3), (A, 6), (A, 7))
+#define LESENSE_BOARD_XG25  ((B, 0), (B, 1), (A, 6), (A, 7))
+#define LESENSE_BOARD_XG28  ((B, 1), (B, 3), (B, 4), (B, 5))
+
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG)              \
+  && _SILICON_LABS_32B_SERIES_2_CONFIG != 3                 \
+  && _SILICON_LABS_32B_SERIES_2_CONFIG != 5                 \
+  && _SILICON_LABS_32B_SERIES_2_CONFIG != 8
+#error "No pins for this device in lesense_multi_channel_pins.h"
+#endif
+
+// Checks of a row: real, distinct EM2 pins
+#define LESENSE_PIN(n, dev)         BSP_COLUMN(n, LESENSE_BOARD_##dev)
+#define LESENSE_PIN_OK(n, dev) \
+  (BSP_PIN_VALID(LESENSE_PIN(n, dev)) && BSP_PIN_EM2(LESENSE_PIN(n, dev)))
+#define LESENSE_BOARD_CHECK(dev)                                              \
+  BSP_CHECK(lesense_##dev##_ch0_em2, LESENSE_PIN_OK(0, dev));                 \
+  BSP_CHECK(lesense_##dev##_ch1_em2, LESENSE_PIN_OK(1, dev));                 \
+  BSP_CHECK(lesense_##dev##_ch2_em2, LESENSE_PIN_OK(2, dev));                 \
+  BSP_CHECK(lesense_##dev##_ch3_em2, LESENSE_PIN_OK(3, dev));                 \
+  BSP_CHECK(lesense_##dev##_pins_differ,                                      \
+            BSP_PIN_DIFFERENT(LESENSE_PIN(0, dev), LESENSE_PIN(1, dev))       \
+            && BSP_PIN_DIFFERENT(LESENSE_PIN(0, dev), LESENSE_PIN(2, dev))    \
+            && BSP_PIN_DIFFERENT(LESENSE_PIN(0, dev), LESENSE_PIN(3, dev))    \
+            && BSP_PIN_DIFFERENT(LESENSE_PIN(1, dev), LESENSE_PIN(2, dev))    \
+            && BSP_PIN_DIFFERENT(LESENSE_PIN(1, dev), LESENSE_PIN(3, dev))    \
+            && BSP_PIN_DIFFERENT(LESENSE_PIN(2, dev), LESENSE_PIN(3, dev)))
+
+// Every row is checked in every build, whichever device it is for
+LESENSE_BOARD_CHECK(XG23);
+LESENSE_BOARD_CHECK(XG25);
+LESENSE_BOARD_CHECK(XG28);
+
+#endif // LESENSE_MULTI_CHANNEL_PINS_H
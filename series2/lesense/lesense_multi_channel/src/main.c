@@ -1,9 +1,10 @@
 /***************************************************************************//**
  * @file
- * @brief LESENSE multi channel demo for EFR32ZG28. This example uses LESENSE
- *        to scan four IADC scan channels in low energy mode. The LESENSE is
- *        configured to detect when each input signal crosses over a threshold
- *        and will trigger an interrupt to toggle an the LED.
+ * @brief LESENSE multi channel demo for EFR32xG23, xG25 and xG28. This
+ *        example uses LESENSE to scan four IADC scan channels in low energy
+ *        mode. The LESENSE is configured to detect when each input signal
+ *        crosses over a threshold and will trigger an interrupt to toggle an
+ *        the LED.
  *******************************************************************************
  * # License
  * <b>Copyright 2021 Silicon Laboratories Inc. www.silabs.com</b>
@@ -49,6 +50,7 @@
 #include "bspconfig.h"
 #include "bsp.h"
 #include "mx25flash_spi.h"
+#include "lesense_multi_channel_pins.h"
 
 #define PD01REGNORETAIN  1  // EM0/1 peripheral register retention
 #define EM2_DEBUG        0  // EM2 debug enable
@@ -72,32 +74,15 @@
 #define IADC_COMP_THRESH_LOWER    0x200
 
 /*
- * Specify the IADC input using the IADC_PosInput_t typedef.  This
- * must be paired with a corresponding macro definition that allocates
- * the corresponding ABUS to the IADC.  These are...
- *
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AEVEN0_ADC0
- * GPIO->ABUSALLOC |= GPIO_ABUSALLOC_AODD0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BEVEN0_ADC0
- * GPIO->BBUSALLOC |= GPIO_BBUSALLOC_BODD0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDEVEN0_ADC0
- * GPIO->CDBUSALLOC |= GPIO_CDBUSALLOC_CDODD0_ADC0
- *
- * ...for port A, port B, and port C/D pins, even and odd, respectively.
+ * The IADC inputs of LESENSE channels 0-3 are in the table in
+ * lesense_multi_channel_pins.h, with a row per board.  Each input's half
+ * of the ABUS, BBUS or CDBUS must be allocated to ADC0; BSP_BUSALLOC()
+ * picks it from the pin.
  */
-#define IADC_INPUT_0_PORT_PIN     iadcPosInputPortBPin1;
-#define IADC_INPUT_1_PORT_PIN     iadcPosInputPortBPin3;
-#define IADC_INPUT_2_PORT_PIN     iadcPosInputPortBPin4;
-#define IADC_INPUT_3_PORT_PIN     iadcPosInputPortBPin5;
-
-#define IADC_INPUT_0_BUS          BBUSALLOC
-#define IADC_INPUT_0_BUSALLOC     GPIO_BBUSALLOC_BODD0_ADC0
-#define IADC_INPUT_1_BUS          BBUSALLOC
-#define IADC_INPUT_1_BUSALLOC     GPIO_BBUSALLOC_BODD0_ADC0
-#define IADC_INPUT_2_BUS          BBUSALLOC
-#define IADC_INPUT_2_BUSALLOC     GPIO_BBUSALLOC_BEVEN0_ADC0
-#define IADC_INPUT_3_BUS          BBUSALLOC
-#define IADC_INPUT_3_BUSALLOC     GPIO_BBUSALLOC_BODD0_ADC0
+#define IADC_INPUT_0              BSP_COLUMN(0, BSP_BOARD(LESENSE_BOARD_))
+#define IADC_INPUT_1              BSP_COLUMN(1, BSP_BOARD(LESENSE_BOARD_))
+#define IADC_INPUT_2              BSP_COLUMN(2, BSP_BOARD(LESENSE_BOARD_))
+#define IADC_INPUT_3              BSP_COLUMN(3, BSP_BOARD(LESENSE_BOARD_))
 
 /***************************************************************************//**
  * @brief LESENSE interrupt handler
@@ -203,20 +188,20 @@ void initIADC (void)
   initScan.triggerSelect = iadcTriggerSelLesense;
 
   // Configure entries in scan table, CH0-3 are single-ended from inputs 0-3
-  // set by the defines at the beginning of this source
-  initScanTable.entries[0].posInput = IADC_INPUT_0_PORT_PIN;
+  // set by the board's row of the pin table
+  initScanTable.entries[0].posInput = BSP_IADC_INPUT(IADC_INPUT_0);
   initScanTable.entries[0].negInput = iadcNegInputGnd;
   initScanTable.entries[0].includeInScan = true;
 
-  initScanTable.entries[1].posInput = IADC_INPUT_1_PORT_PIN;
+  initScanTable.entries[1].posInput = BSP_IADC_INPUT(IADC_INPUT_1);
   initScanTable.entries[1].negInput = iadcNegInputGnd;
   initScanTable.entries[1].includeInScan = true;
 
-  initScanTable.entries[2].posInput = IADC_INPUT_2_PORT_PIN;
+  initScanTable.entries[2].posInput = BSP_IADC_INPUT(IADC_INPUT_2);
   initScanTable.entries[2].negInput = iadcNegInputGnd;
   initScanTable.entries[2].includeInScan = true;
 
-  initScanTable.entries[3].posInput = IADC_INPUT_3_PORT_PIN;
+  initScanTable.entries[3].posInput = BSP_IADC_INPUT(IADC_INPUT_3);
   initScanTable.entries[3].negInput = iadcNegInputGnd;
   initScanTable.entries[3].includeInScan = true;
 
@@ -227,10 +212,10 @@ void initIADC (void)
   IADC_initScan(IADC0, &initScan, &initScanTable);
 
   // Allocate the analog bus for ADC0 inputs
-  GPIO->IADC_INPUT_0_BUS |= IADC_INPUT_0_BUSALLOC;
-  GPIO->IADC_INPUT_1_BUS |= IADC_INPUT_1_BUSALLOC;
-  GPIO->IADC_INPUT_2_BUS |= IADC_INPUT_2_BUSALLOC;
-  GPIO->IADC_INPUT_3_BUS |= IADC_INPUT_3_BUSALLOC;
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_0) |= BSP_BUSALLOC(IADC_INPUT_0, ADC0);
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_1) |= BSP_BUSALLOC(IADC_INPUT_1, ADC0);
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_2) |= BSP_BUSALLOC(IADC_INPUT_2, ADC0);
+  GPIO->BSP_BUSALLOC_REG(IADC_INPUT_3) |= BSP_BUSALLOC(IADC_INPUT_3, ADC0);
 
   // Enable triggering of the scan queue
   IADC_command(IADC0, iadcCmdStartScan);
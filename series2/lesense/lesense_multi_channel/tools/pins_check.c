@@ -0,0 +1,139 @@
+/***************************************************************************//**
+ * @file pins_check.c
+ * @brief Host check of the pin table of every board.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -Wall -I../src -I../../../kit/common/bsp -o pins_check \
+ *       pins_check.c
+ *   ./pins_check
+ *
+ * Including the table checks every row at compile time: a pin that does not
+ * exist, is used twice, or stops in EM2 fails the build.  The program then
+ * allocates each row's inputs the way main.c does on the device, with the
+ * Series 2 register layouts, and compares the result with the values the
+ * per-board copies of the example wrote by hand.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "lesense_multi_channel_pins.h"
+
+// Bus allocation fields for ADC0, as in the device headers
+#define GPIO_ABUSALLOC_AEVEN0_ADC0          0x00000001UL
+#define GPIO_ABUSALLOC_AODD0_ADC0           0x00010000UL
+#define GPIO_BBUSALLOC_BEVEN0_ADC0          0x00000001UL
+#define GPIO_BBUSALLOC_BODD0_ADC0           0x00010000UL
+#define GPIO_CDBUSALLOC_CDEVEN0_ADC0        0x00000001UL
+#define GPIO_CDBUSALLOC_CDODD0_ADC0         0x00010000UL
+
+// Bus allocation registers
+static struct {
+  uint32_t ABUSALLOC;
+  uint32_t BBUSALLOC;
+  uint32_t CDBUSALLOC;
+} gpio, *GPIO = &gpio;
+
+// IADC inputs used by the table, numbered as port * 16 + pin
+enum {
+  iadcPosInputPortAPin6 = 6, iadcPosInputPortAPin7 = 7,
+  iadcPosInputPortBPin0 = 16, iadcPosInputPortBPin1 = 17,
+  iadcPosInputPortBPin3 = 19, iadcPosInputPortBPin4 = 20,
+  iadcPosInputPortBPin5 = 21,
+};
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static void printPin(int port, int pin)
+{
+  printf("  P%c%02d", 'A' + port, pin);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Print a row, allocate its inputs as main.c does, and compare the bus
+ *   allocations with the ones the example used to write by hand.
+ ******************************************************************************/
+#define CHECK_INPUT(n, dev)                                                   \
+  do {                                                                        \
+    printPin(BSP_PORTNUM(LESENSE_PIN(n, dev)), BSP_PIN(LESENSE_PIN(n, dev))); \
+    GPIO->BSP_BUSALLOC_REG(LESENSE_PIN(n, dev))                               \
+      |= BSP_BUSALLOC(LESENSE_PIN(n, dev), ADC0);                             \
+    check(BSP_IADC_INPUT(LESENSE_PIN(n, dev))                                 \
+          == BSP_PORTNUM(LESENSE_PIN(n, dev)) * 16                            \
+             + BSP_PIN(LESENSE_PIN(n, dev)),                                  \
+          #dev " input " #n);                                                 \
+  } while (0)
+
+#define CHECK_BOARD(dev, abus, bbus)                                          \
+  do {                                                                        \
+    printf("%s", #dev);                                                       \
+    gpio.ABUSALLOC = gpio.BBUSALLOC = gpio.CDBUSALLOC = 0;                    \
+    CHECK_INPUT(0, dev);                                                      \
+    CHECK_INPUT(1, dev);                                                      \
+    CHECK_INPUT(2, dev);                                                      \
+    CHECK_INPUT(3, dev);                                                      \
+    printf("  %08lX  %08lX\n", (unsigned long)gpio.ABUSALLOC,                 \
+           (unsigned long)gpio.BBUSALLOC);                                    \
+    check(gpio.ABUSALLOC == (abus), #dev " ABUSALLOC");                       \
+    check(gpio.BBUSALLOC == (bbus), #dev " BBUSALLOC");                       \
+    check(gpio.CDBUSALLOC == 0, #dev " CD bus untouched");                    \
+  } while (0)
+
+int main(void)
+{
+  printf("board CH0   CH1   CH2   CH3    ABUSALLOC BBUSALLOC\n");
+  CHECK_BOARD(XG23, GPIO_ABUSALLOC_AEVEN0_ADC0 | GPIO_ABUSALLOC_AODD0_ADC0,
+              GPIO_BBUSALLOC_BODD0_ADC0);
+  CHECK_BOARD(XG25, GPIO_ABUSALLOC_AEVEN0_ADC0 | GPIO_ABUSALLOC_AODD0_ADC0,
+              GPIO_BBUSALLOC_BEVEN0_ADC0 | GPIO_BBUSALLOC_BODD0_ADC0);
+  CHECK_BOARD(XG28, 0,
+              GPIO_BBUSALLOC_BEVEN0_ADC0 | GPIO_BBUSALLOC_BODD0_ADC0);
+
+  // Spot checks against the inputs the examples used to name by hand
+  check(BSP_IADC_INPUT(LESENSE_PIN(1, XG23)) == iadcPosInputPortBPin3,
+        "XG23 channel 1 is PB03");
+  check(BSP_IADC_INPUT(LESENSE_PIN(0, XG25)) == iadcPosInputPortBPin0,
+        "XG25 channel 0 is PB00");
+  check(BSP_IADC_INPUT(LESENSE_PIN(3, XG28)) == iadcPosInputPortBPin5,
+        "XG28 channel 3 is PB05");
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,481 @@
+/***************************************************************************//**
+ * @file imgw.c
+ * @brief Streaming firmware image writer: pages erased ahead, blocks
+ * programmed without CPU involvement and verified by CRC as they land.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "imgw.h"
+
+#if !defined(IMGW_HOST)
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_gpcrc.h"
+#include "em_ldma.h"
+#include "em_msc.h"
+#include "em_ramfunc.h"
+
+/*
+ * The MSC requests LDMA writes to WDATA where the LDMA crossbar has the
+ * MSC signal; otherwise words are written by a loop running from RAM.
+ * Define IMGW_PROGRAM_BURST to use the loop on all devices.
+ */
+#if defined(LDMAXBAR_CH_REQSEL_SOURCESEL_MSC) && !defined(IMGW_PROGRAM_BURST)
+#define IMGW_PROGRAM_LDMA
+#endif
+
+static unsigned int programCh;
+static unsigned int crcCh;
+
+// Descriptors must stay in place while the LDMA runs them
+static LDMA_Descriptor_t programDesc[2];
+static LDMA_Descriptor_t crcDesc;
+static bool programming;
+
+static bool mscLocked(uint8_t *page)
+{
+  uint32_t n = ((uint32_t)page - FLASH_BASE) / FLASH_PAGE_SIZE;
+
+  return ((&MSC->PAGELOCK0)[n / 32] >> (n % 32)) & 1;
+}
+
+static IMGW_Status_TypeDef mscStatus(void)
+{
+  if (MSC->STATUS & MSC_STATUS_LOCKED) {
+    return imgwErrLocked;
+  }
+  if (MSC->STATUS & MSC_STATUS_INVADDR) {
+    return imgwErrFlash;
+  }
+  return imgwOk;
+}
+
+static IMGW_Status_TypeDef mscErase(uint8_t *page)
+{
+  MSC->ADDRB = (uint32_t)page;
+  MSC->WRITECMD = MSC_WRITECMD_ERASEPAGE;
+  return mscStatus();
+}
+
+#if defined(IMGW_PROGRAM_LDMA)
+/*
+ * The first descriptor moves the words to WDATA as the MSC takes them; the
+ * second ends the write sequence so the last word is programmed.
+ */
+static IMGW_Status_TypeDef mscProgram(uint8_t *address,
+                                      const uint32_t *data,
+                                      uint32_t count)
+{
+  LDMA_TransferCfg_t config =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_MSC_WDATA);
+
+  MSC->ADDRB = (uint32_t)address;
+  if (mscStatus() != imgwOk) {
+    return mscStatus();
+  }
+  programDesc[0] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(data, &MSC->WDATA, count, 1);
+  programDesc[0].xfer.size = ldmaCtrlSizeWord;
+  programDesc[0].xfer.doneIfs = 0;
+  programDesc[1] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_SINGLE_WRITE(MSC_WRITECMD_WRITEEND, &MSC->WRITECMD);
+  LDMA_StartTransfer(programCh, &config, programDesc);
+  programming = true;
+  return imgwOk;
+}
+#else
+/*
+ * Runs from RAM: instruction fetches from flash would stall for each word
+ * being programmed.
+ */
+SL_RAMFUNC_DEFINITION_BEGIN
+static IMGW_Status_TypeDef mscProgram(uint8_t *address,
+                                      const uint32_t *data,
+                                      uint32_t count)
+{
+  MSC->ADDRB = (uint32_t)address;
+  if (MSC->STATUS & MSC_STATUS_INVADDR) {
+    return imgwErrFlash;
+  }
+  while (count-- > 0) {
+    while (!(MSC->STATUS & MSC_STATUS_WDATAREADY)) ;
+    MSC->WDATA = *data++;
+  }
+  MSC->WRITECMD = MSC_WRITECMD_WRITEEND;
+  while (MSC->STATUS & MSC_STATUS_BUSY) ;
+  return (MSC->STATUS & MSC_STATUS_LOCKED) ? imgwErrLocked : imgwOk;
+}
+SL_RAMFUNC_DEFINITION_END
+#endif
+
+static bool mscBusy(void)
+{
+#if defined(IMGW_PROGRAM_LDMA)
+  if (programming) {
+    if (!LDMA_TransferDone(programCh)) {
+      return true;
+    }
+    programming = false;
+  }
+#endif
+  return (MSC->STATUS & MSC_STATUS_BUSY) != 0;
+}
+
+/*
+ * The LDMA feeds whole words to the GPCRC; a final partial word goes in
+ * byte by byte.
+ */
+static uint32_t gpcrcRun(uint32_t seed, const void *data, uint32_t length)
+{
+  LDMA_TransferCfg_t config = LDMA_TRANSFER_CFG_MEMORY();
+  const uint8_t *tail = (const uint8_t *)data + (length & ~3u);
+
+  GPCRC_InitValueSet(GPCRC, seed);
+  GPCRC_Start(GPCRC);
+  if (length >= 4) {
+    crcDesc = (LDMA_Descriptor_t)
+      LDMA_DESCRIPTOR_SINGLE_M2M_WORD(data, &GPCRC->INPUTDATA, length / 4);
+    crcDesc.xfer.dstInc = ldmaCtrlDstIncNone;
+    crcDesc.xfer.doneIfs = 0;
+    LDMA_StartTransfer(crcCh, &config, &crcDesc);
+    while (!LDMA_TransferDone(crcCh)) ;
+  }
+  for (length &= 3; length > 0; length--) {
+    GPCRC_InputU8(GPCRC, *tail++);
+  }
+  return GPCRC_DataRead(GPCRC);
+}
+
+static void mscBegin(void)
+{
+  MSC_Init();
+  MSC->WRITECTRL_SET = MSC_WRITECTRL_WREN;
+}
+
+static void mscEnd(void)
+{
+  MSC_Deinit();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Write images to main flash with the MSC, programming on an LDMA
+ *   channel and verifying with the GPCRC on another.
+ *
+ * @details
+ *   LDMA_Init() must have been called. Programming runs on programChannel
+ *   only on devices where the MSC can request the LDMA.
+ *****************************************************************************/
+void IMGW_FlashMsc(IMGW_Flash_TypeDef *flash,
+                   unsigned int programChannel,
+                   unsigned int crcChannel)
+{
+  GPCRC_Init_TypeDef init = GPCRC_INIT_DEFAULT;
+
+  // IEEE 802.3 CRC-32 over bytes in memory order, as computed by zlib
+  CMU_ClockEnable(cmuClock_GPCRC, true);
+  init.initValue = 0xFFFFFFFFUL;
+  GPCRC_Init(GPCRC, &init);
+
+  programCh = programChannel;
+  crcCh = crcChannel;
+  flash->base = (uint8_t *)FLASH_BASE;
+  flash->size = FLASH_SIZE;
+  flash->pageSize = FLASH_PAGE_SIZE;
+  flash->locked = mscLocked;
+  flash->erase = mscErase;
+  flash->program = mscProgram;
+  flash->busy = mscBusy;
+  flash->crc = gpcrcRun;
+  flash->begin = mscBegin;
+  flash->end = mscEnd;
+}
+#endif // !IMGW_HOST
+
+#define CRC_SEED          0xFFFFFFFFUL
+
+static uint8_t *pageOf(const IMGW_Handle_TypeDef *h, uint8_t *address)
+{
+  return address - (uint32_t)(address - h->start) % h->flash->pageSize;
+}
+
+static void fail(IMGW_Handle_TypeDef *h,
+                 IMGW_Status_TypeDef error,
+                 uint8_t *address)
+{
+  if (h->error == imgwOk) {
+    h->error = error;
+    h->errorAddress = address;
+  }
+}
+
+/*
+ * The block being filled is queued for programming.  Its CRC, continuing
+ * from the previous block, is what reading it back must give.
+ */
+static void seal(IMGW_Handle_TypeDef *h)
+{
+  uint8_t b = (h->head + h->sealed) % IMGW_BLOCKS;
+  uint8_t *bytes = (uint8_t *)h->block[b];
+
+  memset(bytes + h->fill, 0xFF, (4 - h->fill % 4) % 4);
+  h->dataCrc = h->flash->crc(h->dataCrc, bytes, h->fill);
+  h->blockCrc[b] = h->dataCrc;
+  h->blockLength[b] = h->fill;
+  h->sealed++;
+  h->fill = 0;
+}
+
+/*
+ * The head block has been programmed: compare what flash now holds with
+ * the data it was given.
+ */
+static void verify(IMGW_Handle_TypeDef *h)
+{
+  uint8_t b = h->head;
+
+  h->flashCrc = h->flash->crc(h->flashCrc, h->programmed, h->blockLength[b]);
+  if (h->flashCrc != h->blockCrc[b]) {
+    fail(h, imgwErrVerify, h->programmed);
+    return;
+  }
+  h->writing = false;
+  h->programmed += IMGW_BLOCK_SIZE;
+  h->head = (b + 1) % IMGW_BLOCKS;
+  h->sealed--;
+  h->blocks++;
+}
+
+/*
+ * Start the next flash operation.  Queued blocks are programmed first;
+ * pages are erased ahead of them while the flash would otherwise be idle.
+ */
+static bool startNext(IMGW_Handle_TypeDef *h)
+{
+  const IMGW_Flash_TypeDef *f = h->flash;
+  IMGW_Status_TypeDef status;
+  uint8_t *page;
+
+  if (h->sealed > 0 && h->programmed < h->erased) {
+    page = pageOf(h, h->programmed);
+    status = f->locked(page) ? imgwErrLocked
+             : f->program(h->programmed, h->block[h->head],
+                          (h->blockLength[h->head] + 3u) / 4);
+    if (status != imgwOk) {
+      fail(h, status, page);
+      return false;
+    }
+    h->writing = true;
+    return true;
+  }
+  if (h->erased < h->end
+      && h->erased < pageOf(h, h->programmed)
+                     + (1 + IMGW_ERASE_AHEAD) * f->pageSize) {
+    status = f->locked(h->erased) ? imgwErrLocked : f->erase(h->erased);
+    if (status != imgwOk) {
+      fail(h, status, h->erased);
+      return false;
+    }
+    h->erased += f->pageSize;
+    h->erases++;
+    return true;
+  }
+  return false;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start writing an image of up to size bytes at a page boundary.
+ *
+ * @details
+ *   Every page of the range is checked against the page locks first, so a
+ *   locked range fails before anything is erased. Pages are erased as the
+ *   image reaches them, not all up front.
+ *****************************************************************************/
+IMGW_Status_TypeDef IMGW_Begin(IMGW_Handle_TypeDef *handle,
+                               const IMGW_Flash_TypeDef *flash,
+                               uint8_t *address,
+                               uint32_t size)
+{
+  uint32_t pages;
+  uint8_t *page;
+
+  memset(handle, 0, sizeof(*handle));
+  handle->flash = flash;
+  handle->start = address;
+  handle->size = size;
+  handle->dataCrc = CRC_SEED;
+  handle->flashCrc = CRC_SEED;
+
+  pages = (size + flash->pageSize - 1) / flash->pageSize;
+  if (flash->pageSize % IMGW_BLOCK_SIZE != 0
+      || size == 0
+      || address < flash->base
+      || (uint32_t)(address - flash->base) % flash->pageSize != 0
+      || pages > (flash->size - (uint32_t)(address - flash->base))
+                 / flash->pageSize) {
+    fail(handle, imgwErrConfig, address);
+    return handle->error;
+  }
+  handle->end = address + pages * flash->pageSize;
+  handle->erased = address;
+  handle->programmed = address;
+
+  for (page = address; page < handle->end; page += flash->pageSize) {
+    if (flash->locked(page)) {
+      fail(handle, imgwErrLocked, page);
+      return handle->error;
+    }
+  }
+
+  flash->begin();
+  handle->open = true;
+  return IMGW_Poll(handle);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take image data; returns how many bytes were taken.
+ *
+ * @details
+ *   Fewer bytes than offered are taken when all blocks are waiting for the
+ *   flash; offer the rest after IMGW_Poll() stops returning imgwBusy. The
+ *   data is copied, so the buffer may be reused on return.
+ *****************************************************************************/
+uint32_t IMGW_Write(IMGW_Handle_TypeDef *handle,
+                    const void *data,
+                    uint32_t length)
+{
+  const uint8_t *src = data;
+  uint32_t taken = 0;
+  uint32_t n;
+
+  if (!handle->open || handle->finishing || handle->error != imgwOk) {
+    return 0;
+  }
+  while (taken < length) {
+    if (handle->length == handle->size) {
+      fail(handle, imgwErrRange, handle->start + handle->length);
+      break;
+    }
+    if (handle->sealed == IMGW_BLOCKS) {
+      IMGW_Poll(handle);
+      if (handle->sealed == IMGW_BLOCKS) {
+        handle->stalls++;
+        break;
+      }
+    }
+    n = IMGW_BLOCK_SIZE - handle->fill;
+    if (n > length - taken) {
+      n = length - taken;
+    }
+    if (n > handle->size - handle->length) {
+      n = handle->size - handle->length;
+    }
+    memcpy((uint8_t *)handle->block[(handle->head + handle->sealed)
+                                    % IMGW_BLOCKS] + handle->fill,
+           src + taken, n);
+    handle->fill += n;
+    handle->length += n;
+    taken += n;
+    if (handle->fill == IMGW_BLOCK_SIZE) {
+      seal(handle);
+    }
+  }
+  IMGW_Poll(handle);
+  return taken;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Verify finished writes and start the next erase or write.
+ *
+ * @details
+ *   Call whenever an MSC or LDMA interrupt may have ended an operation.
+ *   Returns imgwBusy while an operation runs, imgwOk when the flash waits
+ *   for more data, or the error that stopped the image.
+ *****************************************************************************/
+IMGW_Status_TypeDef IMGW_Poll(IMGW_Handle_TypeDef *handle)
+{
+  if (!handle->open) {
+    return handle->error;
+  }
+  for (;;) {
+    if (handle->flash->busy()) {
+      return imgwBusy;
+    }
+    if (handle->writing && handle->error == imgwOk) {
+      verify(handle);
+    }
+    if (handle->error != imgwOk) {
+      break;
+    }
+    if (!startNext(handle)) {
+      if (handle->error != imgwOk
+          || (handle->finishing && handle->sealed == 0)) {
+        break;
+      }
+      return imgwOk;
+    }
+  }
+  handle->flash->end();
+  handle->open = false;
+  return handle->error;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Queue the last partial block; IMGW_Poll() then returns imgwOk once the
+ *   whole image is programmed and verified.
+ *****************************************************************************/
+IMGW_Status_TypeDef IMGW_Finish(IMGW_Handle_TypeDef *handle)
+{
+  if (handle->open && !handle->finishing && handle->error == imgwOk) {
+    if (handle->fill > 0) {
+      seal(handle);
+    }
+    handle->finishing = true;
+  }
+  return IMGW_Poll(handle);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   CRC-32 of the image read back from flash so far, to compare with the
+ *   CRC sent with the image.
+ *****************************************************************************/
+uint32_t IMGW_Crc(const IMGW_Handle_TypeDef *handle)
+{
+  return ~handle->flashCrc;
+}
@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ * @file imgw.h
+ * @brief Streaming firmware image writer: pages erased ahead, blocks
+ * programmed without CPU involvement and verified by CRC as they land.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef IMGW_H
+#define IMGW_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Bytes programmed with one write; a divisor of the flash page size
+#define IMGW_BLOCK_SIZE     1024
+
+/// Blocks buffered in RAM; those not being programmed must hold the data
+/// received during a page erase
+#define IMGW_BLOCKS         3
+
+/// Pages kept erased beyond the one being programmed
+#define IMGW_ERASE_AHEAD    1
+
+/// Writer state, from best to worst; errors are kept until IMGW_Begin()
+typedef enum {
+  imgwOk,               ///< Idle: all accepted data is programmed or queued
+  imgwBusy,             ///< An erase or write is in progress
+  imgwErrConfig,        ///< Range not page aligned or outside main flash
+  imgwErrLocked,        ///< A page in the range is locked (MSC_PAGELOCKn)
+  imgwErrFlash,         ///< The MSC refused an erase or write
+  imgwErrVerify,        ///< Flash differs from the data written
+  imgwErrRange          ///< More data than the range holds
+} IMGW_Status_TypeDef;
+
+/// Flash access; erase and program start an operation and return
+typedef struct {
+  uint8_t  *base;       ///< Start of main flash
+  uint32_t size;        ///< Size of main flash
+  uint32_t pageSize;
+  bool (*locked)(uint8_t *page);
+  IMGW_Status_TypeDef (*erase)(uint8_t *page);
+  IMGW_Status_TypeDef (*program)(uint8_t *address,
+                                 const uint32_t *data,
+                                 uint32_t count);
+  bool (*busy)(void);
+  /// CRC-32 register value after feeding bytes into it, starting from seed
+  uint32_t (*crc)(uint32_t seed, const void *data, uint32_t length);
+  void (*begin)(void);  ///< Before the first erase of an image
+  void (*end)(void);    ///< After the last write, or on error
+} IMGW_Flash_TypeDef;
+
+/// Writer state; all fields are read-only for the application
+typedef struct {
+  const IMGW_Flash_TypeDef *flash;
+  uint8_t  *start;
+  uint8_t  *end;                  ///< Range rounded up to whole pages
+  uint32_t size;                  ///< Bytes the range accepts
+  uint32_t length;                ///< Bytes accepted so far
+  uint8_t  *erased;               ///< Pages below are erased
+  uint8_t  *programmed;           ///< Where the oldest block goes
+
+  uint32_t block[IMGW_BLOCKS][IMGW_BLOCK_SIZE / 4];
+  uint16_t blockLength[IMGW_BLOCKS];
+  uint32_t blockCrc[IMGW_BLOCKS]; ///< Running CRC expected after each block
+  uint8_t  head;                  ///< Oldest sealed block
+  uint8_t  sealed;                ///< Blocks waiting or being programmed
+  uint16_t fill;                  ///< Bytes in the block being filled
+  bool     writing;               ///< Head block is being programmed
+  bool     open;                  ///< Between begin() and end()
+  bool     finishing;
+  IMGW_Status_TypeDef error;      ///< First error, or imgwOk
+  uint8_t  *errorAddress;         ///< Page or block it occurred at
+
+  uint32_t dataCrc;               ///< Running CRC of the accepted data
+  uint32_t flashCrc;              ///< Running CRC read back from flash
+
+  uint32_t erases;                ///< Pages erased
+  uint32_t blocks;                ///< Blocks programmed and verified
+  uint32_t stalls;                ///< Writes that could not take all data
+} IMGW_Handle_TypeDef;
+
+IMGW_Status_TypeDef IMGW_Begin(IMGW_Handle_TypeDef *handle,
+                               const IMGW_Flash_TypeDef *flash,
+                               uint8_t *address,
+                               uint32_t size);
+uint32_t IMGW_Write(IMGW_Handle_TypeDef *handle,
+                    const void *data,
+                    uint32_t length);
+IMGW_Status_TypeDef IMGW_Poll(IMGW_Handle_TypeDef *handle);
+IMGW_Status_TypeDef IMGW_Finish(IMGW_Handle_TypeDef *handle);
+uint32_t IMGW_Crc(const IMGW_Handle_TypeDef *handle);
+
+#if !defined(IMGW_HOST)
+void IMGW_FlashMsc(IMGW_Flash_TypeDef *flash,
+                   unsigned int programChannel,
+                   unsigned int crcChannel);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IMGW_H
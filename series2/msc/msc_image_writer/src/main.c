@@ -0,0 +1,191 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Write a streamed firmware image to the upper part of main flash.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_emu.h"
+#include "em_ldma.h"
+#include "em_msc.h"
+
+#include "imgw.h"
+
+// LDMA channels for programming and for the GPCRC
+#define PROGRAM_CHANNEL   0
+#define CRC_CHANNEL       1
+
+// Image slot: the upper 128 KB of main flash
+#define SLOT_SIZE         (128 * 1024)
+#define SLOT_ADDRESS      ((uint8_t *)(FLASH_BASE + FLASH_SIZE - SLOT_SIZE))
+
+// Image length, deliberately not a whole number of words, and packet size
+#define IMAGE_LENGTH      (SLOT_SIZE - 123)
+#define PACKET_SIZE       256
+
+IMGW_Handle_TypeDef writer;
+
+// Results; inspect them in the debugger
+IMGW_Status_TypeDef writeStatus;
+uint32_t expectedCrc;
+uint32_t imageCrc;
+bool imageOk;
+
+/**************************************************************************//**
+ * @brief
+ *   The interrupts only wake the main loop from EM1.
+ *****************************************************************************/
+void MSC_IRQHandler(void)
+{
+  MSC_IntClear(MSC_IntGet());
+}
+
+void LDMA_IRQHandler(void)
+{
+  uint32_t flags = LDMA_IntGet();
+
+  if (flags & LDMA_IF_ERROR) {
+    __BKPT(0);
+  }
+  LDMA_IntClear(flags);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Stand-in for a received packet: pseudo-random data, with the CRC-32 the
+ *   sender would put in the image header computed alongside.
+ *****************************************************************************/
+static uint32_t receivePacket(uint8_t *packet, uint32_t length)
+{
+  static uint32_t state = 0x2545F491;
+  static uint32_t crc = 0xFFFFFFFFUL;
+  uint32_t i;
+  int bit;
+
+  for (i = 0; i < length; i++) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    packet[i] = (uint8_t)state;
+
+    crc ^= packet[i];
+    for (bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Let the writer start its next erase or write, and sleep in EM1 while
+ *   one runs.
+ *
+ * @details
+ *   The check and the sleep are in one critical section: an interrupt
+ *   ending the operation in between stays pending and ends the sleep.
+ *****************************************************************************/
+static IMGW_Status_TypeDef pollWriter(void)
+{
+  IMGW_Status_TypeDef status;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  status = IMGW_Poll(&writer);
+  if (status == imgwBusy) {
+    EMU_EnterEM1();
+  }
+  CORE_EXIT_CRITICAL();
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  IMGW_Flash_TypeDef flash;
+  uint8_t packet[PACKET_SIZE];
+  uint32_t received = 0;
+  uint32_t length = 0;
+  uint32_t used = 0;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Enable MSC Clock
+  CMU_ClockEnable(cmuClock_MSC, true);
+
+  LDMA_Init(&ldmaInit);
+  IMGW_FlashMsc(&flash, PROGRAM_CHANNEL, CRC_CHANNEL);
+
+  // Wake from EM1 when an erase or write ends
+  MSC_IntClear(_MSC_IF_MASK);
+  MSC_IntEnable(MSC_IEN_ERASE | MSC_IEN_WRITE);
+  NVIC_ClearPendingIRQ(MSC_IRQn);
+  NVIC_EnableIRQ(MSC_IRQn);
+
+  writeStatus = IMGW_Begin(&writer, &flash, SLOT_ADDRESS, IMAGE_LENGTH);
+
+  // Hand packets to the writer as they come; wait when it is full
+  while (writeStatus <= imgwBusy && used < IMAGE_LENGTH) {
+    if (used == received) {
+      length = IMAGE_LENGTH - received < PACKET_SIZE
+               ? IMAGE_LENGTH - received : PACKET_SIZE;
+      expectedCrc = receivePacket(packet, length);
+      received += length;
+    }
+    used += IMGW_Write(&writer, packet + length - (received - used),
+                       received - used);
+    if (used < received) {
+      writeStatus = pollWriter();
+    }
+  }
+
+  // Program the last block and wait until the whole image is verified
+  writeStatus = IMGW_Finish(&writer);
+  while (writeStatus == imgwBusy) {
+    writeStatus = pollWriter();
+  }
+
+  imageCrc = IMGW_Crc(&writer);
+  imageOk = writeStatus == imgwOk && imageCrc == expectedCrc;
+
+  // Infinite Loop
+  while (1);
+}
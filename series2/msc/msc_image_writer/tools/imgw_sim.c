@@ -0,0 +1,570 @@
+/***************************************************************************//**
+ * @file imgw_sim.c
+ * @brief Host test and benchmark for the image writer, with a timed MSC
+ * model.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DIMGW_HOST -I../src -o imgw_sim imgw_sim.c ../src/imgw.c
+ *   ./imgw_sim
+ *
+ * The MSC model keeps a virtual clock. Erases and writes take the times
+ * below; the CPU is charged for starting operations, copying data, feeding
+ * the CRC and, when words are written by a loop, for the whole write. The
+ * model reports writes to words that are not erased, operations started
+ * while the flash is busy and flash read back while it is busy. Images
+ * arrive in chunks at a given link rate, or as fast as the writer takes
+ * them, and throughput and CPU occupancy are reported for the writer with
+ * LDMA, with the RAM loop, and for MSC_WriteWord() called word by word as
+ * in the msc_rw example. The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "imgw.h"
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// ------------------------------------------------------------- timing, in us
+/*
+ * Of the order given in Series 2 data sheets for a 39 MHz core; set them
+ * from the data sheet of the device in question.
+ */
+#define T_WORD        11.0      // Program one word
+#define T_ERASE       15000.0   // Erase one page
+#define T_START       1.0       // CPU: start an erase, write or CRC
+#define T_POLL        0.2       // CPU: look at the MSC status
+#define T_COPY        0.008     // CPU: copy one byte into a block
+#define T_CRC         0.05      // LDMA feeding one word to the GPCRC
+#define T_CALL        4.0       // CPU: MSC_Init(), MSC_WriteWord(), MSC_Deinit()
+
+// ---------------------------------------------------------------- MSC model
+#define PAGE_SIZE     8192
+#define PAGES         32
+#define CHUNK         256       // Bytes per received packet
+
+typedef enum {
+  modeLdma,                     // Words written by the LDMA
+  modeLoop,                     // Words written by a loop from RAM
+  modeFree                      // No time at all: software overhead only
+} Mode_TypeDef;
+
+static uint8_t flashMem[PAGES * PAGE_SIZE];
+static bool pageLocked[PAGES];
+static Mode_TypeDef mode;
+static double now;              // Virtual time
+static double cpu;              // Of which the CPU was busy
+static double busyUntil;        // End of the flash operation in progress
+static double longest;          // Longest the CPU was busy at once
+static int depth;               // begin()/end() nesting
+static uint32_t sessions;
+static uint32_t corruptBlock;   // Flip a bit in this write; 0 = never
+static uint32_t writes;
+static uint32_t rng = 12345;
+
+static uint32_t rnd(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+static void spend(double us)
+{
+  if (mode != modeFree) {
+    now += us;
+    cpu += us;
+    if (us > longest) {
+      longest = us;
+    }
+  }
+}
+
+static bool flashBusy(void)
+{
+  return now < busyUntil;
+}
+
+static uint32_t pageIndex(uint8_t *address)
+{
+  return (uint32_t)(address - flashMem) / PAGE_SIZE;
+}
+
+static bool modelLocked(uint8_t *page)
+{
+  return pageLocked[pageIndex(page)];
+}
+
+static IMGW_Status_TypeDef modelErase(uint8_t *page)
+{
+  spend(T_START);
+  check(depth == 1, "erase inside begin()/end()");
+  check(!flashBusy(), "erase started while the flash is idle");
+  if (pageLocked[pageIndex(page)]) {
+    return imgwErrLocked;
+  }
+  memset(page, 0xFF, PAGE_SIZE);
+  busyUntil = mode == modeFree ? now : now + T_ERASE;
+  return imgwOk;
+}
+
+static IMGW_Status_TypeDef modelProgram(uint8_t *address,
+                                        const uint32_t *data,
+                                        uint32_t count)
+{
+  uint32_t i;
+  uint32_t old;
+  uint32_t w;
+
+  spend(T_START);
+  check(depth == 1, "write inside begin()/end()");
+  check(!flashBusy(), "write started while the flash is idle");
+  check(pageIndex(address) == pageIndex(address + 4 * count - 1),
+        "write stays in one page");
+  if (pageLocked[pageIndex(address)]) {
+    return imgwErrLocked;
+  }
+  writes++;
+  for (i = 0; i < count; i++) {
+    memcpy(&old, address + 4 * i, 4);
+    check(old == 0xFFFFFFFFUL, "written word was erased");
+    w = data[i];
+    if (writes == corruptBlock && i == count / 2) {
+      w &= w - 1;                       // One bit fails to program
+    }
+    old &= w;
+    memcpy(address + 4 * i, &old, 4);
+  }
+  if (mode == modeLoop) {
+    spend(count * T_WORD);
+  } else if (mode == modeLdma) {
+    busyUntil = now + count * T_WORD;
+  }
+  return imgwOk;
+}
+
+static bool modelBusy(void)
+{
+  spend(T_POLL);
+  return flashBusy();
+}
+
+static uint32_t crc32(uint32_t crc, const uint8_t *p, uint32_t n)
+{
+  static const uint32_t nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+
+  while (n-- > 0) {
+    crc ^= *p++;
+    crc = (crc >> 4) ^ nibble[crc & 15];
+    crc = (crc >> 4) ^ nibble[crc & 15];
+  }
+  return crc;
+}
+
+// The GPCRC without reflection or final inversion: the raw register value
+static uint32_t modelCrc(uint32_t seed, const void *data, uint32_t length)
+{
+  const uint8_t *p = data;
+
+  spend(T_START + (length / 4) * T_CRC);
+  if (p >= flashMem && p < flashMem + sizeof(flashMem)) {
+    check(!flashBusy(), "flash read back while the flash is idle");
+  }
+  return crc32(seed, p, length);
+}
+
+static void modelBegin(void)
+{
+  depth++;
+  sessions++;
+}
+
+static void modelEnd(void)
+{
+  depth--;
+  check(!flashBusy(), "end() with the flash idle");
+}
+
+static const IMGW_Flash_TypeDef msc = {
+  flashMem, sizeof(flashMem), PAGE_SIZE,
+  modelLocked, modelErase, modelProgram, modelBusy, modelCrc,
+  modelBegin, modelEnd
+};
+
+static void reset(Mode_TypeDef m)
+{
+  uint32_t i;
+
+  // Old contents everywhere, so writes to pages not erased are caught
+  for (i = 0; i < sizeof(flashMem); i++) {
+    flashMem[i] = (uint8_t)rnd();
+  }
+  memset(pageLocked, 0, sizeof(pageLocked));
+  mode = m;
+  now = 0;
+  cpu = 0;
+  busyUntil = 0;
+  longest = 0;
+  depth = 0;
+  sessions = 0;
+  corruptBlock = 0;
+  writes = 0;
+}
+
+// ---------------------------------------------------------------- transfers
+static uint8_t image[PAGES * PAGE_SIZE];
+static IMGW_Handle_TypeDef writer;
+
+typedef struct {
+  IMGW_Status_TypeDef status;
+  double time;                  // us, until the image is verified
+  double cpu;                   // us
+  double late;                  // us from the last byte to verified
+  double longest;               // us, longest the CPU was busy at once
+  uint32_t taken;
+} Run_TypeDef;
+
+static void makeImage(uint32_t length)
+{
+  uint32_t i;
+
+  for (i = 0; i < length; i++) {
+    image[i] = (uint8_t)rnd();
+  }
+}
+
+// Time the chunk holding byte pos has been received; rate in bytes/us
+static double arrival(uint32_t pos, uint32_t length, double rate)
+{
+  uint32_t end = (pos / CHUNK + 1) * CHUNK;
+
+  if (rate == 0) {
+    return 0;
+  }
+  return (end < length ? end : length) / rate;
+}
+
+// Sleep until the flash operation ends, then poll as its interrupt would
+static IMGW_Status_TypeDef sleepPoll(void)
+{
+  if (now < busyUntil) {
+    now = busyUntil;
+  }
+  return IMGW_Poll(&writer);
+}
+
+/*
+ * Receive an image at rate bytes/us (0: as fast as taken) and write it
+ * at offset; lockAt > 0 locks that page once the write reaches
+ * lockAt - 1 pages in.
+ */
+static Run_TypeDef transfer(uint32_t offset, uint32_t length, uint32_t size,
+                            double rate, uint32_t lockAt)
+{
+  Run_TypeDef r;
+  uint32_t pos = 0;
+  uint32_t end;
+  uint32_t n;
+  double ready;
+
+  memset(&r, 0, sizeof(r));
+  r.status = IMGW_Begin(&writer, &msc, flashMem + offset, size);
+  while (pos < length && writer.error == imgwOk) {
+    if (lockAt > 0 && pos >= (lockAt - 1) * PAGE_SIZE) {
+      pageLocked[offset / PAGE_SIZE + lockAt] = true;
+    }
+    ready = arrival(pos, length, rate);
+    if (now < ready) {
+      // Waiting for data; the flash may finish something meanwhile
+      if (busyUntil > now && busyUntil < ready) {
+        sleepPoll();
+      } else {
+        now = ready;
+      }
+      continue;
+    }
+    end = (pos / CHUNK + 1) * CHUNK;
+    if (end > length) {
+      end = length;
+    }
+    n = IMGW_Write(&writer, image + pos, end - pos);
+    spend(n * T_COPY);
+    pos += n;
+    if (pos < end && writer.error == imgwOk) {
+      if (sleepPoll() == imgwOk && writer.sealed == IMGW_BLOCKS) {
+        check(0, "writer takes data once the flash is idle");
+        break;
+      }
+    }
+  }
+  r.taken = pos;
+  if (writer.error == imgwOk) {
+    r.status = IMGW_Finish(&writer);
+    while (r.status == imgwBusy) {
+      r.status = sleepPoll();
+    }
+  } else {
+    r.status = IMGW_Poll(&writer);
+    while (r.status == imgwBusy) {
+      r.status = sleepPoll();
+    }
+  }
+  r.time = now;
+  r.cpu = cpu;
+  r.late = now - arrival(length - 1, length, rate);
+  r.longest = longest;
+  return r;
+}
+
+// The msc_rw way: an erase at each page, then MSC_WriteWord() per word
+static Run_TypeDef wordByWord(uint32_t offset, uint32_t length, double rate)
+{
+  Run_TypeDef r;
+  uint32_t pos;
+  uint32_t w;
+  double ready;
+
+  memset(&r, 0, sizeof(r));
+  for (pos = 0; pos < length; pos += 4) {
+    ready = arrival(pos + 3 < length ? pos + 3 : length - 1, length, rate);
+    if (now < ready) {
+      now = ready;
+    }
+    if (pos % PAGE_SIZE == 0) {
+      memset(flashMem + offset + pos, 0xFF, PAGE_SIZE);
+      spend(T_CALL + T_ERASE);
+    }
+    w = 0xFFFFFFFFUL;
+    memcpy(&w, image + pos, length - pos < 4 ? length - pos : 4);
+    memcpy(flashMem + offset + pos, &w, 4);
+    spend(T_CALL + T_WORD);
+  }
+  r.time = now;
+  r.cpu = cpu;
+  r.late = now - arrival(length - 1, length, rate);
+  r.longest = longest;
+  r.taken = length;
+  return r;
+}
+
+static int imageMatches(uint32_t offset, uint32_t length)
+{
+  uint32_t i;
+
+  if (memcmp(flashMem + offset, image, length) != 0) {
+    return 0;
+  }
+  for (i = length; i % 4 != 0; i++) {
+    if (flashMem[offset + i] != 0xFF) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// ---------------------------------------------------------------- tests
+static void testImages(Mode_TypeDef m)
+{
+  static const uint32_t lengths[] = {
+    1, 1024, 1500, 8192, 3 * 8192 + 37, 200001
+  };
+  static const double rates[] = { 0, 0.1, 0.01 };
+  uint32_t i;
+  uint32_t j;
+  uint32_t pages;
+  Run_TypeDef r;
+
+  for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    for (j = 0; j < sizeof(rates) / sizeof(rates[0]); j++) {
+      reset(m);
+      makeImage(lengths[i]);
+      r = transfer(2 * PAGE_SIZE, lengths[i], lengths[i], rates[j], 0);
+      pages = (lengths[i] + PAGE_SIZE - 1) / PAGE_SIZE;
+      check(r.status == imgwOk, "image written");
+      check(r.taken == lengths[i], "all data taken");
+      check(imageMatches(2 * PAGE_SIZE, lengths[i]), "flash holds the image");
+      check(IMGW_Crc(&writer) == ~crc32(~0u, image, lengths[i]),
+            "CRC of the image");
+      check(writer.erases == pages, "only the image's pages erased");
+      check(sessions == 1 && depth == 0, "one MSC session");
+    }
+  }
+}
+
+static void testLocks(void)
+{
+  Run_TypeDef r;
+
+  // Locked before the start: refused before anything is erased
+  reset(modeLdma);
+  makeImage(5 * PAGE_SIZE);
+  pageLocked[4] = true;
+  r = transfer(PAGE_SIZE, 5 * PAGE_SIZE, 5 * PAGE_SIZE, 0, 0);
+  check(r.status == imgwErrLocked, "locked range refused");
+  check(writer.errorAddress == flashMem + 4 * PAGE_SIZE, "locked page named");
+  check(writer.erases == 0 && sessions == 0, "nothing erased");
+
+  // Locked while the image is being written
+  reset(modeLdma);
+  r = transfer(PAGE_SIZE, 5 * PAGE_SIZE, 5 * PAGE_SIZE, 0.1, 3);
+  check(r.status == imgwErrLocked, "lock taking effect stops the image");
+  check(writer.errorAddress == flashMem + 4 * PAGE_SIZE, "locked page named");
+  check(depth == 0 && !writer.open, "session ended");
+  check(IMGW_Write(&writer, image, 16) == 0, "no data taken after an error");
+}
+
+static void testErrors(void)
+{
+  Run_TypeDef r;
+
+  // A bit that did not program is caught at its block
+  reset(modeLdma);
+  makeImage(6 * 1024);
+  corruptBlock = 4;
+  r = transfer(0, 6 * 1024, 6 * 1024, 0, 0);
+  check(r.status == imgwErrVerify, "corrupt block detected");
+  check(writer.errorAddress == flashMem + 3 * 1024, "corrupt block named");
+  check(writer.blocks == 3 && depth == 0, "stopped at the corrupt block");
+
+  // More data than the range takes
+  reset(modeLoop);
+  makeImage(4096);
+  r = transfer(0, 4096, 4000, 0, 0);
+  check(r.status == imgwErrRange && r.taken == 4000, "range enforced");
+
+  reset(modeLdma);
+  check(IMGW_Begin(&writer, &msc, flashMem + 100, 1000) == imgwErrConfig,
+        "unaligned range refused");
+  check(IMGW_Begin(&writer, &msc, flashMem + 30 * PAGE_SIZE,
+                   3 * PAGE_SIZE) == imgwErrConfig,
+        "range past the end of flash refused");
+  check(IMGW_Begin(&writer, &msc, flashMem, 0) == imgwErrConfig,
+        "empty range refused");
+  check(sessions == 0, "no session for a bad range");
+}
+
+static void testEraseAhead(void)
+{
+  Run_TypeDef r;
+
+  // At 100 KB/s every erase fits between blocks
+  reset(modeLdma);
+  makeImage(150000);
+  r = transfer(0, 150000, 150000, 0.1, 0);
+  check(r.status == imgwOk && writer.stalls == 0, "no stall at 100 KB/s");
+  check(r.late < 2 * (IMGW_BLOCK_SIZE / 4) * T_WORD,
+        "done within two block writes of the last byte");
+}
+
+// ---------------------------------------------------------------- benchmark
+static void report(const char *name, Run_TypeDef fast, Run_TypeDef paced)
+{
+  printf("%-22s %6.1f KB/s %5.1f%% CPU | %5.1f%% CPU, CPU held %6.3f ms,"
+         " done %4.1f ms late\n",
+         name, 200000 / fast.time * 1e6 / 1024, 100 * fast.cpu / fast.time,
+         100 * paced.cpu / paced.time, paced.longest / 1000,
+         paced.late / 1000);
+}
+
+static void benchmark(void)
+{
+  Run_TypeDef fast;
+  Run_TypeDef paced;
+  uint32_t i;
+  uint32_t total = 0;
+  clock_t start;
+  double seconds;
+
+  printf("200000-byte image as fast as written | received at 100 KB/s"
+         " in %d-byte chunks\n", CHUNK);
+  makeImage(200000);
+  reset(modeLdma);
+  fast = transfer(0, 200000, 200000, 0, 0);
+  reset(modeLdma);
+  paced = transfer(0, 200000, 200000, 0.1, 0);
+  check(fast.status == imgwOk && paced.status == imgwOk, "benchmark images");
+  report("writer, LDMA", fast, paced);
+
+  reset(modeLoop);
+  fast = transfer(0, 200000, 200000, 0, 0);
+  reset(modeLoop);
+  paced = transfer(0, 200000, 200000, 0.1, 0);
+  report("writer, loop from RAM", fast, paced);
+
+  reset(modeLoop);
+  fast = wordByWord(0, 200000, 0);
+  reset(modeLoop);
+  paced = wordByWord(0, 200000, 0.1);
+  check(imageMatches(0, 200000), "word by word image");
+  report("MSC_WriteWord() each", fast, paced);
+
+  // Host time spent in the writer itself, with a flash that takes no time
+  reset(modeFree);
+  start = clock();
+  for (i = 0; i < 100; i++) {
+    transfer(0, 200000, 200000, 0, 0);
+    total += 200000;
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  check(imageMatches(0, 200000), "free-running image");
+  printf("writer software on this host: %.1f us per KB\n",
+         seconds * 1e6 / (total / 1024));
+}
+
+int main(void)
+{
+  testImages(modeLdma);
+  testImages(modeLoop);
+  testLocks();
+  testErrors();
+  testEraseAhead();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures != 0;
+}
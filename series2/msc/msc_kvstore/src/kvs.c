@@ -0,0 +1,923 @@
+/***************************************************************************//**
+ * @file kvs.c
+ * @brief Key-value store in internal flash: append-only records in a ring of
+ * pages, a RAM index and incremental page reclaim.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "kvs.h"
+
+#if !defined(KVS_HOST)
+#include "em_device.h"
+#include "em_msc.h"
+
+static bool mscErase(uint8_t *page)
+{
+  return MSC_ErasePage((uint32_t *)page) == mscReturnOk;
+}
+
+static bool mscWrite(uint8_t *address, const uint32_t *words, uint32_t count)
+{
+  return MSC_WriteWord((uint32_t *)address, words, count * 4) == mscReturnOk;
+}
+
+static void mscBegin(void)
+{
+  MSC_Init();
+}
+
+static void mscEnd(void)
+{
+  MSC_Deinit();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Place the store in the last pages of main flash and program it with
+ *   the MSC.
+ *
+ * @details
+ *   The application must not extend into these pages; check the map file
+ *   or reserve them in the linker script.
+ *****************************************************************************/
+void KVS_FlashMsc(KVS_Flash_TypeDef *flash, uint8_t pages)
+{
+  flash->base = (uint8_t *)(FLASH_BASE + FLASH_SIZE - pages * FLASH_PAGE_SIZE);
+  flash->pageSize = FLASH_PAGE_SIZE;
+  flash->pages = pages;
+  flash->erase = mscErase;
+  flash->write = mscWrite;
+  flash->begin = mscBegin;
+  flash->end = mscEnd;
+}
+#endif // !KVS_HOST
+
+// Page header: magic, sequence, inverted sequence, geometry
+#define PAGE_MAGIC        0x3153564BUL    // "KVS1"
+#define HEADER_BYTES      16
+
+// Record: header word (key, length, tag), value padded to words, CRC-32
+#define TAG_VALUE         0xA5
+#define TAG_DELETE        0x5A
+#define TAG_RECLAIM       0x3C            // Value: sequence of a reclaimed page
+#define ERASED            0xFFFFFFFFUL
+#define RECORD_MAX_BYTES  (8 + ((KVS_MAX_VALUE + 3) & ~3))
+
+#define HDR_KEY(h)        ((uint16_t)(h))
+#define HDR_LENGTH(h)     ((uint8_t)((h) >> 16))
+#define HDR_TAG(h)        ((uint8_t)((h) >> 24))
+
+typedef enum {
+  recGood,
+  recBad,               ///< CRC mismatch; skipped
+  recEnd,               ///< Erased: the free part of the page starts here
+  recBroken             ///< Unreadable header word; skipped one word at a time
+} Record_TypeDef;
+
+static uint32_t recordBytes(uint32_t header)
+{
+  return 8 + ((HDR_LENGTH(header) + 3u) & ~3u);
+}
+
+static uint32_t readWord(const KVS_Handle_TypeDef *h, uint32_t location)
+{
+  uint32_t w;
+
+  memcpy(&w, h->flash.base + location, 4);
+  return w;
+}
+
+static uint32_t pageBase(const KVS_Handle_TypeDef *h, uint8_t page)
+{
+  return (uint32_t)page * h->flash.pageSize;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   CRC-32 (IEEE 802.3), four bits at a time.
+ *****************************************************************************/
+static uint32_t crc32(uint32_t crc, const uint8_t *p, uint32_t n)
+{
+  static const uint32_t nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+
+  crc = ~crc;
+  while (n-- > 0) {
+    crc ^= *p++;
+    crc = (crc >> 4) ^ nibble[crc & 15];
+    crc = (crc >> 4) ^ nibble[crc & 15];
+  }
+  return ~crc;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Build a record in RAM.
+ *
+ * @return
+ *   Record size in words.
+ *****************************************************************************/
+static uint32_t buildRecord(uint32_t *words,
+                            uint8_t tag,
+                            uint16_t key,
+                            const void *data,
+                            uint8_t length)
+{
+  uint32_t n = (length + 3u) / 4;
+
+  words[0] = ((uint32_t)tag << 24) | ((uint32_t)length << 16) | key;
+  if (length > 0) {
+    words[n] = ERASED;                  // Pad bytes stay erased
+    memcpy(&words[1], data, length);
+  }
+  words[n + 1] = crc32(0, (const uint8_t *)words, 4 + n * 4);
+  return n + 2;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Check the record at an offset of a page.
+ *****************************************************************************/
+static Record_TypeDef readRecord(const KVS_Handle_TypeDef *h,
+                                 uint8_t page,
+                                 uint32_t offset,
+                                 uint32_t *header)
+{
+  uint32_t location = pageBase(h, page) + offset;
+  uint32_t bytes;
+  uint8_t tag;
+
+  if (offset + 8 > h->flash.pageSize) {
+    return recEnd;
+  }
+  *header = readWord(h, location);
+  if (*header == ERASED) {
+    return recEnd;
+  }
+  tag = HDR_TAG(*header);
+  bytes = recordBytes(*header);
+  if ((tag != TAG_VALUE && tag != TAG_DELETE && tag != TAG_RECLAIM)
+      || HDR_LENGTH(*header) > KVS_MAX_VALUE
+      || offset + bytes > h->flash.pageSize) {
+    return recBroken;
+  }
+  if (crc32(0, h->flash.base + location, bytes - 4)
+      != readWord(h, location + bytes - 4)) {
+    return recBad;
+  }
+  return recGood;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Sequence number of a page, or 0 if its header is not valid.
+ *****************************************************************************/
+static uint32_t pageSeq(const KVS_Handle_TypeDef *h, uint8_t page)
+{
+  uint32_t base = pageBase(h, page);
+  uint32_t seq = readWord(h, base + 4);
+
+  if (readWord(h, base) != PAGE_MAGIC
+      || readWord(h, base + 8) != ~seq
+      || readWord(h, base + 12) != (((uint32_t)h->flash.pages << 24)
+                                    | h->flash.pageSize)
+      || seq == 0 || seq == ERASED) {
+    return 0;
+  }
+  return seq;
+}
+
+// ----------------------------------------------------------------- RAM index
+
+static uint32_t slotOf(uint16_t key)
+{
+  // Fibonacci hashing of the 16-bit key
+  return (uint16_t)(key * 40503u) % KVS_INDEX_SIZE;
+}
+
+static KVS_Entry_TypeDef *find(const KVS_Handle_TypeDef *h, uint16_t key)
+{
+  uint32_t i = slotOf(key);
+
+  while (h->index[i].key != KVS_NO_KEY) {
+    if (h->index[i].key == key) {
+      return (KVS_Entry_TypeDef *)&h->index[i];
+    }
+    i = (i + 1) % KVS_INDEX_SIZE;
+  }
+  return NULL;
+}
+
+static KVS_Entry_TypeDef *insert(KVS_Handle_TypeDef *h, uint16_t key)
+{
+  uint32_t i = slotOf(key);
+
+  if (h->keys == KVS_MAX_KEYS) {
+    return NULL;
+  }
+  while (h->index[i].key != KVS_NO_KEY) {
+    i = (i + 1) % KVS_INDEX_SIZE;
+  }
+  h->index[i].key = key;
+  h->keys++;
+  return &h->index[i];
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Remove an index entry, moving later entries of the probe run back so
+ *   lookups need no deleted markers.
+ *****************************************************************************/
+static void removeEntry(KVS_Handle_TypeDef *h, KVS_Entry_TypeDef *e)
+{
+  uint32_t hole = (uint32_t)(e - h->index);
+  uint32_t i = hole;
+
+  for (;;) {
+    uint32_t home;
+
+    i = (i + 1) % KVS_INDEX_SIZE;
+    if (h->index[i].key == KVS_NO_KEY) {
+      break;
+    }
+    home = slotOf(h->index[i].key);
+    // Move the entry if its home is not between the hole and its slot
+    if ((i > hole && (home <= hole || home > i))
+        || (i < hole && home <= hole && home > i)) {
+      h->index[hole] = h->index[i];
+      hole = i;
+    }
+  }
+  h->index[hole].key = KVS_NO_KEY;
+  h->keys--;
+}
+
+// ------------------------------------------------------------------- pages
+
+static uint8_t freePages(const KVS_Handle_TypeDef *h)
+{
+  uint8_t n = 0;
+  uint8_t p;
+
+  for (p = 0; p < h->flash.pages; p++) {
+    if (h->seq[p] == 0) {
+      n++;
+    }
+  }
+  return n;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Oldest page in use; the active page if it is the only one.
+ *****************************************************************************/
+static uint8_t oldestPage(const KVS_Handle_TypeDef *h)
+{
+  uint8_t oldest = h->active;
+  uint8_t p;
+
+  for (p = 0; p < h->flash.pages; p++) {
+    if (h->seq[p] != 0 && h->seq[p] < h->seq[oldest]) {
+      oldest = p;
+    }
+  }
+  return oldest;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Erase a free page and make it the active page.
+ *****************************************************************************/
+static KVS_Status_TypeDef openPage(KVS_Handle_TypeDef *h)
+{
+  uint32_t header[4];
+  uint8_t p = h->active;
+  uint8_t i;
+
+  // Next free page after the active one, so wear goes round the ring
+  for (i = 0; i < h->flash.pages; i++) {
+    p = (uint8_t)((p + 1) % h->flash.pages);
+    if (h->seq[p] == 0) {
+      break;
+    }
+  }
+  if (h->seq[p] != 0) {
+    return kvsErrFull;
+  }
+
+  h->erases++;
+  if (!h->flash.erase(h->flash.base + pageBase(h, p))) {
+    return kvsErrFlash;
+  }
+  header[0] = PAGE_MAGIC;
+  header[1] = h->nextSeq;
+  header[2] = ~h->nextSeq;
+  header[3] = ((uint32_t)h->flash.pages << 24) | h->flash.pageSize;
+  if (!h->flash.write(h->flash.base + pageBase(h, p), header, 4)) {
+    return kvsErrFlash;
+  }
+  h->programmed += HEADER_BYTES;
+  h->seq[p] = h->nextSeq++;
+  h->active = p;
+  h->writeOffset = HEADER_BYTES;
+  return kvsOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Program words at the end of the active page and read them back.
+ *****************************************************************************/
+static KVS_Status_TypeDef append(KVS_Handle_TypeDef *h,
+                                 const uint32_t *words,
+                                 uint32_t count,
+                                 uint32_t *location)
+{
+  uint32_t at = pageBase(h, h->active) + h->writeOffset;
+
+  if (!h->flash.write(h->flash.base + at, words, count)
+      || memcmp(h->flash.base + at, words, count * 4) != 0) {
+    // Never program over a failed write; continue on a new page
+    h->writeOffset = h->flash.pageSize;
+    return kvsErrFlash;
+  }
+  h->programmed += count * 4;
+  h->writeOffset += count * 4;
+  if (location != NULL) {
+    *location = at;
+  }
+  return kvsOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Make room in the active page for reclaim, using a free page if needed.
+ *****************************************************************************/
+static KVS_Status_TypeDef room(KVS_Handle_TypeDef *h, uint32_t bytes)
+{
+  if (h->writeOffset + bytes <= h->flash.pageSize) {
+    return kvsOk;
+  }
+  if (freePages(h) == 0) {
+    return kvsErrFull;
+  }
+  return openPage(h);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Move up to budget current records out of the oldest page; once none is
+ *   left, record that the page is reclaimed and free it.
+ *
+ * @details
+ *   Deletions in the oldest page are dropped instead of moved, since no
+ *   older record of their key can exist. The reclaim record written at the
+ *   end makes mount ignore the page from then on, even if its erase (done
+ *   when the page is opened again) is interrupted.
+ *****************************************************************************/
+static KVS_Status_TypeDef collect(KVS_Handle_TypeDef *h, uint32_t budget)
+{
+  uint32_t copy[RECORD_MAX_BYTES / 4];
+  uint8_t p = oldestPage(h);
+  KVS_Status_TypeDef status;
+
+  if (p == h->active) {
+    // Nothing to reclaim; with no free page the store cannot go on
+    return freePages(h) == 0 ? kvsErrFull : kvsOk;
+  }
+  if (h->gcPage != p) {
+    h->gcPage = p;
+    h->gcOffset = HEADER_BYTES;
+  }
+
+  while (budget > 0) {
+    uint32_t header;
+    uint32_t location = pageBase(h, p) + h->gcOffset;
+    Record_TypeDef rec = readRecord(h, p, h->gcOffset, &header);
+    KVS_Entry_TypeDef *e;
+
+    if (rec == recBroken) {
+      h->gcOffset += 4;
+      continue;
+    }
+    if (rec == recEnd) {
+      uint32_t n = buildRecord(copy, TAG_RECLAIM, 0, &h->seq[p], 4);
+
+      status = room(h, n * 4);
+      if (status == kvsOk) {
+        status = append(h, copy, n, NULL);
+      }
+      if (status != kvsOk) {
+        return status;
+      }
+      h->seq[p] = 0;
+      h->gcPage = KVS_MAX_PAGES;
+      return kvsOk;
+    }
+    if (rec == recBad || HDR_TAG(header) == TAG_RECLAIM) {
+      h->gcOffset += recordBytes(header);
+      continue;
+    }
+
+    e = find(h, HDR_KEY(header));
+    if (e != NULL && e->location == location) {
+      if (HDR_TAG(header) == TAG_DELETE) {
+        h->liveBytes -= recordBytes(header);
+        removeEntry(h, e);
+      } else {
+        uint32_t bytes = recordBytes(header);
+
+        memcpy(copy, h->flash.base + location, bytes);
+        status = room(h, bytes);
+        if (status == kvsOk) {
+          status = append(h, copy, bytes / 4, &e->location);
+        }
+        if (status != kvsOk) {
+          return status;
+        }
+        h->copies++;
+        budget--;
+      }
+    }
+    h->gcOffset += recordBytes(header);
+  }
+  return kvsOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Make room in the active page for a new record: open a new page and, if
+ *   that took the last free page, reclaim the oldest page completely.
+ *   Collection always frees a page before the ring runs out, provided the
+ *   live records stay within capacity().
+ *****************************************************************************/
+static KVS_Status_TypeDef makeRoom(KVS_Handle_TypeDef *h, uint32_t bytes)
+{
+  KVS_Status_TypeDef status;
+  uint8_t attempt;
+
+  for (attempt = 0; attempt <= h->flash.pages; attempt++) {
+    if (h->writeOffset + bytes <= h->flash.pageSize) {
+      return kvsOk;
+    }
+    if (freePages(h) == 0) {
+      // Finish the reclaim that took the last free page
+      status = collect(h, UINT32_MAX);
+    } else {
+      status = openPage(h);
+      while (status == kvsOk && freePages(h) == 0) {
+        status = collect(h, UINT32_MAX);
+      }
+    }
+    if (status != kvsOk) {
+      return status;
+    }
+  }
+  return kvsErrFull;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Live bytes the store accepts: what always fits when all but one page
+ *   are reclaimed, less room for a new record and a reclaim record.
+ *****************************************************************************/
+static uint32_t capacity(const KVS_Handle_TypeDef *h)
+{
+  return (uint32_t)(h->flash.pages - 1) * (h->flash.pageSize - HEADER_BYTES)
+         - 2 * RECORD_MAX_BYTES;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Mount the store: find the pages in use and build the RAM index.
+ *
+ * @details
+ *   Pages are scanned newest first, so the first record found for a key
+ *   (or the last one within a page) is its current one. Records with a bad
+ *   CRC, such as one cut off by a reset, are skipped. Pages named by a
+ *   reclaim record are free. If no page is in use, the store is formatted.
+ *   Reads never scan flash after this.
+ *****************************************************************************/
+KVS_Status_TypeDef KVS_Mount(KVS_Handle_TypeDef *handle,
+                             const KVS_Flash_TypeDef *flash)
+{
+  uint32_t visited = 0;
+  uint32_t reclaimed = 0;
+  bool haveActive = false;
+  uint32_t i;
+  uint8_t p;
+
+  memset(handle, 0, sizeof(*handle));
+  handle->flash = *flash;
+  handle->gcPage = KVS_MAX_PAGES;
+  handle->nextSeq = 1;
+  for (i = 0; i < KVS_INDEX_SIZE; i++) {
+    handle->index[i].key = KVS_NO_KEY;
+  }
+  if (flash->pages < 2 || flash->pages > KVS_MAX_PAGES
+      || flash->pageSize % 4 != 0 || flash->pageSize > 0xFFFFFF
+      || flash->pageSize < HEADER_BYTES + 4 * RECORD_MAX_BYTES) {
+    return kvsErrConfig;
+  }
+
+  for (p = 0; p < flash->pages; p++) {
+    handle->seq[p] = pageSeq(handle, p);
+    if (handle->seq[p] >= handle->nextSeq) {
+      handle->nextSeq = handle->seq[p] + 1;
+    }
+  }
+
+  for (;;) {
+    uint8_t newest = KVS_MAX_PAGES;
+    uint32_t offset = HEADER_BYTES;
+
+    for (p = 0; p < flash->pages; p++) {
+      if (handle->seq[p] != 0 && !(visited & (1UL << p))
+          && (newest == KVS_MAX_PAGES || handle->seq[p] > handle->seq[newest])) {
+        newest = p;
+      }
+    }
+    if (newest == KVS_MAX_PAGES) {
+      break;
+    }
+    p = newest;
+    visited |= 1UL << p;
+    if (handle->seq[p] <= reclaimed) {
+      handle->seq[p] = 0;
+      continue;
+    }
+    if (!haveActive) {
+      handle->active = p;
+      haveActive = true;
+    }
+
+    for (;;) {
+      uint32_t header;
+      uint32_t location = pageBase(handle, p) + offset;
+      Record_TypeDef rec = readRecord(handle, p, offset, &header);
+      KVS_Entry_TypeDef *e;
+
+      if (rec == recBroken) {
+        // Such as a header cut off by a reset; what follows is erased
+        handle->corrupt++;
+        offset += 4;
+        continue;
+      }
+      if (rec == recEnd) {
+        if (p == handle->active) {
+          handle->writeOffset = offset;
+        }
+        break;
+      }
+      offset += recordBytes(header);
+      if (rec == recBad) {
+        handle->corrupt++;
+        continue;
+      }
+
+      if (HDR_TAG(header) == TAG_RECLAIM) {
+        uint32_t seq = readWord(handle, location + 4);
+
+        if (seq > reclaimed && seq < handle->seq[p]) {
+          reclaimed = seq;
+        }
+        continue;
+      }
+      e = find(handle, HDR_KEY(header));
+      if (e == NULL) {
+        e = insert(handle, HDR_KEY(header));
+        if (e == NULL) {
+          return kvsErrFull;
+        }
+      } else if (e->location / flash->pageSize != p) {
+        continue;                     // A newer page has this key
+      }
+      e->location = location;
+    }
+  }
+
+  for (i = 0; i < KVS_INDEX_SIZE; i++) {
+    if (handle->index[i].key != KVS_NO_KEY) {
+      handle->liveBytes += recordBytes(readWord(handle,
+                                                handle->index[i].location));
+    }
+  }
+
+  if (!haveActive) {
+    KVS_Status_TypeDef status;
+
+    handle->active = (uint8_t)(flash->pages - 1);
+    handle->sessions++;
+    flash->begin();
+    status = openPage(handle);
+    flash->end();
+    return status;
+  }
+  return kvsOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Read a value through the RAM index.
+ *
+ * @param[out] length
+ *   Value length; also set when the buffer is too small. May be NULL.
+ *****************************************************************************/
+KVS_Status_TypeDef KVS_Get(const KVS_Handle_TypeDef *handle,
+                           uint16_t key,
+                           void *data,
+                           uint8_t size,
+                           uint8_t *length)
+{
+  const KVS_Entry_TypeDef *e = find(handle, key);
+  uint32_t header;
+
+  if (e == NULL) {
+    return kvsErrNotFound;
+  }
+  header = readWord(handle, e->location);
+  if (HDR_TAG(header) != TAG_VALUE) {
+    return kvsErrNotFound;
+  }
+  if (length != NULL) {
+    *length = HDR_LENGTH(header);
+  }
+  if (HDR_LENGTH(header) > size) {
+    return kvsErrTooLong;
+  }
+  if (HDR_LENGTH(header) > 0) {
+    memcpy(data, handle->flash.base + e->location + 4, HDR_LENGTH(header));
+  }
+  return kvsOk;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Records collected in RAM, programmed together at the end of the active
+ *   page.
+ *****************************************************************************/
+typedef struct {
+  uint32_t words[KVS_STAGE_WORDS];
+  uint32_t count;
+  uint16_t key[KVS_STAGE_WORDS / 2];
+  uint16_t offset[KVS_STAGE_WORDS / 2];   // Words into the stage
+  uint8_t  records;
+  uint8_t  newKeys;
+} Stage_TypeDef;
+
+/**************************************************************************//**
+ * @brief
+ *   Program the staged records with one write and point the index at them.
+ *****************************************************************************/
+static KVS_Status_TypeDef flush(KVS_Handle_TypeDef *h, Stage_TypeDef *st)
+{
+  KVS_Status_TypeDef status;
+  uint32_t at;
+  uint8_t i;
+
+  if (st->count == 0) {
+    return kvsOk;
+  }
+  status = append(h, st->words, st->count, &at);
+  for (i = 0; status == kvsOk && i < st->records; i++) {
+    KVS_Entry_TypeDef *e = find(h, st->key[i]);
+
+    if (e != NULL) {
+      h->liveBytes -= recordBytes(readWord(h, e->location));
+    } else {
+      e = insert(h, st->key[i]);
+    }
+    e->location = at + st->offset[i] * 4u;
+    h->liveBytes += recordBytes(st->words[st->offset[i]]);
+  }
+  st->count = 0;
+  st->records = 0;
+  st->newKeys = 0;
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Write several values and deletions in one flash session.
+ *
+ * @details
+ *   The records are collected in RAM and programmed with one write per
+ *   page they go to, between one begin() and end() (MSC_Init() and
+ *   MSC_Deinit() on the target). Values equal to the stored ones and
+ *   deletions of absent keys are not written. After a reset during the
+ *   call, each item is either written or not; the batch is not atomic.
+ *****************************************************************************/
+KVS_Status_TypeDef KVS_SetMany(KVS_Handle_TypeDef *handle,
+                               const KVS_Item_TypeDef *items,
+                               uint8_t count)
+{
+  static Stage_TypeDef stage;
+  KVS_Status_TypeDef status = kvsOk;
+  int32_t staged = 0;                   // Live bytes the stage adds
+  uint8_t i;
+  uint8_t j;
+
+  stage.count = 0;
+  stage.records = 0;
+  stage.newKeys = 0;
+  handle->sessions++;
+  handle->flash.begin();
+
+  // A reclaim cut short by a reset owns the room left in the active page
+  while (status == kvsOk && freePages(handle) == 0) {
+    status = collect(handle, UINT32_MAX);
+  }
+
+  for (i = 0; status == kvsOk && i < count; i++) {
+    const KVS_Item_TypeDef *it = &items[i];
+    const KVS_Entry_TypeDef *e;
+    uint32_t header = 0;
+    uint32_t bytes;
+    uint32_t replaced = 0;
+
+    if (it->key == KVS_NO_KEY) {
+      status = kvsErrConfig;
+      break;
+    }
+    if (it->data != NULL && it->length > KVS_MAX_VALUE) {
+      status = kvsErrTooLong;
+      break;
+    }
+
+    // A key already staged is decided against the flushed state
+    for (j = 0; j < stage.records; j++) {
+      if (stage.key[j] == it->key) {
+        status = flush(handle, &stage);
+        staged = 0;
+        break;
+      }
+    }
+    if (status != kvsOk) {
+      break;
+    }
+
+    e = find(handle, it->key);
+    if (e != NULL) {
+      header = readWord(handle, e->location);
+      replaced = recordBytes(header);
+    }
+    if (it->data == NULL) {
+      if (e == NULL || HDR_TAG(header) != TAG_VALUE) {
+        continue;
+      }
+    } else if (e != NULL && HDR_TAG(header) == TAG_VALUE
+               && HDR_LENGTH(header) == it->length
+               && memcmp(handle->flash.base + e->location + 4, it->data,
+                         it->length) == 0) {
+      continue;
+    }
+
+    bytes = it->data == NULL ? 8 : 8 + ((it->length + 3u) & ~3u);
+    if ((int32_t)(handle->liveBytes + bytes - replaced) + staged
+        > (int32_t)capacity(handle)
+        || (e == NULL && handle->keys + stage.newKeys >= KVS_MAX_KEYS)) {
+      status = kvsErrFull;
+      break;
+    }
+
+    // Program what is staged if this record does not join it
+    if (stage.count + bytes / 4 > KVS_STAGE_WORDS
+        || handle->writeOffset + (stage.count * 4) + bytes
+        > handle->flash.pageSize) {
+      status = flush(handle, &stage);
+      staged = 0;
+      if (status == kvsOk) {
+        status = makeRoom(handle, bytes);
+      }
+      if (status != kvsOk) {
+        break;
+      }
+    }
+
+    stage.key[stage.records] = it->key;
+    stage.offset[stage.records] = (uint16_t)stage.count;
+    stage.records++;
+    stage.newKeys += e == NULL;
+    stage.count += buildRecord(&stage.words[stage.count],
+                               it->data == NULL ? TAG_DELETE : TAG_VALUE,
+                               it->key, it->data,
+                               it->data == NULL ? 0 : it->length);
+    staged += (int32_t)(bytes - replaced);
+  }
+
+  if (status == kvsOk) {
+    status = flush(handle, &stage);
+  }
+  handle->flash.end();
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Write one value.
+ *****************************************************************************/
+KVS_Status_TypeDef KVS_Set(KVS_Handle_TypeDef *handle,
+                           uint16_t key,
+                           const void *data,
+                           uint8_t length)
+{
+  KVS_Item_TypeDef item = { key, data, length };
+
+  if (data == NULL) {
+    return kvsErrConfig;
+  }
+  return KVS_SetMany(handle, &item, 1);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Delete a key.
+ *****************************************************************************/
+KVS_Status_TypeDef KVS_Delete(KVS_Handle_TypeDef *handle, uint16_t key)
+{
+  KVS_Item_TypeDef item = { key, NULL, 0 };
+  const KVS_Entry_TypeDef *e = find(handle, key);
+
+  if (e == NULL || HDR_TAG(readWord(handle, e->location)) != TAG_VALUE) {
+    return kvsErrNotFound;
+  }
+  return KVS_SetMany(handle, &item, 1);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Whether reclaiming the oldest page is worth running: at most one page
+ *   is free, so the next full page would otherwise reclaim a whole page at
+ *   once.
+ *****************************************************************************/
+bool KVS_CollectDue(const KVS_Handle_TypeDef *handle)
+{
+  return freePages(handle) <= 1 && oldestPage(handle) != handle->active;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Move up to budget records out of the oldest page, from idle time.
+ *
+ * @details
+ *   A page is reclaimed over as many calls as it takes; records written in
+ *   between are unaffected. Call while KVS_CollectDue() is true.
+ *****************************************************************************/
+KVS_Status_TypeDef KVS_Collect(KVS_Handle_TypeDef *handle, uint32_t budget)
+{
+  KVS_Status_TypeDef status;
+
+  if (!KVS_CollectDue(handle)) {
+    return kvsOk;
+  }
+  handle->sessions++;
+  handle->flash.begin();
+  status = collect(handle, budget);
+  handle->flash.end();
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Bytes of new records the store still accepts.
+ *****************************************************************************/
+uint32_t KVS_Free(const KVS_Handle_TypeDef *handle)
+{
+  uint32_t limit = capacity(handle);
+
+  return handle->liveBytes < limit ? limit - handle->liveBytes : 0;
+}
@@ -0,0 +1,148 @@
+/***************************************************************************//**
+ * @file kvs.h
+ * @brief Key-value store in internal flash: append-only records in a ring of
+ * pages, a RAM index and incremental page reclaim.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef KVS_H
+#define KVS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Most flash pages in the store
+#define KVS_MAX_PAGES       8
+
+/// Longest value in bytes
+#define KVS_MAX_VALUE       128
+
+/// Keys held by the RAM index, including deleted keys not yet reclaimed
+#define KVS_MAX_KEYS        192
+
+/// RAM index slots; a power of two, a third larger than KVS_MAX_KEYS
+#define KVS_INDEX_SIZE      256
+
+/// Records collected in RAM and programmed with one write
+#define KVS_STAGE_WORDS     128
+
+/// Key value reserved for empty index slots
+#define KVS_NO_KEY          0xFFFF
+
+/// Result of store operations
+typedef enum {
+  kvsOk,
+  kvsErrNotFound,       ///< Key not present or deleted
+  kvsErrTooLong,        ///< Value longer than KVS_MAX_VALUE or the buffer
+  kvsErrFull,           ///< Out of flash capacity or index slots
+  kvsErrFlash,          ///< Erase or write failed, or read back wrong
+  kvsErrConfig          ///< Bad key or flash geometry
+} KVS_Status_TypeDef;
+
+/// Flash pages of the store and how to program them
+typedef struct {
+  uint8_t  *base;                 ///< First page, memory-mapped for reads
+  uint32_t pageSize;              ///< Bytes
+  uint8_t  pages;                 ///< 2 to KVS_MAX_PAGES; 3 or more for
+                                  ///< incremental reclaim
+  bool (*erase)(uint8_t *page);
+  bool (*write)(uint8_t *address, const uint32_t *words, uint32_t count);
+  void (*begin)(void);            ///< Before erasing and writing
+  void (*end)(void);              ///< After erasing and writing
+} KVS_Flash_TypeDef;
+
+/// One write of a batch; a NULL data pointer deletes the key
+typedef struct {
+  uint16_t   key;
+  const void *data;
+  uint8_t    length;
+} KVS_Item_TypeDef;
+
+/// RAM index slot: where the newest record of a key is
+typedef struct {
+  uint16_t key;
+  uint32_t location;              ///< Byte offset from flash.base
+} KVS_Entry_TypeDef;
+
+/// Store state; all fields are read-only for the application
+typedef struct {
+  KVS_Flash_TypeDef flash;
+  KVS_Entry_TypeDef index[KVS_INDEX_SIZE];
+  uint16_t          keys;         ///< Index slots in use
+  uint32_t          seq[KVS_MAX_PAGES]; ///< Page sequence, 0 if free
+  uint32_t          nextSeq;
+  uint8_t           active;       ///< Page being appended to
+  uint32_t          writeOffset;  ///< Next record in the active page
+  uint8_t           gcPage;       ///< Page being reclaimed, or KVS_MAX_PAGES
+  uint32_t          gcOffset;     ///< Next record to look at in it
+  uint32_t          liveBytes;    ///< Flash taken by current records
+
+  uint32_t sessions;              ///< begin()/end() pairs
+  uint32_t programmed;            ///< Bytes written
+  uint32_t erases;                ///< Pages erased
+  uint32_t copies;                ///< Records moved by reclaim
+  uint32_t corrupt;               ///< Records skipped at mount
+} KVS_Handle_TypeDef;
+
+KVS_Status_TypeDef KVS_Mount(KVS_Handle_TypeDef *handle,
+                             const KVS_Flash_TypeDef *flash);
+KVS_Status_TypeDef KVS_Get(const KVS_Handle_TypeDef *handle,
+                           uint16_t key,
+                           void *data,
+                           uint8_t size,
+                           uint8_t *length);
+KVS_Status_TypeDef KVS_Set(KVS_Handle_TypeDef *handle,
+                           uint16_t key,
+                           const void *data,
+                           uint8_t length);
+KVS_Status_TypeDef KVS_Delete(KVS_Handle_TypeDef *handle, uint16_t key);
+KVS_Status_TypeDef KVS_SetMany(KVS_Handle_TypeDef *handle,
+                               const KVS_Item_TypeDef *items,
+                               uint8_t count);
+bool KVS_CollectDue(const KVS_Handle_TypeDef *handle);
+KVS_Status_TypeDef KVS_Collect(KVS_Handle_TypeDef *handle, uint32_t budget);
+uint32_t KVS_Free(const KVS_Handle_TypeDef *handle);
+
+#if !defined(KVS_HOST)
+void KVS_FlashMsc(KVS_Flash_TypeDef *flash, uint8_t pages);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KVS_H
@@ -0,0 +1,133 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Key-value store in the last pages of main flash, kept across resets.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_msc.h"
+
+#include "kvs.h"
+
+// Flash pages given to the store, taken from the end of main flash
+#define KVS_PAGES         3
+
+// Keys used by this example
+#define KEY_BOOT_COUNT    1
+#define KEY_GAIN          2
+#define KEY_OFFSET        3
+#define KEY_NAME          4
+#define KEY_READING       10
+
+// Updates of the reading written on each boot
+#define UPDATES           1000
+
+KVS_Handle_TypeDef store;
+KVS_Status_TypeDef mountStatus;
+
+// Values read back; inspect them in the debugger
+uint32_t bootCount;
+int16_t gain;
+int16_t offset;
+char name[16];
+uint32_t reading;
+uint32_t writeErrors;
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  KVS_Flash_TypeDef flash;
+  uint32_t i;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Enable MSC Clock
+  CMU_ClockEnable(cmuClock_MSC, true);
+
+  // Find the store's pages in use and index their records
+  KVS_FlashMsc(&flash, KVS_PAGES);
+  mountStatus = KVS_Mount(&store, &flash);
+
+  // Count boots; the value survives resets and power cycles
+  if (KVS_Get(&store, KEY_BOOT_COUNT, &bootCount, sizeof(bootCount), NULL)
+      != kvsOk) {
+    bootCount = 0;
+  }
+  bootCount++;
+  KVS_Set(&store, KEY_BOOT_COUNT, &bootCount, sizeof(bootCount));
+
+  // Write the default configuration in one flash session on the first boot
+  if (KVS_Get(&store, KEY_GAIN, &gain, sizeof(gain), NULL) != kvsOk) {
+    static const int16_t defaultGain = 256;
+    static const int16_t defaultOffset = -12;
+    static const char defaultName[] = "sensor-1";
+    const KVS_Item_TypeDef defaults[] = {
+      { KEY_GAIN, &defaultGain, sizeof(defaultGain) },
+      { KEY_OFFSET, &defaultOffset, sizeof(defaultOffset) },
+      { KEY_NAME, defaultName, sizeof(defaultName) },
+    };
+
+    KVS_SetMany(&store, defaults, sizeof(defaults) / sizeof(defaults[0]));
+  }
+  KVS_Get(&store, KEY_GAIN, &gain, sizeof(gain), NULL);
+  KVS_Get(&store, KEY_OFFSET, &offset, sizeof(offset), NULL);
+  KVS_Get(&store, KEY_NAME, name, sizeof(name), NULL);
+
+  /*
+   * Update a reading many times.  Each update appends a record; between
+   * updates, idle time moves a few records out of the oldest page so no
+   * update has to wait for a whole page to be reclaimed.
+   */
+  for (i = 0; i < UPDATES; i++) {
+    reading = bootCount * UPDATES + i;
+    if (KVS_Set(&store, KEY_READING, &reading, sizeof(reading)) != kvsOk) {
+      writeErrors++;
+    }
+    if (KVS_CollectDue(&store)) {
+      KVS_Collect(&store, 2);
+    }
+  }
+
+  // Mount again as after a reset and read the last reading back
+  mountStatus = KVS_Mount(&store, &flash);
+  KVS_Get(&store, KEY_READING, &reading, sizeof(reading), NULL);
+
+  // Infinite Loop
+  while (1);
+}
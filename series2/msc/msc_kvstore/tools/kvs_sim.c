@@ -0,0 +1,537 @@
+/***************************************************************************//**
+ * @file kvs_sim.c
+ * @brief Host test and benchmark for the flash key-value store, with a
+ * flash model and power-loss injection.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DKVS_HOST -I../src -o kvs_sim kvs_sim.c ../src/kvs.c
+ *   ./kvs_sim
+ *
+ * The flash model programs words by AND-ing them in and reports any word
+ * programmed twice between erases. Power loss is injected after a random
+ * number of programmed words: the word being programmed gets only some of
+ * its bits, an erase in progress leaves the page partly erased, and the
+ * store is mounted again from what is left. A reference copy of the data
+ * checks every key after each reset. The exit status is non-zero if a
+ * check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "kvs.h"
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// ---------------------------------------------------------------- flash model
+#define FLASH_BYTES   (KVS_MAX_PAGES * 8192)
+
+static uint8_t flash[FLASH_BYTES];
+static uint32_t pageSize;
+static uint32_t cutAfter;       // Words until power is lost; 0 = never
+static int dead;                // Power lost: all operations fail
+static uint32_t doubleWrites;
+static int depth;               // begin()/end() nesting
+static uint32_t rng = 12345;
+
+static uint32_t rnd(void)
+{
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+// Count one word of flash work; true if power is lost on it
+static int cut(void)
+{
+  if (cutAfter != 0 && --cutAfter == 0) {
+    dead = 1;
+  }
+  return dead;
+}
+
+static bool modelErase(uint8_t *page)
+{
+  uint32_t i;
+
+  check(depth == 1, "erase inside begin()/end()");
+  if (dead) {
+    return false;
+  }
+  for (i = 0; i < pageSize; i += 4) {
+    if (cut()) {
+      // Part of the page erased, the rest keeps its old contents
+      while (i < pageSize) {
+        if (rnd() & 1) {
+          memset(page + i, 0xFF, 4);
+        }
+        i += 4;
+      }
+      return false;
+    }
+  }
+  memset(page, 0xFF, pageSize);
+  return true;
+}
+
+static bool modelWrite(uint8_t *address, const uint32_t *words, uint32_t count)
+{
+  uint32_t i;
+
+  check(depth == 1, "write inside begin()/end()");
+  if (dead) {
+    return false;
+  }
+  for (i = 0; i < count; i++) {
+    uint32_t old;
+    uint32_t w = words[i];
+
+    memcpy(&old, address + 4 * i, 4);
+    if (old != 0xFFFFFFFFUL) {
+      doubleWrites++;
+    }
+    if (cut()) {
+      w |= rnd();                     // Only some bits programmed
+    }
+    old &= w;
+    memcpy(address + 4 * i, &old, 4);
+    if (dead) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static uint32_t sessions;
+
+static void modelBegin(void)
+{
+  depth++;
+  sessions++;
+}
+
+static void modelEnd(void)
+{
+  depth--;
+}
+
+static KVS_Flash_TypeDef geometry(uint32_t size, uint8_t pages)
+{
+  KVS_Flash_TypeDef f = {
+    flash, size, pages, modelErase, modelWrite, modelBegin, modelEnd
+  };
+
+  pageSize = size;
+  return f;
+}
+
+static void blank(void)
+{
+  memset(flash, 0xFF, sizeof(flash));
+  dead = 0;
+  cutAfter = 0;
+  doubleWrites = 0;
+}
+
+// ---------------------------------------------------------------- reference
+#define KEYS 160
+
+typedef struct {
+  int     present;
+  uint8_t length;
+  uint8_t data[KVS_MAX_VALUE];
+} Ref;
+
+static Ref ref[KEYS];
+static KVS_Handle_TypeDef store;
+
+static int matches(uint16_t key, const Ref *r)
+{
+  uint8_t buf[KVS_MAX_VALUE];
+  uint8_t length;
+  KVS_Status_TypeDef st = KVS_Get(&store, key, buf, sizeof(buf), &length);
+
+  if (!r->present) {
+    return st == kvsErrNotFound;
+  }
+  return st == kvsOk && length == r->length
+         && memcmp(buf, r->data, length) == 0;
+}
+
+static int checkAll(void)
+{
+  uint16_t k;
+
+  for (k = 0; k < KEYS; k++) {
+    if (!matches(k, &ref[k])) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void randomValue(Ref *r)
+{
+  uint8_t i;
+
+  r->present = 1;
+  r->length = (uint8_t)(rnd() % 4 == 0 ? rnd() % (KVS_MAX_VALUE + 1)
+                                       : rnd() % 24);
+  for (i = 0; i < r->length; i++) {
+    r->data[i] = (uint8_t)rnd();
+  }
+}
+
+/*
+ * After a failed batch each key holds its old value or one of the values
+ * the batch gave it; adopt what it holds.
+ */
+static uint32_t adopt(const uint16_t *keys, const Ref *next, uint8_t n)
+{
+  uint32_t bad = 0;
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0; i < n; i++) {
+    if (matches(keys[i], &ref[keys[i]])) {
+      continue;
+    }
+    for (j = 0; j < n; j++) {
+      if (keys[j] == keys[i] && matches(keys[i], &next[j])) {
+        ref[keys[i]] = next[j];
+        break;
+      }
+    }
+    bad += j == n;
+  }
+  return bad;
+}
+
+// ---------------------------------------------------------------- tests
+static void testBasics(void)
+{
+  KVS_Flash_TypeDef f = geometry(2048, 3);
+  uint8_t buf[KVS_MAX_VALUE + 1];
+  uint8_t length;
+  uint32_t programmed;
+  KVS_Item_TypeDef batch[16];
+  uint32_t data[16];
+  uint32_t i;
+
+  blank();
+  check(KVS_Mount(&store, &f) == kvsOk, "blank flash formats");
+  check(KVS_Get(&store, 1, buf, sizeof(buf), &length) == kvsErrNotFound,
+        "empty store");
+  check(KVS_Set(&store, 1, "hello", 5) == kvsOk, "set");
+  check(KVS_Get(&store, 1, buf, sizeof(buf), &length) == kvsOk
+        && length == 5 && memcmp(buf, "hello", 5) == 0, "get");
+  check(KVS_Get(&store, 1, buf, 4, &length) == kvsErrTooLong && length == 5,
+        "buffer too small reports the length");
+  check(KVS_Set(&store, 1, "", 0) == kvsOk
+        && KVS_Get(&store, 1, buf, sizeof(buf), &length) == kvsOk
+        && length == 0, "empty value");
+  check(KVS_Set(&store, 2, buf, KVS_MAX_VALUE) == kvsOk, "longest value");
+  check(KVS_Set(&store, 2, buf, KVS_MAX_VALUE + 1) == kvsErrTooLong,
+        "value too long");
+  check(KVS_Set(&store, KVS_NO_KEY, buf, 1) == kvsErrConfig, "reserved key");
+
+  programmed = store.programmed;
+  check(KVS_Set(&store, 2, buf, KVS_MAX_VALUE) == kvsOk
+        && store.programmed == programmed, "unchanged value not written");
+  check(KVS_Delete(&store, 2) == kvsOk
+        && KVS_Get(&store, 2, buf, sizeof(buf), &length) == kvsErrNotFound,
+        "delete");
+  check(KVS_Delete(&store, 2) == kvsErrNotFound, "delete of an absent key");
+
+  check(KVS_Mount(&store, &f) == kvsOk
+        && KVS_Get(&store, 1, buf, sizeof(buf), &length) == kvsOk
+        && length == 0
+        && KVS_Get(&store, 2, buf, sizeof(buf), &length) == kvsErrNotFound,
+        "remount keeps values and deletions");
+
+  // A batch is one flash session and one write per page
+  for (i = 0; i < 16; i++) {
+    data[i] = i;
+    batch[i].key = (uint16_t)(100 + i);
+    batch[i].data = &data[i];
+    batch[i].length = sizeof(data[i]);
+  }
+  sessions = 0;
+  programmed = store.programmed;
+  check(KVS_SetMany(&store, batch, 16) == kvsOk && sessions == 1,
+        "batch in one session");
+  check(store.programmed - programmed == 16 * 12, "batch record sizes");
+  for (i = 0; i < 16; i++) {
+    uint32_t v;
+
+    check(KVS_Get(&store, (uint16_t)(100 + i), &v, sizeof(v), &length) == kvsOk
+          && v == i, "batch values");
+  }
+
+  // Full store refuses writes and stays readable
+  for (i = 0; i < 200 && KVS_Set(&store, (uint16_t)(200 + i), buf, 100) == kvsOk;
+       i++) {
+  }
+  check(i < 200, "full store refuses writes");
+  check(KVS_Get(&store, 1, buf, sizeof(buf), &length) == kvsOk,
+        "full store readable");
+  check(KVS_Delete(&store, 200) == kvsOk
+        && KVS_Set(&store, 200, buf, 100) == kvsOk, "delete frees room");
+  check(KVS_Mount(&store, &f) == kvsOk
+        && KVS_Get(&store, 200, buf, sizeof(buf), &length) == kvsOk
+        && length == 100, "full store remounts");
+  check(doubleWrites == 0, "no word programmed twice");
+
+  f.pages = 1;
+  check(KVS_Mount(&store, &f) == kvsErrConfig, "one page rejected");
+}
+
+// Random writes, deletes, batches and idle collection with power cuts
+static void testPowerLoss(uint32_t size, uint8_t pages, uint16_t keyCount,
+                          uint32_t cuts)
+{
+  KVS_Flash_TypeDef f = geometry(size, pages);
+  uint32_t resets = 0;
+  uint32_t ops = 0;
+  uint32_t full = 0;
+  uint32_t bad = 0;
+  uint32_t erasesTotal = 0;
+  uint16_t k;
+
+  blank();
+  memset(ref, 0, sizeof(ref));
+  check(KVS_Mount(&store, &f) == kvsOk, "format");
+
+  while (resets < cuts) {
+    Ref next[8];
+    uint16_t keys[8];
+    KVS_Item_TypeDef items[8];
+    uint8_t n;
+    uint8_t i;
+    KVS_Status_TypeDef st;
+
+    // Power is lost within the next few thousand words, sometimes
+    if (cutAfter == 0 && rnd() % 16 == 0) {
+      cutAfter = 1 + rnd() % 3000;
+    }
+
+    if (rnd() % 8 == 0 && KVS_CollectDue(&store)) {
+      st = KVS_Collect(&store, 1 + rnd() % 4);
+      n = 0;
+    } else {
+      n = (uint8_t)(rnd() % 4 == 0 ? 2 + rnd() % 7 : 1);
+      for (i = 0; i < n; i++) {
+        keys[i] = (uint16_t)(rnd() % keyCount);
+        next[i] = ref[keys[i]];
+        if (rnd() % 5 == 0) {
+          next[i].present = 0;
+        } else {
+          randomValue(&next[i]);
+        }
+        items[i].key = keys[i];
+        items[i].data = next[i].present ? next[i].data : NULL;
+        items[i].length = next[i].length;
+      }
+      st = KVS_SetMany(&store, items, n);
+      ops++;
+    }
+
+    if (st == kvsOk) {
+      for (i = 0; i < n; i++) {
+        ref[keys[i]] = next[i];
+      }
+      // Later items of a batch win over earlier ones with the same key
+      continue;
+    }
+    check(st == kvsErrFlash || st == kvsErrFull, "error status");
+    if (st == kvsErrFull && !dead) {
+      // Items before the one that did not fit may be written; make room
+      bad += adopt(keys, next, n);
+      for (k = 0; k < keyCount; k++) {
+        if (ref[k].present && rnd() % 2 == 0
+            && KVS_Delete(&store, k) == kvsOk) {
+          ref[k].present = 0;
+        }
+      }
+      if (++full > 5000) {
+        check(0, "store does not stay full after deletions");
+        return;
+      }
+      continue;
+    }
+
+    // Power lost: mount what is left
+    resets++;
+    erasesTotal += store.erases;
+    dead = 0;
+    cutAfter = 0;
+    if (KVS_Mount(&store, &f) != kvsOk) {
+      check(0, "mount after power loss");
+      return;
+    }
+
+    // Keys of the interrupted batch hold the old or a new value
+    bad += adopt(keys, next, n);
+    for (k = 0; k < keyCount; k++) {
+      if (!matches(k, &ref[k])) {
+        bad++;
+        ref[k].present = 0;
+      }
+    }
+  }
+
+  check(bad == 0, "every key holds its last or interrupted value after resets");
+  check(doubleWrites == 0, "no word programmed twice");
+  check(checkAll(), "final contents");
+  printf("power loss, %u pages of %u bytes, %u keys: %u operations, "
+         "%u resets, %u erases, %u times full\n", pages, (unsigned)size,
+         keyCount, (unsigned)ops, (unsigned)resets,
+         (unsigned)(erasesTotal + store.erases), (unsigned)full);
+}
+
+// Idle collection keeps writes from reclaiming whole pages
+static void testIncremental(void)
+{
+  KVS_Flash_TypeDef f = geometry(2048, 4);
+  uint32_t maxCopies = 0;
+  uint32_t i;
+  uint32_t v;
+
+  blank();
+  KVS_Mount(&store, &f);
+  for (i = 0; i < 5000; i++) {
+    uint32_t before = store.copies;
+
+    v = i;
+    KVS_Set(&store, (uint16_t)(i % 40), &v, sizeof(v));
+    if (store.copies - before > maxCopies) {
+      maxCopies = store.copies - before;
+    }
+    if (KVS_CollectDue(&store)) {
+      KVS_Collect(&store, 2);
+    }
+  }
+  check(maxCopies == 0, "no write waits for reclaim with idle collection");
+  check(KVS_Mount(&store, &f) == kvsOk, "remount");
+  for (i = 0; i < 40; i++) {
+    check(KVS_Get(&store, (uint16_t)i, &v, sizeof(v), NULL) == kvsOk
+          && v == 4960 + i, "values after incremental collection");
+  }
+}
+
+// Mount time against the number of records in flash
+static void benchmark(void)
+{
+  static const uint32_t counts[] = { 250, 500, 1000, 2000, 3500 };
+  KVS_Flash_TypeDef f = geometry(8192, 8);
+  uint8_t value[8] = { 0 };
+  uint32_t c;
+  uint32_t i;
+  uint32_t runs = 200;
+  uint32_t r;
+  clock_t t0;
+  volatile uint32_t sink = 0;
+
+  for (c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+    blank();
+    KVS_Mount(&store, &f);
+    for (i = 0; i < counts[c]; i++) {
+      value[0] = (uint8_t)i;
+      value[1] = (uint8_t)(i >> 8);
+      KVS_Set(&store, (uint16_t)(i % 150), value, sizeof(value));
+    }
+    t0 = clock();
+    for (r = 0; r < runs; r++) {
+      KVS_Mount(&store, &f);
+    }
+    printf("mount with %4u records: %6.1f us", (unsigned)counts[c],
+           (double)(clock() - t0) * 1e6 / CLOCKS_PER_SEC / runs);
+    t0 = clock();
+    for (r = 0; r < 1000000; r++) {
+      uint8_t out[8];
+
+      KVS_Get(&store, (uint16_t)(r % 150), out, sizeof(out), NULL);
+      sink += out[0];
+    }
+    printf(", get %.0f ns\n",
+           (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC / 1000000);
+  }
+  check(store.copies == 0, "benchmark records all in flash");
+  (void)sink;
+
+  // Flash sessions: single writes against a batch
+  blank();
+  KVS_Mount(&store, &f);
+  sessions = 0;
+  for (i = 0; i < 16; i++) {
+    KVS_Set(&store, (uint16_t)i, &i, sizeof(i));
+  }
+  printf("16 values: %u sessions with KVS_Set()", (unsigned)sessions);
+  {
+    KVS_Item_TypeDef batch[16];
+    uint32_t data[16];
+
+    for (i = 0; i < 16; i++) {
+      data[i] = i + 1;
+      batch[i].key = (uint16_t)i;
+      batch[i].data = &data[i];
+      batch[i].length = sizeof(data[i]);
+    }
+    sessions = 0;
+    KVS_SetMany(&store, batch, 16);
+  }
+  printf(", %u with KVS_SetMany()\n", (unsigned)sessions);
+}
+
+int main(void)
+{
+  testBasics();
+  testPowerLoss(2048, 2, 48, 300);
+  testPowerLoss(2048, 3, 150, 300);
+  testPowerLoss(1024, 5, 60, 300);
+  testIncremental();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures != 0;
+}
@@ -0,0 +1,246 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Example that estimates quadrature encoder position, velocity and
+ * acceleration from PCNT counts copied by the LDMA at a fixed rate.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_device.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_pcnt.h"
+#include "em_prs.h"
+#include "mx25flash_spi.h"
+#include "bsp.h"
+#include "qdec.h"
+
+// PRS channels to use for GPIO/PCNT
+#define PCNT_PRS_Ch0    0
+#define PCNT_PRS_Ch1    1
+
+// LDMA channel copying PCNT0->CNT into the snapshot ring
+#define SNAPSHOT_LDMA_CH  0
+
+// Snapshots per CPU wake-up is half the ring: 32 ms at 1 kHz
+#define SNAPSHOT_RING   64
+
+/*******************************************************************************
+ **************************   GLOBAL VARIABLES   *******************************
+ ******************************************************************************/
+
+// Written by the LDMA only
+static volatile uint32_t snapshotRing[SNAPSHOT_RING];
+
+// Watch these in the debugger
+QDEC_Handle_TypeDef qdec;
+uint32_t batchCount = 0;
+
+/***************************************************************************//**
+ * @brief escapeHatch()
+ * When developing or debugging code that enters EM2 or
+ * lower, it's a good idea to have an "escape hatch" type
+ * mechanism, e.g. a way to pause the device so that a debugger can
+ * connect in order to erase flash, among other things.
+ *
+ * Before proceeding with this example, make sure PB0 is not pressed.
+ * If the PB0 pin is low, turn on LED0 and execute the breakpoint
+ * instruction to stop the processor in EM0 and allow a debug
+ * connection to be made.
+ ******************************************************************************/
+void escapeHatch(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN,
+                  gpioModeInputPullFilter, 1);
+  if (GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == 0) {
+    GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN,
+                    gpioModePushPull, 1);
+    __BKPT(0);
+  }
+  // Pin not asserted, so disable input
+  else {
+    GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN,
+                    gpioModeDisabled, 0);
+    CMU_ClockEnable(cmuClock_GPIO, false);
+  }
+}
+
+/***************************************************************************//**
+ * @brief LDMA interrupt handler
+ *        Only wakes the CPU; one interrupt per half ring of snapshots
+ ******************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  LDMA_IntClear(LDMA_IntGet());
+}
+
+/***************************************************************************//**
+ * @brief Initialize PCNT0
+ *        This function sets up PCNT0 with oversampling quadrature mode
+ *        S0 PRS linked to PRSCH0
+ *        S1 PRS linked to PRSCH1
+ *
+ *        The counter free-runs over the full 16-bit range without interrupts;
+ *        the estimator unwraps it from the snapshots.
+ ******************************************************************************/
+static void initPcnt(void)
+{
+  PCNT_Init_TypeDef pcntInit = PCNT_INIT_DEFAULT;
+  PCNT_Filter_TypeDef pcntFilterInit = PCNT_FILTER_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_PCNT0, true);
+
+  pcntInit.mode     = pcntModeOvsQuad4; // OVS quadrature mode
+  pcntInit.top      = 0xFFFF;           // Wrap at 16 bits
+  pcntInit.s1CntDir = false;
+  pcntInit.s0PRS    = PCNT_PRS_Ch0;
+  pcntInit.s1PRS    = PCNT_PRS_Ch1;
+  pcntInit.filter   = true;
+  pcntInit.cntEvent = pcntCntEventBoth; // count up and down
+  pcntInit.hyst     = false;
+
+  // Use max filter len for GPIO push button
+  pcntFilterInit.filtLen = _PCNT_OVSCTRL_FILTLEN_MASK;
+  pcntFilterInit.flutterrm = true;
+
+  PCNT_PRSInputEnable(PCNT0, pcntPRSInputS0, true);
+  PCNT_PRSInputEnable(PCNT0, pcntPRSInputS1, true);
+  PCNT_FilterConfiguration(PCNT0, &pcntFilterInit, true);
+  PCNT_Init(PCNT0, &pcntInit);
+
+  /*
+   * The initial state of the active-low push buttons causes one count when
+   * the PCNT is enabled. Wait for it to propagate through the counter clock
+   * domain and reset the count back to zero.
+   */
+  while (PCNT0->CNT == 0);
+  PCNT0->CMD_SET = PCNT_CMD_CNTRST;
+}
+
+/***************************************************************************//**
+ * @brief Initialize PRS
+ *        This function sets up GPIO PRS which links BTN0 and BTN1 to PRS0 and
+ *        PRS1, respectively
+ ******************************************************************************/
+static void initPrs(void)
+{
+  CMU_ClockEnable(cmuClock_PRS, true);
+
+  PRS_SourceAsyncSignalSet(PCNT_PRS_Ch0, PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO,
+                           BSP_GPIO_PB0_PIN);
+  PRS_SourceAsyncSignalSet(PCNT_PRS_Ch1, PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO,
+                           BSP_GPIO_PB1_PIN);
+}
+
+/***************************************************************************//**
+ * @brief Initialize GPIO setup
+ *        This function configures BTN0 and BTN1 as inputs
+ ******************************************************************************/
+static void initGpio(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN,
+                  gpioModeInputPullFilter, 1);
+  GPIO_PinModeSet(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN,
+                  gpioModeInputPullFilter, 1);
+
+  // Route the pins to PRS without enabling their interrupts
+  GPIO_ExtIntConfig(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, BSP_GPIO_PB0_PIN,
+                    false, false, false);
+  GPIO_ExtIntConfig(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, BSP_GPIO_PB1_PIN,
+                    false, false, false);
+}
+
+/***************************************************************************//**
+ * @brief  Main function
+ ******************************************************************************/
+int main(void)
+{
+  FlashStatus status;
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  QDEC_Init_TypeDef qdecInit = QDEC_INIT_DEFAULT;
+
+  CHIP_Init();
+
+  // Recommended recovery procedure for code in development
+  escapeHatch();
+
+  // Turn on DCDC regulator
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_WSTK_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+
+  // Use LFRCO as clock for EM23GRPACLK and PCNT
+  CMU_ClockSelectSet(cmuClock_EM23GRPACLK, cmuSelect_LFRCO);
+
+  initGpio();
+
+  // Initialize and power-down MX25 SPI flash
+  MX25_init();
+  MX25_RSTEN();
+  MX25_RST(&status);
+  MX25_DP();
+  MX25_deinit();
+
+  initPrs();
+  initPcnt();
+
+  QDEC_Init(&qdec, &qdecInit);
+
+  LDMA_Init(&ldmaInit);
+  QDEC_SnapshotStart(snapshotRing, SNAPSHOT_RING, qdecInit.sampleHz,
+                     SNAPSHOT_LDMA_CH);
+
+  /*
+   * The LDMA does not run in EM2, so sleep in EM1 between batches. TIMER0
+   * and the LDMA take a snapshot every millisecond without the CPU; the
+   * CPU wakes once per half ring and processes the whole batch.
+   */
+  while (true) {
+    EMU_EnterEM1();
+
+    QDEC_Update(&qdec, snapshotRing, SNAPSHOT_RING,
+                QDEC_SnapshotWriteIndex(snapshotRing, SNAPSHOT_LDMA_CH));
+    batchCount++;
+
+    // LED0 shows the direction of motion
+    if (qdec.velocity < 0) {
+      GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    } else {
+      GPIO_PinOutClear(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    }
+  }
+}
@@ -0,0 +1,275 @@
+/***************************************************************************//**
+ * @file qdec.c
+ * @brief Position, velocity and acceleration estimation from PCNT snapshots.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+#include "qdec.h"
+
+#if !defined(QDEC_HOST)
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_ldma.h"
+#include "em_timer.h"
+
+// Ping-pong descriptors; each half of the ring raises one LDMA interrupt
+static LDMA_Descriptor_t snapshotDesc[2];
+
+/**************************************************************************//**
+ * @brief
+ *   Start copying PCNT0->CNT into a ring buffer at a fixed rate.
+ *
+ * @details
+ *   TIMER0 overflows at sampleHz and each overflow requests one LDMA word
+ *   transfer from PCNT0->CNT. The ring is covered by two linked descriptors,
+ *   so the CPU is only interrupted when half of the ring has been filled.
+ *   LDMA_Init() must have been called, and PCNT0 must be running.
+ *
+ * @param[in] ringSize
+ *   Number of words in the ring; must be even.
+ *****************************************************************************/
+void QDEC_SnapshotStart(volatile uint32_t *ring,
+                        uint32_t ringSize,
+                        uint32_t sampleHz,
+                        unsigned int ldmaChannel)
+{
+  LDMA_TransferCfg_t cfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_TIMER0_UFOF);
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+  uint32_t half = ringSize / 2;
+
+  snapshotDesc[0] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_P2M_WORD(&PCNT0->CNT, ring, half, 1);
+  snapshotDesc[1] = (LDMA_Descriptor_t)
+    LDMA_DESCRIPTOR_LINKREL_P2M_WORD(&PCNT0->CNT, ring + half, half, -1);
+
+  // Transfer on every TIMER request
+  snapshotDesc[0].xfer.ignoreSrec = 0;
+  snapshotDesc[1].xfer.ignoreSrec = 0;
+
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+  timerInit.enable = false;
+  TIMER_Init(TIMER0, &timerInit);
+  TIMER_TopSet(TIMER0, CMU_ClockFreqGet(cmuClock_TIMER0) / sampleHz - 1);
+
+  LDMA_StartTransfer(ldmaChannel, &cfg, &snapshotDesc[0]);
+  TIMER_Enable(TIMER0, true);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Ring index the snapshot channel writes next, read from its destination
+ *   address so no interrupt is needed to track it.
+ *****************************************************************************/
+uint32_t QDEC_SnapshotWriteIndex(const volatile uint32_t *ring,
+                                 unsigned int ldmaChannel)
+{
+  return (LDMA->CH[ldmaChannel].DST - (uint32_t)ring) / sizeof(uint32_t);
+}
+#endif // !QDEC_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Reset the estimator.
+ *****************************************************************************/
+void QDEC_Init(QDEC_Handle_TypeDef *handle, const QDEC_Init_TypeDef *init)
+{
+  memset(handle, 0, sizeof(*handle));
+  handle->config = *init;
+  if (handle->config.window == 0 || handle->config.window >= QDEC_HISTORY) {
+    handle->config.window = QDEC_HISTORY - 1;
+  }
+  if (handle->config.minCounts == 0) {
+    handle->config.minCounts = 1;
+  }
+  if (handle->config.maxWindow < handle->config.window) {
+    handle->config.maxWindow = handle->config.window;
+  }
+  handle->method = qdecMethodStop;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Velocity from the time between count changes, for when too few counts
+ *   fall into the M-method window to resolve the speed.
+ *
+ * @details
+ *   Walks back from the newest count change to the first change at least
+ *   one M-method window earlier, stopping early at a change of direction or
+ *   at changes older than maxWindow samples. Both ends of the interval are
+ *   count changes, so the estimate is not diluted by the partial count
+ *   periods at the window edges. Time is resolved to one snapshot period.
+ *****************************************************************************/
+static float velocityMT(QDEC_Handle_TypeDef *h, uint32_t now)
+{
+  const QDEC_Init_TypeDef *c = &h->config;
+  uint8_t newest = (uint8_t)((h->edgeHead + QDEC_EDGES - 1) % QDEC_EDGES);
+  uint32_t idx1 = h->edgeIndex[newest];
+  int32_t pos1 = h->edgePosition[newest];
+  uint32_t span = 0;
+  int32_t counts = 0;
+  uint32_t since = now - idx1;
+  int32_t step = h->edgeStep[newest];
+  int32_t prev = pos1;
+  float v;
+  uint8_t k;
+
+  if (h->edgeCount == 0 || since > c->maxWindow) {
+    h->method = qdecMethodStop;
+    return 0.0f;
+  }
+
+  for (k = 1; k < h->edgeCount; k++) {
+    uint8_t e = (uint8_t)((newest + QDEC_EDGES - k) % QDEC_EDGES);
+
+    // Stop at the window limit and at the last change of direction
+    if (idx1 - h->edgeIndex[e] > c->maxWindow
+        || (prev - h->edgePosition[e] > 0) != (step > 0)) {
+      break;
+    }
+    prev = h->edgePosition[e];
+    span = idx1 - h->edgeIndex[e];
+    counts = pos1 - h->edgePosition[e];
+    if (span >= c->window) {
+      break;
+    }
+  }
+
+  if (span == 0) {
+    // A single change after standstill or reversal: period not known yet
+    counts = step;
+    span = c->maxWindow;
+  }
+
+  v = (float)counts * (float)c->sampleHz / (float)span;
+
+  // No change for longer than the measured period bounds the speed
+  if (since > span) {
+    float bound = (float)c->sampleHz / (float)since;
+
+    if (v > bound) {
+      v = bound;
+    } else if (v < -bound) {
+      v = -bound;
+    }
+  }
+
+  h->method = qdecMethodMT;
+  return v;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Process one PCNT snapshot.
+ *
+ * @param[in] count
+ *   Raw 16-bit PCNT count; wraparound between snapshots is unwrapped as long
+ *   as fewer than 32768 counts pass between two snapshots.
+ *****************************************************************************/
+void QDEC_Sample(QDEC_Handle_TypeDef *handle, uint16_t count)
+{
+  const QDEC_Init_TypeDef *c = &handle->config;
+  uint32_t now = handle->sampleIndex;
+  uint32_t window;
+  int16_t delta;
+  int32_t counts;
+  float velocity;
+
+  if (!handle->primed) {
+    handle->lastCount = count;
+    handle->primed = true;
+  }
+
+  delta = (int16_t)(uint16_t)(count - handle->lastCount);
+  handle->lastCount = count;
+  handle->position += delta;
+  handle->history[now % QDEC_HISTORY] = handle->position;
+
+  if (delta != 0) {
+    handle->edgeIndex[handle->edgeHead] = now;
+    handle->edgePosition[handle->edgeHead] = handle->position;
+    handle->edgeStep[handle->edgeHead] = delta;
+    handle->edgeHead = (uint8_t)((handle->edgeHead + 1) % QDEC_EDGES);
+    if (handle->edgeCount < QDEC_EDGES) {
+      handle->edgeCount++;
+    }
+  }
+
+  // M-method over the last window, shorter until the history has filled
+  window = now < c->window ? now : c->window;
+  counts = window > 0
+           ? handle->position - handle->history[(now - window) % QDEC_HISTORY]
+           : 0;
+
+  if (window == c->window
+      && (counts >= c->minCounts || counts <= -(int32_t)c->minCounts)) {
+    velocity = (float)counts * (float)c->sampleHz / (float)window;
+    handle->method = qdecMethodM;
+  } else {
+    velocity = velocityMT(handle, now);
+  }
+
+  handle->acceleration += c->accelAlpha
+                          * ((velocity - handle->velocity) * (float)c->sampleHz
+                             - handle->acceleration);
+  handle->velocity = velocity;
+  handle->sampleIndex++;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Process every snapshot written to the ring since the last call.
+ *
+ * @note
+ *   Call at least once per ring length; a full lap cannot be told apart
+ *   from no new data.
+ *
+ * @return
+ *   Number of snapshots processed.
+ *****************************************************************************/
+uint32_t QDEC_Update(QDEC_Handle_TypeDef *handle,
+                     const volatile uint32_t *ring,
+                     uint32_t ringSize,
+                     uint32_t writeIndex)
+{
+  uint32_t processed = 0;
+
+  writeIndex %= ringSize;
+  while (handle->readIndex != writeIndex) {
+    QDEC_Sample(handle, (uint16_t)ring[handle->readIndex]);
+    handle->readIndex = (handle->readIndex + 1) % ringSize;
+    processed++;
+  }
+  return processed;
+}
@@ -0,0 +1,118 @@
+/***************************************************************************//**
+ * @file qdec.h
+ * @brief Position, velocity and acceleration estimation from PCNT snapshots.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef QDEC_H
+#define QDEC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Samples of unwrapped position kept for the estimators
+#define QDEC_HISTORY        64
+
+/// Count-change instants kept for the M/T estimator
+#define QDEC_EDGES          16
+
+/// Estimator used for the last velocity value
+typedef enum {
+  qdecMethodM,    ///< Counts in a fixed window (high speed)
+  qdecMethodMT,   ///< Counts between count-change instants (low speed)
+  qdecMethodStop  ///< No count change within the longest window
+} QDEC_Method_TypeDef;
+
+/// Estimator configuration
+typedef struct {
+  uint32_t sampleHz;      ///< Snapshot rate
+  uint16_t window;        ///< M-method window in samples (< QDEC_HISTORY)
+  uint16_t minCounts;     ///< Counts per window below which M/T is used
+  uint16_t maxWindow;     ///< Longest M/T window in samples before "stopped"
+  float    accelAlpha;    ///< Smoothing of the acceleration estimate (0..1]
+} QDEC_Init_TypeDef;
+
+/// Default configuration: 1 kHz snapshots, 16 sample window
+#define QDEC_INIT_DEFAULT                                             \
+  {                                                                   \
+    1000,   /* 1 kHz snapshots */                                     \
+    16,     /* 16 ms M-method window */                               \
+    8,      /* Switch to M/T below 8 counts per window */             \
+    1000,   /* Report standstill after 1 s without a count */         \
+    0.1f,   /* Acceleration smoothing */                              \
+  }
+
+/// Estimator state; all fields are read-only for the application
+typedef struct {
+  QDEC_Init_TypeDef   config;
+  int32_t             position;     ///< Unwrapped count
+  float               velocity;     ///< Counts per second
+  float               acceleration; ///< Counts per second squared
+  QDEC_Method_TypeDef method;
+
+  uint32_t sampleIndex;             ///< Snapshots processed so far
+  uint32_t readIndex;               ///< Next ring entry to process
+  uint16_t lastCount;
+  bool     primed;
+  int32_t  history[QDEC_HISTORY];
+  uint32_t edgeIndex[QDEC_EDGES];   ///< Sample index of count changes
+  int32_t  edgePosition[QDEC_EDGES];
+  int16_t  edgeStep[QDEC_EDGES];    ///< Count change at each instant
+  uint8_t  edgeHead;
+  uint8_t  edgeCount;
+} QDEC_Handle_TypeDef;
+
+void QDEC_Init(QDEC_Handle_TypeDef *handle, const QDEC_Init_TypeDef *init);
+void QDEC_Sample(QDEC_Handle_TypeDef *handle, uint16_t count);
+uint32_t QDEC_Update(QDEC_Handle_TypeDef *handle,
+                     const volatile uint32_t *ring,
+                     uint32_t ringSize,
+                     uint32_t writeIndex);
+
+#if !defined(QDEC_HOST)
+void QDEC_SnapshotStart(volatile uint32_t *ring,
+                        uint32_t ringSize,
+                        uint32_t sampleHz,
+                        unsigned int ldmaChannel);
+uint32_t QDEC_SnapshotWriteIndex(const volatile uint32_t *ring,
+                                 unsigned int ldmaChannel);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QDEC_H
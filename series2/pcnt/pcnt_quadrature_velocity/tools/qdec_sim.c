@@ -0,0 +1,267 @@
+/***************************************************************************//**
+ * @file qdec_sim.c
+ * @brief Host test and benchmark for the quadrature velocity estimator.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DQDEC_HOST -I../src -o qdec_sim qdec_sim.c ../src/qdec.c -lm
+ *   ./qdec_sim                 run the synthetic traces and the benchmark
+ *   ./qdec_sim counts.txt      print estimates for a captured count trace
+ *
+ * The synthetic traces model an encoder whose true position is a continuous
+ * function of time; each snapshot is the 16-bit PCNT count floor(position).
+ * The fused M/T estimate is compared with a plain M-method estimate over the
+ * same window, and the exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "qdec.h"
+
+#define PI 3.14159265358979
+
+typedef double (*Trace_Fn)(double t);
+
+typedef struct {
+  const char *name;
+  Trace_Fn    position;     // counts at time t
+  double      seconds;
+  double      maxRmsRatio;  // fused RMS error / M-only RMS error limit
+  int         expectStop;   // velocity must be 0 at the end
+  int         expectSign;   // sign every settled velocity must have, or 0
+} Trace_TypeDef;
+
+// Accelerate to 20000 counts/s in 2 s, then hold
+static double traceRamp(double t)
+{
+  return t < 2.0 ? 5000.0 * t * t : 20000.0 + 20000.0 * (t - 2.0);
+}
+
+// 20 counts/s: one count per 50 snapshots
+static double traceCrawl(double t)
+{
+  return 0.5 + 20.0 * t;
+}
+
+// 10 counts/s: one count per 100 snapshots, longer than QDEC_HISTORY
+static double traceCreep(double t)
+{
+  return 0.5 + 10.0 * t;
+}
+
+// The same, backwards
+static double traceCreepBack(double t)
+{
+  return 0.5 - 10.0 * t;
+}
+
+// Back and forth, 200 counts amplitude at 0.5 Hz
+static double traceReversal(double t)
+{
+  return 1000.5 + 200.0 * sin(PI * t);
+}
+
+// 30000 counts/s wraps the 16-bit counter every 2.2 s
+static double traceWrap(double t)
+{
+  return -30000.0 * t;
+}
+
+// Slow down from 100 counts/s to a stop at 2 s, then stand still
+static double traceStop(double t)
+{
+  return t < 2.0 ? 0.5 + 100.0 * t - 25.0 * t * t : 100.5;
+}
+
+static const Trace_TypeDef traces[] = {
+  { "ramp",      traceRamp,       4.0, 1.05, 0,  0 },
+  { "crawl",     traceCrawl,      4.0, 0.25, 0,  0 },
+  { "creep",     traceCreep,      4.0, 0.25, 0,  1 },
+  { "creepback", traceCreepBack,  4.0, 0.25, 0, -1 },
+  { "reversal",  traceReversal,   4.0, 1.00, 0,  0 },
+  { "wrap",      traceWrap,       5.0, 1.05, 0,  0 },
+  { "stop",      traceStop,       4.0, 1.00, 1,  0 },
+};
+
+/***************************************************************************//**
+ * @brief
+ *   Run one trace; returns the number of failed checks.
+ ******************************************************************************/
+static int runTrace(const Trace_TypeDef *trace)
+{
+  QDEC_Init_TypeDef init = QDEC_INIT_DEFAULT;
+  QDEC_Handle_TypeDef h;
+  uint32_t n, samples = (uint32_t)(trace->seconds * init.sampleHz);
+  double dt = 1.0 / init.sampleHz;
+  double errFused = 0.0, errM = 0.0;
+  int32_t pos0 = 0, truthPos = 0;
+  int32_t hist[QDEC_HISTORY];
+  uint32_t settled = 0, wrongSign = 0;
+  int failures = 0;
+
+  QDEC_Init(&h, &init);
+
+  for (n = 0; n < samples; n++) {
+    double t = n * dt;
+    int32_t p = (int32_t)floor(trace->position(t));
+    double truth = (trace->position(t + dt / 2) - trace->position(t - dt / 2))
+                   / dt;
+
+    if (n == 0) {
+      pos0 = p;
+    }
+    truthPos = p - pos0;
+    QDEC_Sample(&h, (uint16_t)p);
+    hist[n % QDEC_HISTORY] = h.position;
+
+    if (h.position != truthPos) {
+      printf("  %s: position %ld, expected %ld at sample %lu\n", trace->name,
+             (long)h.position, (long)truthPos, (unsigned long)n);
+      return failures + 1;
+    }
+
+    // Compare once the M window and the longest M/T interval have filled
+    if (n >= init.maxWindow) {
+      double vM = (double)(h.position - hist[(n - init.window) % QDEC_HISTORY])
+                  * init.sampleHz / init.window;
+
+      errFused += (h.velocity - truth) * (h.velocity - truth);
+      errM += (vM - truth) * (vM - truth);
+      settled++;
+      if ((trace->expectSign > 0 && !(h.velocity > 0.0f))
+          || (trace->expectSign < 0 && !(h.velocity < 0.0f))) {
+        wrongSign++;
+      }
+    }
+  }
+
+  errFused = sqrt(errFused / settled);
+  errM = sqrt(errM / settled);
+  printf("  %-9s rms error fused %9.2f  M-only %9.2f counts/s, "
+         "end v %9.2f a %10.1f\n",
+         trace->name, errFused, errM, h.velocity, h.acceleration);
+
+  if (errFused > trace->maxRmsRatio * errM + 1e-9) {
+    printf("  %s: fused error above %.2f x M-only\n",
+           trace->name, trace->maxRmsRatio);
+    failures++;
+  }
+  if (wrongSign != 0) {
+    printf("  %s: %lu of %lu velocities zero or of the wrong sign\n",
+           trace->name, (unsigned long)wrongSign, (unsigned long)settled);
+    failures++;
+  }
+  if (trace->expectStop
+      && (h.velocity != 0.0f || h.method != qdecMethodStop)) {
+    printf("  %s: standstill not detected\n", trace->name);
+    failures++;
+  }
+  return failures;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Measure QDEC_Update throughput on a ring of snapshots.
+ ******************************************************************************/
+static void benchmark(void)
+{
+  static uint32_t ring[64];
+  QDEC_Init_TypeDef init = QDEC_INIT_DEFAULT;
+  QDEC_Handle_TypeDef h;
+  uint32_t batches = 200000, i, k, count = 0;
+  uint64_t updates = 0;
+  clock_t start;
+  double seconds;
+
+  QDEC_Init(&h, &init);
+  start = clock();
+  for (i = 0; i < batches; i++) {
+    // Half a ring per batch, mixed slow and fast motion
+    for (k = 0; k < 32; k++) {
+      count += (i & 1) ? 37 : (k == 0);
+      ring[(i * 32 + k) % 64] = count & 0xFFFF;
+    }
+    updates += QDEC_Update(&h, ring, 64, (i + 1) * 32);
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("benchmark: %llu updates in %.3f s, %.1f M updates/s\n",
+         (unsigned long long)updates, seconds, updates / seconds / 1e6);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Print sample, position, velocity and method for a trace of raw counts,
+ *   one count per line at the default snapshot rate.
+ ******************************************************************************/
+static int runFile(const char *path)
+{
+  static const char *methods[] = { "M", "MT", "stop" };
+  QDEC_Init_TypeDef init = QDEC_INIT_DEFAULT;
+  QDEC_Handle_TypeDef h;
+  unsigned long count;
+  FILE *f = fopen(path, "r");
+
+  if (f == NULL) {
+    perror(path);
+    return 2;
+  }
+  QDEC_Init(&h, &init);
+  printf("sample,position,velocity,acceleration,method\n");
+  while (fscanf(f, "%lu", &count) == 1) {
+    QDEC_Sample(&h, (uint16_t)count);
+    printf("%lu,%ld,%.3f,%.1f,%s\n", (unsigned long)h.sampleIndex - 1,
+           (long)h.position, h.velocity, h.acceleration, methods[h.method]);
+  }
+  fclose(f);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int i;
+  int failures = 0;
+
+  if (argc > 1) {
+    return runFile(argv[1]);
+  }
+
+  printf("synthetic traces:\n");
+  for (i = 0; i < sizeof(traces) / sizeof(traces[0]); i++) {
+    failures += runTrace(&traces[i]);
+  }
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief This project demonstrates PRS glue logic described as a netlist and
+ * compiled into PRS channel tables by the prsnet host tool.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_gpio.h"
+#include "em_prs.h"
+#include "em_emu.h"
+
+#include "bsp.h"
+
+// Output pin used by the netlist's route statement
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_7)
+// Push Button 0/1 are wired to LED0/1 on the xG27 radio board
+#define PRSNET_OUTPUT_PORT   gpioPortC
+#define PRSNET_OUTPUT_PIN    3
+#else
+#define PRSNET_OUTPUT_PORT   BSP_GPIO_LED1_PORT
+#define PRSNET_OUTPUT_PIN    BSP_GPIO_LED1_PIN
+#endif
+
+/*
+ * Channel tables generated from netlist/prs_netlist.net. xG21 and xG24 can
+ * only combine a channel with the previous one and drive LED1 from port B;
+ * the other devices select B freely and drive the output from port C/D.
+ */
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_1) \
+  || defined(_SILICON_LABS_32B_SERIES_2_CONFIG_4)
+#include "prs_netlist_cfg_xg21_xg24.h"
+#else
+#include "prs_netlist_cfg_xg2x.h"
+#endif
+
+/**************************************************************************//**
+ * @brief GPIO initialization
+ *****************************************************************************/
+void initGpio(void)
+{
+  // Enable GPIO clock
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  // Set Push Buttons as input
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter,
+                  1);
+  GPIO_PinModeSet(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, gpioModeInputPullFilter,
+                  1);
+
+  // Configure Push Buttons to create interrupt signals
+  GPIO_ExtIntConfig(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, BSP_GPIO_PB0_PIN, 0,
+                    0, false);
+  GPIO_ExtIntConfig(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, BSP_GPIO_PB1_PIN, 0,
+                    0, false);
+
+  // Set the netlist output pin as output
+  GPIO_PinModeSet(PRSNET_OUTPUT_PORT, PRSNET_OUTPUT_PIN, gpioModePushPull, 0);
+}
+
+/**************************************************************************//**
+ * @brief PRS initialization
+ *****************************************************************************/
+void initPrs(void)
+{
+  // Enable PRS clock
+  CMU_ClockEnable(cmuClock_PRS, true);
+
+  // Program the channel sources, logic functions and output route
+  PRSNET_Apply(&prsnetNetlist);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  CHIP_Init();
+
+  // Setup GPIO
+  initGpio();
+
+  // Setup PRS channels from the compiled netlist
+  initPrs();
+
+  // Infinite loop
+  while(1)
+  {
+    // The logic runs entirely in the PRS; no interrupt ever wakes the core
+    EMU_EnterEM1();
+  }
+}
@@ -0,0 +1,121 @@
+/***************************************************************************//**
+ * @file prs_netlist.c
+ * @brief Applies and evaluates PRS netlist tables generated by prsnet.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include "prs_netlist.h"
+
+#if !defined(PRSNET_HOST)
+#include "em_device.h"
+#include "em_gpio.h"
+#include "em_prs.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Program every channel and route of a generated netlist.
+ *
+ * @note
+ *   The PRS clock must already be enabled. Channels that ignore their B input
+ *   are combined with the previous channel, which is the only pairing
+ *   PRS_Combine() accepts on devices without AUXSEL.
+ *****************************************************************************/
+void PRSNET_Apply(const PRSNET_Netlist_TypeDef *netlist)
+{
+  size_t i;
+
+  for (i = 0; i < netlist->channelCount; i++) {
+    const PRSNET_Channel_TypeDef *ch = &netlist->channels[i];
+    unsigned int aux = ch->auxChannel;
+
+    if (aux == PRSNET_NO_AUX) {
+      aux = (ch->channel + PRS_ASYNC_CHAN_COUNT - 1) % PRS_ASYNC_CHAN_COUNT;
+    }
+    PRS_SourceAsyncSignalSet(ch->channel, ch->source, ch->signal);
+    PRS_Combine(ch->channel, aux, (PRS_Logic_t)ch->fnsel);
+  }
+
+  for (i = 0; i < netlist->routeCount; i++) {
+    const PRSNET_Route_TypeDef *route = &netlist->routes[i];
+
+    if (route->type == prsnetRoutePin) {
+      PRS_PinOutput(route->channel, prsTypeAsync,
+                    (GPIO_Port_TypeDef)route->arg0, (uint8_t)route->arg1);
+    } else {
+      PRS_ConnectConsumer(route->channel, prsTypeAsync,
+                          (PRS_Consumer_t)route->arg0);
+    }
+  }
+}
+#endif
+
+/**************************************************************************//**
+ * @brief
+ *   Compute every channel output of a netlist for one set of input levels.
+ *
+ * @details
+ *   This models the asynchronous channel logic exactly as programmed by
+ *   PRSNET_Apply(): A is the channel's own source signal, B is the output of
+ *   the auxiliary channel and FNSEL is a truth table indexed by (A << 1) | B.
+ *   Because channels are stored in dependency order, one pass settles the
+ *   combinational network.
+ *
+ * @param[in] inputs
+ *   Level (0 or 1) of each netlist input, indexed as in the generated table.
+ *
+ * @param[out] chOut
+ *   Output level of every channel. Unused channels read as 0.
+ *****************************************************************************/
+void PRSNET_Evaluate(const PRSNET_Netlist_TypeDef *netlist,
+                     const uint8_t *inputs,
+                     uint8_t chOut[PRSNET_MAX_CHANNELS])
+{
+  size_t i;
+
+  for (i = 0; i < PRSNET_MAX_CHANNELS; i++) {
+    chOut[i] = 0;
+  }
+
+  for (i = 0; i < netlist->channelCount; i++) {
+    const PRSNET_Channel_TypeDef *ch = &netlist->channels[i];
+    unsigned int a = 0;
+    unsigned int b = 0;
+
+    if (ch->input != PRSNET_NO_INPUT) {
+      a = inputs[ch->input] & 1u;
+    }
+    if (ch->auxChannel != PRSNET_NO_AUX) {
+      b = chOut[ch->auxChannel] & 1u;
+    }
+    chOut[ch->channel] = (ch->fnsel >> ((a << 1) | b)) & 1u;
+  }
+}
@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @file prs_netlist.h
+ * @brief PRS netlist tables and table-driven evaluator.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef PRS_NETLIST_H
+#define PRS_NETLIST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Largest number of asynchronous PRS channels on any supported device
+#define PRSNET_MAX_CHANNELS   16
+
+/// Input index used by channels that do not sample a source signal
+#define PRSNET_NO_INPUT       0xFF
+
+/// Auxiliary channel of channels whose truth table ignores B
+#define PRSNET_NO_AUX         0xFF
+
+/// Truth table value of a channel that passes its A input through unchanged
+#define PRSNET_FNSEL_A        0xC
+
+/*
+ * The tables generated by tools/prsnet.c refer to emlib/BSP symbols for the
+ * source signals and output routes. A host build (PRSNET_HOST) only needs the
+ * logic, so these symbols are dropped and the sources are driven by index.
+ */
+#if defined(PRSNET_HOST)
+#define PRSNET_SOURCE(source, signal)     0, 0
+#define PRSNET_ROUTE_PIN(port, pin)       prsnetRoutePin, 0, 0
+#define PRSNET_ROUTE_CONSUMER(consumer)   prsnetRouteConsumer, 0, 0
+#else
+#define PRSNET_SOURCE(source, signal)     (uint32_t)(source), (uint32_t)(signal)
+#define PRSNET_ROUTE_PIN(port, pin)       prsnetRoutePin, (uint32_t)(port), (uint32_t)(pin)
+#define PRSNET_ROUTE_CONSUMER(consumer)   prsnetRouteConsumer, (uint32_t)(consumer), 0
+#endif
+
+/// One configured asynchronous PRS channel
+typedef struct {
+  uint8_t  channel;     ///< Asynchronous channel number
+  uint32_t source;      ///< SOURCESEL value (PRS_ASYNC_CH_CTRL_SOURCESEL_xxx)
+  uint32_t signal;      ///< SIGSEL value for the selected source
+  uint8_t  input;       ///< Netlist input sampled as A, or PRSNET_NO_INPUT
+  uint8_t  fnsel;       ///< 4-bit truth table indexed by (A << 1) | B
+  uint8_t  auxChannel;  ///< Channel used as B, or PRSNET_NO_AUX
+} PRSNET_Channel_TypeDef;
+
+/// Kind of connection made from a channel output
+typedef enum {
+  prsnetRoutePin,       ///< Drive a GPIO pin
+  prsnetRouteConsumer   ///< Feed a peripheral consumer
+} PRSNET_RouteType_TypeDef;
+
+/// One channel output connection
+typedef struct {
+  uint8_t                  channel;  ///< Channel driving the route
+  PRSNET_RouteType_TypeDef type;     ///< Pin or consumer
+  uint32_t                 arg0;     ///< GPIO port or PRS_Consumer_t value
+  uint32_t                 arg1;     ///< GPIO pin (pin routes only)
+} PRSNET_Route_TypeDef;
+
+/// A compiled netlist. Channels are stored in dependency order.
+typedef struct {
+  const PRSNET_Channel_TypeDef *channels;
+  size_t                        channelCount;
+  const PRSNET_Route_TypeDef   *routes;
+  size_t                        routeCount;
+} PRSNET_Netlist_TypeDef;
+
+#if !defined(PRSNET_HOST)
+void PRSNET_Apply(const PRSNET_Netlist_TypeDef *netlist);
+#endif
+
+void PRSNET_Evaluate(const PRSNET_Netlist_TypeDef *netlist,
+                     const uint8_t *inputs,
+                     uint8_t chOut[PRSNET_MAX_CHANNELS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PRS_NETLIST_H
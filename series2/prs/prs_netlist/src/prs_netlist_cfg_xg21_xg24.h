@@ -0,0 +1,29 @@
+/* Generated by prsnet from prs_netlist.net for xg21. Do not edit. */
+
+#ifndef PRS_NETLIST_CFG_XG21_XG24_H
+#define PRS_NETLIST_CFG_XG21_XG24_H
+
+#include "prs_netlist.h"
+
+#define PRSNET_INPUT_PB0              0
+#define PRSNET_INPUT_PB1              1
+#define PRSNET_INPUT_COUNT            2
+
+#define PRSNET_CH_PRESSED0            0
+#define PRSNET_CH_EITHER              1
+
+static const PRSNET_Channel_TypeDef prsnetChannels[] = {
+  {  0, PRSNET_SOURCE(PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO, BSP_GPIO_PB0_PIN), PRSNET_INPUT_PB0, 0x3, PRSNET_NO_AUX }, // PRESSED0
+  {  1, PRSNET_SOURCE(PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO, BSP_GPIO_PB1_PIN), PRSNET_INPUT_PB1, 0xB, 0 }, // EITHER
+};
+
+static const PRSNET_Route_TypeDef prsnetRoutes[] = {
+  {  1, PRSNET_ROUTE_PIN(PRSNET_OUTPUT_PORT, PRSNET_OUTPUT_PIN) },
+};
+
+static const PRSNET_Netlist_TypeDef prsnetNetlist = {
+  prsnetChannels, sizeof(prsnetChannels) / sizeof(prsnetChannels[0]),
+  prsnetRoutes, sizeof(prsnetRoutes) / sizeof(prsnetRoutes[0])
+};
+
+#endif // PRS_NETLIST_CFG_XG21_XG24_H
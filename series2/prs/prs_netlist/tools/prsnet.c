@@ -0,0 +1,908 @@
+/***************************************************************************//**
+ * @file prsnet.c
+ * @brief Host tool that compiles a PRS netlist into channel tables and
+ * simulates the compiled tables cycle by cycle.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ *******************************************************************************
+ *
+ * Build (from this directory):
+ *   gcc -std=c99 -DPRSNET_HOST -I../src -o prsnet prsnet.c ../src/prs_netlist.c
+ *
+ * Usage:
+ *   prsnet compile [-t target] [-D VAR=VALUE] [-o out.h] netlist.net
+ *   prsnet sim     [-t target] [-D VAR=VALUE] netlist.net vectors.vec
+ *
+ * Netlist statements (one per line, '#' starts a comment):
+ *   input NAME SOURCESEL SIGSEL     asynchronous source signal
+ *   node  NAME = EXPR               logic over at most two signals using
+ *                                   ~ & | ^ ( ) 0 1
+ *   route NAME pin PORT PIN [BANK]  drive a GPIO; BANK is AB, CD or @VAR
+ *   route NAME consumer CONSUMER    feed a PRS consumer (PRS_Consumer_t)
+ *
+ * Vector lines assign inputs for one cycle (NAME=0|1, unassigned inputs keep
+ * their level) and may list expected outputs after a colon:
+ *   PB0=0 PB1=1 : EITHER=1
+ ******************************************************************************/
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "prs_netlist.h"
+
+#define MAX_SIGNALS     64
+#define MAX_ENTITIES    PRSNET_MAX_CHANNELS
+#define MAX_ROUTES      32
+#define MAX_DEFINES     16
+#define MAX_EXPR_NODES  512
+#define NAME_LEN        48
+#define TEXT_LEN        96
+
+#define NONE            (-1)
+
+/// Channel bank masks for pin routing: ports A/B use channels 0-5, C/D 6-11
+#define BANK_ANY        0xFFFFu
+#define BANK_AB         0x003Fu
+#define BANK_CD         0x0FC0u
+
+typedef struct {
+  const char *name;
+  int         channels;
+  int         adjacentAux;  // B is hard-wired to the previous channel
+} Target_t;
+
+// Devices without AUXSEL combine a channel with the previous one only
+static const Target_t targets[] = {
+  { "xg21", 12, 1 },
+  { "xg22", 12, 0 },
+  { "xg23", 12, 0 },
+  { "xg24", 16, 1 },
+  { "xg25", 12, 0 },
+  { "xg27", 12, 0 },
+  { "xg28", 12, 0 },
+};
+
+typedef enum { exprConst, exprVar, exprNot, exprAnd, exprOr, exprXor } ExprOp_t;
+
+typedef struct {
+  ExprOp_t op;
+  int      value;   // constant value or signal index
+  int      lhs;
+  int      rhs;
+} Expr_t;
+
+typedef struct {
+  char name[NAME_LEN];
+  int  isInput;
+  char source[TEXT_LEN];
+  char signal[TEXT_LEN];
+  int  inputIndex;
+  int  expr;         // root expression node
+  int  vars[2];      // distinct signals referenced by the expression
+  int  varCount;
+  int  entity;       // entity producing this node, NONE for inputs
+  int  passEntity;   // shared passthrough entity of an input
+} Signal_t;
+
+typedef struct {
+  int      signal;   // signal produced by this channel
+  int      aInput;   // signal index sampled as A, or NONE
+  int      bEntity;  // entity used as B, or NONE
+  unsigned fnsel;
+  unsigned bankMask;
+  int      channel;
+} Entity_t;
+
+typedef struct {
+  int  signal;
+  int  entity;
+  int  isPin;
+  unsigned bankMask;
+  char arg0[TEXT_LEN];
+  char arg1[TEXT_LEN];
+} Route_t;
+
+static const Target_t *target = &targets[1];
+static char defineName[MAX_DEFINES][NAME_LEN];
+static char defineValue[MAX_DEFINES][TEXT_LEN];
+static int defineCount;
+
+static Signal_t signals[MAX_SIGNALS];
+static int signalCount;
+static int inputCount;
+static Expr_t exprs[MAX_EXPR_NODES];
+static int exprCount;
+static Entity_t entities[MAX_ENTITIES];
+static int entityCount;
+static Route_t routes[MAX_ROUTES];
+static int routeCount;
+
+static const char *fileName;
+static int lineNumber;
+
+/***************************************************************************//**
+ * @brief Report a netlist error with its location and exit.
+ ******************************************************************************/
+static void fail(const char *fmt, ...)
+{
+  va_list ap;
+
+  if (lineNumber > 0) {
+    fprintf(stderr, "%s:%d: ", fileName, lineNumber);
+  } else {
+    fprintf(stderr, "%s: ", fileName);
+  }
+  va_start(ap, fmt);
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+  exit(2);
+}
+
+static int findSignal(const char *name)
+{
+  int i;
+
+  for (i = 0; i < signalCount; i++) {
+    if (strcmp(signals[i].name, name) == 0) {
+      return i;
+    }
+  }
+  return NONE;
+}
+
+static Signal_t *newSignal(const char *name)
+{
+  Signal_t *s;
+
+  if (findSignal(name) != NONE) {
+    fail("'%s' is already defined", name);
+  }
+  if (signalCount == MAX_SIGNALS) {
+    fail("too many signals");
+  }
+  s = &signals[signalCount++];
+  memset(s, 0, sizeof(*s));
+  snprintf(s->name, sizeof(s->name), "%s", name);
+  s->inputIndex = NONE;
+  s->expr = NONE;
+  s->entity = NONE;
+  s->passEntity = NONE;
+  return s;
+}
+
+/*******************************************************************************
+ ****************************   Expression parser   ****************************
+ ******************************************************************************/
+
+static const char *cursor;
+
+static int newExpr(ExprOp_t op, int value, int lhs, int rhs)
+{
+  if (exprCount == MAX_EXPR_NODES) {
+    fail("expression too large");
+  }
+  exprs[exprCount].op = op;
+  exprs[exprCount].value = value;
+  exprs[exprCount].lhs = lhs;
+  exprs[exprCount].rhs = rhs;
+  return exprCount++;
+}
+
+static void skipSpace(void)
+{
+  while (isspace((unsigned char)*cursor)) {
+    cursor++;
+  }
+}
+
+static int parseOr(void);
+
+static int parsePrimary(void)
+{
+  char name[NAME_LEN];
+  int len = 0;
+  int e;
+
+  skipSpace();
+  if (*cursor == '~' || *cursor == '!') {
+    cursor++;
+    return newExpr(exprNot, 0, parsePrimary(), NONE);
+  }
+  if (*cursor == '(') {
+    cursor++;
+    e = parseOr();
+    skipSpace();
+    if (*cursor++ != ')') {
+      fail("missing ')'");
+    }
+    return e;
+  }
+  if (*cursor == '0' || *cursor == '1') {
+    return newExpr(exprConst, *cursor++ - '0', NONE, NONE);
+  }
+  while (isalnum((unsigned char)*cursor) || *cursor == '_') {
+    if (len < NAME_LEN - 1) {
+      name[len++] = *cursor;
+    }
+    cursor++;
+  }
+  name[len] = '\0';
+  if (len == 0) {
+    fail("syntax error in expression near '%s'", cursor);
+  }
+  e = findSignal(name);
+  if (e == NONE) {
+    fail("'%s' is used before it is defined", name);
+  }
+  return newExpr(exprVar, e, NONE, NONE);
+}
+
+static int parseAnd(void)
+{
+  int e = parsePrimary();
+
+  for (skipSpace(); *cursor == '&'; skipSpace()) {
+    cursor++;
+    e = newExpr(exprAnd, 0, e, parsePrimary());
+  }
+  return e;
+}
+
+static int parseXor(void)
+{
+  int e = parseAnd();
+
+  for (skipSpace(); *cursor == '^'; skipSpace()) {
+    cursor++;
+    e = newExpr(exprXor, 0, e, parseAnd());
+  }
+  return e;
+}
+
+static int parseOr(void)
+{
+  int e = parseXor();
+
+  for (skipSpace(); *cursor == '|'; skipSpace()) {
+    cursor++;
+    e = newExpr(exprOr, 0, e, parseXor());
+  }
+  return e;
+}
+
+/***************************************************************************//**
+ * @brief Evaluate an expression with the given level for every signal.
+ ******************************************************************************/
+static int evalExpr(int e, const int *level)
+{
+  const Expr_t *x = &exprs[e];
+
+  switch (x->op) {
+    case exprConst:
+      return x->value;
+    case exprVar:
+      return level[x->value];
+    case exprNot:
+      return !evalExpr(x->lhs, level);
+    case exprAnd:
+      return evalExpr(x->lhs, level) & evalExpr(x->rhs, level);
+    case exprOr:
+      return evalExpr(x->lhs, level) | evalExpr(x->rhs, level);
+    default:
+      return evalExpr(x->lhs, level) ^ evalExpr(x->rhs, level);
+  }
+}
+
+static void collectVars(int e, Signal_t *s)
+{
+  const Expr_t *x = &exprs[e];
+
+  if (x->op == exprVar) {
+    if ((s->varCount > 0 && s->vars[0] == x->value)
+        || (s->varCount > 1 && s->vars[1] == x->value)) {
+      return;
+    }
+    if (s->varCount == 2) {
+      fail("'%s' depends on more than two signals; split it into nodes",
+           s->name);
+    }
+    s->vars[s->varCount++] = x->value;
+  } else if (x->op != exprConst) {
+    collectVars(x->lhs, s);
+    if (x->rhs != NONE) {
+      collectVars(x->rhs, s);
+    }
+  }
+}
+
+/*******************************************************************************
+ ******************************   Netlist reader   *****************************
+ ******************************************************************************/
+
+static const char *lookupDefine(const char *name)
+{
+  int i;
+
+  for (i = 0; i < defineCount; i++) {
+    if (strcmp(defineName[i], name) == 0) {
+      return defineValue[i];
+    }
+  }
+  fail("@%s is not defined; pass -D %s=AB|CD", name, name);
+  return NULL;
+}
+
+static unsigned parseBank(const char *text)
+{
+  if (text[0] == '@') {
+    text = lookupDefine(text + 1);
+  }
+  if (strcmp(text, "AB") == 0) {
+    return BANK_AB;
+  }
+  if (strcmp(text, "CD") == 0) {
+    return BANK_CD;
+  }
+  if (strcmp(text, "any") == 0) {
+    return BANK_ANY;
+  }
+  fail("unknown pin bank '%s'", text);
+  return 0;
+}
+
+static void readNetlist(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  char line[256];
+
+  fileName = path;
+  if (f == NULL) {
+    fail("cannot open netlist");
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char kw[16], name[NAME_LEN];
+    char a[TEXT_LEN], b[TEXT_LEN], c[TEXT_LEN], d[TEXT_LEN];
+    char *hash = strchr(line, '#');
+    int n;
+
+    lineNumber++;
+    if (hash != NULL) {
+      *hash = '\0';
+    }
+    n = sscanf(line, "%15s %47[^= \t\r\n]", kw, name);
+    if (n <= 0) {
+      continue;
+    }
+    if (n < 2) {
+      fail("incomplete statement");
+    }
+    if (strcmp(kw, "input") == 0) {
+      Signal_t *s;
+
+      if (sscanf(line, "%*s %*s %95s %95s", a, b) != 2) {
+        fail("usage: input NAME SOURCESEL SIGSEL");
+      }
+      s = newSignal(name);
+      s->isInput = 1;
+      s->inputIndex = inputCount++;
+      snprintf(s->source, sizeof(s->source), "%s", a);
+      snprintf(s->signal, sizeof(s->signal), "%s", b);
+    } else if (strcmp(kw, "node") == 0) {
+      Signal_t *s;
+      char *eq = strchr(line, '=');
+
+      if (eq == NULL) {
+        fail("usage: node NAME = EXPR");
+      }
+      cursor = eq + 1;
+      s = newSignal(name);
+      s->expr = parseOr();
+      skipSpace();
+      if (*cursor != '\0') {
+        fail("unexpected '%s' in expression", cursor);
+      }
+      collectVars(s->expr, s);
+    } else if (strcmp(kw, "route") == 0) {
+      Route_t *r;
+
+      if (routeCount == MAX_ROUTES) {
+        fail("too many routes");
+      }
+      r = &routes[routeCount++];
+      memset(r, 0, sizeof(*r));
+      r->signal = findSignal(name);
+      if (r->signal == NONE) {
+        fail("route of undefined signal '%s'", name);
+      }
+      n = sscanf(line, "%*s %*s %95s %95s %95s %95s", a, b, c, d);
+      r->bankMask = BANK_ANY;
+      if ((n == 3 || n == 4) && strcmp(a, "pin") == 0) {
+        r->isPin = 1;
+        snprintf(r->arg0, sizeof(r->arg0), "%s", b);
+        snprintf(r->arg1, sizeof(r->arg1), "%s", c);
+        if (n == 4) {
+          r->bankMask = parseBank(d);
+        }
+      } else if (n == 2 && strcmp(a, "consumer") == 0) {
+        snprintf(r->arg0, sizeof(r->arg0), "%s", b);
+      } else {
+        fail("usage: route NAME pin PORT PIN [BANK] | route NAME consumer C");
+      }
+    } else {
+      fail("unknown statement '%s'", kw);
+    }
+  }
+  fclose(f);
+  lineNumber = 0;
+}
+
+/*******************************************************************************
+ ****************************   Channel allocation   ***************************
+ ******************************************************************************/
+
+static int newEntity(int signal, int aInput, int bEntity, unsigned fnsel)
+{
+  Entity_t *e;
+
+  if (entityCount == MAX_ENTITIES) {
+    fail("netlist needs more than %d channels", MAX_ENTITIES);
+  }
+  e = &entities[entityCount];
+  e->signal = signal;
+  e->aInput = aInput;
+  e->bEntity = bEntity;
+  e->fnsel = fnsel;
+  e->bankMask = BANK_ANY;
+  e->channel = NONE;
+  return entityCount++;
+}
+
+/***************************************************************************//**
+ * @brief Return a channel that passes input signal s through unchanged.
+ *
+ * With a free AUXSEL one passthrough can feed any number of channels. When B
+ * is wired to the previous channel every consumer needs its own copy.
+ ******************************************************************************/
+static int passthrough(int s, int shared)
+{
+  if (shared && signals[s].passEntity != NONE) {
+    return signals[s].passEntity;
+  }
+  signals[s].passEntity = newEntity(s, s, NONE, PRSNET_FNSEL_A);
+  return signals[s].passEntity;
+}
+
+/***************************************************************************//**
+ * @brief Build the truth table of node s with signal a on A and b on B.
+ ******************************************************************************/
+static unsigned lutFor(const Signal_t *s, int a, int b)
+{
+  int level[MAX_SIGNALS] = { 0 };
+  unsigned fnsel = 0;
+  unsigned idx;
+
+  for (idx = 0; idx < 4; idx++) {
+    if (a != NONE) {
+      level[a] = (idx >> 1) & 1;
+    }
+    if (b != NONE) {
+      level[b] = idx & 1;
+    }
+    fnsel |= (unsigned)evalExpr(s->expr, level) << idx;
+  }
+  return fnsel;
+}
+
+static void buildEntities(void)
+{
+  int shared = !target->adjacentAux;
+  int i;
+
+  for (i = 0; i < signalCount; i++) {
+    Signal_t *s = &signals[i];
+    int a = NONE;
+    int b = NONE;
+    int bEntity = NONE;
+
+    if (s->isInput) {
+      continue;
+    }
+    if (s->varCount == 2) {
+      int v0 = s->vars[0];
+      int v1 = s->vars[1];
+
+      if (!signals[v0].isInput && !signals[v1].isInput) {
+        fail("'%s' combines two nodes; one operand must be an input",
+             s->name);
+      }
+      // Sample an input directly as A and take the other operand on B
+      if (signals[v0].isInput && (!signals[v1].isInput
+                                  || signals[v0].passEntity == NONE)) {
+        a = v0;
+        b = v1;
+      } else {
+        a = v1;
+        b = v0;
+      }
+    } else if (s->varCount == 1) {
+      if (signals[s->vars[0]].isInput) {
+        a = s->vars[0];
+      } else {
+        b = s->vars[0];
+      }
+    }
+    if (b != NONE) {
+      bEntity = signals[b].isInput ? passthrough(b, shared)
+                : signals[b].entity;
+    }
+    s->entity = newEntity(i, a, bEntity, lutFor(s, a, b));
+  }
+
+  for (i = 0; i < routeCount; i++) {
+    Route_t *r = &routes[i];
+    const Signal_t *s = &signals[r->signal];
+
+    r->entity = s->isInput ? passthrough(r->signal, 1) : s->entity;
+    entities[r->entity].bankMask &= r->bankMask;
+    if (entities[r->entity].bankMask == 0) {
+      fail("'%s' is routed to pins in different banks", s->name);
+    }
+  }
+}
+
+static int assign(int index, unsigned used)
+{
+  Entity_t *e;
+  int ch;
+
+  if (index == entityCount) {
+    return 1;
+  }
+  e = &entities[index];
+  for (ch = 0; ch < target->channels; ch++) {
+    if ((used & (1u << ch)) || !(e->bankMask & (1u << ch))) {
+      continue;
+    }
+    // Channel 0 wraps to a device-specific channel, so keep it B-free
+    if (target->adjacentAux && e->bEntity != NONE
+        && (ch == 0 || entities[e->bEntity].channel != ch - 1)) {
+      continue;
+    }
+    e->channel = ch;
+    if (assign(index + 1, used | (1u << ch))) {
+      return 1;
+    }
+  }
+  e->channel = NONE;
+  return 0;
+}
+
+static int auxOf(const Entity_t *e)
+{
+  return e->bEntity != NONE ? entities[e->bEntity].channel : PRSNET_NO_AUX;
+}
+
+static void compileNetlist(const char *path)
+{
+  readNetlist(path);
+  buildEntities();
+  if (!assign(0, 0)) {
+    fail("no channel assignment satisfies the %s constraints", target->name);
+  }
+}
+
+/*******************************************************************************
+ ********************************   Generator   ********************************
+ ******************************************************************************/
+
+static void emitHeader(FILE *out, const char *netlist, const char *outName)
+{
+  char guard[TEXT_LEN];
+  const char *base = strrchr(outName, '/');
+  const char *source = strrchr(netlist, '/');
+  int i;
+  size_t n;
+
+  base = base != NULL ? base + 1 : outName;
+  source = source != NULL ? source + 1 : netlist;
+  for (n = 0; base[n] != '\0' && n < sizeof(guard) - 1; n++) {
+    guard[n] = isalnum((unsigned char)base[n])
+               ? (char)toupper((unsigned char)base[n]) : '_';
+  }
+  guard[n] = '\0';
+
+  fprintf(out, "/* Generated by prsnet from %s for %s. Do not edit. */\n\n",
+          source, target->name);
+  fprintf(out, "#ifndef %s\n#define %s\n\n#include \"prs_netlist.h\"\n\n",
+          guard, guard);
+
+  for (i = 0; i < signalCount; i++) {
+    if (signals[i].isInput) {
+      fprintf(out, "#define PRSNET_INPUT_%-16s %d\n",
+              signals[i].name, signals[i].inputIndex);
+    }
+  }
+  fprintf(out, "#define %-29s %d\n\n", "PRSNET_INPUT_COUNT", inputCount);
+  for (i = 0; i < signalCount; i++) {
+    if (!signals[i].isInput) {
+      fprintf(out, "#define PRSNET_CH_%-19s %d\n", signals[i].name,
+              entities[signals[i].entity].channel);
+    }
+  }
+
+  fprintf(out, "\nstatic const PRSNET_Channel_TypeDef prsnetChannels[] = {\n");
+  for (i = 0; i < entityCount; i++) {
+    const Entity_t *e = &entities[i];
+
+    if (e->aInput != NONE) {
+      const Signal_t *in = &signals[e->aInput];
+
+      fprintf(out, "  { %2d, PRSNET_SOURCE(%s, %s), PRSNET_INPUT_%s, 0x%X, ",
+              e->channel, in->source, in->signal, in->name, e->fnsel);
+    } else {
+      fprintf(out, "  { %2d, PRSNET_SOURCE(0, 0), PRSNET_NO_INPUT, 0x%X, ",
+              e->channel, e->fnsel);
+    }
+    if (e->bEntity != NONE) {
+      fprintf(out, "%d },", auxOf(e));
+    } else {
+      fprintf(out, "PRSNET_NO_AUX },");
+    }
+    fprintf(out, " // %s\n", signals[e->signal].name);
+  }
+  fprintf(out, "};\n\n");
+
+  if (routeCount > 0) {
+    fprintf(out, "static const PRSNET_Route_TypeDef prsnetRoutes[] = {\n");
+    for (i = 0; i < routeCount; i++) {
+      const Route_t *r = &routes[i];
+
+      if (r->isPin) {
+        fprintf(out, "  { %2d, PRSNET_ROUTE_PIN(%s, %s) },\n",
+                entities[r->entity].channel, r->arg0, r->arg1);
+      } else {
+        fprintf(out, "  { %2d, PRSNET_ROUTE_CONSUMER(%s) },\n",
+                entities[r->entity].channel, r->arg0);
+      }
+    }
+    fprintf(out, "};\n\n");
+  }
+
+  fprintf(out, "static const PRSNET_Netlist_TypeDef prsnetNetlist = {\n");
+  fprintf(out, "  prsnetChannels, sizeof(prsnetChannels) / sizeof(prsnetChannels[0]),\n");
+  if (routeCount > 0) {
+    fprintf(out, "  prsnetRoutes, sizeof(prsnetRoutes) / sizeof(prsnetRoutes[0])\n");
+  } else {
+    fprintf(out, "  NULL, 0\n");
+  }
+  fprintf(out, "};\n\n#endif // %s\n", guard);
+}
+
+/*******************************************************************************
+ ********************************   Simulator   ********************************
+ ******************************************************************************/
+
+static int simulate(const char *vectorPath)
+{
+  PRSNET_Channel_TypeDef table[MAX_ENTITIES];
+  PRSNET_Netlist_TypeDef net = { table, 0, NULL, 0 };
+  uint8_t inputs[MAX_SIGNALS] = { 0 };
+  uint8_t chOut[PRSNET_MAX_CHANNELS];
+  int level[MAX_SIGNALS];
+  char line[256];
+  FILE *f;
+  int cycle = 0;
+  int failures = 0;
+  int i;
+
+  for (i = 0; i < entityCount; i++) {
+    const Entity_t *e = &entities[i];
+
+    memset(&table[i], 0, sizeof(table[i]));
+    table[i].channel = (uint8_t)e->channel;
+    table[i].input = e->aInput != NONE
+                     ? (uint8_t)signals[e->aInput].inputIndex : PRSNET_NO_INPUT;
+    table[i].fnsel = (uint8_t)e->fnsel;
+    table[i].auxChannel = (uint8_t)auxOf(e);
+  }
+  net.channelCount = (size_t)entityCount;
+
+  fileName = vectorPath;
+  f = fopen(vectorPath, "r");
+  if (f == NULL) {
+    fail("cannot open vectors");
+  }
+
+  printf("cycle");
+  for (i = 0; i < signalCount; i++) {
+    printf(" %s", signals[i].name);
+  }
+  printf("\n");
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char *expect;
+    char *tok;
+    int pass;
+
+    lineNumber++;
+    if ((tok = strchr(line, '#')) != NULL) {
+      *tok = '\0';
+    }
+    if (strspn(line, " \t\r\n") == strlen(line)) {
+      continue;
+    }
+    expect = strchr(line, ':');
+    if (expect != NULL) {
+      *expect++ = '\0';
+    }
+
+    // Apply this cycle's input changes
+    for (tok = strtok(line, " \t\r\n"); tok != NULL; tok = strtok(NULL, " \t\r\n")) {
+      char *eq = strchr(tok, '=');
+      int s;
+
+      if (eq == NULL) {
+        fail("expected NAME=0|1, got '%s'", tok);
+      }
+      *eq = '\0';
+      s = findSignal(tok);
+      if (s == NONE || !signals[s].isInput) {
+        fail("'%s' is not an input", tok);
+      }
+      inputs[signals[s].inputIndex] = (uint8_t)(eq[1] == '1');
+    }
+
+    // Settle the compiled channel network and the reference netlist model
+    PRSNET_Evaluate(&net, inputs, chOut);
+    for (i = 0; i < signalCount; i++) {
+      const Signal_t *s = &signals[i];
+
+      level[i] = s->isInput ? inputs[s->inputIndex] : evalExpr(s->expr, level);
+      if (!s->isInput && chOut[entities[s->entity].channel] != level[i]) {
+        fail("cycle %d: compiled channel %d disagrees with '%s'", cycle,
+             entities[s->entity].channel, s->name);
+      }
+    }
+
+    printf("%5d", cycle);
+    for (i = 0; i < signalCount; i++) {
+      printf(" %*d", (int)strlen(signals[i].name), level[i]);
+    }
+
+    // Compare against the expected outputs, if any
+    pass = 1;
+    for (tok = expect != NULL ? strtok(expect, " \t\r\n") : NULL; tok != NULL;
+         tok = strtok(NULL, " \t\r\n")) {
+      char *eq = strchr(tok, '=');
+      int s;
+
+      if (eq == NULL) {
+        fail("expected NAME=0|1, got '%s'", tok);
+      }
+      *eq = '\0';
+      s = findSignal(tok);
+      if (s == NONE) {
+        fail("'%s' is not defined", tok);
+      }
+      if (level[s] != (eq[1] == '1')) {
+        printf("  FAIL %s=%d expected %c", tok, level[s], eq[1]);
+        pass = 0;
+      }
+    }
+    printf("\n");
+    failures += !pass;
+    cycle++;
+  }
+  fclose(f);
+
+  printf("%d cycles, %d failures\n", cycle, failures);
+  return failures == 0 ? 0 : 1;
+}
+
+/*******************************************************************************
+ **********************************   Main   ***********************************
+ ******************************************************************************/
+
+static void usage(void)
+{
+  fprintf(stderr,
+          "usage: prsnet compile [-t target] [-D VAR=VALUE] [-o out.h] netlist\n"
+          "       prsnet sim     [-t target] [-D VAR=VALUE] netlist vectors\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  const char *outName = NULL;
+  int argi = 2;
+  size_t t;
+
+  if (argc < 3) {
+    usage();
+  }
+  while (argi < argc && argv[argi][0] == '-') {
+    if (argi + 1 >= argc) {
+      usage();
+    }
+    if (strcmp(argv[argi], "-t") == 0) {
+      target = NULL;
+      for (t = 0; t < sizeof(targets) / sizeof(targets[0]); t++) {
+        if (strcmp(targets[t].name, argv[argi + 1]) == 0) {
+          target = &targets[t];
+        }
+      }
+      if (target == NULL) {
+        fprintf(stderr, "unknown target '%s'\n", argv[argi + 1]);
+        return 2;
+      }
+    } else if (strcmp(argv[argi], "-D") == 0 && defineCount < MAX_DEFINES) {
+      char *eq = strchr(argv[argi + 1], '=');
+
+      if (eq == NULL) {
+        usage();
+      }
+      *eq = '\0';
+      snprintf(defineName[defineCount], NAME_LEN, "%s", argv[argi + 1]);
+      snprintf(defineValue[defineCount], TEXT_LEN, "%s", eq + 1);
+      defineCount++;
+    } else if (strcmp(argv[argi], "-o") == 0) {
+      outName = argv[argi + 1];
+    } else {
+      usage();
+    }
+    argi += 2;
+  }
+
+  if (strcmp(argv[1], "compile") == 0 && argi + 1 == argc) {
+    FILE *out = stdout;
+
+    compileNetlist(argv[argi]);
+    if (outName != NULL && (out = fopen(outName, "w")) == NULL) {
+      perror(outName);
+      return 2;
+    }
+    emitHeader(out, argv[argi], outName != NULL ? outName : "prs_netlist_cfg.h");
+    if (out != stdout) {
+      fclose(out);
+    }
+    return 0;
+  }
+  if (strcmp(argv[1], "sim") == 0 && argi + 2 == argc) {
+    compileNetlist(argv[argi]);
+    return simulate(argv[argi + 1]);
+  }
+  usage();
+  return 2;
+}
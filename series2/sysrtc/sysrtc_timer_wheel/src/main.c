@@ -0,0 +1,222 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Runs thousands of software timers on the SYSRTC with a tickless
+ * timer wheel, waking from EM2 only when a timer expires.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "tw.h"
+
+// Simulated links, each with a retransmission timeout
+#define LINKS           2000
+
+// Timeouts and reply times, in ms
+#define TIMEOUT_MIN_MS  200
+#define TIMEOUT_MAX_MS  5000
+#define REPLY_MAX_MS    6000
+
+// Periodic timers, in ms
+#define HEARTBEAT_MS    1000
+#define REPORT_MS       10000
+
+typedef struct {
+  TW_Timer_TypeDef timeout;
+  TW_Timer_TypeDef reply;
+} Link_TypeDef;
+
+static TW_Handle_TypeDef wheel;
+static TW_Timer_TypeDef heartbeat, reportTimer;
+static Link_TypeDef links[LINKS];
+static uint32_t tickHz;
+
+// Statistics
+static uint32_t timeouts, replies, wakes, maxLate;
+
+/**************************************************************************//**
+ * @brief
+ *   SYSRTC application IRQ handler; the wake-up for the next expiry.
+ *****************************************************************************/
+void SYSRTC_APP_IRQHandler(void)
+{
+  TW_IRQHandler();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Pseudo-random times for the simulated traffic.
+ *****************************************************************************/
+static uint32_t randomMs(uint32_t range)
+{
+  static uint32_t state = 1;
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state % range;
+}
+
+static uint32_t msToTicks(uint32_t ms)
+{
+  return (uint32_t)((uint64_t)ms * tickHz / 1000);
+}
+
+static void timeoutExpired(void *user);
+static void replyArrived(void *user);
+
+/**************************************************************************//**
+ * @brief
+ *   Send a packet on a link: arm its timeout, and the reply that will
+ *   arrive after a random time, often after the timeout.
+ *****************************************************************************/
+static void send(Link_TypeDef *link)
+{
+  uint32_t now = TW_Now();
+  uint32_t timeout = TIMEOUT_MIN_MS
+                     + randomMs(TIMEOUT_MAX_MS - TIMEOUT_MIN_MS);
+
+  TW_TimerStart(&wheel, &link->timeout, now, msToTicks(timeout), 0,
+                timeoutExpired, link);
+  TW_TimerStart(&wheel, &link->reply, now, msToTicks(randomMs(REPLY_MAX_MS)),
+                0, replyArrived, link);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The reply came first: cancel the timeout and send the next packet.
+ *****************************************************************************/
+static void replyArrived(void *user)
+{
+  Link_TypeDef *link = user;
+
+  TW_TimerStop(&wheel, &link->timeout);
+  replies++;
+  send(link);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The timeout came first: drop the reply and send again.
+ *****************************************************************************/
+static void timeoutExpired(void *user)
+{
+  Link_TypeDef *link = user;
+  uint32_t late = TW_Now() - link->timeout.expiry;
+
+  if (late > maxLate) {
+    maxLate = late;
+  }
+  TW_TimerStop(&wheel, &link->reply);
+  timeouts++;
+  send(link);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Heartbeat on LED0; GPIO outputs hold their state in EM2.
+ *****************************************************************************/
+static void blink(void *user)
+{
+  (void)user;
+  GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Print the traffic and wheel statistics.  USART0 stops in EM2, so the
+ *   output is flushed before the next sleep.
+ *****************************************************************************/
+static void report(void *user)
+{
+  (void)user;
+  printf("\n%lu s: %lu timers running\n",
+         (unsigned long)(TW_Now() / tickHz), (unsigned long)wheel.count);
+  printf("  replies %lu, timeouts %lu, worst lateness %lu ticks\n",
+         (unsigned long)replies, (unsigned long)timeouts,
+         (unsigned long)maxLate);
+  printf("  callbacks %lu, wake-ups %lu, cascades %lu\n",
+         (unsigned long)wheel.runs, (unsigned long)wakes,
+         (unsigned long)wheel.cascades);
+  RETARGET_SerialFlush();
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  uint32_t now;
+  int i;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+
+  printf("\nTimer wheel, %d links\n", LINKS);
+  RETARGET_SerialFlush();
+
+  tickHz = TW_Start();
+  now = TW_Now();
+  TW_Init(&wheel, now);
+
+  TW_TimerStart(&wheel, &heartbeat, now, msToTicks(HEARTBEAT_MS),
+                msToTicks(HEARTBEAT_MS), blink, NULL);
+  TW_TimerStart(&wheel, &reportTimer, now, msToTicks(REPORT_MS),
+                msToTicks(REPORT_MS), report, NULL);
+  for (i = 0; i < LINKS; i++) {
+    send(&links[i]);
+  }
+
+  while (1) {
+    TW_Idle(&wheel);
+    wakes++;
+  }
+}
@@ -0,0 +1,489 @@
+/***************************************************************************//**
+ * @file tw.c
+ * @brief Tickless hierarchical timer wheel on a free-running low frequency
+ * counter, for thousands of software timers.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "tw.h"
+
+#if defined(TW_HOST)
+#define CORE_DECLARE_IRQ_STATE
+#define CORE_ENTER_CRITICAL()
+#define CORE_EXIT_CRITICAL()
+#define CLZ(x)            ((unsigned int)__builtin_clz(x))
+#define CTZ(x)            ((unsigned int)__builtin_ctz(x))
+#else
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_emu.h"
+#include "peripheral_sysrtc.h"
+#define CLZ(x)            __CLZ(x)
+#define CTZ(x)            __CLZ(__RBIT(x))
+
+/**************************************************************************//**
+ * @brief
+ *   Start the wheel time base.
+ *
+ * @details
+ *   The SYSRTC counts the LFXO and runs free; group 0 compare 0 wakes the
+ *   device for the next expiry. The LFXO keeps running in EM2, so timers
+ *   do not keep the device out of it.
+ *
+ * @return
+ *   Counter ticks per second.
+ *****************************************************************************/
+uint32_t TW_Start(void)
+{
+  CMU_LFXOInit_TypeDef lfxoInit = CMU_LFXOINIT_DEFAULT;
+  sl_sysrtc_config_t sysrtcConfig = SYSRTC_CONFIG_DEFAULT;
+  sl_sysrtc_group_config_t groupConfig = SYSRTC_GROUP_CONFIG_DEFAULT;
+
+  CMU_LFXOInit(&lfxoInit);
+  CMU_ClockSelectSet(cmuClock_SYSRTCCLK, cmuSelect_LFXO);
+  CMU_ClockEnable(cmuClock_SYSRTC, true);
+
+  sl_sysrtc_reset();
+  sl_sysrtc_init(&sysrtcConfig);
+  sl_sysrtc_init_group(0, &groupConfig);
+  sl_sysrtc_enable();
+
+  sl_sysrtc_clear_group_interrupts(0, SYSRTC_GRP0_IF_CMP0);
+  NVIC_ClearPendingIRQ(SYSRTC_APP_IRQn);
+  NVIC_EnableIRQ(SYSRTC_APP_IRQn);
+
+  return CMU_ClockFreqGet(cmuClock_SYSRTC);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Current counter value in ticks.
+ *****************************************************************************/
+uint32_t TW_Now(void)
+{
+  return sl_sysrtc_get_counter();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Wake-up for the next expiry; call from SYSRTC_APP_IRQHandler().
+ *
+ * @details
+ *   Callbacks run from TW_Idle() in thread mode, not here.
+ *****************************************************************************/
+void TW_IRQHandler(void)
+{
+  sl_sysrtc_clear_group_interrupts(0, SYSRTC_GRP0_IF_CMP0);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run due callbacks, then sleep in EM2 until the next expiry.
+ *
+ * @details
+ *   Call from the main loop with nothing else to do. The compare is set
+ *   once, to the first expiry of all timers, and nothing runs at the
+ *   ticks in between. The decision and the sleep are made with interrupts
+ *   masked, so an interrupt that starts an earlier timer wakes the core
+ *   from WFI and the next call sets the compare again.
+ *****************************************************************************/
+void TW_Idle(TW_Handle_TypeDef *handle)
+{
+  uint32_t now, left;
+  CORE_DECLARE_IRQ_STATE;
+
+  TW_Dispatch(handle, TW_Now());
+
+  CORE_ENTER_CRITICAL();
+  now = TW_Now();
+  left = TW_NextExpiry(handle, now);
+  if (left < TW_MIN_TICKS) {
+    CORE_EXIT_CRITICAL();
+    return;
+  }
+
+  sl_sysrtc_clear_group_interrupts(0, SYSRTC_GRP0_IF_CMP0);
+  if (left != TW_FOREVER) {
+    sl_sysrtc_set_group_compare_channel_value(0, 0, now + left);
+    sl_sysrtc_enable_group_interrupts(0, SYSRTC_GRP0_IEN_CMP0);
+  } else {
+    sl_sysrtc_disable_group_interrupts(0, SYSRTC_GRP0_IEN_CMP0);
+  }
+
+  EMU_EnterEM2(true);
+  CORE_EXIT_CRITICAL();
+}
+#endif // !TW_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Append a timer to a list; the wheel slots mark themselves occupied.
+ *****************************************************************************/
+static void listAdd(TW_Handle_TypeDef *handle,
+                    TW_Timer_TypeDef *timer,
+                    unsigned int index)
+{
+  TW_Timer_TypeDef *head = handle->lists[index];
+
+  if (head == NULL) {
+    timer->next = timer;
+    timer->prev = timer;
+    handle->lists[index] = timer;
+  } else {
+    timer->next = head;
+    timer->prev = head->prev;
+    head->prev->next = timer;
+    head->prev = timer;
+  }
+  timer->where = (uint16_t)(index + 1);
+  if (index < TW_EXPIRED) {
+    handle->occupied[index / TW_SLOTS] |= 1UL << (index % TW_SLOTS);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take a timer off its list without walking it.
+ *****************************************************************************/
+static void listRemove(TW_Handle_TypeDef *handle, TW_Timer_TypeDef *timer)
+{
+  unsigned int index = timer->where - 1;
+
+  if (timer->next == timer) {
+    handle->lists[index] = NULL;
+    if (index < TW_EXPIRED) {
+      handle->occupied[index / TW_SLOTS] &= ~(1UL << (index % TW_SLOTS));
+    }
+  } else {
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    if (handle->lists[index] == timer) {
+      handle->lists[index] = timer->next;
+    }
+  }
+  timer->where = 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Put a timer in the slot for its expiry, seen from the wheel time.
+ *
+ * @details
+ *   The level is that of the highest bit in which expiry and wheel time
+ *   differ, and the slot is the expiry's bits at that level. A timer in
+ *   level n therefore expires after all timers in levels below n, and
+ *   shares all higher bits with the wheel time; at the top level, the
+ *   counter wrap makes slots below the current one the next round.
+ *****************************************************************************/
+static void place(TW_Handle_TypeDef *handle, TW_Timer_TypeDef *timer)
+{
+  unsigned int level;
+  uint32_t slot;
+
+  if ((int32_t)(timer->expiry - handle->now) <= 0) {
+    listAdd(handle, timer, TW_EXPIRED);
+    return;
+  }
+  level = (31 - CLZ(timer->expiry ^ handle->now)) / TW_LEVEL_BITS;
+  slot = (timer->expiry >> (level * TW_LEVEL_BITS)) & (TW_SLOTS - 1);
+  listAdd(handle, timer, level * TW_SLOTS + slot);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Find the next slot to process, in the lowest occupied level.
+ *
+ * @param[out] start
+ *   First tick covered by the slot. For level 0 this is the expiry of all
+ *   its timers; for higher levels, the time to move them down a level.
+ *
+ * @return
+ *   List index of the slot, or -1 if the wheel is empty.
+ *****************************************************************************/
+static int nextSlot(const TW_Handle_TypeDef *handle, uint32_t *start)
+{
+  unsigned int level, shift, current, slot;
+  uint32_t map, ahead, above;
+
+  for (level = 0; level < TW_LEVELS; level++) {
+    map = handle->occupied[level];
+    if (map == 0) {
+      continue;
+    }
+    shift = level * TW_LEVEL_BITS;
+    current = (handle->now >> shift) & (TW_SLOTS - 1);
+    ahead = (current + 1 < TW_SLOTS) ? map & (0xFFFFFFFFUL << (current + 1))
+            : 0;
+    slot = CTZ(ahead != 0 ? ahead : map);
+
+    above = (shift + TW_LEVEL_BITS < 32)
+            ? handle->now & (0xFFFFFFFFUL << (shift + TW_LEVEL_BITS)) : 0;
+    *start = above | ((uint32_t)slot << shift);
+    return (int)(level * TW_SLOTS + slot);
+  }
+  return -1;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize an empty wheel.
+ *
+ * @details
+ *   Timers left in a wheel that is initialized again must be zeroed
+ *   before their next start.
+ *
+ * @param[in] now
+ *   Current counter value.
+ *****************************************************************************/
+void TW_Init(TW_Handle_TypeDef *handle, uint32_t now)
+{
+  memset(handle, 0, sizeof(*handle));
+  handle->now = now;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start or restart a timer in constant time.
+ *
+ * @details
+ *   Callable from interrupt handlers. The timer struct must be zeroed, or
+ *   static, before its first start.
+ *
+ * @param[in] now
+ *   Current counter value.
+ *
+ * @param[in] delay
+ *   Ticks to the first expiry, at most TW_MAX_DELAY.
+ *
+ * @param[in] period
+ *   Ticks between later expiries, at most TW_MAX_DELAY; 0 for a one-shot
+ *   timer.
+ *
+ * @param[in] callback
+ *   Called from TW_Dispatch(), in thread mode.
+ *****************************************************************************/
+void TW_TimerStart(TW_Handle_TypeDef *handle,
+                   TW_Timer_TypeDef *timer,
+                   uint32_t now,
+                   uint32_t delay,
+                   uint32_t period,
+                   TW_Callback_TypeDef callback,
+                   void *user)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  TW_TimerStop(handle, timer);
+
+  CORE_ENTER_CRITICAL();
+  // An empty wheel may have been left for longer than the counter range;
+  // a running one wakes at least for its first expiry, and catches up so
+  // the new expiry is within half the counter range of the wheel time
+  if (handle->count == 0) {
+    handle->now = now;
+  } else if ((int32_t)(now - handle->now) > (int32_t)TW_MAX_DELAY) {
+    TW_Advance(handle, now);
+  }
+
+  timer->expiry = now + (delay < TW_MAX_DELAY ? delay : TW_MAX_DELAY);
+  timer->period = period < TW_MAX_DELAY ? period : TW_MAX_DELAY;
+  timer->callback = callback;
+  timer->user = user;
+  place(handle, timer);
+  handle->count++;
+  CORE_EXIT_CRITICAL();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Stop a timer in constant time; nothing happens if it is not running.
+ *****************************************************************************/
+void TW_TimerStop(TW_Handle_TypeDef *handle, TW_Timer_TypeDef *timer)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  if (timer->where != 0) {
+    listRemove(handle, timer);
+    handle->count--;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Whether a timer is running, or expired with its callback not yet run.
+ *****************************************************************************/
+bool TW_TimerRunning(const TW_Timer_TypeDef *timer)
+{
+  return timer->where != 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Bring the wheel time to now and move due timers to the expired list.
+ *
+ * @details
+ *   Only occupied slots are visited, lowest level first: a level 0 slot
+ *   holds timers due at its tick, and the timers of a higher level slot
+ *   are placed again, in lower levels, once its first tick is reached.
+ *   Each timer moves down at most TW_LEVELS - 1 times in its life, so the
+ *   cost per timer is bounded whatever the time that has passed.
+ *
+ * @return
+ *   Timers moved to the expired list.
+ *****************************************************************************/
+int TW_Advance(TW_Handle_TypeDef *handle, uint32_t now)
+{
+  TW_Timer_TypeDef *t;
+  uint32_t start;
+  int index, moved = 0;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  // An earlier reading of the counter than the wheel time changes nothing
+  if ((int32_t)(now - handle->now) < 0) {
+    CORE_EXIT_CRITICAL();
+    return 0;
+  }
+
+  while ((index = nextSlot(handle, &start)) >= 0
+         && start - handle->now <= now - handle->now) {
+    handle->now = start;
+    while ((t = handle->lists[index]) != NULL) {
+      listRemove(handle, t);
+      place(handle, t);
+      if (t->where == TW_EXPIRED + 1) {
+        moved++;
+      } else {
+        handle->cascades++;
+      }
+    }
+  }
+  handle->now = now;
+  CORE_EXIT_CRITICAL();
+  return moved;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Ticks from now to the first expiry.
+ *
+ * @details
+ *   The lowest occupied level holds the first timers. In level 0 they all
+ *   expire at the slot tick; in a higher level the slot is searched, so
+ *   the compare is set to the exact expiry and not to the time the slot
+ *   moves down a level.
+ *
+ * @return
+ *   0 if a timer is due, TW_FOREVER if none is running.
+ *****************************************************************************/
+uint32_t TW_NextExpiry(const TW_Handle_TypeDef *handle, uint32_t now)
+{
+  const TW_Timer_TypeDef *t;
+  uint32_t start, first, left;
+  int index;
+
+  if (handle->lists[TW_EXPIRED] != NULL) {
+    return 0;
+  }
+  index = nextSlot(handle, &start);
+  if (index < 0) {
+    return TW_FOREVER;
+  }
+  if (index >= TW_SLOTS) {
+    t = handle->lists[index];
+    first = t->expiry - handle->now;
+    do {
+      left = t->expiry - handle->now;
+      if (left < first) {
+        first = left;
+      }
+      t = t->next;
+    } while (t != handle->lists[index]);
+    start = handle->now + first;
+  }
+  return (int32_t)(start - now) > 0 ? start - now : 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run the callbacks of all due timers.
+ *
+ * @details
+ *   A periodic timer is placed again before its callback runs, so the
+ *   callback may stop or restart it. A periodic timer that fell behind
+ *   skips the periods it missed rather than running once for each. Timers
+ *   due at the same tick run in no particular order.
+ *
+ * @return
+ *   Callbacks run.
+ *****************************************************************************/
+int TW_Dispatch(TW_Handle_TypeDef *handle, uint32_t now)
+{
+  TW_Timer_TypeDef *t;
+  TW_Callback_TypeDef callback;
+  void *user;
+  uint32_t late;
+  int runs = 0;
+  CORE_DECLARE_IRQ_STATE;
+
+  TW_Advance(handle, now);
+
+  while (1) {
+    CORE_ENTER_CRITICAL();
+    t = handle->lists[TW_EXPIRED];
+    if (t == NULL) {
+      CORE_EXIT_CRITICAL();
+      break;
+    }
+    listRemove(handle, t);
+    if (t->period != 0) {
+      late = handle->now - t->expiry;
+      t->expiry += t->period * (late / t->period + 1);
+      place(handle, t);
+    } else {
+      handle->count--;
+    }
+    callback = t->callback;
+    user = t->user;
+    handle->runs++;
+    CORE_EXIT_CRITICAL();
+
+    if (callback != NULL) {
+      callback(user);
+    }
+    runs++;
+  }
+  return runs;
+}
@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ * @file tw.h
+ * @brief Tickless hierarchical timer wheel on a free-running low frequency
+ * counter, for thousands of software timers.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef TW_H
+#define TW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Wheel geometry.  Each level has 32 slots, one bit of a 32-bit occupancy
+ * word each; level n slots are 32^n ticks wide.  Seven levels cover the
+ * whole 32-bit counter.
+ */
+#define TW_LEVEL_BITS     5
+#define TW_SLOTS          (1 << TW_LEVEL_BITS)
+#define TW_LEVELS         7
+
+/// Index of the expired list, after the wheel slots
+#define TW_EXPIRED        (TW_LEVELS * TW_SLOTS)
+
+/// Longest delay or period, in ticks; about 9 hours at 32768 Hz
+#define TW_MAX_DELAY      0x3FFFFFFFUL
+
+/*
+ * Shortest sleep, in ticks.  A new SYSRTC compare value takes a few cycles
+ * of its clock to take effect, so a timer due sooner is waited for awake.
+ */
+#ifndef TW_MIN_TICKS
+#define TW_MIN_TICKS      3
+#endif
+
+/// No timer running
+#define TW_FOREVER        0xFFFFFFFFUL
+
+typedef void (*TW_Callback_TypeDef)(void *user);
+
+/// A one-shot or periodic timer; times are in counter ticks
+typedef struct TW_Timer {
+  struct TW_Timer     *next;      ///< Circular list of the slot
+  struct TW_Timer     *prev;
+  uint32_t            expiry;
+  uint32_t            period;     ///< 0 for one-shot
+  TW_Callback_TypeDef callback;
+  void                *user;
+  uint16_t            where;      ///< List index + 1; 0 when stopped
+} TW_Timer_TypeDef;
+
+/// Wheel state; under 1 KB whatever the number of timers
+typedef struct {
+  uint32_t          now;                      ///< Wheel time
+  uint32_t          occupied[TW_LEVELS];      ///< Non-empty slots
+  TW_Timer_TypeDef  *lists[TW_EXPIRED + 1];   ///< Slots, then expired
+  uint32_t          count;                    ///< Timers running
+
+  // Statistics
+  uint32_t          cascades;   ///< Timers moved to a finer level
+  uint32_t          runs;       ///< Callbacks run
+} TW_Handle_TypeDef;
+
+void TW_Init(TW_Handle_TypeDef *handle, uint32_t now);
+void TW_TimerStart(TW_Handle_TypeDef *handle,
+                   TW_Timer_TypeDef *timer,
+                   uint32_t now,
+                   uint32_t delay,
+                   uint32_t period,
+                   TW_Callback_TypeDef callback,
+                   void *user);
+void TW_TimerStop(TW_Handle_TypeDef *handle, TW_Timer_TypeDef *timer);
+bool TW_TimerRunning(const TW_Timer_TypeDef *timer);
+int TW_Advance(TW_Handle_TypeDef *handle, uint32_t now);
+uint32_t TW_NextExpiry(const TW_Handle_TypeDef *handle, uint32_t now);
+int TW_Dispatch(TW_Handle_TypeDef *handle, uint32_t now);
+
+#if !defined(TW_HOST)
+uint32_t TW_Start(void);
+uint32_t TW_Now(void);
+void TW_Idle(TW_Handle_TypeDef *handle);
+void TW_IRQHandler(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TW_H
@@ -0,0 +1,422 @@
+/***************************************************************************//**
+ * @file tw_sim.c
+ * @brief Host test and benchmark for the timer wheel.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DTW_HOST -I../src -o tw_sim tw_sim.c ../src/tw.c
+ *   ./tw_sim
+ *
+ * Checks the wheel against a reference model: thousands of one-shot and
+ * periodic timers are started, stopped and restarted at random while the
+ * time moves on in random steps, in jumps to the next expiry as the
+ * tickless idle loop does, and across the counter wrap. Every dispatch
+ * must run exactly the timers due, and the next expiry must be exact.
+ * Callbacks that stop or restart their own timer, and a wheel left idle
+ * for hours, are checked too. The benchmark then times start, stop and
+ * expiry with 10000 timers, next to the sorted list that the other timer
+ * examples use. The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tw.h"
+
+#define TIMERS      4000
+#define BENCH       10000
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+static uint32_t rngState = 1;
+
+static uint32_t rng(void)
+{
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+/// Random delay: mostly protocol timeouts, some long, some due at once
+static uint32_t randomDelay(void)
+{
+  switch (rng() % 8) {
+    case 0:
+      return rng() % 4;
+    case 1:
+      return rng() % (TW_MAX_DELAY + 1);
+    case 2:
+      return rng() % 0x100000;
+    default:
+      return 1 + rng() % 5000;
+  }
+}
+
+// ---------------------------------------------------------------- model
+
+static TW_Handle_TypeDef wheel;
+static TW_Timer_TypeDef timers[TIMERS];
+
+static struct {
+  int      running;
+  uint32_t expiry;
+  uint32_t period;
+} ref[TIMERS];
+
+static unsigned char fired[TIMERS];
+static int firedCount;
+
+static void record(void *user)
+{
+  int i = (int)(intptr_t)user;
+
+  fired[i]++;
+  firedCount++;
+}
+
+static void refStart(int i, uint32_t now, uint32_t delay, uint32_t period)
+{
+  ref[i].running = 1;
+  ref[i].expiry = now + delay;
+  ref[i].period = period;
+  TW_TimerStart(&wheel, &timers[i], now, delay, period, record,
+                (void *)(intptr_t)i);
+}
+
+static void refStop(int i)
+{
+  ref[i].running = 0;
+  TW_TimerStop(&wheel, &timers[i]);
+}
+
+static uint32_t refNext(uint32_t now)
+{
+  uint32_t best = TW_FOREVER;
+  int32_t left;
+  int i;
+
+  for (i = 0; i < TIMERS; i++) {
+    if (ref[i].running) {
+      left = (int32_t)(ref[i].expiry - now);
+      if (left <= 0) {
+        return 0;
+      }
+      if ((uint32_t)left < best) {
+        best = (uint32_t)left;
+      }
+    }
+  }
+  return best;
+}
+
+/// Dispatch both; every due timer must run once, and no other
+static int refDispatch(uint32_t now)
+{
+  int i, due = 0, ok = 1, running = 0;
+  uint32_t late;
+
+  memset(fired, 0, sizeof(fired));
+  firedCount = 0;
+  TW_Dispatch(&wheel, now);
+
+  for (i = 0; i < TIMERS; i++) {
+    if (ref[i].running && (int32_t)(ref[i].expiry - now) <= 0) {
+      due++;
+      ok &= fired[i] == 1;
+      if (ref[i].period != 0) {
+        late = now - ref[i].expiry;
+        ref[i].expiry += ref[i].period * (late / ref[i].period + 1);
+      } else {
+        ref[i].running = 0;
+      }
+    } else {
+      ok &= fired[i] == 0;
+    }
+    ok &= TW_TimerRunning(&timers[i]) == (ref[i].running != 0);
+    running += ref[i].running;
+  }
+  ok &= firedCount == due && wheel.count == (uint32_t)running;
+  return ok;
+}
+
+static void testModel(uint32_t origin, const char *what)
+{
+  uint32_t now = origin, next, step;
+  int i, round, ok = 1, exact = 1;
+  char text[80];
+
+  TW_Init(&wheel, now);
+  memset(timers, 0, sizeof(timers));
+  memset(ref, 0, sizeof(ref));
+
+  for (i = 0; i < TIMERS; i++) {
+    refStart(i, now, randomDelay(), (rng() % 4 == 0) ? 1 + rng() % 3000 : 0);
+  }
+
+  for (round = 0; round < 20000; round++) {
+    // Churn: stop, restart or start a few timers
+    for (i = 0; i < 8; i++) {
+      int t = (int)(rng() % TIMERS);
+      if (rng() % 3 == 0) {
+        refStop(t);
+      } else {
+        refStart(t, now, randomDelay(),
+                 (rng() % 4 == 0) ? 1 + rng() % 3000 : 0);
+      }
+    }
+
+    next = TW_NextExpiry(&wheel, now);
+    exact &= next == refNext(now);
+
+    // The idle loop sleeps to the next expiry; otherwise something else
+    // woke the core early or late
+    switch (rng() % 4) {
+      case 0:
+        step = rng() % 64;
+        break;
+      case 1:
+        step = rng() % 0x10000;
+        break;
+      default:
+        step = (next == TW_FOREVER) ? 1000 : next;
+        break;
+    }
+    now += step;
+    ok &= refDispatch(now);
+  }
+
+  snprintf(text, sizeof(text), "model %s: due timers run once", what);
+  check(ok, text);
+  snprintf(text, sizeof(text), "model %s: next expiry exact", what);
+  check(exact, text);
+}
+
+// ---------------------------------------------------------------- callbacks
+
+static TW_Timer_TypeDef selfTimer, otherTimer;
+static int selfRuns, otherRuns;
+
+static void stopSelf(void *user)
+{
+  (void)user;
+  if (++selfRuns == 3) {
+    TW_TimerStop(&wheel, &selfTimer);
+  }
+}
+
+static void restartOther(void *user)
+{
+  uint32_t now = *(uint32_t *)user;
+
+  if (++otherRuns < 5) {
+    TW_TimerStart(&wheel, &otherTimer, now, 7, 0, restartOther, user);
+  }
+}
+
+static void testCallbacks(void)
+{
+  uint32_t now = 0xFFFFFF00UL;
+  int i;
+
+  TW_Init(&wheel, now);
+  memset(&selfTimer, 0, sizeof(selfTimer));
+  memset(&otherTimer, 0, sizeof(otherTimer));
+  TW_TimerStart(&wheel, &selfTimer, now, 10, 10, stopSelf, NULL);
+  TW_TimerStart(&wheel, &otherTimer, now, 7, 0, restartOther, &now);
+
+  for (i = 0; i < 200; i++) {
+    now++;
+    TW_Dispatch(&wheel, now);
+  }
+  check(selfRuns == 3 && !TW_TimerRunning(&selfTimer),
+        "periodic timer stops itself");
+  check(otherRuns == 5 && !TW_TimerRunning(&otherTimer),
+        "one-shot timer restarts itself");
+  check(wheel.count == 0 && TW_NextExpiry(&wheel, now) == TW_FOREVER,
+        "wheel empty after callbacks");
+
+  // A periodic timer that falls behind skips the periods it missed
+  selfRuns = 0;
+  TW_TimerStart(&wheel, &selfTimer, now, 10, 10, stopSelf, NULL);
+  TW_Dispatch(&wheel, now + 55);
+  check(selfRuns == 1 && TW_NextExpiry(&wheel, now + 55) == 5,
+        "periodic timer skips missed periods");
+  TW_TimerStop(&wheel, &selfTimer);
+
+  // An empty wheel may be left for longer than the counter range
+  now += 0xC0000000UL;
+  TW_TimerStart(&wheel, &otherTimer, now, 100, 0, restartOther, &now);
+  check(TW_NextExpiry(&wheel, now) == 100, "empty wheel left idle");
+
+  // A running one that missed its expiry catches up on the next start
+  now += 0x60000000UL;
+  TW_TimerStart(&wheel, &selfTimer, now, TW_MAX_DELAY, 0, stopSelf, NULL);
+  check(TW_NextExpiry(&wheel, now) == 0, "missed timer due at once");
+  TW_TimerStop(&wheel, &otherTimer);
+  check(TW_NextExpiry(&wheel, now) == TW_MAX_DELAY, "wheel caught up");
+}
+
+// ---------------------------------------------------------------- benchmark
+
+/// The sorted list of the sleep scheduler and other examples, for scale
+typedef struct ListTimer {
+  struct ListTimer *next;
+  uint32_t         expiry;
+} ListTimer;
+
+static void listInsert(ListTimer **head, ListTimer *t)
+{
+  ListTimer **p;
+
+  for (p = head; *p != NULL; p = &(*p)->next) {
+    if ((int32_t)(t->expiry - (*p)->expiry) < 0) {
+      break;
+    }
+  }
+  t->next = *p;
+  *p = t;
+}
+
+static int expired;
+
+static void count(void *user)
+{
+  (void)user;
+  expired++;
+}
+
+static void benchmark(void)
+{
+  static TW_Timer_TypeDef bench[BENCH];
+  static ListTimer list[BENCH];
+  static uint32_t delays[BENCH];
+  ListTimer *head = NULL;
+  uint32_t now = 0xFFF00000UL, next;
+  int i, wakes = 0;
+  clock_t start;
+  double insert, stop, expire, churn, sorted;
+  const int rounds = 50;
+  int r;
+
+  // Delays from 1 ms to 60 s at 32768 Hz
+  for (i = 0; i < BENCH; i++) {
+    delays[i] = 33 + rng() % (60 * 32768);
+  }
+  memset(bench, 0, sizeof(bench));
+
+  insert = stop = 0;
+  for (r = 0; r < rounds; r++) {
+    TW_Init(&wheel, now);
+    start = clock();
+    for (i = 0; i < BENCH; i++) {
+      TW_TimerStart(&wheel, &bench[i], now, delays[i], 0, count, NULL);
+    }
+    insert += (double)(clock() - start);
+    start = clock();
+    for (i = 0; i < BENCH; i++) {
+      TW_TimerStop(&wheel, &bench[(i * 7919) % BENCH]);
+    }
+    stop += (double)(clock() - start);
+  }
+  check(wheel.count == 0, "benchmark stops all");
+
+  // Restart a running timer, as when a reply arrives before its timeout
+  TW_Init(&wheel, now);
+  for (i = 0; i < BENCH; i++) {
+    TW_TimerStart(&wheel, &bench[i], now, delays[i], 0, count, NULL);
+  }
+  start = clock();
+  for (r = 0; r < rounds * BENCH; r++) {
+    i = (int)(rng() % BENCH);
+    TW_TimerStart(&wheel, &bench[i], now + r / 64, delays[i], 0, count, NULL);
+  }
+  churn = (double)(clock() - start);
+
+  // Tickless expiry: jump to the next expiry, dispatch, repeat
+  TW_Init(&wheel, now);
+  memset(bench, 0, sizeof(bench));
+  for (i = 0; i < BENCH; i++) {
+    TW_TimerStart(&wheel, &bench[i], now, delays[i], 0, count, NULL);
+  }
+  expired = 0;
+  wheel.cascades = 0;
+  start = clock();
+  while ((next = TW_NextExpiry(&wheel, now)) != TW_FOREVER) {
+    now += next;
+    TW_Dispatch(&wheel, now);
+    wakes++;
+  }
+  expire = (double)(clock() - start);
+  check(expired == BENCH, "benchmark expires all");
+  check(wheel.cascades <= (uint32_t)BENCH * (TW_LEVELS - 1),
+        "bounded cascades per timer");
+
+  start = clock();
+  for (i = 0; i < BENCH; i++) {
+    list[i].expiry = now + delays[i];
+    listInsert(&head, &list[i]);
+  }
+  sorted = (double)(clock() - start);
+
+  printf("%d timers, 1 ms to 60 s at 32768 Hz:\n", BENCH);
+  printf("  start   %6.1f ns\n", insert * 1e9 / CLOCKS_PER_SEC / rounds / BENCH);
+  printf("  stop    %6.1f ns\n", stop * 1e9 / CLOCKS_PER_SEC / rounds / BENCH);
+  printf("  restart %6.1f ns\n", churn * 1e9 / CLOCKS_PER_SEC / rounds / BENCH);
+  printf("  expiry  %6.1f ns, with next expiry; %d wakes, "
+         "%.2f moves per timer\n",
+         expire * 1e9 / CLOCKS_PER_SEC / BENCH, wakes,
+         (double)wheel.cascades / BENCH);
+  printf("  sorted list insert %.1f ns\n", sorted * 1e9 / CLOCKS_PER_SEC / BENCH);
+  printf("on this host\n");
+}
+
+int main(void)
+{
+  testModel(0, "from 0");
+  testModel(0xFFFE0000UL, "across wrap");
+  testModel(0x7FFFF000UL, "across sign");
+  testCallbacks();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
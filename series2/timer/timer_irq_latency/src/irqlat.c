@@ -0,0 +1,452 @@
+/***************************************************************************//**
+ * @file irqlat.c
+ * @brief Interrupt latency histograms.  On the device, TIMER0 counts the
+ * core clock; it captures the event through the PRS and is read again at
+ * handler entry.  In EM2, where TIMER0 stops, LETIMER0 is the event and its
+ * next tick is timed on wake-up instead.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "irqlat.h"
+
+#if !defined(IRQLAT_HOST)
+#include "em_cmu.h"
+#include "em_letimer.h"
+#include "em_prs.h"
+#include "em_timer.h"
+
+#define CLZ(x)          __CLZ(x)
+#else
+#define CLZ(x)          ((uint32_t)__builtin_clz(x))
+#endif
+
+// log2(IRQLAT_EXACT)
+#define EXACT_BITS      5
+#define SUBS            (1UL << IRQLAT_SUB_BITS)
+
+#if (1 << EXACT_BITS) != IRQLAT_EXACT
+#error "EXACT_BITS must match IRQLAT_EXACT"
+#endif
+
+void IRQLAT_Reset(IRQLAT_Hist_TypeDef *hist)
+{
+  memset(hist, 0, sizeof(*hist));
+  hist->min = UINT32_MAX;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Bucket of a latency.
+ *****************************************************************************/
+uint32_t IRQLAT_Bucket(uint32_t cycles)
+{
+  uint32_t e;
+
+  if (cycles < IRQLAT_EXACT) {
+    return cycles;
+  }
+  e = 31 - CLZ(cycles);
+  return IRQLAT_EXACT + (e - EXACT_BITS) * SUBS
+         + ((cycles >> (e - IRQLAT_SUB_BITS)) & (SUBS - 1));
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Lowest latency in a bucket.
+ *****************************************************************************/
+uint32_t IRQLAT_BucketLow(uint32_t bucket)
+{
+  uint32_t e, sub;
+
+  if (bucket < IRQLAT_EXACT) {
+    return bucket;
+  }
+  e = EXACT_BITS + (bucket - IRQLAT_EXACT) / SUBS;
+  sub = (bucket - IRQLAT_EXACT) % SUBS;
+  return (SUBS + sub) << (e - IRQLAT_SUB_BITS);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Highest latency in a bucket.
+ *****************************************************************************/
+uint32_t IRQLAT_BucketHigh(uint32_t bucket)
+{
+  if (bucket < IRQLAT_EXACT) {
+    return bucket;
+  }
+  return IRQLAT_BucketLow(bucket)
+         + ((1UL << (EXACT_BITS + (bucket - IRQLAT_EXACT) / SUBS
+                     - IRQLAT_SUB_BITS)) - 1);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count a latency.  Safe to call from the handler being measured, as
+ *   long as no other handler adds to the same histogram.
+ *****************************************************************************/
+void IRQLAT_Add(IRQLAT_Hist_TypeDef *hist, uint32_t cycles)
+{
+  hist->count++;
+  hist->sum += cycles;
+  if (cycles < hist->min) {
+    hist->min = cycles;
+  }
+  if (cycles > hist->max) {
+    hist->max = cycles;
+  }
+  hist->bins[IRQLAT_Bucket(cycles)]++;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count the latency between a capture of the event and the timestamp at
+ *   handler entry.
+ *
+ * @param[in] capture
+ *   Timer count captured by the event.
+ *
+ * @param[in] entry
+ *   Timer count read at handler entry.  The counter may have wrapped
+ *   once since the capture.
+ *
+ * @return
+ *   The latency in timer cycles.
+ *****************************************************************************/
+uint32_t IRQLAT_Record(IRQLAT_Hist_TypeDef *hist, uint32_t capture,
+                       uint32_t entry)
+{
+  uint32_t cycles = entry - capture;
+
+  IRQLAT_Add(hist, cycles);
+  return cycles;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count events that happened again before their handler ran, and so
+ *   have no latency of their own.
+ *****************************************************************************/
+void IRQLAT_Coalesced(IRQLAT_Hist_TypeDef *hist, uint32_t events)
+{
+  hist->coalesced += events;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Latency of a low-frequency event, from the ticks counted since it and
+ *   the time waited for the next tick.
+ *
+ * @details
+ *   The event happens on a tick.  Entry is "ticks" whole ticks after it,
+ *   and "waited" cycles before the next one, so the latency is
+ *   (ticks + 1) ticks less the wait.  A delay in reading the tick counter
+ *   moves both reads alike and only offsets the result.
+ *
+ * @param[in] ticks
+ *   Whole ticks between the event and entry.
+ *
+ * @param[in] cyclesPerTick256
+ *   Timer cycles per tick, times 256.
+ *
+ * @param[in] waited
+ *   Timer cycles from entry until the tick count changed.
+ *****************************************************************************/
+uint32_t IRQLAT_Vernier(uint32_t ticks, uint32_t cyclesPerTick256,
+                        uint32_t waited)
+{
+  uint32_t span = (uint32_t)(((uint64_t)(ticks + 1) * cyclesPerTick256
+                              + 128) >> 8);
+
+  return (span > waited) ? (span - waited) : 0;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Latency that a share of the samples do not exceed.
+ *
+ * @details
+ *   The result is the top of the bucket holding the sample of that rank,
+ *   and so at most 1/16 above the exact value; it is never above the
+ *   largest sample.
+ *
+ * @param[in] permille
+ *   Share in thousandths: 500 for the median, 999 for the 99.9th
+ *   percentile.
+ *****************************************************************************/
+uint32_t IRQLAT_Percentile(const IRQLAT_Hist_TypeDef *hist, uint32_t permille)
+{
+  uint64_t rank;
+  uint64_t seen = 0;
+  uint32_t b, high;
+
+  if (hist->count == 0) {
+    return 0;
+  }
+  rank = ((uint64_t)hist->count * permille + 999) / 1000;
+  if (rank == 0) {
+    return hist->min;
+  }
+  for (b = IRQLAT_Bucket(hist->min); b < IRQLAT_BUCKETS; b++) {
+    seen += hist->bins[b];
+    if (seen >= rank) {
+      break;
+    }
+  }
+  high = IRQLAT_BucketHigh(b);
+  return (high < hist->max) ? high : hist->max;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Column names of the lines from IRQLAT_Report().  Every line starts
+ *   with "irqlat," so that it can be picked out of other output.
+ *****************************************************************************/
+void IRQLAT_Header(IRQLAT_Emit_TypeDef emit)
+{
+  emit("irqlat,stimulus,load,hz,count,min,p50,p90,p99,p999,max,mean,"
+       "coalesced");
+}
+
+/**************************************************************************//**
+ * @brief
+ *   One line of statistics, in timer cycles; hz is the timer clock, so that
+ *   the counts convert to time.
+ *****************************************************************************/
+void IRQLAT_Report(const IRQLAT_Hist_TypeDef *hist, const char *stimulus,
+                   const char *load, uint32_t hz, IRQLAT_Emit_TypeDef emit)
+{
+  char line[IRQLAT_LINE_SIZE];
+
+  snprintf(line, sizeof(line),
+           "irqlat,%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu",
+           stimulus, load, (unsigned long)hz, (unsigned long)hist->count,
+           (unsigned long)((hist->count != 0) ? hist->min : 0),
+           (unsigned long)IRQLAT_Percentile(hist, 500),
+           (unsigned long)IRQLAT_Percentile(hist, 900),
+           (unsigned long)IRQLAT_Percentile(hist, 990),
+           (unsigned long)IRQLAT_Percentile(hist, 999),
+           (unsigned long)hist->max,
+           (unsigned long)((hist->count != 0) ? hist->sum / hist->count : 0),
+           (unsigned long)hist->coalesced);
+  emit(line);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   The buckets that are not empty, one line each:
+ *
+ *     irqlat_bin,stimulus,load,low,high,count
+ *****************************************************************************/
+void IRQLAT_ReportBins(const IRQLAT_Hist_TypeDef *hist, const char *stimulus,
+                       const char *load, IRQLAT_Emit_TypeDef emit)
+{
+  char line[IRQLAT_LINE_SIZE];
+  uint32_t b;
+
+  for (b = 0; b < IRQLAT_BUCKETS; b++) {
+    if (hist->bins[b] != 0) {
+      snprintf(line, sizeof(line), "irqlat_bin,%s,%s,%lu,%lu,%lu",
+               stimulus, load, (unsigned long)IRQLAT_BucketLow(b),
+               (unsigned long)IRQLAT_BucketHigh(b),
+               (unsigned long)hist->bins[b]);
+      emit(line);
+    }
+  }
+}
+
+#if !defined(IRQLAT_HOST)
+/*******************************************************************************
+ * Timestamps on the device
+ ******************************************************************************/
+
+// LETIMER0 ticks timed to find the TIMER0 cycles per tick
+#define LF_CALIBRATION_TICKS  64
+
+static uint32_t lfTop;
+static uint32_t lfCyclesPerTick256;
+
+/**************************************************************************//**
+ * @brief
+ *   Run TIMER0 from the core clock over its full 32 bits, and capture it
+ *   on events of a PRS channel.  The producer is connected by the caller.
+ *
+ * @param[in] pulse
+ *   true for a pulse signal, such as a timer overflow, captured once;
+ *   false for a level, such as a pin, captured on both edges.
+ *
+ * @return
+ *   TIMER0 clock in Hz.
+ *****************************************************************************/
+uint32_t IRQLAT_CaptureStart(unsigned int prsChannel, bool pulse)
+{
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+  TIMER_InitCC_TypeDef ccInit = TIMER_INITCC_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+
+  timerInit.enable = false;
+  TIMER_Init(TIMER0, &timerInit);
+
+  ccInit.eventCtrl = timerEventEveryEdge;
+  ccInit.edge = pulse ? timerEdgeRising : timerEdgeBoth;
+  ccInit.mode = timerCCModeCapture;
+  ccInit.prsInput = true;
+  ccInit.prsInputType = pulse ? timerPrsInputAsyncPulse
+                        : timerPrsInputAsyncLevel;
+  ccInit.prsSel = prsChannel;
+  TIMER_InitCC(TIMER0, 0, &ccInit);
+  PRS_ConnectConsumer(prsChannel, prsTypeAsync, prsConsumerTIMER0_CC0);
+
+  IRQLAT_CaptureFlush();
+  TIMER_Enable(TIMER0, true);
+
+  return CMU_ClockFreqGet(cmuClock_TIMER0);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Drop the captures left over from a previous run.
+ *****************************************************************************/
+void IRQLAT_CaptureFlush(void)
+{
+  while (!(TIMER0->STATUS & TIMER_STATUS_ICFEMPTY0)) {
+    (void)TIMER0->CC[0].ICF;
+  }
+  TIMER_IntClear(TIMER0, TIMER_IF_CC0 | TIMER_IF_ICBOF0);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Take the capture of the event being handled.
+ *
+ * @param[out] capture
+ *   TIMER0 count at the event.
+ *
+ * @param[out] extra
+ *   Later events already captured, or lost when the capture buffer
+ *   overflowed.  They happened before their handler could run, so they are
+ *   counted as coalesced rather than as latencies.
+ *
+ * @return
+ *   false if there was no capture.
+ *****************************************************************************/
+bool IRQLAT_CaptureTake(uint32_t *capture, uint32_t *extra)
+{
+  uint32_t n = 0;
+
+  if (TIMER0->STATUS & TIMER_STATUS_ICFEMPTY0) {
+    return false;
+  }
+  *capture = TIMER0->CC[0].ICF;
+  while (!(TIMER0->STATUS & TIMER_STATUS_ICFEMPTY0)) {
+    (void)TIMER0->CC[0].ICF;
+    n++;
+  }
+  if (TIMER0->IF & TIMER_IF_ICBOF0) {
+    n++;
+  }
+  TIMER_IntClear(TIMER0, TIMER_IF_CC0 | TIMER_IF_ICBOF0);
+  *extra = n;
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Underflow LETIMER0 every periodTicks of the LFRCO, with its
+ *   interrupt, and measure the TIMER0 cycles per tick.  TIMER0 must be
+ *   running.
+ *****************************************************************************/
+void IRQLAT_LfStart(uint32_t periodTicks)
+{
+  LETIMER_Init_TypeDef init = LETIMER_INIT_DEFAULT;
+  uint32_t last, start, i;
+
+  CMU_ClockSelectSet(cmuClock_EM23GRPACLK, cmuSelect_LFRCO);
+  CMU_ClockEnable(cmuClock_LETIMER0, true);
+
+  lfTop = periodTicks - 1;
+  init.comp0Top = true;
+  init.topValue = lfTop;
+  init.repMode = letimerRepeatFree;
+  LETIMER_Init(LETIMER0, &init);
+
+  // Start on a tick edge, then time whole ticks
+  last = LETIMER0->CNT;
+  while (LETIMER0->CNT == last) {
+  }
+  start = IRQLAT_NOW();
+  for (i = 0; i < LF_CALIBRATION_TICKS; i++) {
+    last = LETIMER0->CNT;
+    while (LETIMER0->CNT == last) {
+    }
+  }
+  lfCyclesPerTick256 = ((IRQLAT_NOW() - start) << 8) / LF_CALIBRATION_TICKS;
+
+  LETIMER_IntClear(LETIMER0, _LETIMER_IF_MASK);
+  LETIMER_IntEnable(LETIMER0, LETIMER_IEN_UF);
+  NVIC_ClearPendingIRQ(LETIMER0_IRQn);
+  NVIC_EnableIRQ(LETIMER0_IRQn);
+}
+
+void IRQLAT_LfStop(void)
+{
+  NVIC_DisableIRQ(LETIMER0_IRQn);
+  LETIMER_IntDisable(LETIMER0, LETIMER_IEN_UF);
+  LETIMER_Enable(LETIMER0, false);
+  LETIMER_IntClear(LETIMER0, _LETIMER_IF_MASK);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Call first thing in LETIMER0_IRQHandler().  Waits for the next tick,
+ *   up to 31 us, and returns the latency from the underflow in TIMER0
+ *   cycles.
+ *
+ * @details
+ *   The counter is reloaded with lfTop on underflow and counts down, so
+ *   lfTop - CNT ticks have passed since.  TIMER0 is stopped in EM2 and
+ *   cannot time the wake-up itself; it only times the part of a tick
+ *   left after it.
+ *****************************************************************************/
+uint32_t IRQLAT_LfEntry(void)
+{
+  uint32_t lf = LETIMER0->CNT;
+  uint32_t start = IRQLAT_NOW();
+
+  while (LETIMER0->CNT == lf) {
+  }
+  return IRQLAT_Vernier(lfTop - lf, lfCyclesPerTick256, IRQLAT_NOW() - start);
+}
+#endif // !IRQLAT_HOST
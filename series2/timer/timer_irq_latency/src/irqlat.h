@@ -0,0 +1,109 @@
+/***************************************************************************//**
+ * @file irqlat.h
+ * @brief Interrupt latency histograms: samples from a hardware timestamp of
+ * the event and a timestamp at handler entry, and a CSV report.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef IRQLAT_H
+#define IRQLAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if !defined(IRQLAT_HOST)
+#include "em_device.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ * Histogram buckets.  Latencies below IRQLAT_EXACT cycles have a bucket
+ * each; above, each power of two is split into 16 buckets, so that a
+ * bucket is at most 1/16 of its value wide.  All 32-bit values fit.
+ ******************************************************************************/
+#define IRQLAT_EXACT        32
+#define IRQLAT_SUB_BITS     4
+#define IRQLAT_BUCKETS      (IRQLAT_EXACT + (32 - 5) * (1 << IRQLAT_SUB_BITS))
+
+/// Longest line passed to the emit function, without the newline
+#define IRQLAT_LINE_SIZE    128
+
+/// Latencies of one stimulus under one load, in timer cycles
+typedef struct {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint32_t coalesced;       ///< Events merged into a later handler run
+  uint32_t bins[IRQLAT_BUCKETS];
+} IRQLAT_Hist_TypeDef;
+
+/// Receives one line of output, without the newline
+typedef void (*IRQLAT_Emit_TypeDef)(const char *line);
+
+void IRQLAT_Reset(IRQLAT_Hist_TypeDef *hist);
+uint32_t IRQLAT_Bucket(uint32_t cycles);
+uint32_t IRQLAT_BucketLow(uint32_t bucket);
+uint32_t IRQLAT_BucketHigh(uint32_t bucket);
+void IRQLAT_Add(IRQLAT_Hist_TypeDef *hist, uint32_t cycles);
+uint32_t IRQLAT_Record(IRQLAT_Hist_TypeDef *hist, uint32_t capture,
+                       uint32_t entry);
+void IRQLAT_Coalesced(IRQLAT_Hist_TypeDef *hist, uint32_t events);
+uint32_t IRQLAT_Vernier(uint32_t ticks, uint32_t cyclesPerTick256,
+                        uint32_t waited);
+uint32_t IRQLAT_Percentile(const IRQLAT_Hist_TypeDef *hist, uint32_t permille);
+void IRQLAT_Header(IRQLAT_Emit_TypeDef emit);
+void IRQLAT_Report(const IRQLAT_Hist_TypeDef *hist, const char *stimulus,
+                   const char *load, uint32_t hz, IRQLAT_Emit_TypeDef emit);
+void IRQLAT_ReportBins(const IRQLAT_Hist_TypeDef *hist, const char *stimulus,
+                       const char *load, IRQLAT_Emit_TypeDef emit);
+
+#if !defined(IRQLAT_HOST)
+/// Timestamp at handler entry; read it first thing in the handler
+#define IRQLAT_NOW()        (TIMER0->CNT)
+
+uint32_t IRQLAT_CaptureStart(unsigned int prsChannel, bool pulse);
+void IRQLAT_CaptureFlush(void);
+bool IRQLAT_CaptureTake(uint32_t *capture, uint32_t *extra);
+void IRQLAT_LfStart(uint32_t periodTicks);
+void IRQLAT_LfStop(void);
+uint32_t IRQLAT_LfEntry(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IRQLAT_H
@@ -0,0 +1,494 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Measures interrupt latency under background loads.  Each event is
+ * timestamped by TIMER0 through the PRS, and again at handler entry; the
+ * latencies are histogrammed and printed over the VCOM.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_letimer.h"
+#include "em_msc.h"
+#include "em_prs.h"
+#include "em_timer.h"
+#include "retargetserial.h"
+
+// BSP for the push button and LED of the escape hatch
+#include "bsp.h"
+
+#include "irqlat.h"
+
+// PRS channel from the event to the TIMER0 capture
+#define PRS_CHANNEL         0
+
+// Trigger pin: TIMER1 CC0 drives it, and its own input raises the GPIO
+// interrupt and the PRS event, so no wire is needed
+#define TRIGGER_PORT        gpioPortA
+#define TRIGGER_PIN         6
+
+// Events from TIMER1 at random intervals of 0.5 to 1.5 ms, so that they
+// land at every point of the background load
+#define PERIOD_MIN_US       500
+#define PERIOD_SPAN_US      1000
+
+// LETIMER0 events every 10 ms of the 32768 Hz LFRCO
+#define LF_PERIOD_TICKS     328
+
+// LDMA channels and words copied per descriptor for the LDMA load
+#define LOAD_LDMA_CH0       0
+#define LOAD_LDMA_CH1       1
+#define LOAD_WORDS          512
+
+// Words written to the scratch page at a time for the flash load
+#define LOAD_FLASH_WORDS    64
+
+/// Source of the events
+typedef enum {
+  stimulusTimer,      ///< TIMER1 overflow, to TIMER1_IRQHandler
+  stimulusGpio,       ///< Edge on the trigger pin, to GPIO_EVEN_IRQHandler
+  stimulusLetimer,    ///< LETIMER0 underflow, to LETIMER0_IRQHandler
+} Stimulus_TypeDef;
+
+/// What the main loop does between events
+typedef enum {
+  loadNone,           ///< Spin in EM0
+  loadEm1,            ///< Sleep in EM1
+  loadLdma,           ///< Spin while two LDMA channels copy RAM to RAM
+  loadFlash,          ///< Erase and write a scratch flash page
+  loadEm2,            ///< Sleep in EM2; LETIMER0 events only
+} Load_TypeDef;
+
+typedef struct {
+  Stimulus_TypeDef  stimulus;
+  Load_TypeDef      load;
+  uint32_t          samples;
+} Phase_TypeDef;
+
+static const char *const stimulusNames[] = { "timer", "gpio", "letimer" };
+static const char *const loadNames[] = { "none", "em1", "ldma", "flash",
+                                         "em2" };
+
+/*******************************************************************************
+ * The suite: edit to choose the events, loads and sample counts.  TIMER0
+ * stops in EM2, so only LETIMER0 events are measured there.
+ ******************************************************************************/
+static const Phase_TypeDef phases[] = {
+  { stimulusTimer,   loadNone,  2000 },
+  { stimulusTimer,   loadEm1,   2000 },
+  { stimulusTimer,   loadLdma,  2000 },
+  { stimulusTimer,   loadFlash, 2000 },
+  { stimulusGpio,    loadNone,  2000 },
+  { stimulusGpio,    loadEm1,   2000 },
+  { stimulusGpio,    loadLdma,  2000 },
+  { stimulusGpio,    loadFlash, 2000 },
+  { stimulusLetimer, loadNone,  300 },
+  { stimulusLetimer, loadEm2,   300 },
+};
+
+#define PHASE_COUNT         (sizeof(phases) / sizeof(phases[0]))
+
+static IRQLAT_Hist_TypeDef hist;
+static volatile uint32_t target;
+static uint32_t periodMin, periodSpan;
+static uint32_t seed = 0x2545F491;
+
+// LDMA load
+static uint32_t loadSrc[LOAD_WORDS], loadDst[2][LOAD_WORDS];
+static LDMA_Descriptor_t loadDesc[2];
+
+// Scratch page for the flash load: the last page of the main flash
+static uint32_t *const scratchPage =
+  (uint32_t *)(FLASH_BASE + FLASH_SIZE - FLASH_PAGE_SIZE);
+
+static void emit(const char *line)
+{
+  printf("%s\n", line);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Next TIMER1 period in cycles, from a xorshift generator.
+ *****************************************************************************/
+static uint32_t nextPeriod(void)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return periodMin + seed % periodSpan;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count the latency of the event being handled; entry is the TIMER0
+ *   count read first thing in the handler.
+ *****************************************************************************/
+static void sample(uint32_t entry)
+{
+  uint32_t capture, extra;
+
+  if (IRQLAT_CaptureTake(&capture, &extra) && (hist.count < target)) {
+    IRQLAT_Record(&hist, capture, entry);
+    IRQLAT_Coalesced(&hist, extra);
+  }
+  TIMER_TopBufSet(TIMER1, nextPeriod());
+}
+
+void TIMER1_IRQHandler(void)
+{
+  uint32_t entry = IRQLAT_NOW();
+
+  TIMER_IntClear(TIMER1, TIMER_IF_OF);
+  sample(entry);
+}
+
+void GPIO_EVEN_IRQHandler(void)
+{
+  uint32_t entry = IRQLAT_NOW();
+
+  GPIO_IntClear(1 << TRIGGER_PIN);
+  sample(entry);
+}
+
+void LETIMER0_IRQHandler(void)
+{
+  uint32_t latency = IRQLAT_LfEntry();
+
+  LETIMER_IntClear(LETIMER0, LETIMER_IF_UF);
+  if (hist.count < target) {
+    IRQLAT_Add(&hist, latency);
+  }
+}
+
+void LDMA_IRQHandler(void)
+{
+  uint32_t flags = LDMA_IntGet();
+
+  // Stop in case there was an error
+  if (flags & LDMA_IF_ERROR) {
+    __BKPT(0);
+  }
+  LDMA_IntClear(flags);
+}
+
+/**************************************************************************//**
+ * @brief escapeHatch()
+ * When developing or debugging code that enters EM2 or
+ * lower, it's a good idea to have an "escape hatch" type
+ * mechanism, e.g. a way to pause the device so that a debugger can
+ * connect in order to erase flash, among other things.
+ *
+ * Before proceeding with this example, make sure PB0 is not pressed.
+ * If the PB0 pin is low, turn on LED0 and execute the breakpoint
+ * instruction to stop the processor in EM0 and allow a debug
+ * connection to be made.
+ *****************************************************************************/
+void escapeHatch(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
+  if (GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == 0) {
+    GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 1);
+    __BKPT(0);
+  }
+  // Pin not asserted, so disable input
+  else {
+    GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeDisabled, 0);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   TIMER1 counts up from the core clock; its overflow is the event, or
+ *   toggles the trigger pin.  The buffered top sets the next period.
+ *****************************************************************************/
+static void initTIMER1(bool toggle)
+{
+  TIMER_Init_TypeDef init = TIMER_INIT_DEFAULT;
+  TIMER_InitCC_TypeDef ccInit = TIMER_INITCC_DEFAULT;
+  uint32_t hz;
+
+  CMU_ClockEnable(cmuClock_TIMER1, true);
+  hz = CMU_ClockFreqGet(cmuClock_TIMER1);
+  periodMin = hz / 1000000 * PERIOD_MIN_US;
+  periodSpan = hz / 1000000 * PERIOD_SPAN_US;
+
+  // TIMER1 is 16 bits wide; keep the longest period within it
+  if (periodMin + periodSpan > 0xFFFF) {
+    periodSpan = 0xFFFF - periodMin;
+  }
+
+  init.enable = false;
+  TIMER_Init(TIMER1, &init);
+  if (toggle) {
+    ccInit.mode = timerCCModeCompare;
+    ccInit.cofoa = timerOutputActionToggle;
+    ccInit.cmoa = timerOutputActionNone;
+    TIMER_InitCC(TIMER1, 0, &ccInit);
+    GPIO->TIMERROUTE[1].CC0ROUTE = (TRIGGER_PORT << _GPIO_TIMER_CC0ROUTE_PORT_SHIFT)
+                                   | (TRIGGER_PIN << _GPIO_TIMER_CC0ROUTE_PIN_SHIFT);
+    GPIO->TIMERROUTE[1].ROUTEEN = GPIO_TIMER_ROUTEEN_CC0PEN;
+  } else {
+    ccInit.mode = timerCCModeOff;
+    TIMER_InitCC(TIMER1, 0, &ccInit);
+    GPIO->TIMERROUTE[1].ROUTEEN = 0;
+  }
+  TIMER_CounterSet(TIMER1, 0);
+  TIMER_TopSet(TIMER1, nextPeriod());
+  TIMER_TopBufSet(TIMER1, nextPeriod());
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the events of a phase.
+ *
+ * @return
+ *   TIMER0 clock in Hz, the unit of the results.
+ *****************************************************************************/
+static uint32_t startStimulus(Stimulus_TypeDef stimulus)
+{
+  uint32_t hz;
+
+  switch (stimulus) {
+    case stimulusTimer:
+      PRS_ConnectSignal(PRS_CHANNEL, prsTypeAsync, prsSignalTIMER1_OF);
+      hz = IRQLAT_CaptureStart(PRS_CHANNEL, true);
+      initTIMER1(false);
+      TIMER_IntClear(TIMER1, _TIMER_IF_MASK);
+      TIMER_IntEnable(TIMER1, TIMER_IEN_OF);
+      NVIC_ClearPendingIRQ(TIMER1_IRQn);
+      NVIC_EnableIRQ(TIMER1_IRQn);
+      TIMER_Enable(TIMER1, true);
+      break;
+
+    case stimulusGpio:
+      GPIO_PinModeSet(TRIGGER_PORT, TRIGGER_PIN, gpioModePushPull, 0);
+      GPIO_ExtIntConfig(TRIGGER_PORT, TRIGGER_PIN, TRIGGER_PIN,
+                        true, true, true);
+      PRS_SourceAsyncSignalSet(PRS_CHANNEL, PRS_ASYNC_CH_CTRL_SOURCESEL_GPIO,
+                               TRIGGER_PIN);
+      hz = IRQLAT_CaptureStart(PRS_CHANNEL, false);
+      initTIMER1(true);
+      NVIC_ClearPendingIRQ(GPIO_EVEN_IRQn);
+      NVIC_EnableIRQ(GPIO_EVEN_IRQn);
+      TIMER_Enable(TIMER1, true);
+      break;
+
+    default:
+      PRS_ConnectSignal(PRS_CHANNEL, prsTypeAsync, prsSignalNone);
+      hz = IRQLAT_CaptureStart(PRS_CHANNEL, true);
+      IRQLAT_LfStart(LF_PERIOD_TICKS);
+      break;
+  }
+  return hz;
+}
+
+static void stopStimulus(Stimulus_TypeDef stimulus)
+{
+  switch (stimulus) {
+    case stimulusTimer:
+      TIMER_Enable(TIMER1, false);
+      TIMER_IntDisable(TIMER1, TIMER_IEN_OF);
+      NVIC_DisableIRQ(TIMER1_IRQn);
+      break;
+
+    case stimulusGpio:
+      TIMER_Enable(TIMER1, false);
+      GPIO_IntDisable(1 << TRIGGER_PIN);
+      NVIC_DisableIRQ(GPIO_EVEN_IRQn);
+      GPIO->TIMERROUTE[1].ROUTEEN = 0;
+      GPIO_PinModeSet(TRIGGER_PORT, TRIGGER_PIN, gpioModeDisabled, 0);
+      break;
+
+    default:
+      IRQLAT_LfStop();
+      break;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Two channels copy a RAM buffer over and over, each through a
+ *   descriptor that links to itself, without interrupts.
+ *****************************************************************************/
+static void startLdmaLoad(void)
+{
+  LDMA_TransferCfg_t cfg = LDMA_TRANSFER_CFG_MEMORY();
+  unsigned int i;
+
+  for (i = 0; i < 2; i++) {
+    loadDesc[i] = (LDMA_Descriptor_t)
+      LDMA_DESCRIPTOR_LINKREL_M2M_WORD(loadSrc, loadDst[i], LOAD_WORDS, 0);
+    loadDesc[i].xfer.doneIfs = 0;
+  }
+  LDMA_StartTransfer(LOAD_LDMA_CH0, &cfg, &loadDesc[0]);
+  LDMA_StartTransfer(LOAD_LDMA_CH1, &cfg, &loadDesc[1]);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Erase the scratch page, then fill it a few words at a time.  The core
+ *   stalls on fetches from the flash while it is busy, and so do handlers
+ *   and vectors in the flash.
+ *****************************************************************************/
+static void flashCycle(void)
+{
+  static uint32_t words[LOAD_FLASH_WORDS];
+  uint32_t offset;
+
+  MSC_ErasePage(scratchPage);
+  for (offset = 0; offset < FLASH_PAGE_SIZE / 4; offset += LOAD_FLASH_WORDS) {
+    words[0] = offset;
+    MSC_WriteWord(scratchPage + offset, words, sizeof(words));
+  }
+}
+
+static void startLoad(Load_TypeDef load)
+{
+  if (load == loadLdma) {
+    startLdmaLoad();
+  } else if (load == loadFlash) {
+    CMU_ClockEnable(cmuClock_MSC, true);
+    MSC_Init();
+  }
+}
+
+static void runLoad(Load_TypeDef load)
+{
+  switch (load) {
+    case loadEm1:
+      EMU_EnterEM1();
+      break;
+
+    case loadEm2:
+      EMU_EnterEM2(true);
+      break;
+
+    case loadFlash:
+      flashCycle();
+      break;
+
+    default:
+      break;
+  }
+}
+
+static void stopLoad(Load_TypeDef load)
+{
+  if (load == loadLdma) {
+    LDMA_StopTransfer(LOAD_LDMA_CH0);
+    LDMA_StopTransfer(LOAD_LDMA_CH1);
+  } else if (load == loadFlash) {
+    MSC_Deinit();
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Run a phase until its samples are taken, and report it.
+ *****************************************************************************/
+static void runPhase(const Phase_TypeDef *phase)
+{
+  uint32_t hz;
+
+  if ((phase->load == loadEm2) && (phase->stimulus != stimulusLetimer)) {
+    printf("skipped %s under em2: TIMER0 stops in EM2\n",
+           stimulusNames[phase->stimulus]);
+    return;
+  }
+
+  // Nothing else on the bus while the phase runs
+  RETARGET_SerialFlush();
+
+  IRQLAT_Reset(&hist);
+  target = phase->samples;
+  startLoad(phase->load);
+  hz = startStimulus(phase->stimulus);
+  while (hist.count < target) {
+    runLoad(phase->load);
+  }
+  stopStimulus(phase->stimulus);
+  stopLoad(phase->load);
+
+  IRQLAT_Report(&hist, stimulusNames[phase->stimulus],
+                loadNames[phase->load], hz, emit);
+  IRQLAT_ReportBins(&hist, stimulusNames[phase->stimulus],
+                    loadNames[phase->load], emit);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  uint32_t i;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Init DCDC regulator if available
+#if defined( DCDC )
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+#endif
+
+  escapeHatch();
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  CMU_ClockEnable(cmuClock_PRS, true);
+  LDMA_Init(&ldmaInit);
+
+  for (i = 0; i < LOAD_WORDS; i++) {
+    loadSrc[i] = i;
+  }
+
+  printf("\nInterrupt latency, in TIMER0 cycles\n");
+  IRQLAT_Header(emit);
+  for (i = 0; i < PHASE_COUNT; i++) {
+    runPhase(&phases[i]);
+  }
+  printf("done\n");
+  RETARGET_SerialFlush();
+
+  while (1) {
+    EMU_EnterEM1();
+  }
+}
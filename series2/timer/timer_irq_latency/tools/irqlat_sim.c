@@ -0,0 +1,517 @@
+/***************************************************************************//**
+ * @file irqlat_sim.c
+ * @brief Host test and benchmark for the interrupt latency histograms.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DIRQLAT_HOST -I../src -o irqlat_sim irqlat_sim.c \
+ *       ../src/irqlat.c
+ *   ./irqlat_sim
+ *
+ * The phases of the device suite run against a model of the measurement.
+ * Events come at random intervals; each is captured by a 32-bit TIMER0 that
+ * wraps during the run, and its handler starts after a latency injected
+ * from a model of the load:
+ *
+ *   none   exception entry and the timer read, plus the instruction in
+ *          progress
+ *   em1    as none, plus the wake-up from EM1
+ *   ldma   as none, plus waits for the bus
+ *   flash  as none, but nothing runs while the flash erases a page or
+ *          writes a block of words
+ *   em2    the wake-up from EM2, measured through LETIMER0 ticks
+ *
+ * Handlers keep the core busy for a while and a late handler finds later
+ * events in the two-entry capture buffer.  The histograms must match the
+ * injected latencies exactly for the TIMER0 captures, and within the
+ * polling step for the LETIMER0 phases; percentiles must be within a
+ * bucket of the exact values.  The exit status is non-zero if a check
+ * fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "irqlat.h"
+
+#define HZ              19000000UL
+#define LF_HZ           32768
+#define START_COUNT     0xFFF00000UL    // wraps TIMER0 early in each phase
+#define MAX_SAMPLES     4000
+
+// Core model, in cycles
+#define ENTRY           14      // Exception entry and the TIMER0 read
+#define HANDLER         150     // Time a handler keeps the core
+#define TAKE            24      // From entry to the capture read
+#define FIFO_DEPTH      2       // TIMER0 capture buffer
+#define POLL            12      // One read of the LETIMER0 count in a loop
+#define LF_READ_DELAY   3       // Age of the count a read returns
+#define LF_PERIOD_TICKS 328
+#define LF_CAL_TICKS    64
+
+// Flash model: a page erase, then 32 blocks of 64 word writes
+#define FLASH_ERASE     (HZ / 1000 * 12)
+#define FLASH_BLOCK     (64 * (HZ / 1000000 * 11))
+#define FLASH_GAP       40
+#define FLASH_BLOCKS    32
+#define FLASH_CYCLE     (FLASH_ERASE + FLASH_GAP \
+                         + FLASH_BLOCKS * (FLASH_BLOCK + FLASH_GAP))
+
+typedef enum { stimulusTimer, stimulusGpio, stimulusLetimer } Stimulus_TypeDef;
+typedef enum { loadNone, loadEm1, loadLdma, loadFlash, loadEm2 } Load_TypeDef;
+
+typedef struct {
+  Stimulus_TypeDef  stimulus;
+  Load_TypeDef      load;
+  uint32_t          samples;
+} Phase_TypeDef;
+
+static const char *const stimulusNames[] = { "timer", "gpio", "letimer" };
+static const char *const loadNames[] = { "none", "em1", "ldma", "flash",
+                                         "em2" };
+
+// The device suite
+static const Phase_TypeDef phases[] = {
+  { stimulusTimer,   loadNone,  2000 },
+  { stimulusTimer,   loadEm1,   2000 },
+  { stimulusTimer,   loadLdma,  2000 },
+  { stimulusTimer,   loadFlash, 2000 },
+  { stimulusGpio,    loadNone,  2000 },
+  { stimulusGpio,    loadEm1,   2000 },
+  { stimulusGpio,    loadLdma,  2000 },
+  { stimulusGpio,    loadFlash, 2000 },
+  { stimulusLetimer, loadNone,  300 },
+  { stimulusLetimer, loadEm2,   300 },
+};
+
+#define PHASE_COUNT     (sizeof(phases) / sizeof(phases[0]))
+
+static IRQLAT_Hist_TypeDef hist;
+static uint32_t truth[MAX_SAMPLES];
+static uint32_t truthCount, truthCoalesced;
+static uint32_t seed = 12345;
+static int failures;
+
+// Lines from the report functions
+static char lines[600][IRQLAT_LINE_SIZE];
+static uint32_t lineCount;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("  FAILED: %s\n", what);
+    failures++;
+  }
+}
+
+static uint32_t between(uint32_t lo, uint32_t hi)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return lo + seed % (hi - lo + 1);
+}
+
+static void collect(const char *line)
+{
+  if (lineCount < sizeof(lines) / sizeof(lines[0])) {
+    strncpy(lines[lineCount], line, IRQLAT_LINE_SIZE - 1);
+    lines[lineCount][IRQLAT_LINE_SIZE - 1] = '\0';
+  }
+  lineCount++;
+}
+
+static void print(const char *line)
+{
+  printf("%s\n", line);
+}
+
+static int columns(const char *line)
+{
+  int n = 1;
+
+  for (; *line != '\0'; line++) {
+    n += (*line == ',');
+  }
+  return n;
+}
+
+static int compare(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+ * Load models
+ ******************************************************************************/
+
+/**************************************************************************//**
+ * @brief
+ *   End of the flash operation under way at time t, or t if the flash is
+ *   idle.
+ *****************************************************************************/
+static uint64_t flashFree(uint64_t t)
+{
+  uint64_t pos = t % FLASH_CYCLE, q, r;
+
+  if (pos < FLASH_ERASE) {
+    return t - pos + FLASH_ERASE;
+  }
+  if (pos < FLASH_ERASE + FLASH_GAP) {
+    return t;
+  }
+  q = pos - FLASH_ERASE - FLASH_GAP;
+  r = q % (FLASH_BLOCK + FLASH_GAP);
+  return (r < FLASH_BLOCK) ? t - r + FLASH_BLOCK : t;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Time the handler of an event at time s can start, with the core free
+ *   from coreFree on.
+ *****************************************************************************/
+static uint64_t entryTime(Stimulus_TypeDef stimulus, Load_TypeDef load,
+                          uint64_t s, uint64_t coreFree)
+{
+  uint64_t t = s, entry;
+
+  // The pin interrupt goes through the GPIO synchronizer; the PRS does not
+  if (stimulus == stimulusGpio) {
+    t += between(2, 3);
+  }
+  switch (load) {
+    case loadEm1:
+      t += between(10, 24);
+      break;
+    case loadLdma:
+      t += between(0, 9);
+      break;
+    case loadFlash:
+      t = flashFree(t);
+      break;
+    default:
+      break;
+  }
+  entry = t + ENTRY + between(0, 2);
+  return (entry > coreFree) ? entry : coreFree;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   A phase with TIMER0 captures: events at random intervals of 0.5 to
+ *   1.5 ms, and the handler's capture logic of the device.
+ *****************************************************************************/
+static void runCapture(const Phase_TypeDef *phase)
+{
+  uint64_t s, coreFree = 0, entry;
+  uint64_t next = 1000;
+  uint32_t pending, extra;
+
+  while (hist.count < phase->samples) {
+    // The event to handle, and those that come before its capture is read
+    s = next;
+    next += between(HZ / 2000, HZ / 2000 * 3);
+    entry = entryTime(phase->stimulus, phase->load, s, coreFree);
+    pending = 1;
+    while (next < entry + TAKE) {
+      pending++;
+      next += between(HZ / 2000, HZ / 2000 * 3);
+    }
+    coreFree = entry + HANDLER;
+
+    // As IRQLAT_CaptureTake(): the oldest capture, the rest of the buffer,
+    // and one more for an overflow
+    extra = ((pending < FIFO_DEPTH) ? pending : FIFO_DEPTH) - 1
+            + (pending > FIFO_DEPTH);
+    IRQLAT_Record(&hist, (uint32_t)(START_COUNT + s),
+                  (uint32_t)(START_COUNT + entry));
+    IRQLAT_Coalesced(&hist, extra);
+    truth[truthCount++] = (uint32_t)(entry - s);
+    truthCoalesced += pending - 1;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Time of the first count change seen by a loop reading LETIMER0 every
+ *   POLL cycles from time t.
+ *****************************************************************************/
+static double lfChange(double t, double tick)
+{
+  double count = (double)(uint64_t)((t - LF_READ_DELAY) / tick);
+
+  do {
+    t += POLL;
+  } while ((double)(uint64_t)((t - LF_READ_DELAY) / tick) == count);
+  return t;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   A phase with LETIMER0 events, measured as IRQLAT_LfEntry() does.
+ *****************************************************************************/
+static void runLf(const Phase_TypeDef *phase)
+{
+  const double tick = (double)HZ / LF_HZ;
+  double start, end, u, e;
+  uint32_t cpt256, latency, measured, ticks;
+  uint32_t n = 1;
+
+  // IRQLAT_LfStart(): align to a tick, then time LF_CAL_TICKS ticks
+  start = lfChange(1234.5, tick);
+  end = start;
+  for (ticks = 0; ticks < LF_CAL_TICKS; ticks++) {
+    end = lfChange(end, tick);
+  }
+  cpt256 = (uint32_t)(((uint32_t)(end - start) << 8) / LF_CAL_TICKS);
+
+  while (hist.count < phase->samples) {
+    u = n++ * LF_PERIOD_TICKS * tick;
+    latency = ENTRY + between(0, 2);
+    if (phase->load == loadEm2) {
+      latency += between(HZ / 1000000 * 10, HZ / 1000000 * 30);
+    }
+    e = u + latency;
+
+    // Ticks counted at entry, and the wait for the next one
+    ticks = (uint32_t)((e - LF_READ_DELAY - u) / tick);
+    measured = IRQLAT_Vernier(ticks, cpt256,
+                              (uint32_t)(lfChange(e, tick) - e + 0.5));
+    IRQLAT_Add(&hist, measured);
+    truth[truthCount++] = latency;
+  }
+}
+
+/*******************************************************************************
+ * Tests
+ ******************************************************************************/
+
+static void testBuckets(void)
+{
+  uint32_t b, v, i, low, high;
+  int ok = 1;
+
+  for (b = 0; b < IRQLAT_BUCKETS; b++) {
+    low = IRQLAT_BucketLow(b);
+    high = IRQLAT_BucketHigh(b);
+    ok &= (low <= high) && (IRQLAT_Bucket(low) == b)
+          && (IRQLAT_Bucket(high) == b);
+    ok &= (high - low) <= ((low < 32) ? 0 : low / 16);
+    if (b + 1 < IRQLAT_BUCKETS) {
+      ok &= IRQLAT_BucketLow(b + 1) == high + 1;
+    }
+  }
+  check(ok, "buckets cover the values in order, at most 1/16 wide");
+  check(IRQLAT_BucketLow(0) == 0, "first bucket starts at 0");
+  check(IRQLAT_BucketHigh(IRQLAT_BUCKETS - 1) == UINT32_MAX,
+        "last bucket ends at 2^32 - 1");
+
+  ok = 1;
+  for (v = 0; v < (1UL << 20); v++) {
+    b = IRQLAT_Bucket(v);
+    ok &= (IRQLAT_BucketLow(b) <= v) && (v <= IRQLAT_BucketHigh(b));
+  }
+  for (i = 0; i < 1000000; i++) {
+    v = between(0, UINT32_MAX - 1) << between(0, 8);
+    b = IRQLAT_Bucket(v);
+    ok &= (b < IRQLAT_BUCKETS) && (IRQLAT_BucketLow(b) <= v)
+          && (v <= IRQLAT_BucketHigh(b));
+  }
+  check(ok, "every value falls in its bucket");
+}
+
+static void testStats(void)
+{
+  uint32_t v;
+
+  IRQLAT_Reset(&hist);
+  check(IRQLAT_Percentile(&hist, 500) == 0, "empty percentile is 0");
+  lineCount = 0;
+  IRQLAT_Report(&hist, "timer", "none", HZ, collect);
+  check(strcmp(lines[0], "irqlat,timer,none,19000000,0,0,0,0,0,0,0,0,0") == 0,
+        "empty report");
+
+  IRQLAT_Add(&hist, 17);
+  check((IRQLAT_Percentile(&hist, 0) == 17)
+        && (IRQLAT_Percentile(&hist, 500) == 17)
+        && (IRQLAT_Percentile(&hist, 999) == 17), "one sample");
+
+  IRQLAT_Reset(&hist);
+  for (v = 1; v <= 1000; v++) {
+    IRQLAT_Add(&hist, v);
+  }
+  check((hist.min == 1) && (hist.max == 1000) && (hist.sum == 500500),
+        "min, max and sum");
+  check((IRQLAT_Percentile(&hist, 500) >= 500)
+        && (IRQLAT_Percentile(&hist, 500) <= 500 + 500 / 16),
+        "median within a bucket");
+  check(IRQLAT_Percentile(&hist, 1000) == 1000, "100th percentile is max");
+  check(IRQLAT_Percentile(&hist, 10) == 10, "exact buckets are exact");
+
+  check(IRQLAT_Record(&hist, 0xFFFFFFF0UL, 0x00000010UL) == 0x20,
+        "latency across the counter wrap");
+  check(IRQLAT_Vernier(0, 580 * 256, 100) == 480, "vernier within a tick");
+  check(IRQLAT_Vernier(2, 580 * 256 + 128, 40) == 1742 - 40,
+        "vernier over ticks, rounded");
+  check(IRQLAT_Vernier(0, 580 * 256, 700) == 0, "vernier clamps at 0");
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Compare a phase's histogram with the injected latencies.
+ *
+ * @param[in] tolerance
+ *   Largest error of a single sample: 0 for TIMER0 captures.
+ *****************************************************************************/
+static void checkPhase(const Phase_TypeDef *phase, uint32_t tolerance)
+{
+  static const uint32_t permille[] = { 500, 900, 990, 999 };
+  uint32_t i, rank, exact, p, binSum, bins;
+  uint64_t sum = 0;
+  int ok = 1;
+  char what[80];
+
+  qsort(truth, truthCount, sizeof(truth[0]), compare);
+  for (i = 0; i < truthCount; i++) {
+    sum += truth[i];
+  }
+  snprintf(what, sizeof(what), "%s/%s: count",
+           stimulusNames[phase->stimulus], loadNames[phase->load]);
+  check((hist.count == phase->samples) && (truthCount == phase->samples),
+        what);
+
+  if (tolerance == 0) {
+    snprintf(what, sizeof(what), "%s/%s: min, max and sum exact",
+             stimulusNames[phase->stimulus], loadNames[phase->load]);
+    check((hist.min == truth[0]) && (hist.max == truth[truthCount - 1])
+          && (hist.sum == sum), what);
+    snprintf(what, sizeof(what), "%s/%s: coalesced events counted",
+             stimulusNames[phase->stimulus], loadNames[phase->load]);
+    check((hist.coalesced <= truthCoalesced)
+          && ((truthCoalesced == 0) == (hist.coalesced == 0)), what);
+  } else {
+    snprintf(what, sizeof(what), "%s/%s: min and max within %lu cycles",
+             stimulusNames[phase->stimulus], loadNames[phase->load],
+             (unsigned long)tolerance);
+    check((hist.min + tolerance >= truth[0])
+          && (hist.min <= truth[0] + tolerance)
+          && (hist.max + tolerance >= truth[truthCount - 1])
+          && (hist.max <= truth[truthCount - 1] + tolerance), what);
+  }
+
+  for (i = 0; i < sizeof(permille) / sizeof(permille[0]); i++) {
+    rank = (truthCount * permille[i] + 999) / 1000;
+    exact = truth[rank - 1];
+    p = IRQLAT_Percentile(&hist, permille[i]);
+    ok &= (p + tolerance >= exact)
+          && (p <= exact + exact / 16 + tolerance + tolerance / 16);
+  }
+  snprintf(what, sizeof(what), "%s/%s: percentiles within a bucket",
+           stimulusNames[phase->stimulus], loadNames[phase->load]);
+  check(ok, what);
+
+  lineCount = 0;
+  IRQLAT_ReportBins(&hist, stimulusNames[phase->stimulus],
+                    loadNames[phase->load], collect);
+  binSum = 0;
+  bins = (lineCount < 600) ? lineCount : 600;
+  for (i = 0; i < bins; i++) {
+    ok &= columns(lines[i]) == 6;
+    binSum += (uint32_t)strtoul(strrchr(lines[i], ',') + 1, NULL, 10);
+  }
+  snprintf(what, sizeof(what), "%s/%s: bins add up",
+           stimulusNames[phase->stimulus], loadNames[phase->load]);
+  check(ok && (lineCount <= 600) && (binSum == hist.count), what);
+}
+
+static void runSuite(void)
+{
+  uint32_t i;
+  const Phase_TypeDef *phase;
+
+  lineCount = 0;
+  IRQLAT_Header(collect);
+  check(columns(lines[0]) == 13, "header has 13 columns");
+  IRQLAT_Header(print);
+
+  for (i = 0; i < PHASE_COUNT; i++) {
+    phase = &phases[i];
+    IRQLAT_Reset(&hist);
+    truthCount = 0;
+    truthCoalesced = 0;
+    if (phase->stimulus == stimulusLetimer) {
+      runLf(phase);
+    } else {
+      runCapture(phase);
+    }
+    IRQLAT_Report(&hist, stimulusNames[phase->stimulus],
+                  loadNames[phase->load], HZ, print);
+    lineCount = 0;
+    IRQLAT_Report(&hist, stimulusNames[phase->stimulus],
+                  loadNames[phase->load], HZ, collect);
+    check(columns(lines[0]) == 13, "report has 13 columns");
+    checkPhase(phase, (phase->stimulus == stimulusLetimer)
+               ? POLL + LF_READ_DELAY + 2 : 0);
+  }
+}
+
+static void benchmark(void)
+{
+  struct timespec t0, t1;
+  uint32_t i, n = 10000000;
+  double ns;
+
+  IRQLAT_Reset(&hist);
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (i = 0; i < n; i++) {
+    IRQLAT_Record(&hist, i * 7919u, i * 7919u + (i & 0xFFFF));
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n;
+  printf("IRQLAT_Record(): %.1f ns on this host\n", ns);
+}
+
+int main(void)
+{
+  testBuckets();
+  testStats();
+  runSuite();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}
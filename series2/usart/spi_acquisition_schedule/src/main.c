@@ -0,0 +1,279 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Periodic reads of three SPI sensors run entirely by the LDMA, with
+ * the CPU woken only to drain full capture rings.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_usart.h"
+
+#include "spisched.h"
+
+// Ports and pins for SPI interface; chip selects are plain GPIO outputs
+#if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_8)
+#define US0MOSI_PORT  gpioPortD
+#define US0MOSI_PIN   7
+#define US0MISO_PORT  gpioPortD
+#define US0MISO_PIN   8
+#define US0CLK_PORT   gpioPortD
+#define US0CLK_PIN    9
+#define CS0_PORT      gpioPortD
+#define CS0_PIN       10
+#define CS1_PORT      gpioPortC
+#define CS1_PIN       0
+#define CS2_PORT      gpioPortC
+#define CS2_PIN       1
+#else
+#define US0MOSI_PORT  gpioPortC
+#define US0MOSI_PIN   0
+#define US0MISO_PORT  gpioPortC
+#define US0MISO_PIN   1
+#define US0CLK_PORT   gpioPortC
+#define US0CLK_PIN    2
+#define CS0_PORT      gpioPortC
+#define CS0_PIN       3
+#define CS1_PORT      gpioPortC
+#define CS1_PIN       4
+#define CS2_PORT      gpioPortC
+#define CS2_PIN       5
+#endif
+
+// LDMA channels of the sequencer, transmit and receive programs
+#define SEQ_LDMA_CHANNEL  0
+#define TX_LDMA_CHANNEL   1
+#define RX_LDMA_CHANNEL   2
+
+// Schedule timing
+#define TICK_HZ           1000
+#define BIT_RATE          1000000
+#define LAPS              8
+
+// Commands of the three sensors
+static const uint8_t cmdAccel[] = { 0xF2 };
+static const uint8_t cmdPressure[] = { 0x9F };
+static const uint8_t cmdTemp[] = { 0x83, 0x00 };
+
+// Capture rings, written only by the LDMA
+static uint8_t ringAccel[SPISCHED_RING_SIZE(4 * LAPS, 1, 6)];
+static uint8_t ringPressure[SPISCHED_RING_SIZE(2 * LAPS, 1, 3)];
+static uint8_t ringTemp[SPISCHED_RING_SIZE(1 * LAPS, 2, 2)];
+
+/*
+ * Accelerometer every tick, pressure every other tick and temperature
+ * every fourth tick, phased so the busiest tick has two reads.
+ */
+static const SPISCHED_Sensor_TypeDef sensors[] = {
+  { CS0_PORT, CS0_PIN, cmdAccel, sizeof(cmdAccel), 6, 0xA0, 1, 0, 16,
+    ringAccel, sizeof(ringAccel) },
+  { CS1_PORT, CS1_PIN, cmdPressure, sizeof(cmdPressure), 3, 0xB0, 2, 1, 8,
+    ringPressure, sizeof(ringPressure) },
+  { CS2_PORT, CS2_PIN, cmdTemp, sizeof(cmdTemp), 2, 0xC0, 4, 2, 4,
+    ringTemp, sizeof(ringTemp) },
+};
+
+#define SENSOR_COUNT  (sizeof(sensors) / sizeof(sensors[0]))
+
+// Schedule state; inspect the ring counters in the debugger
+SPISCHED_Handle_TypeDef schedule;
+SPISCHED_Status_TypeDef compileStatus;
+
+// Last sample of each sensor and the samples read
+uint8_t sample[SENSOR_COUNT][SPISCHED_MAX_READ];
+uint32_t samples[SENSOR_COUNT];
+
+// Samples equal to the fill bytes, as seen with MOSI looped back to MISO
+uint32_t loopbackGood;
+uint32_t loopbackBad;
+
+// CPU wakeups
+volatile uint32_t wakeups;
+
+/**************************************************************************//**
+ * @brief
+ *    GPIO initialization
+ *****************************************************************************/
+void initGPIO(void)
+{
+  uint32_t i;
+
+  // Enable clock
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  // Configure TX pin as an output
+  GPIO_PinModeSet(US0MOSI_PORT, US0MOSI_PIN, gpioModePushPull, 0);
+
+  // Configure RX pin as an input
+  GPIO_PinModeSet(US0MISO_PORT, US0MISO_PIN, gpioModeInput, 0);
+
+  // Configure CLK pin as an output low (CPOL = 0)
+  GPIO_PinModeSet(US0CLK_PORT, US0CLK_PIN, gpioModePushPull, 0);
+
+  // Configure the chip selects as outputs and drive them inactive high
+  for (i = 0; i < SENSOR_COUNT; i++) {
+    GPIO_PinModeSet((GPIO_Port_TypeDef)sensors[i].csPort, sensors[i].csPin,
+                    gpioModePushPull, 1);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *    USART0 initialization
+ *****************************************************************************/
+void initUSART0(void)
+{
+  // Enable clock
+  CMU_ClockEnable(cmuClock_USART0, true);
+
+  // Default synchronous initializer (main mode, 1 Mbps, 8-bit data)
+  USART_InitSync_TypeDef init = USART_INITSYNC_DEFAULT;
+
+  init.baudrate = BIT_RATE;
+  init.msbf = true;           // MSB first transmission for SPI compatibility
+
+  /*
+   * Route USART0 RX, TX, and CLK to the specified pins.  The chip selects
+   * are driven by the sequencer LDMA channel, not by USART0.
+   */
+  GPIO->USARTROUTE[0].TXROUTE = (US0MOSI_PORT << _GPIO_USART_TXROUTE_PORT_SHIFT)
+      | (US0MOSI_PIN << _GPIO_USART_TXROUTE_PIN_SHIFT);
+  GPIO->USARTROUTE[0].RXROUTE = (US0MISO_PORT << _GPIO_USART_RXROUTE_PORT_SHIFT)
+      | (US0MISO_PIN << _GPIO_USART_RXROUTE_PIN_SHIFT);
+  GPIO->USARTROUTE[0].CLKROUTE = (US0CLK_PORT << _GPIO_USART_CLKROUTE_PORT_SHIFT)
+      | (US0CLK_PIN << _GPIO_USART_CLKROUTE_PIN_SHIFT);
+
+  // Enable USART interface pins
+  GPIO->USARTROUTE[0].ROUTEEN = GPIO_USART_ROUTEEN_RXPEN |    // MISO
+                                GPIO_USART_ROUTEEN_TXPEN |    // MOSI
+                                GPIO_USART_ROUTEEN_CLKPEN;
+
+  // Configure and enable USART0
+  USART_InitSync(USART0, &init);
+}
+
+/**************************************************************************//**
+ * @brief LDMA IRQHandler
+ *****************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  uint32_t flags = LDMA_IntGet();
+
+  // Only the receive channel interrupts, at watermarks and twice per lap
+  LDMA_IntClear(flags);
+  wakeups++;
+
+  // Stop in case there was an error
+  if (flags & LDMA_IF_ERROR) {
+    __BKPT(0);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *    Copy out every waiting sample of one sensor
+ *****************************************************************************/
+static void drain(uint8_t sensor)
+{
+  uint32_t i;
+
+  while (SPISCHED_Read(&schedule, sensor, sample[sensor])) {
+    bool good = true;
+
+    for (i = 0; i < sensors[sensor].readLength; i++) {
+      if (sample[sensor][i] != sensors[sensor].fill) {
+        good = false;
+      }
+    }
+    if (good) {
+      loopbackGood++;
+    } else {
+      loopbackBad++;
+    }
+    samples[sensor]++;
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *    Main function
+ *****************************************************************************/
+int main(void)
+{
+  SPISCHED_Init_TypeDef init = {
+    sensors, SENSOR_COUNT, LAPS, TICK_HZ, BIT_RATE,
+    4,      // Chip select and descriptor time per read, us
+    NULL    // Set by SPISCHED_Start()
+  };
+  uint32_t ready;
+  uint8_t i;
+
+  // Chip errata
+  CHIP_Init();
+
+  // Check the schedule before touching the hardware; halt if it is invalid
+  compileStatus = SPISCHED_Compile(&schedule, &init);
+  if (compileStatus != spischedOk) {
+    __BKPT(0);
+  }
+
+  // Initialize GPIO, USART0 and the LDMA, then start the schedule
+  initGPIO();
+  initUSART0();
+
+  LDMA_Init_t ldmaInit = LDMA_INIT_DEFAULT;
+  LDMA_Init(&ldmaInit);
+
+  SPISCHED_Start(&schedule, SEQ_LDMA_CHANNEL, TX_LDMA_CHANNEL, RX_LDMA_CHANNEL);
+
+  while (1) {
+    // Count the captures since the last wakeup and drain the full rings
+    ready = SPISCHED_Update(&schedule);
+    for (i = 0; i < SENSOR_COUNT; i++) {
+      if (ready & (1UL << i)) {
+        drain(i);
+      }
+    }
+
+    /*
+     * The USART needs the HFCLK, so the LDMA programs run in EM1; the
+     * CPU sleeps until the next watermark or lap interrupt.
+     */
+    EMU_EnterEM1();
+  }
+}
@@ -0,0 +1,612 @@
+/***************************************************************************//**
+ * @file spisched.c
+ * @brief Periodic SPI sensor reads run by LDMA descriptor programs, with
+ * per-sensor capture rings and watermark wakeups.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "spisched.h"
+
+static uint8_t *captureAddress(const SPISCHED_Handle_TypeDef *h,
+                               uint8_t sensor,
+                               uint32_t entry);
+
+#if !defined(SPISCHED_HOST)
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_timer.h"
+#include "em_usart.h"
+
+static LDMA_Descriptor_t descriptors[SPISCHED_MAX_DESCRIPTORS];
+static uint32_t csMask[SPISCHED_MAX_SENSORS];
+static uint32_t idleWord;
+static volatile uint32_t stamp;
+
+/**************************************************************************//**
+ * @brief
+ *   Completed reads in the current lap, as written by the receive channel
+ *   after each capture, so no interrupt is needed to track them.
+ *****************************************************************************/
+static uint32_t rxCompleted(void)
+{
+  return stamp;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   LDMA descriptor for one program step.
+ *****************************************************************************/
+static LDMA_Descriptor_t stepDescriptor(const SPISCHED_Handle_TypeDef *h,
+                                        const SPISCHED_Step_TypeDef *step,
+                                        uint8_t slot,
+                                        uint16_t lap)
+{
+  const SPISCHED_Sensor_TypeDef *s = h->config.sensors;
+  LDMA_Descriptor_t d;
+
+  if (step->sensor != SPISCHED_IDLE) {
+    s += step->sensor;
+  }
+
+  switch (step->kind) {
+    case spischedStepTick:
+      // One word per TIMER request; the word asserts chip select or is idle
+      if (step->sensor == SPISCHED_IDLE) {
+        d = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_M2M_WORD(&idleWord, &idleWord, step->count, 1);
+        d.xfer.srcInc = ldmaCtrlSrcIncNone;
+        d.xfer.dstInc = ldmaCtrlDstIncNone;
+      } else {
+        d = (LDMA_Descriptor_t)
+          LDMA_DESCRIPTOR_LINKREL_M2M_WORD(&csMask[step->sensor],
+                                           &GPIO->P_CLR[s->csPort].DOUT, 1, 1);
+      }
+      d.xfer.blockSize = ldmaCtrlBlockSizeUnit1;
+      d.xfer.reqMode = ldmaCtrlReqModeBlock;
+      d.xfer.structReq = 0;
+      d.xfer.ignoreSrec = 0;
+      break;
+
+    case spischedStepCsLow:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_WRITE(csMask[step->sensor],
+                                      &GPIO->P_CLR[s->csPort].DOUT, 1);
+      break;
+
+    case spischedStepCsHigh:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_WRITE(csMask[step->sensor],
+                                      &GPIO->P_SET[s->csPort].DOUT, 1);
+      break;
+
+    case spischedStepGo:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_SYNC(SPISCHED_SYNC_GO, SPISCHED_SYNC_DONE, 0, 0, 1);
+      break;
+
+    case spischedStepWaitDone:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_SYNC(0, 0, SPISCHED_SYNC_DONE, SPISCHED_SYNC_DONE, 1);
+      break;
+
+    case spischedStepWaitGo:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_SYNC(0, 0, SPISCHED_SYNC_GO, SPISCHED_SYNC_GO, 1);
+      break;
+
+    case spischedStepClearGo:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_SYNC(0, SPISCHED_SYNC_GO, 0, 0, 1);
+      break;
+
+    case spischedStepCommand:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(s->command, &USART0->TXDATA,
+                                         s->commandLength, 1);
+      break;
+
+    case spischedStepFill:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(&s->fill, &USART0->TXDATA,
+                                         s->readLength, 1);
+      d.xfer.srcInc = ldmaCtrlSrcIncNone;
+      break;
+
+    case spischedStepCapture:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_P2M_BYTE(&USART0->RXDATA,
+                                         SPISCHED_CaptureAddress(h, slot, lap),
+                                         h->rings[step->sensor].stride, 1);
+      break;
+
+    case spischedStepStamp:
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_WRITE(SPISCHED_Stamp(h, slot, lap), &stamp, 1);
+      break;
+
+    default: // spischedStepDone
+      d = (LDMA_Descriptor_t)
+        LDMA_DESCRIPTOR_LINKREL_SYNC(SPISCHED_SYNC_DONE, 0, 0, 0, 1);
+      break;
+  }
+
+  // Only the stamps of watermark captures interrupt, so the count the CPU
+  // reads already includes the capture
+  d.xfer.doneIfs = (step->kind == spischedStepStamp
+                    && SPISCHED_CaptureIrq(h, slot, lap)) ? 1 : 0;
+  return d;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Turn a program into a looping descriptor chain.
+ *
+ * @return
+ *   First descriptor after the chain.
+ *****************************************************************************/
+static uint16_t buildChain(const SPISCHED_Handle_TypeDef *h,
+                           const SPISCHED_Step_TypeDef *steps,
+                           uint16_t count,
+                           uint16_t laps,
+                           uint16_t first)
+{
+  uint16_t n = first;
+  uint16_t lap;
+  uint16_t i;
+  uint8_t slot;
+
+  for (lap = 0; lap < laps; lap++) {
+    slot = 0;
+    for (i = 0; i < count; i++) {
+      descriptors[n++] = stepDescriptor(h, &steps[i], slot, lap);
+      if (steps[i].kind == spischedStepStamp) {
+        slot++;
+      }
+    }
+  }
+
+  // The last descriptor jumps back to the first
+  descriptors[n - 1].xfer.linkAddr = (int32_t)(first - (n - 1)) * 4;
+  return n;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Start the compiled schedule.
+ *
+ * @details
+ *   USART0 must be enabled in synchronous main mode without automatic chip
+ *   select, the chip select pins must be push-pull outputs driven high,
+ *   and LDMA_Init() must have been called. TIMER0 provides the tick: each
+ *   overflow is one request to the sequencer channel, cleared as soon as the
+ *   channel takes it. Only the receive channel interrupts, at watermarks and
+ *   twice per lap; the application clears the flag in LDMA_IRQHandler() and
+ *   calls SPISCHED_Update() from thread context.
+ *****************************************************************************/
+void SPISCHED_Start(SPISCHED_Handle_TypeDef *handle,
+                    unsigned int seqChannel,
+                    unsigned int txChannel,
+                    unsigned int rxChannel)
+{
+  const LDMA_TransferCfg_t seqCfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_TIMER0_UFOF);
+  const LDMA_TransferCfg_t txCfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_USART0_TXBL);
+  const LDMA_TransferCfg_t rxCfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_USART0_RXDATAV);
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+  uint16_t tx;
+  uint16_t rx;
+  uint8_t i;
+
+  stamp = 0;
+  handle->config.completed = rxCompleted;
+  for (i = 0; i < handle->config.count; i++) {
+    csMask[i] = 1UL << handle->config.sensors[i].csPin;
+  }
+
+  tx = buildChain(handle, handle->seq, handle->seqSteps, 1, 0);
+  rx = buildChain(handle, handle->tx, handle->txSteps, 1, tx);
+  buildChain(handle, handle->rx, handle->rxSteps, handle->config.laps, rx);
+
+  LDMA->SYNCSWCLR = SPISCHED_SYNC_GO | SPISCHED_SYNC_DONE;
+
+  // Receive first, so every byte clocked has a destination
+  LDMA_StartTransfer(rxChannel, &rxCfg, &descriptors[rx]);
+  LDMA_StartTransfer(txChannel, &txCfg, &descriptors[tx]);
+  LDMA_StartTransfer(seqChannel, &seqCfg, &descriptors[0]);
+  LDMA_IntDisable((1 << seqChannel) | (1 << txChannel));
+  LDMA_IntClear(1 << rxChannel);
+  LDMA_IntEnable(1 << rxChannel);
+
+  // The tick: one request per overflow, cleared when the channel takes it
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+  timerInit.enable = false;
+  timerInit.dmaClrAct = true;
+  TIMER_Init(TIMER0, &timerInit);
+  TIMER_TopSet(TIMER0, CMU_ClockFreqGet(cmuClock_TIMER0)
+                       / handle->config.tickHz - 1);
+  TIMER_Enable(TIMER0, true);
+}
+#endif // !SPISCHED_HOST
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t t = a % b;
+
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+static void addStep(SPISCHED_Step_TypeDef *steps,
+                    uint16_t *count,
+                    uint8_t kind,
+                    uint8_t sensor,
+                    uint16_t n)
+{
+  steps[*count].kind = kind;
+  steps[*count].sensor = sensor;
+  steps[*count].count = n;
+  (*count)++;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Check a schedule and compile it into the sequencer, transmit and receive
+ *   programs.
+ *
+ * @details
+ *   Over one hyperperiod, each tick reads every sensor whose phase matches
+ *   the tick, in table order. For each read the sequencer asserts chip
+ *   select (on the tick request for the first read of a tick), sets GO,
+ *   waits for DONE and releases chip select. The transmit program waits
+ *   for GO and sends the command and the fill bytes; the receive program
+ *   stores every received byte of the read in the sensor's ring and sets
+ *   DONE. The receive program is repeated laps times so that each ring
+ *   entry has its own capture descriptor, and each capture is followed by
+ *   a write of the count of completed reads in the lap.
+ *****************************************************************************/
+SPISCHED_Status_TypeDef SPISCHED_Compile(SPISCHED_Handle_TypeDef *handle,
+                                         const SPISCHED_Init_TypeDef *init)
+{
+  const SPISCHED_Sensor_TypeDef *s = init->sensors;
+  uint32_t tickUs;
+  uint32_t hyper = 1;
+  uint32_t idle = 0;
+  uint16_t t;
+  uint8_t i;
+  uint8_t j;
+
+  memset(handle, 0, sizeof(*handle));
+  handle->config = *init;
+
+  if (init->count == 0 || init->count > SPISCHED_MAX_SENSORS
+      || init->laps == 0 || init->tickHz == 0 || init->bitRate == 0) {
+    return spischedErrConfig;
+  }
+  tickUs = 1000000 / init->tickHz;
+
+  for (i = 0; i < init->count; i++) {
+    if (s[i].period == 0 || s[i].phase >= s[i].period
+        || s[i].readLength == 0 || s[i].readLength > SPISCHED_MAX_READ
+        || s[i].commandLength > SPISCHED_MAX_COMMAND
+        || (s[i].commandLength > 0 && s[i].command == NULL)
+        || s[i].ring == NULL) {
+      return spischedErrConfig;
+    }
+    hyper = hyper / gcd(hyper, s[i].period) * s[i].period;
+    if (hyper > SPISCHED_MAX_TICKS) {
+      return spischedErrHyperperiod;
+    }
+  }
+  handle->hyperperiod = (uint16_t)hyper;
+
+  // Rings: depth follows from the laps
+  for (i = 0; i < init->count; i++) {
+    SPISCHED_Ring_TypeDef *r = &handle->rings[i];
+    uint32_t depth = (hyper / s[i].period) * init->laps;
+
+    r->perHyper = (uint8_t)(hyper / s[i].period);
+    r->stride = (uint8_t)(s[i].commandLength + s[i].readLength);
+    if (depth > UINT16_MAX
+        || s[i].ringSize < SPISCHED_RING_SIZE(depth, s[i].commandLength,
+                                              s[i].readLength)) {
+      return spischedErrRing;
+    }
+    r->depth = (uint16_t)depth;
+    if (s[i].watermark == 0 || depth % s[i].watermark != 0) {
+      return spischedErrWatermark;
+    }
+    for (j = 0; j < i; j++) {
+      if ((uintptr_t)s[i].ring < (uintptr_t)s[j].ring + s[j].ringSize
+          && (uintptr_t)s[j].ring < (uintptr_t)s[i].ring + s[i].ringSize) {
+        return spischedErrRing;
+      }
+    }
+  }
+
+  // Slots in tick order, then table order within a tick
+  for (t = 0; t < hyper; t++) {
+    uint32_t busUs = 0;
+    uint8_t inTick = 0;
+
+    for (i = 0; i < init->count; i++) {
+      SPISCHED_Ring_TypeDef *r = &handle->rings[i];
+      uint8_t read;
+
+      if (t % s[i].period != s[i].phase) {
+        continue;
+      }
+      if (handle->slots == SPISCHED_MAX_SLOTS) {
+        return spischedErrSlots;
+      }
+      read = (uint8_t)(t / s[i].period);
+      handle->slotSensor[handle->slots] = i;
+      handle->slotRead[handle->slots] = read;
+      busUs += (uint32_t)((uint64_t)r->stride * 8 * 1000000 / init->bitRate)
+               + init->slotOverheadUs;
+
+      // Sequencer: the first read of a tick waits for the tick request
+      if (inTick == 0) {
+        if (idle > 0) {
+          addStep(handle->seq, &handle->seqSteps, spischedStepTick,
+                  SPISCHED_IDLE, (uint16_t)idle);
+          idle = 0;
+        }
+        addStep(handle->seq, &handle->seqSteps, spischedStepTick, i, 1);
+      } else {
+        addStep(handle->seq, &handle->seqSteps, spischedStepCsLow, i, 0);
+      }
+      addStep(handle->seq, &handle->seqSteps, spischedStepGo, i, 0);
+      addStep(handle->seq, &handle->seqSteps, spischedStepWaitDone, i, 0);
+      addStep(handle->seq, &handle->seqSteps, spischedStepCsHigh, i, 0);
+
+      addStep(handle->tx, &handle->txSteps, spischedStepWaitGo, i, 0);
+      addStep(handle->tx, &handle->txSteps, spischedStepClearGo, i, 0);
+      if (s[i].commandLength > 0) {
+        addStep(handle->tx, &handle->txSteps, spischedStepCommand, i, 0);
+      }
+      addStep(handle->tx, &handle->txSteps, spischedStepFill, i, 0);
+
+      addStep(handle->rx, &handle->rxSteps, spischedStepCapture, i, read);
+      addStep(handle->rx, &handle->rxSteps, spischedStepStamp, i, 0);
+      addStep(handle->rx, &handle->rxSteps, spischedStepDone, i, 0);
+
+      handle->slots++;
+      inTick++;
+    }
+
+    if (inTick == 0) {
+      idle++;
+    }
+    if (busUs > handle->busiestTickUs) {
+      handle->busiestTickUs = busUs;
+    }
+  }
+  if (idle > 0) {
+    addStep(handle->seq, &handle->seqSteps, spischedStepTick,
+            SPISCHED_IDLE, (uint16_t)idle);
+  }
+
+  if (handle->busiestTickUs > tickUs) {
+    return spischedErrOverload;
+  }
+  handle->descriptors = (uint16_t)(handle->seqSteps + handle->txSteps
+                                   + handle->rxSteps * init->laps);
+  if (handle->descriptors > SPISCHED_MAX_DESCRIPTORS) {
+    return spischedErrDescriptors;
+  }
+  return spischedOk;
+}
+
+static uint8_t *captureAddress(const SPISCHED_Handle_TypeDef *h,
+                               uint8_t sensor,
+                               uint32_t entry)
+{
+  return h->config.sensors[sensor].ring
+         + (entry % h->rings[sensor].depth) * h->rings[sensor].stride;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Ring entry the receive program fills for a slot of the hyperperiod in a
+ *   given lap.
+ *****************************************************************************/
+uint8_t *SPISCHED_CaptureAddress(const SPISCHED_Handle_TypeDef *handle,
+                                 uint8_t slot,
+                                 uint16_t lap)
+{
+  uint8_t sensor = handle->slotSensor[slot];
+
+  return captureAddress(handle, sensor,
+                        (uint32_t)lap * handle->rings[sensor].perHyper
+                        + handle->slotRead[slot]);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Whether a capture interrupts: when its sensor reaches a multiple of the
+ *   watermark, and at the middle and end of each lap so that
+ *   SPISCHED_Update() runs at least twice per lap.
+ *****************************************************************************/
+bool SPISCHED_CaptureIrq(const SPISCHED_Handle_TypeDef *handle,
+                         uint8_t slot,
+                         uint16_t lap)
+{
+  uint8_t sensor = handle->slotSensor[slot];
+  uint32_t entry = (uint32_t)lap * handle->rings[sensor].perHyper
+                   + handle->slotRead[slot];
+  uint32_t lapSlots = (uint32_t)handle->slots * handle->config.laps;
+  uint32_t n = (uint32_t)lap * handle->slots + slot + 1;
+
+  return (entry + 1) % handle->config.sensors[sensor].watermark == 0
+         || n == lapSlots
+         || n == lapSlots / 2;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Stamp the receive program writes after a capture: the count of reads
+ *   completed in the lap, modulo the reads per lap.
+ *****************************************************************************/
+uint32_t SPISCHED_Stamp(const SPISCHED_Handle_TypeDef *handle,
+                        uint8_t slot,
+                        uint16_t lap)
+{
+  return ((uint32_t)lap * handle->slots + slot + 1)
+         % ((uint32_t)handle->slots * handle->config.laps);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Captures of a sensor completed after the last SPISCHED_Update().
+ *****************************************************************************/
+static uint32_t pending(const SPISCHED_Handle_TypeDef *h,
+                        uint8_t sensor,
+                        uint32_t live)
+{
+  uint32_t lapSlots = (uint32_t)h->slots * h->config.laps;
+  uint32_t n = 0;
+  uint32_t p;
+
+  for (p = h->position; p != live; p = (p + 1) % lapSlots) {
+    if (h->slotSensor[p % h->slots] == sensor) {
+      n++;
+    }
+  }
+  return n;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Count the captures completed since the last call.
+ *
+ * @note
+ *   Call from one context only, at least twice per lap; the receive
+ *   channel interrupts at the middle and end of each lap for this.
+ *
+ * @return
+ *   Bit mask of the sensors with at least watermark unread samples.
+ *****************************************************************************/
+uint32_t SPISCHED_Update(SPISCHED_Handle_TypeDef *handle)
+{
+  uint32_t lapSlots = (uint32_t)handle->slots * handle->config.laps;
+  uint32_t live = handle->config.completed();
+  uint32_t mask = 0;
+  uint8_t i;
+
+  while (handle->position != live) {
+    handle->rings[handle->slotSensor[handle->position % handle->slots]].written++;
+    handle->position = (handle->position + 1) % lapSlots;
+  }
+
+  for (i = 0; i < handle->config.count; i++) {
+    if (SPISCHED_Available(handle, i) >= handle->config.sensors[i].watermark) {
+      mask |= 1UL << i;
+    }
+  }
+  return mask;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Unread samples of a sensor as of the last SPISCHED_Update(), at most
+ *   the ring depth.
+ *****************************************************************************/
+uint32_t SPISCHED_Available(const SPISCHED_Handle_TypeDef *handle,
+                            uint8_t sensor)
+{
+  const SPISCHED_Ring_TypeDef *r = &handle->rings[sensor];
+  uint32_t n = r->written - r->read;
+
+  return n > r->depth ? r->depth : n;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Copy the oldest unread sample of a sensor.
+ *
+ * @details
+ *   Samples the receive channel has overwritten, before or during the copy,
+ *   are skipped and counted as overruns.
+ *
+ * @param[out] out
+ *   readLength bytes.
+ *
+ * @return
+ *   false if no sample is waiting.
+ *****************************************************************************/
+bool SPISCHED_Read(SPISCHED_Handle_TypeDef *handle,
+                   uint8_t sensor,
+                   uint8_t *out)
+{
+  SPISCHED_Ring_TypeDef *r = &handle->rings[sensor];
+  const SPISCHED_Sensor_TypeDef *s = &handle->config.sensors[sensor];
+
+  while ((int32_t)(r->written - r->read) > 0) {
+    uint32_t live = r->written
+                    + pending(handle, sensor, handle->config.completed());
+
+    // The capture in progress overwrites sample live - depth
+    if (live - r->read >= r->depth) {
+      uint32_t oldest = live - r->depth + 1;
+
+      // Samples not counted by SPISCHED_Update() yet are checked again then
+      if ((int32_t)(oldest - r->written) > 0) {
+        oldest = r->written;
+      }
+      r->overruns += oldest - r->read;
+      r->read = oldest;
+      continue;
+    }
+
+    memcpy(out, captureAddress(handle, sensor, r->read) + s->commandLength,
+           s->readLength);
+
+    live = r->written + pending(handle, sensor, handle->config.completed());
+    if (live - r->read >= r->depth) {
+      r->overruns++;
+      r->read++;
+      continue;
+    }
+    r->read++;
+    return true;
+  }
+  return false;
+}
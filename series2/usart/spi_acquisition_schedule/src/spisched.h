@@ -0,0 +1,202 @@
+/***************************************************************************//**
+ * @file spisched.h
+ * @brief Periodic SPI sensor reads run by LDMA descriptor programs, with
+ * per-sensor capture rings and watermark wakeups.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef SPISCHED_H
+#define SPISCHED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Sensors in one schedule
+#define SPISCHED_MAX_SENSORS      8
+
+/// Longest hyperperiod (least common multiple of the periods) in ticks
+#define SPISCHED_MAX_TICKS        32
+
+/// Reads per hyperperiod
+#define SPISCHED_MAX_SLOTS        24
+
+/// Longest command and sample
+#define SPISCHED_MAX_COMMAND      8
+#define SPISCHED_MAX_READ         64
+
+/// LDMA descriptors available to the three programs
+#define SPISCHED_MAX_DESCRIPTORS  256
+
+/// LDMA sync bits used between the sequencer, transmit and receive channels
+#define SPISCHED_SYNC_GO          (1 << 6)
+#define SPISCHED_SYNC_DONE        (1 << 7)
+
+/// Ring bytes for a sensor: depth entries holding the command echo and the
+/// sample
+#define SPISCHED_RING_SIZE(depth, commandLength, readLength) \
+  ((depth) * ((commandLength) + (readLength)))
+
+/// One sensor in the schedule
+typedef struct {
+  uint8_t       csPort;         ///< Chip select GPIO port
+  uint8_t       csPin;
+  const uint8_t *command;       ///< Sent after chip select assertion
+  uint8_t       commandLength;  ///< May be 0
+  uint8_t       readLength;     ///< Sample bytes read after the command
+  uint8_t       fill;           ///< Sent while the sample is read
+  uint16_t      period;         ///< Ticks between reads
+  uint16_t      phase;          ///< Tick of the first read, below period
+  uint16_t      watermark;      ///< Unread samples that wake the CPU
+  uint8_t       *ring;          ///< See SPISCHED_RING_SIZE()
+  uint32_t      ringSize;       ///< Bytes
+} SPISCHED_Sensor_TypeDef;
+
+/// Schedule configuration
+typedef struct {
+  const SPISCHED_Sensor_TypeDef *sensors;
+  uint8_t  count;
+  uint16_t laps;                ///< Hyperperiods held by each ring; a sensor's
+                                ///< ring depth is laps * hyperperiod / period
+  uint32_t tickHz;
+  uint32_t bitRate;             ///< SPI clock, for the tick budget check
+  uint16_t slotOverheadUs;      ///< Chip select and descriptor time per read
+  uint32_t (*completed)(void);  ///< Last stamp written by the receive
+                                ///< channel; set by SPISCHED_Start() on
+                                ///< the target
+} SPISCHED_Init_TypeDef;
+
+/// Result of SPISCHED_Compile()
+typedef enum {
+  spischedOk,
+  spischedErrConfig,        ///< Bad count, length, period, phase or rate
+  spischedErrHyperperiod,   ///< Periods do not fit SPISCHED_MAX_TICKS
+  spischedErrSlots,         ///< More than SPISCHED_MAX_SLOTS reads
+  spischedErrRing,          ///< Ring too small or overlapping another
+  spischedErrWatermark,     ///< Watermark zero or not dividing the depth
+  spischedErrOverload,      ///< Reads of one tick do not fit in the tick
+  spischedErrDescriptors    ///< More than SPISCHED_MAX_DESCRIPTORS needed
+} SPISCHED_Status_TypeDef;
+
+/// Program steps; each becomes one LDMA descriptor
+typedef enum {
+  spischedStepTick,         ///< Wait for a tick; assert chip select, or idle
+  spischedStepCsLow,
+  spischedStepCsHigh,
+  spischedStepGo,           ///< Set GO and clear DONE
+  spischedStepWaitDone,
+  spischedStepWaitGo,
+  spischedStepClearGo,
+  spischedStepCommand,      ///< Send the command bytes
+  spischedStepFill,         ///< Send the fill byte readLength times
+  spischedStepCapture,      ///< Receive command echo and sample into the ring
+  spischedStepStamp,        ///< Write the count of completed reads
+  spischedStepDone          ///< Set DONE
+} SPISCHED_StepKind_TypeDef;
+
+/// Sensor index of an idle tick step
+#define SPISCHED_IDLE             0xFF
+
+/// One program step
+typedef struct {
+  uint8_t  kind;            ///< SPISCHED_StepKind_TypeDef
+  uint8_t  sensor;          ///< Or SPISCHED_IDLE
+  uint16_t count;           ///< Idle ticks, or read index in the hyperperiod
+} SPISCHED_Step_TypeDef;
+
+/// Capture ring state of one sensor
+typedef struct {
+  uint16_t depth;           ///< Entries
+  uint8_t  stride;          ///< Bytes per entry: command echo and sample
+  uint8_t  perHyper;        ///< Reads per hyperperiod
+  uint32_t written;         ///< Samples captured
+  uint32_t read;            ///< Samples read
+  uint32_t overruns;        ///< Samples overwritten before they were read
+} SPISCHED_Ring_TypeDef;
+
+/// Compiled schedule; all fields are read-only for the application
+typedef struct {
+  SPISCHED_Init_TypeDef config;
+  SPISCHED_Ring_TypeDef rings[SPISCHED_MAX_SENSORS];
+  uint16_t              hyperperiod;    ///< Ticks
+  uint8_t               slots;          ///< Reads per hyperperiod
+  uint8_t               slotSensor[SPISCHED_MAX_SLOTS];
+  uint8_t               slotRead[SPISCHED_MAX_SLOTS];   ///< Read index
+
+  // Programs of the sequencer, transmit and receive channels; the receive
+  // program is repeated laps times with the capture addresses advanced
+  SPISCHED_Step_TypeDef seq[4 * SPISCHED_MAX_SLOTS + SPISCHED_MAX_TICKS];
+  SPISCHED_Step_TypeDef tx[4 * SPISCHED_MAX_SLOTS];
+  SPISCHED_Step_TypeDef rx[3 * SPISCHED_MAX_SLOTS];
+  uint16_t              seqSteps;
+  uint16_t              txSteps;
+  uint16_t              rxSteps;
+  uint16_t              descriptors;    ///< LDMA descriptors needed
+  uint32_t              busiestTickUs;  ///< Longest tick of bus activity
+
+  uint32_t              position;       ///< Completed reads in this lap
+} SPISCHED_Handle_TypeDef;
+
+SPISCHED_Status_TypeDef SPISCHED_Compile(SPISCHED_Handle_TypeDef *handle,
+                                         const SPISCHED_Init_TypeDef *init);
+uint8_t *SPISCHED_CaptureAddress(const SPISCHED_Handle_TypeDef *handle,
+                                 uint8_t slot,
+                                 uint16_t lap);
+uint32_t SPISCHED_Stamp(const SPISCHED_Handle_TypeDef *handle,
+                        uint8_t slot,
+                        uint16_t lap);
+bool SPISCHED_CaptureIrq(const SPISCHED_Handle_TypeDef *handle,
+                         uint8_t slot,
+                         uint16_t lap);
+uint32_t SPISCHED_Update(SPISCHED_Handle_TypeDef *handle);
+uint32_t SPISCHED_Available(const SPISCHED_Handle_TypeDef *handle,
+                            uint8_t sensor);
+bool SPISCHED_Read(SPISCHED_Handle_TypeDef *handle,
+                   uint8_t sensor,
+                   uint8_t *out);
+
+#if !defined(SPISCHED_HOST)
+void SPISCHED_Start(SPISCHED_Handle_TypeDef *handle,
+                    unsigned int seqChannel,
+                    unsigned int txChannel,
+                    unsigned int rxChannel);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPISCHED_H
@@ -0,0 +1,675 @@
+/***************************************************************************//**
+ * @file spisched_sim.c
+ * @brief Host test and benchmark for the SPI acquisition schedule compiler
+ * and ring bookkeeping.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DSPISCHED_HOST -I../src -o spisched_sim spisched_sim.c ../src/spisched.c
+ *   ./spisched_sim
+ *
+ * The compiled sequencer, transmit and receive programs are executed by a
+ * model of the three LDMA channels, their sync bits, the TIMER tick
+ * request and the SPI bus, in bit times. Model sensors check the chip
+ * select framing and the bytes they receive, and answer with data that
+ * encodes their sample number, so the "CPU" (SPISCHED_Update() at each
+ * capture interrupt, then SPISCHED_Read()) can check every sample it gets.
+ * The exit status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "spisched.h"
+
+#define TICK_HZ   1000
+#define BIT_RATE  1000000
+#define LAPS      8
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// ---------------------------------------------------------------- demo table
+static const uint8_t cmdAccel[] = { 0xF2 };
+static const uint8_t cmdPressure[] = { 0x9F };
+static const uint8_t cmdTemp[] = { 0x83, 0x00 };
+
+static uint8_t ringAccel[SPISCHED_RING_SIZE(4 * LAPS, 1, 6)];
+static uint8_t ringPressure[SPISCHED_RING_SIZE(2 * LAPS, 1, 3)];
+static uint8_t ringTemp[SPISCHED_RING_SIZE(1 * LAPS, 2, 2)];
+
+static SPISCHED_Sensor_TypeDef sensors[3] = {
+  { 2, 0, cmdAccel, 1, 6, 0xA0, 1, 0, 16, ringAccel, sizeof(ringAccel) },
+  { 2, 4, cmdPressure, 1, 3, 0xB0, 2, 1, 8, ringPressure, sizeof(ringPressure) },
+  { 2, 5, cmdTemp, 2, 2, 0xC0, 4, 2, 4, ringTemp, sizeof(ringTemp) },
+};
+
+// ---------------------------------------------------------------- the model
+typedef struct {
+  const SPISCHED_Step_TypeDef *steps;
+  uint16_t count;
+  uint16_t pc;
+  uint16_t lap;
+  uint8_t  slot;           // Capture steps seen in this pass
+  uint16_t done;           // Bytes moved or ticks taken by the current step
+} Channel;
+
+static SPISCHED_Handle_TypeDef sched;
+static Channel seq;
+static Channel tx;
+static Channel rx;
+static uint32_t syncBits;
+static int tickRequest;
+static uint32_t ticksLost;
+static uint64_t now;                  // Bit times
+static uint64_t nextTick;
+static uint32_t tickIndex;
+static uint32_t misaligned;           // Reads started off their tick
+static int txFifo[2];
+static int txCount;
+static int rxByte = -1;
+static uint8_t *dst;                  // Receive channel destination
+static uint32_t stamp;                // Written by the receive channel
+static int irqPending;
+
+// Model sensors
+static int csLow[3];
+static uint32_t samples[3];           // Reads completed by each sensor
+static uint32_t byteInFrame[3];
+static uint32_t badFrames;
+
+static uint8_t sensorData(uint8_t s, uint32_t n, uint32_t i)
+{
+  return (uint8_t)((n >> (8 * (i % 4))) + i * 17 + s * 71);
+}
+
+static uint32_t (*completedHook)(void);
+
+static uint32_t modelCompleted(void)
+{
+  return completedHook != NULL ? completedHook() : stamp;
+}
+
+static int csCount(void)
+{
+  return csLow[0] + csLow[1] + csLow[2];
+}
+
+static void setCs(uint8_t s, int low)
+{
+  const SPISCHED_Sensor_TypeDef *c = &sensors[s];
+
+  if (low) {
+    if (csCount() != 0) {
+      badFrames++;
+    }
+    byteInFrame[s] = 0;
+    if (tickIndex - 1 != c->phase + samples[s] * c->period) {
+      misaligned++;
+    }
+  } else if (csLow[s]) {
+    if (byteInFrame[s] != (uint32_t)c->commandLength + c->readLength) {
+      badFrames++;
+    }
+    samples[s]++;
+  }
+  csLow[s] = low;
+}
+
+static void loadRx(void)
+{
+  const SPISCHED_Step_TypeDef *st = &rx.steps[rx.pc];
+
+  if (st->kind == spischedStepCapture) {
+    dst = SPISCHED_CaptureAddress(&sched, rx.slot, rx.lap);
+  }
+}
+
+static void nextStep(Channel *ch)
+{
+  ch->done = 0;
+  if (++ch->pc == ch->count) {
+    ch->pc = 0;
+    ch->slot = 0;
+    ch->lap = (uint16_t)((ch->lap + 1) % sched.config.laps);
+  }
+}
+
+// Run one channel as far as it can go without waiting; true if it moved
+static int runSeq(void)
+{
+  const SPISCHED_Step_TypeDef *st = &seq.steps[seq.pc];
+
+  switch (st->kind) {
+    case spischedStepTick:
+      if (!tickRequest) {
+        return 0;
+      }
+      tickRequest = 0;
+      if (st->sensor != SPISCHED_IDLE) {
+        setCs(st->sensor, 1);
+      } else if (++seq.done < st->count) {
+        return 1;
+      }
+      break;
+    case spischedStepCsLow:
+      setCs(st->sensor, 1);
+      break;
+    case spischedStepCsHigh:
+      setCs(st->sensor, 0);
+      break;
+    case spischedStepGo:
+      syncBits |= SPISCHED_SYNC_GO;
+      syncBits &= ~SPISCHED_SYNC_DONE;
+      break;
+    case spischedStepWaitDone:
+      if (!(syncBits & SPISCHED_SYNC_DONE)) {
+        return 0;
+      }
+      break;
+    default:
+      check(0, "step kind in the sequencer program");
+      break;
+  }
+  nextStep(&seq);
+  return 1;
+}
+
+static int runTx(void)
+{
+  const SPISCHED_Step_TypeDef *st = &tx.steps[tx.pc];
+  const SPISCHED_Sensor_TypeDef *c = &sensors[st->sensor];
+
+  switch (st->kind) {
+    case spischedStepWaitGo:
+      if (!(syncBits & SPISCHED_SYNC_GO)) {
+        return 0;
+      }
+      break;
+    case spischedStepClearGo:
+      syncBits &= ~SPISCHED_SYNC_GO;
+      break;
+    case spischedStepCommand:
+    case spischedStepFill:
+      if (txCount == 2) {
+        return 0;
+      }
+      txFifo[txCount++] = st->kind == spischedStepCommand
+                          ? c->command[tx.done] : c->fill;
+      if (++tx.done < (st->kind == spischedStepCommand
+                       ? c->commandLength : c->readLength)) {
+        return 1;
+      }
+      break;
+    default:
+      check(0, "step kind in the transmit program");
+      break;
+  }
+  nextStep(&tx);
+  return 1;
+}
+
+static int runRx(void)
+{
+  const SPISCHED_Step_TypeDef *st = &rx.steps[rx.pc];
+
+  switch (st->kind) {
+    case spischedStepCapture:
+      if (rxByte < 0) {
+        return 0;
+      }
+      *dst++ = (uint8_t)rxByte;
+      rxByte = -1;
+      if (++rx.done < sched.rings[st->sensor].stride) {
+        return 1;
+      }
+      break;
+    case spischedStepStamp:
+      stamp = SPISCHED_Stamp(&sched, rx.slot, rx.lap);
+      if (SPISCHED_CaptureIrq(&sched, rx.slot, rx.lap)) {
+        irqPending = 1;
+      }
+      rx.slot++;
+      break;
+    case spischedStepDone:
+      syncBits |= SPISCHED_SYNC_DONE;
+      break;
+    default:
+      check(0, "step kind in the receive program");
+      break;
+  }
+  nextStep(&rx);
+  loadRx();
+  return 1;
+}
+
+static void tickUntil(uint64_t t)
+{
+  while (nextTick <= t) {
+    if (tickRequest) {
+      ticksLost++;
+    }
+    tickRequest = 1;
+    tickIndex++;
+    nextTick += BIT_RATE / TICK_HZ;
+  }
+}
+
+// Shift one byte: MOSI from the transmit FIFO, MISO from the selected sensor
+static void shiftByte(void)
+{
+  int selected = -1;
+  int mosi = txFifo[0];
+  uint8_t s;
+
+  txFifo[0] = txFifo[1];
+  txCount--;
+  for (s = 0; s < 3; s++) {
+    if (csLow[s]) {
+      selected = s;
+    }
+  }
+  now += 8;
+  if (selected < 0 || csCount() != 1 || rxByte >= 0) {
+    badFrames++;
+    rxByte = 0;
+    return;
+  }
+
+  s = (uint8_t)selected;
+  if (byteInFrame[s] < sensors[s].commandLength) {
+    if (mosi != sensors[s].command[byteInFrame[s]]) {
+      badFrames++;
+    }
+    rxByte = 0xEE;
+  } else {
+    if (mosi != sensors[s].fill) {
+      badFrames++;
+    }
+    rxByte = sensorData(s, samples[s], byteInFrame[s] - sensors[s].commandLength);
+  }
+  byteInFrame[s]++;
+}
+
+// Advance the model by whole bytes or ticks until the given time
+static void runUntil(uint64_t end)
+{
+  while (now < end) {
+    while (runRx() | runTx() | runSeq()) {
+    }
+    if (irqPending) {
+      return;
+    }
+    if (txCount > 0) {
+      shiftByte();
+    } else {
+      now = nextTick < end ? nextTick : end;
+    }
+    tickUntil(now);
+  }
+}
+
+static void reset(void)
+{
+  memset(&seq, 0, sizeof(seq));
+  memset(&tx, 0, sizeof(tx));
+  memset(&rx, 0, sizeof(rx));
+  seq.steps = sched.seq;
+  seq.count = sched.seqSteps;
+  tx.steps = sched.tx;
+  tx.count = sched.txSteps;
+  rx.steps = sched.rx;
+  rx.count = sched.rxSteps;
+  syncBits = 0;
+  tickRequest = 0;
+  ticksLost = 0;
+  now = 0;
+  nextTick = 0;
+  tickIndex = 0;
+  txCount = 0;
+  rxByte = -1;
+  irqPending = 0;
+  stamp = 0;
+  completedHook = NULL;
+  memset(csLow, 0, sizeof(csLow));
+  memset(samples, 0, sizeof(samples));
+  badFrames = 0;
+  misaligned = 0;
+  loadRx();
+}
+
+static SPISCHED_Init_TypeDef demoInit(void)
+{
+  SPISCHED_Init_TypeDef init = {
+    sensors, 3, LAPS, TICK_HZ, BIT_RATE, 4, modelCompleted
+  };
+
+  return init;
+}
+
+// Read and check every available sample of every sensor
+static uint32_t drain(uint32_t *bad)
+{
+  uint8_t out[SPISCHED_MAX_READ];
+  uint32_t n = 0;
+  uint8_t s;
+  uint32_t i;
+
+  for (s = 0; s < 3; s++) {
+    while (SPISCHED_Read(&sched, s, out)) {
+      uint32_t sample = sched.rings[s].read - 1;
+
+      for (i = 0; i < sensors[s].readLength; i++) {
+        if (out[i] != sensorData(s, sample, i)) {
+          (*bad)++;
+          break;
+        }
+      }
+      n++;
+    }
+  }
+  return n;
+}
+
+static void testCompile(void)
+{
+  SPISCHED_Init_TypeDef init = demoInit();
+  SPISCHED_Sensor_TypeDef bad[3];
+  static uint8_t big[SPISCHED_MAX_SENSORS][SPISCHED_RING_SIZE(64, 0, 1)];
+  SPISCHED_Sensor_TypeDef many[SPISCHED_MAX_SENSORS];
+  uint8_t i;
+
+  check(SPISCHED_Compile(&sched, &init) == spischedOk, "demo table compiles");
+  check(sched.hyperperiod == 4 && sched.slots == 7, "hyperperiod 4 ticks, 7 reads");
+  check(sched.rings[0].depth == 32 && sched.rings[1].depth == 16
+        && sched.rings[2].depth == 8, "ring depths from the laps");
+  check(sched.descriptors == sched.seqSteps + sched.txSteps + sched.rxSteps * LAPS
+        && sched.descriptors <= SPISCHED_MAX_DESCRIPTORS, "descriptor count");
+  printf("demo: %u ticks, %u reads per hyperperiod, %u descriptors "
+         "(%u bytes), busiest tick %u us of %u\n",
+         sched.hyperperiod, sched.slots, sched.descriptors,
+         sched.descriptors * 16, (unsigned)sched.busiestTickUs,
+         1000000 / TICK_HZ);
+
+  memcpy(bad, sensors, sizeof(bad));
+  init.sensors = bad;
+  bad[1].phase = 2;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrConfig, "phase >= period");
+  memcpy(bad, sensors, sizeof(bad));
+  bad[1].period = 7;
+  bad[2].period = 9;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrHyperperiod,
+        "hyperperiod too long");
+  memcpy(bad, sensors, sizeof(bad));
+  bad[0].ringSize--;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrRing, "ring too small");
+  memcpy(bad, sensors, sizeof(bad));
+  bad[2].ring = ringPressure + 4;
+  bad[2].ringSize = 8;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrRing, "rings overlap");
+  memcpy(bad, sensors, sizeof(bad));
+  bad[0].watermark = 5;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrWatermark,
+        "watermark must divide the depth");
+  init = demoInit();
+  init.tickHz = 20000;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrOverload,
+        "tick too short for its reads");
+  init = demoInit();
+  init.laps = 64;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrRing
+        || SPISCHED_Compile(&sched, &init) == spischedErrDescriptors,
+        "too many laps");
+
+  // Eight sensors every tick: 32 reads per 4-tick hyperperiod
+  for (i = 0; i < SPISCHED_MAX_SENSORS; i++) {
+    many[i] = sensors[0];
+    many[i].command = NULL;
+    many[i].commandLength = 0;
+    many[i].readLength = 1;
+    many[i].period = 1;
+    many[i].watermark = 1;
+    many[i].ring = big[i];
+    many[i].ringSize = sizeof(big[i]);
+  }
+  init = demoInit();
+  init.sensors = many;
+  init.count = SPISCHED_MAX_SENSORS;
+  init.laps = 1;
+  many[0].period = 4;
+  check(SPISCHED_Compile(&sched, &init) == spischedErrSlots, "too many reads");
+}
+
+static void testRun(void)
+{
+  SPISCHED_Init_TypeDef init = demoInit();
+  uint32_t bad = 0;
+  uint32_t got = 0;
+  uint32_t wakes = 0;
+  uint64_t end = (uint64_t)BIT_RATE * 2;   // 2 s
+
+  memset(ringAccel, 0, sizeof(ringAccel));
+  SPISCHED_Compile(&sched, &init);
+  reset();
+
+  while (now < end) {
+    runUntil(end);
+    if (irqPending) {
+      irqPending = 0;
+      wakes++;
+      SPISCHED_Update(&sched);
+      got += drain(&bad);
+    }
+  }
+  SPISCHED_Update(&sched);
+  got += drain(&bad);
+
+  check(badFrames == 0, "chip select framing and transmitted bytes");
+  check(ticksLost == 0, "no tick lost");
+  check(misaligned == 0, "every read starts in its tick");
+  check(bad == 0, "every sample read matches the sensor");
+  check(got == samples[0] + samples[1] + samples[2]
+        - (sched.rings[0].written != samples[0])
+        - (sched.rings[1].written != samples[1])
+        - (sched.rings[2].written != samples[2]),
+        "every completed sample read");
+  check(samples[0] >= 1999 && samples[1] >= 999 && samples[2] >= 499,
+        "read rates follow the periods");
+  check(sched.rings[0].overruns + sched.rings[1].overruns
+        + sched.rings[2].overruns == 0, "no overruns with a responsive CPU");
+  printf("2 s run: %u samples, %u CPU wakeups (%u per second)\n",
+         (unsigned)got, (unsigned)wakes, (unsigned)(wakes / 2));
+}
+
+// The CPU leaves one sensor unread for longer than its ring lasts
+static void testOverrun(void)
+{
+  SPISCHED_Init_TypeDef init = demoInit();
+  uint8_t out[SPISCHED_MAX_READ];
+  uint32_t bad = 0;
+  uint32_t got = 0;
+  uint64_t end = (uint64_t)BIT_RATE / TICK_HZ * 4 * LAPS * 3 / 2;
+
+  SPISCHED_Compile(&sched, &init);
+  reset();
+  while (now < end) {
+    runUntil(end);
+    if (irqPending) {
+      irqPending = 0;
+      SPISCHED_Update(&sched);
+      while (SPISCHED_Read(&sched, 1, out) || SPISCHED_Read(&sched, 2, out)) {
+      }
+    }
+  }
+  SPISCHED_Update(&sched);
+  check(SPISCHED_Available(&sched, 0) == sched.rings[0].depth,
+        "available clamped to the ring depth");
+  got = drain(&bad);
+  check(bad == 0, "only intact samples read after an overrun");
+  check(sched.rings[0].overruns > 0
+        && sched.rings[0].overruns + sched.rings[0].depth
+        >= sched.rings[0].written - 1,
+        "overwritten samples counted");
+  check(sched.rings[0].read == sched.rings[0].written,
+        "reader caught up after the overrun");
+  check(sched.rings[1].overruns == 0 && sched.rings[2].overruns == 0,
+        "other sensors unaffected");
+  printf("overrun: %u samples written, %u overwritten, %u read\n",
+         (unsigned)sched.rings[0].written, (unsigned)sched.rings[0].overruns,
+         (unsigned)got);
+}
+
+// The receive channel overwrites the sample being copied
+static uint32_t injectCall;
+static uint32_t injectAt;
+
+static uint32_t injectingCompleted(void)
+{
+  if (++injectCall == injectAt) {
+    // The bus runs on while the CPU copies: one more read of every sensor
+    uint32_t target = samples[0] + 1;
+
+    while (samples[0] < target) {
+      runUntil(nextTick);
+      irqPending = 0;
+    }
+  }
+  return stamp;
+}
+
+static void testOverwriteDuringCopy(void)
+{
+  SPISCHED_Init_TypeDef init = demoInit();
+  uint8_t out[SPISCHED_MAX_READ];
+  uint32_t overruns;
+  uint32_t first;
+  uint32_t i;
+  uint64_t end;
+
+  SPISCHED_Compile(&sched, &init);
+  reset();
+
+  // Fill the accelerometer ring to one below its depth, then start a read
+  end = (uint64_t)BIT_RATE / TICK_HZ * (sched.rings[0].depth - 2);
+  while (now < end) {
+    runUntil(end);
+    if (irqPending) {
+      irqPending = 0;
+      SPISCHED_Update(&sched);
+    }
+  }
+  while (samples[0] < sched.rings[0].depth - 1u) {
+    runUntil(nextTick);
+    irqPending = 0;
+  }
+  SPISCHED_Update(&sched);
+  check(sched.rings[0].written == sched.rings[0].depth - 1u
+        && sched.rings[0].read == 0, "ring one below full before the copy");
+
+  // Check before the copy passes; the check after it sees the new capture
+  overruns = sched.rings[0].overruns;
+  injectCall = 0;
+  injectAt = 2;
+  completedHook = injectingCompleted;
+  check(SPISCHED_Read(&sched, 0, out), "a sample after the overwritten one");
+  completedHook = NULL;
+  first = sched.rings[0].read - 1;
+  check(sched.rings[0].overruns > overruns, "overwrite during the copy detected");
+  check(first > 0, "overwritten sample not returned");
+  for (i = 0; i < sensors[0].readLength; i++) {
+    if (out[i] != sensorData(0, first, i)) {
+      check(0, "sample after the overwrite intact");
+      break;
+    }
+  }
+}
+
+// Host cost of the bookkeeping: SPISCHED_Update() and SPISCHED_Read() per
+// sample, with the stamp advanced half a lap per wakeup
+static uint32_t benchStamp;
+
+static uint32_t benchCompleted(void)
+{
+  return benchStamp;
+}
+
+static void benchmark(void)
+{
+  SPISCHED_Init_TypeDef init = demoInit();
+  uint8_t out[SPISCHED_MAX_READ];
+  uint32_t lapSlots;
+  uint32_t samplesRead = 0;
+  uint32_t wakes = 200000;
+  uint32_t w;
+  uint8_t s;
+  clock_t t0;
+  double ns;
+
+  init.completed = benchCompleted;
+  SPISCHED_Compile(&sched, &init);
+  lapSlots = (uint32_t)sched.slots * LAPS;
+  benchStamp = 0;
+
+  t0 = clock();
+  for (w = 0; w < wakes; w++) {
+    benchStamp = (benchStamp + lapSlots / 2) % lapSlots;
+    SPISCHED_Update(&sched);
+    for (s = 0; s < 3; s++) {
+      while (SPISCHED_Read(&sched, s, out)) {
+        samplesRead++;
+      }
+    }
+  }
+  ns = (double)(clock() - t0) * 1e9 / CLOCKS_PER_SEC;
+  printf("bookkeeping: %.0f ns per sample, %u samples per wakeup\n",
+         ns / (samplesRead ? samplesRead : 1),
+         (unsigned)(samplesRead / wakes));
+}
+
+int main(void)
+{
+  testCompile();
+  testRun();
+  testOverrun();
+  testOverwriteDuringCopy();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures != 0;
+}
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file main.c
+ * @brief Three cooperative tasks under a supervisor that feeds the windowed
+ * watchdog only while all of them keep their deadlines and budgets.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include "em_device.h"
+#include "em_chip.h"
+#include "em_cmu.h"
+#include "em_emu.h"
+#include "em_gpio.h"
+#include "em_rmu.h"
+#include "em_wdog.h"
+#include "bsp.h"
+#include "retargetserial.h"
+
+#include "sup.h"
+
+// No feed sooner than this after the last; the illegal window is 25% of 2049 ms
+#define FEED_MIN_MS       600
+
+// Telemetry report interval
+#define REPORT_MS         5000
+
+// Task set: run period, deadline between check-ins and run time budget
+typedef struct {
+  const char *name;
+  uint32_t   periodMs;
+  uint32_t   deadlineMs;
+  uint32_t   budgetUs;
+  uint32_t   workUs;      // Normal run time
+  int        id;          // Supervisor task index
+  uint32_t   next;        // Next run, ticks
+} Task_TypeDef;
+
+enum { TASK_SENSOR, TASK_COMMS, TASK_UI, TASK_COUNT };
+
+static Task_TypeDef tasks[TASK_COUNT] = {
+  { "sensor", 50, 100, 2000, 500, 0, 0 },
+  { "comms", 200, 300, 5000, 1500, 0, 0 },
+  { "ui", 20, 100, 1000, 100, 0, 0 },
+};
+
+static const char *const faultNames[] = {
+  "not polled", "hung", "late", "overran"
+};
+
+SUP_Handle_TypeDef sup;
+static uint32_t tickHz;
+
+// Faults injected from the push buttons
+static volatile bool hangSensor;
+static volatile bool slowComms;
+
+static uint32_t ticks(uint32_t us)
+{
+  return (uint32_t)((uint64_t)us * tickHz / 1000000);
+}
+
+static uint32_t micros(uint32_t t)
+{
+  return (uint32_t)((uint64_t)t * 1000000 / tickHz);
+}
+
+// Stand-in for the work of a task
+static void work(uint32_t us)
+{
+  uint32_t start = SUP_Now();
+
+  while (SUP_Now() - start < ticks(us)) {
+  }
+}
+
+/**************************************************************************//**
+ * @brief  Task bodies
+ *****************************************************************************/
+static void runTask(int index)
+{
+  Task_TypeDef *task = &tasks[index];
+
+  switch (index) {
+    case TASK_SENSOR:
+      while (hangSensor) {
+        // Stuck waiting for a sensor that never answers
+      }
+      work(task->workUs);
+      break;
+
+    case TASK_COMMS:
+      // 20 ms instead of 1.5 ms: over budget on every run
+      work(slowComms ? 20000 : task->workUs);
+      break;
+
+    case TASK_UI:
+      if (GPIO_PinInGet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN) == 0) {
+        hangSensor = true;
+      }
+      if (GPIO_PinInGet(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN) == 0) {
+        slowComms = true;
+      }
+      work(task->workUs);
+      break;
+  }
+}
+
+/**************************************************************************//**
+ * @brief  LED0 shows the supervisor feeds; push buttons inject faults
+ *****************************************************************************/
+void initGPIO(void)
+{
+  CMU_ClockEnable(cmuClock_GPIO, true);
+
+  GPIO_PinModeSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN, gpioModePushPull, 0);
+  GPIO_PinModeSet(BSP_GPIO_PB0_PORT, BSP_GPIO_PB0_PIN, gpioModeInputPullFilter, 1);
+  GPIO_PinModeSet(BSP_GPIO_PB1_PORT, BSP_GPIO_PB1_PIN, gpioModeInputPullFilter, 1);
+}
+
+/**************************************************************************//**
+ * @brief Watchdog initialization: 2 s period, illegal window for the first
+ * 25%, warning at 75%
+ *****************************************************************************/
+void initWDOG(void)
+{
+  CMU_ClockSelectSet(cmuClock_WDOG0, cmuSelect_ULFRCO);
+  CMU_ClockEnable(cmuClock_WDOG0, true);
+
+  WDOG_Init_TypeDef wdogInit = WDOG_INIT_DEFAULT;
+  wdogInit.debugRun = true;
+  wdogInit.perSel = wdogPeriod_2k;
+  wdogInit.winSel = wdogIllegalWindowTime25_0pct;
+  wdogInit.warnSel = wdogWarnTime75pct;
+
+  WDOGn_IntEnable(WDOG0, WDOG_IEN_WARN);
+  NVIC_EnableIRQ(WDOG0_IRQn);
+
+  WDOGn_Init(WDOG0, &wdogInit);
+}
+
+/**************************************************************************//**
+ * @brief Watchdog warning: no feed for 1.5 s. Blame a task; the reset
+ * follows at 2 s.
+ *****************************************************************************/
+void WDOG0_IRQHandler(void)
+{
+  SUP_WarningIRQ(&sup);
+  GPIO_PinOutSet(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+}
+
+/**************************************************************************//**
+ * @brief  Print the per-task telemetry
+ *****************************************************************************/
+void report(void)
+{
+  int i;
+
+  printf("-- task      runs  worst run/budget (us)  worst gap/deadline (ms)"
+         "  overruns  late\n");
+  for (i = 0; i < sup.count; i++) {
+    SUP_Task_TypeDef *t = &sup.tasks[i];
+    printf("   %-8s %6lu %10lu /%6lu %14lu /%6lu %10lu %5lu\n",
+           t->name, t->runs, micros(t->worstRun), micros(t->budget),
+           micros(t->worstGap) / 1000, micros(t->deadline) / 1000,
+           t->overruns, t->lateCheckIns);
+  }
+  printf("-- watchdog feeds: %lu\n", sup.feeds);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *****************************************************************************/
+int main(void)
+{
+  SUP_Record_TypeDef fault;
+  uint32_t resetCause;
+  uint32_t now, nextReport;
+  int i;
+
+  CHIP_Init();
+
+  EMU_DCDCInit_TypeDef dcdcInit = EMU_DCDCINIT_DEFAULT;
+  EMU_DCDCInit(&dcdcInit);
+
+  resetCause = RMU_ResetCauseGet();
+  RMU_ResetCauseClear();
+
+  RETARGET_SerialInit();
+  RETARGET_SerialCrLf(1);
+  initGPIO();
+  tickHz = SUP_Start();
+
+  printf("\nWatchdog task supervisor\n");
+  if (SUP_LastFault(&fault) && (resetCause & EMU_RSTCAUSE_WDOG0)) {
+    if (fault.offender >= 0) {
+      printf("-- Watchdog reset: task %s %s, %lu us over its limit\n",
+             tasks[fault.offender].name, faultNames[fault.fault],
+             micros(fault.excess));
+    } else {
+      printf("-- Watchdog reset: all tasks healthy, supervisor not polled\n");
+    }
+  }
+  printf("-- PB0 hangs the sensor task, PB1 slows the comms task\n");
+
+  now = SUP_Now();
+  SUP_Init(&sup, ticks(FEED_MIN_MS * 1000), now);
+  for (i = 0; i < TASK_COUNT; i++) {
+    tasks[i].id = SUP_Register(&sup, tasks[i].name,
+                               ticks(tasks[i].deadlineMs * 1000),
+                               ticks(tasks[i].budgetUs), now);
+    tasks[i].next = now;
+  }
+  nextReport = now + ticks(REPORT_MS * 1000);
+  initWDOG();
+
+  // Cooperative scheduler: run each task when its period comes round
+  while (1) {
+    for (i = 0; i < TASK_COUNT; i++) {
+      now = SUP_Now();
+      if ((int32_t)(now - tasks[i].next) >= 0) {
+        tasks[i].next += ticks(tasks[i].periodMs * 1000);
+        SUP_Begin(&sup, tasks[i].id, now);
+        runTask(i);
+        SUP_CheckIn(&sup, tasks[i].id, SUP_Now());
+      }
+    }
+
+    if (SUP_Service(&sup)) {
+      GPIO_PinOutToggle(BSP_GPIO_LED0_PORT, BSP_GPIO_LED0_PIN);
+    }
+
+    if ((int32_t)(SUP_Now() - nextReport) >= 0) {
+      nextReport += ticks(REPORT_MS * 1000);
+      report();
+    }
+  }
+}
@@ -0,0 +1,355 @@
+/***************************************************************************//**
+ * @file sup.c
+ * @brief Cooperative task supervisor: the watchdog is fed only while every
+ * task checks in within its deadline and run time budget.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <string.h>
+#include "sup.h"
+
+#if !defined(SUP_HOST)
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_timer.h"
+#include "em_wdog.h"
+
+/**************************************************************************//**
+ * @brief
+ *   Start the supervisor time base and enable the fault record.
+ *
+ * @details
+ *   TIMER0 runs free as a 32-bit counter at about 1 MHz. BURAM holds the
+ *   fault record through the watchdog reset.
+ *
+ * @return
+ *   Supervisor ticks per second.
+ *****************************************************************************/
+uint32_t SUP_Start(void)
+{
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+
+  CMU_ClockEnable(cmuClock_TIMER0, true);
+#if defined(_CMU_CLKEN0_BURAM_MASK)
+  CMU_ClockEnable(cmuClock_BURAM, true);
+#endif
+
+  // Free-running 32-bit counter; divide by 16 for a ~1 us tick
+  timerInit.prescale = timerPrescale16;
+  TIMER_Init(TIMER0, &timerInit);
+
+  return CMU_ClockFreqGet(cmuClock_TIMER0) / 16;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Current supervisor time in ticks.
+ *****************************************************************************/
+uint32_t SUP_Now(void)
+{
+  return TIMER_CounterGet(TIMER0);
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Feed WDOG0 if the supervisor allows it; call from the main loop.
+ *
+ * @return
+ *   true if the watchdog was fed.
+ *****************************************************************************/
+bool SUP_Service(SUP_Handle_TypeDef *handle)
+{
+  if (!SUP_FeedDue(handle, SUP_Now())) {
+    return false;
+  }
+  WDOGn_Feed(WDOG0);
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Blame a task for a watchdog warning and keep the result in BURAM.
+ *
+ * @details
+ *   Call from WDOG0_IRQHandler(). The watchdog reset follows when the
+ *   period ends; SUP_LastFault() reads the record after it.
+ *****************************************************************************/
+void SUP_WarningIRQ(SUP_Handle_TypeDef *handle)
+{
+  uint32_t flags = WDOGn_IntGet(WDOG0);
+
+  WDOGn_IntClear(WDOG0, flags);
+  if (flags & WDOG_IF_WARN) {
+    SUP_RecordSave(SUP_Warning(handle, SUP_Now()), &BURAM->RET[0].REG);
+  }
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Read and clear the fault record left by the last warning.
+ *
+ * @return
+ *   false if there is none.
+ *****************************************************************************/
+bool SUP_LastFault(SUP_Record_TypeDef *record)
+{
+  return SUP_RecordLoad(&BURAM->RET[0].REG, record);
+}
+#endif // !SUP_HOST
+
+/**************************************************************************//**
+ * @brief
+ *   Initialize a supervisor with no tasks.
+ *
+ * @param[in] feedMin
+ *   Ticks after a feed before the watchdog window opens; feeding earlier
+ *   would be refused by a windowed watchdog.
+ *
+ * @param[in] now
+ *   Current time; the watchdog is taken as fed now.
+ *****************************************************************************/
+void SUP_Init(SUP_Handle_TypeDef *handle, uint32_t feedMin, uint32_t now)
+{
+  memset(handle, 0, sizeof(*handle));
+  handle->feedMin = feedMin;
+  handle->lastFeed = now;
+  handle->last.offender = -1;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Add a task; its first deadline runs from now.
+ *
+ * @param[in] name
+ *   Used for reports only; must stay valid.
+ *
+ * @param[in] deadline
+ *   Longest time between check-ins. Every task must check in between the
+ *   window opening and the warning, so the deadline must be shorter than
+ *   that stretch of the watchdog period.
+ *
+ * @param[in] budget
+ *   Longest run from SUP_Begin() to SUP_CheckIn().
+ *
+ * @return
+ *   Task index, or -1 if SUP_MAX_TASKS are registered already.
+ *****************************************************************************/
+int SUP_Register(SUP_Handle_TypeDef *handle,
+                 const char *name,
+                 uint32_t deadline,
+                 uint32_t budget,
+                 uint32_t now)
+{
+  SUP_Task_TypeDef *task;
+
+  if (handle->count >= SUP_MAX_TASKS) {
+    return -1;
+  }
+  task = &handle->tasks[handle->count];
+  memset(task, 0, sizeof(*task));
+  task->name = name;
+  task->deadline = deadline;
+  task->budget = budget;
+  task->lastCheckIn = now;
+  return handle->count++;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Note the start of a task run.
+ *****************************************************************************/
+void SUP_Begin(SUP_Handle_TypeDef *handle, int task, uint32_t now)
+{
+  handle->tasks[task].runStart = now;
+  handle->tasks[task].running = true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Note the end of a task run and update its telemetry.
+ *
+ * @details
+ *   A check-in counts towards the next feed only if the run kept to the
+ *   budget and the check-in came within the deadline. A task that broke
+ *   either must check in within limits once more before the watchdog
+ *   period ends, or the device resets.
+ *
+ * @return
+ *   true if the check-in was within limits.
+ *****************************************************************************/
+bool SUP_CheckIn(SUP_Handle_TypeDef *handle, int task, uint32_t now)
+{
+  SUP_Task_TypeDef *t = &handle->tasks[task];
+  uint32_t gap = now - t->lastCheckIn;
+  uint32_t run = t->running ? now - t->runStart : 0;
+  bool ok = true;
+
+  t->runs++;
+  if (run > t->worstRun) {
+    t->worstRun = run;
+  }
+  if (gap > t->worstGap) {
+    t->worstGap = gap;
+  }
+  if (run > t->budget) {
+    t->overruns++;
+    ok = false;
+  }
+  if (gap > t->deadline) {
+    t->lateCheckIns++;
+    ok = false;
+  }
+  t->lastCheckIn = now;
+  t->running = false;
+  if (ok) {
+    t->healthy = true;
+  }
+  return ok;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Decide whether the watchdog may be fed now.
+ *
+ * @details
+ *   The watchdog may be fed once its window is open, if every task has
+ *   checked in within limits since the last feed. No task may be overdue
+ *   or running past its budget at this moment either. A true result starts
+ *   the next period: the caller must feed the watchdog.
+ *****************************************************************************/
+bool SUP_FeedDue(SUP_Handle_TypeDef *handle, uint32_t now)
+{
+  SUP_Task_TypeDef *t;
+  int i;
+
+  if (now - handle->lastFeed < handle->feedMin) {
+    return false;
+  }
+  for (i = 0; i < handle->count; i++) {
+    t = &handle->tasks[i];
+    if (!t->healthy
+        || (now - t->lastCheckIn > t->deadline)
+        || (t->running && (now - t->runStart > t->budget))) {
+      return false;
+    }
+  }
+  for (i = 0; i < handle->count; i++) {
+    handle->tasks[i].healthy = false;
+  }
+  handle->lastFeed = now;
+  handle->feeds++;
+  return true;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Find the task that is holding back the feed.
+ *
+ * @details
+ *   Called at the watchdog warning. A task still running past its budget
+ *   is blamed first, then the task furthest past its deadline, then the
+ *   longest-silent task whose check-ins all overran. Among tasks with the
+ *   same fault, the one furthest over its limit is blamed.
+ *
+ * @return
+ *   The result, also kept in handle->last.
+ *****************************************************************************/
+const SUP_Record_TypeDef *SUP_Warning(SUP_Handle_TypeDef *handle,
+                                      uint32_t now)
+{
+  SUP_Record_TypeDef found = { -1, supFaultNone, 0 };
+  SUP_Task_TypeDef *t;
+  SUP_Fault_TypeDef fault;
+  uint32_t excess;
+  int i;
+
+  for (i = 0; i < handle->count; i++) {
+    t = &handle->tasks[i];
+    if (t->running && (now - t->runStart > t->budget)) {
+      fault = supFaultHung;
+      excess = now - t->runStart - t->budget;
+    } else if (now - t->lastCheckIn > t->deadline) {
+      fault = supFaultLate;
+      excess = now - t->lastCheckIn - t->deadline;
+    } else if (!t->healthy) {
+      fault = supFaultOverrun;
+      excess = now - t->lastCheckIn;
+    } else {
+      continue;
+    }
+    // Enum order is the blame order: hung before late before overrun
+    if ((found.fault == supFaultNone) || (fault < found.fault)
+        || ((fault == found.fault) && (excess > found.excess))) {
+      found.offender = i;
+      found.fault = fault;
+      found.excess = excess;
+    }
+  }
+
+  handle->warnings++;
+  handle->last = found;
+  return &handle->last;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Store a fault record in two retention registers.
+ *****************************************************************************/
+void SUP_RecordSave(const SUP_Record_TypeDef *record, volatile uint32_t *ret)
+{
+  ret[1] = record->excess;
+  ret[0] = (SUP_RECORD_MAGIC << 16)
+           | ((uint32_t)record->fault << 8)
+           | (uint8_t)record->offender;
+}
+
+/**************************************************************************//**
+ * @brief
+ *   Read and clear a fault record written by SUP_RecordSave().
+ *
+ * @return
+ *   false if the registers hold no record.
+ *****************************************************************************/
+bool SUP_RecordLoad(volatile uint32_t *ret, SUP_Record_TypeDef *record)
+{
+  uint32_t word = ret[0];
+
+  if ((word >> 16) != SUP_RECORD_MAGIC
+      || ((word >> 8) & 0xFF) > supFaultOverrun) {
+    return false;
+  }
+  record->offender = (int8_t)(word & 0xFF);
+  record->fault = (SUP_Fault_TypeDef)((word >> 8) & 0xFF);
+  record->excess = ret[1];
+  ret[0] = 0;
+  return true;
+}
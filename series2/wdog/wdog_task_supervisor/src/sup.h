@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file sup.h
+ * @brief Cooperative task supervisor: the watchdog is fed only while every
+ * task checks in within its deadline and run time budget.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#ifndef SUP_H
+#define SUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Tasks one supervisor can watch
+#define SUP_MAX_TASKS       8
+
+/// Marks a fault record kept across the watchdog reset
+#define SUP_RECORD_MAGIC    0x5355U
+
+/// Why a task was blamed for a watchdog warning
+typedef enum {
+  supFaultNone,       ///< Every task was healthy; the supervisor was not polled
+  supFaultHung,       ///< Still running past its budget
+  supFaultLate,       ///< No check-in within its deadline
+  supFaultOverrun     ///< Checked in, but every run since the feed overran
+} SUP_Fault_TypeDef;
+
+/// One supervised task; times are in supervisor ticks
+typedef struct {
+  const char *name;
+  uint32_t   deadline;      ///< Longest time between check-ins
+  uint32_t   budget;        ///< Longest run, SUP_Begin() to SUP_CheckIn()
+
+  // Private to the supervisor
+  uint32_t   lastCheckIn;
+  uint32_t   runStart;
+  bool       running;
+  bool       healthy;       ///< Checked in within limits since the last feed
+
+  // Telemetry
+  uint32_t   runs;
+  uint32_t   worstRun;      ///< Worst-case execution time seen
+  uint32_t   worstGap;      ///< Longest time between check-ins seen
+  uint32_t   overruns;      ///< Runs longer than the budget
+  uint32_t   lateCheckIns;  ///< Check-ins after the deadline
+} SUP_Task_TypeDef;
+
+/// What the warning interrupt found; kept across the watchdog reset
+typedef struct {
+  int8_t            offender; ///< Task index, -1 for none
+  SUP_Fault_TypeDef fault;
+  uint32_t          excess;   ///< Ticks past the budget or deadline
+} SUP_Record_TypeDef;
+
+/// Supervisor state
+typedef struct {
+  SUP_Task_TypeDef   tasks[SUP_MAX_TASKS];
+  uint8_t            count;
+  uint32_t           feedMin;   ///< Ticks after a feed before the window opens
+  uint32_t           lastFeed;
+  uint32_t           feeds;
+  uint32_t           warnings;
+  SUP_Record_TypeDef last;      ///< Set by SUP_Warning()
+} SUP_Handle_TypeDef;
+
+void SUP_Init(SUP_Handle_TypeDef *handle, uint32_t feedMin, uint32_t now);
+int SUP_Register(SUP_Handle_TypeDef *handle,
+                 const char *name,
+                 uint32_t deadline,
+                 uint32_t budget,
+                 uint32_t now);
+void SUP_Begin(SUP_Handle_TypeDef *handle, int task, uint32_t now);
+bool SUP_CheckIn(SUP_Handle_TypeDef *handle, int task, uint32_t now);
+bool SUP_FeedDue(SUP_Handle_TypeDef *handle, uint32_t now);
+const SUP_Record_TypeDef *SUP_Warning(SUP_Handle_TypeDef *handle,
+                                      uint32_t now);
+void SUP_RecordSave(const SUP_Record_TypeDef *record, volatile uint32_t *ret);
+bool SUP_RecordLoad(volatile uint32_t *ret, SUP_Record_TypeDef *record);
+
+#if !defined(SUP_HOST)
+uint32_t SUP_Start(void);
+uint32_t SUP_Now(void);
+bool SUP_Service(SUP_Handle_TypeDef *handle);
+void SUP_WarningIRQ(SUP_Handle_TypeDef *handle);
+bool SUP_LastFault(SUP_Record_TypeDef *record);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SUP_H
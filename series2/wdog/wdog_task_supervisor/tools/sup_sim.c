@@ -0,0 +1,310 @@
+/***************************************************************************//**
+ * @file sup_sim.c
+ * @brief Host test and benchmark for the watchdog task supervisor.
+ *
+ * Build and run on a PC:
+ *   gcc -std=c99 -O2 -DSUP_HOST -I../src -o sup_sim sup_sim.c ../src/sup.c
+ *   ./sup_sim
+ *
+ * A simulated 1 MHz clock drives the task set of the example through a
+ * model of the windowed watchdog: 2049 ms period, illegal window for the
+ * first 25%, warning at 75%. Healthy runs must never feed in the window
+ * or reach the warning; a single overrun must be forgiven; a hung, late or
+ * always-overrunning task must reach the warning and be blamed. The exit
+ * status is non-zero if a check fails.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *******************************************************************************
+ * # Evaluation Quality
+ * This code has been minimally tested to ensure that it builds and is suitable
+ * as a demonstration for evaluation purposes only. This code will be maintained
+ * at the sole discretion of Silicon Labs.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sup.h"
+
+// Watchdog model, in 1 us ticks
+#define WDOG_PERIOD     2049000
+#define WDOG_WINDOW     (WDOG_PERIOD / 4)
+#define WDOG_WARNING    (WDOG_PERIOD * 3 / 4)
+#define FEED_MIN        600000
+
+static int failures;
+
+static void check(int ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    failures++;
+  }
+}
+
+// The example's task set
+typedef struct {
+  const char *name;
+  uint32_t   period;
+  uint32_t   deadline;
+  uint32_t   budget;
+  uint32_t   work;
+} SimTask_TypeDef;
+
+static const SimTask_TypeDef simTasks[] = {
+  { "sensor", 50000, 100000, 2000, 500 },
+  { "comms", 200000, 300000, 5000, 1500 },
+  { "ui", 20000, 100000, 1000, 100 },
+};
+
+#define SIM_TASKS  (sizeof(simTasks) / sizeof(simTasks[0]))
+
+// Faults to inject
+typedef struct {
+  int      task;          // -1 for none
+  uint32_t from;          // Time the fault starts
+  uint32_t runTime;       // Run time while faulty; 0xFFFFFFFF hangs
+  uint32_t runs;          // Faulty runs, 0 for all
+  bool     skip;          // The task stops being scheduled instead
+  bool     noPoll;        // The main loop stops polling the supervisor
+} Fault_TypeDef;
+
+// What happened
+typedef struct {
+  uint32_t feeds;
+  uint32_t earlyFeeds;    // Feeds in the illegal window
+  bool     warned;
+  uint32_t warnedAt;
+  SUP_Record_TypeDef record;
+} Outcome_TypeDef;
+
+static SUP_Handle_TypeDef sup;
+
+/*
+ * Run the cooperative loop of the example until the watchdog warning or
+ * the end time. A hung task is modelled by its run never ending; the
+ * warning interrupt then finds it still running.
+ */
+static Outcome_TypeDef simulate(uint32_t start, uint32_t duration,
+                                const Fault_TypeDef *fault)
+{
+  Outcome_TypeDef out;
+  uint32_t now = start, lastFeed = start, next[SIM_TASKS], faulty = 0;
+  int ids[SIM_TASKS];
+  unsigned int i;
+
+  memset(&out, 0, sizeof(out));
+  SUP_Init(&sup, FEED_MIN, now);
+  for (i = 0; i < SIM_TASKS; i++) {
+    ids[i] = SUP_Register(&sup, simTasks[i].name, simTasks[i].deadline,
+                          simTasks[i].budget, now);
+    next[i] = now;
+  }
+
+  while (now - start < duration) {
+    for (i = 0; i < SIM_TASKS; i++) {
+      bool injected = fault && (fault->task == (int)i)
+                      && (now - start >= fault->from)
+                      && (fault->runs == 0 || faulty < fault->runs);
+      uint32_t run = simTasks[i].work;
+
+      if ((int32_t)(now - next[i]) < 0) {
+        continue;
+      }
+      next[i] += simTasks[i].period;
+      if (injected && fault->skip) {
+        continue;
+      }
+      if (injected) {
+        faulty++;
+        run = fault->runTime;
+      }
+      SUP_Begin(&sup, ids[i], now);
+      if (run == 0xFFFFFFFF || now - lastFeed + run >= WDOG_WARNING) {
+        // The warning interrupt fires during this run
+        now = lastFeed + WDOG_WARNING;
+        goto warning;
+      }
+      now += run;
+      SUP_CheckIn(&sup, ids[i], now);
+    }
+
+    if (!(fault && fault->noPoll && now - start >= fault->from)
+        && SUP_FeedDue(&sup, now)) {
+      if (now - lastFeed < WDOG_WINDOW) {
+        out.earlyFeeds++;
+      }
+      out.feeds++;
+      lastFeed = now;
+    }
+    now += 50;          // Loop overhead
+    if (now - lastFeed >= WDOG_WARNING) {
+      now = lastFeed + WDOG_WARNING;
+      goto warning;
+    }
+  }
+  return out;
+
+  warning:
+  out.warned = true;
+  out.warnedAt = now - start;
+  out.record = *SUP_Warning(&sup, now);
+  return out;
+}
+
+static void testHealthy(uint32_t start)
+{
+  Outcome_TypeDef out = simulate(start, 60000000, NULL);
+
+  check(!out.warned, "healthy: no warning");
+  check(out.earlyFeeds == 0, "healthy: no feed in the illegal window");
+  check(out.feeds >= 90 && out.feeds <= 100, "healthy: feeds every ~600 ms");
+  check(sup.tasks[0].worstRun == 500 && sup.tasks[1].worstRun == 1500,
+        "healthy: worst-case run times");
+  check(sup.tasks[0].worstGap <= 100000 && sup.tasks[2].worstGap <= 100000,
+        "healthy: gaps within deadlines");
+  check(sup.tasks[0].overruns == 0 && sup.tasks[1].lateCheckIns == 0,
+        "healthy: no faults counted");
+}
+
+static void testFaults(void)
+{
+  Fault_TypeDef once = { 1, 3000000, 20000, 1, false, false };
+  Fault_TypeDef always = { 1, 3000000, 20000, 0, false, false };
+  Fault_TypeDef hang = { 0, 3000000, 0xFFFFFFFF, 0, false, false };
+  Fault_TypeDef skip = { 2, 3000000, 0, 0, true, false };
+  Fault_TypeDef noPoll = { -1, 3000000, 0, 0, false, true };
+  Outcome_TypeDef out;
+
+  out = simulate(0, 30000000, &once);
+  check(!out.warned, "single overrun forgiven");
+  check(sup.tasks[1].overruns == 1 && sup.tasks[1].worstRun == 20000,
+        "single overrun recorded");
+
+  out = simulate(0, 30000000, &always);
+  check(out.warned, "repeated overrun reaches the warning");
+  check(out.record.offender == 1 && out.record.fault == supFaultOverrun,
+        "repeated overrun blamed on comms");
+  check(out.warnedAt < 3000000 + WDOG_PERIOD, "overrun warning in time");
+
+  out = simulate(0, 30000000, &hang);
+  check(out.warned, "hang reaches the warning");
+  check(out.record.offender == 0 && out.record.fault == supFaultHung,
+        "hang blamed on sensor");
+  check(out.record.excess > 900000, "hang excess");
+
+  out = simulate(0, 30000000, &skip);
+  check(out.warned, "skipped task reaches the warning");
+  check(out.record.offender == 2 && out.record.fault == supFaultLate,
+        "skipped task blamed on ui");
+
+  out = simulate(0, 30000000, &noPoll);
+  check(out.warned, "unpolled supervisor reaches the warning");
+  check(out.record.offender == -1 && out.record.fault == supFaultNone,
+        "unpolled supervisor blames no task");
+}
+
+static void testUnits(void)
+{
+  SUP_Handle_TypeDef h;
+  SUP_Record_TypeDef in = { 2, supFaultLate, 123456 }, rec;
+  volatile uint32_t ret[2] = { 0xFFFFFFFF, 0 };
+  int i;
+
+  SUP_Init(&h, 100, 0);
+  for (i = 0; i < SUP_MAX_TASKS; i++) {
+    check(SUP_Register(&h, "t", 1000, 10, 0) == i, "register");
+  }
+  check(SUP_Register(&h, "t", 1000, 10, 0) == -1, "register past limit");
+
+  // Nothing checked in; then all but one; then the window
+  SUP_Init(&h, 100, 0);
+  SUP_Register(&h, "a", 1000, 10, 0);
+  SUP_Register(&h, "b", 1000, 10, 0);
+  check(!SUP_FeedDue(&h, 200), "no feed before check-ins");
+  SUP_Begin(&h, 0, 10);
+  check(SUP_CheckIn(&h, 0, 15), "check-in within limits");
+  check(!SUP_FeedDue(&h, 200), "no feed with one task missing");
+  SUP_Begin(&h, 1, 20);
+  check(!SUP_CheckIn(&h, 1, 40), "check-in over budget refused");
+  check(!SUP_FeedDue(&h, 200), "no feed after an overrun");
+  SUP_Begin(&h, 1, 50);
+  SUP_CheckIn(&h, 1, 55);
+  check(!SUP_FeedDue(&h, 60), "no feed in the window");
+  check(SUP_FeedDue(&h, 100), "feed once the window opens");
+  check(!SUP_FeedDue(&h, 300), "check-ins needed again after a feed");
+
+  // Fault record
+  SUP_RecordSave(&in, ret);
+  check(SUP_RecordLoad(ret, &rec) && rec.offender == 2
+        && rec.fault == supFaultLate && rec.excess == 123456, "record");
+  check(!SUP_RecordLoad(ret, &rec), "record consumed");
+  in.offender = -1;
+  in.fault = supFaultNone;
+  SUP_RecordSave(&in, ret);
+  check(SUP_RecordLoad(ret, &rec) && rec.offender == -1, "record, no task");
+  ret[0] = 0x12345678;
+  check(!SUP_RecordLoad(ret, &rec), "power-on contents refused");
+}
+
+static void benchmark(void)
+{
+  SUP_Handle_TypeDef h;
+  uint32_t now = 0, n = 2000000, i;
+  int t, due = 0;
+  clock_t start;
+  double seconds;
+
+  SUP_Init(&h, 1000, 0);
+  for (t = 0; t < SUP_MAX_TASKS; t++) {
+    SUP_Register(&h, "t", 100000, 1000, 0);
+  }
+  start = clock();
+  for (i = 0; i < n; i++) {
+    t = i % SUP_MAX_TASKS;
+    SUP_Begin(&h, t, now);
+    now += 10;
+    SUP_CheckIn(&h, t, now);
+    due += SUP_FeedDue(&h, now);
+  }
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  check(due > 0, "benchmark feeds");
+  printf("check-in and feed decision with %d tasks: %.1f ns on this host\n",
+         SUP_MAX_TASKS, seconds * 1e9 / n);
+}
+
+int main(void)
+{
+  testUnits();
+  testHealthy(0);
+  testHealthy(0xFFFFFFFF - 5000000);   // Clock wrap part way
+  testFaults();
+  benchmark();
+
+  printf("%d failure(s)\n", failures);
+  return failures ? 1 : 0;
+}